@@ -5,6 +5,12 @@
 #define DAYS_IN_100_PERIOD  (36524UL)    // 25 * DAYS_IN_4_PERIOD - 1
 #define DAYS_IN_400_PERIOD  (146097UL)   // 4 * DAYS_IN_100_PERIOD + 1
 
+// computational calendar of Neri-Schneider algorithm starts at 0000-03-01, so leap day is the last day of year
+#define DAYS_BEFORE_EPOCH   (306U)       // days from 0000-03-01 to 0001-01-01
+#define YEAR_MULTIPLIER     (2939745U)   // 2^32 / year length scaled by 4, see grigorian_days_to_date
+#define MONTH_MULTIPLIER    (2141U)      // 2^16 / average length of month from March to January
+#define MONTH_OFFSET        (197913U)    // makes month of March 3 and of January 13
+
 static sint8 grigorian_month_days[24] = {
     31, 28, 31,
     30, 31, 30,
@@ -62,48 +68,96 @@ uint8 grigorian_is_leap_year(uint64 date)
     return 0;
 }
 
+// convert days since 0001-01-01 to year, month and day without branches and divisions by variables (Neri-Schneider):
+// n1 counts quarter-days, so 400-year period (century in terms of the algorithm) and year of it are found
+// by multiplication by constants, day of year starting from March gives month and day by one more multiplication
+inline void grigorian_days_to_date(uint64 days, uint64 *year, uint32 *month, uint32 *day)
+{
+    uint64 n1 = 4 * (days + DAYS_BEFORE_EPOCH) + 3;
+    uint64 century = n1 / DAYS_IN_400_PERIOD;
+    uint32 n2 = (uint32)(n1 % DAYS_IN_400_PERIOD) | 3;
+    uint64 p2 = (uint64)YEAR_MULTIPLIER * n2;
+    uint32 year_day = (uint32)p2 / (YEAR_MULTIPLIER * 4);
+    uint32 n3 = MONTH_MULTIPLIER * year_day + MONTH_OFFSET;
+    uint32 january = year_day >= DAYS_BEFORE_EPOCH;     // January and February belong to the next year
+
+    *year = 100 * century + (uint32)(p2 >> 32) + january;
+    *month = (n3 >> 16) - 12 * january;
+    *day = (n3 & 0xFFFF) / MONTH_MULTIPLIER + 1;
+}
+
 uint64 grigorian_extract_year(uint64 date)
 {
-    uint64 res          = date / SECONDS_IN_DAY;  // whole days
-    uint64 res400       = res / DAYS_IN_400_PERIOD;   // number of 400 year periods
-    uint64 res400_rem   = res % DAYS_IN_400_PERIOD;
-    uint64 res100       = (res400_rem == DAYS_IN_400_PERIOD-1) ? 3 : res400_rem / DAYS_IN_100_PERIOD;    // number of 100 year periods
-    uint64 res100_rem   = (res400_rem == DAYS_IN_400_PERIOD-1) ? DAYS_IN_100_PERIOD : res400_rem % DAYS_IN_100_PERIOD;
-    uint64 res4         = res100_rem / DAYS_IN_4_PERIOD;   // etc
-    uint64 res4_rem     = res100_rem % DAYS_IN_4_PERIOD;
-    res                 = (res4_rem == DAYS_IN_4_PERIOD-1) ? 3 : res4_rem / 365;
+    uint64 year;
+    uint32 month, day;
 
-    return res400 * 400 + res100 * 100 + res4 * 4 + res + 1;  // starts with 1
+    grigorian_days_to_date(date / SECONDS_IN_DAY, &year, &month, &day);
+    return year;
 }
 
 uint8 grigorian_extract_month_of_year(uint64 date)
 {
-    sint16 year_day = (date - grigorian_trunc_to_year(date)) / SECONDS_IN_DAY;
-    uint8 is_leap = grigorian_is_leap_year(date);
+    uint64 year;
+    uint32 month, day;
+
+    grigorian_days_to_date(date / SECONDS_IN_DAY, &year, &month, &day);
+    return (uint8)month;
+}
+
+uint8 grigorian_extract_day_of_month(uint64 date)
+{
+    uint64 year;
+    uint32 month, day;
+
+    grigorian_days_to_date(date / SECONDS_IN_DAY, &year, &month, &day);
+    return (uint8)day;
+}
+
+// loops below have no branches or calls, so they are unrolled and vectorized where target allows
+void grigorian_extract_year_batch(const uint64 *date, uint32 n, uint64 *year)
+{
+    uint32 month, day;
 
-    sint8 *month_days = grigorian_month_days + 12 * is_leap;
-    uint8 month = 0;
-    do
+    for(uint32 i = 0; i < n; i++)
     {
-        year_day -= month_days[month++];
+        grigorian_days_to_date(date[i] / SECONDS_IN_DAY, year + i, &month, &day);
     }
-    while(year_day >= 0);
+}
 
-    return month;
+void grigorian_extract_month_of_year_batch(const uint64 *date, uint32 n, uint8 *month)
+{
+    uint64 year;
+    uint32 m, day;
+
+    for(uint32 i = 0; i < n; i++)
+    {
+        grigorian_days_to_date(date[i] / SECONDS_IN_DAY, &year, &m, &day);
+        month[i] = (uint8)m;
+    }
 }
 
-uint8 grigorian_extract_day_of_month(uint64 date)
+void grigorian_extract_day_of_month_batch(const uint64 *date, uint32 n, uint8 *day)
+{
+    uint64 year;
+    uint32 month, d;
+
+    for(uint32 i = 0; i < n; i++)
+    {
+        grigorian_days_to_date(date[i] / SECONDS_IN_DAY, &year, &month, &d);
+        day[i] = (uint8)d;
+    }
+}
+
+void grigorian_extract_date_batch(const uint64 *date, uint32 n, uint64 *year, uint8 *month, uint8 *day)
 {
-    sint16 year_day = (date - grigorian_trunc_to_year(date)) / SECONDS_IN_DAY;
-    uint8 is_leap = grigorian_is_leap_year(date);
+    uint32 m, d;
 
-    sint8 *month_days = grigorian_month_days + 12 * is_leap;
-    uint8 month = 0;
-    while(year_day >= month_days[month])
+    for(uint32 i = 0; i < n; i++)
     {
-        year_day -= month_days[month++];
+        grigorian_days_to_date(date[i] / SECONDS_IN_DAY, year + i, &m, &d);
+        month[i] = (uint8)m;
+        day[i] = (uint8)d;
     }
-    return year_day+1;
 }
 
 sint8 grigorian_make_date_with_time(uint64 *date, uint64 year, uint8 month, uint8 day, uint8 hour, uint8 min, uint8 sec)
@@ -0,0 +1,593 @@
+#include "calendar/tzinfo.h"
+#include "calendar/grigorian.h"
+#include "config/config.h"
+#include "common/error.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TZINFO_SECONDS_IN_DAY   (86400L)
+#define TZINFO_USEC_IN_SEC      (1000000L)
+#define TZINFO_USEC_IN_MIN      (60000000L)
+#define TZINFO_UNIX_EPOCH       (719162L * TZINFO_SECONDS_IN_DAY)   // 1970-01-01 in seconds since 0001-01-01
+#define TZINFO_MAX_OFFSET       (26 * 3600)                         // offsets of zones are within a day
+#define TZINFO_CYCLE_YEARS      (400)
+#define TZINFO_CYCLE            (146097L * TZINFO_SECONDS_IN_DAY)   // 400 years of Gregorian calendar
+#define TZINFO_HEADER_SZ        (44)
+#define TZINFO_TYPE_SZ          (6)         // utoff (4 bytes), isdst, desigidx
+#define TZINFO_POSIX_MAX_LEN    (128)
+#define TZINFO_MAX_FILE_SZ      (1024 * 1024)
+#define TZINFO_MAX_PATH_LEN     (4096)
+
+// day of transition of POSIX TZ rule
+typedef enum _tzinfo_rule_kind
+{
+    TZINFO_RULE_JULIAN = 0,     // Jn: day of year from 1 to 365, February 29 is never counted
+    TZINFO_RULE_DAY,            // n: day of year from 0 to 365
+    TZINFO_RULE_MONTH           // Mm.w.d: day d (0 - Sunday) of week w (5 - the last one) of month m
+} tzinfo_rule_kind;
+
+typedef struct _tzinfo_rule
+{
+    uint8  kind;
+    uint8  month;
+    uint8  week;
+    uint8  wday;
+    uint16 day;
+    sint32 time;                // seconds of local time the transition happens at
+} tzinfo_rule;
+
+// POSIX TZ string: std offset [dst [offset] [,start[/time],end[/time]]]
+typedef struct _tzinfo_posix
+{
+    sint32 std;                 // offset of standard time from UTC in seconds, positive east of Greenwich
+    sint32 dst;                 // offset of daylight saving time
+    uint8  has_dst;
+    tzinfo_rule start;          // transition to daylight saving time
+    tzinfo_rule end;            // transition to standard time
+} tzinfo_posix;
+
+
+// return sz bytes of buf in big-endian order
+inline uint64 tzinfo_get(const uint8 *buf, uint32 sz)
+{
+    uint64 v = 0;
+
+    for(uint32 i = 0; i < sz; i++)
+    {
+        v = (v << 8) | buf[i];
+    }
+
+    return v;
+}
+
+// allocate zone of up to cap periods, the first one starts at 0 with offset 0
+// return zone, NULL if out of memory (error code is set)
+tzinfo_zone *tzinfo_alloc(uint32 cap)
+{
+    tzinfo_zone *zone = (tzinfo_zone *)malloc(sizeof(tzinfo_zone) + cap * (2 * sizeof(sint64) + sizeof(sint16)));
+
+    if(zone == NULL)
+    {
+        error_set(ERROR_OUT_OF_MEMORY);
+        return NULL;
+    }
+
+    zone->start = (sint64 *)(zone + 1);
+    zone->local_start = zone->start + cap;
+    zone->offset = (sint16 *)(zone->local_start + cap);
+    zone->n = 1;
+    zone->start[0] = 0;
+    zone->local_start[0] = 0;
+    zone->offset[0] = 0;
+    zone->cycle_start = 0;
+    zone->cycle_end = 0;
+
+    return zone;
+}
+
+// start period of offset seconds from UTC at UTC second start, transitions before 0001-01-01 set the first period,
+// transitions which don't change offset in minutes are dropped
+// return 0 on success, non-0 if transitions are not sorted or offset is invalid
+sint8 tzinfo_add_period(tzinfo_zone *zone, sint64 start, sint32 offset)
+{
+    sint16 minutes = (sint16)(offset / 60);
+
+    if(offset > TZINFO_MAX_OFFSET || offset < -TZINFO_MAX_OFFSET) return 1;
+
+    if(start <= 0)
+    {
+        zone->offset[0] = minutes;
+        return 0;
+    }
+
+    if(start <= zone->start[zone->n - 1]) return 1;
+    if(minutes == zone->offset[zone->n - 1]) return 0;
+
+    zone->start[zone->n] = start;
+    zone->offset[zone->n] = minutes;
+    zone->n++;
+
+    return 0;
+}
+
+// read name of time zone: at least one letter or any characters in angle brackets
+// return pointer after name, NULL on error
+const achar *tzinfo_parse_name(const achar *p)
+{
+    const achar *begin = p;
+
+    if(*p == _ach('<'))
+    {
+        while(*p != _ach('>') && *p != _ach('\0')) p++;
+        return *p == _ach('>') ? p + 1 : NULL;
+    }
+
+    while((*p >= _ach('a') && *p <= _ach('z')) || (*p >= _ach('A') && *p <= _ach('Z'))) p++;
+
+    return p > begin ? p : NULL;
+}
+
+// read [+|-]hh[:mm[:ss]] to seconds
+// return pointer after time, NULL on error
+const achar *tzinfo_parse_time(const achar *p, sint32 *seconds)
+{
+    sint32 v = 0, part, mul = 3600, sign = 1;
+    uint8 digits;
+
+    if(*p == _ach('+') || *p == _ach('-')) sign = *(p++) == _ach('-') ? -1 : 1;
+
+    for(*seconds = 0; mul > 0; mul /= 60)
+    {
+        for(part = 0, digits = 0; *p >= _ach('0') && *p <= _ach('9') && digits < 3; p++, digits++)
+        {
+            part = part * 10 + (*p - _ach('0'));
+        }
+        if(digits == 0) return NULL;
+        v += part * mul;
+
+        if(*p != _ach(':') || mul == 1) break;
+        p++;
+    }
+
+    *seconds = sign * v;
+    return p;
+}
+
+// read number of up to 3 digits from min to max
+// return pointer after number, NULL on error
+const achar *tzinfo_parse_number(const achar *p, uint16 min, uint16 max, uint16 *v)
+{
+    uint8 digits;
+
+    for(*v = 0, digits = 0; *p >= _ach('0') && *p <= _ach('9') && digits < 3; p++, digits++)
+    {
+        *v = (uint16)(*v * 10 + (*p - _ach('0')));
+    }
+
+    return digits > 0 && *v >= min && *v <= max ? p : NULL;
+}
+
+// read rule Jn, n or Mm.w.d[/time]
+// return pointer after rule, NULL on error
+const achar *tzinfo_parse_rule(const achar *p, tzinfo_rule *rule)
+{
+    uint16 month, week, wday;
+
+    rule->time = 2 * 3600;
+
+    if(*p == _ach('M'))
+    {
+        rule->kind = TZINFO_RULE_MONTH;
+        if(NULL == (p = tzinfo_parse_number(p + 1, 1, 12, &month)) || *p != _ach('.')) return NULL;
+        if(NULL == (p = tzinfo_parse_number(p + 1, 1, 5, &week)) || *p != _ach('.')) return NULL;
+        if(NULL == (p = tzinfo_parse_number(p + 1, 0, 6, &wday))) return NULL;
+        rule->month = (uint8)month;
+        rule->week = (uint8)week;
+        rule->wday = (uint8)wday;
+    }
+    else if(*p == _ach('J'))
+    {
+        rule->kind = TZINFO_RULE_JULIAN;
+        if(NULL == (p = tzinfo_parse_number(p + 1, 1, 365, &rule->day))) return NULL;
+    }
+    else
+    {
+        rule->kind = TZINFO_RULE_DAY;
+        if(NULL == (p = tzinfo_parse_number(p, 0, 365, &rule->day))) return NULL;
+    }
+
+    if(*p == _ach('/')) p = tzinfo_parse_time(p + 1, &rule->time);
+
+    return p;
+}
+
+// read POSIX TZ string tz, offsets of the string are positive west of Greenwich
+// return 0 on success, non-0 on error
+sint8 tzinfo_parse_posix(const achar *p, tzinfo_posix *posix)
+{
+    if(NULL == (p = tzinfo_parse_name(p))) return 1;
+    if(NULL == (p = tzinfo_parse_time(p, &posix->std))) return 1;
+    posix->std = -posix->std;
+    posix->dst = posix->std + 3600;
+    posix->has_dst = 0;
+
+    if(*p == _ach('\0')) return 0;
+
+    if(NULL == (p = tzinfo_parse_name(p))) return 1;
+    posix->has_dst = 1;
+    if(*p != _ach(',') && *p != _ach('\0'))
+    {
+        if(NULL == (p = tzinfo_parse_time(p, &posix->dst))) return 1;
+        posix->dst = -posix->dst;
+    }
+
+    if(*p == _ach('\0'))
+    {
+        // rule is not specified, take the one of United States
+        tzinfo_parse_rule(_ach("M3.2.0"), &posix->start);
+        tzinfo_parse_rule(_ach("M11.1.0"), &posix->end);
+        return 0;
+    }
+
+    if(*p != _ach(',') || NULL == (p = tzinfo_parse_rule(p + 1, &posix->start))) return 1;
+    if(*p != _ach(',') || NULL == (p = tzinfo_parse_rule(p + 1, &posix->end))) return 1;
+
+    return *p == _ach('\0') ? 0 : 1;
+}
+
+// return day since 0001-01-01 of rule in year
+sint64 tzinfo_rule_day(const tzinfo_rule *rule, uint64 year)
+{
+    uint64 jan1, first, next;
+    sint64 day;
+
+    grigorian_make_date(&jan1, year, 1, 1);
+
+    switch(rule->kind)
+    {
+        case TZINFO_RULE_JULIAN:
+            day = rule->day - 1;
+            if(rule->day >= 60 && grigorian_is_leap_year(jan1)) day++;
+            return (sint64)(jan1 / TZINFO_SECONDS_IN_DAY) + day;
+        case TZINFO_RULE_DAY:
+            return (sint64)(jan1 / TZINFO_SECONDS_IN_DAY) + rule->day;
+        default:
+            grigorian_make_date(&first, year, rule->month, 1);
+            if(rule->month == 12) grigorian_make_date(&next, year + 1, 1, 1);
+            else grigorian_make_date(&next, year, rule->month + 1, 1);
+            first /= TZINFO_SECONDS_IN_DAY;
+            next /= TZINFO_SECONDS_IN_DAY;
+
+            // 0001-01-01 is Monday
+            day = (sint64)first + (rule->wday - (sint64)(first + 1) % 7 + 7) % 7 + (rule->week - 1) * 7;
+            while(day >= (sint64)next) day -= 7;
+            return day;
+    }
+}
+
+// add periods of posix rule after the last period for 400 years and one more year, so that later times can be moved
+// back by whole cycles, zone without transitions takes the rule from year 1
+// return 0 on success, non-0 on error
+sint8 tzinfo_expand_posix(tzinfo_zone *zone, const tzinfo_posix *posix)
+{
+    sint64 last = zone->start[zone->n - 1], s, e;
+    uint64 year, jan1;
+
+    if(!posix->has_dst) return tzinfo_add_period(zone, zone->n > 1 ? last + 1 : 0, posix->std);
+
+    year = zone->n > 1 ? grigorian_extract_year((uint64)last) : 1;
+
+    for(uint64 y = year; y <= year + TZINFO_CYCLE_YEARS + 1; y++)
+    {
+        // rule times are local times before the transition
+        s = tzinfo_rule_day(&posix->start, y) * TZINFO_SECONDS_IN_DAY + posix->start.time - posix->std;
+        e = tzinfo_rule_day(&posix->end, y) * TZINFO_SECONDS_IN_DAY + posix->end.time - posix->dst;
+
+        // daylight saving time of southern hemisphere ends in the first half of year
+        if(s < e)
+        {
+            if(s > last && 0 != tzinfo_add_period(zone, s, posix->dst)) return 1;
+            if(e > last && 0 != tzinfo_add_period(zone, e, posix->std)) return 1;
+        }
+        else
+        {
+            if(e > last && 0 != tzinfo_add_period(zone, e, posix->std)) return 1;
+            if(s > last && 0 != tzinfo_add_period(zone, s, posix->dst)) return 1;
+        }
+    }
+
+    grigorian_make_date(&jan1, year + 1, 1, 1);
+    zone->cycle_start = (sint64)jan1;
+    zone->cycle_end = zone->cycle_start + TZINFO_CYCLE;
+
+    return 0;
+}
+
+// set local start of each period
+void tzinfo_finish(tzinfo_zone *zone)
+{
+    for(uint32 i = 1; i < zone->n; i++)
+    {
+        zone->local_start[i] = zone->start[i] + zone->offset[i] * 60;
+    }
+}
+
+tzinfo_zone *tzinfo_create_posix(const achar *tz)
+{
+    tzinfo_posix posix;
+    tzinfo_zone *zone;
+
+    if(0 != tzinfo_parse_posix(tz, &posix))
+    {
+        error_set(ERROR_INVALID_TIME_ZONE);
+        return NULL;
+    }
+
+    zone = tzinfo_alloc(2 * (TZINFO_CYCLE_YEARS + 2) + 1);
+    if(zone == NULL) return NULL;
+
+    zone->offset[0] = (sint16)(posix.std / 60);
+    if(0 != tzinfo_expand_posix(zone, &posix))
+    {
+        free(zone);
+        error_set(ERROR_INVALID_TIME_ZONE);
+        return NULL;
+    }
+    tzinfo_finish(zone);
+
+    return zone;
+}
+
+// counts of TZif header
+typedef struct _tzinfo_counts
+{
+    uint32 isutcnt;
+    uint32 isstdcnt;
+    uint32 leapcnt;
+    uint32 timecnt;
+    uint32 typecnt;
+    uint32 charcnt;
+} tzinfo_counts;
+
+// read TZif header at data of sz bytes and return size of data block which follows it with times of tsz bytes
+// return 0 on success, non-0 on error
+sint8 tzinfo_read_header(const uint8 *data, uint64 sz, uint32 tsz, tzinfo_counts *c, uint64 *block_sz)
+{
+    if(sz < TZINFO_HEADER_SZ || 0 != memcmp(data, "TZif", 4)) return 1;
+
+    c->isutcnt  = (uint32)tzinfo_get(data + 20, 4);
+    c->isstdcnt = (uint32)tzinfo_get(data + 24, 4);
+    c->leapcnt  = (uint32)tzinfo_get(data + 28, 4);
+    c->timecnt  = (uint32)tzinfo_get(data + 32, 4);
+    c->typecnt  = (uint32)tzinfo_get(data + 36, 4);
+    c->charcnt  = (uint32)tzinfo_get(data + 40, 4);
+
+    *block_sz = (uint64)c->timecnt * (tsz + 1) + (uint64)c->typecnt * TZINFO_TYPE_SZ + c->charcnt
+        + (uint64)c->leapcnt * (tsz + 4) + c->isstdcnt + c->isutcnt;
+
+    return c->typecnt == 0 || *block_sz > sz - TZINFO_HEADER_SZ;
+}
+
+tzinfo_zone *tzinfo_create(const uint8 *data, uint64 sz)
+{
+    const uint8 *times, *idx, *types, *footer, *eol;
+    tzinfo_counts c;
+    tzinfo_posix posix;
+    tzinfo_zone *zone;
+    achar tz[TZINFO_POSIX_MAX_LEN + 1];
+    uint64 block_sz;
+    uint32 tsz = 4, i;
+    sint64 t;
+    sint8 res = 0;
+
+    if(0 != tzinfo_read_header(data, sz, tsz, &c, &block_sz))
+    {
+        error_set(ERROR_INVALID_TIME_ZONE);
+        return NULL;
+    }
+
+    // version 2 and later repeat data with 64-bit times after data of version 1
+    if(data[4] >= '2')
+    {
+        data += TZINFO_HEADER_SZ + block_sz;
+        sz -= TZINFO_HEADER_SZ + block_sz;
+        tsz = 8;
+        if(0 != tzinfo_read_header(data, sz, tsz, &c, &block_sz))
+        {
+            error_set(ERROR_INVALID_TIME_ZONE);
+            return NULL;
+        }
+    }
+
+    times = data + TZINFO_HEADER_SZ;
+    idx = times + (uint64)c.timecnt * tsz;
+    types = idx + c.timecnt;
+    footer = data + TZINFO_HEADER_SZ + block_sz;
+
+    zone = tzinfo_alloc(c.timecnt + 2 * (TZINFO_CYCLE_YEARS + 2) + 1);
+    if(zone == NULL) return NULL;
+
+    // local time before the first transition is of the first type
+    tzinfo_add_period(zone, 0, (sint32)tzinfo_get(types, 4));
+
+    for(i = 0; i < c.timecnt && res == 0; i++)
+    {
+        t = tsz == 4 ? (sint64)(sint32)tzinfo_get(times + i * tsz, tsz) : (sint64)tzinfo_get(times + i * tsz, tsz);
+        // times far in the past don't fit after the shift
+        t = t < -TZINFO_UNIX_EPOCH ? 0 : t + TZINFO_UNIX_EPOCH;
+
+        res = idx[i] >= c.typecnt || 0 != tzinfo_add_period(zone, t, (sint32)tzinfo_get(types + idx[i] * TZINFO_TYPE_SZ, 4));
+    }
+
+    // footer of version 2 and later: newline, POSIX TZ string for times after the last transition, newline
+    if(res == 0 && tsz == 8 && footer < data + sz && *footer == '\n')
+    {
+        eol = memchr(footer + 1, '\n', data + sz - footer - 1);
+        res = eol == NULL || eol - footer - 1 > TZINFO_POSIX_MAX_LEN;
+        if(res == 0 && eol - footer > 1)
+        {
+            memcpy(tz, footer + 1, eol - footer - 1);
+            tz[eol - footer - 1] = _ach('\0');
+            res = 0 != tzinfo_parse_posix(tz, &posix) || 0 != tzinfo_expand_posix(zone, &posix);
+        }
+    }
+
+    if(res != 0)
+    {
+        free(zone);
+        error_set(ERROR_INVALID_TIME_ZONE);
+        return NULL;
+    }
+
+    tzinfo_finish(zone);
+
+    return zone;
+}
+
+tzinfo_zone *tzinfo_load(const achar *name)
+{
+    achar path[TZINFO_MAX_PATH_LEN];
+    tzinfo_zone *zone = NULL;
+    uint8 *data;
+    FILE *f;
+    long sz;
+
+    // name must stay inside of the database directory
+    if(name[0] == _ach('\0') || name[0] == _ach('/') || NULL != strstr(name, _ach(".."))
+        || snprintf(path, sizeof(path), "%s/%s", config_get_str(CONFIG_TZ_DIR), name) >= (int)sizeof(path))
+    {
+        error_set(ERROR_INVALID_TIME_ZONE);
+        return NULL;
+    }
+
+    f = fopen(path, "rb");
+    if(f == NULL)
+    {
+        error_set(ERROR_INVALID_TIME_ZONE);
+        return NULL;
+    }
+
+    if(0 != fseek(f, 0, SEEK_END) || (sz = ftell(f)) <= 0 || sz > TZINFO_MAX_FILE_SZ || 0 != fseek(f, 0, SEEK_SET))
+    {
+        fclose(f);
+        error_set(ERROR_INVALID_TIME_ZONE);
+        return NULL;
+    }
+
+    data = (uint8 *)malloc(sz);
+    if(data == NULL)
+    {
+        fclose(f);
+        error_set(ERROR_OUT_OF_MEMORY);
+        return NULL;
+    }
+
+    if(fread(data, 1, sz, f) == (size_t)sz) zone = tzinfo_create(data, (uint64)sz);
+    else error_set(ERROR_INVALID_TIME_ZONE);
+
+    free(data);
+    fclose(f);
+
+    return zone;
+}
+
+void tzinfo_destroy(tzinfo_zone *zone)
+{
+    free(zone);
+}
+
+
+// return index of the last of n starts which is not greater than s, start[0] must not be greater than s
+inline uint32 tzinfo_find(const sint64 *start, uint32 n, sint64 s)
+{
+    const sint64 *base = start;
+    uint32 half;
+
+    while(n > 1)
+    {
+        half = n / 2;
+        base = base[half] <= s ? base + half : base;
+        n -= half;
+    }
+
+    return (uint32)(base - start);
+}
+
+// return s moved back by whole 400-year cycles into periods of zone
+inline sint64 tzinfo_reduce(const tzinfo_zone *zone, sint64 s)
+{
+    return zone->cycle_end > 0 && s >= zone->cycle_end ? zone->cycle_start + (s - zone->cycle_start) % TZINFO_CYCLE : s;
+}
+
+// return index of period of UTC second s, period i is checked first
+inline uint32 tzinfo_find_utc(const tzinfo_zone *zone, sint64 s, uint32 i)
+{
+    if(zone->start[i] <= s && (i + 1 == zone->n || s < zone->start[i + 1])) return i;
+    return tzinfo_find(zone->start, zone->n, s);
+}
+
+// return index of period of local second s, period i is checked first
+inline uint32 tzinfo_find_local(const tzinfo_zone *zone, sint64 s, uint32 i)
+{
+    if(zone->local_start[i] > s || (i + 1 < zone->n && s >= zone->local_start[i + 1])) i = tzinfo_find(zone->local_start, zone->n, s);
+    return i;
+}
+
+// return ts shifted by minutes, times before 0001-01-01 are set to 0001-01-01
+inline uint64 tzinfo_shift(uint64 ts, sint16 minutes)
+{
+    sint64 v = (sint64)ts + minutes * TZINFO_USEC_IN_MIN;
+    return v < 0 ? 0 : (uint64)v;
+}
+
+// return offset of local time of period i for local second s, the earlier of two instants is taken for repeated time
+inline sint16 tzinfo_local_offset(const tzinfo_zone *zone, sint64 s, uint32 i)
+{
+    return i > 0 && s < zone->start[i] + zone->offset[i - 1] * 60 ? zone->offset[i - 1] : zone->offset[i];
+}
+
+sint16 tzinfo_offset(const tzinfo_zone *zone, uint64 ts)
+{
+    return zone->offset[tzinfo_find(zone->start, zone->n, tzinfo_reduce(zone, (sint64)(ts / TZINFO_USEC_IN_SEC)))];
+}
+
+uint64 tzinfo_to_local(const tzinfo_zone *zone, uint64 ts, sint16 *tz)
+{
+    *tz = tzinfo_offset(zone, ts);
+    return tzinfo_shift(ts, *tz);
+}
+
+uint64 tzinfo_to_utc(const tzinfo_zone *zone, uint64 ts, sint16 *tz)
+{
+    sint64 s = tzinfo_reduce(zone, (sint64)(ts / TZINFO_USEC_IN_SEC));
+
+    *tz = tzinfo_local_offset(zone, s, tzinfo_find(zone->local_start, zone->n, s));
+    return tzinfo_shift(ts, (sint16)-*tz);
+}
+
+void tzinfo_to_local_batch(const tzinfo_zone *zone, const uint64 *ts, uint32 n, uint64 *local, sint16 *tz)
+{
+    uint32 p = 0;
+
+    for(uint32 i = 0; i < n; i++)
+    {
+        p = tzinfo_find_utc(zone, tzinfo_reduce(zone, (sint64)(ts[i] / TZINFO_USEC_IN_SEC)), p);
+        tz[i] = zone->offset[p];
+        local[i] = tzinfo_shift(ts[i], tz[i]);
+    }
+}
+
+void tzinfo_to_utc_batch(const tzinfo_zone *zone, const uint64 *ts, uint32 n, uint64 *utc, sint16 *tz)
+{
+    uint32 p = 0;
+    sint64 s;
+
+    for(uint32 i = 0; i < n; i++)
+    {
+        s = tzinfo_reduce(zone, (sint64)(ts[i] / TZINFO_USEC_IN_SEC));
+        p = tzinfo_find_local(zone, s, p);
+        tz[i] = tzinfo_local_offset(zone, s, p);
+        utc[i] = tzinfo_shift(ts[i], (sint16)-tz[i]);
+    }
+}
@@ -47,6 +47,9 @@ typedef struct _dbclient_session
     uint16          nullable_col_idx;
     handle          pproto_client_session;
     uint32          nulls_sz;
+    uint8           script;                 // 1 if script is being executed
+    uint32          script_succeeded;       // statements succeeded in the last script
+    uint32          script_failed;          // statements failed in the last script
     char            errmes[DBCLIENT_MAX_ERRMES + 1];
     uint8           row_nulls[DBCLIENT_ROW_NULLS_SZ];
     pproto_col_desc rs_columns[DBCLIENT_MAX_COLUMNS];
@@ -192,6 +195,8 @@ int dbclient_make_connection(dbclient_session *ss, const char *host, uint16_t po
 
 void dbclient_close_connection(dbclient_session *ss)
 {
+    pproto_client_discard_held(ss->pproto_client_session);
+
     if(0 != shutdown(ss->sock, SHUT_RDWR))
     {
         dbclient_std_error(ss, "Shutting down connection", errno);
@@ -214,6 +219,13 @@ char *dbclient_last_error(handle session)
 }
 
 
+void dbclient_script_summary(handle session, uint32 *succeeded, uint32 *failed)
+{
+    *succeeded = ((dbclient_session *)session)->script_succeeded;
+    *failed = ((dbclient_session *)session)->script_failed;
+}
+
+
 // close connection and process errors
 void dbclient_termination_with_err(dbclient_session *ss, const char* context)
 {
@@ -409,7 +421,7 @@ dbclient_return_code dbclient_begin_statement(handle session)
 {
     dbclient_session *ss = (dbclient_session *)session;
 
-    if(DBCLIENT_STATE_CONNECTED != ss->state)
+    if(DBCLIENT_STATE_AUTHENTICATED != ss->state)
     {
         strncpy(ss->errmes, "Client must be authenticated and not executing statement", DBCLIENT_MAX_ERRMES + 1);
         dbclient_spill_errmes(ss);
@@ -423,6 +435,34 @@ dbclient_return_code dbclient_begin_statement(handle session)
         return DBCLIENT_RETURN_ERROR;
     }
 
+    ss->script = 0;
+    ss->state = DBCLIENT_STATE_STATEMENT;
+
+    return DBCLIENT_RETURN_SUCCESS;
+}
+
+
+dbclient_return_code dbclient_begin_script(handle session, uint8 on_error)
+{
+    dbclient_session *ss = (dbclient_session *)session;
+
+    if(DBCLIENT_STATE_AUTHENTICATED != ss->state)
+    {
+        strncpy(ss->errmes, "Client must be authenticated and not executing statement", DBCLIENT_MAX_ERRMES + 1);
+        dbclient_spill_errmes(ss);
+        return DBCLIENT_RETURN_ERROR;
+    }
+
+    if(pproto_client_sql_script_begin(ss->pproto_client_session, on_error) != 0)
+    {
+        dbclient_pproto_client_error(ss, "Sending script text to server");
+        dbclient_spill_errmes(ss);
+        return DBCLIENT_RETURN_ERROR;
+    }
+
+    ss->script = 1;
+    ss->script_succeeded = 0;
+    ss->script_failed = 0;
     ss->state = DBCLIENT_STATE_STATEMENT;
 
     return DBCLIENT_RETURN_SUCCESS;
@@ -439,7 +479,8 @@ dbclient_return_code dbclient_statement(handle session, const uint8 *buf, uint32
         return DBCLIENT_RETURN_ERROR;
     }
 
-    sint8 res = pproto_client_poll(ss->pproto_client_session);
+    // results of script statements are received by protocol client while script is sent and read after the whole script is sent
+    sint8 res = ss->script ? 0 : pproto_client_poll(ss->pproto_client_session);
     if(0 == res)
     {
         if(pproto_client_send_sql_stmt(ss->pproto_client_session, buf, len) != 0)
@@ -468,9 +509,9 @@ dbclient_return_code dbclient_statement(handle session, const uint8 *buf, uint32
 dbclient_return_code dbclient_finish_statement(handle session)
 {
     dbclient_session *ss = (dbclient_session *)session;
-    if(DBCLIENT_STATE_CONNECTED != ss->state)
+    if(DBCLIENT_STATE_STATEMENT != ss->state)
     {
-        strncpy(ss->errmes, "Client must be authenticated", DBCLIENT_MAX_ERRMES + 1);
+        strncpy(ss->errmes, "Client must begin statement", DBCLIENT_MAX_ERRMES + 1);
         dbclient_spill_errmes(ss);
         return DBCLIENT_RETURN_ERROR;
     }
@@ -511,12 +552,33 @@ dbclient_return_code dbclient_execution_status(handle session)
     }
     else if(msg_type == PPROTO_SUCCESS_WITH_TEXT_MSG)
     {
+        if(!ss->script) ss->state = DBCLIENT_STATE_AUTHENTICATED;
         return DBCLIENT_RETURN_SUCCESS_MSG;
     }
     else if(msg_type == PPROTO_SUCCESS_WITHOUT_TEXT_MSG)
     {
+        if(!ss->script) ss->state = DBCLIENT_STATE_AUTHENTICATED;
         return DBCLIENT_RETURN_SUCCESS;
     }
+    else if(msg_type == PPROTO_ERROR_MSG)
+    {
+        if(DBCLIENT_RETURN_SUCCESS != dbclient_server_error(ss)) return DBCLIENT_RETURN_ERROR;
+        dbclient_spill_errmes(ss);
+        if(!ss->script) ss->state = DBCLIENT_STATE_AUTHENTICATED;
+        return DBCLIENT_RETURN_STMT_FAILED;
+    }
+    else if(msg_type == PPROTO_SCRIPT_END_MSG && ss->script)
+    {
+        if(pproto_client_read_script_end(ss->pproto_client_session, &ss->script_succeeded, &ss->script_failed) != 0)
+        {
+            dbclient_pproto_client_error(ss, "Retreiving script summary");
+            dbclient_spill_errmes(ss);
+            return DBCLIENT_RETURN_ERROR;
+        }
+        ss->script = 0;
+        ss->state = DBCLIENT_STATE_AUTHENTICATED;
+        return DBCLIENT_RETURN_SCRIPT_END;
+    }
     else
     {
         dbclient_process_err_msg_type(ss, msg_type, "Retreiving execution status");
@@ -772,7 +834,8 @@ dbclient_return_code dbclient_close_recordset(handle session)
         return DBCLIENT_RETURN_ERROR;
     }
 
-    ss->state = DBCLIENT_STATE_AUTHENTICATED;
+    // results of the next script statements follow
+    ss->state = ss->script ? DBCLIENT_STATE_EXECUTION : DBCLIENT_STATE_AUTHENTICATED;
 
     return DBCLIENT_RETURN_SUCCESS;
 }
@@ -5,6 +5,7 @@
 #include "client/dbclient.h"
 #include "client/printing.h"
 #include "common/strop.h"
+#include "common/fltconv.h"
 #include <stdio.h>
 #include <getopt.h>
 #include <stdlib.h>
@@ -54,6 +55,8 @@ const char *prompt = "ptool> ";
 uint8       strbuf[CLIENT_STRBUF_SZ];
 char        decimal_separator = '.';
 encoding    client_enc;
+char       *script_file = 0;
+uint8       script_on_error = PPROTO_SCRIPT_ON_ERROR_DEFAULT;
 
 
 typedef struct _char_state
@@ -68,6 +71,7 @@ typedef struct _char_state
 void init()
 {
     const char *encname = getenv(CLIENT_ENCODING_ENVVAR);
+    encoding_init();
     if(NULL != encname)
     {
         client_enc = encoding_idbyname(encname);
@@ -82,13 +86,12 @@ void init()
         printf("%s environment variable is not set, ASCII will be used as default encoding\n", CLIENT_ENCODING_ENVVAR);
         client_enc = ENCODING_ASCII;
     }
-    encoding_init();
     strop_set_encoding(client_enc);
 }
 
 void usage(FILE* fp)
 {
-    fputs("Usage: psql [-h | --help] [-u <user>] [-p [<password>]] [-H --host <host>] [-P --port port>]\n", fp);
+    fputs("Usage: psql [-h | --help] [-u <user>] [-p [<password>]] [-H --host <host>] [-P --port port>] [-f --file <file>] [-E --on-error stop|continue]\n", fp);
 }
 
 void show_help()
@@ -100,6 +103,8 @@ void show_help()
     puts("  -u --user      user name");
     puts("  -p --password  ask for password or use option value as a password if specified");
     puts("  -s --server    server host and port");
+    puts("  -f --file      execute script from file as single request; script is also read from stdin if it is not a terminal");
+    puts("  -E --on-error  stop or continue script execution when statement fails; server setting is used by default");
 }
 
 void parse_args(int argc, char **argv)
@@ -116,10 +121,12 @@ void parse_args(int argc, char **argv)
             {"password",optional_argument,  0,  'p'},
             {"host",    required_argument,  0,  'H'},
             {"port",    required_argument,  0,  'P'},
+            {"file",    required_argument,  0,  'f'},
+            {"on-error",required_argument,  0,  'E'},
             {0,         0,                  0,  0}
         };
 
-        c = getopt_long(argc, argv, "hu:p::s:H:P:",
+        c = getopt_long(argc, argv, "hu:p::s:H:P:f:E:",
                  long_options, &option_index);
         if(c == -1)
         {
@@ -165,6 +172,29 @@ void parse_args(int argc, char **argv)
                     exit(1);
                 }
                 break;
+            case 'f':
+                if(0 == optarg)
+                {
+                    usage(stderr);
+                    exit(1);
+                }
+                script_file = optarg;
+                break;
+            case 'E':
+                if(0 != optarg && 0 == strcmp(optarg, "stop"))
+                {
+                    script_on_error = PPROTO_SCRIPT_ON_ERROR_STOP;
+                }
+                else if(0 != optarg && 0 == strcmp(optarg, "continue"))
+                {
+                    script_on_error = PPROTO_SCRIPT_ON_ERROR_CONTINUE;
+                }
+                else
+                {
+                    usage(stderr);
+                    exit(1);
+                }
+                break;
             case '?':
             default:
                 usage(stderr);
@@ -181,19 +211,23 @@ void parse_args(int argc, char **argv)
 }
 
 // read next char from stdin
-char next_char(char_state *chst)
+// return EOF on end of input
+int next_char(char_state *chst)
 {
+    ssize_t len;
+
     while(chst->lineptr >= chst->lineend)
     {
         fputs(prompt, stdout);
-        if(getline(&chst->line, &chst->linelen, stdin) == -1)
+        if((len = getline(&chst->line, &chst->linelen, stdin)) == -1)
         {
-            perror("Failed to read input");
+            if(ferror(stdin)) perror("Failed to read input");
+            return EOF;
         }
         else
         {
             chst->lineptr = chst->line;
-            chst->lineend = chst->line + chst->linelen;
+            chst->lineend = chst->line + len;
         }
     }
 
@@ -287,10 +321,12 @@ sint8 read_and_format_value(handle ss, uint16 c)
             snprintf((char*)strbuf, CLIENT_STRBUF_SZ, "%6d", val.s);
             break;
         case FLOAT:
-            snprintf((char*)strbuf, CLIENT_STRBUF_SZ, "%1.6e", val.f32);
+            sz = fltconv_format_float(val.f32, strbuf);
+            strbuf[sz] = '\0';
             break;
         case DOUBLE_PRECISION:
-            snprintf((char*)strbuf, CLIENT_STRBUF_SZ, "%1.12e", val.f64);
+            sz = fltconv_format_double(val.f64, strbuf);
+            strbuf[sz] = '\0';
             break;
         case DATE:
             if(strop_fmt_date(strbuf, &sz, CLIENT_STRBUF_SZ, CLIENT_DEFAULT_DATE_FMT, val.dt) != 0) return 1;
@@ -386,6 +422,58 @@ sint8 wait_for_execution_completion(handle ss)
     return status;
 }
 
+// send the whole script as single request and print result of each statement
+// return 0 if all statements succeeded, 1 otherwise
+int run_script(handle ss, FILE *fp)
+{
+    size_t sz;
+    uint32 succeeded, failed;
+    dbclient_return_code status;
+
+    if(DBCLIENT_RETURN_SUCCESS != dbclient_begin_script(ss, script_on_error)) return 1;
+
+    while((sz = fread(strbuf, 1, CLIENT_STRBUF_SZ, fp)) > 0)
+    {
+        if(DBCLIENT_RETURN_SUCCESS != dbclient_statement(ss, strbuf, (uint32)sz)) return 1;
+    }
+
+    if(ferror(fp))
+    {
+        perror("Failed to read script");
+        return 1;
+    }
+
+    if(DBCLIENT_RETURN_SUCCESS != dbclient_finish_statement(ss)) return 1;
+
+    do
+    {
+        status = wait_for_execution_completion(ss);
+        switch(status)
+        {
+            case DBCLIENT_RETURN_SUCCESS_RS:
+                get_and_print_recordset(ss);
+                break;
+            case DBCLIENT_RETURN_SUCCESS_MSG:
+
+            case DBCLIENT_RETURN_SUCCESS:
+                puts("Complete");
+                break;
+            case DBCLIENT_RETURN_STMT_FAILED:
+                // error message is already printed
+            case DBCLIENT_RETURN_SCRIPT_END:
+                break;
+            default:
+                return 1;
+        }
+    }
+    while(DBCLIENT_RETURN_SCRIPT_END != status);
+
+    dbclient_script_summary(ss, &succeeded, &failed);
+    printf("Script finished: %u statement(s) succeeded, %u failed\n", succeeded, failed);
+
+    return failed > 0 ? 1 : 0;
+}
+
 int main(int argc, char **argv)
 {
     puts("=== Persistence command line tool v0.1 ===");
@@ -457,8 +545,27 @@ int main(int argc, char **argv)
 
     if(DBCLIENT_RETURN_SUCCESS != dbclient_authenticate(ss, user, password)) return 1;
 
+    if(0 != script_file || !isatty(STDIN_FILENO))
+    {
+        FILE *fp = stdin;
+        int res;
+
+        if(0 != script_file && NULL == (fp = fopen(script_file, "r")))
+        {
+            perror("Failed to open script file");
+            return 1;
+        }
+
+        res = run_script(ss, fp);
+        if(stdin != fp) fclose(fp);
+        dbclient_close_session(ss, 1);
+        fflush(NULL);
+
+        return res;
+    }
+
     uint8 in_comment = 0, in_string = 0;
-    char ch;
+    int ch;
     int aborted = 0;
     char_state chst;
     memset(&chst, 0, sizeof(chst));
@@ -467,7 +574,7 @@ int main(int argc, char **argv)
 
     while(!aborted)
     {
-        ch = next_char(&chst);
+        if((ch = next_char(&chst)) == EOF) break;
         if(in_string == 2)  // check for escape sequence for ' inside string
         {
             if(ch == '\'') in_string = 1;
@@ -505,6 +612,9 @@ int main(int argc, char **argv)
                 {
                     aborted = 1;
                 }
+
+                // delimiter is not part of the statement
+                continue;
             }
             else if(ch == '\'')
             {
@@ -522,7 +632,8 @@ int main(int argc, char **argv)
         }
 
         // send statement char to server
-        if(DBCLIENT_RETURN_SUCCESS != dbclient_statement(ss, (const uint8 *)&ch, sizeof(char)))
+        char c = (char)ch;
+        if(DBCLIENT_RETURN_SUCCESS != dbclient_statement(ss, (const uint8 *)&c, sizeof(c)))
         {
             aborted = 1;
         }
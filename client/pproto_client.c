@@ -3,6 +3,7 @@
 #include <sys/socket.h>
 #include <arpa/inet.h>
 #include <string.h>
+#include <stdlib.h>
 #include <errno.h>
 #include <assert.h>
 #include <poll.h>
@@ -30,6 +31,11 @@ typedef struct
     uint32 send_buf_ptr;
 
     uint8 next_chunk_len;
+    uint8 drain;                // 1 if data received while sending is kept in held buffer (script is being sent)
+    uint8 *held;                // data received while sending, it is read before socket
+    uint64 held_sz;
+    uint64 held_ptr;
+    uint64 held_cap;
     char errmes[PPROTO_MAX_ERRMES];
     uint8 recv_buf[PPROTO_CLIENT_RECV_BUF_SIZE];
     uint8 send_buf[PPROTO_CLIENT_SEND_BUF_SIZE];
@@ -54,6 +60,10 @@ handle pproto_client_create(void *ss_buf, int sock)
     state->recv_buf_upper_bound = 0;
     state->send_buf_ptr = 0;
 
+    state->drain = 0;
+    state->held = NULL;
+    state->held_sz = state->held_ptr = state->held_cap = 0;
+
     return (handle)state;
 }
 
@@ -63,13 +73,86 @@ void pproto_client_set_sock(handle ss, int sock)
     state->sock = sock;
 }
 
+void pproto_client_discard_held(handle ss)
+{
+    pproto_client_state *state = (pproto_client_state *)ss;
+
+    free(state->held);
+    state->held = NULL;
+    state->held_sz = state->held_ptr = state->held_cap = 0;
+}
+
+// receive data available on socket into held buffer
+// return 0 on success, non 0 otherwise
+sint8 pproto_client_hold_portion(pproto_client_state *state)
+{
+    ssize_t readsz;
+    uint8 *held;
+    uint64 cap;
+
+    if(state->held_cap - state->held_sz < PPROTO_CLIENT_RECV_BUF_SIZE)
+    {
+        cap = state->held_cap * 2 + PPROTO_CLIENT_RECV_BUF_SIZE;
+        if((held = (uint8 *)realloc(state->held, cap)) == NULL) return 1;
+        state->held = held;
+        state->held_cap = cap;
+    }
+
+    readsz = recv(state->sock, state->held + state->held_sz, state->held_cap - state->held_sz, MSG_DONTWAIT);
+    if(readsz < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return 0;
+    if(readsz <= 0) return 1;
+    state->held_sz += (uint64)readsz;
+
+    return 0;
+}
+
+// send data and at the same time receive whatever server sends into held buffer,
+// so that server never blocks on sending results while it has not read the whole request yet
+// return 0 on success, non 0 otherwise
+sint8 pproto_client_send_draining(pproto_client_state *state, const uint8 *data, uint64 sz)
+{
+    struct pollfd fds;
+    ssize_t written;
+
+    fds.fd = state->sock;
+    fds.events = POLLIN | POLLOUT;
+
+    while(sz > 0u)
+    {
+        if(poll(&fds, 1, -1) <= 0) return 1;
+
+        if(fds.revents & POLLIN)
+        {
+            if(pproto_client_hold_portion(state) != 0) return 1;
+        }
+        else if(fds.revents & POLLOUT)
+        {
+            written = send(state->sock, data, sz, MSG_DONTWAIT);
+            if(written < 0 && errno != EAGAIN && errno != EWOULDBLOCK) return 1;
+            if(written > 0)
+            {
+                data += written;
+                sz -= (uint64)written;
+            }
+        }
+        else
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
 sint8 pproto_client_send_fully(handle ss, const void *data, uint64 sz)
 {
     pproto_client_state *state = (pproto_client_state *)ss;
     ssize_t written;
     uint64 total_written = 0u;
 
-    while(sz > total_written && (written = send(state->sock, data, sz - total_written, 0)) > 0)
+    if(state->drain) return pproto_client_send_draining(state, (const uint8 *)data, sz);
+
+    while(sz > total_written && (written = send(state->sock, (const uint8 *)data + total_written, sz - total_written, 0)) > 0)
     {
         total_written += (uint64)written;
     }
@@ -95,6 +178,17 @@ sint8 pproto_client_read_portion(handle ss)
         state->recv_buf_upper_bound = 0u;
     }
 
+    // data received while sending goes first
+    if(state->held_ptr < state->held_sz)
+    {
+        if(leftsz > state->held_sz - state->held_ptr) leftsz = (uint32)(state->held_sz - state->held_ptr);
+        memcpy(state->recv_buf + state->recv_buf_upper_bound, state->held + state->held_ptr, leftsz);
+        state->recv_buf_upper_bound += leftsz;
+        state->held_ptr += leftsz;
+        if(state->held_ptr == state->held_sz) pproto_client_discard_held(ss);
+        return 0;
+    }
+
     readsz = recv(state->sock, state->recv_buf + state->recv_buf_upper_bound, leftsz, 0);
     if(readsz <= 0)
     {
@@ -158,7 +252,7 @@ sint8 pproto_client_send(handle ss, const uint8 *buf, uint32 sz)
         }
 
         diff = state->send_buf_size - state->send_buf_ptr;
-        cpsz = (diff > sz) ? sz : diff;
+        cpsz = (diff > sz - wr) ? sz - wr : diff;
         memcpy(state->send_buf + state->send_buf_ptr, buf + wr, cpsz);
         wr += cpsz;
         state->send_buf_ptr += cpsz;
@@ -586,6 +680,9 @@ pproto_msg_type pproto_client_read_msg_type(handle ss)
         case PPROTO_GOODBYE_MESSAGE:
             return PPROTO_GOODBYE_MSG;
             break;
+        case PPROTO_SCRIPT_END_MESSAGE_MAGIC:
+            return PPROTO_SCRIPT_END_MSG;
+            break;
         default:
             return PPROTO_UNKNOWN_MSG;
     }
@@ -652,6 +749,30 @@ sint8 pproto_client_sql_stmt_begin(handle ss)
 }
 
 
+sint8 pproto_client_sql_script_begin(handle ss, uint8 on_error)
+{
+    uint8 magics[3] = {PPROTO_SQL_SCRIPT_MESSAGE_MAGIC, on_error, PPROTO_UTEXT_STRING_MAGIC};
+
+    // server sends result of each statement as soon as it is executed, results are drained until script is sent
+    ((pproto_client_state *)ss)->drain = 1;
+    return pproto_client_send(ss, magics, sizeof(magics));
+}
+
+
+sint8 pproto_client_read_script_end(handle ss, uint32 *succeeded, uint32 *failed)
+{
+    uint32 v1, v2;
+
+    if(0 != pproto_client_get(ss, (uint8 *)&v1, sizeof(v1))) return 1;
+    if(0 != pproto_client_get(ss, (uint8 *)&v2, sizeof(v2))) return 1;
+
+    *succeeded = be32toh(v1);
+    *failed = be32toh(v2);
+
+    return 0;
+}
+
+
 sint8 pproto_client_send_sql_stmt(handle ss, const uint8* data, uint32 sz)
 {
     uint8 len;
@@ -671,10 +792,15 @@ sint8 pproto_client_send_sql_stmt(handle ss, const uint8* data, uint32 sz)
 
 sint8 pproto_client_sql_stmt_finish(handle ss)
 {
+    pproto_client_state *state = (pproto_client_state *)ss;
     uint8 terminator = 0;
+    sint8 res;
+
     if(0 != pproto_client_send(ss, &terminator, sizeof(terminator))) return 1;
 
-    return pproto_client_flush_send(ss);
+    res = pproto_client_flush_send(ss);
+    state->drain = 0;
+    return res;
 }
 
 
@@ -716,6 +842,7 @@ sint8 pproto_client_poll(handle ss)
     pproto_client_state *state = (pproto_client_state *)ss;
 
     if(state->recv_buf_upper_bound - state->recv_buf_ptr > 0) return 1;
+    if(state->held_ptr < state->held_sz) return 1;
 
     struct pollfd fds;
     fds.fd = state->sock;
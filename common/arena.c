@@ -0,0 +1,261 @@
+#include "common/arena.h"
+#include "common/error.h"
+#include "logging/logger.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+
+#define ARENA_ALIGN             (16u)
+#define ARENA_SPILL_FILE_NAME   ("/persistence_arena_XXXXXX")
+#define ARENA_PATH_BUF_SZ       (4096)
+
+
+// chunk of memory, allocated elements follow the header
+typedef struct _arena_chunk arena_chunk;
+typedef struct _arena_chunk
+{
+    arena_chunk *next;
+    uint64      sz;         // total chunk size including header
+    uint64      used;       // bytes used including header
+    uint8       spilled;    // 1 if chunk is mapped from spill file
+} arena_chunk;
+
+
+typedef struct _arena_state
+{
+    arena_chunk     *head;          // current chunk, allocations are taken from it first
+    uint64          mem_budget;
+    uint64          mem_sz;         // heap bytes taken by chunks
+    uint64          spilled_sz;     // spill file size
+    const achar     *spill_dir;
+    int             spill_fd;       // -1 if spill file is not created yet
+} arena_state;
+
+
+// size of header rounded up to alignment
+#define ARENA_HEADER_SZ     ((sizeof(arena_chunk) + ARENA_ALIGN - 1) & ~((uint64)ARENA_ALIGN - 1))
+
+
+// return size of the buffer for arena initialization
+size_t arena_get_alloc_sz()
+{
+    return sizeof(arena_state);
+}
+
+
+// create arena using buffer buf
+// return NULL on error
+handle arena_create(void *buf, uint64 mem_budget, const achar *spill_dir)
+{
+    arena_state *as = (arena_state *)buf;
+
+    if(NULL == as) return NULL;
+
+    as->head = NULL;
+    as->mem_sz = 0;
+    as->spilled_sz = 0;
+    as->spill_fd = -1;
+    arena_set_budget((handle)as, mem_budget, spill_dir);
+
+    return (handle)as;
+}
+
+
+// change in-memory budget and spill directory
+void arena_set_budget(handle ah, uint64 mem_budget, const achar *spill_dir)
+{
+    arena_state *as = (arena_state *)ah;
+
+    as->mem_budget = mem_budget;
+    as->spill_dir = (NULL == spill_dir) ? ARENA_DEFAULT_SPILL_DIR : spill_dir;
+}
+
+
+// create and immediately unlink spill file, so it disappears with the process
+// return 0 on success, non-0 on error
+sint8 arena_open_spill_file(arena_state *as)
+{
+    achar path[ARENA_PATH_BUF_SZ];
+
+    if(snprintf(path, ARENA_PATH_BUF_SZ, _ach("%s%s"), as->spill_dir, ARENA_SPILL_FILE_NAME) >= ARENA_PATH_BUF_SZ)
+    {
+        logger_error(_ach("arena, spill directory name is too long: %s"), as->spill_dir);
+        return 1;
+    }
+
+    if((as->spill_fd = mkstemp(path)) == -1)
+    {
+        logger_error(_ach("arena, failed to create spill file in %s: %s"), as->spill_dir, strerror(errno));
+        return 1;
+    }
+
+    if(unlink(path) != 0)
+    {
+        logger_warn(_ach("arena, failed to unlink spill file %s: %s"), path, strerror(errno));
+    }
+
+    return 0;
+}
+
+
+// allocate new chunk of at least sz bytes (including header)
+// return NULL on error
+arena_chunk *arena_new_chunk(arena_state *as, uint64 sz)
+{
+    arena_chunk *chunk;
+    uint64 page_sz;
+
+    if(sz <= ARENA_MEM_CHUNK_SZ) sz = ARENA_MEM_CHUNK_SZ;
+
+    if(as->mem_sz + sz <= as->mem_budget)
+    {
+        if((chunk = (arena_chunk *)malloc(sz)) == NULL) return NULL;
+        chunk->spilled = 0;
+        as->mem_sz += sz;
+    }
+    else
+    {
+        if(-1 == as->spill_fd && arena_open_spill_file(as) != 0) return NULL;
+
+        if(sz <= ARENA_SPILL_CHUNK_SZ) sz = ARENA_SPILL_CHUNK_SZ;
+        page_sz = (uint64)sysconf(_SC_PAGESIZE);
+        sz = (sz + page_sz - 1) / page_sz * page_sz;
+
+        if(ftruncate(as->spill_fd, as->spilled_sz + sz) != 0)
+        {
+            logger_error(_ach("arena, failed to extend spill file: %s"), strerror(errno));
+            return NULL;
+        }
+
+        chunk = (arena_chunk *)mmap(NULL, sz, PROT_READ | PROT_WRITE, MAP_SHARED, as->spill_fd, as->spilled_sz);
+        if(MAP_FAILED == (void *)chunk)
+        {
+            logger_error(_ach("arena, failed to map spill file: %s"), strerror(errno));
+            return NULL;
+        }
+        chunk->spilled = 1;
+        as->spilled_sz += sz;
+    }
+
+    chunk->sz = sz;
+    chunk->used = ARENA_HEADER_SZ;
+    chunk->next = as->head;
+    as->head = chunk;
+
+    return chunk;
+}
+
+
+// allocate zero-filled element of size sz
+// return pointer to the element or NULL on error
+void *arena_alloc(handle ah, size_t sz)
+{
+    arena_state *as = (arena_state *)ah;
+    arena_chunk *chunk = as->head;
+    void *ptr;
+
+    sz = (sz + ARENA_ALIGN - 1) & ~((size_t)ARENA_ALIGN - 1);
+
+    if(NULL == chunk || chunk->sz - chunk->used < sz)
+    {
+        if((chunk = arena_new_chunk(as, ARENA_HEADER_SZ + sz)) == NULL)
+        {
+            error_set(ERROR_OUT_OF_MEMORY);
+            return NULL;
+        }
+    }
+
+    ptr = (uint8 *)chunk + chunk->used;
+    chunk->used += sz;
+
+    // spilled chunks come zero-filled from the file
+    if(!chunk->spilled) memset(ptr, 0, sz);
+
+    return ptr;
+}
+
+
+// release chunks, keep the first in-memory chunk for reuse if keep_first is set and budget allows
+void arena_release(arena_state *as, uint8 keep_first)
+{
+    arena_chunk *chunk = as->head, *next, *first = NULL;
+
+    while(NULL != chunk)
+    {
+        next = chunk->next;
+
+        if(chunk->spilled)
+        {
+            munmap(chunk, chunk->sz);
+        }
+        else if(keep_first && NULL == next && chunk->sz == ARENA_MEM_CHUNK_SZ && chunk->sz <= as->mem_budget)
+        {
+            first = chunk;
+        }
+        else
+        {
+            as->mem_sz -= chunk->sz;
+            free(chunk);
+        }
+
+        chunk = next;
+    }
+
+    if(as->spilled_sz > 0)
+    {
+        if(ftruncate(as->spill_fd, 0) != 0)
+        {
+            logger_warn(_ach("arena, failed to truncate spill file: %s"), strerror(errno));
+        }
+        as->spilled_sz = 0;
+    }
+
+    if(NULL != first)
+    {
+        first->used = ARENA_HEADER_SZ;
+        first->next = NULL;
+    }
+    as->head = first;
+}
+
+
+// release all elements allocated so far
+void arena_reset(handle ah)
+{
+    arena_release((arena_state *)ah, 1);
+}
+
+
+// release all resources
+void arena_destroy(handle ah)
+{
+    arena_state *as = (arena_state *)ah;
+
+    arena_release(as, 0);
+    assert(0 == as->mem_sz);
+
+    if(-1 != as->spill_fd)
+    {
+        close(as->spill_fd);
+        as->spill_fd = -1;
+    }
+}
+
+
+// return total number of bytes allocated in memory
+uint64 arena_mem_sz(handle ah)
+{
+    return ((arena_state *)ah)->mem_sz;
+}
+
+
+// return total number of bytes allocated in the spill file
+uint64 arena_spilled_sz(handle ah)
+{
+    return ((arena_state *)ah)->spilled_sz;
+}
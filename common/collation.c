@@ -0,0 +1,168 @@
+#include "common/collation.h"
+#include "common/error.h"
+#include <string.h>
+#include <strings.h>
+
+
+#define COLLATION_ONES          (0x0101010101010101UL)
+#define COLLATION_HIGHS         (0x8080808080808080UL)
+
+// non-0 if word w has zero byte
+#define COLLATION_HAS_ZERO(w)   (((w) - COLLATION_ONES) & ~(w) & COLLATION_HIGHS)
+
+// byte c with latin upper case letter folded to lower case
+#define COLLATION_FOLD(c)       ((uint8)((c) + ((uint8)((c) - 'A') < 26 ? 0x20 : 0)))
+
+
+struct
+{
+    encoding enc;
+} g_collation_state = {ENCODING_UTF8};
+
+
+const achar *g_collation_names[COLLATION_NUM] = {_ach("binary"), _ach("ascii_ci"), _ach("codepoint")};
+
+
+void collation_set_encoding(encoding enc)
+{
+    if(ENCODING_UNKNOWN != enc) g_collation_state.enc = enc;
+}
+
+
+sint8 collation_by_name(const achar *name, collation *coll)
+{
+    for(uint8 i = 0; i < COLLATION_NUM; i++)
+    {
+        if(0 == strcasecmp(name, g_collation_names[i]))
+        {
+            *coll = (collation)i;
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+
+const achar *collation_name(collation coll)
+{
+    return (coll < COLLATION_NUM) ? g_collation_names[coll] : NULL;
+}
+
+
+// check that str of sz bytes is valid in server encoding
+// return 0 if it is valid, non-0 otherwise (error code is set)
+sint8 collation_check_chars(const uint8 *str, uint64 sz)
+{
+    uint64 valid;
+
+    if(encoding_validate(g_collation_state.enc, str, sz, &valid) != CHAR_STATE_COMPLETE)
+    {
+        error_set(ERROR_INVALID_CHARACTER);
+        return 1;
+    }
+
+    return 0;
+}
+
+
+// return word w with latin upper case letters folded to lower case: bit 0x20 is set in every byte of A-Z
+uint64 collation_fold_word(uint64 w)
+{
+    uint64 low7 = w & ~COLLATION_HIGHS;
+    uint64 ge_a = low7 + (0x80 - 'A') * COLLATION_ONES;        // high bit is set if low 7 bits >= 'A'
+    uint64 gt_z = low7 + (0x80 - 'Z' - 1) * COLLATION_ONES;    // high bit is set if low 7 bits > 'Z'
+
+    return w | (((ge_a ^ gt_z) & ~w & COLLATION_HIGHS) >> 2);
+}
+
+
+sint8 collation_cmp(collation coll, const uint8 *str1, uint64 sz1, const uint8 *str2, uint64 sz2, sint8 *res)
+{
+    uint64 sz = (sz1 < sz2) ? sz1 : sz2, i;
+    uint8 c1, c2;
+    int r = 0;
+
+    switch(coll)
+    {
+        case COLLATION_CODEPOINT:
+            // valid strings are in code point order as bytes
+            if(collation_check_chars(str1, sz1) != 0 || collation_check_chars(str2, sz2) != 0) return 1;
+            // fall through
+        case COLLATION_BINARY:
+            r = (sz > 0) ? memcmp(str1, str2, sz) : 0;
+            break;
+        case COLLATION_ASCII_CI:
+            for(i = 0; i < sz; i++)
+            {
+                c1 = COLLATION_FOLD(str1[i]);
+                c2 = COLLATION_FOLD(str2[i]);
+                if(c1 != c2)
+                {
+                    r = (c1 < c2) ? -1 : 1;
+                    break;
+                }
+            }
+            break;
+        default:
+            error_set(ERROR_SEMANTIC_ERROR);
+            return 1;
+    }
+
+    if(0 == r) *res = (sz1 < sz2) ? -1 : ((sz1 > sz2) ? 1 : 0);
+    else *res = (r < 0) ? -1 : 1;
+
+    return 0;
+}
+
+
+sint8 collation_key(collation coll, const uint8 *str, uint64 sz, uint8 *key, uint64 *key_sz)
+{
+    uint8 *k = key, fold, c;
+    uint64 i = 0, w;
+
+    switch(coll)
+    {
+        case COLLATION_CODEPOINT:
+            if(collation_check_chars(str, sz) != 0) return 1;
+            fold = 0;
+            break;
+        case COLLATION_BINARY:
+            fold = 0;
+            break;
+        case COLLATION_ASCII_CI:
+            fold = 1;
+            break;
+        default:
+            error_set(ERROR_SEMANTIC_ERROR);
+            return 1;
+    }
+
+    while(i < sz)
+    {
+        // word without zero byte is copied at once
+        if(i + 8 <= sz)
+        {
+            memcpy(&w, str + i, 8);
+            if(!COLLATION_HAS_ZERO(w))
+            {
+                if(fold) w = collation_fold_word(w);
+                memcpy(k, &w, 8);
+                k += 8;
+                i += 8;
+                continue;
+            }
+        }
+
+        c = str[i++];
+        if(fold) c = COLLATION_FOLD(c);
+        *k++ = c;
+        if(0 == c) *k++ = 0xFF;
+    }
+
+    *k++ = 0;
+    *k++ = 0;
+    *key_sz = (uint64)(k - key);
+
+    return 0;
+}
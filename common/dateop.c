@@ -1,6 +1,7 @@
 #include "common/dateop.h"
 #include "calendar/grigorian.h"
 #include <assert.h>
+#include <string.h>
 
 
 uint64 dateop_trunc_to_year_default_impl(uint64 date)
@@ -28,6 +29,28 @@ uint8 dateop_extract_day_of_month_default_impl(uint64 date)
     return 0;
 }
 
+void dateop_extract_year_batch_default_impl(const uint64 *date, uint32 n, uint64 *year)
+{
+    memset(year, 0, n * sizeof(*year));
+}
+
+void dateop_extract_month_of_year_batch_default_impl(const uint64 *date, uint32 n, uint8 *month)
+{
+    memset(month, 0, n);
+}
+
+void dateop_extract_day_of_month_batch_default_impl(const uint64 *date, uint32 n, uint8 *day)
+{
+    memset(day, 0, n);
+}
+
+void dateop_extract_date_batch_default_impl(const uint64 *date, uint32 n, uint64 *year, uint8 *month, uint8 *day)
+{
+    memset(year, 0, n * sizeof(*year));
+    memset(month, 0, n);
+    memset(day, 0, n);
+}
+
 sint8 dateop_make_date_with_time_default_impl(uint64 *date, uint64 year, uint8 month, uint8 day, uint8 hour, uint8 min, uint8 sec)
 {
     return 0;
@@ -41,6 +64,10 @@ sint8 dateop_make_date_default_impl(uint64 *date, uint64 year, uint8 month, uint
 uint64 (*dateop_extract_year) (uint64 date) = dateop_extract_year_default_impl;
 uint8  (*dateop_extract_month_of_year) (uint64 date) = dateop_extract_month_of_year_default_impl;
 uint8  (*dateop_extract_day_of_month) (uint64 date) = dateop_extract_day_of_month_default_impl;
+void   (*dateop_extract_year_batch) (const uint64 *date, uint32 n, uint64 *year) = dateop_extract_year_batch_default_impl;
+void   (*dateop_extract_month_of_year_batch) (const uint64 *date, uint32 n, uint8 *month) = dateop_extract_month_of_year_batch_default_impl;
+void   (*dateop_extract_day_of_month_batch) (const uint64 *date, uint32 n, uint8 *day) = dateop_extract_day_of_month_batch_default_impl;
+void   (*dateop_extract_date_batch) (const uint64 *date, uint32 n, uint64 *year, uint8 *month, uint8 *day) = dateop_extract_date_batch_default_impl;
 uint64 (*dateop_trunc_to_year) (uint64 date) = dateop_trunc_to_year_default_impl;
 uint8  (*dateop_is_leap_year) (uint64 date) = dateop_is_leap_year_default_impl;
 sint8  (*dateop_make_date_with_time) (uint64 *date, uint64 year, uint8 month, uint8 day, uint8 hour, uint8 min, uint8 sec) = dateop_make_date_with_time_default_impl;
@@ -55,6 +82,10 @@ void dateop_set_calendar(dateop_calendar calendar)
             dateop_extract_year         = grigorian_extract_year;
             dateop_extract_month_of_year = grigorian_extract_month_of_year;
             dateop_extract_day_of_month = grigorian_extract_day_of_month;
+            dateop_extract_year_batch   = grigorian_extract_year_batch;
+            dateop_extract_month_of_year_batch = grigorian_extract_month_of_year_batch;
+            dateop_extract_day_of_month_batch = grigorian_extract_day_of_month_batch;
+            dateop_extract_date_batch   = grigorian_extract_date_batch;
             dateop_trunc_to_year        = grigorian_trunc_to_year;
             dateop_is_leap_year         = grigorian_is_leap_year;
             dateop_make_date_with_time  = grigorian_make_date_with_time;
@@ -64,6 +95,10 @@ void dateop_set_calendar(dateop_calendar calendar)
             dateop_extract_year         = dateop_extract_year_default_impl;
             dateop_extract_month_of_year = dateop_extract_month_of_year_default_impl;
             dateop_extract_day_of_month = dateop_extract_day_of_month_default_impl;
+            dateop_extract_year_batch   = dateop_extract_year_batch_default_impl;
+            dateop_extract_month_of_year_batch = dateop_extract_month_of_year_batch_default_impl;
+            dateop_extract_day_of_month_batch = dateop_extract_day_of_month_batch_default_impl;
+            dateop_extract_date_batch   = dateop_extract_date_batch_default_impl;
             dateop_trunc_to_year        = dateop_trunc_to_year_default_impl;
             dateop_is_leap_year         = dateop_is_leap_year_default_impl;
             dateop_make_date_with_time  = dateop_make_date_with_time_default_impl;
@@ -72,3 +107,27 @@ void dateop_set_calendar(dateop_calendar calendar)
     }
 }
 
+// time of day is calendar independent, seconds of day fit into 32 bits, so the rest is 32-bit arithmetics
+void dateop_extract_hour_batch(const uint64 *date, uint32 n, uint8 *hour)
+{
+    for(uint32 i = 0; i < n; i++)
+    {
+        hour[i] = (uint8)((uint32)(date[i] % 86400) / 3600);
+    }
+}
+
+void dateop_extract_minutes_batch(const uint64 *date, uint32 n, uint8 *min)
+{
+    for(uint32 i = 0; i < n; i++)
+    {
+        min[i] = (uint8)((uint32)(date[i] % 3600) / 60);
+    }
+}
+
+void dateop_extract_seconds_batch(const uint64 *date, uint32 n, uint8 *sec)
+{
+    for(uint32 i = 0; i < n; i++)
+    {
+        sec[i] = (uint8)(date[i] % 60);
+    }
+}
@@ -1,7 +1,9 @@
 #include "common/decimal.h"
 #include "common/error.h"
+#include "common/fltconv.h"
 #include <assert.h>
 #include <string.h>
+#include <stdio.h>
 
 
 // add abs values of two decimals: d3 = d1 + d2
@@ -43,14 +45,15 @@ inline sint16 decimal_abs_cmp(const sint16 *d1, const sint16 *d2)
 // return positive if d1 > d2, negative if d1 < d2, 0 otherwise
 inline sint16 decimal_abs_cmp_with_shift(const sint16 *d1, sint16 n1, const sint16 *d2, sint16 n2)
 {
-    sint16 t1 = DECIMAL_BASE / 10, t2 = DECIMAL_BASE / 10;
+    sint16 t1 = 1, t2 = 1;
     sint16 s;
     sint16 v1, v2;
 
-    s = n1 / DECIMAL_BASE_LOG10;
-    while((s--) > 0) t1 /= 10;
-    s = n2 / DECIMAL_BASE_LOG10;
-    while((s--) > 0) t2 /= 10;
+    // position of the most significant digit inside its part
+    s = (n1 - 1) % DECIMAL_BASE_LOG10;
+    while((s--) > 0) t1 *= 10;
+    s = (n2 - 1) % DECIMAL_BASE_LOG10;
+    while((s--) > 0) t2 *= 10;
 
     for(n1--, n2--; n1 >= 0 && n2 >= 0; n1--, n2--)
     {
@@ -62,6 +65,21 @@ inline sint16 decimal_abs_cmp_with_shift(const sint16 *d1, sint16 n1, const sint
         t2 /= 10;
         if(t2 == 0) t2 = DECIMAL_BASE / 10;
     }
+
+    // the longer mantissa is greater if the rest of it is not zero
+    for(; n1 >= 0; n1--)
+    {
+        if((d1[n1 / DECIMAL_BASE_LOG10] / t1) % 10 != 0) return 1;
+        t1 /= 10;
+        if(t1 == 0) t1 = DECIMAL_BASE / 10;
+    }
+    for(; n2 >= 0; n2--)
+    {
+        if((d2[n2 / DECIMAL_BASE_LOG10] / t2) % 10 != 0) return -1;
+        t2 /= 10;
+        if(t2 == 0) t2 = DECIMAL_BASE / 10;
+    }
+
     return 0;
 }
 
@@ -86,18 +104,6 @@ void decimal_abs_sub(const sint16 *d1, const sint16 *d2, sint16 *d3)
     assert(0 == c);
 }
 
-// multiply d1 by digit d and put result to d3 with overflow
-void decimal_mul_by_digit(const sint16 *d1, sint16 d, sint16 *d3)
-{
-    sint32 i, m;
-    for(i = m = 0; i < DECIMAL_PARTS; i++)
-    {
-        m = d1[i] * d + m / DECIMAL_BASE;
-        d3[i] = (sint16)(m % DECIMAL_BASE);
-    }
-    d3[DECIMAL_PARTS] = m / DECIMAL_BASE;
-}
-
 // shift decimal m to the right by n digits
 void decimal_shift_right(sint16 *m, sint32 n)
 {
@@ -191,9 +197,127 @@ sint16 decimal_num_digits(const sint16 *m)
     return n;
 }
 
-// multiply two decimals: d3 = d1 * d2
+#define DECIMAL_E16             (10000000000000000UL)
+#define DECIMAL_INT64_DIGITS    (18)        // digits of mantissa which can be added as 64-bit integers
+
+// powers of 10 fitting in 64 bits
+const uint64 g_decimal_pow10[20] =
+{
+    1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL,
+    10000000000UL, 100000000000UL, 1000000000000UL, 10000000000000UL, 100000000000000UL,
+    1000000000000000UL, 10000000000000000UL, 100000000000000000UL, 1000000000000000000UL,
+    10000000000000000000UL
+};
+
+// convert 4 limbs of mantissa m to integer
+inline uint64 decimal_limbs_to_uint64(const sint16 *m)
+{
+    return (uint64)m[0] + (uint64)m[1] * 10000UL + (uint64)m[2] * 100000000UL + (uint64)m[3] * 1000000000000UL;
+}
+
+// convert integer v < 10^16 to 4 limbs of mantissa m
+inline void decimal_uint64_to_limbs(uint64 v, sint16 *m)
+{
+    m[0] = (sint16)(v % DECIMAL_BASE);
+    v /= DECIMAL_BASE;
+    m[1] = (sint16)(v % DECIMAL_BASE);
+    v /= DECIMAL_BASE;
+    m[2] = (sint16)(v % DECIMAL_BASE);
+    m[3] = (sint16)(v / DECIMAL_BASE);
+}
+
+// convert absolute value of mantissa of d of up to DECIMAL_INT64_DIGITS digits to integer
+inline uint64 decimal_abs_to_uint64(const decimal *d)
+{
+    return decimal_limbs_to_uint64(d->m) + (uint64)d->m[4] * DECIMAL_E16;
+}
+
+// convert absolute value of mantissa of d to 128-bit integer u
+// return 0 on success, 1 if mantissa has more than DECIMAL_INT128_DIGITS digits
+sint8 decimal_abs_to_uint128(const decimal *d, uint128 *u)
+{
+    if(d->n > DECIMAL_INT128_DIGITS) return 1;
+
+    *u = decimal_limbs_to_uint64(d->m);
+    if(d->n > 4 * DECIMAL_BASE_LOG10)
+    {
+        *u += (uint128)decimal_limbs_to_uint64(d->m + 4) * DECIMAL_E16;
+        if(d->n > 8 * DECIMAL_BASE_LOG10)
+        {
+            *u += (uint128)((uint64)d->m[8] + (uint64)d->m[9] * 10000UL) * DECIMAL_E16 * DECIMAL_E16;
+        }
+    }
+
+    return 0;
+}
+
+// put 128-bit integer u to mantissa of d and set number of digits, u < 10^DECIMAL_POSITIONS
+void decimal_abs_from_uint128(uint128 u, decimal *d)
+{
+    uint128 q;
+    uint64 lo;
+
+    memset(d->m, 0, sizeof(d->m));
+    if(u >> 64 != 0)
+    {
+        // 128-bit division is slow, it is done once for the low 16 digits
+        q = u / DECIMAL_E16;
+        decimal_uint64_to_limbs((uint64)(u - q * DECIMAL_E16), d->m);
+        u = q;
+        if(u >> 64 != 0)
+        {
+            q = u / DECIMAL_E16;
+            decimal_uint64_to_limbs((uint64)(u - q * DECIMAL_E16), d->m + 4);
+            lo = (uint64)q;
+            d->m[8] = (sint16)(lo % DECIMAL_BASE);
+            d->m[9] = (sint16)(lo / DECIMAL_BASE);
+        }
+        else
+        {
+            lo = (uint64)u;
+            decimal_uint64_to_limbs(lo % DECIMAL_E16, d->m + 4);
+            lo /= DECIMAL_E16;
+            d->m[8] = (sint16)(lo % DECIMAL_BASE);
+            d->m[9] = (sint16)(lo / DECIMAL_BASE);
+        }
+    }
+    else
+    {
+        // most of the values, 64-bit divisions only
+        lo = (uint64)u;
+        decimal_uint64_to_limbs(lo % DECIMAL_E16, d->m);
+        lo /= DECIMAL_E16;
+        d->m[4] = (sint16)(lo % DECIMAL_BASE);
+        d->m[5] = (sint16)(lo / DECIMAL_BASE);
+    }
+    d->n = decimal_num_digits(d->m);
+}
+
+// convert mantissa of d with sign to 128-bit integer v, so d = v * 10^d->e
+// return 0 on success, not 0 if mantissa has more than DECIMAL_INT128_DIGITS digits
+sint8 decimal_to_int128(const decimal *d, sint128 *v)
+{
+    uint128 u;
+
+    if(decimal_abs_to_uint128(d, &u) != 0) return 1;
+
+    *v = d->sign == DECIMAL_SIGN_NEG ? -(sint128)u : (sint128)u;
+
+    return 0;
+}
+
+// convert 128-bit integer v with exponent e to decimal d = v * 10^e
+void decimal_from_int128(sint128 v, sint8 e, decimal *d)
+{
+    // |v| < 2^127 < 10^39, it always fits into mantissa
+    decimal_abs_from_uint128(v < 0 ? (uint128)0 - (uint128)v : (uint128)v, d);
+    d->sign = v < 0 ? DECIMAL_SIGN_NEG : DECIMAL_SIGN_POS;
+    d->e = d->n == 0 ? 0 : e;
+}
+
+// multiply two decimals on limbs: d3 = d1 * d2
 // return 0 on success, not 0 on error
-sint8 decimal_mul(const decimal *d1, const decimal *d2, decimal *d3)
+sint8 decimal_mul_limbs(const decimal *d1, const decimal *d2, decimal *d3)
 {
     sint32 m, k = 0, n, nd, i, j, e = (sint32)d1->e + (sint32)d2->e;
     sint16 d1mi;
@@ -235,15 +359,19 @@ sint8 decimal_mul(const decimal *d1, const decimal *d2, decimal *d3)
         nd = n % DECIMAL_BASE_LOG10;
         n = (n + DECIMAL_BASE_LOG10 - 1) / DECIMAL_BASE_LOG10 - DECIMAL_PARTS;
 
-        decimal_shift_left(m3 + n, DECIMAL_BASE_LOG10 - nd);
-
-        k = DECIMAL_BASE;
-        while(nd > 0)
+        // the most significant limb has nd digits, the rest are taken from the top of the limb below
+        if(nd > 0)
         {
-            k /= 10;
-            nd--;
+            decimal_shift_left(m3 + n, DECIMAL_BASE_LOG10 - nd);
+
+            k = 1;
+            while(nd > 0)
+            {
+                k *= 10;
+                nd--;
+            }
+            m3[n] += m3[n - 1] / k;
         }
-        m3[n] += m3[n - 1] / k;
 
         d3->n = DECIMAL_POSITIONS;
     }
@@ -267,22 +395,99 @@ sint8 decimal_mul(const decimal *d1, const decimal *d2, decimal *d3)
 }
 
 
-// divide d1 by d2: d3 = d1 / d2
+// multiply two decimals: d3 = d1 * d2
 // return 0 on success, not 0 on error
-sint8 decimal_div(const decimal *d1, const decimal *d2, decimal *d3)
+sint8 decimal_mul(const decimal *d1, const decimal *d2, decimal *d3)
 {
-    // Knuth's division
-    sint32 d, c, i, j, n, m, e, qh, l, k, rh, p;
-    sint16 buf[DECIMAL_PARTS * 3 + 3], v1, v2;
-    sint16 *n1 = buf + 2 + DECIMAL_PARTS, *n2 = buf + DECIMAL_PARTS * 2 + 3, *n1j;
+    sint32 e = (sint32)d1->e + (sint32)d2->e;
+    uint128 u1, u2;
+
+    // product of less than DECIMAL_INT128_DIGITS digits fits into 128 bits
+    if((sint32)d1->n + (sint32)d2->n > DECIMAL_INT128_DIGITS
+        || decimal_abs_to_uint128(d1, &u1) != 0 || decimal_abs_to_uint128(d2, &u2) != 0)
+    {
+        return decimal_mul_limbs(d1, d2, d3);
+    }
+
+    if(e > DECIMAL_MAX_EXPONENT || e < DECIMAL_MIN_EXPONENT)
+    {
+        error_set(ERROR_DECIMAL_OVERFLOW);
+        return 1;
+    }
+
+    d3->sign = ((d1->sign == d2->sign || d1->n == 0) ? DECIMAL_SIGN_POS : DECIMAL_SIGN_NEG);
+    d3->e = (sint8)e;
+    decimal_abs_from_uint128(u1 * u2, d3);
+
+    return 0;
+}
+
+
+// return num / v for num < 2^63, inv = floor((2^64 - 1) / v) is reciprocal of v, remainder is put to rem
+inline uint64 decimal_div_by_reciprocal(uint64 num, uint64 v, uint64 inv, uint64 *rem)
+{
+    // estimation is less than quotient by at most 1
+    uint64 q = (uint64)(((uint128)num * inv) >> 64);
+    uint64 r = num - q * v;
+
+    if(r >= v)
+    {
+        q++;
+        r -= v;
+    }
+    *rem = r;
+
+    return q;
+}
+
+// prepare divisor d2 for repeated division
+// return 0 on success, not 0 on error
+sint8 decimal_divisor_prepare(const decimal *d2, decimal_divisor *dv)
+{
+    sint32 i, n;
+    uint64 c;
 
     if(d2->n == 0)
     {
         error_set(ERROR_DIVISION_BY_ZERO);
         return 1;
     }
+
     n = (d2->n - 1) / DECIMAL_BASE_LOG10;
 
+    // pairs of limbs make limbs of base DECIMAL_BASE2
+    dv->vn = (sint16)(n / 2 + 1);
+    for(i = 0; i < dv->vn; i++)
+    {
+        dv->v[i] = (uint32)d2->m[2 * i] + (2 * i + 1 <= n ? (uint32)d2->m[2 * i + 1] * DECIMAL_BASE : 0);
+    }
+
+    // normalize: norm * v[most significant] is close to DECIMAL_BASE2
+    dv->norm = dv->vn > 1 ? (uint32)(DECIMAL_BASE2 / (dv->v[dv->vn - 1] + 1)) : 1;
+    for(i = 0, c = 0; i < dv->vn && dv->norm > 1; i++)
+    {
+        c += (uint64)dv->v[i] * dv->norm;
+        dv->v[i] = (uint32)(c % DECIMAL_BASE2);
+        c /= DECIMAL_BASE2;
+    }
+
+    dv->inv = (uint64)-1 / dv->v[dv->vn - 1];
+    dv->n = (sint16)n;
+    dv->e = d2->e;
+    dv->sign = d2->sign;
+
+    return 0;
+}
+
+// divide d1 by prepared divisor dv: d3 = d1 / dv
+// return 0 on success, not 0 on error
+sint8 decimal_div_by_divisor(const decimal *d1, const decimal_divisor *dv, decimal *d3)
+{
+    uint32 u[DECIMAL_PARTS + 2], q[DECIMAL_PARTS + 1];
+    sint32 i, j, k, m, p, e, ul, vn = dv->vn;
+    uint64 qh, rh, c, v1, v2;
+    sint64 t, b;
+
     if(d1->n == 0)
     {
         memset(d3->m, 0, sizeof(d3->m));
@@ -293,155 +498,84 @@ sint8 decimal_div(const decimal *d1, const decimal *d2, decimal *d3)
     }
     m = (d1->n - 1) / DECIMAL_BASE_LOG10;
 
-    i = DECIMAL_PARTS - 1;
-    p = 1;
-
-    if(n == 0)
+    // dividend u is d1 shifted by k limbs, so the quotient has DECIMAL_PARTS or DECIMAL_PARTS + 1 limbs
+    k = dv->n + DECIMAL_PARTS - m;
+    ul = (dv->n + DECIMAL_PARTS + 2) / 2;
+    for(i = 0; i < ul; i++)
     {
-        // division by single digit
-        d = *(d2->m);
-        rh = 0;
-        j = m;
-        if(d1->m[j] < d)
-        {
-            rh = d1->m[j];
-            j--;
-            p--;
-        }
-
-        while(i >= 0)
-        {
-            qh = rh * DECIMAL_BASE + ((j >= 0) ? d1->m[j] : 0);
-            rh = qh % d;
-            d3->m[i] = qh / d;
-
-            if(rh == 0 && j <= 0)
-            {
-                break;
-            }
-
-            j--;
-            i--;
-        }
+        j = 2 * i - k;
+        u[i] = (j >= 0 && j <= m ? (uint32)d1->m[j] : 0) + (j + 1 >= 0 && j + 1 <= m ? (uint32)d1->m[j + 1] * DECIMAL_BASE : 0);
+    }
 
-        while(i > 0)
+    if(vn == 1)
+    {
+        // division by single limb
+        for(i = ul - 1, rh = 0; i >= 0; i--)
         {
-            i--;
-            d3->m[i] = 0;
+            q[i] = (uint32)decimal_div_by_reciprocal(rh * DECIMAL_BASE2 + u[i], dv->v[0], dv->inv, &rh);
         }
     }
     else
     {
-        // normalize: n1 = d1 * d, n2 = d2 * d
-        d = DECIMAL_BASE / (d2->m[n] + 1);  // factor d: d * d2[most significant] is close to DECIMAL_BASE
-
-        memset(buf, 0, sizeof(buf));
-
-        if(d == 1)
-        {
-            memcpy(n1, d1->m, sizeof(d1->m));
-            memcpy(n2, d2->m, sizeof(d2->m));
-        }
-        else
+        // Knuth's division, u is normalized as v
+        for(i = 0, c = 0; i < ul; i++)
         {
-            decimal_mul_by_digit(d1->m, d, n1);
-            decimal_mul_by_digit(d2->m, d, n2);
+            c += (uint64)u[i] * dv->norm;
+            u[i] = (uint32)(c % DECIMAL_BASE2);
+            c /= DECIMAL_BASE2;
         }
+        u[ul] = (uint32)c;
 
-        v1 = n2[n];
-        v2 = n2[n - 1];
-/*
-        if(n1[j + n + 1] * DECIMAL_BASE + n1[j + n] < v1)
+        v1 = dv->v[vn - 1];
+        v2 = dv->v[vn - 2];
+        for(j = ul - vn; j >= 0; j--)
         {
-            n1--;
-            if(n1[j + n + 1] * DECIMAL_BASE + n1[j + n] < v1)
+            // estimate quotient digit by the two most significant limbs
+            if(u[j + vn] == v1)
             {
-                n1--;
+                qh = DECIMAL_BASE2 - 1;
+                rh = (uint64)u[j + vn - 1] + v1;
             }
-        }
-*/
-        j = m - n;
-        do
-        {
-            n1j = n1 + j;
-            qh = (n1j[n + 1] * DECIMAL_BASE + n1j[n]);
-            rh = qh % v1;
-            qh /= v1;
-
-            if(qh >= DECIMAL_BASE || (qh * v2 > DECIMAL_BASE * rh + n1j[n-1]))
+            else
+            {
+                qh = decimal_div_by_reciprocal((uint64)u[j + vn] * DECIMAL_BASE2 + u[j + vn - 1], v1, dv->inv, &rh);
+            }
+            while(rh < DECIMAL_BASE2 && qh * v2 > rh * DECIMAL_BASE2 + u[j + vn - 2])
             {
                 qh--;
                 rh += v1;
-                if(rh < DECIMAL_BASE)
-                {
-                    if(qh >= DECIMAL_BASE || (qh * v2 > DECIMAL_BASE * rh + n1j[n - 1]))
-                    {
-                        qh--;
-                    }
-                }
             }
 
-            // n1_j = n1_j - n2 * qh
-            for(l = c = k = 0; l <= n + 1; l++)
+            // u_j = u_j - v * qh
+            for(i = 0, c = 0, b = 0; i < vn; i++)
             {
-                k = n2[l] * qh + k / DECIMAL_BASE;
-                n1j[l] -= k % DECIMAL_BASE + c;
-                if(n1j[l] < 0)
-                {
-                    n1j[l] += DECIMAL_BASE;
-                    c = 1;
-                }
-                else
-                {
-                    c = 0;
-                }
+                c += qh * dv->v[i];
+                t = (sint64)u[i + j] - (sint64)(c % DECIMAL_BASE2) - b;
+                b = t < 0;
+                u[i + j] = (uint32)(t + b * (sint64)DECIMAL_BASE2);
+                c /= DECIMAL_BASE2;
             }
 
-            if(c > 0)
+            if((sint64)u[j + vn] - (sint64)c - b < 0)
             {
-                // compensate
+                // estimation was greater by one, compensate
                 qh--;
-                for(l = c = 0; l <= n + 1; l++)
+                for(i = 0, c = 0; i < vn; i++)
                 {
-                    n1j[l] += n2[l] + c;
-                    if(n1j[l] >= DECIMAL_BASE)
-                    {
-                        n1j[l] -= DECIMAL_BASE;
-                        c = 1;
-                    }
-                    else
-                    {
-                        c = 0;
-                    }
+                    c += (uint64)u[i + j] + dv->v[i];
+                    u[i + j] = (uint32)(c % DECIMAL_BASE2);
+                    c /= DECIMAL_BASE2;
                 }
-                assert(c > 0);
             }
 
-            if(i < DECIMAL_PARTS - 1 || qh > 0)
-            {
-                d3->m[i] = qh;
-                i--;
-            }
-            else
-            {
-                p--;
-            }
-
-            j--;
+            q[j] = (uint32)qh;
         }
-        while(i>=0 && n1 + j > buf);
     }
 
-    // exponent
-    j = 0;
-    d = d3->m[DECIMAL_PARTS - 1];
-    while(d > 0)
-    {
-        d /= 10;
-        j++;
-    }
+    // quotient of DECIMAL_PARTS + 1 limbs is truncated
+    p = q[DECIMAL_PARTS / 2] != 0;
 
-    e = (sint32)d1->e - (sint32)d2->e - (DECIMAL_PARTS - m + n - p) * DECIMAL_BASE_LOG10;
+    e = (sint32)d1->e - (sint32)dv->e - (DECIMAL_PARTS - m + dv->n - p) * DECIMAL_BASE_LOG10;
 
     if(e > DECIMAL_MAX_EXPONENT || e < DECIMAL_MIN_EXPONENT)
     {
@@ -449,21 +583,36 @@ sint8 decimal_div(const decimal *d1, const decimal *d2, decimal *d3)
         return 1;
     }
 
+    for(i = 0; i < DECIMAL_PARTS / 2; i++)
+    {
+        d3->m[2 * i] = (sint16)(p ? q[i] / DECIMAL_BASE : q[i] % DECIMAL_BASE);
+        d3->m[2 * i + 1] = (sint16)(p ? q[i + 1] % DECIMAL_BASE : q[i] / DECIMAL_BASE);
+    }
     d3->e = (sint8)e;
+    d3->n = decimal_num_digits(d3->m);
+    d3->sign = ((d1->sign == dv->sign) ? DECIMAL_SIGN_POS : DECIMAL_SIGN_NEG);
 
-    d3->n = DECIMAL_POSITIONS - DECIMAL_BASE_LOG10 + j;
+    return 0;
+}
 
-    d3->sign = ((d1->sign == d2->sign) ? DECIMAL_SIGN_POS : DECIMAL_SIGN_NEG);
+// divide d1 by d2: d3 = d1 / d2
+// return 0 on success, not 0 on error
+sint8 decimal_div(const decimal *d1, const decimal *d2, decimal *d3)
+{
+    decimal_divisor dv;
 
-    return 0;
+    if(decimal_divisor_prepare(d2, &dv) != 0) return 1;
+
+    return decimal_div_by_divisor(d1, &dv, d3);
 }
 
-// add two decimals if op >= 0: d3 = d1 + d2, subtract if op < 0
+// add two decimals on limbs if op >= 0: d3 = d1 + d2, subtract if op < 0
 // return 0 on success, not 0 on error
-sint8 decimal_add_sub(const decimal *d1, const decimal *d2, decimal *d3, sint8 op)
+sint8 decimal_add_sub_limbs(const decimal *d1, const decimal *d2, decimal *d3, sint8 op)
 {
     sint32 shift, free, e;
     sint16 cmp;
+    sint8 sign1, sign2;     // signs of terms n1 and n2 taking op into account
     const decimal *n1, *n2;
     decimal s1, s2;
 
@@ -489,11 +638,15 @@ sint8 decimal_add_sub(const decimal *d1, const decimal *d2, decimal *d3, sint8 o
     {
         n1 = d2;
         n2 = d1;
+        sign1 = d2->sign * op;
+        sign2 = d1->sign;
     }
     else
     {
         n1 = d1;
         n2 = d2;
+        sign1 = d1->sign;
+        sign2 = d2->sign * op;
     }
     shift = (sint32)n1->e - (sint32)n2->e;
     e = (sint32)n1->e;
@@ -510,8 +663,9 @@ sint8 decimal_add_sub(const decimal *d1, const decimal *d2, decimal *d3, sint8 o
         {
             if(shift - free > (sint32)s2.n)
             {
-                // n2 is too small
+                // n2 is too small, result is n1 with its sign after op
                 memcpy(d3, n1, sizeof(*d3));
+                d3->sign = sign1;
                 return 0;
             }
             else
@@ -539,20 +693,20 @@ sint8 decimal_add_sub(const decimal *d1, const decimal *d2, decimal *d3, sint8 o
         n2 = &s2;
     }
 
-    if((n1->sign != n2->sign && op >= 0) || (op < 0 && n1->sign == n2->sign))
+    if(sign1 != sign2)
     {
         // subtract
         cmp = decimal_abs_cmp(n1->m, n2->m);
         if(cmp > 0)
         {
-            d3->sign = n1->sign;
+            d3->sign = sign1;
             d3->e = e;
             decimal_abs_sub(n1->m, n2->m, d3->m);
             d3->n = decimal_num_digits(d3->m);
         }
         else if(cmp < 0)
         {
-            d3->sign = n2->sign;
+            d3->sign = sign2;
             d3->e = e;
             decimal_abs_sub(n2->m, n1->m, d3->m);
             d3->n = decimal_num_digits(d3->m);
@@ -567,7 +721,7 @@ sint8 decimal_add_sub(const decimal *d1, const decimal *d2, decimal *d3, sint8 o
     else
     {
         // add
-        d3->sign = d1->sign;
+        d3->sign = sign1;
         d3->e = e;
         if(decimal_abs_add(n1->m, n2->m, d3->m) > 0)
         {
@@ -589,6 +743,74 @@ sint8 decimal_add_sub(const decimal *d1, const decimal *d2, decimal *d3, sint8 o
     return 0;
 }
 
+// add two non-zero decimals as 64-bit integers if op >= 0: d3 = d1 + d2, subtract if op < 0,
+// terms brought to the lower exponent must have up to DECIMAL_INT64_DIGITS digits
+// return 0 on success, not 0 on error
+sint8 decimal_add_sub_int64(const decimal *d1, const decimal *d2, decimal *d3, sint8 op)
+{
+    sint32 shift = (sint32)d1->e - (sint32)d2->e;
+    sint8 sign1 = d1->sign, sign2 = d2->sign * op;
+    uint64 u1, u2, u;
+
+    u1 = decimal_abs_to_uint64(d1);
+    u2 = decimal_abs_to_uint64(d2);
+    if(shift > 0)
+    {
+        u1 *= g_decimal_pow10[shift];
+        d3->e = d2->e;
+    }
+    else
+    {
+        u2 *= g_decimal_pow10[-shift];
+        d3->e = d1->e;
+    }
+
+    if(sign1 == sign2)
+    {
+        // sum is less than 2 * 10^18, no overflow
+        d3->sign = sign1;
+        u = u1 + u2;
+    }
+    else if(u1 != u2)
+    {
+        d3->sign = u1 > u2 ? sign1 : sign2;
+        u = u1 > u2 ? u1 - u2 : u2 - u1;
+    }
+    else
+    {
+        d3->sign = DECIMAL_SIGN_POS;
+        d3->e = d3->n = 0;
+        memset(d3->m, 0, sizeof(d3->m));
+        return 0;
+    }
+
+    memset(d3->m + 5, 0, sizeof(d3->m) - 5 * sizeof(d3->m[0]));
+    decimal_uint64_to_limbs(u % DECIMAL_E16, d3->m);
+    d3->m[4] = (sint16)(u / DECIMAL_E16);
+    d3->n = decimal_num_digits(d3->m);
+
+    return 0;
+}
+
+// add two decimals if op >= 0: d3 = d1 + d2, subtract if op < 0
+// return 0 on success, not 0 on error
+sint8 decimal_add_sub(const decimal *d1, const decimal *d2, decimal *d3, sint8 op)
+{
+    sint32 shift = (sint32)d1->e - (sint32)d2->e;
+
+    // terms brought to the lower exponent must fit into 64 bits, longer ones are added on limbs faster
+    // than with 128-bit integers, zero term is just copied; both branches are tail calls, so long terms
+    // pay only for the check
+    if(d1->n > DECIMAL_INT64_DIGITS || d2->n > DECIMAL_INT64_DIGITS || 0 == d1->n || 0 == d2->n
+        || (sint32)d1->n + (shift > 0 ? shift : 0) > DECIMAL_INT64_DIGITS
+        || (sint32)d2->n - (shift < 0 ? shift : 0) > DECIMAL_INT64_DIGITS)
+    {
+        return decimal_add_sub_limbs(d1, d2, d3, op);
+    }
+
+    return decimal_add_sub_int64(d1, d2, d3, op);
+}
+
 // subtract two decimals: d3 = d1 - d2
 // return 0 on success, not 0 on error
 inline sint8 decimal_sub(const decimal *d1, const decimal *d2, decimal *d3)
@@ -607,12 +829,15 @@ inline sint8 decimal_add(const decimal *d1, const decimal *d2, decimal *d3)
 // return positive if d1 > d2, negative if d1 < d2, 0 otherwise
 sint16 decimal_cmp(const decimal *d1, const decimal *d2)
 {
+    // exponent of zero is meaningless, zero can be negative
+    if(d1->n == 0 || d2->n == 0) return (d1->n != 0) * d1->sign - (d2->n != 0) * d2->sign;
+
     if(d1->sign != d2->sign) return d1->sign;
 
     sint32 diff = (sint32)d1->e + (sint32)d1->n - (sint32)d2->e - (sint32)d2->n;
 
-    if(diff > 0) return 1;
-    if(diff < 0) return -1;
+    if(diff > 0) return d1->sign;
+    if(diff < 0) return -d1->sign;
 
     if(d1->n != d2->n)
     {
@@ -622,3 +847,275 @@ sint16 decimal_cmp(const decimal *d1, const decimal *d2)
     return decimal_abs_cmp(d1->m, d2->m) * d1->sign;
 }
 
+// convert integer to decimal
+void decimal_from_int64(sint64 v, decimal *d)
+{
+    uint64 u;
+    sint32 i = 0;
+
+    memset(d, 0, sizeof(*d));
+    d->sign = v < 0 ? DECIMAL_SIGN_NEG : DECIMAL_SIGN_POS;
+    u = v < 0 ? (uint64)0 - (uint64)v : (uint64)v;
+
+    while(u > 0)
+    {
+        d->m[i++] = (sint16)(u % DECIMAL_BASE);
+        u /= DECIMAL_BASE;
+    }
+
+    d->n = decimal_num_digits(d->m);
+}
+
+
+// convert decimal d to the nearest floating point number
+float64 decimal_to_float64(const decimal *d)
+{
+    uint8 str[DECIMAL_POSITIONS + 8];
+    uint64 w = 0;
+    float64 v;
+    sint32 i, e = d->e;
+    uint32 sz;
+
+    if(d->n <= DECIMAL_UINT64_DIGITS)
+    {
+        for(i = (d->n - 1) / DECIMAL_BASE_LOG10; i >= 0; i--)
+        {
+            w = w * DECIMAL_BASE + (uint16)d->m[i];
+        }
+
+        return fltconv_to_double(w, e, d->sign == DECIMAL_SIGN_NEG);
+    }
+
+    // long mantissa is rounded once from its digits
+    sz = (uint32)d->n;
+    for(i = 0; i < d->n; i++)
+    {
+        str[sz - 1 - i] = (uint8)('0' + (d->m[i / DECIMAL_BASE_LOG10] / g_decimal_pow10[i % DECIMAL_BASE_LOG10]) % 10);
+    }
+    sz += (uint32)snprintf((char *)str + sz, sizeof(str) - sz, "e%d", e);
+    fltconv_parse_double(str, sz, &v);
+
+    return d->sign == DECIMAL_SIGN_NEG ? -v : v;
+}
+
+
+// carry limbs of accumulator, so all limbs but the last one are below DECIMAL_BASE and have sign of the sum
+// return sign of the sum, 0 if the sum is zero
+sint8 decimal_accumulator_carry(decimal_accumulator *acc)
+{
+    sint64 c;
+    sint32 i, t;
+    sint8 sign;
+
+    for(i = 0; i < DECIMAL_ACC_PARTS - 1; i++)
+    {
+        c = acc->m[i] / DECIMAL_BASE;
+        acc->m[i] -= c * DECIMAL_BASE;
+        acc->m[i + 1] += c;
+    }
+    acc->pending = 0;
+
+    // lower limbs are below DECIMAL_BASE, so the most significant limb has sign of the sum
+    for(t = DECIMAL_ACC_PARTS - 1; t >= 0 && 0 == acc->m[t]; t--);
+    if(t < 0) return 0;
+    sign = acc->m[t] > 0 ? DECIMAL_SIGN_POS : DECIMAL_SIGN_NEG;
+
+    for(i = 0; i < t; i++)
+    {
+        if(acc->m[i] * sign < 0)
+        {
+            acc->m[i] += sign * DECIMAL_BASE;
+            acc->m[i + 1] -= sign;
+        }
+    }
+
+    return sign;
+}
+
+// return number of digits in mantissa of carried accumulator
+sint32 decimal_accumulator_digits(const decimal_accumulator *acc)
+{
+    sint32 t, n;
+    sint64 v;
+
+    for(t = DECIMAL_ACC_PARTS - 1; t >= 0 && 0 == acc->m[t]; t--);
+    if(t < 0) return 0;
+
+    v = acc->m[t] < 0 ? -acc->m[t] : acc->m[t];
+    for(n = t * DECIMAL_BASE_LOG10; v > 0; v /= 10) n++;
+
+    return n;
+}
+
+// bring mantissa of carried accumulator to exponent e, lower digits are truncated if e is greater than exponent,
+// the caller makes sure digits fit if e is less than exponent
+void decimal_accumulator_rescale(decimal_accumulator *acc, sint32 e)
+{
+    sint32 i, q, r = (sint32)acc->e - e;
+    sint64 p, rem;
+
+    if(r > 0)
+    {
+        q = r / DECIMAL_BASE_LOG10;
+        p = (sint64)g_decimal_pow10[r % DECIMAL_BASE_LOG10];
+        for(i = DECIMAL_ACC_PARTS - 1; i >= 0; i--)
+        {
+            acc->m[i] = i >= q ? acc->m[i - q] * p : 0;
+        }
+    }
+    else if(r < 0)
+    {
+        q = -r / DECIMAL_BASE_LOG10;
+        p = (sint64)g_decimal_pow10[-r % DECIMAL_BASE_LOG10];
+        for(i = 0; i < DECIMAL_ACC_PARTS; i++)
+        {
+            acc->m[i] = i + q < DECIMAL_ACC_PARTS ? acc->m[i + q] : 0;
+        }
+        for(i = DECIMAL_ACC_PARTS - 1, rem = 0; i >= 0; i--)
+        {
+            acc->m[i] += rem * DECIMAL_BASE;
+            rem = acc->m[i] % p;
+            acc->m[i] /= p;
+        }
+    }
+
+    acc->e = (sint16)e;
+}
+
+// initialize empty accumulator acc
+void decimal_accumulator_init(decimal_accumulator *acc)
+{
+    memset(acc, 0, sizeof(*acc));
+    acc->e = DECIMAL_MAX_EXPONENT;  // the first value lowers it
+}
+
+// add decimal d to accumulator acc
+void decimal_accumulator_add(decimal_accumulator *acc, const decimal *d)
+{
+    decimal_accumulator tmp;
+    sint32 i, q, k = (sint32)d->e - (sint32)acc->e;
+    sint64 p;
+
+    if(0 == d->n)
+    {
+        acc->count++;
+        return;
+    }
+
+    // value is added to limbs at its position without carry, any limb of value stays below the last limb
+    if(k >= 0 && k < (DECIMAL_ACC_PARTS - DECIMAL_PARTS - 1) * DECIMAL_BASE_LOG10)
+    {
+        if(acc->pending >= DECIMAL_ACC_CARRY_INTERVAL)
+        {
+            decimal_accumulator_carry(acc);
+        }
+
+        q = k / DECIMAL_BASE_LOG10;
+        p = (sint64)g_decimal_pow10[k % DECIMAL_BASE_LOG10] * d->sign;
+        for(i = 0; i < (d->n + DECIMAL_BASE_LOG10 - 1) / DECIMAL_BASE_LOG10; i++)
+        {
+            acc->m[q + i] += d->m[i] * p;
+        }
+        acc->pending++;
+        acc->count++;
+        return;
+    }
+
+    // exponent of accumulator changes
+    memset(&tmp, 0, sizeof(tmp));
+    for(i = 0; i < DECIMAL_PARTS; i++)
+    {
+        tmp.m[i] = d->m[i] * d->sign;
+    }
+    tmp.e = d->e;
+    tmp.count = 1;
+
+    decimal_accumulator_merge(acc, &tmp);
+}
+
+// add sum and count of accumulator other to accumulator acc
+void decimal_accumulator_merge(decimal_accumulator *acc, const decimal_accumulator *other)
+{
+    decimal_accumulator tmp;
+    sint32 i, e, top, top2;
+
+    memcpy(&tmp, other, sizeof(tmp));
+    acc->count += tmp.count;
+
+    if(0 == decimal_accumulator_carry(&tmp)) return;
+    if(0 == decimal_accumulator_carry(acc))
+    {
+        memcpy(acc->m, tmp.m, sizeof(acc->m));
+        acc->e = tmp.e;
+        return;
+    }
+
+    // the lower exponent keeps all digits of both sums if they fit into the window
+    top = (sint32)acc->e + decimal_accumulator_digits(acc);
+    top2 = (sint32)tmp.e + decimal_accumulator_digits(&tmp);
+    if(top2 > top) top = top2;
+    e = acc->e < tmp.e ? acc->e : tmp.e;
+    if(top - e > DECIMAL_ACC_WINDOW) e = top - DECIMAL_ACC_WINDOW;
+
+    decimal_accumulator_rescale(acc, e);
+    decimal_accumulator_rescale(&tmp, e);
+
+    for(i = 0; i < DECIMAL_ACC_PARTS; i++)
+    {
+        acc->m[i] += tmp.m[i];
+    }
+    acc->pending = 1;
+}
+
+// put sum of accumulated values to d
+// return 0 on success, not 0 on error
+sint8 decimal_accumulator_sum(const decimal_accumulator *acc, decimal *d)
+{
+    decimal_accumulator tmp;
+    sint32 i, n;
+    sint8 sign;
+
+    memcpy(&tmp, acc, sizeof(tmp));
+    if(0 == (sign = decimal_accumulator_carry(&tmp)))
+    {
+        memset(d, 0, sizeof(*d));
+        d->sign = DECIMAL_SIGN_POS;
+        return 0;
+    }
+
+    // the sum is truncated to digits of decimal
+    n = decimal_accumulator_digits(&tmp);
+    if(n > DECIMAL_POSITIONS)
+    {
+        decimal_accumulator_rescale(&tmp, (sint32)tmp.e + n - DECIMAL_POSITIONS);
+    }
+
+    if(tmp.e > DECIMAL_MAX_EXPONENT || tmp.e < DECIMAL_MIN_EXPONENT)
+    {
+        error_set(ERROR_DECIMAL_OVERFLOW);
+        return 1;
+    }
+
+    for(i = 0; i < DECIMAL_PARTS; i++)
+    {
+        d->m[i] = (sint16)(tmp.m[i] * sign);
+    }
+    d->n = decimal_num_digits(d->m);
+    d->e = (sint8)tmp.e;
+    d->sign = sign;
+
+    return 0;
+}
+
+// put average of accumulated values to d, empty accumulator is division by zero
+// return 0 on success, not 0 on error
+sint8 decimal_accumulator_avg(const decimal_accumulator *acc, decimal *d)
+{
+    decimal sum, count;
+
+    if(decimal_accumulator_sum(acc, &sum) != 0) return 1;
+
+    decimal_from_int64((sint64)acc->count, &count);
+
+    return decimal_div(&sum, &count, d);
+}
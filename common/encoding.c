@@ -3,11 +3,27 @@
 #include <string.h>
 #include <assert.h>
 
+#if defined(__x86_64__) && defined(__GNUC__)
+#define ENCODING_X86
+#include <immintrin.h>
+#endif
+
+#define ENCODING_ASCII_MASK (0x8080808080808080UL)
+
+
+typedef uint64 (*encoding_buf_fun)(const uint8 *str, uint64 sz);
+typedef void (*encoding_replace_fun)(const uint8 *str, uint64 sz, uint8 *dst);
 
 struct _encoding_state
 {
     uint8   initialized;
     int     utf8_length_states[5];
+
+    // buffer kernels, chosen by encoding_init for the instruction set of the processor
+    encoding_buf_fun ascii_len;
+    encoding_buf_fun utf8_valid_len;
+    encoding_buf_fun utf8_count;
+    encoding_replace_fun ascii_replace;
 } g_encoding_state = {
     .initialized = 0,
     .utf8_length_states = {
@@ -74,6 +90,435 @@ void encoding_utf8_char_len(const_char_info *chr)
 }
 
 
+//
+// Buffer functions
+//
+// scalar kernels read 8 bytes at a time, SSE2 kernels 16 and AVX2 kernels 32 bytes; ASCII is found by the high bit
+// of bytes, characters of valid UTF-8 are counted as bytes which are not continuation bytes (10xxxxxx);
+// AVX2 validation looks up error flags of each pair of adjacent bytes by their nibbles (Keiser and Lemire,
+// "Validating UTF-8 In Less Than One Instruction Per Byte"), other kernels skip ASCII runs and check
+// multibyte characters one by one; a block with an error is rechecked by the scalar code to find the exact position
+//
+
+// check UTF-8 character at str of sz > 0 bytes: overlong forms, surrogates and code points above U+10FFFF are invalid
+// return character length, 0 if character is invalid, negative length of its valid beginning if str ends before it
+sint8 encoding_utf8_check_char(const uint8 *str, uint64 sz)
+{
+    uint8 b = str[0], len, lo = 0x80u, hi = 0xBFu;
+
+    if(b < 0x80u) return 1;
+    if(b < 0xC2u) return 0;
+    if(b < 0xE0u)
+    {
+        len = 2;
+    }
+    else if(b < 0xF0u)
+    {
+        len = 3;
+        if(b == 0xE0u) lo = 0xA0u;          // overlong
+        else if(b == 0xEDu) hi = 0x9Fu;     // surrogates
+    }
+    else if(b < 0xF5u)
+    {
+        len = 4;
+        if(b == 0xF0u) lo = 0x90u;          // overlong
+        else if(b == 0xF4u) hi = 0x8Fu;     // above U+10FFFF
+    }
+    else
+    {
+        return 0;
+    }
+
+    for(uint8 i = 1; i < len; i++, lo = 0x80u, hi = 0xBFu)
+    {
+        if(i == sz) return -(sint8)i;
+        if(str[i] < lo || str[i] > hi) return 0;
+    }
+
+    return len;
+}
+
+uint64 encoding_ascii_len_scalar(const uint8 *str, uint64 sz)
+{
+    uint64 i = 0, w;
+
+    for(; i + 8 <= sz; i += 8)
+    {
+        memcpy(&w, str + i, 8);
+        if(w & ENCODING_ASCII_MASK) break;
+    }
+
+    while(i < sz && str[i] < 0x80u) i++;
+    return i;
+}
+
+uint64 encoding_utf8_count_scalar(const uint8 *str, uint64 sz)
+{
+    uint64 i = 0, w, cont = 0;
+
+    for(; i + 8 <= sz; i += 8)
+    {
+        memcpy(&w, str + i, 8);
+        cont += __builtin_popcountll(w & ~(w << 1) & ENCODING_ASCII_MASK);   // 10xxxxxx
+    }
+
+    for(; i < sz; i++) cont += (0x80u == (0xC0u & str[i]));
+    return sz - cont;
+}
+
+void encoding_ascii_replace_scalar(const uint8 *str, uint64 sz, uint8 *dst)
+{
+    for(uint64 i = 0; i < sz; i++) dst[i] = (str[i] > 0x7Fu) ? 0x3Fu : str[i];
+}
+
+// validate starting from the last character which begins before str + i, everything before it is valid
+uint64 encoding_utf8_valid_len_from(const uint8 *str, uint64 sz, uint64 i, encoding_buf_fun ascii_len)
+{
+    sint8 len;
+
+    for(uint64 k = 1; k <= 3 && k <= i; k++)
+    {
+        if(0x80u != (0xC0u & str[i - k]))
+        {
+            if(str[i - k] >= 0xC0u) i -= k;
+            break;
+        }
+    }
+
+    while(i < sz)
+    {
+        i += ascii_len(str + i, sz - i);
+        if(i == sz) break;
+
+        len = encoding_utf8_check_char(str + i, sz - i);
+        if(len <= 0) break;
+        i += len;
+    }
+
+    return i;
+}
+
+uint64 encoding_utf8_valid_len_scalar(const uint8 *str, uint64 sz)
+{
+    return encoding_utf8_valid_len_from(str, sz, 0, encoding_ascii_len_scalar);
+}
+
+
+#ifdef ENCODING_X86
+
+uint64 encoding_ascii_len_sse2(const uint8 *str, uint64 sz)
+{
+    uint64 i = 0;
+    int mask;
+
+    for(; i + 16 <= sz; i += 16)
+    {
+        mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(str + i)));
+        if(mask) return i + __builtin_ctz(mask);
+    }
+
+    return i + encoding_ascii_len_scalar(str + i, sz - i);
+}
+
+uint64 encoding_utf8_count_sse2(const uint8 *str, uint64 sz)
+{
+    const __m128i cont = _mm_set1_epi8((char)0xBF);     // continuation bytes are -128..-65 as signed
+    uint64 i = 0, n = 0;
+
+    for(; i + 16 <= sz; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(str + i));
+        n += __builtin_popcount(_mm_movemask_epi8(_mm_cmpgt_epi8(v, cont)));
+    }
+
+    return n + encoding_utf8_count_scalar(str + i, sz - i);
+}
+
+void encoding_ascii_replace_sse2(const uint8 *str, uint64 sz, uint8 *dst)
+{
+    const __m128i question = _mm_set1_epi8(0x3F);
+    uint64 i = 0;
+
+    for(; i + 16 <= sz; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(str + i));
+        __m128i high = _mm_cmplt_epi8(v, _mm_setzero_si128());
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(_mm_andnot_si128(high, v), _mm_and_si128(high, question)));
+    }
+
+    encoding_ascii_replace_scalar(str + i, sz - i, dst + i);
+}
+
+uint64 encoding_utf8_valid_len_sse2(const uint8 *str, uint64 sz)
+{
+    return encoding_utf8_valid_len_from(str, sz, 0, encoding_ascii_len_sse2);
+}
+
+
+__attribute__((target("avx2")))
+uint64 encoding_ascii_len_avx2(const uint8 *str, uint64 sz)
+{
+    uint64 i = 0;
+    uint32 mask;
+
+    for(; i + 32 <= sz; i += 32)
+    {
+        mask = (uint32)_mm256_movemask_epi8(_mm256_loadu_si256((const __m256i *)(str + i)));
+        if(mask) return i + __builtin_ctz(mask);
+    }
+
+    return i + encoding_ascii_len_sse2(str + i, sz - i);
+}
+
+__attribute__((target("avx2")))
+uint64 encoding_utf8_count_avx2(const uint8 *str, uint64 sz)
+{
+    const __m256i cont = _mm256_set1_epi8((char)0xBF);
+    uint64 i = 0, n = 0;
+
+    for(; i + 32 <= sz; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(str + i));
+        n += __builtin_popcount((uint32)_mm256_movemask_epi8(_mm256_cmpgt_epi8(v, cont)));
+    }
+
+    return n + encoding_utf8_count_sse2(str + i, sz - i);
+}
+
+__attribute__((target("avx2")))
+void encoding_ascii_replace_avx2(const uint8 *str, uint64 sz, uint8 *dst)
+{
+    const __m256i question = _mm256_set1_epi8(0x3F);
+    uint64 i = 0;
+
+    for(; i + 32 <= sz; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(str + i));
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_blendv_epi8(v, question, v));    // by the high bit of v
+    }
+
+    encoding_ascii_replace_sse2(str + i, sz - i, dst + i);
+}
+
+// error flags of a pair of adjacent bytes, looked up by high nibble of the first byte, low nibble of the first byte
+// and high nibble of the second byte, error is the flag set in all three
+#define ENCODING_TOO_SHORT      (1 << 0)    // lead byte or ASCII after lead byte
+#define ENCODING_TOO_LONG       (1 << 1)    // continuation byte after ASCII
+#define ENCODING_OVERLONG_3     (1 << 2)
+#define ENCODING_TOO_LARGE      (1 << 3)
+#define ENCODING_SURROGATE      (1 << 4)
+#define ENCODING_OVERLONG_2     (1 << 5)
+#define ENCODING_TOO_LARGE_1000 (1 << 6)
+#define ENCODING_OVERLONG_4     (1 << 6)
+#define ENCODING_TWO_CONTS      (1 << 7)    // two continuation bytes, error unless it is 3rd or 4th byte of character
+#define ENCODING_CARRY          (ENCODING_TOO_SHORT | ENCODING_TOO_LONG | ENCODING_TWO_CONTS)
+
+#define ENCODING_LOOKUP16(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15) \
+    _mm256_setr_epi8(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, \
+                     a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15)
+
+__attribute__((target("avx2")))
+uint64 encoding_utf8_valid_len_avx2(const uint8 *str, uint64 sz)
+{
+    const __m256i byte_1_high = ENCODING_LOOKUP16(
+        ENCODING_TOO_LONG, ENCODING_TOO_LONG, ENCODING_TOO_LONG, ENCODING_TOO_LONG,
+        ENCODING_TOO_LONG, ENCODING_TOO_LONG, ENCODING_TOO_LONG, ENCODING_TOO_LONG,
+        ENCODING_TWO_CONTS, ENCODING_TWO_CONTS, ENCODING_TWO_CONTS, ENCODING_TWO_CONTS,
+        ENCODING_TOO_SHORT | ENCODING_OVERLONG_2,
+        ENCODING_TOO_SHORT,
+        ENCODING_TOO_SHORT | ENCODING_OVERLONG_3 | ENCODING_SURROGATE,
+        ENCODING_TOO_SHORT | ENCODING_TOO_LARGE | ENCODING_TOO_LARGE_1000 | ENCODING_OVERLONG_4);
+    const __m256i byte_1_low = ENCODING_LOOKUP16(
+        ENCODING_CARRY | ENCODING_OVERLONG_3 | ENCODING_OVERLONG_2 | ENCODING_OVERLONG_4,
+        ENCODING_CARRY | ENCODING_OVERLONG_2,
+        ENCODING_CARRY,
+        ENCODING_CARRY,
+        ENCODING_CARRY | ENCODING_TOO_LARGE,
+        ENCODING_CARRY | ENCODING_TOO_LARGE | ENCODING_TOO_LARGE_1000,
+        ENCODING_CARRY | ENCODING_TOO_LARGE | ENCODING_TOO_LARGE_1000,
+        ENCODING_CARRY | ENCODING_TOO_LARGE | ENCODING_TOO_LARGE_1000,
+        ENCODING_CARRY | ENCODING_TOO_LARGE | ENCODING_TOO_LARGE_1000,
+        ENCODING_CARRY | ENCODING_TOO_LARGE | ENCODING_TOO_LARGE_1000,
+        ENCODING_CARRY | ENCODING_TOO_LARGE | ENCODING_TOO_LARGE_1000,
+        ENCODING_CARRY | ENCODING_TOO_LARGE | ENCODING_TOO_LARGE_1000,
+        ENCODING_CARRY | ENCODING_TOO_LARGE | ENCODING_TOO_LARGE_1000,
+        ENCODING_CARRY | ENCODING_TOO_LARGE | ENCODING_TOO_LARGE_1000 | ENCODING_SURROGATE,
+        ENCODING_CARRY | ENCODING_TOO_LARGE | ENCODING_TOO_LARGE_1000,
+        ENCODING_CARRY | ENCODING_TOO_LARGE | ENCODING_TOO_LARGE_1000);
+    const __m256i byte_2_high = ENCODING_LOOKUP16(
+        ENCODING_TOO_SHORT, ENCODING_TOO_SHORT, ENCODING_TOO_SHORT, ENCODING_TOO_SHORT,
+        ENCODING_TOO_SHORT, ENCODING_TOO_SHORT, ENCODING_TOO_SHORT, ENCODING_TOO_SHORT,
+        ENCODING_TOO_LONG | ENCODING_OVERLONG_2 | ENCODING_TWO_CONTS | ENCODING_OVERLONG_3
+            | ENCODING_TOO_LARGE_1000 | ENCODING_OVERLONG_4,
+        ENCODING_TOO_LONG | ENCODING_OVERLONG_2 | ENCODING_TWO_CONTS | ENCODING_OVERLONG_3 | ENCODING_TOO_LARGE,
+        ENCODING_TOO_LONG | ENCODING_OVERLONG_2 | ENCODING_TWO_CONTS | ENCODING_SURROGATE | ENCODING_TOO_LARGE,
+        ENCODING_TOO_LONG | ENCODING_OVERLONG_2 | ENCODING_TWO_CONTS | ENCODING_SURROGATE | ENCODING_TOO_LARGE,
+        ENCODING_TOO_SHORT, ENCODING_TOO_SHORT, ENCODING_TOO_SHORT, ENCODING_TOO_SHORT);
+    // last bytes of a block which start characters not complete in the block
+    const __m256i incomplete_max = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)(0xF0u - 1), (char)(0xE0u - 1), (char)(0xC0u - 1));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i in, prev = _mm256_setzero_si256(), incomplete = _mm256_setzero_si256();
+    uint64 i = 0;
+
+    for(; i + 32 <= sz; i += 32)
+    {
+        in = _mm256_loadu_si256((const __m256i *)(str + i));
+
+        if(0 == _mm256_movemask_epi8(in))
+        {
+            if(!_mm256_testz_si256(incomplete, incomplete)) break;
+            prev = in;
+            continue;
+        }
+
+        __m256i prev_in = _mm256_permute2x128_si256(prev, in, 0x21);
+        __m256i prev1 = _mm256_alignr_epi8(in, prev_in, 15);
+        __m256i prev2 = _mm256_alignr_epi8(in, prev_in, 14);
+        __m256i prev3 = _mm256_alignr_epi8(in, prev_in, 13);
+
+        __m256i flags = _mm256_and_si256(
+            _mm256_and_si256(
+                _mm256_shuffle_epi8(byte_1_high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+                _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(prev1, nibble))),
+            _mm256_shuffle_epi8(byte_2_high, _mm256_and_si256(_mm256_srli_epi16(in, 4), nibble)));
+
+        // 3rd and 4th bytes of characters must be two continuation bytes in a row
+        __m256i must23 = _mm256_or_si256(
+            _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0u - 0x80u))),
+            _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0u - 0x80u))));
+        __m256i err = _mm256_xor_si256(_mm256_and_si256(must23, _mm256_set1_epi8((char)0x80u)), flags);
+
+        if(!_mm256_testz_si256(err, err)) break;
+
+        incomplete = _mm256_subs_epu8(in, incomplete_max);
+        prev = in;
+    }
+
+    return encoding_utf8_valid_len_from(str, sz, i, encoding_ascii_len_avx2);
+}
+
+#endif
+
+
+void encoding_init_kernels()
+{
+    g_encoding_state.ascii_len = encoding_ascii_len_scalar;
+    g_encoding_state.utf8_valid_len = encoding_utf8_valid_len_scalar;
+    g_encoding_state.utf8_count = encoding_utf8_count_scalar;
+    g_encoding_state.ascii_replace = encoding_ascii_replace_scalar;
+
+#ifdef ENCODING_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2"))
+    {
+        g_encoding_state.ascii_len = encoding_ascii_len_avx2;
+        g_encoding_state.utf8_valid_len = encoding_utf8_valid_len_avx2;
+        g_encoding_state.utf8_count = encoding_utf8_count_avx2;
+        g_encoding_state.ascii_replace = encoding_ascii_replace_avx2;
+    }
+    else
+    {
+        g_encoding_state.ascii_len = encoding_ascii_len_sse2;
+        g_encoding_state.utf8_valid_len = encoding_utf8_valid_len_sse2;
+        g_encoding_state.utf8_count = encoding_utf8_count_sse2;
+        g_encoding_state.ascii_replace = encoding_ascii_replace_sse2;
+    }
+#endif
+}
+
+uint64 encoding_ascii_len(const uint8 *str, uint64 sz)
+{
+    return g_encoding_state.ascii_len(str, sz);
+}
+
+encoding_char_state encoding_validate(encoding enc, const uint8 *str, uint64 sz, uint64 *valid)
+{
+    assert(enc > ENCODING_UNKNOWN && enc < ENCODING_NUM);
+
+    if(ENCODING_ASCII == enc)
+    {
+        *valid = g_encoding_state.ascii_len(str, sz);
+        return (*valid == sz) ? CHAR_STATE_COMPLETE : CHAR_STATE_INVALID;
+    }
+
+    *valid = g_encoding_state.utf8_valid_len(str, sz);
+    if(*valid == sz) return CHAR_STATE_COMPLETE;
+    return (encoding_utf8_check_char(str + *valid, sz - *valid) < 0) ? CHAR_STATE_INCOMPLETE : CHAR_STATE_INVALID;
+}
+
+uint64 encoding_count(encoding enc, const uint8 *str, uint64 sz)
+{
+    assert(enc > ENCODING_UNKNOWN && enc < ENCODING_NUM);
+    return (ENCODING_ASCII == enc) ? sz : g_encoding_state.utf8_count(str, sz);
+}
+
+// return length of the longest prefix of UTF-8 str of sz bytes which ends with a complete character
+uint64 encoding_utf8_complete_len(const uint8 *str, uint64 sz)
+{
+    const_char_info chr;
+
+    for(uint64 k = 1; k <= 3 && k <= sz; k++)
+    {
+        if(0x80u != (0xC0u & str[sz - k]))
+        {
+            chr.chr = str + sz - k;
+            encoding_utf8_char_len(&chr);
+            return (chr.length > k) ? sz - k : sz;
+        }
+    }
+
+    return sz;
+}
+
+uint64 encoding_convert(encoding from, encoding to, const uint8 *str, uint64 sz, uint8 *dst, uint64 dst_sz, uint64 *read)
+{
+    uint64 i = 0, wr = 0, n;
+
+    assert(from > ENCODING_UNKNOWN && from < ENCODING_NUM);
+    assert(to > ENCODING_UNKNOWN && to < ENCODING_NUM);
+
+    if(ENCODING_UTF8 != from || ENCODING_UTF8 == to)
+    {
+        // byte to byte
+        n = (sz < dst_sz) ? sz : dst_sz;
+        if(ENCODING_UTF8 == from) n = encoding_utf8_complete_len(str, n);
+
+        if(ENCODING_ASCII == from && ENCODING_UTF8 == to)
+            g_encoding_state.ascii_replace(str, n, dst);
+        else
+            memcpy(dst, str, n);
+
+        *read = n;
+        return n;
+    }
+
+    // UTF-8 to ASCII: ASCII runs are copied, other characters are replaced by one question mark
+    while(i < sz && wr < dst_sz)
+    {
+        if(str[i] < 0x80u)
+        {
+            n = g_encoding_state.ascii_len(str + i, sz - i);
+            if(n > dst_sz - wr) n = dst_sz - wr;
+            memcpy(dst + wr, str + i, n);
+            i += n;
+            wr += n;
+            continue;
+        }
+
+        n = (str[i] < 0xC0u) ? 1 : (str[i] < 0xE0u) ? 2 : (str[i] < 0xF0u) ? 3 : 4;
+        if(n > sz - i) break;
+
+        dst[wr++] = 0x3Fu;
+        i += n;
+    }
+
+    *read = i;
+    return wr;
+}
+
+
 //
 // Building charater from byte stream
 //
@@ -102,7 +547,10 @@ void encoding_build_utf8_char(char_info *chr, uint8 byte)
         {
             chr->chr[chr->ptr] = byte;
             chr->ptr++;
-            if(chr->length == chr->ptr) chr->state = CHAR_STATE_COMPLETE;
+            if(chr->length == chr->ptr)
+            {
+                chr->state = (encoding_utf8_check_char(chr->chr, chr->length) > 0) ? CHAR_STATE_COMPLETE : CHAR_STATE_INVALID;
+            }
         }
     }
 }
@@ -155,6 +603,7 @@ void encoding_init()
     encoding_set_entry(0, _ach("Unknown"), 0, 0, 0, 0, NULL, NULL);
     encoding_set_entry(1, _ach("ASCII"),   0, 1, terminator, 1, encoding_build_ascii_char, encoding_ascii_char_len);
     encoding_set_entry(2, _ach("UTF-8"),   1, 0, terminator, 1, encoding_build_utf8_char, encoding_utf8_char_len);
+    encoding_init_kernels();
 
     g_encoding_state.initialized = 1;
 }
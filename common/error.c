@@ -1,6 +1,6 @@
 #include "common/error.h"
 
-#define ERROR_CODE_NUM 10
+#define ERROR_CODE_NUM 15
 
 achar *g_error_msg[] =
 {
@@ -14,6 +14,11 @@ achar *g_error_msg[] =
     _ach("ECODE=00008: datatype mismatch"),
     _ach("ECODE=00009: out of memory"),
     _ach("ECODE=00010: semantic error"),
+    _ach("ECODE=00011: expression is too complex"),
+    _ach("ECODE=00012: invalid date or time format"),
+    _ach("ECODE=00013: unknown or invalid time zone"),
+    _ach("ECODE=00014: invalid character for encoding"),
+    _ach("ECODE=00015: invalid escape character or sequence in pattern"),
 };
 
 error_code g_current_error_code = 0;
@@ -0,0 +1,1656 @@
+#include "common/fltconv.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+
+#define FLTCONV_DOUBLE_MANTISSA_BITS    (52)
+#define FLTCONV_DOUBLE_EXPONENT_BITS    (11)
+#define FLTCONV_DOUBLE_BIAS             (1023)
+#define FLTCONV_FLOAT_MANTISSA_BITS     (23)
+#define FLTCONV_FLOAT_EXPONENT_BITS     (8)
+#define FLTCONV_FLOAT_BIAS              (127)
+
+#define FLTCONV_POW5_INV_BITCOUNT       (125)
+#define FLTCONV_POW5_BITCOUNT           (125)
+#define FLTCONV_POW5_INV_TABLE_SZ       (342)
+#define FLTCONV_POW5_TABLE_SZ           (326)
+#define FLTCONV_FLOAT_POW5_INV_BITCOUNT (FLTCONV_POW5_INV_BITCOUNT - 64)
+#define FLTCONV_FLOAT_POW5_BITCOUNT     (FLTCONV_POW5_BITCOUNT - 64)
+
+#define FLTCONV_FIXED_MIN_EXP           (-4)    // decimal exponents written as fixed point number
+#define FLTCONV_FIXED_MAX_EXP           (15)
+#define FLTCONV_FAST_MAX_W              (1UL << 53)
+#define FLTCONV_FAST_MAX_EXP            (22)
+#define FLTCONV_FLOAT_FAST_MAX_W        (1UL << 24)
+#define FLTCONV_FLOAT_FAST_MAX_EXP      (10)
+#define FLTCONV_MAX_DIGITS              (19)    // digits of mantissa accumulated in uint64
+#define FLTCONV_LEMIRE_MIN_EXP          (-342)  // 10^q rounds to zero for smaller q
+#define FLTCONV_LEMIRE_MAX_EXP          (308)   // 10^q rounds to infinity for larger q
+#define FLTCONV_SLOW_MAX_DIGITS         (800)   // digits after these can't change rounding except being non-zero
+#define FLTCONV_SLOW_BUF_SZ             (FLTCONV_SLOW_MAX_DIGITS + 32)
+#define FLTCONV_MAX_EXP                 (100000)
+
+
+// floor(2^(pow5bits(q) - 1 + FLTCONV_POW5_INV_BITCOUNT) / 5^q) + 1 as low and high 64 bits
+const uint64 g_fltconv_pow5_inv[FLTCONV_POW5_INV_TABLE_SZ][2] =
+{
+    {1UL, 2305843009213693952UL}, {11068046444225730970UL, 1844674407370955161UL},
+    {5165088340638674453UL, 1475739525896764129UL}, {7821419487252849886UL, 1180591620717411303UL},
+    {8824922364862649494UL, 1888946593147858085UL}, {7059937891890119595UL, 1511157274518286468UL},
+    {13026647942995916322UL, 1208925819614629174UL}, {9774590264567735146UL, 1934281311383406679UL},
+    {11509021026396098440UL, 1547425049106725343UL}, {16585914450600699399UL, 1237940039285380274UL},
+    {15469416676735388068UL, 1980704062856608439UL}, {16064882156130220778UL, 1584563250285286751UL},
+    {9162556910162266299UL, 1267650600228229401UL}, {7281393426775805432UL, 2028240960365167042UL},
+    {16893161185646375315UL, 1622592768292133633UL}, {2446482504291369283UL, 1298074214633706907UL},
+    {7603720821608101175UL, 2076918743413931051UL}, {2393627842544570617UL, 1661534994731144841UL},
+    {16672297533003297786UL, 1329227995784915872UL}, {11918280793837635165UL, 2126764793255865396UL},
+    {5845275820328197809UL, 1701411834604692317UL}, {15744267100488289217UL, 1361129467683753853UL},
+    {3054734472329800808UL, 2177807148294006166UL}, {17201182836831481939UL, 1742245718635204932UL},
+    {6382248639981364905UL, 1393796574908163946UL}, {2832900194486363201UL, 2230074519853062314UL},
+    {5955668970331000884UL, 1784059615882449851UL}, {1075186361522890384UL, 1427247692705959881UL},
+    {12788344622662355584UL, 2283596308329535809UL}, {13920024512871794791UL, 1826877046663628647UL},
+    {3757321980813615186UL, 1461501637330902918UL}, {10384555214134712795UL, 1169201309864722334UL},
+    {5547241898389809503UL, 1870722095783555735UL}, {4437793518711847602UL, 1496577676626844588UL},
+    {10928932444453298728UL, 1197262141301475670UL}, {17486291911125277965UL, 1915619426082361072UL},
+    {6610335899416401726UL, 1532495540865888858UL}, {12666966349016942027UL, 1225996432692711086UL},
+    {12888448528943286597UL, 1961594292308337738UL}, {17689456452638449924UL, 1569275433846670190UL},
+    {14151565162110759939UL, 1255420347077336152UL}, {7885109000409574610UL, 2008672555323737844UL},
+    {9997436015069570011UL, 1606938044258990275UL}, {7997948812055656009UL, 1285550435407192220UL},
+    {12796718099289049614UL, 2056880696651507552UL}, {2858676849947419045UL, 1645504557321206042UL},
+    {13354987924183666206UL, 1316403645856964833UL}, {17678631863951955605UL, 2106245833371143733UL},
+    {3074859046935833515UL, 1684996666696914987UL}, {13527933681774397782UL, 1347997333357531989UL},
+    {10576647446613305481UL, 2156795733372051183UL}, {15840015586774465031UL, 1725436586697640946UL},
+    {8982663654677661702UL, 1380349269358112757UL}, {18061610662226169046UL, 2208558830972980411UL},
+    {10759939715039024913UL, 1766847064778384329UL}, {12297300586773130254UL, 1413477651822707463UL},
+    {15986332124095098083UL, 2261564242916331941UL}, {9099716884534168143UL, 1809251394333065553UL},
+    {14658471137111155161UL, 1447401115466452442UL}, {4348079280205103483UL, 1157920892373161954UL},
+    {14335624477811986218UL, 1852673427797059126UL}, {7779150767507678651UL, 1482138742237647301UL},
+    {2533971799264232598UL, 1185710993790117841UL}, {15122401323048503126UL, 1897137590064188545UL},
+    {12097921058438802501UL, 1517710072051350836UL}, {5988988032009131678UL, 1214168057641080669UL},
+    {16961078480698431330UL, 1942668892225729070UL}, {13568862784558745064UL, 1554135113780583256UL},
+    {7165741412905085728UL, 1243308091024466605UL}, {11465186260648137165UL, 1989292945639146568UL},
+    {16550846638002330379UL, 1591434356511317254UL}, {16930026125143774626UL, 1273147485209053803UL},
+    {4951948911778577463UL, 2037035976334486086UL}, {272210314680951647UL, 1629628781067588869UL},
+    {3907117066486671641UL, 1303703024854071095UL}, {6251387306378674625UL, 2085924839766513752UL},
+    {16069156289328670670UL, 1668739871813211001UL}, {9165976216721026213UL, 1334991897450568801UL},
+    {7286864317269821294UL, 2135987035920910082UL}, {16897537898041588005UL, 1708789628736728065UL},
+    {13518030318433270404UL, 1367031702989382452UL}, {6871453250525591353UL, 2187250724783011924UL},
+    {9186511415162383406UL, 1749800579826409539UL}, {11038557946871817048UL, 1399840463861127631UL},
+    {10282995085511086630UL, 2239744742177804210UL}, {8226396068408869304UL, 1791795793742243368UL},
+    {13959814484210916090UL, 1433436634993794694UL}, {11267656730511734774UL, 2293498615990071511UL},
+    {5324776569667477496UL, 1834798892792057209UL}, {7949170070475892320UL, 1467839114233645767UL},
+    {17427382500606444826UL, 1174271291386916613UL}, {5747719112518849781UL, 1878834066219066582UL},
+    {15666221734240810795UL, 1503067252975253265UL}, {12532977387392648636UL, 1202453802380202612UL},
+    {5295368560860596524UL, 1923926083808324180UL}, {4236294848688477220UL, 1539140867046659344UL},
+    {7078384693692692099UL, 1231312693637327475UL}, {11325415509908307358UL, 1970100309819723960UL},
+    {9060332407926645887UL, 1576080247855779168UL}, {14626963555825137356UL, 1260864198284623334UL},
+    {12335095245094488799UL, 2017382717255397335UL}, {9868076196075591040UL, 1613906173804317868UL},
+    {15273158586344293478UL, 1291124939043454294UL}, {13369007293925138595UL, 2065799902469526871UL},
+    {7005857020398200553UL, 1652639921975621497UL}, {16672732060544291412UL, 1322111937580497197UL},
+    {11918976037903224966UL, 2115379100128795516UL}, {5845832015580669650UL, 1692303280103036413UL},
+    {12055363241948356366UL, 1353842624082429130UL}, {841837113407818570UL, 2166148198531886609UL},
+    {4362818505468165179UL, 1732918558825509287UL}, {14558301248600263113UL, 1386334847060407429UL},
+    {12225235553534690011UL, 2218135755296651887UL}, {2401490813343931363UL, 1774508604237321510UL},
+    {1921192650675145090UL, 1419606883389857208UL}, {17831303500047873437UL, 2271371013423771532UL},
+    {6886345170554478103UL, 1817096810739017226UL}, {1819727321701672159UL, 1453677448591213781UL},
+    {16213177116328979020UL, 1162941958872971024UL}, {14873036941900635463UL, 1860707134196753639UL},
+    {15587778368262418694UL, 1488565707357402911UL}, {8780873879868024632UL, 1190852565885922329UL},
+    {2981351763563108441UL, 1905364105417475727UL}, {13453127855076217722UL, 1524291284333980581UL},
+    {7073153469319063855UL, 1219433027467184465UL}, {11317045550910502167UL, 1951092843947495144UL},
+    {12742985255470312057UL, 1560874275157996115UL}, {10194388204376249646UL, 1248699420126396892UL},
+    {1553625868034358140UL, 1997919072202235028UL}, {8621598323911307159UL, 1598335257761788022UL},
+    {17965325103354776697UL, 1278668206209430417UL}, {13987124906400001422UL, 2045869129935088668UL},
+    {121653480894270168UL, 1636695303948070935UL}, {97322784715416134UL, 1309356243158456748UL},
+    {14913111714512307107UL, 2094969989053530796UL}, {8241140556867935363UL, 1675975991242824637UL},
+    {17660958889720079260UL, 1340780792994259709UL}, {17189487779326395846UL, 2145249268790815535UL},
+    {13751590223461116677UL, 1716199415032652428UL}, {18379969808252713988UL, 1372959532026121942UL},
+    {14650556434236701088UL, 2196735251241795108UL}, {652398703163629901UL, 1757388200993436087UL},
+    {11589965406756634890UL, 1405910560794748869UL}, {7475898206584884855UL, 2249456897271598191UL},
+    {2291369750525997561UL, 1799565517817278553UL}, {9211793429904618695UL, 1439652414253822842UL},
+    {18428218302589300235UL, 2303443862806116547UL}, {7363877012587619542UL, 1842755090244893238UL},
+    {13269799239553916280UL, 1474204072195914590UL}, {10615839391643133024UL, 1179363257756731672UL},
+    {2227947767661371545UL, 1886981212410770676UL}, {16539753473096738529UL, 1509584969928616540UL},
+    {13231802778477390823UL, 1207667975942893232UL}, {6413489186596184024UL, 1932268761508629172UL},
+    {16198837793502678189UL, 1545815009206903337UL}, {5580372605318321905UL, 1236652007365522670UL},
+    {8928596168509315048UL, 1978643211784836272UL}, {18210923379033183008UL, 1582914569427869017UL},
+    {7190041073742725760UL, 1266331655542295214UL}, {436019273762630246UL, 2026130648867672343UL},
+    {7727513048493924843UL, 1620904519094137874UL}, {9871359253537050198UL, 1296723615275310299UL},
+    {4726128361433549347UL, 2074757784440496479UL}, {7470251503888749801UL, 1659806227552397183UL},
+    {13354898832594820487UL, 1327844982041917746UL}, {13989140502667892133UL, 2124551971267068394UL},
+    {14880661216876224029UL, 1699641577013654715UL}, {11904528973500979224UL, 1359713261610923772UL},
+    {4289851098633925465UL, 2175541218577478036UL}, {18189276137874781665UL, 1740432974861982428UL},
+    {3483374466074094362UL, 1392346379889585943UL}, {1884050330976640656UL, 2227754207823337509UL},
+    {5196589079523222848UL, 1782203366258670007UL}, {15225317707844309248UL, 1425762693006936005UL},
+    {5913764258841343181UL, 2281220308811097609UL}, {8420360221814984868UL, 1824976247048878087UL},
+    {17804334621677718864UL, 1459980997639102469UL}, {17932816512084085415UL, 1167984798111281975UL},
+    {10245762345624985047UL, 1868775676978051161UL}, {4507261061758077715UL, 1495020541582440929UL},
+    {7295157664148372495UL, 1196016433265952743UL}, {7982903447895485668UL, 1913626293225524389UL},
+    {10075671573058298858UL, 1530901034580419511UL}, {4371188443704728763UL, 1224720827664335609UL},
+    {14372599139411386667UL, 1959553324262936974UL}, {15187428126271019657UL, 1567642659410349579UL},
+    {15839291315758726049UL, 1254114127528279663UL}, {3206773216762499739UL, 2006582604045247462UL},
+    {13633465017635730761UL, 1605266083236197969UL}, {14596120828850494932UL, 1284212866588958375UL},
+    {4907049252451240275UL, 2054740586542333401UL}, {236290587219081897UL, 1643792469233866721UL},
+    {14946427728742906810UL, 1315033975387093376UL}, {16535586736504830250UL, 2104054360619349402UL},
+    {5849771759720043554UL, 1683243488495479522UL}, {15747863852001765813UL, 1346594790796383617UL},
+    {10439186904235184007UL, 2154551665274213788UL}, {15730047152871967852UL, 1723641332219371030UL},
+    {12584037722297574282UL, 1378913065775496824UL}, {9066413911450387881UL, 2206260905240794919UL},
+    {10942479943902220628UL, 1765008724192635935UL}, {8753983955121776503UL, 1412006979354108748UL},
+    {10317025513452932081UL, 2259211166966573997UL}, {874922781278525018UL, 1807368933573259198UL},
+    {8078635854506640661UL, 1445895146858607358UL}, {13841606313089133175UL, 1156716117486885886UL},
+    {14767872471458792434UL, 1850745787979017418UL}, {746251532941302978UL, 1480596630383213935UL},
+    {597001226353042382UL, 1184477304306571148UL}, {15712597221132509104UL, 1895163686890513836UL},
+    {8880728962164096960UL, 1516130949512411069UL}, {10793931984473187891UL, 1212904759609928855UL},
+    {17270291175157100626UL, 1940647615375886168UL}, {2748186495899949531UL, 1552518092300708935UL},
+    {2198549196719959625UL, 1242014473840567148UL}, {18275073973719576693UL, 1987223158144907436UL},
+    {10930710364233751031UL, 1589778526515925949UL}, {12433917106128911148UL, 1271822821212740759UL},
+    {8826220925580526867UL, 2034916513940385215UL}, {7060976740464421494UL, 1627933211152308172UL},
+    {16716827836597268165UL, 1302346568921846537UL}, {11989529279587987770UL, 2083754510274954460UL},
+    {9591623423670390216UL, 1667003608219963568UL}, {15051996368420132820UL, 1333602886575970854UL},
+    {13015147745246481542UL, 2133764618521553367UL}, {3033420566713364587UL, 1707011694817242694UL},
+    {6116085268112601993UL, 1365609355853794155UL}, {9785736428980163188UL, 2184974969366070648UL},
+    {15207286772667951197UL, 1747979975492856518UL}, {1097782973908629988UL, 1398383980394285215UL},
+    {1756452758253807981UL, 2237414368630856344UL}, {5094511021344956708UL, 1789931494904685075UL},
+    {4075608817075965366UL, 1431945195923748060UL}, {6520974107321544586UL, 2291112313477996896UL},
+    {1527430471115325346UL, 1832889850782397517UL}, {12289990821117991246UL, 1466311880625918013UL},
+    {17210690286378213644UL, 1173049504500734410UL}, {9090360384495590213UL, 1876879207201175057UL},
+    {18340334751822203140UL, 1501503365760940045UL}, {14672267801457762512UL, 1201202692608752036UL},
+    {16096930852848599373UL, 1921924308174003258UL}, {1809498238053148529UL, 1537539446539202607UL},
+    {12515645034668249793UL, 1230031557231362085UL}, {1578287981759648052UL, 1968050491570179337UL},
+    {12330676829633449412UL, 1574440393256143469UL}, {13553890278448669853UL, 1259552314604914775UL},
+    {3239480371808320148UL, 2015283703367863641UL}, {17348979556414297411UL, 1612226962694290912UL},
+    {6500486015647617283UL, 1289781570155432730UL}, {10400777625036187652UL, 2063650512248692368UL},
+    {15699319729512770768UL, 1650920409798953894UL}, {16248804598352126938UL, 1320736327839163115UL},
+    {7551343283653851484UL, 2113178124542660985UL}, {6041074626923081187UL, 1690542499634128788UL},
+    {12211557331022285596UL, 1352433999707303030UL}, {1091747655926105338UL, 2163894399531684849UL},
+    {4562746939482794594UL, 1731115519625347879UL}, {7339546366328145998UL, 1384892415700278303UL},
+    {8053925371383123274UL, 2215827865120445285UL}, {6443140297106498619UL, 1772662292096356228UL},
+    {12533209867169019542UL, 1418129833677084982UL}, {5295740528502789974UL, 2269007733883335972UL},
+    {15304638867027962949UL, 1815206187106668777UL}, {4865013464138549713UL, 1452164949685335022UL},
+    {14960057215536570740UL, 1161731959748268017UL}, {9178696285890871890UL, 1858771135597228828UL},
+    {14721654658196518159UL, 1487016908477783062UL}, {4398626097073393881UL, 1189613526782226450UL},
+    {7037801755317430209UL, 1903381642851562320UL}, {5630241404253944167UL, 1522705314281249856UL},
+    {814844308661245011UL, 1218164251424999885UL}, {1303750893857992017UL, 1949062802279999816UL},
+    {15800395974054034906UL, 1559250241823999852UL}, {5261619149759407279UL, 1247400193459199882UL},
+    {12107939454356961969UL, 1995840309534719811UL}, {5997002748743659252UL, 1596672247627775849UL},
+    {8486951013736837725UL, 1277337798102220679UL}, {2511075177753209390UL, 2043740476963553087UL},
+    {13076906586428298482UL, 1634992381570842469UL}, {14150874083884549109UL, 1307993905256673975UL},
+    {4194654460505726958UL, 2092790248410678361UL}, {18113118827372222859UL, 1674232198728542688UL},
+    {3422448617672047318UL, 1339385758982834151UL}, {16543964232501006678UL, 2143017214372534641UL},
+    {9545822571258895019UL, 1714413771498027713UL}, {15015355686490936662UL, 1371531017198422170UL},
+    {5577825024675947042UL, 2194449627517475473UL}, {11840957649224578280UL, 1755559702013980378UL},
+    {16851463748863483271UL, 1404447761611184302UL}, {12204946739213931940UL, 2247116418577894884UL},
+    {13453306206113055875UL, 1797693134862315907UL}, {3383947335406624054UL, 1438154507889852726UL},
+    {16482362180876329456UL, 2301047212623764361UL}, {9496540929959153242UL, 1840837770099011489UL},
+    {11286581558709232917UL, 1472670216079209191UL}, {5339916432225476010UL, 1178136172863367353UL},
+    {4854517476818851293UL, 1885017876581387765UL}, {3883613981455081034UL, 1508014301265110212UL},
+    {14174937629389795797UL, 1206411441012088169UL}, {11611853762797942306UL, 1930258305619341071UL},
+    {5600134195496443521UL, 1544206644495472857UL}, {15548153800622885787UL, 1235365315596378285UL},
+    {6430302007287065643UL, 1976584504954205257UL}, {16212288050055383484UL, 1581267603963364205UL},
+    {12969830440044306787UL, 1265014083170691364UL}, {9683682259845159889UL, 2024022533073106183UL},
+    {15125643437359948558UL, 1619218026458484946UL}, {8411165935146048523UL, 1295374421166787957UL},
+    {17147214310975587960UL, 2072599073866860731UL}, {10028422634038560045UL, 1658079259093488585UL},
+    {8022738107230848036UL, 1326463407274790868UL}, {9147032156827446534UL, 2122341451639665389UL},
+    {11006974540203867551UL, 1697873161311732311UL}, {5116230817421183718UL, 1358298529049385849UL},
+    {15564666937357714594UL, 2173277646479017358UL}, {1383687105660440706UL, 1738622117183213887UL},
+    {12174996128754083534UL, 1390897693746571109UL}, {8411947361780802685UL, 2225436309994513775UL},
+    {6729557889424642148UL, 1780349047995611020UL}, {5383646311539713719UL, 1424279238396488816UL},
+    {1235136468979721303UL, 2278846781434382106UL}, {15745504434151418335UL, 1823077425147505684UL},
+    {16285752362063044992UL, 1458461940118004547UL}, {5649904260166615347UL, 1166769552094403638UL},
+    {5350498001524674232UL, 1866831283351045821UL}, {591049586477829062UL, 1493465026680836657UL},
+    {11540886113407994219UL, 1194772021344669325UL}, {18673707743239135UL, 1911635234151470921UL},
+    {14772334225162232601UL, 1529308187321176736UL}, {8128518565387875758UL, 1223446549856941389UL},
+    {1937583260394870242UL, 1957514479771106223UL}, {8928764237799716840UL, 1566011583816884978UL},
+    {14521709019723594119UL, 1252809267053507982UL}, {8477339172590109297UL, 2004494827285612772UL},
+    {17849917782297818407UL, 1603595861828490217UL}, {6901236596354434079UL, 1282876689462792174UL},
+    {18420676183650915173UL, 2052602703140467478UL}, {3668494502695001169UL, 1642082162512373983UL},
+    {10313493231639821582UL, 1313665730009899186UL}, {9122891541139893884UL, 2101865168015838698UL},
+    {14677010862395735754UL, 1681492134412670958UL}, {673562245690857633UL, 1345193707530136767UL}
+};
+
+// 5^i normalized to FLTCONV_POW5_BITCOUNT bits as low and high 64 bits
+const uint64 g_fltconv_pow5[FLTCONV_POW5_TABLE_SZ][2] =
+{
+    {0UL, 1152921504606846976UL}, {0UL, 1441151880758558720UL},
+    {0UL, 1801439850948198400UL}, {0UL, 2251799813685248000UL},
+    {0UL, 1407374883553280000UL}, {0UL, 1759218604441600000UL},
+    {0UL, 2199023255552000000UL}, {0UL, 1374389534720000000UL},
+    {0UL, 1717986918400000000UL}, {0UL, 2147483648000000000UL},
+    {0UL, 1342177280000000000UL}, {0UL, 1677721600000000000UL},
+    {0UL, 2097152000000000000UL}, {0UL, 1310720000000000000UL},
+    {0UL, 1638400000000000000UL}, {0UL, 2048000000000000000UL},
+    {0UL, 1280000000000000000UL}, {0UL, 1600000000000000000UL},
+    {0UL, 2000000000000000000UL}, {0UL, 1250000000000000000UL},
+    {0UL, 1562500000000000000UL}, {0UL, 1953125000000000000UL},
+    {0UL, 1220703125000000000UL}, {0UL, 1525878906250000000UL},
+    {0UL, 1907348632812500000UL}, {0UL, 1192092895507812500UL},
+    {0UL, 1490116119384765625UL}, {4611686018427387904UL, 1862645149230957031UL},
+    {9799832789158199296UL, 1164153218269348144UL}, {12249790986447749120UL, 1455191522836685180UL},
+    {15312238733059686400UL, 1818989403545856475UL}, {14528612397897220096UL, 2273736754432320594UL},
+    {13692068767113150464UL, 1421085471520200371UL}, {12503399940464050176UL, 1776356839400250464UL},
+    {15629249925580062720UL, 2220446049250313080UL}, {9768281203487539200UL, 1387778780781445675UL},
+    {7598665485932036096UL, 1734723475976807094UL}, {274959820560269312UL, 2168404344971008868UL},
+    {9395221924704944128UL, 1355252715606880542UL}, {2520655369026404352UL, 1694065894508600678UL},
+    {12374191248137781248UL, 2117582368135750847UL}, {14651398557727195136UL, 1323488980084844279UL},
+    {13702562178731606016UL, 1654361225106055349UL}, {3293144668132343808UL, 2067951531382569187UL},
+    {18199116482078572544UL, 1292469707114105741UL}, {8913837547316051968UL, 1615587133892632177UL},
+    {15753982952572452864UL, 2019483917365790221UL}, {12152082354571476992UL, 1262177448353618888UL},
+    {15190102943214346240UL, 1577721810442023610UL}, {9764256642163156992UL, 1972152263052529513UL},
+    {17631875447420442880UL, 1232595164407830945UL}, {8204786253993389888UL, 1540743955509788682UL},
+    {1032610780636961552UL, 1925929944387235853UL}, {2951224747111794922UL, 1203706215242022408UL},
+    {3689030933889743652UL, 1504632769052528010UL}, {13834660704216955373UL, 1880790961315660012UL},
+    {17870034976990372916UL, 1175494350822287507UL}, {17725857702810578241UL, 1469367938527859384UL},
+    {3710578054803671186UL, 1836709923159824231UL}, {26536550077201078UL, 2295887403949780289UL},
+    {11545800389866720434UL, 1434929627468612680UL}, {14432250487333400542UL, 1793662034335765850UL},
+    {8816941072311974870UL, 2242077542919707313UL}, {17039803216263454053UL, 1401298464324817070UL},
+    {12076381983474541759UL, 1751623080406021338UL}, {5872105442488401391UL, 2189528850507526673UL},
+    {15199280947623720629UL, 1368455531567204170UL}, {9775729147674874978UL, 1710569414459005213UL},
+    {16831347453020981627UL, 2138211768073756516UL}, {1296220121283337709UL, 1336382355046097823UL},
+    {15455333206886335848UL, 1670477943807622278UL}, {10095794471753144002UL, 2088097429759527848UL},
+    {6309871544845715001UL, 1305060893599704905UL}, {12499025449484531656UL, 1631326116999631131UL},
+    {11012095793428276666UL, 2039157646249538914UL}, {11494245889320060820UL, 1274473528905961821UL},
+    {532749306367912313UL, 1593091911132452277UL}, {5277622651387278295UL, 1991364888915565346UL},
+    {7910200175544436838UL, 1244603055572228341UL}, {14499436237857933952UL, 1555753819465285426UL},
+    {8900923260467641632UL, 1944692274331606783UL}, {12480606065433357876UL, 1215432671457254239UL},
+    {10989071563364309441UL, 1519290839321567799UL}, {9124653435777998898UL, 1899113549151959749UL},
+    {8008751406574943263UL, 1186945968219974843UL}, {5399253239791291175UL, 1483682460274968554UL},
+    {15972438586593889776UL, 1854603075343710692UL}, {759402079766405302UL, 1159126922089819183UL},
+    {14784310654990170340UL, 1448908652612273978UL}, {9257016281882937117UL, 1811135815765342473UL},
+    {16182956370781059300UL, 2263919769706678091UL}, {7808504722524468110UL, 1414949856066673807UL},
+    {5148944884728197234UL, 1768687320083342259UL}, {1824495087482858639UL, 2210859150104177824UL},
+    {1140309429676786649UL, 1381786968815111140UL}, {1425386787095983311UL, 1727233711018888925UL},
+    {6393419502297367043UL, 2159042138773611156UL}, {13219259225790630210UL, 1349401336733506972UL},
+    {16524074032238287762UL, 1686751670916883715UL}, {16043406521870471799UL, 2108439588646104644UL},
+    {803757039314269066UL, 1317774742903815403UL}, {14839754354425000045UL, 1647218428629769253UL},
+    {4714634887749086344UL, 2059023035787211567UL}, {9864175832484260821UL, 1286889397367007229UL},
+    {16941905809032713930UL, 1608611746708759036UL}, {2730638187581340797UL, 2010764683385948796UL},
+    {10930020904093113806UL, 1256727927116217997UL}, {18274212148543780162UL, 1570909908895272496UL},
+    {4396021111970173586UL, 1963637386119090621UL}, {5053356204195052443UL, 1227273366324431638UL},
+    {15540067292098591362UL, 1534091707905539547UL}, {14813398096695851299UL, 1917614634881924434UL},
+    {13870059828862294966UL, 1198509146801202771UL}, {12725888767650480803UL, 1498136433501503464UL},
+    {15907360959563101004UL, 1872670541876879330UL}, {14553786618154326031UL, 1170419088673049581UL},
+    {4357175217410743827UL, 1463023860841311977UL}, {10058155040190817688UL, 1828779826051639971UL},
+    {7961007781811134206UL, 2285974782564549964UL}, {14199001900486734687UL, 1428734239102843727UL},
+    {13137066357181030455UL, 1785917798878554659UL}, {11809646928048900164UL, 2232397248598193324UL},
+    {16604401366885338411UL, 1395248280373870827UL}, {16143815690179285109UL, 1744060350467338534UL},
+    {10956397575869330579UL, 2180075438084173168UL}, {6847748484918331612UL, 1362547148802608230UL},
+    {17783057643002690323UL, 1703183936003260287UL}, {17617136035325974999UL, 2128979920004075359UL},
+    {17928239049719816230UL, 1330612450002547099UL}, {17798612793722382384UL, 1663265562503183874UL},
+    {13024893955298202172UL, 2079081953128979843UL}, {5834715712847682405UL, 1299426220705612402UL},
+    {16516766677914378815UL, 1624282775882015502UL}, {11422586310538197711UL, 2030353469852519378UL},
+    {11750802462513761473UL, 1268970918657824611UL}, {10076817059714813937UL, 1586213648322280764UL},
+    {12596021324643517422UL, 1982767060402850955UL}, {5566670318688504437UL, 1239229412751781847UL},
+    {2346651879933242642UL, 1549036765939727309UL}, {7545000868343941206UL, 1936295957424659136UL},
+    {4715625542714963254UL, 1210184973390411960UL}, {5894531928393704067UL, 1512731216738014950UL},
+    {16591536947346905892UL, 1890914020922518687UL}, {17287239619732898039UL, 1181821263076574179UL},
+    {16997363506238734644UL, 1477276578845717724UL}, {2799960309088866689UL, 1846595723557147156UL},
+    {10973347230035317489UL, 1154122327223216972UL}, {13716684037544146861UL, 1442652909029021215UL},
+    {12534169028502795672UL, 1803316136286276519UL}, {11056025267201106687UL, 2254145170357845649UL},
+    {18439230838069161439UL, 1408840731473653530UL}, {13825666510731675991UL, 1761050914342066913UL},
+    {3447025083132431277UL, 2201313642927583642UL}, {6766076695385157452UL, 1375821026829739776UL},
+    {8457595869231446815UL, 1719776283537174720UL}, {10571994836539308519UL, 2149720354421468400UL},
+    {6607496772837067824UL, 1343575221513417750UL}, {17482743002901110588UL, 1679469026891772187UL},
+    {17241742735199000331UL, 2099336283614715234UL}, {15387775227926763111UL, 1312085177259197021UL},
+    {5399660979626290177UL, 1640106471573996277UL}, {11361262242960250625UL, 2050133089467495346UL},
+    {11712474920277544544UL, 1281333180917184591UL}, {10028907631919542777UL, 1601666476146480739UL},
+    {7924448521472040567UL, 2002083095183100924UL}, {14176152362774801162UL, 1251301934489438077UL},
+    {3885132398186337741UL, 1564127418111797597UL}, {9468101516160310080UL, 1955159272639746996UL},
+    {15140935484454969608UL, 1221974545399841872UL}, {479425281859160394UL, 1527468181749802341UL},
+    {5210967620751338397UL, 1909335227187252926UL}, {17091912818251750210UL, 1193334516992033078UL},
+    {12141518985959911954UL, 1491668146240041348UL}, {15176898732449889943UL, 1864585182800051685UL},
+    {11791404716994875166UL, 1165365739250032303UL}, {10127569877816206054UL, 1456707174062540379UL},
+    {8047776328842869663UL, 1820883967578175474UL}, {836348374198811271UL, 2276104959472719343UL},
+    {7440246761515338900UL, 1422565599670449589UL}, {13911994470321561530UL, 1778206999588061986UL},
+    {8166621051047176104UL, 2222758749485077483UL}, {2798295147690791113UL, 1389224218428173427UL},
+    {17332926989895652603UL, 1736530273035216783UL}, {17054472718942177850UL, 2170662841294020979UL},
+    {8353202440125167204UL, 1356664275808763112UL}, {10441503050156459005UL, 1695830344760953890UL},
+    {3828506775840797949UL, 2119787930951192363UL}, {86973725686804766UL, 1324867456844495227UL},
+    {13943775212390669669UL, 1656084321055619033UL}, {3594660960206173375UL, 2070105401319523792UL},
+    {2246663100128858359UL, 1293815875824702370UL}, {12031700912015848757UL, 1617269844780877962UL},
+    {5816254103165035138UL, 2021587305976097453UL}, {5941001823691840913UL, 1263492066235060908UL},
+    {7426252279614801142UL, 1579365082793826135UL}, {4671129331091113523UL, 1974206353492282669UL},
+    {5225298841145639904UL, 1233878970932676668UL}, {6531623551432049880UL, 1542348713665845835UL},
+    {3552843420862674446UL, 1927935892082307294UL}, {16055585193321335241UL, 1204959932551442058UL},
+    {10846109454796893243UL, 1506199915689302573UL}, {18169322836923504458UL, 1882749894611628216UL},
+    {11355826773077190286UL, 1176718684132267635UL}, {9583097447919099954UL, 1470898355165334544UL},
+    {11978871809898874942UL, 1838622943956668180UL}, {14973589762373593678UL, 2298278679945835225UL},
+    {2440964573842414192UL, 1436424174966147016UL}, {3051205717303017741UL, 1795530218707683770UL},
+    {13037379183483547984UL, 2244412773384604712UL}, {8148361989677217490UL, 1402757983365377945UL},
+    {14797138505523909766UL, 1753447479206722431UL}, {13884737113477499304UL, 2191809349008403039UL},
+    {15595489723564518921UL, 1369880843130251899UL}, {14882676136028260747UL, 1712351053912814874UL},
+    {9379973133180550126UL, 2140438817391018593UL}, {17391698254306313589UL, 1337774260869386620UL},
+    {3292878744173340370UL, 1672217826086733276UL}, {4116098430216675462UL, 2090272282608416595UL},
+    {266718509671728212UL, 1306420176630260372UL}, {333398137089660265UL, 1633025220787825465UL},
+    {5028433689789463235UL, 2041281525984781831UL}, {10060300083759496378UL, 1275800953740488644UL},
+    {12575375104699370472UL, 1594751192175610805UL}, {1884160825592049379UL, 1993438990219513507UL},
+    {17318501580490888525UL, 1245899368887195941UL}, {7813068920331446945UL, 1557374211108994927UL},
+    {5154650131986920777UL, 1946717763886243659UL}, {915813323278131534UL, 1216698602428902287UL},
+    {14979824709379828129UL, 1520873253036127858UL}, {9501408849870009354UL, 1901091566295159823UL},
+    {12855909558809837702UL, 1188182228934474889UL}, {2234828893230133415UL, 1485227786168093612UL},
+    {2793536116537666769UL, 1856534732710117015UL}, {8663489100477123587UL, 1160334207943823134UL},
+    {1605989338741628675UL, 1450417759929778918UL}, {11230858710281811652UL, 1813022199912223647UL},
+    {9426887369424876662UL, 2266277749890279559UL}, {12809333633531629769UL, 1416423593681424724UL},
+    {16011667041914537212UL, 1770529492101780905UL}, {6179525747111007803UL, 2213161865127226132UL},
+    {13085575628799155685UL, 1383226165704516332UL}, {16356969535998944606UL, 1729032707130645415UL},
+    {15834525901571292854UL, 2161290883913306769UL}, {2979049660840976177UL, 1350806802445816731UL},
+    {17558870131333383934UL, 1688508503057270913UL}, {8113529608884566205UL, 2110635628821588642UL},
+    {9682642023980241782UL, 1319147268013492901UL}, {16714988548402690132UL, 1648934085016866126UL},
+    {11670363648648586857UL, 2061167606271082658UL}, {11905663298832754689UL, 1288229753919426661UL},
+    {1047021068258779650UL, 1610287192399283327UL}, {15143834390605638274UL, 2012858990499104158UL},
+    {4853210475701136017UL, 1258036869061940099UL}, {1454827076199032118UL, 1572546086327425124UL},
+    {1818533845248790147UL, 1965682607909281405UL}, {3442426662494187794UL, 1228551629943300878UL},
+    {13526405364972510550UL, 1535689537429126097UL}, {3072948650933474476UL, 1919611921786407622UL},
+    {15755650962115585259UL, 1199757451116504763UL}, {15082877684217093670UL, 1499696813895630954UL},
+    {9630225068416591280UL, 1874621017369538693UL}, {8324733676974063502UL, 1171638135855961683UL},
+    {5794231077790191473UL, 1464547669819952104UL}, {7242788847237739342UL, 1830684587274940130UL},
+    {18276858095901949986UL, 2288355734093675162UL}, {16034722328366106645UL, 1430222333808546976UL},
+    {1596658836748081690UL, 1787777917260683721UL}, {6607509564362490017UL, 2234722396575854651UL},
+    {1823850468512862308UL, 1396701497859909157UL}, {6891499104068465790UL, 1745876872324886446UL},
+    {17837745916940358045UL, 2182346090406108057UL}, {4231062170446641922UL, 1363966306503817536UL},
+    {5288827713058302403UL, 1704957883129771920UL}, {6611034641322878003UL, 2131197353912214900UL},
+    {13355268687681574560UL, 1331998346195134312UL}, {16694085859601968200UL, 1664997932743917890UL},
+    {11644235287647684442UL, 2081247415929897363UL}, {4971804045566108824UL, 1300779634956185852UL},
+    {6214755056957636030UL, 1625974543695232315UL}, {3156757802769657134UL, 2032468179619040394UL},
+    {6584659645158423613UL, 1270292612261900246UL}, {17454196593302805324UL, 1587865765327375307UL},
+    {17206059723201118751UL, 1984832206659219134UL}, {6142101308573311315UL, 1240520129162011959UL},
+    {3065940617289251240UL, 1550650161452514949UL}, {8444111790038951954UL, 1938312701815643686UL},
+    {665883850346957067UL, 1211445438634777304UL}, {832354812933696334UL, 1514306798293471630UL},
+    {10263815553021896226UL, 1892883497866839537UL}, {17944099766707154901UL, 1183052186166774710UL},
+    {13206752671529167818UL, 1478815232708468388UL}, {16508440839411459773UL, 1848519040885585485UL},
+    {12623618533845856310UL, 1155324400553490928UL}, {15779523167307320387UL, 1444155500691863660UL},
+    {1277659885424598868UL, 1805194375864829576UL}, {1597074856780748586UL, 2256492969831036970UL},
+    {5609857803915355770UL, 1410308106144398106UL}, {16235694291748970521UL, 1762885132680497632UL},
+    {1847873790976661535UL, 2203606415850622041UL}, {12684136165428883219UL, 1377254009906638775UL},
+    {11243484188358716120UL, 1721567512383298469UL}, {219297180166231438UL, 2151959390479123087UL},
+    {7054589765244976505UL, 1344974619049451929UL}, {13429923224983608535UL, 1681218273811814911UL},
+    {12175718012802122765UL, 2101522842264768639UL}, {14527352785642408584UL, 1313451776415480399UL},
+    {13547504963625622826UL, 1641814720519350499UL}, {12322695186104640628UL, 2052268400649188124UL},
+    {16925056528170176201UL, 1282667750405742577UL}, {7321262604930556539UL, 1603334688007178222UL},
+    {18374950293017971482UL, 2004168360008972777UL}, {4566814905495150320UL, 1252605225005607986UL},
+    {14931890668723713708UL, 1565756531257009982UL}, {9441491299049866327UL, 1957195664071262478UL},
+    {1289246043478778550UL, 1223247290044539049UL}, {6223243572775861092UL, 1529059112555673811UL},
+    {3167368447542438461UL, 1911323890694592264UL}, {1979605279714024038UL, 1194577431684120165UL},
+    {7086192618069917952UL, 1493221789605150206UL}, {18081112809442173248UL, 1866527237006437757UL},
+    {13606538515115052232UL, 1166579523129023598UL}, {7784801107039039482UL, 1458224403911279498UL},
+    {507629346944023544UL, 1822780504889099373UL}, {5246222702107417334UL, 2278475631111374216UL},
+    {3278889188817135834UL, 1424047269444608885UL}, {8710297504448807696UL, 1780059086805761106UL}
+};
+
+// exact powers of 10
+const float64 g_fltconv_pow10[FLTCONV_FAST_MAX_EXP + 1] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+const float32 g_fltconv_pow10f[FLTCONV_FLOAT_FAST_MAX_EXP + 1] =
+{
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+// 5^q truncated to 128 bits, q from FLTCONV_LEMIRE_MIN_EXP to FLTCONV_LEMIRE_MAX_EXP, rounded up for negative q,
+// as high and low 64 bits
+const uint64 g_fltconv_pow10_128[FLTCONV_LEMIRE_MAX_EXP - FLTCONV_LEMIRE_MIN_EXP + 1][2] =
+{
+    {0xEEF453D6923BD65AUL, 0x113FAA2906A13B3FUL}, {0x9558B4661B6565F8UL, 0x4AC7CA59A424C507UL},
+    {0xBAAEE17FA23EBF76UL, 0x5D79BCF00D2DF649UL}, {0xE95A99DF8ACE6F53UL, 0xF4D82C2C107973DCUL},
+    {0x91D8A02BB6C10594UL, 0x79071B9B8A4BE869UL}, {0xB64EC836A47146F9UL, 0x9748E2826CDEE284UL},
+    {0xE3E27A444D8D98B7UL, 0xFD1B1B2308169B25UL}, {0x8E6D8C6AB0787F72UL, 0xFE30F0F5E50E20F7UL},
+    {0xB208EF855C969F4FUL, 0xBDBD2D335E51A935UL}, {0xDE8B2B66B3BC4723UL, 0xAD2C788035E61382UL},
+    {0x8B16FB203055AC76UL, 0x4C3BCB5021AFCC31UL}, {0xADDCB9E83C6B1793UL, 0xDF4ABE242A1BBF3DUL},
+    {0xD953E8624B85DD78UL, 0xD71D6DAD34A2AF0DUL}, {0x87D4713D6F33AA6BUL, 0x8672648C40E5AD68UL},
+    {0xA9C98D8CCB009506UL, 0x680EFDAF511F18C2UL}, {0xD43BF0EFFDC0BA48UL, 0x0212BD1B2566DEF2UL},
+    {0x84A57695FE98746DUL, 0x014BB630F7604B57UL}, {0xA5CED43B7E3E9188UL, 0x419EA3BD35385E2DUL},
+    {0xCF42894A5DCE35EAUL, 0x52064CAC828675B9UL}, {0x818995CE7AA0E1B2UL, 0x7343EFEBD1940993UL},
+    {0xA1EBFB4219491A1FUL, 0x1014EBE6C5F90BF8UL}, {0xCA66FA129F9B60A6UL, 0xD41A26E077774EF6UL},
+    {0xFD00B897478238D0UL, 0x8920B098955522B4UL}, {0x9E20735E8CB16382UL, 0x55B46E5F5D5535B0UL},
+    {0xC5A890362FDDBC62UL, 0xEB2189F734AA831DUL}, {0xF712B443BBD52B7BUL, 0xA5E9EC7501D523E4UL},
+    {0x9A6BB0AA55653B2DUL, 0x47B233C92125366EUL}, {0xC1069CD4EABE89F8UL, 0x999EC0BB696E840AUL},
+    {0xF148440A256E2C76UL, 0xC00670EA43CA250DUL}, {0x96CD2A865764DBCAUL, 0x380406926A5E5728UL},
+    {0xBC807527ED3E12BCUL, 0xC605083704F5ECF2UL}, {0xEBA09271E88D976BUL, 0xF7864A44C633682EUL},
+    {0x93445B8731587EA3UL, 0x7AB3EE6AFBE0211DUL}, {0xB8157268FDAE9E4CUL, 0x5960EA05BAD82964UL},
+    {0xE61ACF033D1A45DFUL, 0x6FB92487298E33BDUL}, {0x8FD0C16206306BABUL, 0xA5D3B6D479F8E056UL},
+    {0xB3C4F1BA87BC8696UL, 0x8F48A4899877186CUL}, {0xE0B62E2929ABA83CUL, 0x331ACDABFE94DE87UL},
+    {0x8C71DCD9BA0B4925UL, 0x9FF0C08B7F1D0B14UL}, {0xAF8E5410288E1B6FUL, 0x07ECF0AE5EE44DD9UL},
+    {0xDB71E91432B1A24AUL, 0xC9E82CD9F69D6150UL}, {0x892731AC9FAF056EUL, 0xBE311C083A225CD2UL},
+    {0xAB70FE17C79AC6CAUL, 0x6DBD630A48AAF406UL}, {0xD64D3D9DB981787DUL, 0x092CBBCCDAD5B108UL},
+    {0x85F0468293F0EB4EUL, 0x25BBF56008C58EA5UL}, {0xA76C582338ED2621UL, 0xAF2AF2B80AF6F24EUL},
+    {0xD1476E2C07286FAAUL, 0x1AF5AF660DB4AEE1UL}, {0x82CCA4DB847945CAUL, 0x50D98D9FC890ED4DUL},
+    {0xA37FCE126597973CUL, 0xE50FF107BAB528A0UL}, {0xCC5FC196FEFD7D0CUL, 0x1E53ED49A96272C8UL},
+    {0xFF77B1FCBEBCDC4FUL, 0x25E8E89C13BB0F7AUL}, {0x9FAACF3DF73609B1UL, 0x77B191618C54E9ACUL},
+    {0xC795830D75038C1DUL, 0xD59DF5B9EF6A2417UL}, {0xF97AE3D0D2446F25UL, 0x4B0573286B44AD1DUL},
+    {0x9BECCE62836AC577UL, 0x4EE367F9430AEC32UL}, {0xC2E801FB244576D5UL, 0x229C41F793CDA73FUL},
+    {0xF3A20279ED56D48AUL, 0x6B43527578C1110FUL}, {0x9845418C345644D6UL, 0x830A13896B78AAA9UL},
+    {0xBE5691EF416BD60CUL, 0x23CC986BC656D553UL}, {0xEDEC366B11C6CB8FUL, 0x2CBFBE86B7EC8AA8UL},
+    {0x94B3A202EB1C3F39UL, 0x7BF7D71432F3D6A9UL}, {0xB9E08A83A5E34F07UL, 0xDAF5CCD93FB0CC53UL},
+    {0xE858AD248F5C22C9UL, 0xD1B3400F8F9CFF68UL}, {0x91376C36D99995BEUL, 0x23100809B9C21FA1UL},
+    {0xB58547448FFFFB2DUL, 0xABD40A0C2832A78AUL}, {0xE2E69915B3FFF9F9UL, 0x16C90C8F323F516CUL},
+    {0x8DD01FAD907FFC3BUL, 0xAE3DA7D97F6792E3UL}, {0xB1442798F49FFB4AUL, 0x99CD11CFDF41779CUL},
+    {0xDD95317F31C7FA1DUL, 0x40405643D711D583UL}, {0x8A7D3EEF7F1CFC52UL, 0x482835EA666B2572UL},
+    {0xAD1C8EAB5EE43B66UL, 0xDA3243650005EECFUL}, {0xD863B256369D4A40UL, 0x90BED43E40076A82UL},
+    {0x873E4F75E2224E68UL, 0x5A7744A6E804A291UL}, {0xA90DE3535AAAE202UL, 0x711515D0A205CB36UL},
+    {0xD3515C2831559A83UL, 0x0D5A5B44CA873E03UL}, {0x8412D9991ED58091UL, 0xE858790AFE9486C2UL},
+    {0xA5178FFF668AE0B6UL, 0x626E974DBE39A872UL}, {0xCE5D73FF402D98E3UL, 0xFB0A3D212DC8128FUL},
+    {0x80FA687F881C7F8EUL, 0x7CE66634BC9D0B99UL}, {0xA139029F6A239F72UL, 0x1C1FFFC1EBC44E80UL},
+    {0xC987434744AC874EUL, 0xA327FFB266B56220UL}, {0xFBE9141915D7A922UL, 0x4BF1FF9F0062BAA8UL},
+    {0x9D71AC8FADA6C9B5UL, 0x6F773FC3603DB4A9UL}, {0xC4CE17B399107C22UL, 0xCB550FB4384D21D3UL},
+    {0xF6019DA07F549B2BUL, 0x7E2A53A146606A48UL}, {0x99C102844F94E0FBUL, 0x2EDA7444CBFC426DUL},
+    {0xC0314325637A1939UL, 0xFA911155FEFB5308UL}, {0xF03D93EEBC589F88UL, 0x793555AB7EBA27CAUL},
+    {0x96267C7535B763B5UL, 0x4BC1558B2F3458DEUL}, {0xBBB01B9283253CA2UL, 0x9EB1AAEDFB016F16UL},
+    {0xEA9C227723EE8BCBUL, 0x465E15A979C1CADCUL}, {0x92A1958A7675175FUL, 0x0BFACD89EC191EC9UL},
+    {0xB749FAED14125D36UL, 0xCEF980EC671F667BUL}, {0xE51C79A85916F484UL, 0x82B7E12780E7401AUL},
+    {0x8F31CC0937AE58D2UL, 0xD1B2ECB8B0908810UL}, {0xB2FE3F0B8599EF07UL, 0x861FA7E6DCB4AA15UL},
+    {0xDFBDCECE67006AC9UL, 0x67A791E093E1D49AUL}, {0x8BD6A141006042BDUL, 0xE0C8BB2C5C6D24E0UL},
+    {0xAECC49914078536DUL, 0x58FAE9F773886E18UL}, {0xDA7F5BF590966848UL, 0xAF39A475506A899EUL},
+    {0x888F99797A5E012DUL, 0x6D8406C952429603UL}, {0xAAB37FD7D8F58178UL, 0xC8E5087BA6D33B83UL},
+    {0xD5605FCDCF32E1D6UL, 0xFB1E4A9A90880A64UL}, {0x855C3BE0A17FCD26UL, 0x5CF2EEA09A55067FUL},
+    {0xA6B34AD8C9DFC06FUL, 0xF42FAA48C0EA481EUL}, {0xD0601D8EFC57B08BUL, 0xF13B94DAF124DA26UL},
+    {0x823C12795DB6CE57UL, 0x76C53D08D6B70858UL}, {0xA2CB1717B52481EDUL, 0x54768C4B0C64CA6EUL},
+    {0xCB7DDCDDA26DA268UL, 0xA9942F5DCF7DFD09UL}, {0xFE5D54150B090B02UL, 0xD3F93B35435D7C4CUL},
+    {0x9EFA548D26E5A6E1UL, 0xC47BC5014A1A6DAFUL}, {0xC6B8E9B0709F109AUL, 0x359AB6419CA1091BUL},
+    {0xF867241C8CC6D4C0UL, 0xC30163D203C94B62UL}, {0x9B407691D7FC44F8UL, 0x79E0DE63425DCF1DUL},
+    {0xC21094364DFB5636UL, 0x985915FC12F542E4UL}, {0xF294B943E17A2BC4UL, 0x3E6F5B7B17B2939DUL},
+    {0x979CF3CA6CEC5B5AUL, 0xA705992CEECF9C42UL}, {0xBD8430BD08277231UL, 0x50C6FF782A838353UL},
+    {0xECE53CEC4A314EBDUL, 0xA4F8BF5635246428UL}, {0x940F4613AE5ED136UL, 0x871B7795E136BE99UL},
+    {0xB913179899F68584UL, 0x28E2557B59846E3FUL}, {0xE757DD7EC07426E5UL, 0x331AEADA2FE589CFUL},
+    {0x9096EA6F3848984FUL, 0x3FF0D2C85DEF7621UL}, {0xB4BCA50B065ABE63UL, 0x0FED077A756B53A9UL},
+    {0xE1EBCE4DC7F16DFBUL, 0xD3E8495912C62894UL}, {0x8D3360F09CF6E4BDUL, 0x64712DD7ABBBD95CUL},
+    {0xB080392CC4349DECUL, 0xBD8D794D96AACFB3UL}, {0xDCA04777F541C567UL, 0xECF0D7A0FC5583A0UL},
+    {0x89E42CAAF9491B60UL, 0xF41686C49DB57244UL}, {0xAC5D37D5B79B6239UL, 0x311C2875C522CED5UL},
+    {0xD77485CB25823AC7UL, 0x7D633293366B828BUL}, {0x86A8D39EF77164BCUL, 0xAE5DFF9C02033197UL},
+    {0xA8530886B54DBDEBUL, 0xD9F57F830283FDFCUL}, {0xD267CAA862A12D66UL, 0xD072DF63C324FD7BUL},
+    {0x8380DEA93DA4BC60UL, 0x4247CB9E59F71E6DUL}, {0xA46116538D0DEB78UL, 0x52D9BE85F074E608UL},
+    {0xCD795BE870516656UL, 0x67902E276C921F8BUL}, {0x806BD9714632DFF6UL, 0x00BA1CD8A3DB53B6UL},
+    {0xA086CFCD97BF97F3UL, 0x80E8A40ECCD228A4UL}, {0xC8A883C0FDAF7DF0UL, 0x6122CD128006B2CDUL},
+    {0xFAD2A4B13D1B5D6CUL, 0x796B805720085F81UL}, {0x9CC3A6EEC6311A63UL, 0xCBE3303674053BB0UL},
+    {0xC3F490AA77BD60FCUL, 0xBEDBFC4411068A9CUL}, {0xF4F1B4D515ACB93BUL, 0xEE92FB5515482D44UL},
+    {0x991711052D8BF3C5UL, 0x751BDD152D4D1C4AUL}, {0xBF5CD54678EEF0B6UL, 0xD262D45A78A0635DUL},
+    {0xEF340A98172AACE4UL, 0x86FB897116C87C34UL}, {0x9580869F0E7AAC0EUL, 0xD45D35E6AE3D4DA0UL},
+    {0xBAE0A846D2195712UL, 0x8974836059CCA109UL}, {0xE998D258869FACD7UL, 0x2BD1A438703FC94BUL},
+    {0x91FF83775423CC06UL, 0x7B6306A34627DDCFUL}, {0xB67F6455292CBF08UL, 0x1A3BC84C17B1D542UL},
+    {0xE41F3D6A7377EECAUL, 0x20CABA5F1D9E4A93UL}, {0x8E938662882AF53EUL, 0x547EB47B7282EE9CUL},
+    {0xB23867FB2A35B28DUL, 0xE99E619A4F23AA43UL}, {0xDEC681F9F4C31F31UL, 0x6405FA00E2EC94D4UL},
+    {0x8B3C113C38F9F37EUL, 0xDE83BC408DD3DD04UL}, {0xAE0B158B4738705EUL, 0x9624AB50B148D445UL},
+    {0xD98DDAEE19068C76UL, 0x3BADD624DD9B0957UL}, {0x87F8A8D4CFA417C9UL, 0xE54CA5D70A80E5D6UL},
+    {0xA9F6D30A038D1DBCUL, 0x5E9FCF4CCD211F4CUL}, {0xD47487CC8470652BUL, 0x7647C3200069671FUL},
+    {0x84C8D4DFD2C63F3BUL, 0x29ECD9F40041E073UL}, {0xA5FB0A17C777CF09UL, 0xF468107100525890UL},
+    {0xCF79CC9DB955C2CCUL, 0x7182148D4066EEB4UL}, {0x81AC1FE293D599BFUL, 0xC6F14CD848405530UL},
+    {0xA21727DB38CB002FUL, 0xB8ADA00E5A506A7CUL}, {0xCA9CF1D206FDC03BUL, 0xA6D90811F0E4851CUL},
+    {0xFD442E4688BD304AUL, 0x908F4A166D1DA663UL}, {0x9E4A9CEC15763E2EUL, 0x9A598E4E043287FEUL},
+    {0xC5DD44271AD3CDBAUL, 0x40EFF1E1853F29FDUL}, {0xF7549530E188C128UL, 0xD12BEE59E68EF47CUL},
+    {0x9A94DD3E8CF578B9UL, 0x82BB74F8301958CEUL}, {0xC13A148E3032D6E7UL, 0xE36A52363C1FAF01UL},
+    {0xF18899B1BC3F8CA1UL, 0xDC44E6C3CB279AC1UL}, {0x96F5600F15A7B7E5UL, 0x29AB103A5EF8C0B9UL},
+    {0xBCB2B812DB11A5DEUL, 0x7415D448F6B6F0E7UL}, {0xEBDF661791D60F56UL, 0x111B495B3464AD21UL},
+    {0x936B9FCEBB25C995UL, 0xCAB10DD900BEEC34UL}, {0xB84687C269EF3BFBUL, 0x3D5D514F40EEA742UL},
+    {0xE65829B3046B0AFAUL, 0x0CB4A5A3112A5112UL}, {0x8FF71A0FE2C2E6DCUL, 0x47F0E785EABA72ABUL},
+    {0xB3F4E093DB73A093UL, 0x59ED216765690F56UL}, {0xE0F218B8D25088B8UL, 0x306869C13EC3532CUL},
+    {0x8C974F7383725573UL, 0x1E414218C73A13FBUL}, {0xAFBD2350644EEACFUL, 0xE5D1929EF90898FAUL},
+    {0xDBAC6C247D62A583UL, 0xDF45F746B74ABF39UL}, {0x894BC396CE5DA772UL, 0x6B8BBA8C328EB783UL},
+    {0xAB9EB47C81F5114FUL, 0x066EA92F3F326564UL}, {0xD686619BA27255A2UL, 0xC80A537B0EFEFEBDUL},
+    {0x8613FD0145877585UL, 0xBD06742CE95F5F36UL}, {0xA798FC4196E952E7UL, 0x2C48113823B73704UL},
+    {0xD17F3B51FCA3A7A0UL, 0xF75A15862CA504C5UL}, {0x82EF85133DE648C4UL, 0x9A984D73DBE722FBUL},
+    {0xA3AB66580D5FDAF5UL, 0xC13E60D0D2E0EBBAUL}, {0xCC963FEE10B7D1B3UL, 0x318DF905079926A8UL},
+    {0xFFBBCFE994E5C61FUL, 0xFDF17746497F7052UL}, {0x9FD561F1FD0F9BD3UL, 0xFEB6EA8BEDEFA633UL},
+    {0xC7CABA6E7C5382C8UL, 0xFE64A52EE96B8FC0UL}, {0xF9BD690A1B68637BUL, 0x3DFDCE7AA3C673B0UL},
+    {0x9C1661A651213E2DUL, 0x06BEA10CA65C084EUL}, {0xC31BFA0FE5698DB8UL, 0x486E494FCFF30A62UL},
+    {0xF3E2F893DEC3F126UL, 0x5A89DBA3C3EFCCFAUL}, {0x986DDB5C6B3A76B7UL, 0xF89629465A75E01CUL},
+    {0xBE89523386091465UL, 0xF6BBB397F1135823UL}, {0xEE2BA6C0678B597FUL, 0x746AA07DED582E2CUL},
+    {0x94DB483840B717EFUL, 0xA8C2A44EB4571CDCUL}, {0xBA121A4650E4DDEBUL, 0x92F34D62616CE413UL},
+    {0xE896A0D7E51E1566UL, 0x77B020BAF9C81D17UL}, {0x915E2486EF32CD60UL, 0x0ACE1474DC1D122EUL},
+    {0xB5B5ADA8AAFF80B8UL, 0x0D819992132456BAUL}, {0xE3231912D5BF60E6UL, 0x10E1FFF697ED6C69UL},
+    {0x8DF5EFABC5979C8FUL, 0xCA8D3FFA1EF463C1UL}, {0xB1736B96B6FD83B3UL, 0xBD308FF8A6B17CB2UL},
+    {0xDDD0467C64BCE4A0UL, 0xAC7CB3F6D05DDBDEUL}, {0x8AA22C0DBEF60EE4UL, 0x6BCDF07A423AA96BUL},
+    {0xAD4AB7112EB3929DUL, 0x86C16C98D2C953C6UL}, {0xD89D64D57A607744UL, 0xE871C7BF077BA8B7UL},
+    {0x87625F056C7C4A8BUL, 0x11471CD764AD4972UL}, {0xA93AF6C6C79B5D2DUL, 0xD598E40D3DD89BCFUL},
+    {0xD389B47879823479UL, 0x4AFF1D108D4EC2C3UL}, {0x843610CB4BF160CBUL, 0xCEDF722A585139BAUL},
+    {0xA54394FE1EEDB8FEUL, 0xC2974EB4EE658828UL}, {0xCE947A3DA6A9273EUL, 0x733D226229FEEA32UL},
+    {0x811CCC668829B887UL, 0x0806357D5A3F525FUL}, {0xA163FF802A3426A8UL, 0xCA07C2DCB0CF26F7UL},
+    {0xC9BCFF6034C13052UL, 0xFC89B393DD02F0B5UL}, {0xFC2C3F3841F17C67UL, 0xBBAC2078D443ACE2UL},
+    {0x9D9BA7832936EDC0UL, 0xD54B944B84AA4C0DUL}, {0xC5029163F384A931UL, 0x0A9E795E65D4DF11UL},
+    {0xF64335BCF065D37DUL, 0x4D4617B5FF4A16D5UL}, {0x99EA0196163FA42EUL, 0x504BCED1BF8E4E45UL},
+    {0xC06481FB9BCF8D39UL, 0xE45EC2862F71E1D6UL}, {0xF07DA27A82C37088UL, 0x5D767327BB4E5A4CUL},
+    {0x964E858C91BA2655UL, 0x3A6A07F8D510F86FUL}, {0xBBE226EFB628AFEAUL, 0x890489F70A55368BUL},
+    {0xEADAB0ABA3B2DBE5UL, 0x2B45AC74CCEA842EUL}, {0x92C8AE6B464FC96FUL, 0x3B0B8BC90012929DUL},
+    {0xB77ADA0617E3BBCBUL, 0x09CE6EBB40173744UL}, {0xE55990879DDCAABDUL, 0xCC420A6A101D0515UL},
+    {0x8F57FA54C2A9EAB6UL, 0x9FA946824A12232DUL}, {0xB32DF8E9F3546564UL, 0x47939822DC96ABF9UL},
+    {0xDFF9772470297EBDUL, 0x59787E2B93BC56F7UL}, {0x8BFBEA76C619EF36UL, 0x57EB4EDB3C55B65AUL},
+    {0xAEFAE51477A06B03UL, 0xEDE622920B6B23F1UL}, {0xDAB99E59958885C4UL, 0xE95FAB368E45ECEDUL},
+    {0x88B402F7FD75539BUL, 0x11DBCB0218EBB414UL}, {0xAAE103B5FCD2A881UL, 0xD652BDC29F26A119UL},
+    {0xD59944A37C0752A2UL, 0x4BE76D3346F0495FUL}, {0x857FCAE62D8493A5UL, 0x6F70A4400C562DDBUL},
+    {0xA6DFBD9FB8E5B88EUL, 0xCB4CCD500F6BB952UL}, {0xD097AD07A71F26B2UL, 0x7E2000A41346A7A7UL},
+    {0x825ECC24C873782FUL, 0x8ED400668C0C28C8UL}, {0xA2F67F2DFA90563BUL, 0x728900802F0F32FAUL},
+    {0xCBB41EF979346BCAUL, 0x4F2B40A03AD2FFB9UL}, {0xFEA126B7D78186BCUL, 0xE2F610C84987BFA8UL},
+    {0x9F24B832E6B0F436UL, 0x0DD9CA7D2DF4D7C9UL}, {0xC6EDE63FA05D3143UL, 0x91503D1C79720DBBUL},
+    {0xF8A95FCF88747D94UL, 0x75A44C6397CE912AUL}, {0x9B69DBE1B548CE7CUL, 0xC986AFBE3EE11ABAUL},
+    {0xC24452DA229B021BUL, 0xFBE85BADCE996168UL}, {0xF2D56790AB41C2A2UL, 0xFAE27299423FB9C3UL},
+    {0x97C560BA6B0919A5UL, 0xDCCD879FC967D41AUL}, {0xBDB6B8E905CB600FUL, 0x5400E987BBC1C920UL},
+    {0xED246723473E3813UL, 0x290123E9AAB23B68UL}, {0x9436C0760C86E30BUL, 0xF9A0B6720AAF6521UL},
+    {0xB94470938FA89BCEUL, 0xF808E40E8D5B3E69UL}, {0xE7958CB87392C2C2UL, 0xB60B1D1230B20E04UL},
+    {0x90BD77F3483BB9B9UL, 0xB1C6F22B5E6F48C2UL}, {0xB4ECD5F01A4AA828UL, 0x1E38AEB6360B1AF3UL},
+    {0xE2280B6C20DD5232UL, 0x25C6DA63C38DE1B0UL}, {0x8D590723948A535FUL, 0x579C487E5A38AD0EUL},
+    {0xB0AF48EC79ACE837UL, 0x2D835A9DF0C6D851UL}, {0xDCDB1B2798182244UL, 0xF8E431456CF88E65UL},
+    {0x8A08F0F8BF0F156BUL, 0x1B8E9ECB641B58FFUL}, {0xAC8B2D36EED2DAC5UL, 0xE272467E3D222F3FUL},
+    {0xD7ADF884AA879177UL, 0x5B0ED81DCC6ABB0FUL}, {0x86CCBB52EA94BAEAUL, 0x98E947129FC2B4E9UL},
+    {0xA87FEA27A539E9A5UL, 0x3F2398D747B36224UL}, {0xD29FE4B18E88640EUL, 0x8EEC7F0D19A03AADUL},
+    {0x83A3EEEEF9153E89UL, 0x1953CF68300424ACUL}, {0xA48CEAAAB75A8E2BUL, 0x5FA8C3423C052DD7UL},
+    {0xCDB02555653131B6UL, 0x3792F412CB06794DUL}, {0x808E17555F3EBF11UL, 0xE2BBD88BBEE40BD0UL},
+    {0xA0B19D2AB70E6ED6UL, 0x5B6ACEAEAE9D0EC4UL}, {0xC8DE047564D20A8BUL, 0xF245825A5A445275UL},
+    {0xFB158592BE068D2EUL, 0xEED6E2F0F0D56712UL}, {0x9CED737BB6C4183DUL, 0x55464DD69685606BUL},
+    {0xC428D05AA4751E4CUL, 0xAA97E14C3C26B886UL}, {0xF53304714D9265DFUL, 0xD53DD99F4B3066A8UL},
+    {0x993FE2C6D07B7FABUL, 0xE546A8038EFE4029UL}, {0xBF8FDB78849A5F96UL, 0xDE98520472BDD033UL},
+    {0xEF73D256A5C0F77CUL, 0x963E66858F6D4440UL}, {0x95A8637627989AADUL, 0xDDE7001379A44AA8UL},
+    {0xBB127C53B17EC159UL, 0x5560C018580D5D52UL}, {0xE9D71B689DDE71AFUL, 0xAAB8F01E6E10B4A6UL},
+    {0x9226712162AB070DUL, 0xCAB3961304CA70E8UL}, {0xB6B00D69BB55C8D1UL, 0x3D607B97C5FD0D22UL},
+    {0xE45C10C42A2B3B05UL, 0x8CB89A7DB77C506AUL}, {0x8EB98A7A9A5B04E3UL, 0x77F3608E92ADB242UL},
+    {0xB267ED1940F1C61CUL, 0x55F038B237591ED3UL}, {0xDF01E85F912E37A3UL, 0x6B6C46DEC52F6688UL},
+    {0x8B61313BBABCE2C6UL, 0x2323AC4B3B3DA015UL}, {0xAE397D8AA96C1B77UL, 0xABEC975E0A0D081AUL},
+    {0xD9C7DCED53C72255UL, 0x96E7BD358C904A21UL}, {0x881CEA14545C7575UL, 0x7E50D64177DA2E54UL},
+    {0xAA242499697392D2UL, 0xDDE50BD1D5D0B9E9UL}, {0xD4AD2DBFC3D07787UL, 0x955E4EC64B44E864UL},
+    {0x84EC3C97DA624AB4UL, 0xBD5AF13BEF0B113EUL}, {0xA6274BBDD0FADD61UL, 0xECB1AD8AEACDD58EUL},
+    {0xCFB11EAD453994BAUL, 0x67DE18EDA5814AF2UL}, {0x81CEB32C4B43FCF4UL, 0x80EACF948770CED7UL},
+    {0xA2425FF75E14FC31UL, 0xA1258379A94D028DUL}, {0xCAD2F7F5359A3B3EUL, 0x096EE45813A04330UL},
+    {0xFD87B5F28300CA0DUL, 0x8BCA9D6E188853FCUL}, {0x9E74D1B791E07E48UL, 0x775EA264CF55347DUL},
+    {0xC612062576589DDAUL, 0x95364AFE032A819DUL}, {0xF79687AED3EEC551UL, 0x3A83DDBD83F52204UL},
+    {0x9ABE14CD44753B52UL, 0xC4926A9672793542UL}, {0xC16D9A0095928A27UL, 0x75B7053C0F178293UL},
+    {0xF1C90080BAF72CB1UL, 0x5324C68B12DD6338UL}, {0x971DA05074DA7BEEUL, 0xD3F6FC16EBCA5E03UL},
+    {0xBCE5086492111AEAUL, 0x88F4BB1CA6BCF584UL}, {0xEC1E4A7DB69561A5UL, 0x2B31E9E3D06C32E5UL},
+    {0x9392EE8E921D5D07UL, 0x3AFF322E62439FCFUL}, {0xB877AA3236A4B449UL, 0x09BEFEB9FAD487C2UL},
+    {0xE69594BEC44DE15BUL, 0x4C2EBE687989A9B3UL}, {0x901D7CF73AB0ACD9UL, 0x0F9D37014BF60A10UL},
+    {0xB424DC35095CD80FUL, 0x538484C19EF38C94UL}, {0xE12E13424BB40E13UL, 0x2865A5F206B06FB9UL},
+    {0x8CBCCC096F5088CBUL, 0xF93F87B7442E45D3UL}, {0xAFEBFF0BCB24AAFEUL, 0xF78F69A51539D748UL},
+    {0xDBE6FECEBDEDD5BEUL, 0xB573440E5A884D1BUL}, {0x89705F4136B4A597UL, 0x31680A88F8953030UL},
+    {0xABCC77118461CEFCUL, 0xFDC20D2B36BA7C3DUL}, {0xD6BF94D5E57A42BCUL, 0x3D32907604691B4CUL},
+    {0x8637BD05AF6C69B5UL, 0xA63F9A49C2C1B10FUL}, {0xA7C5AC471B478423UL, 0x0FCF80DC33721D53UL},
+    {0xD1B71758E219652BUL, 0xD3C36113404EA4A8UL}, {0x83126E978D4FDF3BUL, 0x645A1CAC083126E9UL},
+    {0xA3D70A3D70A3D70AUL, 0x3D70A3D70A3D70A3UL}, {0xCCCCCCCCCCCCCCCCUL, 0xCCCCCCCCCCCCCCCCUL},
+    {0x8000000000000000UL, 0x0000000000000000UL}, {0xA000000000000000UL, 0x0000000000000000UL},
+    {0xC800000000000000UL, 0x0000000000000000UL}, {0xFA00000000000000UL, 0x0000000000000000UL},
+    {0x9C40000000000000UL, 0x0000000000000000UL}, {0xC350000000000000UL, 0x0000000000000000UL},
+    {0xF424000000000000UL, 0x0000000000000000UL}, {0x9896800000000000UL, 0x0000000000000000UL},
+    {0xBEBC200000000000UL, 0x0000000000000000UL}, {0xEE6B280000000000UL, 0x0000000000000000UL},
+    {0x9502F90000000000UL, 0x0000000000000000UL}, {0xBA43B74000000000UL, 0x0000000000000000UL},
+    {0xE8D4A51000000000UL, 0x0000000000000000UL}, {0x9184E72A00000000UL, 0x0000000000000000UL},
+    {0xB5E620F480000000UL, 0x0000000000000000UL}, {0xE35FA931A0000000UL, 0x0000000000000000UL},
+    {0x8E1BC9BF04000000UL, 0x0000000000000000UL}, {0xB1A2BC2EC5000000UL, 0x0000000000000000UL},
+    {0xDE0B6B3A76400000UL, 0x0000000000000000UL}, {0x8AC7230489E80000UL, 0x0000000000000000UL},
+    {0xAD78EBC5AC620000UL, 0x0000000000000000UL}, {0xD8D726B7177A8000UL, 0x0000000000000000UL},
+    {0x878678326EAC9000UL, 0x0000000000000000UL}, {0xA968163F0A57B400UL, 0x0000000000000000UL},
+    {0xD3C21BCECCEDA100UL, 0x0000000000000000UL}, {0x84595161401484A0UL, 0x0000000000000000UL},
+    {0xA56FA5B99019A5C8UL, 0x0000000000000000UL}, {0xCECB8F27F4200F3AUL, 0x0000000000000000UL},
+    {0x813F3978F8940984UL, 0x4000000000000000UL}, {0xA18F07D736B90BE5UL, 0x5000000000000000UL},
+    {0xC9F2C9CD04674EDEUL, 0xA400000000000000UL}, {0xFC6F7C4045812296UL, 0x4D00000000000000UL},
+    {0x9DC5ADA82B70B59DUL, 0xF020000000000000UL}, {0xC5371912364CE305UL, 0x6C28000000000000UL},
+    {0xF684DF56C3E01BC6UL, 0xC732000000000000UL}, {0x9A130B963A6C115CUL, 0x3C7F400000000000UL},
+    {0xC097CE7BC90715B3UL, 0x4B9F100000000000UL}, {0xF0BDC21ABB48DB20UL, 0x1E86D40000000000UL},
+    {0x96769950B50D88F4UL, 0x1314448000000000UL}, {0xBC143FA4E250EB31UL, 0x17D955A000000000UL},
+    {0xEB194F8E1AE525FDUL, 0x5DCFAB0800000000UL}, {0x92EFD1B8D0CF37BEUL, 0x5AA1CAE500000000UL},
+    {0xB7ABC627050305ADUL, 0xF14A3D9E40000000UL}, {0xE596B7B0C643C719UL, 0x6D9CCD05D0000000UL},
+    {0x8F7E32CE7BEA5C6FUL, 0xE4820023A2000000UL}, {0xB35DBF821AE4F38BUL, 0xDDA2802C8A800000UL},
+    {0xE0352F62A19E306EUL, 0xD50B2037AD200000UL}, {0x8C213D9DA502DE45UL, 0x4526F422CC340000UL},
+    {0xAF298D050E4395D6UL, 0x9670B12B7F410000UL}, {0xDAF3F04651D47B4CUL, 0x3C0CDD765F114000UL},
+    {0x88D8762BF324CD0FUL, 0xA5880A69FB6AC800UL}, {0xAB0E93B6EFEE0053UL, 0x8EEA0D047A457A00UL},
+    {0xD5D238A4ABE98068UL, 0x72A4904598D6D880UL}, {0x85A36366EB71F041UL, 0x47A6DA2B7F864750UL},
+    {0xA70C3C40A64E6C51UL, 0x999090B65F67D924UL}, {0xD0CF4B50CFE20765UL, 0xFFF4B4E3F741CF6DUL},
+    {0x82818F1281ED449FUL, 0xBFF8F10E7A8921A4UL}, {0xA321F2D7226895C7UL, 0xAFF72D52192B6A0DUL},
+    {0xCBEA6F8CEB02BB39UL, 0x9BF4F8A69F764490UL}, {0xFEE50B7025C36A08UL, 0x02F236D04753D5B4UL},
+    {0x9F4F2726179A2245UL, 0x01D762422C946590UL}, {0xC722F0EF9D80AAD6UL, 0x424D3AD2B7B97EF5UL},
+    {0xF8EBAD2B84E0D58BUL, 0xD2E0898765A7DEB2UL}, {0x9B934C3B330C8577UL, 0x63CC55F49F88EB2FUL},
+    {0xC2781F49FFCFA6D5UL, 0x3CBF6B71C76B25FBUL}, {0xF316271C7FC3908AUL, 0x8BEF464E3945EF7AUL},
+    {0x97EDD871CFDA3A56UL, 0x97758BF0E3CBB5ACUL}, {0xBDE94E8E43D0C8ECUL, 0x3D52EEED1CBEA317UL},
+    {0xED63A231D4C4FB27UL, 0x4CA7AAA863EE4BDDUL}, {0x945E455F24FB1CF8UL, 0x8FE8CAA93E74EF6AUL},
+    {0xB975D6B6EE39E436UL, 0xB3E2FD538E122B44UL}, {0xE7D34C64A9C85D44UL, 0x60DBBCA87196B616UL},
+    {0x90E40FBEEA1D3A4AUL, 0xBC8955E946FE31CDUL}, {0xB51D13AEA4A488DDUL, 0x6BABAB6398BDBE41UL},
+    {0xE264589A4DCDAB14UL, 0xC696963C7EED2DD1UL}, {0x8D7EB76070A08AECUL, 0xFC1E1DE5CF543CA2UL},
+    {0xB0DE65388CC8ADA8UL, 0x3B25A55F43294BCBUL}, {0xDD15FE86AFFAD912UL, 0x49EF0EB713F39EBEUL},
+    {0x8A2DBF142DFCC7ABUL, 0x6E3569326C784337UL}, {0xACB92ED9397BF996UL, 0x49C2C37F07965404UL},
+    {0xD7E77A8F87DAF7FBUL, 0xDC33745EC97BE906UL}, {0x86F0AC99B4E8DAFDUL, 0x69A028BB3DED71A3UL},
+    {0xA8ACD7C0222311BCUL, 0xC40832EA0D68CE0CUL}, {0xD2D80DB02AABD62BUL, 0xF50A3FA490C30190UL},
+    {0x83C7088E1AAB65DBUL, 0x792667C6DA79E0FAUL}, {0xA4B8CAB1A1563F52UL, 0x577001B891185938UL},
+    {0xCDE6FD5E09ABCF26UL, 0xED4C0226B55E6F86UL}, {0x80B05E5AC60B6178UL, 0x544F8158315B05B4UL},
+    {0xA0DC75F1778E39D6UL, 0x696361AE3DB1C721UL}, {0xC913936DD571C84CUL, 0x03BC3A19CD1E38E9UL},
+    {0xFB5878494ACE3A5FUL, 0x04AB48A04065C723UL}, {0x9D174B2DCEC0E47BUL, 0x62EB0D64283F9C76UL},
+    {0xC45D1DF942711D9AUL, 0x3BA5D0BD324F8394UL}, {0xF5746577930D6500UL, 0xCA8F44EC7EE36479UL},
+    {0x9968BF6ABBE85F20UL, 0x7E998B13CF4E1ECBUL}, {0xBFC2EF456AE276E8UL, 0x9E3FEDD8C321A67EUL},
+    {0xEFB3AB16C59B14A2UL, 0xC5CFE94EF3EA101EUL}, {0x95D04AEE3B80ECE5UL, 0xBBA1F1D158724A12UL},
+    {0xBB445DA9CA61281FUL, 0x2A8A6E45AE8EDC97UL}, {0xEA1575143CF97226UL, 0xF52D09D71A3293BDUL},
+    {0x924D692CA61BE758UL, 0x593C2626705F9C56UL}, {0xB6E0C377CFA2E12EUL, 0x6F8B2FB00C77836CUL},
+    {0xE498F455C38B997AUL, 0x0B6DFB9C0F956447UL}, {0x8EDF98B59A373FECUL, 0x4724BD4189BD5EACUL},
+    {0xB2977EE300C50FE7UL, 0x58EDEC91EC2CB657UL}, {0xDF3D5E9BC0F653E1UL, 0x2F2967B66737E3EDUL},
+    {0x8B865B215899F46CUL, 0xBD79E0D20082EE74UL}, {0xAE67F1E9AEC07187UL, 0xECD8590680A3AA11UL},
+    {0xDA01EE641A708DE9UL, 0xE80E6F4820CC9495UL}, {0x884134FE908658B2UL, 0x3109058D147FDCDDUL},
+    {0xAA51823E34A7EEDEUL, 0xBD4B46F0599FD415UL}, {0xD4E5E2CDC1D1EA96UL, 0x6C9E18AC7007C91AUL},
+    {0x850FADC09923329EUL, 0x03E2CF6BC604DDB0UL}, {0xA6539930BF6BFF45UL, 0x84DB8346B786151CUL},
+    {0xCFE87F7CEF46FF16UL, 0xE612641865679A63UL}, {0x81F14FAE158C5F6EUL, 0x4FCB7E8F3F60C07EUL},
+    {0xA26DA3999AEF7749UL, 0xE3BE5E330F38F09DUL}, {0xCB090C8001AB551CUL, 0x5CADF5BFD3072CC5UL},
+    {0xFDCB4FA002162A63UL, 0x73D9732FC7C8F7F6UL}, {0x9E9F11C4014DDA7EUL, 0x2867E7FDDCDD9AFAUL},
+    {0xC646D63501A1511DUL, 0xB281E1FD541501B8UL}, {0xF7D88BC24209A565UL, 0x1F225A7CA91A4226UL},
+    {0x9AE757596946075FUL, 0x3375788DE9B06958UL}, {0xC1A12D2FC3978937UL, 0x0052D6B1641C83AEUL},
+    {0xF209787BB47D6B84UL, 0xC0678C5DBD23A49AUL}, {0x9745EB4D50CE6332UL, 0xF840B7BA963646E0UL},
+    {0xBD176620A501FBFFUL, 0xB650E5A93BC3D898UL}, {0xEC5D3FA8CE427AFFUL, 0xA3E51F138AB4CEBEUL},
+    {0x93BA47C980E98CDFUL, 0xC66F336C36B10137UL}, {0xB8A8D9BBE123F017UL, 0xB80B0047445D4184UL},
+    {0xE6D3102AD96CEC1DUL, 0xA60DC059157491E5UL}, {0x9043EA1AC7E41392UL, 0x87C89837AD68DB2FUL},
+    {0xB454E4A179DD1877UL, 0x29BABE4598C311FBUL}, {0xE16A1DC9D8545E94UL, 0xF4296DD6FEF3D67AUL},
+    {0x8CE2529E2734BB1DUL, 0x1899E4A65F58660CUL}, {0xB01AE745B101E9E4UL, 0x5EC05DCFF72E7F8FUL},
+    {0xDC21A1171D42645DUL, 0x76707543F4FA1F73UL}, {0x899504AE72497EBAUL, 0x6A06494A791C53A8UL},
+    {0xABFA45DA0EDBDE69UL, 0x0487DB9D17636892UL}, {0xD6F8D7509292D603UL, 0x45A9D2845D3C42B6UL},
+    {0x865B86925B9BC5C2UL, 0x0B8A2392BA45A9B2UL}, {0xA7F26836F282B732UL, 0x8E6CAC7768D7141EUL},
+    {0xD1EF0244AF2364FFUL, 0x3207D795430CD926UL}, {0x8335616AED761F1FUL, 0x7F44E6BD49E807B8UL},
+    {0xA402B9C5A8D3A6E7UL, 0x5F16206C9C6209A6UL}, {0xCD036837130890A1UL, 0x36DBA887C37A8C0FUL},
+    {0x802221226BE55A64UL, 0xC2494954DA2C9789UL}, {0xA02AA96B06DEB0FDUL, 0xF2DB9BAA10B7BD6CUL},
+    {0xC83553C5C8965D3DUL, 0x6F92829494E5ACC7UL}, {0xFA42A8B73ABBF48CUL, 0xCB772339BA1F17F9UL},
+    {0x9C69A97284B578D7UL, 0xFF2A760414536EFBUL}, {0xC38413CF25E2D70DUL, 0xFEF5138519684ABAUL},
+    {0xF46518C2EF5B8CD1UL, 0x7EB258665FC25D69UL}, {0x98BF2F79D5993802UL, 0xEF2F773FFBD97A61UL},
+    {0xBEEEFB584AFF8603UL, 0xAAFB550FFACFD8FAUL}, {0xEEAABA2E5DBF6784UL, 0x95BA2A53F983CF38UL},
+    {0x952AB45CFA97A0B2UL, 0xDD945A747BF26183UL}, {0xBA756174393D88DFUL, 0x94F971119AEEF9E4UL},
+    {0xE912B9D1478CEB17UL, 0x7A37CD5601AAB85DUL}, {0x91ABB422CCB812EEUL, 0xAC62E055C10AB33AUL},
+    {0xB616A12B7FE617AAUL, 0x577B986B314D6009UL}, {0xE39C49765FDF9D94UL, 0xED5A7E85FDA0B80BUL},
+    {0x8E41ADE9FBEBC27DUL, 0x14588F13BE847307UL}, {0xB1D219647AE6B31CUL, 0x596EB2D8AE258FC8UL},
+    {0xDE469FBD99A05FE3UL, 0x6FCA5F8ED9AEF3BBUL}, {0x8AEC23D680043BEEUL, 0x25DE7BB9480D5854UL},
+    {0xADA72CCC20054AE9UL, 0xAF561AA79A10AE6AUL}, {0xD910F7FF28069DA4UL, 0x1B2BA1518094DA04UL},
+    {0x87AA9AFF79042286UL, 0x90FB44D2F05D0842UL}, {0xA99541BF57452B28UL, 0x353A1607AC744A53UL},
+    {0xD3FA922F2D1675F2UL, 0x42889B8997915CE8UL}, {0x847C9B5D7C2E09B7UL, 0x69956135FEBADA11UL},
+    {0xA59BC234DB398C25UL, 0x43FAB9837E699095UL}, {0xCF02B2C21207EF2EUL, 0x94F967E45E03F4BBUL},
+    {0x8161AFB94B44F57DUL, 0x1D1BE0EEBAC278F5UL}, {0xA1BA1BA79E1632DCUL, 0x6462D92A69731732UL},
+    {0xCA28A291859BBF93UL, 0x7D7B8F7503CFDCFEUL}, {0xFCB2CB35E702AF78UL, 0x5CDA735244C3D43EUL},
+    {0x9DEFBF01B061ADABUL, 0x3A0888136AFA64A7UL}, {0xC56BAEC21C7A1916UL, 0x088AAA1845B8FDD0UL},
+    {0xF6C69A72A3989F5BUL, 0x8AAD549E57273D45UL}, {0x9A3C2087A63F6399UL, 0x36AC54E2F678864BUL},
+    {0xC0CB28A98FCF3C7FUL, 0x84576A1BB416A7DDUL}, {0xF0FDF2D3F3C30B9FUL, 0x656D44A2A11C51D5UL},
+    {0x969EB7C47859E743UL, 0x9F644AE5A4B1B325UL}, {0xBC4665B596706114UL, 0x873D5D9F0DDE1FEEUL},
+    {0xEB57FF22FC0C7959UL, 0xA90CB506D155A7EAUL}, {0x9316FF75DD87CBD8UL, 0x09A7F12442D588F2UL},
+    {0xB7DCBF5354E9BECEUL, 0x0C11ED6D538AEB2FUL}, {0xE5D3EF282A242E81UL, 0x8F1668C8A86DA5FAUL},
+    {0x8FA475791A569D10UL, 0xF96E017D694487BCUL}, {0xB38D92D760EC4455UL, 0x37C981DCC395A9ACUL},
+    {0xE070F78D3927556AUL, 0x85BBE253F47B1417UL}, {0x8C469AB843B89562UL, 0x93956D7478CCEC8EUL},
+    {0xAF58416654A6BABBUL, 0x387AC8D1970027B2UL}, {0xDB2E51BFE9D0696AUL, 0x06997B05FCC0319EUL},
+    {0x88FCF317F22241E2UL, 0x441FECE3BDF81F03UL}, {0xAB3C2FDDEEAAD25AUL, 0xD527E81CAD7626C3UL},
+    {0xD60B3BD56A5586F1UL, 0x8A71E223D8D3B074UL}, {0x85C7056562757456UL, 0xF6872D5667844E49UL},
+    {0xA738C6BEBB12D16CUL, 0xB428F8AC016561DBUL}, {0xD106F86E69D785C7UL, 0xE13336D701BEBA52UL},
+    {0x82A45B450226B39CUL, 0xECC0024661173473UL}, {0xA34D721642B06084UL, 0x27F002D7F95D0190UL},
+    {0xCC20CE9BD35C78A5UL, 0x31EC038DF7B441F4UL}, {0xFF290242C83396CEUL, 0x7E67047175A15271UL},
+    {0x9F79A169BD203E41UL, 0x0F0062C6E984D386UL}, {0xC75809C42C684DD1UL, 0x52C07B78A3E60868UL},
+    {0xF92E0C3537826145UL, 0xA7709A56CCDF8A82UL}, {0x9BBCC7A142B17CCBUL, 0x88A66076400BB691UL},
+    {0xC2ABF989935DDBFEUL, 0x6ACFF893D00EA435UL}, {0xF356F7EBF83552FEUL, 0x0583F6B8C4124D43UL},
+    {0x98165AF37B2153DEUL, 0xC3727A337A8B704AUL}, {0xBE1BF1B059E9A8D6UL, 0x744F18C0592E4C5CUL},
+    {0xEDA2EE1C7064130CUL, 0x1162DEF06F79DF73UL}, {0x9485D4D1C63E8BE7UL, 0x8ADDCB5645AC2BA8UL},
+    {0xB9A74A0637CE2EE1UL, 0x6D953E2BD7173692UL}, {0xE8111C87C5C1BA99UL, 0xC8FA8DB6CCDD0437UL},
+    {0x910AB1D4DB9914A0UL, 0x1D9C9892400A22A2UL}, {0xB54D5E4A127F59C8UL, 0x2503BEB6D00CAB4BUL},
+    {0xE2A0B5DC971F303AUL, 0x2E44AE64840FD61DUL}, {0x8DA471A9DE737E24UL, 0x5CEAECFED289E5D2UL},
+    {0xB10D8E1456105DADUL, 0x7425A83E872C5F47UL}, {0xDD50F1996B947518UL, 0xD12F124E28F77719UL},
+    {0x8A5296FFE33CC92FUL, 0x82BD6B70D99AAA6FUL}, {0xACE73CBFDC0BFB7BUL, 0x636CC64D1001550BUL},
+    {0xD8210BEFD30EFA5AUL, 0x3C47F7E05401AA4EUL}, {0x8714A775E3E95C78UL, 0x65ACFAEC34810A71UL},
+    {0xA8D9D1535CE3B396UL, 0x7F1839A741A14D0DUL}, {0xD31045A8341CA07CUL, 0x1EDE48111209A050UL},
+    {0x83EA2B892091E44DUL, 0x934AED0AAB460432UL}, {0xA4E4B66B68B65D60UL, 0xF81DA84D5617853FUL},
+    {0xCE1DE40642E3F4B9UL, 0x36251260AB9D668EUL}, {0x80D2AE83E9CE78F3UL, 0xC1D72B7C6B426019UL},
+    {0xA1075A24E4421730UL, 0xB24CF65B8612F81FUL}, {0xC94930AE1D529CFCUL, 0xDEE033F26797B627UL},
+    {0xFB9B7CD9A4A7443CUL, 0x169840EF017DA3B1UL}, {0x9D412E0806E88AA5UL, 0x8E1F289560EE864EUL},
+    {0xC491798A08A2AD4EUL, 0xF1A6F2BAB92A27E2UL}, {0xF5B5D7EC8ACB58A2UL, 0xAE10AF696774B1DBUL},
+    {0x9991A6F3D6BF1765UL, 0xACCA6DA1E0A8EF29UL}, {0xBFF610B0CC6EDD3FUL, 0x17FD090A58D32AF3UL},
+    {0xEFF394DCFF8A948EUL, 0xDDFC4B4CEF07F5B0UL}, {0x95F83D0A1FB69CD9UL, 0x4ABDAF101564F98EUL},
+    {0xBB764C4CA7A4440FUL, 0x9D6D1AD41ABE37F1UL}, {0xEA53DF5FD18D5513UL, 0x84C86189216DC5EDUL},
+    {0x92746B9BE2F8552CUL, 0x32FD3CF5B4E49BB4UL}, {0xB7118682DBB66A77UL, 0x3FBC8C33221DC2A1UL},
+    {0xE4D5E82392A40515UL, 0x0FABAF3FEAA5334AUL}, {0x8F05B1163BA6832DUL, 0x29CB4D87F2A7400EUL},
+    {0xB2C71D5BCA9023F8UL, 0x743E20E9EF511012UL}, {0xDF78E4B2BD342CF6UL, 0x914DA9246B255416UL},
+    {0x8BAB8EEFB6409C1AUL, 0x1AD089B6C2F7548EUL}, {0xAE9672ABA3D0C320UL, 0xA184AC2473B529B1UL},
+    {0xDA3C0F568CC4F3E8UL, 0xC9E5D72D90A2741EUL}, {0x8865899617FB1871UL, 0x7E2FA67C7A658892UL},
+    {0xAA7EEBFB9DF9DE8DUL, 0xDDBB901B98FEEAB7UL}, {0xD51EA6FA85785631UL, 0x552A74227F3EA565UL},
+    {0x8533285C936B35DEUL, 0xD53A88958F87275FUL}, {0xA67FF273B8460356UL, 0x8A892ABAF368F137UL},
+    {0xD01FEF10A657842CUL, 0x2D2B7569B0432D85UL}, {0x8213F56A67F6B29BUL, 0x9C3B29620E29FC73UL},
+    {0xA298F2C501F45F42UL, 0x8349F3BA91B47B8FUL}, {0xCB3F2F7642717713UL, 0x241C70A936219A73UL},
+    {0xFE0EFB53D30DD4D7UL, 0xED238CD383AA0110UL}, {0x9EC95D1463E8A506UL, 0xF4363804324A40AAUL},
+    {0xC67BB4597CE2CE48UL, 0xB143C6053EDCD0D5UL}, {0xF81AA16FDC1B81DAUL, 0xDD94B7868E94050AUL},
+    {0x9B10A4E5E9913128UL, 0xCA7CF2B4191C8326UL}, {0xC1D4CE1F63F57D72UL, 0xFD1C2F611F63A3F0UL},
+    {0xF24A01A73CF2DCCFUL, 0xBC633B39673C8CECUL}, {0x976E41088617CA01UL, 0xD5BE0503E085D813UL},
+    {0xBD49D14AA79DBC82UL, 0x4B2D8644D8A74E18UL}, {0xEC9C459D51852BA2UL, 0xDDF8E7D60ED1219EUL},
+    {0x93E1AB8252F33B45UL, 0xCABB90E5C942B503UL}, {0xB8DA1662E7B00A17UL, 0x3D6A751F3B936243UL},
+    {0xE7109BFBA19C0C9DUL, 0x0CC512670A783AD4UL}, {0x906A617D450187E2UL, 0x27FB2B80668B24C5UL},
+    {0xB484F9DC9641E9DAUL, 0xB1F9F660802DEDF6UL}, {0xE1A63853BBD26451UL, 0x5E7873F8A0396973UL},
+    {0x8D07E33455637EB2UL, 0xDB0B487B6423E1E8UL}, {0xB049DC016ABC5E5FUL, 0x91CE1A9A3D2CDA62UL},
+    {0xDC5C5301C56B75F7UL, 0x7641A140CC7810FBUL}, {0x89B9B3E11B6329BAUL, 0xA9E904C87FCB0A9DUL},
+    {0xAC2820D9623BF429UL, 0x546345FA9FBDCD44UL}, {0xD732290FBACAF133UL, 0xA97C177947AD4095UL},
+    {0x867F59A9D4BED6C0UL, 0x49ED8EABCCCC485DUL}, {0xA81F301449EE8C70UL, 0x5C68F256BFFF5A74UL},
+    {0xD226FC195C6A2F8CUL, 0x73832EEC6FFF3111UL}, {0x83585D8FD9C25DB7UL, 0xC831FD53C5FF7EABUL},
+    {0xA42E74F3D032F525UL, 0xBA3E7CA8B77F5E55UL}, {0xCD3A1230C43FB26FUL, 0x28CE1BD2E55F35EBUL},
+    {0x80444B5E7AA7CF85UL, 0x7980D163CF5B81B3UL}, {0xA0555E361951C366UL, 0xD7E105BCC332621FUL},
+    {0xC86AB5C39FA63440UL, 0x8DD9472BF3FEFAA7UL}, {0xFA856334878FC150UL, 0xB14F98F6F0FEB951UL},
+    {0x9C935E00D4B9D8D2UL, 0x6ED1BF9A569F33D3UL}, {0xC3B8358109E84F07UL, 0x0A862F80EC4700C8UL},
+    {0xF4A642E14C6262C8UL, 0xCD27BB612758C0FAUL}, {0x98E7E9CCCFBD7DBDUL, 0x8038D51CB897789CUL},
+    {0xBF21E44003ACDD2CUL, 0xE0470A63E6BD56C3UL}, {0xEEEA5D5004981478UL, 0x1858CCFCE06CAC74UL},
+    {0x95527A5202DF0CCBUL, 0x0F37801E0C43EBC8UL}, {0xBAA718E68396CFFDUL, 0xD30560258F54E6BAUL},
+    {0xE950DF20247C83FDUL, 0x47C6B82EF32A2069UL}, {0x91D28B7416CDD27EUL, 0x4CDC331D57FA5441UL},
+    {0xB6472E511C81471DUL, 0xE0133FE4ADF8E952UL}, {0xE3D8F9E563A198E5UL, 0x58180FDDD97723A6UL},
+    {0x8E679C2F5E44FF8FUL, 0x570F09EAA7EA7648UL}
+};
+
+const char g_fltconv_digit_pairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+
+// return number of bits of 5^e, e > 0
+inline sint32 fltconv_pow5bits(sint32 e)
+{
+    return (sint32)(((uint32)e * 1217359) >> 19) + 1;
+}
+
+// return floor(log10(2^e))
+inline uint32 fltconv_log10_pow2(sint32 e)
+{
+    return ((uint32)e * 78913) >> 18;
+}
+
+// return floor(log10(5^e))
+inline uint32 fltconv_log10_pow5(sint32 e)
+{
+    return ((uint32)e * 732923) >> 20;
+}
+
+// return maximum p such that 5^p divides v
+inline uint32 fltconv_pow5_factor(uint64 v)
+{
+    uint32 p = 0;
+
+    while(v % 5 == 0)
+    {
+        v /= 5;
+        p++;
+    }
+
+    return p;
+}
+
+// return (m * mul) >> j, mul is 128-bit number as low and high 64 bits, j >= 64
+inline uint64 fltconv_mul_shift64(uint64 m, const uint64 *mul, sint32 j)
+{
+    uint128 b0 = (uint128)m * mul[0];
+    uint128 b2 = (uint128)m * mul[1];
+
+    return (uint64)(((b0 >> 64) + b2) >> (j - 64));
+}
+
+// return (m * factor) >> shift, shift > 32
+inline uint32 fltconv_mul_shift32(uint32 m, uint64 factor, sint32 shift)
+{
+    uint64 bits0 = (uint64)m * (uint32)factor;
+    uint64 bits1 = (uint64)m * (factor >> 32);
+
+    return (uint32)(((bits0 >> 32) + bits1) >> (shift - 32));
+}
+
+// return number of decimal digits of v
+inline uint32 fltconv_digits(uint64 v)
+{
+    uint32 n = 1;
+
+    while(v >= 10000)
+    {
+        v /= 10000;
+        n += 4;
+    }
+    while(v >= 10)
+    {
+        v /= 10;
+        n++;
+    }
+
+    return n;
+}
+
+
+// convert binary mantissa and exponent of double to the shortest decimal output * 10^e10 rounding back to it
+void fltconv_shortest_double(uint64 ieee_m, uint32 ieee_e, uint64 *output, sint32 *e10)
+{
+    sint32 e2, q, k, i, j;
+    uint64 m2, mv, vr, vp, vm, vp_div, vm_div, vr_div;
+    uint32 mm_shift, removed = 0;
+    uint8 accept_bounds, vm_trailing_zeros = 0, vr_trailing_zeros = 0, last_removed = 0, round_up = 0;
+
+    if(ieee_e == 0)
+    {
+        e2 = 1 - FLTCONV_DOUBLE_BIAS - FLTCONV_DOUBLE_MANTISSA_BITS - 2;
+        m2 = ieee_m;
+    }
+    else
+    {
+        e2 = (sint32)ieee_e - FLTCONV_DOUBLE_BIAS - FLTCONV_DOUBLE_MANTISSA_BITS - 2;
+        m2 = (1UL << FLTCONV_DOUBLE_MANTISSA_BITS) | ieee_m;
+    }
+    accept_bounds = (m2 & 1) == 0;
+
+    // interval of decimals rounding to the number is (mm, mp) around mv, all scaled by 4
+    mv = 4 * m2;
+    mm_shift = ieee_m != 0 || ieee_e <= 1;
+
+    if(e2 >= 0)
+    {
+        q = (sint32)fltconv_log10_pow2(e2) - (e2 > 3);
+        *e10 = q;
+        k = FLTCONV_POW5_INV_BITCOUNT + fltconv_pow5bits(q) - 1;
+        i = -e2 + q + k;
+        vr = fltconv_mul_shift64(4 * m2, g_fltconv_pow5_inv[q], i);
+        vp = fltconv_mul_shift64(4 * m2 + 2, g_fltconv_pow5_inv[q], i);
+        vm = fltconv_mul_shift64(4 * m2 - 1 - mm_shift, g_fltconv_pow5_inv[q], i);
+
+        if(q <= 21)
+        {
+            // only one of mp, mv, and mm can be a multiple of 5
+            if(mv % 5 == 0)
+            {
+                vr_trailing_zeros = fltconv_pow5_factor(mv) >= (uint32)q;
+            }
+            else if(accept_bounds)
+            {
+                vm_trailing_zeros = fltconv_pow5_factor(mv - 1 - mm_shift) >= (uint32)q;
+            }
+            else
+            {
+                vp -= fltconv_pow5_factor(mv + 2) >= (uint32)q;
+            }
+        }
+    }
+    else
+    {
+        q = (sint32)fltconv_log10_pow5(-e2) - (-e2 > 1);
+        *e10 = q + e2;
+        i = -e2 - q;
+        k = fltconv_pow5bits(i) - FLTCONV_POW5_BITCOUNT;
+        j = q - k;
+        vr = fltconv_mul_shift64(4 * m2, g_fltconv_pow5[i], j);
+        vp = fltconv_mul_shift64(4 * m2 + 2, g_fltconv_pow5[i], j);
+        vm = fltconv_mul_shift64(4 * m2 - 1 - mm_shift, g_fltconv_pow5[i], j);
+
+        if(q <= 1)
+        {
+            // mv = 4 * m2 has at least 2 trailing 0 bits
+            vr_trailing_zeros = 1;
+            if(accept_bounds)
+            {
+                vm_trailing_zeros = mm_shift == 1;
+            }
+            else
+            {
+                vp--;
+            }
+        }
+        else if(q < 63)
+        {
+            // the full product has at least q trailing zeros if mv has q trailing zero bits
+            vr_trailing_zeros = (mv & ((1UL << q) - 1)) == 0;
+        }
+    }
+
+    // remove digits while the interval holds distinct decimals
+    if(vm_trailing_zeros || vr_trailing_zeros)
+    {
+        for(;;)
+        {
+            vp_div = vp / 10;
+            vm_div = vm / 10;
+            if(vp_div <= vm_div) break;
+            vr_div = vr / 10;
+            vm_trailing_zeros &= vm - vm_div * 10 == 0;
+            vr_trailing_zeros &= last_removed == 0;
+            last_removed = (uint8)(vr - vr_div * 10);
+            vr = vr_div;
+            vp = vp_div;
+            vm = vm_div;
+            removed++;
+        }
+
+        if(vm_trailing_zeros)
+        {
+            for(;;)
+            {
+                vm_div = vm / 10;
+                if(vm - vm_div * 10 != 0) break;
+                vp_div = vp / 10;
+                vr_div = vr / 10;
+                vr_trailing_zeros &= last_removed == 0;
+                last_removed = (uint8)(vr - vr_div * 10);
+                vr = vr_div;
+                vp = vp_div;
+                vm = vm_div;
+                removed++;
+            }
+        }
+
+        // exactly half way, round to even
+        if(vr_trailing_zeros && last_removed == 5 && vr % 2 == 0) last_removed = 4;
+
+        *output = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) || last_removed >= 5);
+    }
+    else
+    {
+        // common case, two digits are removed at once while possible
+        if(vp / 100 > vm / 100)
+        {
+            round_up = vr % 100 >= 50;
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+
+        for(;;)
+        {
+            vp_div = vp / 10;
+            vm_div = vm / 10;
+            if(vp_div <= vm_div) break;
+            vr_div = vr / 10;
+            round_up = vr - vr_div * 10 >= 5;
+            vr = vr_div;
+            vp = vp_div;
+            vm = vm_div;
+            removed++;
+        }
+
+        *output = vr + (vr == vm || round_up);
+    }
+
+    *e10 += removed;
+}
+
+
+// convert binary mantissa and exponent of float to the shortest decimal output * 10^e10 rounding back to it
+void fltconv_shortest_float(uint32 ieee_m, uint32 ieee_e, uint32 *output, sint32 *e10)
+{
+    sint32 e2, q, k, i, j, l;
+    uint32 m2, mv, mp, mm, vr, vp, vm, mm_shift, removed = 0;
+    uint8 accept_bounds, vm_trailing_zeros = 0, vr_trailing_zeros = 0, last_removed = 0;
+
+    if(ieee_e == 0)
+    {
+        e2 = 1 - FLTCONV_FLOAT_BIAS - FLTCONV_FLOAT_MANTISSA_BITS - 2;
+        m2 = ieee_m;
+    }
+    else
+    {
+        e2 = (sint32)ieee_e - FLTCONV_FLOAT_BIAS - FLTCONV_FLOAT_MANTISSA_BITS - 2;
+        m2 = (1U << FLTCONV_FLOAT_MANTISSA_BITS) | ieee_m;
+    }
+    accept_bounds = (m2 & 1) == 0;
+
+    mv = 4 * m2;
+    mp = 4 * m2 + 2;
+    mm_shift = ieee_m != 0 || ieee_e <= 1;
+    mm = 4 * m2 - 1 - mm_shift;
+
+    // multipliers are the high 64 bits of the double multipliers, the inverse ones need + 1
+    if(e2 >= 0)
+    {
+        q = (sint32)fltconv_log10_pow2(e2);
+        *e10 = q;
+        k = FLTCONV_FLOAT_POW5_INV_BITCOUNT + fltconv_pow5bits(q) - 1;
+        i = -e2 + q + k;
+        vr = fltconv_mul_shift32(mv, g_fltconv_pow5_inv[q][1] + 1, i);
+        vp = fltconv_mul_shift32(mp, g_fltconv_pow5_inv[q][1] + 1, i);
+        vm = fltconv_mul_shift32(mm, g_fltconv_pow5_inv[q][1] + 1, i);
+
+        if(q != 0 && (vp - 1) / 10 <= vm / 10)
+        {
+            // one removed digit is needed even if no digits are removed below
+            l = FLTCONV_FLOAT_POW5_INV_BITCOUNT + fltconv_pow5bits(q - 1) - 1;
+            last_removed = (uint8)(fltconv_mul_shift32(mv, g_fltconv_pow5_inv[q - 1][1] + 1, -e2 + q - 1 + l) % 10);
+        }
+
+        if(q <= 9)
+        {
+            if(mv % 5 == 0)
+            {
+                vr_trailing_zeros = fltconv_pow5_factor(mv) >= (uint32)q;
+            }
+            else if(accept_bounds)
+            {
+                vm_trailing_zeros = fltconv_pow5_factor(mm) >= (uint32)q;
+            }
+            else
+            {
+                vp -= fltconv_pow5_factor(mp) >= (uint32)q;
+            }
+        }
+    }
+    else
+    {
+        q = (sint32)fltconv_log10_pow5(-e2);
+        *e10 = q + e2;
+        i = -e2 - q;
+        k = fltconv_pow5bits(i) - FLTCONV_FLOAT_POW5_BITCOUNT;
+        j = q - k;
+        vr = fltconv_mul_shift32(mv, g_fltconv_pow5[i][1], j);
+        vp = fltconv_mul_shift32(mp, g_fltconv_pow5[i][1], j);
+        vm = fltconv_mul_shift32(mm, g_fltconv_pow5[i][1], j);
+
+        if(q != 0 && (vp - 1) / 10 <= vm / 10)
+        {
+            j = q - 1 - (fltconv_pow5bits(i + 1) - FLTCONV_FLOAT_POW5_BITCOUNT);
+            last_removed = (uint8)(fltconv_mul_shift32(mv, g_fltconv_pow5[i + 1][1], j) % 10);
+        }
+
+        if(q <= 1)
+        {
+            vr_trailing_zeros = 1;
+            if(accept_bounds)
+            {
+                vm_trailing_zeros = mm_shift == 1;
+            }
+            else
+            {
+                vp--;
+            }
+        }
+        else if(q < 31)
+        {
+            vr_trailing_zeros = (mv & ((1U << (q - 1)) - 1)) == 0;
+        }
+    }
+
+    if(vm_trailing_zeros || vr_trailing_zeros)
+    {
+        while(vp / 10 > vm / 10)
+        {
+            vm_trailing_zeros &= vm % 10 == 0;
+            vr_trailing_zeros &= last_removed == 0;
+            last_removed = (uint8)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+
+        if(vm_trailing_zeros)
+        {
+            while(vm % 10 == 0)
+            {
+                vr_trailing_zeros &= last_removed == 0;
+                last_removed = (uint8)(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+
+        if(vr_trailing_zeros && last_removed == 5 && vr % 2 == 0) last_removed = 4;
+
+        *output = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) || last_removed >= 5);
+    }
+    else
+    {
+        while(vp / 10 > vm / 10)
+        {
+            last_removed = (uint8)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+
+        *output = vr + (vr == vm || last_removed >= 5);
+    }
+
+    *e10 += removed;
+}
+
+
+// write digits of v of n digits to buf
+inline void fltconv_write_digits(uint64 v, uint32 n, uint8 *buf)
+{
+    uint32 r;
+
+    while(n >= 2)
+    {
+        r = (uint32)(v % 100) * 2;
+        v /= 100;
+        n -= 2;
+        buf[n] = (uint8)g_fltconv_digit_pairs[r];
+        buf[n + 1] = (uint8)g_fltconv_digit_pairs[r + 1];
+    }
+
+    if(n == 1) buf[0] = (uint8)('0' + v);
+}
+
+// write decimal output * 10^e10 with sign to buf
+// return number of bytes written
+uint32 fltconv_write(uint64 output, sint32 e10, uint8 neg, uint8 *buf)
+{
+    uint8 *p = buf;
+    uint32 n = fltconv_digits(output);
+    sint32 x = e10 + (sint32)n - 1;     // exponent in scientific notation
+    uint32 ex;
+
+    if(neg) *p++ = '-';
+
+    if(x >= FLTCONV_FIXED_MIN_EXP && x < FLTCONV_FIXED_MAX_EXP)
+    {
+        if(e10 >= 0)
+        {
+            // integer
+            fltconv_write_digits(output, n, p);
+            p += n;
+            memset(p, '0', e10);
+            p += e10;
+        }
+        else if(x >= 0)
+        {
+            // point inside digits
+            fltconv_write_digits(output, n, p + 1);
+            memmove(p, p + 1, x + 1);
+            p[x + 1] = '.';
+            p += n + 1;
+        }
+        else
+        {
+            // 0.000ddd
+            *p++ = '0';
+            *p++ = '.';
+            memset(p, '0', -x - 1);
+            p += -x - 1;
+            fltconv_write_digits(output, n, p);
+            p += n;
+        }
+    }
+    else
+    {
+        // d.ddde+xx
+        fltconv_write_digits(output, n, p + 1);
+        p[0] = p[1];
+        if(n > 1)
+        {
+            p[1] = '.';
+            p += n + 1;
+        }
+        else
+        {
+            p++;
+        }
+
+        *p++ = 'e';
+        *p++ = x < 0 ? '-' : '+';
+        ex = (uint32)(x < 0 ? -x : x);
+        if(ex >= 100)
+        {
+            *p++ = (uint8)('0' + ex / 100);
+            ex %= 100;
+        }
+        *p++ = (uint8)g_fltconv_digit_pairs[ex * 2];
+        *p++ = (uint8)g_fltconv_digit_pairs[ex * 2 + 1];
+    }
+
+    return (uint32)(p - buf);
+}
+
+// write NaN, infinity or zero to buf
+// return number of bytes written
+uint32 fltconv_write_special(uint8 neg, uint8 nan, uint8 zero, uint8 *buf)
+{
+    uint8 *p = buf;
+
+    if(nan)
+    {
+        memcpy(p, "NaN", 3);
+        return 3;
+    }
+
+    if(neg) *p++ = '-';
+
+    if(zero)
+    {
+        *p++ = '0';
+    }
+    else
+    {
+        memcpy(p, "Infinity", 8);
+        p += 8;
+    }
+
+    return (uint32)(p - buf);
+}
+
+
+// format v to buf of at least FLTCONV_DOUBLE_MAX_SZ bytes
+// return number of bytes written
+uint32 fltconv_format_double(float64 v, uint8 *buf)
+{
+    uint64 bits, ieee_m, output;
+    uint32 ieee_e;
+    sint32 e10;
+    uint8 neg;
+
+    memcpy(&bits, &v, sizeof(bits));
+    neg = (uint8)(bits >> (FLTCONV_DOUBLE_MANTISSA_BITS + FLTCONV_DOUBLE_EXPONENT_BITS));
+    ieee_m = bits & ((1UL << FLTCONV_DOUBLE_MANTISSA_BITS) - 1);
+    ieee_e = (uint32)(bits >> FLTCONV_DOUBLE_MANTISSA_BITS) & ((1U << FLTCONV_DOUBLE_EXPONENT_BITS) - 1);
+
+    if(ieee_e == (1U << FLTCONV_DOUBLE_EXPONENT_BITS) - 1 || (ieee_e == 0 && ieee_m == 0))
+    {
+        return fltconv_write_special(neg, ieee_e != 0 && ieee_m != 0, ieee_e == 0, buf);
+    }
+
+    // small integers are exact, trailing zeroes are moved to exponent
+    e10 = (sint32)ieee_e - FLTCONV_DOUBLE_BIAS - FLTCONV_DOUBLE_MANTISSA_BITS;
+    if(e10 <= 0 && e10 >= -FLTCONV_DOUBLE_MANTISSA_BITS
+        && (((1UL << FLTCONV_DOUBLE_MANTISSA_BITS) | ieee_m) & ((1UL << -e10) - 1)) == 0)
+    {
+        output = ((1UL << FLTCONV_DOUBLE_MANTISSA_BITS) | ieee_m) >> -e10;
+        e10 = 0;
+        while(output % 10 == 0)
+        {
+            output /= 10;
+            e10++;
+        }
+    }
+    else
+    {
+        fltconv_shortest_double(ieee_m, ieee_e, &output, &e10);
+    }
+
+    return fltconv_write(output, e10, neg, buf);
+}
+
+// format v to buf of at least FLTCONV_FLOAT_MAX_SZ bytes
+// return number of bytes written
+uint32 fltconv_format_float(float32 v, uint8 *buf)
+{
+    uint32 bits, ieee_m, ieee_e, output;
+    sint32 e10;
+    uint8 neg;
+
+    memcpy(&bits, &v, sizeof(bits));
+    neg = (uint8)(bits >> (FLTCONV_FLOAT_MANTISSA_BITS + FLTCONV_FLOAT_EXPONENT_BITS));
+    ieee_m = bits & ((1U << FLTCONV_FLOAT_MANTISSA_BITS) - 1);
+    ieee_e = (bits >> FLTCONV_FLOAT_MANTISSA_BITS) & ((1U << FLTCONV_FLOAT_EXPONENT_BITS) - 1);
+
+    if(ieee_e == (1U << FLTCONV_FLOAT_EXPONENT_BITS) - 1 || (ieee_e == 0 && ieee_m == 0))
+    {
+        return fltconv_write_special(neg, ieee_e != 0 && ieee_m != 0, ieee_e == 0, buf);
+    }
+
+    fltconv_shortest_float(ieee_m, ieee_e, &output, &e10);
+
+    return fltconv_write(output, e10, neg, buf);
+}
+
+
+// binary floating point format for conversion from decimal
+typedef struct _fltconv_binary
+{
+    sint32 mantissa_bits;       // explicit mantissa bits
+    sint32 bias;                // exponent bias
+    sint32 even_min_exp;        // decimal exponents where product can be exactly halfway between two numbers
+    sint32 even_max_exp;
+} fltconv_binary;
+
+const fltconv_binary g_fltconv_double = {FLTCONV_DOUBLE_MANTISSA_BITS, FLTCONV_DOUBLE_BIAS, -4, 23};
+const fltconv_binary g_fltconv_float = {FLTCONV_FLOAT_MANTISSA_BITS, FLTCONV_FLOAT_BIAS, -17, 10};
+
+// convert w * 10^q, w > 0, to bits of the nearest number of binary format fmt (Eisel-Lemire algorithm):
+// w normalized to 64 bits is multiplied by 128-bit 5^q, which gives mantissa unless the product is too close
+// to halfway between two numbers to be sure of rounding
+// return 0 on success, 1 if result is not certain or subnormal
+sint8 fltconv_lemire(uint64 w, sint32 q, const fltconv_binary *fmt, uint64 *bits)
+{
+    const uint64 *pow5;
+    uint128 product;
+    uint64 hi, lo, mantissa, mask;
+    sint32 lz, upper, shift, power2;
+
+    if(q < FLTCONV_LEMIRE_MIN_EXP)
+    {
+        *bits = 0;
+        return 0;
+    }
+    if(q > FLTCONV_LEMIRE_MAX_EXP)
+    {
+        *bits = (uint64)(2 * fmt->bias + 1) << fmt->mantissa_bits;
+        return 0;
+    }
+
+    lz = __builtin_clzl(w);
+    w <<= lz;
+    pow5 = g_fltconv_pow10_128[q - FLTCONV_LEMIRE_MIN_EXP];
+
+    // the low half of power matters only if the truncated bits of the product are all ones
+    product = (uint128)w * pow5[0];
+    hi = (uint64)(product >> 64);
+    lo = (uint64)product;
+    mask = ~0UL >> (fmt->mantissa_bits + 3);
+    if((hi & mask) == mask)
+    {
+        product = (uint128)w * pow5[1];
+        lo += (uint64)(product >> 64);
+        hi += lo < (uint64)(product >> 64);
+        if(lo == ~0UL && (q < -27 || q > 55)) return 1;
+    }
+
+    upper = (sint32)(hi >> 63);
+    shift = upper + 64 - fmt->mantissa_bits - 3;
+    mantissa = hi >> shift;
+    power2 = (((152170 + 65536) * q) >> 16) + 63 + upper - lz + fmt->bias;
+    if(power2 <= 0) return 1;
+
+    // exactly halfway, round to even
+    if(lo <= 1 && q >= fmt->even_min_exp && q <= fmt->even_max_exp && (mantissa & 3) == 1 && (mantissa << shift) == hi)
+    {
+        mantissa &= ~1UL;
+    }
+
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if(mantissa >= (2UL << fmt->mantissa_bits))
+    {
+        mantissa = 1UL << fmt->mantissa_bits;
+        power2++;
+    }
+    mantissa &= ~(1UL << fmt->mantissa_bits);
+
+    if(power2 >= 2 * fmt->bias + 1)
+    {
+        power2 = 2 * fmt->bias + 1;
+        mantissa = 0;
+    }
+
+    *bits = mantissa | (uint64)power2 << fmt->mantissa_bits;
+    return 0;
+}
+
+// convert truncated w * 10^q to bits of number of binary format fmt, the result has to be the same for w + 1
+// return 0 on success, 1 if result is not certain
+sint8 fltconv_lemire_truncated(uint64 w, sint32 q, const fltconv_binary *fmt, uint64 *bits)
+{
+    uint64 upper;
+
+    if(0 != fltconv_lemire(w, q, fmt, bits)) return 1;
+    if(0 != fltconv_lemire(w + 1, q, fmt, &upper)) return 1;
+
+    return *bits != upper;
+}
+
+
+// return w * 10^e correctly rounded, negated if neg is 1
+float64 fltconv_to_double(uint64 w, sint32 e, uint8 neg)
+{
+    uint8 str[FLTCONV_MAX_DIGITS + 16];
+    float64 v;
+    uint64 bits;
+
+    if(w == 0)
+    {
+        v = 0.0;
+    }
+    else if(w <= FLTCONV_FAST_MAX_W && e >= -FLTCONV_FAST_MAX_EXP && e <= FLTCONV_FAST_MAX_EXP)
+    {
+        // both operands are exact, so is the rounding of the single operation
+        v = e < 0 ? (float64)w / g_fltconv_pow10[-e] : (float64)w * g_fltconv_pow10[e];
+    }
+    else if(0 == fltconv_lemire(w, e, &g_fltconv_double, &bits))
+    {
+        memcpy(&v, &bits, sizeof(v));
+    }
+    else
+    {
+        snprintf((char *)str, sizeof(str), "%lue%d", w, e);
+        v = strtod((const char *)str, NULL);
+    }
+
+    return neg ? -v : v;
+}
+
+
+// number parsed from text
+typedef struct _fltconv_number
+{
+    uint64 w;           // the first FLTCONV_MAX_DIGITS significant digits
+    sint32 e;           // number = w * 10^e if not truncated
+    uint32 sz;          // number of bytes of text
+    uint8  neg;
+    uint8  truncated;   // 1 if there are more significant digits than in w
+    uint8  special;     // 1 - NaN, 2 - Infinity
+} fltconv_number;
+
+// return 1 if str of sz bytes starts with word, case insensitive
+inline uint8 fltconv_starts_with(const uint8 *str, uint32 sz, const char *word, uint32 len)
+{
+    uint32 i;
+
+    if(sz < len) return 0;
+    for(i = 0; i < len; i++)
+    {
+        if((str[i] | 0x20) != (uint8)word[i]) return 0;
+    }
+
+    return 1;
+}
+
+// scan number from str of sz bytes
+// return number of bytes read, 0 if str does not start with number
+uint32 fltconv_scan(const uint8 *str, uint32 sz, fltconv_number *num)
+{
+    uint32 i = 0, digits = 0, mantissa_digits = 0;
+    sint32 e = 0, exp_sign = 1;
+    uint8 c;
+
+    memset(num, 0, sizeof(*num));
+
+    if(i < sz && (str[i] == '-' || str[i] == '+'))
+    {
+        num->neg = str[i] == '-';
+        i++;
+    }
+
+    if(fltconv_starts_with(str + i, sz - i, "nan", 3))
+    {
+        num->special = 1;
+        num->sz = i + 3;
+        return num->sz;
+    }
+    if(fltconv_starts_with(str + i, sz - i, "infinity", 8))
+    {
+        num->special = 2;
+        num->sz = i + 8;
+        return num->sz;
+    }
+
+    // leading zeroes are not significant
+    while(i < sz && str[i] == '0')
+    {
+        i++;
+        mantissa_digits++;
+    }
+
+    for(; i < sz && (c = (uint8)(str[i] - '0')) <= 9; i++, mantissa_digits++)
+    {
+        if(digits < FLTCONV_MAX_DIGITS)
+        {
+            num->w = num->w * 10 + c;
+            digits++;
+        }
+        else
+        {
+            num->truncated |= c != 0;
+            e++;
+        }
+    }
+
+    if(i < sz && str[i] == '.')
+    {
+        i++;
+        if(digits == 0)
+        {
+            while(i < sz && str[i] == '0')
+            {
+                i++;
+                mantissa_digits++;
+                e--;
+            }
+        }
+
+        for(; i < sz && (c = (uint8)(str[i] - '0')) <= 9; i++, mantissa_digits++)
+        {
+            if(digits < FLTCONV_MAX_DIGITS)
+            {
+                num->w = num->w * 10 + c;
+                digits++;
+                e--;
+            }
+            else
+            {
+                num->truncated |= c != 0;
+            }
+        }
+    }
+
+    if(mantissa_digits == 0) return 0;
+
+    if(i + 1 < sz && (str[i] == 'e' || str[i] == 'E'))
+    {
+        uint32 j = i + 1;
+        sint32 x = 0;
+
+        if(str[j] == '-' || str[j] == '+')
+        {
+            exp_sign = str[j] == '-' ? -1 : 1;
+            j++;
+        }
+
+        if(j < sz && (uint8)(str[j] - '0') <= 9)
+        {
+            for(; j < sz && (c = (uint8)(str[j] - '0')) <= 9; j++)
+            {
+                if(x < FLTCONV_MAX_EXP) x = x * 10 + c;
+            }
+            e += exp_sign * x;
+            i = j;
+        }
+    }
+
+    num->e = e;
+    num->sz = i;
+    return i;
+}
+
+// write number of sz bytes already scanned by fltconv_scan as NUL-terminated 0.digits * 10^exp to buf
+// of FLTCONV_SLOW_BUF_SZ bytes for strtod, significant digits after FLTCONV_SLOW_MAX_DIGITS are replaced by single
+// non-zero digit, which keeps rounding the same
+void fltconv_canonize(const uint8 *str, uint32 sz, char *buf)
+{
+    uint32 i = 0, n = 0, digits = 0;
+    sint32 e = 0, x = 0, exp_sign = 1;
+    uint8 point = 0, significant = 0, sticky = 0;
+
+    if(str[i] == '-' || str[i] == '+')
+    {
+        if(str[i] == '-') buf[n++] = '-';
+        i++;
+    }
+    buf[n++] = '0';
+    buf[n++] = '.';
+
+    for(; i < sz && str[i] != 'e' && str[i] != 'E'; i++)
+    {
+        if(str[i] == '.')
+        {
+            point = 1;
+            continue;
+        }
+
+        significant |= str[i] != '0';
+        if(!significant)
+        {
+            e -= point;
+            continue;
+        }
+
+        e += !point;
+        if(digits < FLTCONV_SLOW_MAX_DIGITS)
+        {
+            buf[n++] = (char)str[i];
+            digits++;
+        }
+        else
+        {
+            sticky |= str[i] != '0';
+        }
+    }
+    if(sticky) buf[n++] = '1';
+
+    if(i < sz)
+    {
+        for(i++; i < sz; i++)
+        {
+            if(str[i] == '-') exp_sign = -1;
+            else if(str[i] != '+' && x < FLTCONV_MAX_EXP) x = x * 10 + (str[i] - '0');
+        }
+        e += exp_sign * x;
+    }
+
+    snprintf(buf + n, FLTCONV_SLOW_BUF_SZ - n, "e%d", e);
+}
+
+// parse number from str of sz bytes: [+|-]digits[.digits][(e|E)[+|-]digits], NaN, Infinity, -Infinity
+// return number of bytes read, 0 if str does not start with number
+uint32 fltconv_parse_double(const uint8 *str, uint32 sz, float64 *v)
+{
+    fltconv_number num;
+    char buf[FLTCONV_SLOW_BUF_SZ];
+    uint64 bits;
+
+    if(0 == fltconv_scan(str, sz, &num)) return 0;
+
+    if(num.special)
+    {
+        *v = num.special == 1 ? __builtin_nan("") : (num.neg ? -__builtin_inf() : __builtin_inf());
+    }
+    else if(!num.truncated)
+    {
+        *v = fltconv_to_double(num.w, num.e, num.neg);
+    }
+    else if(0 == fltconv_lemire_truncated(num.w, num.e, &g_fltconv_double, &bits))
+    {
+        memcpy(v, &bits, sizeof(*v));
+        if(num.neg) *v = -*v;
+    }
+    else
+    {
+        fltconv_canonize(str, num.sz, buf);
+        *v = strtod(buf, NULL);
+    }
+
+    return num.sz;
+}
+
+// parse float from str of sz bytes, see fltconv_parse_double
+// return number of bytes read, 0 if str does not start with number
+uint32 fltconv_parse_float(const uint8 *str, uint32 sz, float32 *v)
+{
+    fltconv_number num;
+    char buf[FLTCONV_SLOW_BUF_SZ];
+    uint64 bits = 0;
+    uint32 fbits;
+    float32 f;
+
+    if(0 == fltconv_scan(str, sz, &num)) return 0;
+
+    if(num.special)
+    {
+        *v = num.special == 1 ? __builtin_nanf("") : (num.neg ? -__builtin_inff() : __builtin_inff());
+    }
+    else if(!num.truncated && num.w <= FLTCONV_FLOAT_FAST_MAX_W && num.e >= -FLTCONV_FLOAT_FAST_MAX_EXP && num.e <= FLTCONV_FLOAT_FAST_MAX_EXP)
+    {
+        f = num.e < 0 ? (float32)num.w / g_fltconv_pow10f[-num.e] : (float32)num.w * g_fltconv_pow10f[num.e];
+        *v = num.neg ? -f : f;
+    }
+    else if(num.w == 0 || 0 == (num.truncated ? fltconv_lemire_truncated(num.w, num.e, &g_fltconv_float, &bits)
+                                              : fltconv_lemire(num.w, num.e, &g_fltconv_float, &bits)))
+    {
+        fbits = (uint32)bits;
+        memcpy(&f, &fbits, sizeof(f));
+        *v = num.neg ? -f : f;
+    }
+    else
+    {
+        // rounding to double and then to float is not exact, text goes to strtof
+        fltconv_canonize(str, num.sz, buf);
+        *v = strtof(buf, NULL);
+    }
+
+    return num.sz;
+}
@@ -0,0 +1,367 @@
+#include "common/hmap.h"
+#include "common/error.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define HMAP_SSE2
+#include <emmintrin.h>
+#endif
+
+
+#define HMAP_GROUP_SZ           (16)
+#define HMAP_MIN_CAPACITY       (16)
+#define HMAP_MIGRATE_SLOTS      (64)        // slots of old table moved on each insert and delete
+
+#define HMAP_CTRL_EMPTY         (0x80)
+#define HMAP_CTRL_DELETED       (0xFE)      // full slots have control byte below 0x80
+
+// hash spread over 64 bits, so weak low bits of the hash function don't cluster entries
+#define HMAP_MIX(hash)          ((uint64)(hash) * 0x9E3779B97F4A7C15UL)
+#define HMAP_H1(mix)            ((uint32)((mix) >> 32))
+#define HMAP_H2(mix)            ((uint8)((mix) >> 25) & 0x7F)
+
+
+typedef struct _hmap_slot
+{
+    hmap_entry  entry;
+    uint32      hash;           // value of hash function for the key
+} hmap_slot;
+
+
+typedef struct _hmap_table
+{
+    uint32      cap;            // number of slots, power of 2
+    uint32      used;           // full slots
+    uint32      deleted;        // tombstones
+    uint8       *ctrl;          // cap + HMAP_GROUP_SZ control bytes, the last group mirrors the first one
+    hmap_slot   *slots;
+    void        *mem;           // heap block of the table, NULL if it is in the map buffer
+} hmap_table;
+
+
+typedef struct _hmap_state
+{
+    hmap_hfun   hfun;
+    hmap_table  cur;            // table new entries are added to
+    hmap_table  old;            // table being moved to cur, its slots are NULL if there is none
+    uint32      migrated;       // slots of old table moved so far
+    uint64      data[];         // the first table
+} hmap_state;
+
+
+// return number of slots of table holding up to n entries
+uint32 hmap_capacity(uint32 n)
+{
+    uint64 cap = HMAP_MIN_CAPACITY;
+
+    while(cap * 7 / 8 < n) cap *= 2;
+    return (uint32)cap;
+}
+
+
+// return size of table of cap slots
+uint64 hmap_table_sz(uint32 cap)
+{
+    return (uint64)cap * sizeof(hmap_slot) + cap + HMAP_GROUP_SZ;
+}
+
+
+// set up table of cap slots in memory mem, all slots are empty
+void hmap_table_init(hmap_table *t, uint32 cap, void *mem)
+{
+    t->cap = cap;
+    t->used = 0;
+    t->deleted = 0;
+    t->slots = (hmap_slot *)mem;
+    t->ctrl = (uint8 *)(t->slots + cap);
+    memset(t->ctrl, HMAP_CTRL_EMPTY, cap + HMAP_GROUP_SZ);
+}
+
+
+// return bit mask of bytes of group at ctrl equal to c
+uint32 hmap_group_match(const uint8 *ctrl, uint8 c)
+{
+#ifdef HMAP_SSE2
+    __m128i g = _mm_loadu_si128((const __m128i *)ctrl);
+    return (uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8((char)c)));
+#else
+    uint32 m = 0;
+
+    for(uint32 i = 0; i < HMAP_GROUP_SZ; i++) m |= (uint32)(ctrl[i] == c) << i;
+    return m;
+#endif
+}
+
+
+// return bit mask of empty or deleted bytes of group at ctrl
+uint32 hmap_group_free(const uint8 *ctrl)
+{
+#ifdef HMAP_SSE2
+    return (uint32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+#else
+    uint32 m = 0;
+
+    for(uint32 i = 0; i < HMAP_GROUP_SZ; i++) m |= (uint32)(ctrl[i] >> 7) << i;
+    return m;
+#endif
+}
+
+
+// set control byte of slot i, bytes of the first group are mirrored after the last slot
+void hmap_set_ctrl(hmap_table *t, uint32 i, uint8 c)
+{
+    t->ctrl[i] = c;
+    if(i < HMAP_GROUP_SZ) t->ctrl[t->cap + i] = c;
+}
+
+
+// find slot of key with hash in table t
+// return slot index or t->cap if there is no such key
+uint32 hmap_find(const hmap_table *t, const void *key, uint32 keylen, uint32 hash)
+{
+    uint64 mix = HMAP_MIX(hash);
+    uint32 mask = t->cap - 1, pos = HMAP_H1(mix) & mask, stride = 0, m, i;
+    const hmap_slot *s;
+
+    for(;;)
+    {
+        for(m = hmap_group_match(t->ctrl + pos, HMAP_H2(mix)); m != 0; m &= m - 1)
+        {
+            i = (pos + __builtin_ctz(m)) & mask;
+            s = t->slots + i;
+            if(s->hash == hash && s->entry.keylen == keylen && 0 == memcmp(s->entry.key, key, keylen)) return i;
+        }
+
+        if(hmap_group_match(t->ctrl + pos, HMAP_CTRL_EMPTY) != 0) return t->cap;
+
+        stride += HMAP_GROUP_SZ;
+        pos = (pos + stride) & mask;
+    }
+}
+
+
+// put entry with hash into the first free slot of its probe sequence, key must not be in table t
+void hmap_put(hmap_table *t, const hmap_entry *entry, uint32 hash)
+{
+    uint64 mix = HMAP_MIX(hash);
+    uint32 mask = t->cap - 1, pos = HMAP_H1(mix) & mask, stride = 0, m, i;
+
+    while((m = hmap_group_free(t->ctrl + pos)) == 0)
+    {
+        stride += HMAP_GROUP_SZ;
+        pos = (pos + stride) & mask;
+    }
+
+    i = (pos + __builtin_ctz(m)) & mask;
+    if(t->ctrl[i] == HMAP_CTRL_DELETED) t->deleted--;
+    hmap_set_ctrl(t, i, HMAP_H2(mix));
+    t->slots[i].entry = *entry;
+    t->slots[i].hash = hash;
+    t->used++;
+}
+
+
+// free slot i of table t, it becomes empty if no group of 16 slots around it is full,
+// otherwise some probe could have passed it and it becomes a tombstone
+void hmap_remove(hmap_table *t, uint32 i)
+{
+    uint32 mask = t->cap - 1;
+    uint32 after = hmap_group_match(t->ctrl + i, HMAP_CTRL_EMPTY);
+    uint32 before = hmap_group_match(t->ctrl + ((i - HMAP_GROUP_SZ) & mask), HMAP_CTRL_EMPTY);
+    uint32 gap = (after ? __builtin_ctz(after) : HMAP_GROUP_SZ) + (before ? __builtin_clz(before) - (32 - HMAP_GROUP_SZ) : HMAP_GROUP_SZ);
+
+    t->used--;
+    if(gap < HMAP_GROUP_SZ)
+    {
+        hmap_set_ctrl(t, i, HMAP_CTRL_EMPTY);
+    }
+    else
+    {
+        hmap_set_ctrl(t, i, HMAP_CTRL_DELETED);
+        t->deleted++;
+    }
+}
+
+
+// move up to slots of old table to the current one, old table is released when it is empty
+void hmap_migrate(hmap_state *ms, uint32 slots)
+{
+    hmap_table *old = &ms->old;
+    uint32 end = (old->cap - ms->migrated < slots) ? old->cap : ms->migrated + slots, i;
+
+    for(i = ms->migrated; i < end && old->used > 0; i++)
+    {
+        if(old->ctrl[i] & HMAP_CTRL_EMPTY) continue;
+
+        hmap_put(&ms->cur, &old->slots[i].entry, old->slots[i].hash);
+        hmap_set_ctrl(old, i, HMAP_CTRL_DELETED);
+        old->used--;
+    }
+    ms->migrated = i;
+
+    if(ms->migrated == old->cap || 0 == old->used)
+    {
+        free(old->mem);
+        old->slots = NULL;
+    }
+}
+
+
+// start moving entries to a new table: twice as large if table is more than 7/16 full,
+// of the same size if it is mostly tombstones
+// return 0 on success, non-0 on error (error code is set)
+sint8 hmap_grow(hmap_state *ms)
+{
+    uint32 cap = ms->cur.cap;
+    void *mem;
+
+    if(NULL != ms->old.slots) hmap_migrate(ms, ms->old.cap);
+
+    if((uint64)ms->cur.used + 1 > (uint64)cap * 7 / 16) cap *= 2;
+    if(0 == cap || (mem = malloc(hmap_table_sz(cap))) == NULL)
+    {
+        error_set(ERROR_OUT_OF_MEMORY);
+        return 1;
+    }
+
+    ms->old = ms->cur;
+    ms->migrated = 0;
+    hmap_table_init(&ms->cur, cap, mem);
+    ms->cur.mem = mem;
+
+    if(0 == ms->old.used)
+    {
+        free(ms->old.mem);
+        ms->old.slots = NULL;
+    }
+
+    return 0;
+}
+
+
+size_t hmap_get_alloc_sz(uint32 n)
+{
+    return sizeof(hmap_state) + ((hmap_table_sz(hmap_capacity(n)) + 7) & ~7UL);
+}
+
+
+handle hmap_create(void *buf, uint32 n, hmap_hfun f)
+{
+    hmap_state *ms = (hmap_state *)buf;
+
+    assert(NULL != f);
+
+    if(NULL == ms) return NULL;
+
+    ms->hfun = f;
+    ms->old.slots = NULL;
+    ms->migrated = 0;
+    hmap_table_init(&ms->cur, hmap_capacity(n), ms->data);
+    ms->cur.mem = NULL;
+
+    return (handle)ms;
+}
+
+
+sint8 hmap_insert(handle mh, const hmap_entry *entry)
+{
+    hmap_state *ms = (hmap_state *)mh;
+    hmap_table *cur = &ms->cur;
+    uint32 hash, i;
+
+    assert(NULL != entry);
+    assert(NULL != entry->key);
+
+    hash = ms->hfun(entry->key, entry->keylen);
+
+    if((i = hmap_find(cur, entry->key, entry->keylen, hash)) < cur->cap)
+    {
+        cur->slots[i].entry = *entry;
+        return 0;
+    }
+
+    if(NULL != ms->old.slots)
+    {
+        if((i = hmap_find(&ms->old, entry->key, entry->keylen, hash)) < ms->old.cap)
+        {
+            hmap_set_ctrl(&ms->old, i, HMAP_CTRL_DELETED);
+            ms->old.used--;
+        }
+        hmap_migrate(ms, HMAP_MIGRATE_SLOTS);
+    }
+
+    // entries still in old table are counted, so moving them never overfills the current one
+    if((uint64)cur->used + cur->deleted + (NULL != ms->old.slots ? ms->old.used : 0) + 1 > (uint64)cur->cap * 7 / 8)
+    {
+        if(hmap_grow(ms) != 0) return 1;
+    }
+
+    hmap_put(cur, entry, hash);
+    return 0;
+}
+
+
+const hmap_entry *hmap_search(handle mh, const void *key, uint32 keylen)
+{
+    const hmap_state *ms = (const hmap_state *)mh;
+    uint32 hash, i;
+
+    assert(NULL != key);
+
+    hash = ms->hfun(key, keylen);
+
+    if((i = hmap_find(&ms->cur, key, keylen, hash)) < ms->cur.cap) return &ms->cur.slots[i].entry;
+
+    if(NULL != ms->old.slots && (i = hmap_find(&ms->old, key, keylen, hash)) < ms->old.cap) return &ms->old.slots[i].entry;
+
+    return NULL;
+}
+
+
+sint8 hmap_delete(handle mh, const void *key, uint32 keylen)
+{
+    hmap_state *ms = (hmap_state *)mh;
+    uint32 hash, i;
+    sint8 res = 1;
+
+    assert(NULL != key);
+
+    hash = ms->hfun(key, keylen);
+
+    if((i = hmap_find(&ms->cur, key, keylen, hash)) < ms->cur.cap)
+    {
+        hmap_remove(&ms->cur, i);
+        res = 0;
+    }
+    else if(NULL != ms->old.slots && (i = hmap_find(&ms->old, key, keylen, hash)) < ms->old.cap)
+    {
+        hmap_set_ctrl(&ms->old, i, HMAP_CTRL_DELETED);
+        ms->old.used--;
+        res = 0;
+    }
+
+    if(NULL != ms->old.slots) hmap_migrate(ms, HMAP_MIGRATE_SLOTS);
+
+    return res;
+}
+
+
+uint32 hmap_size(handle mh)
+{
+    const hmap_state *ms = (const hmap_state *)mh;
+
+    return ms->cur.used + (NULL != ms->old.slots ? ms->old.used : 0);
+}
+
+
+void hmap_destroy(handle mh)
+{
+    hmap_state *ms = (hmap_state *)mh;
+
+    if(NULL != ms->old.slots) free(ms->old.mem);
+    free(ms->cur.mem);
+    ms->old.slots = NULL;
+    ms->cur.mem = NULL;
+}
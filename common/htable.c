@@ -1,22 +1,19 @@
 #include "common/htable.h"
 #include <stdlib.h>
-#include <string.h>
 #include <assert.h>
 
 
 typedef struct _htable_table_desc
 {
     uint32          n;
-    uint32          used;
-    htable_hfun     hfun;
-    htable_entry    tbl[];
+    uint64          map[];
 } htable_table_desc;
 
 
 // return allocation size for table of n elements
 size_t htable_get_alloc_sz(uint32 n)
 {
-    return sizeof(htable_table_desc) + n*sizeof(htable_entry);
+    return sizeof(htable_table_desc) + hmap_get_alloc_sz(n);
 }
 
 
@@ -32,9 +29,7 @@ handle htable_create(uint32 n, void *buf, htable_hfun f)
     if(NULL != buf)
     {
         ht->n = n;
-        ht->hfun = f;
-        ht->used = 0;
-        memset(ht->tbl, 0, sizeof(htable_entry)*n);
+        hmap_create(ht->map, n, f);
     }
 
     return (handle)buf;
@@ -47,30 +42,10 @@ sint8 htable_add(handle hh, const htable_entry *entry)
 {
     htable_table_desc *ht = (htable_table_desc *)hh;
 
-    if(ht->used == ht->n) return -1;
+    // map holds n entries without growing
+    if(hmap_size((handle)ht->map) == ht->n) return -1;
 
-    assert(NULL != entry);
-    assert(NULL != entry->key);
-
-    uint32 hash = ht->hfun(entry->key, entry->keylen) % ht->n;
-
-    htable_entry *e = ht->tbl + hash;
-    while(NULL != e->key)
-    {
-        if(e->keylen == entry->keylen && 0 == memcmp(e->key, entry->key, e->keylen))
-        {
-            break;
-        }
-
-        hash++;
-        if(hash == ht->n) hash = 0;
-        e = ht->tbl + hash;
-    }
-
-    ht->tbl[hash] = *entry;
-    ht->used++;
-
-    return 0;
+    return hmap_insert((handle)ht->map, entry);
 }
 
 
@@ -78,39 +53,9 @@ sint8 htable_add(handle hh, const htable_entry *entry)
 // return NULL if not found
 const htable_entry *htable_search(handle hh, const void *key, uint32 keylen)
 {
-    htable_table_desc   *ht = (htable_table_desc *)hh;
-    const htable_entry  *e;
-    uint32              checked = 0;
-    uint32              hash;
-
-    assert(NULL != key);
-
-    hash = ht->hfun(key, keylen) % ht->n;
-
-    do
-    {
-        e = ht->tbl + hash;
-        if(NULL == e->key)
-        {
-            return NULL;
-        }
-        else
-        {
-            if(e->keylen != keylen || 0 != memcmp(e->key, key, keylen))
-            {
-                hash++;
-                if(hash == ht->n) hash = 0;
-            }
-            else
-            {
-                return e;
-            }
-            checked++;
-        }
-    }
-    while(checked < ht->used);
+    htable_table_desc *ht = (htable_table_desc *)hh;
 
-    return NULL;
+    return hmap_search((handle)ht->map, key, keylen);
 }
 
 
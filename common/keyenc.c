@@ -0,0 +1,260 @@
+#include "common/keyenc.h"
+#include "common/error.h"
+#include <string.h>
+
+
+#define KEYENC_SIGN_BIT64           (0x8000000000000000UL)
+#define KEYENC_SIGN_BIT32           (0x80000000U)
+#define KEYENC_NAN64                (0x7FF8000000000000UL)
+#define KEYENC_NAN32                (0x7FC00000U)
+#define KEYENC_USEC_IN_MIN          (60L * 1000000L)
+
+// class byte of decimal, negative decimal goes first
+#define KEYENC_DECIMAL_NEG          (0x01)
+#define KEYENC_DECIMAL_ZERO         (0x02)
+#define KEYENC_DECIMAL_POS          (0x03)
+#define KEYENC_DECIMAL_END          (0x00)      // terminator, pair of digits xy is encoded as xy + 1
+#define KEYENC_DECIMAL_EXP_BIAS     (0x8000)
+
+
+// put sz lower bytes of v to buf in big-endian order
+inline void keyenc_put(uint64 v, uint8 *buf, uint32 sz)
+{
+    while(sz > 0)
+    {
+        buf[--sz] = (uint8)v;
+        v >>= 8;
+    }
+}
+
+// return sz bytes of buf in big-endian order
+inline uint64 keyenc_get(const uint8 *buf, uint32 sz)
+{
+    uint64 v = 0;
+
+    for(uint32 i = 0; i < sz; i++)
+    {
+        v = (v << 8) | buf[i];
+    }
+
+    return v;
+}
+
+
+uint32 keyenc_encode_smallint(sint16 v, uint8 *buf)
+{
+    keyenc_put((uint16)v ^ 0x8000U, buf, KEYENC_SMALLINT_SZ);
+    return KEYENC_SMALLINT_SZ;
+}
+
+uint32 keyenc_encode_integer(sint32 v, uint8 *buf)
+{
+    keyenc_put((uint32)v ^ KEYENC_SIGN_BIT32, buf, KEYENC_INTEGER_SZ);
+    return KEYENC_INTEGER_SZ;
+}
+
+uint32 keyenc_encode_float(float32 v, uint8 *buf)
+{
+    uint32 u;
+
+    if(v == 0.0f) v = 0.0f;     // -0
+    memcpy(&u, &v, sizeof(u));
+    if(v != v) u = KEYENC_NAN32;
+
+    keyenc_put((u & KEYENC_SIGN_BIT32) ? ~u : u | KEYENC_SIGN_BIT32, buf, KEYENC_FLOAT_SZ);
+    return KEYENC_FLOAT_SZ;
+}
+
+uint32 keyenc_encode_double(float64 v, uint8 *buf)
+{
+    uint64 u;
+
+    if(v == 0.0) v = 0.0;       // -0
+    memcpy(&u, &v, sizeof(u));
+    if(v != v) u = KEYENC_NAN64;
+
+    keyenc_put((u & KEYENC_SIGN_BIT64) ? ~u : u | KEYENC_SIGN_BIT64, buf, KEYENC_DOUBLE_SZ);
+    return KEYENC_DOUBLE_SZ;
+}
+
+uint32 keyenc_encode_date(uint64 v, uint8 *buf)
+{
+    keyenc_put(v, buf, KEYENC_DATE_SZ);
+    return KEYENC_DATE_SZ;
+}
+
+uint32 keyenc_encode_timestamp(uint64 v, uint8 *buf)
+{
+    keyenc_put(v, buf, KEYENC_TIMESTAMP_SZ);
+    return KEYENC_TIMESTAMP_SZ;
+}
+
+// encode timestamp ts of local time with offset tz in minutes from UTC to buf
+// return number of bytes written
+uint32 keyenc_encode_timestamp_with_tz(uint64 ts, sint16 tz, uint8 *buf)
+{
+    sint64 instant = (sint64)ts - (sint64)tz * KEYENC_USEC_IN_MIN;
+
+    keyenc_put((uint64)instant ^ KEYENC_SIGN_BIT64, buf, KEYENC_TIMESTAMP_TZ_SZ);
+    return KEYENC_TIMESTAMP_TZ_SZ;
+}
+
+// encode decimal d to buf of at least KEYENC_DECIMAL_MAX_SZ bytes
+// return number of bytes written
+uint32 keyenc_encode_decimal(const decimal *d, uint8 *buf)
+{
+    uint8 digits[DECIMAL_POSITIONS + 1];
+    sint32 i, n, len, e, t;
+    uint8 inv, *p = buf;
+
+    // number of digits is taken from the most significant non-zero limb, as d->n of arithmetic result
+    // can count leading zeroes
+    for(i = (d->n - 1) / DECIMAL_BASE_LOG10; i >= 0 && 0 == d->m[i]; i--);
+    if(d->n <= 0 || i < 0)
+    {
+        *buf = KEYENC_DECIMAL_ZERO;
+        return 1;
+    }
+    for(len = i * DECIMAL_BASE_LOG10 + 1, t = 10; t <= d->m[i]; t *= 10) len++;
+
+    // digits from the most significant one, trailing zeroes are dropped, so equal decimals have equal encoding
+    for(i = len - 1, t = 1; i >= 0; i--)
+    {
+        digits[i] = (uint8)((d->m[(len - 1 - i) / DECIMAL_BASE_LOG10] / t) % 10);
+        t = (t == DECIMAL_BASE / 10) ? 1 : t * 10;
+    }
+    for(n = len; n > 1 && 0 == digits[n - 1]; n--);
+    digits[n] = 0;
+
+    // d = 0.digits * 10^(e + len)
+    e = (sint32)d->e + len + KEYENC_DECIMAL_EXP_BIAS;
+    inv = d->sign == DECIMAL_SIGN_NEG ? 0xFF : 0;
+
+    *p++ = d->sign == DECIMAL_SIGN_NEG ? KEYENC_DECIMAL_NEG : KEYENC_DECIMAL_POS;
+    *p++ = (uint8)(e >> 8) ^ inv;
+    *p++ = (uint8)e ^ inv;
+    for(i = 0; i < n; i += 2)
+    {
+        *p++ = (uint8)(digits[i] * 10 + digits[i + 1] + 1) ^ inv;
+    }
+    *p++ = KEYENC_DECIMAL_END ^ inv;
+
+    return (uint32)(p - buf);
+}
+
+
+uint32 keyenc_decode_smallint(const uint8 *buf, sint16 *v)
+{
+    *v = (sint16)(keyenc_get(buf, KEYENC_SMALLINT_SZ) ^ 0x8000U);
+    return KEYENC_SMALLINT_SZ;
+}
+
+uint32 keyenc_decode_integer(const uint8 *buf, sint32 *v)
+{
+    *v = (sint32)(keyenc_get(buf, KEYENC_INTEGER_SZ) ^ KEYENC_SIGN_BIT32);
+    return KEYENC_INTEGER_SZ;
+}
+
+uint32 keyenc_decode_float(const uint8 *buf, float32 *v)
+{
+    uint32 u = (uint32)keyenc_get(buf, KEYENC_FLOAT_SZ);
+
+    u = (u & KEYENC_SIGN_BIT32) ? u ^ KEYENC_SIGN_BIT32 : ~u;
+    memcpy(v, &u, sizeof(u));
+    return KEYENC_FLOAT_SZ;
+}
+
+uint32 keyenc_decode_double(const uint8 *buf, float64 *v)
+{
+    uint64 u = keyenc_get(buf, KEYENC_DOUBLE_SZ);
+
+    u = (u & KEYENC_SIGN_BIT64) ? u ^ KEYENC_SIGN_BIT64 : ~u;
+    memcpy(v, &u, sizeof(u));
+    return KEYENC_DOUBLE_SZ;
+}
+
+uint32 keyenc_decode_date(const uint8 *buf, uint64 *v)
+{
+    *v = keyenc_get(buf, KEYENC_DATE_SZ);
+    return KEYENC_DATE_SZ;
+}
+
+uint32 keyenc_decode_timestamp(const uint8 *buf, uint64 *v)
+{
+    *v = keyenc_get(buf, KEYENC_TIMESTAMP_SZ);
+    return KEYENC_TIMESTAMP_SZ;
+}
+
+// decode timestamp with time zone from buf, ts is set to UTC time and tz to 0
+// return number of bytes read
+uint32 keyenc_decode_timestamp_with_tz(const uint8 *buf, uint64 *ts, sint16 *tz)
+{
+    *ts = keyenc_get(buf, KEYENC_TIMESTAMP_TZ_SZ) ^ KEYENC_SIGN_BIT64;
+    *tz = 0;
+    return KEYENC_TIMESTAMP_TZ_SZ;
+}
+
+// decode decimal from buf of sz bytes to d, mantissa of d is normalized: it has no trailing zeroes,
+// unless they are needed to keep exponent in range
+// return number of bytes read, 0 if buf does not start with encoded decimal (error code is set)
+uint32 keyenc_decode_decimal(const uint8 *buf, uint32 sz, decimal *d)
+{
+    uint8 digits[DECIMAL_POSITIONS];
+    uint32 i;
+    sint32 j, n = 0, e, t;
+    uint8 inv, b;
+
+    memset(d, 0, sizeof(*d));
+    d->sign = DECIMAL_SIGN_POS;
+
+    if(sz > 0 && *buf == KEYENC_DECIMAL_ZERO) return 1;
+
+    if(sz < 4 || (*buf != KEYENC_DECIMAL_NEG && *buf != KEYENC_DECIMAL_POS))
+    {
+        error_set(ERROR_INVALID_DECIMAL_FORMAT);
+        return 0;
+    }
+
+    inv = *buf == KEYENC_DECIMAL_NEG ? 0xFF : 0;
+    e = (sint32)(((buf[1] ^ inv) << 8) | (buf[2] ^ inv)) - KEYENC_DECIMAL_EXP_BIAS;
+
+    for(i = 3; i < sz && (b = buf[i] ^ inv) != KEYENC_DECIMAL_END; i++)
+    {
+        if(b > 100 || n == DECIMAL_POSITIONS)
+        {
+            error_set(ERROR_INVALID_DECIMAL_FORMAT);
+            return 0;
+        }
+        digits[n++] = (uint8)((b - 1) / 10);
+        digits[n++] = (uint8)((b - 1) % 10);
+    }
+
+    if(i == sz || n == 0 || 0 == digits[0])
+    {
+        error_set(ERROR_INVALID_DECIMAL_FORMAT);
+        return 0;
+    }
+
+    // the second digit of the last pair is padding
+    if(0 == digits[n - 1]) n--;
+
+    // trailing zeroes dropped by encoding are kept in mantissa if exponent doesn't fit without them
+    e -= n;
+    for(; e > DECIMAL_MAX_EXPONENT && n < DECIMAL_POSITIONS; e--) digits[n++] = 0;
+    if(e > DECIMAL_MAX_EXPONENT || e < DECIMAL_MIN_EXPONENT)
+    {
+        error_set(ERROR_INVALID_DECIMAL_FORMAT);
+        return 0;
+    }
+
+    for(j = n - 1, t = 1; j >= 0; j--)
+    {
+        d->m[(n - 1 - j) / DECIMAL_BASE_LOG10] += (sint16)(digits[j] * t);
+        t = (t == DECIMAL_BASE / 10) ? 1 : t * 10;
+    }
+    d->n = (sint16)n;
+    d->e = (sint8)e;
+    d->sign = inv ? DECIMAL_SIGN_NEG : DECIMAL_SIGN_POS;
+
+    return i + 1;
+}
@@ -1,26 +1,86 @@
 #include "common/string_literal.h"
+#include "common/error.h"
+#include "logging/logger.h"
+#include "table/table.h"
+#include <stdlib.h>
+#include <stdio.h>
 #include <string.h>
+#include <stddef.h>
+#include <errno.h>
+#include <unistd.h>
 
 
-// TODO: get rid of the size limit, e.g. write data to tipi
+#define STRING_LITERAL_INLINE_SZ        (64)
+#define STRING_LITERAL_CHUNK_SZ         (4096)
+#define STRING_LITERAL_CHUNK_DATA_SZ    (STRING_LITERAL_CHUNK_SZ - sizeof(void *))
+#define STRING_LITERAL_MAX_SZ           (MAX_VARCHAR_LENGTH * ENCODING_MAXCHAR_LEN)
+#define STRING_LITERAL_SPILL_FILE_NAME  ("/persistence_literal_XXXXXX")
+#define STRING_LITERAL_PATH_BUF_SZ      (4096)
 
 
-#define STRING_LITERAL_MAX_BUF_SZ   (1024)
+// chunk of the rope, all chunks but the last one are full
+typedef struct _string_literal_chunk string_literal_chunk;
+typedef struct _string_literal_chunk
+{
+    string_literal_chunk *next;
+    uint8 buf[STRING_LITERAL_CHUNK_DATA_SZ];
+} string_literal_chunk;
 
 
+// bytes of string literal follow each other in:
+// inline buffer, chunks (mem_sz bytes together), spill file (file_sz bytes), spill buffer (the rest)
 typedef struct _string_literal
 {
-    uint64  sz;
-    uint8   buf[STRING_LITERAL_MAX_BUF_SZ];
+    uint64  sz;                         // total size in bytes
+    uint64  mem_sz;                     // bytes in inline buffer and chunks
+    uint64  file_sz;                    // bytes written to spill file
+    string_literal_chunk *head;
+    string_literal_chunk *tail;
+    string_literal_chunk *spill_buf;    // bytes after spill file, NULL if nothing is spilled
+    string_literal_chunk *read_chunk;   // chunk of the last read, read_idx is its number
+    uint64  read_idx;
+    int     fd;                         // spill file, -1 if not created
+    uint8   buf[STRING_LITERAL_INLINE_SZ];
 } string_literal;
 
 
+struct
+{
+    uint64 mem_sz;
+    const achar *spill_dir;
+} g_string_literal_state = {STRING_LITERAL_DEFAULT_MEM_SZ, STRING_LITERAL_DEFAULT_SPILL_DIR};
+
+
+// set number of bytes of each string literal kept in memory, the rest is spilled to a file in spill_dir
+void string_literal_set_spill(uint64 mem_sz, const achar *spill_dir)
+{
+    g_string_literal_state.mem_sz = mem_sz;
+    g_string_literal_state.spill_dir = (NULL == spill_dir) ? STRING_LITERAL_DEFAULT_SPILL_DIR : spill_dir;
+}
+
+
 // size for string_literal
 size_t string_literal_alloc_sz()
 {
     return sizeof(string_literal);
 }
 
+
+// reset string literal to empty one without releasing its resources
+void string_literal_init(string_literal *sl)
+{
+    sl->sz = 0;
+    sl->mem_sz = 0;
+    sl->file_sz = 0;
+    sl->head = NULL;
+    sl->tail = NULL;
+    sl->spill_buf = NULL;
+    sl->read_chunk = NULL;
+    sl->read_idx = 0;
+    sl->fd = -1;
+}
+
+
 // create string literal instance
 // return NULL on error
 handle string_literal_create(void *buf)
@@ -29,20 +89,116 @@ handle string_literal_create(void *buf)
 
     if(NULL == sl) return NULL;
 
-    sl->sz = 0L;
+    string_literal_init(sl);
 
     return (handle)sl;
 }
 
+
+// create and immediately unlink spill file, so it disappears with the process
+// return 0 on success, non-0 on error
+sint8 string_literal_open_spill_file(string_literal *sl)
+{
+    achar path[STRING_LITERAL_PATH_BUF_SZ];
+
+    if(snprintf(path, STRING_LITERAL_PATH_BUF_SZ, _ach("%s%s"), g_string_literal_state.spill_dir, STRING_LITERAL_SPILL_FILE_NAME) >= STRING_LITERAL_PATH_BUF_SZ)
+    {
+        logger_error(_ach("string_literal, spill directory name is too long: %s"), g_string_literal_state.spill_dir);
+        return 1;
+    }
+
+    if((sl->fd = mkstemp(path)) == -1)
+    {
+        logger_error(_ach("string_literal, failed to create spill file in %s: %s"), g_string_literal_state.spill_dir, strerror(errno));
+        return 1;
+    }
+
+    if(unlink(path) != 0)
+    {
+        logger_warn(_ach("string_literal, failed to unlink spill file %s: %s"), path, strerror(errno));
+    }
+
+    return 0;
+}
+
+
 // append buffer to string literal
 // return 0 on success, 1 on error
 sint8 string_literal_append_char(handle sh, const uint8 *buf, uint32 sz)
 {
     string_literal *sl = (string_literal *)sh;
-    if(sz + sl->sz > STRING_LITERAL_MAX_BUF_SZ) return -1;
+    string_literal_chunk *chunk;
+    uint64 n, off;
+
+    if(sl->sz + sz > STRING_LITERAL_MAX_SZ) return 1;
+
+    while(sz > 0)
+    {
+        if(NULL == sl->spill_buf && sl->mem_sz < g_string_literal_state.mem_sz)
+        {
+            if(sl->mem_sz < STRING_LITERAL_INLINE_SZ)
+            {
+                n = STRING_LITERAL_INLINE_SZ - sl->mem_sz;
+                if(n > sz) n = sz;
+                memcpy(sl->buf + sl->mem_sz, buf, n);
+            }
+            else
+            {
+                off = (sl->mem_sz - STRING_LITERAL_INLINE_SZ) % STRING_LITERAL_CHUNK_DATA_SZ;
+                if(0 == off)
+                {
+                    if((chunk = (string_literal_chunk *)malloc(sizeof(string_literal_chunk))) == NULL)
+                    {
+                        error_set(ERROR_OUT_OF_MEMORY);
+                        return 1;
+                    }
+
+                    chunk->next = NULL;
+                    if(NULL == sl->tail) sl->head = chunk;
+                    else sl->tail->next = chunk;
+                    sl->tail = chunk;
+                }
+
+                n = STRING_LITERAL_CHUNK_DATA_SZ - off;
+                if(n > sz) n = sz;
+                memcpy(sl->tail->buf + off, buf, n);
+            }
+
+            sl->mem_sz += n;
+        }
+        else
+        {
+            if(NULL == sl->spill_buf)
+            {
+                if(string_literal_open_spill_file(sl) != 0) return 1;
+                if((sl->spill_buf = (string_literal_chunk *)malloc(sizeof(string_literal_chunk))) == NULL)
+                {
+                    error_set(ERROR_OUT_OF_MEMORY);
+                    return 1;
+                }
+            }
+
+            off = sl->sz - sl->mem_sz - sl->file_sz;
+            n = STRING_LITERAL_CHUNK_DATA_SZ - off;
+            if(n > sz) n = sz;
+            memcpy(sl->spill_buf->buf + off, buf, n);
+
+            if(off + n == STRING_LITERAL_CHUNK_DATA_SZ)
+            {
+                if(pwrite(sl->fd, sl->spill_buf->buf, STRING_LITERAL_CHUNK_DATA_SZ, (off_t)sl->file_sz) != (ssize_t)STRING_LITERAL_CHUNK_DATA_SZ)
+                {
+                    logger_error(_ach("string_literal, failed to write spill file: %s"), strerror(errno));
+                    return 1;
+                }
+                sl->file_sz += STRING_LITERAL_CHUNK_DATA_SZ;
+            }
+        }
+
+        sl->sz += n;
+        buf += n;
+        sz -= n;
+    }
 
-    memcpy(sl->buf + sl->sz, buf, sz);
-    sl->sz += sz;
     return 0;
 }
 
@@ -51,62 +207,155 @@ sint8 string_literal_append_char(handle sh, const uint8 *buf, uint32 sz)
 sint8 string_literal_truncate(handle sh)
 {
     string_literal *sl = (string_literal *)sh;
-    sl->sz = 0;
+    string_literal_chunk *chunk;
+
+    while(NULL != (chunk = sl->head))
+    {
+        sl->head = chunk->next;
+        free(chunk);
+    }
+
+    free(sl->spill_buf);
+    if(-1 != sl->fd) close(sl->fd);
+
+    string_literal_init(sl);
     return 0;
 }
 
 
+// release all resources, buffer of the string literal is not freed
+void string_literal_destroy(handle sh)
+{
+    string_literal_truncate(sh);
+}
+
+
 // move ownership from one string literal to another
 // from is trucated
 // return 0 on success, non-0 on error
 sint8 string_literal_move(handle from, handle to)
 {
-    // for now it is simple copy
-    string_literal *sl_from= (string_literal *)from;
+    string_literal *sl_from = (string_literal *)from;
     string_literal *sl_to = (string_literal *)to;
+    uint64 inl = (sl_from->mem_sz < STRING_LITERAL_INLINE_SZ) ? sl_from->mem_sz : STRING_LITERAL_INLINE_SZ;
 
-    memcpy(sl_to->buf, sl_from->buf, sl_from->sz);
-    sl_to->sz = sl_from->sz;
+    if(string_literal_truncate(to) != 0) return 1;
 
-    return string_literal_truncate(from);
+    memcpy(sl_to, sl_from, offsetof(string_literal, buf) + inl);
+    string_literal_init(sl_from);
+
+    return 0;
 }
 
 
-sint8 string_literal_read(handle sh, uint8 *buf, uint64 *sz)
+// return pointer to contiguous bytes of string literal starting at pos < sz, len is set to their number;
+// spilled bytes are read to file_buf, but not more than max
+// return NULL on error
+const uint8 *string_literal_piece(string_literal *sl, uint64 pos, uint8 *file_buf, uint64 max, uint64 *len)
+{
+    uint64 idx, off;
+
+    if(pos < sl->mem_sz)
+    {
+        if(pos < STRING_LITERAL_INLINE_SZ)
+        {
+            *len = ((sl->mem_sz < STRING_LITERAL_INLINE_SZ) ? sl->mem_sz : STRING_LITERAL_INLINE_SZ) - pos;
+            return sl->buf + pos;
+        }
+
+        // chunks are found from the chunk of the previous read, so reading in order takes linear time
+        idx = (pos - STRING_LITERAL_INLINE_SZ) / STRING_LITERAL_CHUNK_DATA_SZ;
+        off = (pos - STRING_LITERAL_INLINE_SZ) % STRING_LITERAL_CHUNK_DATA_SZ;
+        if(NULL == sl->read_chunk || sl->read_idx > idx)
+        {
+            sl->read_chunk = sl->head;
+            sl->read_idx = 0;
+        }
+        for(; sl->read_idx < idx; sl->read_idx++) sl->read_chunk = sl->read_chunk->next;
+
+        *len = STRING_LITERAL_CHUNK_DATA_SZ - off;
+        if(*len > sl->mem_sz - pos) *len = sl->mem_sz - pos;
+        return sl->read_chunk->buf + off;
+    }
+
+    pos -= sl->mem_sz;
+    if(pos < sl->file_sz)
+    {
+        *len = (sl->file_sz - pos < max) ? sl->file_sz - pos : max;
+        if(pread(sl->fd, file_buf, *len, (off_t)pos) != (ssize_t)*len)
+        {
+            logger_error(_ach("string_literal, failed to read spill file: %s"), strerror(errno));
+            return NULL;
+        }
+        return file_buf;
+    }
+
+    pos -= sl->file_sz;
+    *len = sl->sz - sl->mem_sz - sl->file_sz - pos;
+    return sl->spill_buf->buf + pos;
+}
+
+
+// read data of size sz starting from byte offset of string literal to buf
+// upon completion sz is set to the number of bytes read
+// return 0 on success, non-0 on error
+sint8 string_literal_read_at(handle sh, uint64 offset, uint8 *buf, uint64 *sz)
 {
     string_literal *sl = (string_literal *)sh;
+    const uint8 *piece;
+    uint64 rd = 0, len;
 
-    if(sl->sz < *sz) *sz = sl->sz;
-    memcpy(buf, sl->buf, *sz);
+    if(offset >= sl->sz) *sz = 0;
+    else if(sl->sz - offset < *sz) *sz = sl->sz - offset;
+
+    while(rd < *sz)
+    {
+        if((piece = string_literal_piece(sl, offset + rd, buf + rd, *sz - rd, &len)) == NULL) return 1;
+        if(len > *sz - rd) len = *sz - rd;
+        if(piece != buf + rd) memcpy(buf + rd, piece, len);
+        rd += len;
+    }
 
     return 0;
 }
 
+
+sint8 string_literal_read(handle sh, uint8 *buf, uint64 *sz)
+{
+    return string_literal_read_at(sh, 0, buf, sz);
+}
+
+
 sint8 string_literal_byte_compare(handle sh1, handle sh2, sint8 *ret)
 {
     string_literal *sl1 = (string_literal *)sh1;
     string_literal *sl2 = (string_literal *)sh2;
-    int res;
+    uint8 file_buf1[STRING_LITERAL_CHUNK_DATA_SZ], file_buf2[STRING_LITERAL_CHUNK_DATA_SZ];
+    const uint8 *p1, *p2;
+    uint64 sz = (sl1->sz < sl2->sz) ? sl1->sz : sl2->sz, pos = 0, len1, len2;
+    int res = 0;
 
-    if(sl1->sz == sl2->sz)
+    if(sl1->sz <= STRING_LITERAL_INLINE_SZ && sl1->mem_sz == sl1->sz && sl2->sz <= STRING_LITERAL_INLINE_SZ && sl2->mem_sz == sl2->sz)
     {
-        res = memcmp(sl1->buf, sl2->buf, sl1->sz);
-        *ret = (res > 0) ? 1 : ((res < 0) ? -1 : 0);
+        res = memcmp(sl1->buf, sl2->buf, sz);
     }
     else
     {
-        if(sl1->sz > sl2->sz)
+        while(0 == res && pos < sz)
         {
-            res = memcmp(sl1->buf, sl2->buf, sl2->sz);
-            *ret = (res >= 0) ? 1 : -1;
-        }
-        else
-        {
-            res = memcmp(sl1->buf, sl2->buf, sl1->sz);
-            *ret = (res > 0) ? 1 : -1;
+            if((p1 = string_literal_piece(sl1, pos, file_buf1, STRING_LITERAL_CHUNK_DATA_SZ, &len1)) == NULL) return 1;
+            if((p2 = string_literal_piece(sl2, pos, file_buf2, STRING_LITERAL_CHUNK_DATA_SZ, &len2)) == NULL) return 1;
+            if(len1 > len2) len1 = len2;
+            if(len1 > sz - pos) len1 = sz - pos;
+
+            res = memcmp(p1, p2, len1);
+            pos += len1;
         }
     }
 
+    if(0 == res) *ret = (sl1->sz > sl2->sz) ? 1 : ((sl1->sz < sl2->sz) ? -1 : 0);
+    else *ret = (res > 0) ? 1 : -1;
+
     return 0;
 }
 
@@ -0,0 +1,625 @@
+#include "common/strmatch.h"
+#include "common/string_literal.h"
+#include "common/error.h"
+#include <string.h>
+#include <stdlib.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define STRMATCH_X86
+#include <immintrin.h>
+#endif
+
+
+#define STRMATCH_WINDOW_SZ      (4096)      // strings of literals up to this size are matched in one piece
+#define STRMATCH_MAX_ESCAPE_SZ  (4)         // longest escape character
+
+#define STRMATCH_TOKEN_END      (0)
+#define STRMATCH_TOKEN_BYTES    (1)         // literal bytes of one character
+#define STRMATCH_TOKEN_ANY      (2)         // _
+#define STRMATCH_TOKEN_STAR     (3)         // %
+#define STRMATCH_TOKEN_ERROR    (4)
+
+#define STRMATCH_NFA_CONTINUE   (0)
+#define STRMATCH_NFA_ACCEPT     (1)         // string matches whatever follows
+#define STRMATCH_NFA_REJECT     (2)         // string doesn't match whatever follows
+
+// 1 if c is continuation byte of UTF-8 character
+#define STRMATCH_IS_CONT(c)     (((c) & 0xC0) == 0x80)
+
+
+typedef uint8 (*strmatch_contains_fun)(const uint8 *str, uint64 sz, const uint8 *lit, uint64 lit_sz);
+
+struct
+{
+    // substring search kernel, chosen on the first compilation for the instruction set of the processor
+    strmatch_contains_fun contains;
+} g_strmatch_state = {NULL};
+
+
+typedef struct _strmatch_state
+{
+    strmatch_kind kind;
+    uint8   lead_star;      // general, segments: pattern starts with %
+    uint8   trail_star;     // segments: pattern ends with %
+    uint32  segs;           // segments: number of literal segments
+    uint32  *seg;           // segments: sizes of literal segments, their bytes follow each other in lit
+    uint32  words;          // general: 64-bit words of NFA state
+    uint64  final;          // general: bit of the last state in its word
+    uint64  lit_sz;         // literal of exact, prefix, suffix and contains kinds, all segments of segments kind
+    uint8   *lit;
+    uint64  *masks;         // general: states which accept byte, words per byte value
+    uint64  *loop;          // general: states followed by %
+    uint64  *any;           // general: states of _
+    uint64  *d;             // general: active states while matching
+} strmatch_state;
+
+
+// return number of 64-bit words of NFA state of pattern of pattern_sz bytes
+uint32 strmatch_words(uint64 pattern_sz)
+{
+    return (pattern_sz > 64) ? (uint32)((pattern_sz + 63) / 64) : 1;
+}
+
+
+uint64 strmatch_get_alloc_sz(uint64 pattern_sz)
+{
+    return sizeof(strmatch_state) + (uint64)strmatch_words(pattern_sz) * (256 + 3) * sizeof(uint64)
+           + pattern_sz * sizeof(uint32) + pattern_sz;
+}
+
+
+// return pointer to segment sizes area of buffer for compiled pattern of pattern_sz bytes
+uint32 *strmatch_seg_area(void *buf, uint64 pattern_sz)
+{
+    return (uint32 *)((uint8 *)buf + sizeof(strmatch_state) + (uint64)strmatch_words(pattern_sz) * (256 + 3) * sizeof(uint64));
+}
+
+
+// return pointer to literal area of buffer for compiled pattern of pattern_sz bytes
+uint8 *strmatch_lit_area(void *buf, uint64 pattern_sz)
+{
+    return (uint8 *)buf + strmatch_get_alloc_sz(pattern_sz) - pattern_sz;
+}
+
+
+// return length of UTF-8 character by its first byte, 0 if byte can't start a character
+uint8 strmatch_char_len(uint8 lead)
+{
+    if(lead < 0x80) return 1;
+    if((lead & 0xE0) == 0xC0) return 2;
+    if((lead & 0xF0) == 0xE0) return 3;
+    if((lead & 0xF8) == 0xF0) return 4;
+    return 0;
+}
+
+
+// read token of pattern of sz bytes at *pos, for literal token lit and lit_sz are set to its bytes
+// return STRMATCH_TOKEN_*
+uint8 strmatch_next_token(const uint8 *pattern, uint64 sz, uint64 *pos, const uint8 *escape, uint64 escape_sz,
+                          const uint8 **lit, uint64 *lit_sz)
+{
+    uint64 i = *pos;
+
+    if(i >= sz) return STRMATCH_TOKEN_END;
+
+    if(escape_sz > 0 && i + escape_sz <= sz && 0 == memcmp(pattern + i, escape, escape_sz))
+    {
+        i += escape_sz;
+        *lit = pattern + i;
+        if(i + escape_sz <= sz && 0 == memcmp(pattern + i, escape, escape_sz))
+        {
+            *lit_sz = escape_sz;
+        }
+        else if(i < sz && (pattern[i] == '%' || pattern[i] == '_'))
+        {
+            *lit_sz = 1;
+        }
+        else
+        {
+            return STRMATCH_TOKEN_ERROR;
+        }
+
+        *pos = i + *lit_sz;
+        return STRMATCH_TOKEN_BYTES;
+    }
+
+    *pos = i + 1;
+    if(pattern[i] == '%') return STRMATCH_TOKEN_STAR;
+    if(pattern[i] == '_') return STRMATCH_TOKEN_ANY;
+
+    *lit = pattern + i;
+    *lit_sz = 1;
+    return STRMATCH_TOKEN_BYTES;
+}
+
+
+// find the leftmost occurrence of lit of lit_sz bytes in str of sz bytes
+// return pointer to the occurrence, NULL if there is none
+const uint8 *strmatch_find(const uint8 *str, uint64 sz, const uint8 *lit, uint64 lit_sz)
+{
+    const uint8 *p = str, *end;
+
+    if(sz < lit_sz) return NULL;
+
+    // candidates start before end
+    end = str + sz - lit_sz + 1;
+    while(p < end)
+    {
+        p = (const uint8 *)memchr(p, lit[0], (size_t)(end - p));
+        if(NULL == p) return NULL;
+        if(p[lit_sz - 1] == lit[lit_sz - 1] && 0 == memcmp(p + 1, lit + 1, lit_sz - 1)) return p;
+        p++;
+    }
+
+    return NULL;
+}
+
+
+uint8 strmatch_contains_scalar(const uint8 *str, uint64 sz, const uint8 *lit, uint64 lit_sz)
+{
+    return NULL != strmatch_find(str, sz, lit, lit_sz);
+}
+
+
+#ifdef STRMATCH_X86
+
+uint8 strmatch_contains_sse2(const uint8 *str, uint64 sz, const uint8 *lit, uint64 lit_sz)
+{
+    uint64 i = 0;
+    uint32 mask;
+
+    if(lit_sz < 2) return strmatch_contains_scalar(str, sz, lit, lit_sz);
+
+    const __m128i first = _mm_set1_epi8((char)lit[0]);
+    const __m128i last = _mm_set1_epi8((char)lit[lit_sz - 1]);
+
+    // 16 candidates at a time, candidate k has the first byte at i + k and the last one at i + k + lit_sz - 1
+    for(; i + lit_sz + 15 <= sz; i += 16)
+    {
+        __m128i b = _mm_cmpeq_epi8(first, _mm_loadu_si128((const __m128i *)(str + i)));
+        __m128i e = _mm_cmpeq_epi8(last, _mm_loadu_si128((const __m128i *)(str + i + lit_sz - 1)));
+
+        for(mask = (uint32)_mm_movemask_epi8(_mm_and_si128(b, e)); mask; mask &= mask - 1)
+        {
+            if(0 == memcmp(str + i + __builtin_ctz(mask) + 1, lit + 1, lit_sz - 2)) return 1;
+        }
+    }
+
+    return strmatch_contains_scalar(str + i, sz - i, lit, lit_sz);
+}
+
+
+__attribute__((target("avx2")))
+uint8 strmatch_contains_avx2(const uint8 *str, uint64 sz, const uint8 *lit, uint64 lit_sz)
+{
+    uint64 i = 0;
+    uint32 mask;
+
+    if(lit_sz < 2) return strmatch_contains_scalar(str, sz, lit, lit_sz);
+
+    const __m256i first = _mm256_set1_epi8((char)lit[0]);
+    const __m256i last = _mm256_set1_epi8((char)lit[lit_sz - 1]);
+
+    for(; i + lit_sz + 31 <= sz; i += 32)
+    {
+        __m256i b = _mm256_cmpeq_epi8(first, _mm256_loadu_si256((const __m256i *)(str + i)));
+        __m256i e = _mm256_cmpeq_epi8(last, _mm256_loadu_si256((const __m256i *)(str + i + lit_sz - 1)));
+
+        for(mask = (uint32)_mm256_movemask_epi8(_mm256_and_si256(b, e)); mask; mask &= mask - 1)
+        {
+            if(0 == memcmp(str + i + __builtin_ctz(mask) + 1, lit + 1, lit_sz - 2)) return 1;
+        }
+    }
+
+    return strmatch_contains_sse2(str + i, sz - i, lit, lit_sz);
+}
+
+#endif
+
+
+void strmatch_init_kernels()
+{
+    g_strmatch_state.contains = strmatch_contains_scalar;
+
+#ifdef STRMATCH_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2"))
+    {
+        g_strmatch_state.contains = strmatch_contains_avx2;
+    }
+    else
+    {
+        g_strmatch_state.contains = strmatch_contains_sse2;
+    }
+#endif
+}
+
+
+// build NFA of general pattern of sz bytes in ms
+void strmatch_build_nfa(strmatch_state *ms, const uint8 *pattern, uint64 sz, const uint8 *escape, uint64 escape_sz)
+{
+    uint64 pos = 0, lit_sz, s = 0, j;
+    const uint8 *lit;
+    uint8 token;
+    uint32 c, words = ms->words;
+
+    memset(ms->masks, 0, (uint64)words * (256 + 3) * sizeof(uint64));
+    ms->lead_star = 0;
+
+    while((token = strmatch_next_token(pattern, sz, &pos, escape, escape_sz, &lit, &lit_sz)) != STRMATCH_TOKEN_END)
+    {
+        switch(token)
+        {
+            case STRMATCH_TOKEN_STAR:
+                if(0 == s) ms->lead_star = 1;
+                else ms->loop[(s - 1) / 64] |= 1UL << ((s - 1) % 64);
+                break;
+            case STRMATCH_TOKEN_ANY:
+                for(c = 0; c < 256; c++)
+                {
+                    if(!STRMATCH_IS_CONT(c)) ms->masks[c * words + s / 64] |= 1UL << (s % 64);
+                }
+                ms->any[s / 64] |= 1UL << (s % 64);
+                s++;
+                break;
+            default:
+                for(j = 0; j < lit_sz; j++, s++)
+                {
+                    ms->masks[lit[j] * words + s / 64] |= 1UL << (s % 64);
+                }
+                break;
+        }
+    }
+
+    ms->final = 1UL << ((s - 1) % 64);
+}
+
+
+handle strmatch_compile(void *buf, const uint8 *pattern, uint64 pattern_sz, const uint8 *escape, uint64 escape_sz)
+{
+    strmatch_state *ms = (strmatch_state *)buf;
+    uint64 pos = 0, lit_sz, bytes = 0, anys = 0, stars = 0, seg_start;
+    uint8 token, lead = 0, trail = 0, inner = 0, pending = 0;
+    const uint8 *lit;
+
+    if(NULL == g_strmatch_state.contains) strmatch_init_kernels();
+
+    if(escape_sz > 0)
+    {
+        if(escape_sz > STRMATCH_MAX_ESCAPE_SZ || strmatch_char_len(escape[0]) != escape_sz)
+        {
+            error_set(ERROR_INVALID_ESCAPE);
+            return NULL;
+        }
+        for(pos = 1; pos < escape_sz; pos++)
+        {
+            if(!STRMATCH_IS_CONT(escape[pos]))
+            {
+                error_set(ERROR_INVALID_ESCAPE);
+                return NULL;
+            }
+        }
+        pos = 0;
+    }
+
+    // shape of the pattern, pending is set by % after literal bytes
+    while((token = strmatch_next_token(pattern, pattern_sz, &pos, escape, escape_sz, &lit, &lit_sz)) != STRMATCH_TOKEN_END)
+    {
+        switch(token)
+        {
+            case STRMATCH_TOKEN_ERROR:
+                error_set(ERROR_INVALID_ESCAPE);
+                return NULL;
+            case STRMATCH_TOKEN_STAR:
+                if(0 == bytes + anys) lead = 1;
+                else pending = 1;
+                trail = 1;
+                stars++;
+                break;
+            default:
+                inner |= pending;
+                pending = 0;
+                trail = 0;
+                if(STRMATCH_TOKEN_ANY == token) anys++;
+                else bytes += lit_sz;
+                break;
+        }
+    }
+
+    // NFA takes a state per literal byte and per _
+    ms->words = strmatch_words(bytes + anys);
+    ms->masks = (uint64 *)(ms + 1);
+    ms->loop = ms->masks + (uint64)ms->words * 256;
+    ms->any = ms->loop + ms->words;
+    ms->d = ms->any + ms->words;
+    ms->lit = strmatch_lit_area(buf, pattern_sz);
+    ms->lit_sz = bytes;
+
+    if(anys > 0)
+    {
+        ms->kind = STRMATCH_KIND_GENERAL;
+        strmatch_build_nfa(ms, pattern, pattern_sz, escape, escape_sz);
+        return (handle)ms;
+    }
+
+    if(inner)
+    {
+        // literal segments between % are searched directly, NFA is still run on strings read by windows
+        ms->kind = STRMATCH_KIND_SEGMENTS;
+        ms->trail_star = trail;
+        ms->seg = strmatch_seg_area(buf, pattern_sz);
+        ms->segs = 0;
+        strmatch_build_nfa(ms, pattern, pattern_sz, escape, escape_sz);
+    }
+    else if(0 == stars) ms->kind = STRMATCH_KIND_EXACT;
+    else if(0 == bytes) ms->kind = STRMATCH_KIND_ANY;
+    else if(lead && trail) ms->kind = STRMATCH_KIND_CONTAINS;
+    else if(lead) ms->kind = STRMATCH_KIND_SUFFIX;
+    else ms->kind = STRMATCH_KIND_PREFIX;
+
+    // literal never gets ahead of the pattern, so pattern may be in the literal area already;
+    // % closes segment of bytes read after the previous segment
+    for(pos = 0, bytes = 0, seg_start = 0; (token = strmatch_next_token(pattern, pattern_sz, &pos, escape, escape_sz, &lit, &lit_sz)) != STRMATCH_TOKEN_END; )
+    {
+        if(STRMATCH_TOKEN_BYTES == token)
+        {
+            memmove(ms->lit + bytes, lit, lit_sz);
+            bytes += lit_sz;
+        }
+        else if(STRMATCH_KIND_SEGMENTS == ms->kind && bytes > seg_start)
+        {
+            ms->seg[ms->segs++] = (uint32)(bytes - seg_start);
+            seg_start = bytes;
+        }
+    }
+    if(STRMATCH_KIND_SEGMENTS == ms->kind && bytes > seg_start) ms->seg[ms->segs++] = (uint32)(bytes - seg_start);
+
+    return (handle)ms;
+}
+
+
+handle strmatch_compile_literal(void *buf, handle pattern, handle escape)
+{
+    uint8 esc[STRMATCH_MAX_ESCAPE_SZ + 1];
+    uint64 pattern_sz, sz, escape_sz = 0;
+    uint8 *area;
+
+    if(string_literal_byte_length(pattern, &pattern_sz) != 0) return NULL;
+
+    if(NULL != escape)
+    {
+        escape_sz = sizeof(esc);
+        if(string_literal_read(escape, esc, &escape_sz) != 0) return NULL;
+        if(0 == escape_sz)
+        {
+            error_set(ERROR_INVALID_ESCAPE);
+            return NULL;
+        }
+    }
+
+    area = strmatch_lit_area(buf, pattern_sz);
+    sz = pattern_sz;
+    if(string_literal_read(pattern, area, &sz) != 0) return NULL;
+
+    return strmatch_compile(buf, area, sz, esc, escape_sz);
+}
+
+
+strmatch_kind strmatch_get_kind(handle mh)
+{
+    return ((strmatch_state *)mh)->kind;
+}
+
+
+// run NFA of ms over str of sz bytes from active states d, first is 1 if str is the beginning of string
+// return STRMATCH_NFA_*
+uint8 strmatch_nfa_run(const strmatch_state *ms, uint64 *d, uint8 first, const uint8 *str, uint64 sz)
+{
+    const uint64 *masks = ms->masks, *loop = ms->loop, *any = ms->any;
+    uint64 start = first | ms->lead_star, i, carry, next, last = ms->words - 1;
+    uint32 w, words = ms->words;
+    uint8 c;
+
+    if(1 == words)
+    {
+        uint64 s = d[0], lp = loop[0], an = any[0];
+
+        for(i = 0; i < sz; i++)
+        {
+            c = str[i];
+            s = (((s << 1) | start) & masks[c]) | (s & lp) | (STRMATCH_IS_CONT(c) ? s & an : 0);
+            start = ms->lead_star;
+            if(s & ms->final & lp) return STRMATCH_NFA_ACCEPT;
+            if(0 == (s | start)) return STRMATCH_NFA_REJECT;
+        }
+
+        d[0] = s;
+        return STRMATCH_NFA_CONTINUE;
+    }
+
+    for(i = 0; i < sz; i++)
+    {
+        c = str[i];
+        next = 0;
+
+        // words are shifted from the highest one, so carry is taken from the old lower word
+        for(w = words; w-- > 0; )
+        {
+            carry = (w > 0) ? d[w - 1] >> 63 : start;
+            d[w] = (((d[w] << 1) | carry) & masks[c * words + w]) | (d[w] & loop[w])
+                   | (STRMATCH_IS_CONT(c) ? d[w] & any[w] : 0);
+            next |= d[w];
+        }
+
+        start = ms->lead_star;
+        if(d[last] & ms->final & loop[last]) return STRMATCH_NFA_ACCEPT;
+        if(0 == (next | start)) return STRMATCH_NFA_REJECT;
+    }
+
+    return STRMATCH_NFA_CONTINUE;
+}
+
+
+// match str of sz bytes against segments of ms: the first segment is at the beginning unless pattern starts with %,
+// the last one is at the end unless pattern ends with %, inner segments are taken at their leftmost occurrences,
+// which leave the most of the string to the rest
+// return 1 if str matches, 0 otherwise
+uint8 strmatch_segments_match(const strmatch_state *ms, const uint8 *str, uint64 sz)
+{
+    const uint8 *lit = ms->lit, *p;
+    uint32 s = 0, n = ms->segs;
+    uint64 len;
+
+    // the first byte rejects most strings without call of memcmp
+    if(!ms->lead_star)
+    {
+        len = ms->seg[s++];
+        if(sz < len || str[0] != lit[0] || 0 != memcmp(str, lit, len)) return 0;
+        str += len;
+        sz -= len;
+        lit += len;
+    }
+
+    if(!ms->trail_star)
+    {
+        len = ms->seg[--n];
+        if(sz < len || 0 != memcmp(str + sz - len, ms->lit + ms->lit_sz - len, len)) return 0;
+        sz -= len;
+    }
+
+    for(; s < n; s++)
+    {
+        len = ms->seg[s];
+        if(NULL == (p = strmatch_find(str, sz, lit, len))) return 0;
+        sz -= (uint64)(p - str) + len;
+        str = p + len;
+        lit += len;
+    }
+
+    return 1;
+}
+
+
+uint8 strmatch_match(handle mh, const uint8 *str, uint64 sz)
+{
+    strmatch_state *ms = (strmatch_state *)mh;
+    uint64 lit_sz = ms->lit_sz;
+    uint8 r;
+
+    switch(ms->kind)
+    {
+        case STRMATCH_KIND_EXACT:
+            return sz == lit_sz && 0 == memcmp(str, ms->lit, lit_sz);
+        case STRMATCH_KIND_PREFIX:
+            return sz >= lit_sz && 0 == memcmp(str, ms->lit, lit_sz);
+        case STRMATCH_KIND_SUFFIX:
+            return sz >= lit_sz && 0 == memcmp(str + sz - lit_sz, ms->lit, lit_sz);
+        case STRMATCH_KIND_CONTAINS:
+            return g_strmatch_state.contains(str, sz, ms->lit, lit_sz);
+        case STRMATCH_KIND_ANY:
+            return 1;
+        case STRMATCH_KIND_SEGMENTS:
+            return strmatch_segments_match(ms, str, sz);
+        default:
+            memset(ms->d, 0, ms->words * sizeof(uint64));
+            r = strmatch_nfa_run(ms, ms->d, 1, str, sz);
+            if(STRMATCH_NFA_CONTINUE == r) return (ms->d[ms->words - 1] & ms->final) != 0;
+            return STRMATCH_NFA_ACCEPT == r;
+    }
+}
+
+
+// compare lit_sz bytes of string literal sl starting from offset with lit, res is set to 1 if they are equal
+// return 0 on success, non-0 on error
+sint8 strmatch_literal_equal(handle sl, uint64 offset, const uint8 *lit, uint64 lit_sz, uint8 *res)
+{
+    uint8 buf[STRMATCH_WINDOW_SZ];
+    uint64 i, sz;
+
+    for(i = 0, *res = 1; i < lit_sz && *res; i += sz)
+    {
+        sz = (lit_sz - i < sizeof(buf)) ? lit_sz - i : sizeof(buf);
+        if(string_literal_read_at(sl, offset + i, buf, &sz) != 0) return 1;
+        *res = (sz > 0 && 0 == memcmp(buf, lit + i, sz));
+    }
+
+    return 0;
+}
+
+
+sint8 strmatch_match_literal(handle mh, handle sl, uint8 *res)
+{
+    strmatch_state *ms = (strmatch_state *)mh;
+    uint8 buf[STRMATCH_WINDOW_SZ], *str, r;
+    uint64 len, sz, offset, lit_sz = ms->lit_sz;
+
+    if(string_literal_byte_length(sl, &len) != 0) return 1;
+
+    if(len <= sizeof(buf))
+    {
+        sz = len;
+        if(string_literal_read(sl, buf, &sz) != 0) return 1;
+        *res = strmatch_match(mh, buf, sz);
+        return 0;
+    }
+
+    switch(ms->kind)
+    {
+        case STRMATCH_KIND_EXACT:
+            if(len != lit_sz)
+            {
+                *res = 0;
+                return 0;
+            }
+            return strmatch_literal_equal(sl, 0, ms->lit, lit_sz, res);
+        case STRMATCH_KIND_PREFIX:
+            *res = 0;
+            return (len >= lit_sz) ? strmatch_literal_equal(sl, 0, ms->lit, lit_sz, res) : 0;
+        case STRMATCH_KIND_SUFFIX:
+            *res = 0;
+            return (len >= lit_sz) ? strmatch_literal_equal(sl, len - lit_sz, ms->lit, lit_sz, res) : 0;
+        case STRMATCH_KIND_ANY:
+            *res = 1;
+            return 0;
+        case STRMATCH_KIND_CONTAINS:
+            if(lit_sz > sizeof(buf) / 2)
+            {
+                // literal doesn't leave room for sliding window, string is read as a whole
+                str = (uint8 *)malloc(len);
+                if(NULL == str)
+                {
+                    error_set(ERROR_OUT_OF_MEMORY);
+                    return 1;
+                }
+                sz = len;
+                r = (string_literal_read(sl, str, &sz) != 0);
+                if(0 == r) *res = strmatch_match(mh, str, sz);
+                free(str);
+                return r;
+            }
+
+            // windows overlap by lit_sz - 1 bytes, so occurrence is never split
+            for(offset = 0, *res = 0; ; offset += sz - (lit_sz - 1))
+            {
+                sz = sizeof(buf);
+                if(string_literal_read_at(sl, offset, buf, &sz) != 0) return 1;
+                if(g_strmatch_state.contains(buf, sz, ms->lit, lit_sz))
+                {
+                    *res = 1;
+                    return 0;
+                }
+                if(offset + sz >= len) return 0;
+            }
+        default:
+            memset(ms->d, 0, ms->words * sizeof(uint64));
+            for(offset = 0, r = STRMATCH_NFA_CONTINUE; offset < len && STRMATCH_NFA_CONTINUE == r; offset += sz)
+            {
+                sz = sizeof(buf);
+                if(string_literal_read_at(sl, offset, buf, &sz) != 0) return 1;
+                if(0 == sz) break;
+                r = strmatch_nfa_run(ms, ms->d, 0 == offset, buf, sz);
+            }
+            *res = (STRMATCH_NFA_CONTINUE == r) ? (ms->d[ms->words - 1] & ms->final) != 0 : (STRMATCH_NFA_ACCEPT == r);
+            return 0;
+    }
+}
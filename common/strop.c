@@ -7,6 +7,11 @@
 #include "common/error.h"
 
 #define TIMESTAMP_TZ_MASK (0xFFF0000000000000UL)
+#define STROP_UINT64_DIGITS (20)
+#define STROP_DECIMAL_DIGITS (DECIMAL_POSITIONS + 2 * 256)  // mantissa and zeroes up to precision
+#define STROP_DTTM_NO_DAY (0xFFFFFFFFFFFFFFFFUL)   // day of empty calendar fields cache
+#define STROP_DTTM_MAX_TZ (18 * 60)                 // largest time zone offset in minutes
+#define STROP_NOT_DIGIT (0xFF)
 
 struct
 {
@@ -15,6 +20,8 @@ struct
 
     uint8 digit_buf[10][ENCODING_MAXCHAR_LEN];
     char_info digits[10];
+    uint8 digit_pairs[200];     // "00", "01", ..., "99"
+    uint8 digit_value[256];     // value of digit byte, STROP_NOT_DIGIT for other bytes
 
     uint8 fmt_letters_buf[13][ENCODING_MAXCHAR_LEN];
     char_info fmt_letter_y;
@@ -49,6 +56,19 @@ void strop_set_encoding(encoding enc)
         ach = _ach('0') + i;
         g_strop_state.digits[i].chr = g_strop_state.digit_buf[i];
         g_strop_state.conversion_fun((const_char_info *)&achr, &(g_strop_state.digits[i]));
+        assert(g_strop_state.digits[i].length == 1);
+    }
+
+    memset(g_strop_state.digit_value, STROP_NOT_DIGIT, sizeof(g_strop_state.digit_value));
+    for(int i=0; i<10; i++)
+    {
+        g_strop_state.digit_value[g_strop_state.digit_buf[i][0]] = (uint8)i;
+    }
+
+    for(int i=0; i<100; i++)
+    {
+        g_strop_state.digit_pairs[i * 2] = g_strop_state.digit_buf[i / 10][0];
+        g_strop_state.digit_pairs[i * 2 + 1] = g_strop_state.digit_buf[i % 10][0];
     }
 
     g_strop_state.fmt_letter_y.chr      = g_strop_state.fmt_letters_buf[0];
@@ -81,39 +101,48 @@ void strop_set_encoding(encoding enc)
 }
 
 
-// format uint64 number to string, put in buf starting from ptr, adjust ptr to point at the end of formatted value
-// return 0 on success, non-0 on error
-sint8 strop_fmt_uint64(uint8* buf, uint32 *ptr, uint32 sz, uint64 number)
+// put digits of number to memory ending at end, two digits at a time
+// return pointer to the most significant digit
+inline uint8 *strop_uint64_to_digits(uint64 number, uint8 *end)
 {
-    uint32 charlen, dgt;
-    uint64 pos = 1;
+    uint32 r;
+
+    while(number >= 100)
+    {
+        r = (uint32)(number % 100) * 2;
+        number /= 100;
+        end -= 2;
+        end[0] = g_strop_state.digit_pairs[r];
+        end[1] = g_strop_state.digit_pairs[r + 1];
+    }
 
-    if(0 == number)
+    r = (uint32)number * 2;
+    if(number >= 10)
     {
-        charlen = g_strop_state.digits[0].length;
-        if(sz - (*ptr) < charlen) return 1; // buf overflow
-        memcpy(buf + (*ptr), g_strop_state.digit_buf[0], charlen);
-        (*ptr) += charlen;
+        end -= 2;
+        end[0] = g_strop_state.digit_pairs[r];
+        end[1] = g_strop_state.digit_pairs[r + 1];
     }
     else
     {
-        while((number / pos) / 10 != 0)
-        {
-            pos *= 10;
-        }
-
-        do
-        {
-            dgt = (number / pos) % 10;
-            charlen = g_strop_state.digits[dgt].length;
-            if(sz - (*ptr) < charlen) return 1; // buf overflow
-            memcpy(buf + (*ptr), g_strop_state.digit_buf[dgt], charlen);
-            (*ptr) += charlen;
-            pos /= 10;
-        }
-        while(pos != 0);
+        *(--end) = g_strop_state.digit_pairs[r + 1];
     }
 
+    return end;
+}
+
+// format uint64 number to string, put in buf starting from ptr, adjust ptr to point at the end of formatted value
+// return 0 on success, non-0 on error
+sint8 strop_fmt_uint64(uint8* buf, uint32 *ptr, uint32 sz, uint64 number)
+{
+    uint8 tmp[STROP_UINT64_DIGITS];
+    uint8 *p = strop_uint64_to_digits(number, tmp + STROP_UINT64_DIGITS);
+    uint32 len = (uint32)(tmp + STROP_UINT64_DIGITS - p);
+
+    if(sz - (*ptr) < len) return 1; // buf overflow
+    memcpy(buf + (*ptr), p, len);
+    (*ptr) += len;
+
     return 0;
 }
 
@@ -122,59 +151,154 @@ sint8 strop_fmt_uint64(uint8* buf, uint32 *ptr, uint32 sz, uint64 number)
 // return 0 on success, non-0 on buffer overflow
 sint8 strop_fmt_uint64_padded(uint8* buf, uint32 *ptr, uint32 sz, uint64 number, uint32 pad)
 {
-    uint32 charlen, dgt;
-    uint64 pos = 1;
+    uint8 tmp[STROP_UINT64_DIGITS];
 
     if(pad == 0) return 0;
+    if(sz - (*ptr) < pad) return 1; // buf overflow
 
-    pad--;
-    while((number / pos) / 10 != 0 && pad > 0)
+    if(pad > STROP_UINT64_DIGITS)
     {
-        pos *= 10;
-        pad--;
+        memset(buf + (*ptr), g_strop_state.digit_pairs[0], pad - STROP_UINT64_DIGITS);
+        (*ptr) += pad - STROP_UINT64_DIGITS;
+        pad = STROP_UINT64_DIGITS;
     }
 
-    charlen = g_strop_state.digits[0].length;
-    while(pad > 0)
+    // the lowest pad digits of number padded with zeroes
+    memset(tmp, g_strop_state.digit_pairs[0], STROP_UINT64_DIGITS);
+    strop_uint64_to_digits(number, tmp + STROP_UINT64_DIGITS);
+    memcpy(buf + (*ptr), tmp + STROP_UINT64_DIGITS - pad, pad);
+    (*ptr) += pad;
+
+    return 0;
+}
+
+// put character chr to buf
+// return 0 on success, non-0 on buffer overflow
+inline sint8 strop_put_char(uint8 *buf, uint32 *ptr, uint32 sz, const char_info *chr)
+{
+    if(sz - (*ptr) < chr->length) return 1; // buf overflow
+    memcpy(buf + (*ptr), chr->chr, chr->length);
+    (*ptr) += chr->length;
+    return 0;
+}
+
+// append literal character chr to compiled format df, adjacent literal characters make one op
+// return 0 on success, non-0 if format is too long
+inline sint8 strop_dttm_fmt_add_literal(strop_dttm_fmt *df, const char_info *chr)
+{
+    strop_dttm_fmt_op *op = df->ops + df->n - 1;
+
+    if(df->literal_sz + chr->length > STROP_DTTM_FMT_LITERAL_SZ) return 1;
+
+    if(df->n == 0 || op->code != STROP_DTTM_LITERAL)
     {
-        if(sz - (*ptr) < charlen) return 1; // buf overflow
-        memcpy(buf + (*ptr), g_strop_state.digit_buf[0], charlen);
-        (*ptr) += charlen;
-        pad--;
+        if(df->n == STROP_DTTM_FMT_OPS) return 1;
+        op = df->ops + df->n++;
+        op->code = STROP_DTTM_LITERAL;
+        op->len = 0;
+        op->offset = (uint16)df->literal_sz;
     }
 
-    do
+    memcpy(df->literals + df->literal_sz, chr->chr, chr->length);
+    df->literal_sz += chr->length;
+    op->len += chr->length;
+
+    return 0;
+}
+
+// append field op of code with len positions to compiled format df
+// return 0 on success, non-0 if format is too long
+inline sint8 strop_dttm_fmt_add_field(strop_dttm_fmt *df, uint8 code, uint8 len)
+{
+    if(df->n == STROP_DTTM_FMT_OPS) return 1;
+
+    df->ops[df->n].code = code;
+    df->ops[df->n].len = len;
+    df->ops[df->n].offset = 0;
+    df->n++;
+    df->calendar |= code == STROP_DTTM_YEAR || code == STROP_DTTM_MONTH || code == STROP_DTTM_DAY;
+
+    return 0;
+}
+
+// return 1 if op of df is literal lit of len bytes
+uint8 strop_dttm_fmt_is_literal(const strop_dttm_fmt *df, const strop_dttm_fmt_op *op, const char *lit, uint8 len)
+{
+    return op->code == STROP_DTTM_LITERAL && op->len == len && 0 == memcmp(df->literals + op->offset, lit, len);
+}
+
+// set ISO-8601 shape of df if its ops are yyyy-mm-dd[(T| )hh:mi[:ss[.f...]][tz]]
+void strop_dttm_fmt_detect_iso(strop_dttm_fmt *df)
+{
+    const strop_dttm_fmt_op *op = df->ops, *end = df->ops + df->n;
+    uint8 shape, sep = 0, frac = 0;
+
+    df->iso_shape = 0;
+    df->iso_sep = 0;
+    df->iso_frac = 0;
+
+    if(df->n < 5 || op[0].code != STROP_DTTM_YEAR || !strop_dttm_fmt_is_literal(df, op + 1, "-", 1) || op[2].code != STROP_DTTM_MONTH
+        || !strop_dttm_fmt_is_literal(df, op + 3, "-", 1) || op[4].code != STROP_DTTM_DAY) return;
+    shape = STROP_ISO_DATE;
+    op += 5;
+
+    if(op < end)
     {
-        dgt = (number / pos) % 10;
-        charlen = g_strop_state.digits[dgt].length;
-        if(sz - (*ptr) < charlen) return 1; // buf overflow
-        memcpy(buf + (*ptr), g_strop_state.digit_buf[dgt], charlen);
-        (*ptr) += charlen;
-        pos /= 10;
+        if(end - op < 4 || (!strop_dttm_fmt_is_literal(df, op, "T", 1) && !strop_dttm_fmt_is_literal(df, op, " ", 1))
+            || op[1].code != STROP_DTTM_HOUR || !strop_dttm_fmt_is_literal(df, op + 2, ":", 1) || op[3].code != STROP_DTTM_MINUTES) return;
+        sep = df->literals[op->offset];
+        shape |= STROP_ISO_TIME;
+        op += 4;
+
+        if(end - op >= 2 && strop_dttm_fmt_is_literal(df, op, ":", 1) && op[1].code == STROP_DTTM_SECONDS)
+        {
+            shape |= STROP_ISO_SECONDS;
+            op += 2;
+
+            if(end - op >= 2 && strop_dttm_fmt_is_literal(df, op, ".", 1) && op[1].code == STROP_DTTM_FRACTION)
+            {
+                frac = op[1].len;
+                op += 2;
+            }
+        }
+
+        if(op < end && op->code == STROP_DTTM_TZ)
+        {
+            shape |= STROP_ISO_TZ;
+            op++;
+        }
     }
-    while(pos != 0);
 
-    return 0;
+    if(op != end) return;
+
+    df->iso_shape = shape;
+    df->iso_sep = sep;
+    df->iso_frac = frac;
 }
 
-sint8 strop_fmt_dttm_all(uint8 *buf, uint32 *start, uint32 sz, const achar* fmt, uint64 date, uint32 microseconds, sint16 tzminutes)
+// compile date and timestamp format fmt (see strop_fmt_timestamp_with_tz) to df
+// return 0 on success, non-0 on error
+sint8 strop_dttm_fmt_compile(const achar *fmt, strop_dttm_fmt *df)
 {
-    uint32 ptr = (*start);
-    uint8 finished = 0, cnt;
+    uint8 finished = 0, cnt, res = 0;
     achar ch, ach;
     uint8 chr_buf[ENCODING_MAXCHAR_LEN];
     char_info achr;
     char_info chr;
-    const char_info *sign;
 
     chr.chr = chr_buf;
     achr.chr = (uint8*)&ach;
     achr.length = 1;
 
-    assert(sz - ptr > 0 && buf != NULL && fmt != NULL);
+    df->n = 0;
+    df->literal_sz = 0;
+    df->calendar = 0;
+
+    assert(fmt != NULL);
 
+    // letters which don't make a field are literals, the next character is checked again
     ch = *(fmt++);
-    while(!finished)
+    while(!finished && res == 0)
     {
         if(ch == _ach('y'))
         {
@@ -189,17 +313,11 @@ sint8 strop_fmt_dttm_all(uint8 *buf, uint32 *start, uint32 sz, const achar* fmt,
             if(cnt == 4)
             {
                 // yyyy
-                if(0 != strop_fmt_uint64_padded(buf, &ptr, sz, dateop_extract_year(date), 4)) return 1;
+                res = strop_dttm_fmt_add_field(df, STROP_DTTM_YEAR, 4);
             }
             else
             {
-                while(cnt > 0)
-                {
-                    if(sz - ptr < g_strop_state.fmt_letter_y.length) return 1; // buf overflow
-                    memcpy(buf + ptr, g_strop_state.fmt_letter_y.chr, g_strop_state.fmt_letter_y.length);
-                    ptr += g_strop_state.fmt_letter_y.length;
-                    cnt --;
-                }
+                while(cnt-- > 0 && res == 0) res = strop_dttm_fmt_add_literal(df, &g_strop_state.fmt_letter_y);
             }
         }
         else if(ch == _ach('m'))
@@ -208,68 +326,33 @@ sint8 strop_fmt_dttm_all(uint8 *buf, uint32 *start, uint32 sz, const achar* fmt,
             if(ch == _ach('m'))
             {
                 // month
-                if(0 != strop_fmt_uint64_padded(buf, &ptr, sz, dateop_extract_month_of_year(date), 2)) return 1;
+                res = strop_dttm_fmt_add_field(df, STROP_DTTM_MONTH, 2);
                 ch = *(fmt++);
             }
             else if(ch == _ach('i'))
             {
                 // minutes
-                if(0 != strop_fmt_uint64_padded(buf, &ptr, sz, dateop_extract_minutes(date), 2)) return 1;
+                res = strop_dttm_fmt_add_field(df, STROP_DTTM_MINUTES, 2);
                 ch = *(fmt++);
             }
             else
             {
-                if(sz - ptr < g_strop_state.fmt_letter_m.length) return 1; // buf overflow
-                memcpy(buf + ptr, g_strop_state.fmt_letter_m.chr, g_strop_state.fmt_letter_m.length);
-                ptr += g_strop_state.fmt_letter_m.length;
+                res = strop_dttm_fmt_add_literal(df, &g_strop_state.fmt_letter_m);
             }
         }
-        else if(ch == _ach('d'))
-        {
-            ch = *(fmt++);
-            if(ch == _ach('d'))
-            {
-                // day of month
-                if(0 != strop_fmt_uint64_padded(buf, &ptr, sz, dateop_extract_day_of_month(date), 2)) return 1;
-                ch = *(fmt++);
-            }
-            else
-            {
-                if(sz - ptr < g_strop_state.fmt_letter_d.length) return 1; // buf overflow
-                memcpy(buf + ptr, g_strop_state.fmt_letter_d.chr, g_strop_state.fmt_letter_d.length);
-                ptr += g_strop_state.fmt_letter_d.length;
-            }
-        }
-        else if(ch == _ach('h'))
-        {
-            ch = *(fmt++);
-            if(ch == _ach('h'))
-            {
-                // hour
-                if(0 != strop_fmt_uint64_padded(buf, &ptr, sz, (uint64)dateop_extract_hour(date), 2)) return 1;
-                ch = *(fmt++);
-            }
-            else
-            {
-                if(sz - ptr < g_strop_state.fmt_letter_h.length) return 1; // buf overflow
-                memcpy(buf + ptr, g_strop_state.fmt_letter_h.chr, g_strop_state.fmt_letter_h.length);
-                ptr += g_strop_state.fmt_letter_h.length;
-            }
-        }
-        else if(ch == _ach('s'))
+        else if(ch == _ach('d') || ch == _ach('h') || ch == _ach('s'))
         {
+            ach = ch;
             ch = *(fmt++);
-            if(ch == _ach('s'))
+            if(ch == ach)
             {
-                // second
-                if(0 != strop_fmt_uint64_padded(buf, &ptr, sz, (uint64)dateop_extract_seconds(date), 2)) return 1;
+                // day of month, hour or second
+                res = strop_dttm_fmt_add_field(df, ach == _ach('d') ? STROP_DTTM_DAY : (ach == _ach('h') ? STROP_DTTM_HOUR : STROP_DTTM_SECONDS), 2);
                 ch = *(fmt++);
             }
             else
             {
-                if(sz - ptr < g_strop_state.fmt_letter_s.length) return 1; // buf overflow
-                memcpy(buf + ptr, g_strop_state.fmt_letter_s.chr, g_strop_state.fmt_letter_s.length);
-                ptr += g_strop_state.fmt_letter_s.length;
+                res = strop_dttm_fmt_add_literal(df, ach == _ach('d') ? &g_strop_state.fmt_letter_d : (ach == _ach('h') ? &g_strop_state.fmt_letter_h : &g_strop_state.fmt_letter_s));
             }
         }
         else if(ch == _ach('f'))
@@ -282,45 +365,19 @@ sint8 strop_fmt_dttm_all(uint8 *buf, uint32 *start, uint32 sz, const achar* fmt,
             }
             while(ch == _ach('f') && cnt < 6);
 
-            if(0 != strop_fmt_uint64_padded(buf, &ptr, sz, microseconds / g_strop_state.pow10[6 - cnt], cnt)) return 1;
+            res = strop_dttm_fmt_add_field(df, STROP_DTTM_FRACTION, cnt);
         }
         else if(ch == _ach('t'))
         {
             ch = *(fmt++);
             if(ch == _ach('z'))
             {
-                if(tzminutes >= 0)
-                {
-                    sign = &g_strop_state.sign_plus;
-                }
-                else
-                {
-                    sign = &g_strop_state.sign_minus;
-                    tzminutes = -tzminutes;
-                }
-
-                if(sz - ptr < sign->length) return 1; // buf overflow
-                memcpy(buf + ptr, sign->chr, sign->length);
-                ptr += sign->length;
-
-                // tz hours
-                if(0 != strop_fmt_uint64_padded(buf, &ptr, sz, tzminutes/60, 2)) return 1;
-
-                // :
-                if(sz - ptr < g_strop_state.colon.length) return 1; // buf overflow
-                memcpy(buf + ptr, g_strop_state.colon.chr, g_strop_state.colon.length);
-                ptr += g_strop_state.colon.length;
-
-                // tz minutes
-                if(0 != strop_fmt_uint64_padded(buf, &ptr, sz, tzminutes%60, 2)) return 1;
-
+                res = strop_dttm_fmt_add_field(df, STROP_DTTM_TZ, 0);
                 ch = *(fmt++);
             }
             else
             {
-                if(sz - ptr < g_strop_state.fmt_letter_t.length) return 1; // buf overflow
-                memcpy(buf + ptr, g_strop_state.fmt_letter_t.chr, g_strop_state.fmt_letter_t.length);
-                ptr += g_strop_state.fmt_letter_t.length;
+                res = strop_dttm_fmt_add_literal(df, &g_strop_state.fmt_letter_t);
             }
         }
         else if(ch == _ach('\0'))
@@ -332,30 +389,464 @@ sint8 strop_fmt_dttm_all(uint8 *buf, uint32 *start, uint32 sz, const achar* fmt,
             // simply write char to buf
             ach = ch;
             g_strop_state.conversion_fun((const_char_info*)&achr, &chr);
-            if(sz - ptr < chr.length) return 1; // buf overflow
-            memcpy(buf + ptr, chr_buf, chr.length);
-            ptr += chr.length;
+            res = strop_dttm_fmt_add_literal(df, &chr);
 
             ch = *(fmt++);
         }
     }
 
+    if(res != 0)
+    {
+        error_set(ERROR_INVALID_DATETIME_FORMAT);
+        return 1;
+    }
+
+    strop_dttm_fmt_detect_iso(df);
+
+    return 0;
+}
+
+// put two digits of v < 100 to buf
+// return 0 on success, non-0 on buffer overflow
+inline sint8 strop_put_pair(uint8 *buf, uint32 *ptr, uint32 sz, uint32 v)
+{
+    if(sz - (*ptr) < 2) return 1; // buf overflow
+    buf[(*ptr)] = g_strop_state.digit_pairs[v * 2];
+    buf[(*ptr) + 1] = g_strop_state.digit_pairs[v * 2 + 1];
+    (*ptr) += 2;
+    return 0;
+}
+
+// format date of seconds with calendar fields f, microseconds and time zone according to df and put result to buf + start
+// return 0 on success, non-0 on buffer overflow
+// start value updated to point after formatted date
+sint8 strop_fmt_dttm_fields(uint8 *buf, uint32 *start, uint32 sz, const strop_dttm_fmt *df, const strop_dttm_fields *f,
+                            uint64 date, uint32 microseconds, sint16 tzminutes)
+{
+    const strop_dttm_fmt_op *op = df->ops, *end = df->ops + df->n;
+    uint32 ptr = (*start), sec = (uint32)(date % 86400);
+    const char_info *sign;
+
+    for(; op < end; op++)
+    {
+        switch(op->code)
+        {
+            case STROP_DTTM_LITERAL:
+                if(sz - ptr < op->len) return 1; // buf overflow
+                memcpy(buf + ptr, df->literals + op->offset, op->len);
+                ptr += op->len;
+                break;
+            case STROP_DTTM_YEAR:
+                if(0 != strop_put_pair(buf, &ptr, sz, (uint32)(f->year / 100 % 100))) return 1;
+                if(0 != strop_put_pair(buf, &ptr, sz, (uint32)(f->year % 100))) return 1;
+                break;
+            case STROP_DTTM_MONTH:
+                if(0 != strop_put_pair(buf, &ptr, sz, f->month)) return 1;
+                break;
+            case STROP_DTTM_DAY:
+                if(0 != strop_put_pair(buf, &ptr, sz, f->day)) return 1;
+                break;
+            case STROP_DTTM_HOUR:
+                if(0 != strop_put_pair(buf, &ptr, sz, sec / 3600)) return 1;
+                break;
+            case STROP_DTTM_MINUTES:
+                if(0 != strop_put_pair(buf, &ptr, sz, sec % 3600 / 60)) return 1;
+                break;
+            case STROP_DTTM_SECONDS:
+                if(0 != strop_put_pair(buf, &ptr, sz, sec % 60)) return 1;
+                break;
+            case STROP_DTTM_FRACTION:
+                if(0 != strop_fmt_uint64_padded(buf, &ptr, sz, microseconds / g_strop_state.pow10[6 - op->len], op->len)) return 1;
+                break;
+            case STROP_DTTM_TZ:
+                sign = tzminutes >= 0 ? &g_strop_state.sign_plus : &g_strop_state.sign_minus;
+                if(0 != strop_put_char(buf, &ptr, sz, sign)) return 1;
+                if(0 != strop_fmt_uint64_padded(buf, &ptr, sz, (uint64)(tzminutes >= 0 ? tzminutes : -tzminutes) / 60, 2)) return 1;
+                if(0 != strop_put_char(buf, &ptr, sz, &g_strop_state.colon)) return 1;
+                if(0 != strop_put_pair(buf, &ptr, sz, (uint32)(tzminutes >= 0 ? tzminutes : -tzminutes) % 60)) return 1;
+                break;
+        }
+    }
+
     (*start) = ptr;
 
     return 0;
 }
 
-/*
-uint64 strop_len_utf8(const uint8 *str)
+// fill calendar fields f of date of seconds if df uses them and the day differs from the one of f
+inline void strop_dttm_fields_get(const strop_dttm_fmt *df, uint64 date, strop_dttm_fields *f)
+{
+    uint64 days = date / 86400;
+
+    if(df->calendar && days != f->days)
+    {
+        dateop_extract_date_batch(&date, 1, &f->year, &f->month, &f->day);
+        f->days = days;
+    }
+}
+
+sint8 strop_fmt_dttm_all(uint8 *buf, uint32 *start, uint32 sz, const achar* fmt, uint64 date, uint32 microseconds, sint16 tzminutes)
+{
+    strop_dttm_fmt df;
+    strop_dttm_fields f = {.days = STROP_DTTM_NO_DAY};
+
+    if(0 != strop_dttm_fmt_compile(fmt, &df)) return 1;
+    strop_dttm_fields_get(&df, date, &f);
+
+    return strop_fmt_dttm_fields(buf, start, sz, &df, &f, date, microseconds, tzminutes);
+}
+
+// fields of date or timestamp read from text
+typedef struct _strop_dttm_value
+{
+    uint64 year;
+    uint32 microseconds;
+    uint8  month;
+    uint8  day;
+    uint8  hour;
+    uint8  min;
+    uint8  sec;
+    uint8  shape;           // STROP_ISO_* parts found by ISO-8601 parser
+    uint8  frac;            // digits of fraction found by ISO-8601 parser
+    uint8  sep;             // separator of date and time found by ISO-8601 parser
+    sint16 tz;
+} strop_dttm_value;
+
+// return value of n digits of str, digits are checked by caller
+inline uint32 strop_digits_value(const uint8 *str, uint32 n)
+{
+    uint32 v = 0;
+
+    for(uint32 i = 0; i < n; i++)
+    {
+        v = v * 10 + g_strop_state.digit_value[str[i]];
+    }
+
+    return v;
+}
+
+// return 1 if n bytes of str are digits
+inline uint8 strop_is_digits(const uint8 *str, uint32 n)
+{
+    for(uint32 i = 0; i < n; i++)
+    {
+        if(g_strop_state.digit_value[str[i]] == STROP_NOT_DIGIT) return 0;
+    }
+
+    return 1;
+}
+
+// return 1 if str of sz bytes at ptr starts with character chr
+inline uint8 strop_starts_with_char(const uint8 *str, uint32 sz, uint32 ptr, const char_info *chr)
+{
+    return sz - ptr >= chr->length && 0 == memcmp(str + ptr, chr->chr, chr->length);
+}
+
+// read fields of value from str of sz bytes according to compiled format df, fields missing in format are left as is
+// return number of bytes read, 0 if str does not match format
+uint32 strop_parse_dttm_fields(const uint8 *str, uint32 sz, const strop_dttm_fmt *df, strop_dttm_value *v)
+{
+    const strop_dttm_fmt_op *op = df->ops, *end = df->ops + df->n;
+    uint32 ptr = 0, tz;     // tz also holds two-digit fields
+    uint8 neg;
+
+    for(; op < end; op++)
+    {
+        switch(op->code)
+        {
+            case STROP_DTTM_LITERAL:
+                if(sz - ptr < op->len || 0 != memcmp(str + ptr, df->literals + op->offset, op->len)) return 0;
+                ptr += op->len;
+                break;
+            case STROP_DTTM_YEAR:
+                if(sz - ptr < 4 || !strop_is_digits(str + ptr, 4)) return 0;
+                v->year = strop_digits_value(str + ptr, 4);
+                ptr += 4;
+                break;
+            case STROP_DTTM_FRACTION:
+                if(sz - ptr < op->len || !strop_is_digits(str + ptr, op->len)) return 0;
+                v->microseconds = strop_digits_value(str + ptr, op->len) * g_strop_state.pow10[6 - op->len];
+                ptr += op->len;
+                break;
+            case STROP_DTTM_TZ:
+                if(strop_starts_with_char(str, sz, ptr, &g_strop_state.sign_plus)) neg = 0;
+                else if(strop_starts_with_char(str, sz, ptr, &g_strop_state.sign_minus)) neg = 1;
+                else return 0;
+                ptr += neg ? g_strop_state.sign_minus.length : g_strop_state.sign_plus.length;
+
+                if(sz - ptr < 2 || !strop_is_digits(str + ptr, 2)) return 0;
+                tz = strop_digits_value(str + ptr, 2) * 60;
+                ptr += 2;
+                if(!strop_starts_with_char(str, sz, ptr, &g_strop_state.colon)) return 0;
+                ptr += g_strop_state.colon.length;
+                if(sz - ptr < 2 || !strop_is_digits(str + ptr, 2) || strop_digits_value(str + ptr, 2) > 59) return 0;
+                tz += strop_digits_value(str + ptr, 2);
+                ptr += 2;
+                v->tz = (sint16)(neg ? -(sint32)tz : (sint32)tz);
+                break;
+            default:
+                if(sz - ptr < 2 || !strop_is_digits(str + ptr, 2)) return 0;
+                tz = strop_digits_value(str + ptr, 2);
+                ptr += 2;
+
+                if(op->code == STROP_DTTM_MONTH) v->month = (uint8)tz;
+                else if(op->code == STROP_DTTM_DAY) v->day = (uint8)tz;
+                else if(op->code == STROP_DTTM_HOUR) v->hour = (uint8)tz;
+                else if(op->code == STROP_DTTM_MINUTES) v->min = (uint8)tz;
+                else v->sec = (uint8)tz;
+                break;
+        }
+    }
+
+    return ptr;
+}
+
+// read ISO-8601 value from str of sz bytes at fixed positions: yyyy-mm-dd[(T| )hh:mi[:ss[.f...]][Z|(+|-)hh[[:]mi]]],
+// fraction of up to 9 digits is truncated to microseconds, shape of v is set to parts found;
+// ASCII is compared directly, every supported encoding is ASCII-compatible
+// return number of bytes read, 0 if str does not start with ISO-8601 value
+uint32 strop_parse_iso_fields(const uint8 *str, uint32 sz, strop_dttm_value *v)
+{
+    uint32 ptr = 10, n;
+    uint8 c;
+
+    // any non-digit gives byte above 9 after subtraction of '0'
+    if(sz < 10 || str[4] != '-' || str[7] != '-') return 0;
+    if((uint8)(str[0] - '0') > 9 || (uint8)(str[1] - '0') > 9 || (uint8)(str[2] - '0') > 9 || (uint8)(str[3] - '0') > 9
+        || (uint8)(str[5] - '0') > 9 || (uint8)(str[6] - '0') > 9 || (uint8)(str[8] - '0') > 9 || (uint8)(str[9] - '0') > 9) return 0;
+
+    v->year = (str[0] - '0') * 1000 + (str[1] - '0') * 100 + (str[2] - '0') * 10 + (str[3] - '0');
+    v->month = (uint8)((str[5] - '0') * 10 + (str[6] - '0'));
+    v->day = (uint8)((str[8] - '0') * 10 + (str[9] - '0'));
+    v->shape = STROP_ISO_DATE;
+
+    // time
+    if(sz - ptr >= 6 && (str[ptr] == 'T' || str[ptr] == ' ') && str[ptr + 3] == ':'
+        && (uint8)(str[ptr + 1] - '0') <= 9 && (uint8)(str[ptr + 2] - '0') <= 9 && (uint8)(str[ptr + 4] - '0') <= 9 && (uint8)(str[ptr + 5] - '0') <= 9)
+    {
+        v->sep = str[ptr];
+        v->hour = (uint8)((str[ptr + 1] - '0') * 10 + (str[ptr + 2] - '0'));
+        v->min = (uint8)((str[ptr + 4] - '0') * 10 + (str[ptr + 5] - '0'));
+        v->shape |= STROP_ISO_TIME;
+        ptr += 6;
+
+        if(sz - ptr >= 3 && str[ptr] == ':' && (uint8)(str[ptr + 1] - '0') <= 9 && (uint8)(str[ptr + 2] - '0') <= 9)
+        {
+            v->sec = (uint8)((str[ptr + 1] - '0') * 10 + (str[ptr + 2] - '0'));
+            v->shape |= STROP_ISO_SECONDS;
+            ptr += 3;
+
+            if(sz - ptr >= 2 && str[ptr] == '.' && (uint8)(str[ptr + 1] - '0') <= 9)
+            {
+                v->microseconds = 0;
+                for(ptr++, n = 0; ptr < sz && (c = (uint8)(str[ptr] - '0')) <= 9 && n < 9; ptr++, n++)
+                {
+                    if(n < 6) v->microseconds = v->microseconds * 10 + c;
+                }
+                v->frac = (uint8)n;
+                if(n < 6) v->microseconds *= g_strop_state.pow10[6 - n];
+            }
+        }
+
+        // time zone
+        if(ptr < sz && str[ptr] == 'Z')
+        {
+            v->tz = 0;
+            v->shape |= STROP_ISO_TZ_OTHER;
+            ptr++;
+        }
+        else if(sz - ptr >= 3 && (str[ptr] == '+' || str[ptr] == '-') && (uint8)(str[ptr + 1] - '0') <= 9 && (uint8)(str[ptr + 2] - '0') <= 9)
+        {
+            c = str[ptr] == '-';
+            v->tz = (sint16)(((str[ptr + 1] - '0') * 10 + (str[ptr + 2] - '0')) * 60);
+            v->shape |= STROP_ISO_TZ_OTHER;
+            ptr += 3;
+
+            // minutes with or without colon, only the first is the time zone of compiled formats
+            n = ptr < sz && str[ptr] == ':';
+            if(sz - ptr >= 2 + n && (uint8)(str[ptr + n] - '0') <= 9 && (uint8)(str[ptr + n + 1] - '0') <= 9)
+            {
+                if(str[ptr + n] > '5') return 0;
+                v->tz = (sint16)(v->tz + (str[ptr + n] - '0') * 10 + (str[ptr + n + 1] - '0'));
+                if(n) v->shape = (v->shape & ~STROP_ISO_TZ_OTHER) | STROP_ISO_TZ;
+                ptr += 2 + n;
+            }
+            if(c) v->tz = (sint16)-v->tz;
+        }
+    }
+
+    return ptr;
+}
+
+// initialize fields which may be missing in format
+inline void strop_dttm_value_init(strop_dttm_value *v)
+{
+    memset(v, 0, sizeof(*v));
+    v->year = 1;
+    v->month = 1;
+    v->day = 1;
+}
+
+// read fields of value from str of sz bytes according to compiled format df, value of ISO-8601 format is read
+// by fixed positions if exactly the parts of format are found, otherwise by ops, so the result is the same
+// return number of bytes read, 0 if str does not match format
+inline uint32 strop_parse_dttm(const uint8 *str, uint32 sz, const strop_dttm_fmt *df, strop_dttm_value *v)
+{
+    uint32 ptr;
+
+    if(df->iso_shape != 0)
+    {
+        ptr = strop_parse_iso_fields(str, sz, v);
+        if(ptr > 0 && v->shape == df->iso_shape && v->frac == df->iso_frac && (v->sep == df->iso_sep || df->iso_sep == 0)) return ptr;
+        strop_dttm_value_init(v);
+    }
+
+    return strop_parse_dttm_fields(str, sz, df, v);
+}
+
+// convert fields v to date in seconds, calendar part is taken from f if the day is the same and stored to f otherwise
+// return 0 on success, non-0 if fields are invalid
+inline sint8 strop_dttm_value_to_date(const strop_dttm_value *v, strop_dttm_fields *f, uint64 *date)
 {
-    return
+    if(v->hour > 23 || v->min > 59 || v->sec > 59 || v->tz > STROP_DTTM_MAX_TZ || v->tz < -STROP_DTTM_MAX_TZ) return 1;
+
+    if(f->days == STROP_DTTM_NO_DAY || v->year != f->year || v->month != f->month || v->day != f->day)
+    {
+        f->days = STROP_DTTM_NO_DAY;
+        if(0 != dateop_make_date(date, v->year, v->month, v->day)) return 1;
+        f->days = (*date) / 86400;
+        f->year = v->year;
+        f->month = v->month;
+        f->day = v->day;
+    }
+
+    *date = f->days * 86400 + (uint32)v->hour * 3600 + (uint32)v->min * 60 + v->sec;
+
+    return 0;
+}
+
+// read value from str of sz bytes according to df, date is set to seconds, microseconds and tz are set if not NULL
+// return number of bytes read, 0 on error (error code is set)
+uint32 strop_parse_dttm_all(const uint8 *str, uint32 sz, const strop_dttm_fmt *df, strop_dttm_fields *f, uint64 *date, uint32 *microseconds, sint16 *tz)
+{
+    strop_dttm_value v;
+    uint32 ptr;
+
+    strop_dttm_value_init(&v);
+    ptr = strop_parse_dttm(str, sz, df, &v);
+    if(ptr == 0 || 0 != strop_dttm_value_to_date(&v, f, date))
+    {
+        error_set(ERROR_INVALID_DATETIME_FORMAT);
+        return 0;
+    }
+
+    if(microseconds != NULL) *microseconds = v.microseconds;
+    if(tz != NULL) *tz = v.tz;
+
+    return ptr;
 }
 
-uint64 strop_len(const uint8 *str)
+uint32 strop_parse_date_compiled(const uint8 *str, uint32 sz, const strop_dttm_fmt *df, uint64 *date)
 {
+    strop_dttm_fields f = {.days = STROP_DTTM_NO_DAY};
 
+    return strop_parse_dttm_all(str, sz, df, &f, date, NULL, NULL);
 }
 
+uint32 strop_parse_timestamp_compiled(const uint8 *str, uint32 sz, const strop_dttm_fmt *df, uint64 *ts)
+{
+    strop_dttm_fields f = {.days = STROP_DTTM_NO_DAY};
+    uint32 ptr, microseconds;
+
+    ptr = strop_parse_dttm_all(str, sz, df, &f, ts, &microseconds, NULL);
+    *ts = (*ts) * 1000000 + microseconds;
+
+    return ptr;
+}
+
+uint32 strop_parse_timestamp_with_tz_compiled(const uint8 *str, uint32 sz, const strop_dttm_fmt *df, uint64 *ts, sint16 *tz)
+{
+    strop_dttm_fields f = {.days = STROP_DTTM_NO_DAY};
+    uint32 ptr, microseconds;
+
+    ptr = strop_parse_dttm_all(str, sz, df, &f, ts, &microseconds, tz);
+    *ts = (*ts) * 1000000 + microseconds;
+
+    return ptr;
+}
+
+uint32 strop_parse_timestamp_iso(const uint8 *str, uint32 sz, uint64 *ts, sint16 *tz)
+{
+    strop_dttm_fields f = {.days = STROP_DTTM_NO_DAY};
+    strop_dttm_value v;
+    uint32 ptr;
+
+    strop_dttm_value_init(&v);
+    ptr = strop_parse_iso_fields(str, sz, &v);
+    if(ptr == 0 || 0 != strop_dttm_value_to_date(&v, &f, ts))
+    {
+        error_set(ERROR_INVALID_DATETIME_FORMAT);
+        return 0;
+    }
+
+    *ts = (*ts) * 1000000 + v.microseconds;
+    *tz = v.tz;
+
+    return ptr;
+}
+
+// value i of batch takes bytes from end[i - 1] to end[i] and has to be read completely,
+// the calendar part is computed once for values of the same day
+uint32 strop_parse_date_batch(const uint8 *buf, const uint32 *end, uint32 n, const strop_dttm_fmt *df, uint64 *date)
+{
+    strop_dttm_fields f = {.days = STROP_DTTM_NO_DAY};
+    uint32 i, start = 0;
+
+    for(i = 0; i < n; start = end[i++])
+    {
+        if(strop_parse_dttm_all(buf + start, end[i] - start, df, &f, date + i, NULL, NULL) != end[i] - start) break;
+    }
+
+    if(i < n) error_set(ERROR_INVALID_DATETIME_FORMAT);
+    return i;
+}
+
+uint32 strop_parse_timestamp_batch(const uint8 *buf, const uint32 *end, uint32 n, const strop_dttm_fmt *df, uint64 *ts)
+{
+    strop_dttm_fields f = {.days = STROP_DTTM_NO_DAY};
+    uint32 i, start = 0, microseconds;
+
+    for(i = 0; i < n; start = end[i++])
+    {
+        if(strop_parse_dttm_all(buf + start, end[i] - start, df, &f, ts + i, &microseconds, NULL) != end[i] - start) break;
+        ts[i] = ts[i] * 1000000 + microseconds;
+    }
+
+    if(i < n) error_set(ERROR_INVALID_DATETIME_FORMAT);
+    return i;
+}
+
+uint32 strop_parse_timestamp_with_tz_batch(const uint8 *buf, const uint32 *end, uint32 n, const strop_dttm_fmt *df, uint64 *ts, sint16 *tz)
+{
+    strop_dttm_fields f = {.days = STROP_DTTM_NO_DAY};
+    uint32 i, start = 0, microseconds;
+
+    for(i = 0; i < n; start = end[i++])
+    {
+        if(strop_parse_dttm_all(buf + start, end[i] - start, df, &f, ts + i, &microseconds, tz + i) != end[i] - start) break;
+        ts[i] = ts[i] * 1000000 + microseconds;
+    }
+
+    if(i < n) error_set(ERROR_INVALID_DATETIME_FORMAT);
+    return i;
+}
+
+uint64 strop_len(const uint8 *str, uint64 sz)
+{
+    return encoding_count(g_strop_state.enc, str, sz);
+}
+
+/*
 // compare two strings
 // return an -1, 0, 1 if, respectively, str1 < str2, str1 == str2, str1 > str2
 sint8 strop_cmp(const uint8 *str1, const uint8 *str2)
@@ -364,14 +855,13 @@ sint8 strop_cmp(const uint8 *str1, const uint8 *str2)
 }
 */
 
-// format decimal value according to fmt and put result to buf + start
+// compile decimal format fmt to df
 // return 0 on success, non-0 on error
-// start value will be updated to point after formatted number
 // format:
 //   d - decimal digit
 //   s - decimal separator
 //   e - exponent
-sint8 strop_fmt_decimal(uint8 *buf, uint32 *start, uint32 sz, const achar* fmt, decimal *d)
+sint8 strop_decimal_fmt_compile(const achar* fmt, strop_decimal_fmt *df)
 {
     sint32 n = 0, m = 0;
     sint8 finished = 0, state = 0;
@@ -432,119 +922,139 @@ sint8 strop_fmt_decimal(uint8 *buf, uint32 *start, uint32 sz, const achar* fmt,
         }
     }
 
-    return strop_fmt_decimal_pse(buf, start, sz, n + m, m, (state == 2 ? 1 : 0), d);
+    df->precision = (uint8)(n + m);
+    df->scale = (uint8)m;
+    df->exp = (state == 2 ? 1 : 0);
+
+    return 0;
+}
+
+// format decimal value according to fmt and put result to buf + start
+// return 0 on success, non-0 on error
+// start value will be updated to point after formatted number
+// format:
+//   d - decimal digit
+//   s - decimal separator
+//   e - exponent
+sint8 strop_fmt_decimal(uint8 *buf, uint32 *start, uint32 sz, const achar* fmt, decimal *d)
+{
+    strop_decimal_fmt df;
+
+    if(0 != strop_decimal_fmt_compile(fmt, &df)) return 1;
+
+    return strop_fmt_decimal_compiled(buf, start, sz, &df, d);
 }
 
 sint8 strop_fmt_decimal_pse(uint8 *buf, uint32 *start, uint32 sz, uint8 precision, uint8 scale, uint8 exp, decimal *d)
 {
+    strop_decimal_fmt df = {.precision = precision, .scale = scale, .exp = exp};
+
+    return strop_fmt_decimal_compiled(buf, start, sz, &df, d);
+}
+
+// put cnt zero digits to buf
+// return 0 on success, non-0 on buffer overflow
+inline sint8 strop_put_zeroes(uint8 *buf, uint32 *ptr, uint32 sz, sint32 cnt)
+{
+    if(sz - (*ptr) < (uint32)cnt) return 1; // buf overflow
+    memset(buf + (*ptr), g_strop_state.digit_pairs[0], cnt);
+    (*ptr) += cnt;
+    return 0;
+}
+
+// put digits of mantissa of d to digits, the most significant first, a limb at a time
+// return pointer to the most significant digit, digits after the least significant one are to be filled by caller
+inline uint8 *strop_decimal_to_digits(const decimal *d, uint8 *digits)
+{
+    sint32 i, top = (d->n - 1) / DECIMAL_BASE_LOG10;
+    uint32 hi, lo;
+    uint8 *p = digits;
+
+    for(i = top; i >= 0; i--, p += DECIMAL_BASE_LOG10)
+    {
+        hi = (uint32)(d->m[i] / 100) * 2;
+        lo = (uint32)(d->m[i] % 100) * 2;
+        p[0] = g_strop_state.digit_pairs[hi];
+        p[1] = g_strop_state.digit_pairs[hi + 1];
+        p[2] = g_strop_state.digit_pairs[lo];
+        p[3] = g_strop_state.digit_pairs[lo + 1];
+    }
+
+    return p - d->n;
+}
+
+// format decimal value according to compiled format df and put result to buf + start
+// return 0 on success, non-0 on error
+// start value will be updated to point after formatted number
+sint8 strop_fmt_decimal_compiled(uint8 *buf, uint32 *start, uint32 sz, const strop_decimal_fmt *df, const decimal *d)
+{
+    // digits of mantissa followed by zeroes up to precision
+    uint8 digits[STROP_DECIMAL_DIGITS];
+    uint8 *src;
     uint32 ptr = (*start);
-    sint32 p, k, n = precision - scale, m = scale;
-    sint32 i, digit, e;
-    char_info *sign;
+    sint32 n = df->precision - df->scale, m = df->scale;
+    sint32 e = 0, whole, len;
 
     if(d->n > 0)
     {
-        // we go through the digits starting from the most significant one, down to less significant
-        // and put separator/exponent where we need to
+        whole = d->n + d->e;
 
-        i = (d->n - 1) / DECIMAL_BASE_LOG10;
-        k = d->m[i];
-        p = 1;
-        while(k / p >= 10) p *= 10;
-
-        if(n >= (d->n + d->e) || exp > 0)
+        if(n >= whole || df->exp > 0)
         {
             // sign
-            if(d->sign == DECIMAL_SIGN_NEG)
-            {
-                if(sz - ptr < g_strop_state.sign_minus.length) return 1; // buf overflow
-                memcpy(buf + ptr, g_strop_state.sign_minus.chr, g_strop_state.sign_minus.length);
-                ptr += g_strop_state.sign_minus.length;
-            }
-            else
-            {
-                if(sz - ptr < g_strop_state.space.length) return 1; // buf overflow
-                memcpy(buf + ptr, g_strop_state.space.chr, g_strop_state.space.length);
-                ptr += g_strop_state.space.length;
-            }
+            if(0 != strop_put_char(buf, &ptr, sz, d->sign == DECIMAL_SIGN_NEG ? &g_strop_state.sign_minus : &g_strop_state.space)) return 1;
 
-            if(exp > 0)
+            if(df->exp > 0)
             {
-                e = d->n + d->e - n;
+                e = whole - n;
             }
             else
             {
-                if(n > 0 && d->n + d->e <= 0)
+                if(n > 0 && whole <= 0)
                 {
                     // d < 1 and whole part requested
-                    if(sz - ptr < g_strop_state.digits[0].length) return 1; // buf overflow
-                    memcpy(buf + ptr, g_strop_state.digits[0].chr, g_strop_state.digits[0].length);
-                    ptr += g_strop_state.digits[0].length;
+                    if(0 != strop_put_char(buf, &ptr, sz, &g_strop_state.digits[0])) return 1;
                 }
 
-                n = (d->n + d->e);
+                n = whole;
             }
 
-            do
+            src = strop_decimal_to_digits(d, digits);
+            len = (n > 0 ? n : 0) + m;
+            if(len > d->n)
             {
-                while(n > 0)
-                {
-                    if(i >= 0)
-                    {
-                        digit = (d->m[i] / p) % 10;
-                        p /= 10;
-                        if(p == 0)
-                        {
-                            i--;
-                            p = DECIMAL_BASE / 10;
-                        }
-                    }
-                    else
-                    {
-                        digit = 0;
-                    }
-
-                    if(sz - ptr < g_strop_state.digits[digit].length) return 1; // buf overflow
-                    memcpy(buf + ptr, g_strop_state.digits[digit].chr, g_strop_state.digits[digit].length);
-                    ptr += g_strop_state.digits[digit].length;
-
-                    n--;
-                }
+                memset(src + d->n, g_strop_state.digit_pairs[0], len - d->n);
+            }
 
-                if(m > 0)
-                {
-                    if(sz - ptr < g_strop_state.decimal_separator.length) return 1; // buf overflow
-                    memcpy(buf + ptr, g_strop_state.decimal_separator.chr, g_strop_state.decimal_separator.length);
-                    ptr += g_strop_state.decimal_separator.length;
-
-                    // note "n = (d->n + d->e);" above can produce negative n
-                    while(n < 0 && m > 0)
-                    {
-                        // d < 1 and whole part requested
-                        if(sz - ptr < g_strop_state.digits[0].length) return 1; // buf overflow
-                        memcpy(buf + ptr, g_strop_state.digits[0].chr, g_strop_state.digits[0].length);
-                        ptr += g_strop_state.digits[0].length;
-                        n++;
-                        m--;
-                    }
-
-                    n = m;
-                    m = 0;
-                }
+            if(n > 0)
+            {
+                if(sz - ptr < (uint32)n) return 1; // buf overflow
+                memcpy(buf + ptr, src, n);
+                ptr += n;
+                src += n;
             }
-            while(n > 0);
 
-            if(exp > 0)
+            if(m > 0)
             {
-                if(sz - ptr < g_strop_state.fmt_letter_e.length) return 1; // buf overflow
-                memcpy(buf + ptr, g_strop_state.fmt_letter_e.chr, g_strop_state.fmt_letter_e.length);
-                ptr += g_strop_state.fmt_letter_e.length;
+                if(0 != strop_put_char(buf, &ptr, sz, &g_strop_state.decimal_separator)) return 1;
+
+                // d < 1: zeroes after separator
+                if(n < 0)
+                {
+                    len = -n < m ? -n : m;
+                    if(0 != strop_put_zeroes(buf, &ptr, sz, len)) return 1;
+                    m -= len;
+                }
 
-                sign = (e >= 0) ? &g_strop_state.sign_plus : &g_strop_state.sign_minus;
-                if(sz - ptr < sign->length) return 1; // buf overflow
-                memcpy(buf + ptr, sign->chr, sign->length);
-                ptr += sign->length;
+                if(sz - ptr < (uint32)m) return 1; // buf overflow
+                memcpy(buf + ptr, src, m);
+                ptr += m;
+            }
 
+            if(df->exp > 0)
+            {
+                if(0 != strop_put_char(buf, &ptr, sz, &g_strop_state.fmt_letter_e)) return 1;
+                if(0 != strop_put_char(buf, &ptr, sz, e >= 0 ? &g_strop_state.sign_plus : &g_strop_state.sign_minus)) return 1;
                 if(0 != strop_fmt_uint64(buf, &ptr, sz, (uint64)(e >= 0 ? e : -e))) return 1;
             }
         }
@@ -552,9 +1062,7 @@ sint8 strop_fmt_decimal_pse(uint8 *buf, uint32 *start, uint32 sz, uint8 precisio
         {
             // format requested less significant number than decimal contains
             // we can't print that without loosing data
-            if(sz - ptr < g_strop_state.question_mark.length) return 1; // buf overflow
-            memcpy(buf + ptr, g_strop_state.question_mark.chr, g_strop_state.question_mark.length);
-            ptr += g_strop_state.question_mark.length;
+            if(0 != strop_put_char(buf, &ptr, sz, &g_strop_state.question_mark)) return 1;
         }
     }
     else
@@ -562,41 +1070,21 @@ sint8 strop_fmt_decimal_pse(uint8 *buf, uint32 *start, uint32 sz, uint8 precisio
         // format zero
         if(n > 0)
         {
-            if(sz - ptr < g_strop_state.digits[0].length) return 1; // buf overflow
-            memcpy(buf + ptr, g_strop_state.digits[0].chr, g_strop_state.digits[0].length);
-            ptr += g_strop_state.digits[0].length;
+            if(0 != strop_put_char(buf, &ptr, sz, &g_strop_state.digits[0])) return 1;
         }
 
         if(m > 0)
         {
-            if(sz - ptr < g_strop_state.decimal_separator.length) return 1; // buf overflow
-            memcpy(buf + ptr, g_strop_state.decimal_separator.chr, g_strop_state.decimal_separator.length);
-            ptr += g_strop_state.decimal_separator.length;
-
-            if(sz - ptr < (uint32)m * g_strop_state.digits[0].length) return 1; // buf overflow
-
-            do
-            {
-                memcpy(buf + ptr, g_strop_state.digits[0].chr, g_strop_state.digits[0].length);
-                ptr += g_strop_state.digits[0].length;
-                m--;
-            }
-            while(m > 0);
+            if(0 != strop_put_char(buf, &ptr, sz, &g_strop_state.decimal_separator)) return 1;
+            if(0 != strop_put_zeroes(buf, &ptr, sz, m)) return 1;
         }
 
-        if(exp > 0)
+        if(df->exp > 0)
         {
             // add exponent
-            if(sz - ptr < (uint32)g_strop_state.digits[0].length + (uint32)g_strop_state.fmt_letter_e.length + (uint32)g_strop_state.sign_plus.length) return 1; // buf overflow
-
-            memcpy(buf + ptr, g_strop_state.fmt_letter_e.chr, g_strop_state.fmt_letter_e.length);
-            ptr += g_strop_state.fmt_letter_e.length;
-
-            memcpy(buf + ptr, g_strop_state.sign_plus.chr, g_strop_state.sign_plus.length);
-            ptr += g_strop_state.sign_plus.length;
-
-            memcpy(buf + ptr, g_strop_state.digits[0].chr, g_strop_state.digits[0].length);
-            ptr += g_strop_state.digits[0].length;
+            if(0 != strop_put_char(buf, &ptr, sz, &g_strop_state.fmt_letter_e)) return 1;
+            if(0 != strop_put_char(buf, &ptr, sz, &g_strop_state.sign_plus)) return 1;
+            if(0 != strop_put_char(buf, &ptr, sz, &g_strop_state.digits[0])) return 1;
         }
     }
 
@@ -619,3 +1107,70 @@ sint8 strop_fmt_timestamp_with_tz(uint8 *buf, uint32 *start, uint32 sz, const ac
     return strop_fmt_dttm_all(buf, start, sz, fmt, ts/1000000, ts%1000000, tz);
 }
 
+sint8 strop_fmt_date_compiled(uint8 *buf, uint32 *start, uint32 sz, const strop_dttm_fmt *df, uint64 date)
+{
+    strop_dttm_fields f = {.days = STROP_DTTM_NO_DAY};
+
+    strop_dttm_fields_get(df, date, &f);
+    return strop_fmt_dttm_fields(buf, start, sz, df, &f, date, 0, 0);
+}
+
+sint8 strop_fmt_timestamp_compiled(uint8 *buf, uint32 *start, uint32 sz, const strop_dttm_fmt *df, uint64 ts)
+{
+    return strop_fmt_timestamp_with_tz_compiled(buf, start, sz, df, ts, 0);
+}
+
+sint8 strop_fmt_timestamp_with_tz_compiled(uint8 *buf, uint32 *start, uint32 sz, const strop_dttm_fmt *df, uint64 ts, sint16 tz)
+{
+    strop_dttm_fields f = {.days = STROP_DTTM_NO_DAY};
+
+    strop_dttm_fields_get(df, ts / 1000000, &f);
+    return strop_fmt_dttm_fields(buf, start, sz, df, &f, ts / 1000000, ts % 1000000, tz);
+}
+
+// the calendar breakdown is kept while values fall on the same day, which is typical for sorted or clustered columns
+uint32 strop_fmt_date_batch(uint8 *buf, uint32 *start, uint32 sz, const strop_dttm_fmt *df, const uint64 *date, uint32 n, uint32 *end)
+{
+    strop_dttm_fields f = {.days = STROP_DTTM_NO_DAY};
+    uint32 i;
+
+    for(i = 0; i < n; i++)
+    {
+        strop_dttm_fields_get(df, date[i], &f);
+        if(0 != strop_fmt_dttm_fields(buf, start, sz, df, &f, date[i], 0, 0)) break;
+        end[i] = (*start);
+    }
+
+    return i;
+}
+
+uint32 strop_fmt_timestamp_batch(uint8 *buf, uint32 *start, uint32 sz, const strop_dttm_fmt *df, const uint64 *ts, uint32 n, uint32 *end)
+{
+    strop_dttm_fields f = {.days = STROP_DTTM_NO_DAY};
+    uint32 i;
+
+    for(i = 0; i < n; i++)
+    {
+        strop_dttm_fields_get(df, ts[i] / 1000000, &f);
+        if(0 != strop_fmt_dttm_fields(buf, start, sz, df, &f, ts[i] / 1000000, ts[i] % 1000000, 0)) break;
+        end[i] = (*start);
+    }
+
+    return i;
+}
+
+uint32 strop_fmt_timestamp_with_tz_batch(uint8 *buf, uint32 *start, uint32 sz, const strop_dttm_fmt *df, const uint64 *ts, const sint16 *tz, uint32 n, uint32 *end)
+{
+    strop_dttm_fields f = {.days = STROP_DTTM_NO_DAY};
+    uint32 i;
+
+    for(i = 0; i < n; i++)
+    {
+        strop_dttm_fields_get(df, ts[i] / 1000000, &f);
+        if(0 != strop_fmt_dttm_fields(buf, start, sz, df, &f, ts[i] / 1000000, ts[i] % 1000000, tz[i])) break;
+        end[i] = (*start);
+    }
+
+    return i;
+}
+
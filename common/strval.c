@@ -0,0 +1,280 @@
+#include "common/strval.h"
+#include "common/string_literal.h"
+#include "common/error.h"
+#include <stdlib.h>
+#include <string.h>
+#include <endian.h>
+
+
+#define STRVAL_HASH_MUL1    (0xBF58476D1CE4E5B9UL)
+#define STRVAL_HASH_MUL2    (0x94D049BB133111EBUL)
+
+
+// reference-counted buffer of long string
+typedef struct _strval_buf
+{
+    uint32 refs;
+    uint8 data[];
+} strval_buf;
+
+
+// interning dictionary, values are followed by hash slots and storage of long strings
+typedef struct _strval_dict_state
+{
+    uint32 n;               // maximum number of strings
+    uint32 used;
+    uint32 mask;            // number of slots - 1
+    uint32 storage_sz;
+    uint32 storage_used;
+    strval *values;
+    uint32 *slots;          // index of value + 1, 0 if slot is empty
+    uint8 *storage;
+} strval_dict_state;
+
+
+// return hash of str of len bytes, 8 bytes are mixed at a time
+uint32 strval_hash_buf(const uint8 *str, uint32 len)
+{
+    uint64 h = 0x9E3779B97F4A7C15UL ^ len, w;
+
+    for(; len >= 8; len -= 8, str += 8)
+    {
+        memcpy(&w, str, 8);
+        h = (h ^ w) * STRVAL_HASH_MUL1;
+        h ^= h >> 31;
+    }
+
+    if(len > 0)
+    {
+        w = 0;
+        memcpy(&w, str, len);
+        h = (h ^ w) * STRVAL_HASH_MUL1;
+        h ^= h >> 31;
+    }
+
+    h *= STRVAL_HASH_MUL2;
+    return (uint32)(h ^ (h >> 32));
+}
+
+
+// set fields of value v of str of len bytes with hash, long string is referenced by ptr owned by buf
+void strval_set(strval *v, const uint8 *str, uint32 len, uint32 hash, const uint8 *ptr, strval_buf *buf)
+{
+    v->len = len;
+    v->hash = hash;
+
+    if(len <= STRVAL_INLINE_SZ)
+    {
+        memset(v->data, 0, STRVAL_INLINE_SZ);
+        memcpy(v->data, str, len);
+    }
+    else
+    {
+        memcpy(v->prefix, str, STRVAL_PREFIX_SZ);
+        v->ptr = ptr;
+        v->buf = buf;
+    }
+}
+
+
+sint8 strval_from_buf(strval *v, const uint8 *str, uint32 len)
+{
+    strval_buf *buf = NULL;
+
+    if(len > STRVAL_INLINE_SZ)
+    {
+        if((buf = (strval_buf *)malloc(sizeof(strval_buf) + len)) == NULL)
+        {
+            error_set(ERROR_OUT_OF_MEMORY);
+            return 1;
+        }
+
+        buf->refs = 1;
+        memcpy(buf->data, str, len);
+    }
+
+    strval_set(v, str, len, strval_hash_buf(str, len), (NULL == buf) ? NULL : buf->data, buf);
+    return 0;
+}
+
+
+void strval_from_ref(strval *v, const uint8 *str, uint32 len)
+{
+    strval_set(v, str, len, strval_hash_buf(str, len), str, NULL);
+}
+
+
+sint8 strval_from_literal(strval *v, handle sl)
+{
+    uint8 data[STRVAL_INLINE_SZ];
+    strval_buf *buf;
+    uint64 len, rd;
+
+    if(string_literal_byte_length(sl, &len) != 0) return 1;
+    if(len > 0xFFFFFFFFUL)
+    {
+        error_set(ERROR_OUT_OF_MEMORY);
+        return 1;
+    }
+
+    if(len <= STRVAL_INLINE_SZ)
+    {
+        rd = len;
+        if(string_literal_read(sl, data, &rd) != 0) return 1;
+        strval_set(v, data, (uint32)len, strval_hash_buf(data, (uint32)len), NULL, NULL);
+        return 0;
+    }
+
+    if((buf = (strval_buf *)malloc(sizeof(strval_buf) + len)) == NULL)
+    {
+        error_set(ERROR_OUT_OF_MEMORY);
+        return 1;
+    }
+
+    rd = len;
+    if(string_literal_read(sl, buf->data, &rd) != 0)
+    {
+        free(buf);
+        return 1;
+    }
+
+    buf->refs = 1;
+    strval_set(v, buf->data, (uint32)len, strval_hash_buf(buf->data, (uint32)len), buf->data, buf);
+    return 0;
+}
+
+
+void strval_copy(strval *dst, const strval *src)
+{
+    *dst = *src;
+    if(src->len > STRVAL_INLINE_SZ && NULL != src->buf) ((strval_buf *)src->buf)->refs++;
+}
+
+
+void strval_release(strval *v)
+{
+    if(v->len > STRVAL_INLINE_SZ && NULL != v->buf && 0 == --((strval_buf *)v->buf)->refs) free(v->buf);
+    v->len = 0;
+    v->hash = strval_hash_buf(NULL, 0);
+    memset(v->data, 0, STRVAL_INLINE_SZ);
+}
+
+
+const uint8 *strval_data(const strval *v)
+{
+    return (v->len <= STRVAL_INLINE_SZ) ? v->data : v->ptr;
+}
+
+
+uint8 strval_eq(const strval *a, const strval *b)
+{
+    if(a->len != b->len || a->hash != b->hash) return 0;
+    if(a->len <= STRVAL_INLINE_SZ) return 0 == memcmp(a->data, b->data, STRVAL_INLINE_SZ);
+    return a->ptr == b->ptr || 0 == memcmp(a->ptr, b->ptr, a->len);
+}
+
+
+sint8 strval_cmp(const strval *a, const strval *b)
+{
+    uint64 pa, pb;
+    uint32 n = (a->len < b->len) ? a->len : b->len;
+    int res;
+
+    // the first bytes of both forms, padding zeroes of short string are less than any byte of the other one
+    memcpy(&pa, a->data, 8);
+    memcpy(&pb, b->data, 8);
+    if(pa != pb) return (be64toh(pa) < be64toh(pb)) ? -1 : 1;
+
+    if(n > STRVAL_PREFIX_SZ)
+    {
+        res = memcmp(strval_data(a) + STRVAL_PREFIX_SZ, strval_data(b) + STRVAL_PREFIX_SZ, n - STRVAL_PREFIX_SZ);
+        if(res != 0) return (res > 0) ? 1 : -1;
+    }
+
+    return (a->len > b->len) ? 1 : ((a->len < b->len) ? -1 : 0);
+}
+
+
+// return number of hash slots for n strings
+uint32 strval_dict_slots(uint32 n)
+{
+    uint32 slots = 2;
+    while(slots < 2 * n) slots <<= 1;
+    return slots;
+}
+
+
+size_t strval_dict_get_alloc_sz(uint32 n, uint32 storage_sz)
+{
+    return sizeof(strval_dict_state) + n * sizeof(strval) + strval_dict_slots(n) * sizeof(uint32) + storage_sz;
+}
+
+
+handle strval_dict_create(void *buf, uint32 n, uint32 storage_sz)
+{
+    strval_dict_state *ds = (strval_dict_state *)buf;
+
+    if(NULL == ds) return NULL;
+
+    ds->n = n;
+    ds->mask = strval_dict_slots(n) - 1;
+    ds->storage_sz = storage_sz;
+    ds->values = (strval *)(ds + 1);
+    ds->slots = (uint32 *)(ds->values + n);
+    ds->storage = (uint8 *)(ds->slots + ds->mask + 1);
+    strval_dict_reset((handle)ds);
+
+    return (handle)ds;
+}
+
+
+sint8 strval_dict_intern(handle dh, const uint8 *str, uint32 len, strval *v)
+{
+    strval_dict_state *ds = (strval_dict_state *)dh;
+    uint32 hash = strval_hash_buf(str, len), i;
+    const uint8 *ptr = NULL;
+    strval *e;
+
+    for(i = hash & ds->mask; 0 != ds->slots[i]; i = (i + 1) & ds->mask)
+    {
+        e = ds->values + ds->slots[i] - 1;
+        if(e->hash == hash && e->len == len && 0 == memcmp(strval_data(e), str, len))
+        {
+            *v = *e;
+            return 0;
+        }
+    }
+
+    if(ds->used == ds->n) return 1;
+
+    if(len > STRVAL_INLINE_SZ)
+    {
+        if(len > ds->storage_sz - ds->storage_used) return 1;
+        ptr = ds->storage + ds->storage_used;
+        memcpy(ds->storage + ds->storage_used, str, len);
+        ds->storage_used += len;
+    }
+
+    e = ds->values + ds->used;
+    strval_set(e, str, len, hash, ptr, NULL);
+    ds->slots[i] = ++ds->used;
+
+    *v = *e;
+    return 0;
+}
+
+
+uint32 strval_dict_size(handle dh)
+{
+    return ((strval_dict_state *)dh)->used;
+}
+
+
+void strval_dict_reset(handle dh)
+{
+    strval_dict_state *ds = (strval_dict_state *)dh;
+
+    ds->used = 0;
+    ds->storage_used = 0;
+    memset(ds->slots, 0, (ds->mask + 1) * sizeof(uint32));
+}
@@ -1,5 +1,6 @@
 #include "config/config.h"
 #include "common/error.h"
+#include "common/fltconv.h"
 #include "logging/logger.h"
 #include <stddef.h>
 #include <stdio.h>
@@ -8,7 +9,7 @@
 #include <assert.h>
 #include <errno.h>
 
-#define CONFIG_ENTRIES_NUM 4
+#define CONFIG_ENTRIES_NUM 8
 
 typedef enum _config_option_type
 {
@@ -32,7 +33,11 @@ config_entry g_config[CONFIG_ENTRIES_NUM] =
     {CONFIG_LOGGING_MODE, _ach("logging_mode"), CONFIG_TYPE_STRING, _ach("warn"), 0L, 0.0},
     {CONFIG_LOG_DIR, _ach("log_dir"), CONFIG_TYPE_STRING, _ach("/var/log/persistence"), 0L, 0.0},
     {CONFIG_LOG_FILE_SIZE_THRESHOLD, _ach("log_file_size_threshold"), CONFIG_TYPE_INT, _ach(""), 1024*1024*10, 0.0},
-    {CONFIG_LISTENER_TCP_PORT, _ach("listener_tcp_port"), CONFIG_TYPE_INT, _ach(""), 3000, 0.0}
+    {CONFIG_LISTENER_TCP_PORT, _ach("listener_tcp_port"), CONFIG_TYPE_INT, _ach(""), 3000, 0.0},
+    {CONFIG_PARSER_MEMORY_BUDGET, _ach("parser_memory_budget"), CONFIG_TYPE_INT, _ach(""), 1024*1024*16, 0.0},
+    {CONFIG_TEMP_DIR, _ach("temp_dir"), CONFIG_TYPE_STRING, _ach("/tmp"), 0L, 0.0},
+    {CONFIG_SCRIPT_ON_ERROR, _ach("script_on_error"), CONFIG_TYPE_STRING, _ach("stop"), 0L, 0.0},
+    {CONFIG_TZ_DIR, _ach("tz_dir"), CONFIG_TYPE_STRING, _ach("/usr/share/zoneinfo"), 0L, 0.0}
 };
 
 /////////////////////////////////////
@@ -79,7 +84,10 @@ sint8 config_set_entry_value(config_option option, achar *str_value, sint32 valu
                 entry->int_value = atol(str_value);
                 break;
             case CONFIG_TYPE_FLOAT:
-                entry->float_value = atof(str_value);
+                if(0 == fltconv_parse_double((const uint8 *)str_value, value_len, &entry->float_value))
+                {
+                    entry->float_value = 0.0;
+                }
                 break;
         }
     }
@@ -181,6 +189,21 @@ sint8 check_config_valid()
         return 1;
     }
 
+    entry = config_get_entry(CONFIG_PARSER_MEMORY_BUDGET);
+    if(entry->int_value < 0)
+    {
+        logger_error(_ach("Value for option %s must be greater than or equal to 0"), entry->option_name);
+        return 1;
+    }
+
+    entry = config_get_entry(CONFIG_SCRIPT_ON_ERROR);
+    if(!(0 == strcmp(entry->str_value, _ach("stop"))
+             || 0 == strcmp(entry->str_value, _ach("continue"))))
+    {
+        logger_error(_ach("Value for option %s must be one of 'stop', 'continue'"), entry->option_name);
+        return 1;
+    }
+
     return 0;
 }
 
@@ -2,14 +2,18 @@
 #include "session/pproto_server.h"
 #include "parser/parser.h"
 #include "parser/lexer.h"
+#include "execution/exproptimize.h"
+#include <stddef.h>
+#include <stdlib.h>
 
 // statement execution depends on statement type
 // select:
 //   1. parser parses input: checks syntax and semantics
 //   2. parser builds AST (long values can be saved on the disk)
-//   3. existence of the objects and access privilages are checked
-//   4. optimizer builds execution plan
-//   5. executor executes statement according to plan: access rows, filters, joins sets,
+//   3. expressions of the statement are optimized once: constants folded, equal subexpressions merged
+//   4. existence of the objects and access privilages are checked
+//   5. optimizer builds execution plan
+//   6. executor executes statement according to plan: access rows, filters, joins sets,
 //      saves intermediate results to disk, and spills resulting rows to client
 // insert:
 //   1. if insert is insert as select (not supported yet) then then the execution is
@@ -24,19 +28,108 @@
 //   similar to update/delete but transaction is commited before statement execution
 
 
+struct
+{
+    uint8       script_on_error;        // default stop-on-error policy of scripts
+    handle      optimizer;              // expression optimizer, created on first use
+} g_execution_state = {PPROTO_SCRIPT_ON_ERROR_STOP, NULL};
+
+
+// set stop-on-error policy used for scripts which do not specify it
+void execution_set_script_on_error(uint8 on_error)
+{
+    g_execution_state.script_on_error = on_error;
+}
+
+
+// prepare parsed statement for execution
+// return 0 on success, -1 on error
+sint8 execution_prepare_statement(parser_ast_stmt *stmt)
+{
+    if(NULL == g_execution_state.optimizer)
+    {
+        void *buf = malloc(exproptimize_get_alloc_sz());
+        g_execution_state.optimizer = exproptimize_create(buf);
+        if(NULL == g_execution_state.optimizer)
+        {
+            free(buf);
+            return -1;
+        }
+    }
+
+    return exproptimize_stmt(g_execution_state.optimizer, stmt) == 0 ? 0 : -1;
+}
+
+
 // execute statement
 sint8 execution_exec_statement(handle lexer)
 {
     uint64 sql_len;
+    sint8 res;
+    parser_ast_stmt *stmt = NULL;
+    parser_interface pi;
+    pi.report_error = pproto_server_send_error;
+
+    if(pproto_server_read_str_begin(&sql_len) != 0) return 1;
+
+    res = parser_parse(&stmt, lexer, pi);
+    if(0 == res) res = execution_prepare_statement(stmt);
+    parser_deallocate_stmt(stmt);
+    if(-1 == res) return 1;
+
+    // syntax error is already reported, the rest of the statement is not needed
+    if(pproto_server_skip_str() != 0) return 1;
+
+    if(0 == res && pproto_server_send_success() != 0) return 1;
+
+    return 0;
+}
+
+
+// execute script: statements are executed one by one and result of each is sent to client,
+// the script is finished with summary of succeeded and failed statements
+sint8 execution_exec_script(handle lexer)
+{
+    uint64 sql_len;
+    uint8 on_error;
+    uint32 succeeded = 0, failed = 0;
+    sint8 res;
     parser_ast_stmt *stmt;
     parser_interface pi;
     pi.report_error = pproto_server_send_error;
 
+    if(pproto_server_read_script_on_error(&on_error) != 0) return 1;
+    if(PPROTO_SCRIPT_ON_ERROR_DEFAULT == on_error) on_error = g_execution_state.script_on_error;
+
     if(pproto_server_read_str_begin(&sql_len) != 0) return 1;
-    if(parser_parse(&stmt, lexer, pi))
+    if(parser_script_begin(lexer, pi) != 0) return 1;
+
+    while(1)
     {
-        return 1;
+        res = parser_script_next(&stmt);
+        if(-1 == res) return 1;
+
+        if(0 == res)
+        {
+            if(NULL == stmt) break;
+
+            res = execution_prepare_statement(stmt);
+            parser_deallocate_stmt(stmt);
+            if(-1 == res) return 1;
+
+            if(pproto_server_send_success() != 0) return 1;
+            succeeded++;
+        }
+        else
+        {
+            // error is already reported by parser
+            failed++;
+            if(PPROTO_SCRIPT_ON_ERROR_STOP == on_error) break;
+        }
     }
-    if(pproto_server_read_str_end() != 0) return 1;
+
+    if(pproto_server_skip_str() != 0) return 1;
+    if(pproto_server_send_script_end(succeeded, failed) != 0) return 1;
+
     return 0;
 }
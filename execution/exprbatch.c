@@ -0,0 +1,1099 @@
+#include "execution/exprbatch.h"
+#include "execution/expression.h"
+#include "common/decimal.h"
+#include "common/error.h"
+#include "common/string_literal.h"
+#include "common/strmatch.h"
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+
+
+#define EXPRBATCH_VECTOR_FREE       (0)     // vector was never used
+#define EXPRBATCH_VECTOR_TAKEN      (1)
+#define EXPRBATCH_VECTOR_RELEASED   (2)     // temporary vector which can be reused by another temporary
+
+#define EXPRBATCH_OP_NARROW         (32)    // step opcode beyond parser_expr_op_type, see exprbatch_step
+#define EXPRBATCH_OP_LIKE           (33)    // a LIKE compiled pattern at offset b of pattern pool
+#define EXPRBATCH_OP_NOT_LIKE       (34)
+
+#define EXPRBATCH_BYTES_TO_BITS     (0x0102040810204080ULL)     // gathers lowest bits of 8 bytes into the top byte
+#define EXPRBATCH_BITS_TO_BYTES     (0x0002040810204081ULL)     // spreads 7 bits into lowest bits of 7 bytes
+#define EXPRBATCH_LOW_BITS          (0x0101010101010101ULL)
+
+#define EXPRBATCH_IS_NUMERIC(t)     ((t) == PARSER_EXPR_NODE_TYPE_INT || (t) == PARSER_EXPR_NODE_TYPE_NUM || (t) == PARSER_EXPR_NODE_TYPE_FLOAT)
+#define EXPRBATCH_IS_LOGICAL(t)     ((t) == PARSER_EXPR_NODE_TYPE_BOOL || (t) == PARSER_EXPR_NODE_TYPE_NULL)
+
+// run statement for every evaluated element i, dense loop is kept free of indirection for vectorization
+#define EXPRBATCH_LOOP(sel, n, ...) \
+    if(NULL == (sel)) \
+    { \
+        for(i = 0; i < (n); i++) { __VA_ARGS__ } \
+    } \
+    else \
+    { \
+        for(k = 0; k < (n); k++) { i = (sel)[k]; __VA_ARGS__ } \
+    }
+
+
+// kernel: d = a <op> b for evaluated elements, sets type and null bitmap of d
+// return 0 on success, non-0 on error
+typedef sint8 (*exprbatch_kernel)(uint8 op, const exprbatch_vector *a, const exprbatch_vector *b,
+                                  exprbatch_vector *d, const uint16 *sel, uint16 n);
+
+
+// step of the program: dst = a <op> b over selection of the level
+// EXPRBATCH_OP_NARROW step selects elements of the level where AND/OR operand a does not decide the result
+// into selection of level + 1, if there are none evaluation continues with step b which combines operands
+typedef struct _exprbatch_step
+{
+    uint8       op;             // parser_expr_op_type or EXPRBATCH_OP_*
+    uint8       level;          // selection the step is evaluated over, 0 is selection passed to evaluation
+    uint8       narrowed;       // AND/OR step whose operand b is evaluated over narrowed selection of level + 1
+    uint16      dst;            // program vector
+    uint16      a;              // program vector or column if EXPRBATCH_COLUMN is set
+    uint16      b;              // program vector or column if EXPRBATCH_COLUMN is set, step index for narrowing,
+                                // pattern offset for LIKE
+} exprbatch_step;
+
+
+// storage of program vector elements
+typedef union _exprbatch_data
+{
+    sint64      integer[EXPRBATCH_SIZE];
+    float64     fp[EXPRBATCH_SIZE];
+    decimal     num[EXPRBATCH_SIZE];
+    void        *str[EXPRBATCH_SIZE];
+    uint8       boolean[EXPRBATCH_SIZE];
+} exprbatch_data;
+
+
+// operation node of expression, node can be referenced several times when equal subexpressions are merged
+typedef struct _exprbatch_node_ref
+{
+    const parser_ast_expr   *node;
+    uint16                  refs;           // references which are not compiled yet
+    uint16                  operand;        // vector holding value of the node once it is compiled
+    uint8                   compiled;
+} exprbatch_node_ref;
+
+
+// compiled program
+typedef struct _exprbatch_program
+{
+    uint16              step_num;
+    uint16              result;                                 // operand holding the result
+    uint16              node_num;                               // compilation only
+    uint8               level;                                  // compilation only: number of enclosing narrowed operands
+    uint32              pattern_used;                           // compilation only: bytes taken in patterns
+    uint8               vector_state[EXPRBATCH_MAX_VECTORS];    // compilation only: one of EXPRBATCH_VECTOR_*
+    exprbatch_node_ref  nodes[EXPRBATCH_MAX_STEPS];             // compilation only: operation nodes of expression
+    exprbatch_step      steps[EXPRBATCH_MAX_STEPS];
+    exprbatch_vector    vectors[EXPRBATCH_MAX_VECTORS];
+    exprbatch_vector    skipped;                                // all-null operand which was not evaluated for any element
+    uint16              sel_n[EXPRBATCH_MAX_LEVELS];            // evaluation only: number of elements of narrowed selections
+    uint16              sels[EXPRBATCH_MAX_LEVELS][EXPRBATCH_SIZE];
+    exprbatch_data      data[EXPRBATCH_MAX_VECTORS];
+    uint64              patterns[EXPRBATCH_PATTERN_POOL_SZ / sizeof(uint64)];  // compiled LIKE patterns
+} exprbatch_program;
+
+
+// return size of the buffer for compiled program
+size_t exprbatch_get_alloc_sz()
+{
+    return sizeof(exprbatch_program);
+}
+
+
+// null bitmap of d is union of null bitmaps of a and b
+void exprbatch_merge_nulls(const exprbatch_vector *a, const exprbatch_vector *b, exprbatch_vector *d)
+{
+    uint16 w;
+
+    for(w = 0; w < EXPRBATCH_NULL_WORDS; w++)
+    {
+        d->nulls[w] = a->nulls[w] | b->nulls[w];
+    }
+}
+
+
+// return decimal value of element i of numeric vector v, integer is converted into buf
+const decimal *exprbatch_num_value(const exprbatch_vector *v, uint16 i, decimal *buf)
+{
+    if(v->type == PARSER_EXPR_NODE_TYPE_INT)
+    {
+        decimal_from_int64(v->integer[i], buf);
+        return buf;
+    }
+
+    return v->num + i;
+}
+
+
+// return floating point value of element i of numeric vector v
+float64 exprbatch_float_value(const exprbatch_vector *v, uint16 i)
+{
+    switch(v->type)
+    {
+        case PARSER_EXPR_NODE_TYPE_INT: return (float64)v->integer[i];
+        case PARSER_EXPR_NODE_TYPE_NUM: return decimal_to_float64(v->num + i);
+        default: return v->fp[i];
+    }
+}
+
+
+// compare element i of numeric vectors a and b, float operand makes comparison float
+// return positive if a > b, negative if a < b, 0 otherwise
+sint16 exprbatch_num_cmp(const exprbatch_vector *a, const exprbatch_vector *b, uint16 i)
+{
+    decimal da, db;
+    float64 fa, fb;
+
+    if(a->type == PARSER_EXPR_NODE_TYPE_FLOAT || b->type == PARSER_EXPR_NODE_TYPE_FLOAT)
+    {
+        fa = exprbatch_float_value(a, i);
+        fb = exprbatch_float_value(b, i);
+        return (fa > fb) - (fa < fb);
+    }
+
+    return decimal_cmp(exprbatch_num_value(a, i, &da), exprbatch_num_value(b, i, &db));
+}
+
+
+// return 1 if comparison result cmp satisfies comparison operator op, 0 otherwise
+uint8 exprbatch_cmp_result(uint8 op, sint32 cmp)
+{
+    switch(op)
+    {
+        case PARSER_EXPR_OP_TYPE_EQ: return cmp == 0;
+        case PARSER_EXPR_OP_TYPE_NE: return cmp != 0;
+        case PARSER_EXPR_OP_TYPE_GT: return cmp > 0;
+        case PARSER_EXPR_OP_TYPE_GE: return cmp >= 0;
+        case PARSER_EXPR_OP_TYPE_LT: return cmp < 0;
+        case PARSER_EXPR_OP_TYPE_LE: return cmp <= 0;
+        default:
+            assert(1 == 0);
+            return 0;
+    }
+}
+
+
+// result of any operation with all-null operand: all elements of d are null
+sint8 exprbatch_null_kernel(uint8 op, const exprbatch_vector *a, const exprbatch_vector *b,
+                            exprbatch_vector *d, const uint16 *sel, uint16 n)
+{
+    (void)op; (void)a; (void)b; (void)sel; (void)n;
+
+    d->type = PARSER_EXPR_NODE_TYPE_NULL;
+    memset(d->nulls, 0xFF, sizeof(d->nulls));
+    return 0;
+}
+
+
+// arithmetic over decimals or mix of decimals and integers, null elements are skipped
+sint8 exprbatch_arith_num(uint8 op, const exprbatch_vector *a, const exprbatch_vector *b,
+                          exprbatch_vector *d, const uint16 *sel, uint16 n)
+{
+    decimal da, db;
+    const decimal *pa, *pb;
+    sint8 res = 0;
+    uint16 i, k;
+
+    exprbatch_merge_nulls(a, b, d);
+    d->type = PARSER_EXPR_NODE_TYPE_NUM;
+
+    EXPRBATCH_LOOP(sel, n,
+        if(EXPRBATCH_IS_NULL(d, i)) continue;
+        pa = exprbatch_num_value(a, i, &da);
+        pb = exprbatch_num_value(b, i, &db);
+        switch(op)
+        {
+            case PARSER_EXPR_OP_TYPE_MUL: res = decimal_mul(pa, pb, d->num + i); break;
+            case PARSER_EXPR_OP_TYPE_DIV: res = decimal_div(pa, pb, d->num + i); break;
+            case PARSER_EXPR_OP_TYPE_ADD: res = decimal_add(pa, pb, d->num + i); break;
+            case PARSER_EXPR_OP_TYPE_SUB: res = decimal_sub(pa, pb, d->num + i); break;
+            default: assert(1 == 0);
+        }
+        if(res != 0) return -1;
+    )
+
+    return 0;
+}
+
+
+// integer arithmetic, whole batch is recalculated in decimal if any element overflows
+#define EXPRBATCH_INT_ARITH_KERNEL(name, builtin) \
+sint8 exprbatch_##name##_int_int(uint8 op, const exprbatch_vector *a, const exprbatch_vector *b, \
+                                 exprbatch_vector *d, const uint16 *sel, uint16 n) \
+{ \
+    const sint64 *x = a->integer, *y = b->integer; \
+    sint64 *z = d->integer; \
+    uint8 overflow = 0; \
+    uint16 i, k; \
+    \
+    EXPRBATCH_LOOP(sel, n, overflow |= builtin(x[i], y[i], z + i);) \
+    \
+    if(overflow) return exprbatch_arith_num(op, a, b, d, sel, n); \
+    \
+    exprbatch_merge_nulls(a, b, d); \
+    d->type = PARSER_EXPR_NODE_TYPE_INT; \
+    return 0; \
+}
+
+EXPRBATCH_INT_ARITH_KERNEL(mul, __builtin_mul_overflow)
+EXPRBATCH_INT_ARITH_KERNEL(add, __builtin_add_overflow)
+EXPRBATCH_INT_ARITH_KERNEL(sub, __builtin_sub_overflow)
+
+
+// float arithmetic over floats or mix of floats and other numbers, null elements are skipped
+sint8 exprbatch_arith_flt(uint8 op, const exprbatch_vector *a, const exprbatch_vector *b,
+                          exprbatch_vector *d, const uint16 *sel, uint16 n)
+{
+    uint16 i, k;
+
+    exprbatch_merge_nulls(a, b, d);
+    d->type = PARSER_EXPR_NODE_TYPE_FLOAT;
+
+    EXPRBATCH_LOOP(sel, n,
+        if(EXPRBATCH_IS_NULL(d, i)) continue;
+        if(expression_float_op(op, exprbatch_float_value(a, i), exprbatch_float_value(b, i), d->fp + i) != 0) return -1;
+    )
+
+    return 0;
+}
+
+
+// float arithmetic, batch is recalculated element by element to report error if any non-null element is not finite
+#define EXPRBATCH_FLT_ARITH_KERNEL(name, oper) \
+sint8 exprbatch_##name##_flt_flt(uint8 op, const exprbatch_vector *a, const exprbatch_vector *b, \
+                                 exprbatch_vector *d, const uint16 *sel, uint16 n) \
+{ \
+    const float64 *x = a->fp, *y = b->fp; \
+    float64 *z = d->fp; \
+    uint8 bad = 0; \
+    uint16 i, k; \
+    \
+    exprbatch_merge_nulls(a, b, d); \
+    EXPRBATCH_LOOP(sel, n, z[i] = x[i] oper y[i]; bad |= (isfinite(z[i]) == 0) & (EXPRBATCH_IS_NULL(d, i) ^ 1);) \
+    \
+    if(bad) return exprbatch_arith_flt(op, a, b, d, sel, n); \
+    \
+    d->type = PARSER_EXPR_NODE_TYPE_FLOAT; \
+    return 0; \
+}
+
+EXPRBATCH_FLT_ARITH_KERNEL(mul, *)
+EXPRBATCH_FLT_ARITH_KERNEL(div, /)
+EXPRBATCH_FLT_ARITH_KERNEL(add, +)
+EXPRBATCH_FLT_ARITH_KERNEL(sub, -)
+
+// kernels indexed by op - PARSER_EXPR_OP_TYPE_MUL
+exprbatch_kernel g_exprbatch_arith_flt_flt[] = {exprbatch_mul_flt_flt, exprbatch_div_flt_flt, exprbatch_add_flt_flt, exprbatch_sub_flt_flt};
+
+
+// comparison of integers
+#define EXPRBATCH_INT_CMP_KERNEL(name, cmp) \
+sint8 exprbatch_##name##_int_int(uint8 op, const exprbatch_vector *a, const exprbatch_vector *b, \
+                                 exprbatch_vector *d, const uint16 *sel, uint16 n) \
+{ \
+    const sint64 *x = a->integer, *y = b->integer; \
+    uint8 *z = d->boolean; \
+    uint16 i, k; \
+    (void)op; \
+    \
+    EXPRBATCH_LOOP(sel, n, z[i] = (x[i] cmp y[i]);) \
+    \
+    exprbatch_merge_nulls(a, b, d); \
+    d->type = PARSER_EXPR_NODE_TYPE_BOOL; \
+    return 0; \
+}
+
+// comparison of decimals, null elements are skipped
+#define EXPRBATCH_NUM_CMP_KERNEL(name, cmp) \
+sint8 exprbatch_##name##_num_num(uint8 op, const exprbatch_vector *a, const exprbatch_vector *b, \
+                                 exprbatch_vector *d, const uint16 *sel, uint16 n) \
+{ \
+    const decimal *x = a->num, *y = b->num; \
+    uint8 *z = d->boolean; \
+    uint16 i, k; \
+    (void)op; \
+    \
+    exprbatch_merge_nulls(a, b, d); \
+    d->type = PARSER_EXPR_NODE_TYPE_BOOL; \
+    \
+    EXPRBATCH_LOOP(sel, n, z[i] = !EXPRBATCH_IS_NULL(d, i) && (decimal_cmp(x + i, y + i) cmp 0);) \
+    return 0; \
+}
+
+// comparison of floats
+#define EXPRBATCH_FLT_CMP_KERNEL(name, cmp) \
+sint8 exprbatch_##name##_flt_flt(uint8 op, const exprbatch_vector *a, const exprbatch_vector *b, \
+                                 exprbatch_vector *d, const uint16 *sel, uint16 n) \
+{ \
+    const float64 *x = a->fp, *y = b->fp; \
+    uint8 *z = d->boolean; \
+    uint16 i, k; \
+    (void)op; \
+    \
+    EXPRBATCH_LOOP(sel, n, z[i] = (x[i] cmp y[i]);) \
+    \
+    exprbatch_merge_nulls(a, b, d); \
+    d->type = PARSER_EXPR_NODE_TYPE_BOOL; \
+    return 0; \
+}
+
+EXPRBATCH_INT_CMP_KERNEL(eq, ==)
+EXPRBATCH_INT_CMP_KERNEL(ne, !=)
+EXPRBATCH_INT_CMP_KERNEL(gt, >)
+EXPRBATCH_INT_CMP_KERNEL(ge, >=)
+EXPRBATCH_INT_CMP_KERNEL(lt, <)
+EXPRBATCH_INT_CMP_KERNEL(le, <=)
+
+EXPRBATCH_NUM_CMP_KERNEL(eq, ==)
+EXPRBATCH_NUM_CMP_KERNEL(ne, !=)
+EXPRBATCH_NUM_CMP_KERNEL(gt, >)
+EXPRBATCH_NUM_CMP_KERNEL(ge, >=)
+EXPRBATCH_NUM_CMP_KERNEL(lt, <)
+EXPRBATCH_NUM_CMP_KERNEL(le, <=)
+
+EXPRBATCH_FLT_CMP_KERNEL(eq, ==)
+EXPRBATCH_FLT_CMP_KERNEL(ne, !=)
+EXPRBATCH_FLT_CMP_KERNEL(gt, >)
+EXPRBATCH_FLT_CMP_KERNEL(ge, >=)
+EXPRBATCH_FLT_CMP_KERNEL(lt, <)
+EXPRBATCH_FLT_CMP_KERNEL(le, <=)
+
+// kernels indexed by op - PARSER_EXPR_OP_TYPE_EQ
+exprbatch_kernel g_exprbatch_cmp_int_int[] = {exprbatch_eq_int_int, exprbatch_ne_int_int, exprbatch_gt_int_int,
+                                              exprbatch_ge_int_int, exprbatch_lt_int_int, exprbatch_le_int_int};
+exprbatch_kernel g_exprbatch_cmp_num_num[] = {exprbatch_eq_num_num, exprbatch_ne_num_num, exprbatch_gt_num_num,
+                                              exprbatch_ge_num_num, exprbatch_lt_num_num, exprbatch_le_num_num};
+exprbatch_kernel g_exprbatch_cmp_flt_flt[] = {exprbatch_eq_flt_flt, exprbatch_ne_flt_flt, exprbatch_gt_flt_flt,
+                                              exprbatch_ge_flt_flt, exprbatch_lt_flt_flt, exprbatch_le_flt_flt};
+
+
+// comparison of mix of numeric types, or of strings, null elements are skipped
+sint8 exprbatch_cmp_generic(uint8 op, const exprbatch_vector *a, const exprbatch_vector *b,
+                            exprbatch_vector *d, const uint16 *sel, uint16 n)
+{
+    sint8 cmp;
+    uint16 i, k;
+
+    exprbatch_merge_nulls(a, b, d);
+    d->type = PARSER_EXPR_NODE_TYPE_BOOL;
+
+    if(a->type == PARSER_EXPR_NODE_TYPE_STR)
+    {
+        EXPRBATCH_LOOP(sel, n,
+            d->boolean[i] = 0;
+            if(EXPRBATCH_IS_NULL(d, i)) continue;
+            if(string_literal_byte_compare(a->str[i], b->str[i], &cmp) != 0) return -1;
+            d->boolean[i] = exprbatch_cmp_result(op, cmp);
+        )
+    }
+    else
+    {
+        EXPRBATCH_LOOP(sel, n,
+            d->boolean[i] = 0;
+            if(EXPRBATCH_IS_NULL(d, i)) continue;
+            d->boolean[i] = exprbatch_cmp_result(op, exprbatch_num_cmp(a, b, i));
+        )
+    }
+
+    return 0;
+}
+
+
+// a IS [NOT] NULL, b is all-null vector
+sint8 exprbatch_is_null(uint8 op, const exprbatch_vector *a, const exprbatch_vector *b,
+                        exprbatch_vector *d, const uint16 *sel, uint16 n)
+{
+    uint8 *z = d->boolean, neg = (op == PARSER_EXPR_OP_TYPE_IS_NOT);
+    uint16 i, k;
+    (void)b;
+
+    EXPRBATCH_LOOP(sel, n, z[i] = EXPRBATCH_IS_NULL(a, i) ^ neg;)
+
+    memset(d->nulls, 0, sizeof(d->nulls));
+    d->type = PARSER_EXPR_NODE_TYPE_BOOL;
+    return 0;
+}
+
+
+// a IS [NOT] b, null is equal to null, values of different types are not equal
+sint8 exprbatch_is_generic(uint8 op, const exprbatch_vector *a, const exprbatch_vector *b,
+                           exprbatch_vector *d, const uint16 *sel, uint16 n)
+{
+    uint8 *z = d->boolean, neg = (op == PARSER_EXPR_OP_TYPE_IS_NOT), na, nb;
+    sint8 cmp;
+    uint16 i, k;
+
+    EXPRBATCH_LOOP(sel, n,
+        na = EXPRBATCH_IS_NULL(a, i);
+        nb = EXPRBATCH_IS_NULL(b, i);
+        if(na || nb)
+        {
+            z[i] = na & nb;
+        }
+        else if(EXPRBATCH_IS_NUMERIC(a->type) && EXPRBATCH_IS_NUMERIC(b->type))
+        {
+            z[i] = (0 == exprbatch_num_cmp(a, b, i));
+        }
+        else if(a->type != b->type)
+        {
+            z[i] = 0;
+        }
+        else if(a->type == PARSER_EXPR_NODE_TYPE_STR)
+        {
+            if(string_literal_byte_compare(a->str[i], b->str[i], &cmp) != 0) return -1;
+            z[i] = (0 == cmp);
+        }
+        else
+        {
+            z[i] = (a->boolean[i] == b->boolean[i]);
+        }
+        z[i] ^= neg;
+    )
+
+    memset(d->nulls, 0, sizeof(d->nulls));
+    d->type = PARSER_EXPR_NODE_TYPE_BOOL;
+    return 0;
+}
+
+
+// NOT a, null stays null
+sint8 exprbatch_not(uint8 op, const exprbatch_vector *a, const exprbatch_vector *b,
+                    exprbatch_vector *d, const uint16 *sel, uint16 n)
+{
+    const uint8 *x = a->boolean;
+    uint8 *z = d->boolean;
+    uint16 i, k;
+    (void)op; (void)b;
+
+    EXPRBATCH_LOOP(sel, n, z[i] = x[i] ^ 1;)
+
+    memcpy(d->nulls, a->nulls, sizeof(d->nulls));
+    d->type = PARSER_EXPR_NODE_TYPE_BOOL;
+    return 0;
+}
+
+
+// a [NOT] LIKE compiled pattern mh, null elements are skipped
+// return 0 on success, non-0 on error
+sint8 exprbatch_like(handle mh, uint8 negate, const exprbatch_vector *a, exprbatch_vector *d, const uint16 *sel, uint16 n)
+{
+    uint8 *z = d->boolean;
+    uint16 i, k;
+
+    if(a->type == PARSER_EXPR_NODE_TYPE_NULL) return exprbatch_null_kernel(0, a, a, d, sel, n);
+    if(a->type != PARSER_EXPR_NODE_TYPE_STR)
+    {
+        error_set(ERROR_DATATYPE_MISMATCH);
+        return -1;
+    }
+
+    memcpy(d->nulls, a->nulls, sizeof(d->nulls));
+    d->type = PARSER_EXPR_NODE_TYPE_BOOL;
+
+    EXPRBATCH_LOOP(sel, n,
+        if(EXPRBATCH_IS_NULL(a, i)) continue;
+        if(strmatch_match_literal(mh, a->str[i], z + i) != 0) return -1;
+        z[i] ^= negate;
+    )
+
+    return 0;
+}
+
+
+// convert boolean vector v into true and false bitmaps, null elements are in neither of them
+// only first words of bitmaps are converted, all-null vector gives empty bitmaps
+void exprbatch_bool_to_bitmap(const exprbatch_vector *v, uint16 words, exprbatch_bool_bitmap *bm)
+{
+    uint64 bytes, bits;
+    uint16 w, j;
+
+    if(v->type == PARSER_EXPR_NODE_TYPE_NULL)
+    {
+        memset(bm->true_bits, 0, words * sizeof(uint64));
+        memset(bm->false_bits, 0, words * sizeof(uint64));
+        return;
+    }
+
+    for(w = 0; w < words; w++)
+    {
+        bits = 0;
+        for(j = 0; j < 8; j++)
+        {
+            memcpy(&bytes, v->boolean + (w << 6) + (j << 3), sizeof(bytes));
+            bits |= (((bytes & EXPRBATCH_LOW_BITS) * EXPRBATCH_BYTES_TO_BITS) >> 56) << (j << 3);
+        }
+        bm->true_bits[w] = bits & ~v->nulls[w];
+        bm->false_bits[w] = ~bits & ~v->nulls[w];
+    }
+}
+
+
+// convert first words of true and false bitmaps bm into boolean vector v, element which is neither true nor false is null
+void exprbatch_bitmap_to_bool(const exprbatch_bool_bitmap *bm, exprbatch_vector *v, uint16 words)
+{
+    uint64 bytes, bits;
+    uint16 w, j;
+
+    for(w = 0; w < words; w++)
+    {
+        bits = bm->true_bits[w];
+        for(j = 0; j < 8; j++, bits >>= 8)
+        {
+            bytes = (((bits & 0x7f) * EXPRBATCH_BITS_TO_BYTES) & EXPRBATCH_LOW_BITS) | (((bits >> 7) & 1) << 56);
+            memcpy(v->boolean + (w << 6) + (j << 3), &bytes, sizeof(bytes));
+        }
+        v->nulls[w] = ~(bm->true_bits[w] | bm->false_bits[w]);
+    }
+
+    v->type = PARSER_EXPR_NODE_TYPE_BOOL;
+}
+
+
+// a = a AND b over first words: true if both are true, false if any is false, otherwise null
+void exprbatch_bitmap_and(exprbatch_bool_bitmap *a, const exprbatch_bool_bitmap *b, uint16 words)
+{
+    uint16 w;
+
+    for(w = 0; w < words; w++)
+    {
+        a->true_bits[w] &= b->true_bits[w];
+        a->false_bits[w] |= b->false_bits[w];
+    }
+}
+
+
+// a = a OR b over first words: true if any is true, false if both are false, otherwise null
+void exprbatch_bitmap_or(exprbatch_bool_bitmap *a, const exprbatch_bool_bitmap *b, uint16 words)
+{
+    uint16 w;
+
+    for(w = 0; w < words; w++)
+    {
+        a->true_bits[w] |= b->true_bits[w];
+        a->false_bits[w] &= b->false_bits[w];
+    }
+}
+
+
+// a AND b, a OR b: false AND null is false, true OR null is true, otherwise null operand gives null
+// operands are combined as bitmaps 64 elements at a time, words past the last evaluated element are skipped
+sint8 exprbatch_and_or(uint8 op, const exprbatch_vector *a, const exprbatch_vector *b,
+                       exprbatch_vector *d, const uint16 *sel, uint16 n)
+{
+    exprbatch_bool_bitmap ba, bb;
+    uint16 words = (n == 0) ? 0 : (NULL == sel ? (n + 63) >> 6 : (sel[n - 1] >> 6) + 1);
+
+    exprbatch_bool_to_bitmap(a, words, &ba);
+    exprbatch_bool_to_bitmap(b, words, &bb);
+
+    if(op == PARSER_EXPR_OP_TYPE_AND)
+    {
+        exprbatch_bitmap_and(&ba, &bb, words);
+    }
+    else
+    {
+        exprbatch_bitmap_or(&ba, &bb, words);
+    }
+
+    exprbatch_bitmap_to_bool(&ba, d, words);
+    return 0;
+}
+
+
+// choose kernel for operation op over vectors of types ta and tb
+// return kernel or NULL if types are not compatible with operation
+exprbatch_kernel exprbatch_kernel_lookup(uint8 op, parser_expr_node_type ta, parser_expr_node_type tb)
+{
+    uint8 arg_null = (ta == PARSER_EXPR_NODE_TYPE_NULL || tb == PARSER_EXPR_NODE_TYPE_NULL);
+
+    switch(op)
+    {
+        case PARSER_EXPR_OP_TYPE_MUL:
+        case PARSER_EXPR_OP_TYPE_DIV:
+        case PARSER_EXPR_OP_TYPE_ADD:
+        case PARSER_EXPR_OP_TYPE_SUB:
+            if(arg_null) return exprbatch_null_kernel;
+            if(ta == PARSER_EXPR_NODE_TYPE_FLOAT && tb == PARSER_EXPR_NODE_TYPE_FLOAT) return g_exprbatch_arith_flt_flt[op - PARSER_EXPR_OP_TYPE_MUL];
+            if((ta == PARSER_EXPR_NODE_TYPE_FLOAT || tb == PARSER_EXPR_NODE_TYPE_FLOAT) && EXPRBATCH_IS_NUMERIC(ta) && EXPRBATCH_IS_NUMERIC(tb)) return exprbatch_arith_flt;
+            if(ta == PARSER_EXPR_NODE_TYPE_INT && tb == PARSER_EXPR_NODE_TYPE_INT)
+            {
+                switch(op)
+                {
+                    case PARSER_EXPR_OP_TYPE_MUL: return exprbatch_mul_int_int;
+                    case PARSER_EXPR_OP_TYPE_ADD: return exprbatch_add_int_int;
+                    case PARSER_EXPR_OP_TYPE_SUB: return exprbatch_sub_int_int;
+                    default: return exprbatch_arith_num;    // division result is decimal
+                }
+            }
+            if(EXPRBATCH_IS_NUMERIC(ta) && EXPRBATCH_IS_NUMERIC(tb)) return exprbatch_arith_num;
+            return NULL;
+
+        case PARSER_EXPR_OP_TYPE_EQ:
+        case PARSER_EXPR_OP_TYPE_NE:
+        case PARSER_EXPR_OP_TYPE_GT:
+        case PARSER_EXPR_OP_TYPE_GE:
+        case PARSER_EXPR_OP_TYPE_LT:
+        case PARSER_EXPR_OP_TYPE_LE:
+            if(arg_null) return exprbatch_null_kernel;
+            if(ta == PARSER_EXPR_NODE_TYPE_INT && tb == PARSER_EXPR_NODE_TYPE_INT) return g_exprbatch_cmp_int_int[op - PARSER_EXPR_OP_TYPE_EQ];
+            if(ta == PARSER_EXPR_NODE_TYPE_NUM && tb == PARSER_EXPR_NODE_TYPE_NUM) return g_exprbatch_cmp_num_num[op - PARSER_EXPR_OP_TYPE_EQ];
+            if(ta == PARSER_EXPR_NODE_TYPE_FLOAT && tb == PARSER_EXPR_NODE_TYPE_FLOAT) return g_exprbatch_cmp_flt_flt[op - PARSER_EXPR_OP_TYPE_EQ];
+            if(EXPRBATCH_IS_NUMERIC(ta) && EXPRBATCH_IS_NUMERIC(tb)) return exprbatch_cmp_generic;
+            if(ta == PARSER_EXPR_NODE_TYPE_STR && tb == PARSER_EXPR_NODE_TYPE_STR) return exprbatch_cmp_generic;
+            return NULL;
+
+        case PARSER_EXPR_OP_TYPE_IS:
+        case PARSER_EXPR_OP_TYPE_IS_NOT:
+            if(tb == PARSER_EXPR_NODE_TYPE_NULL) return exprbatch_is_null;
+            return exprbatch_is_generic;
+
+        case PARSER_EXPR_OP_TYPE_NOT:
+            if(ta == PARSER_EXPR_NODE_TYPE_NULL) return exprbatch_null_kernel;
+            if(ta == PARSER_EXPR_NODE_TYPE_BOOL) return exprbatch_not;
+            return NULL;
+
+        case PARSER_EXPR_OP_TYPE_LIKE:
+        case PARSER_EXPR_OP_TYPE_NOT_LIKE:
+            // string operand is matched by EXPRBATCH_OP_LIKE step, this one is left for null pattern
+            if(arg_null) return exprbatch_null_kernel;
+            return NULL;
+
+        case PARSER_EXPR_OP_TYPE_AND:
+        case PARSER_EXPR_OP_TYPE_OR:
+            if(ta == PARSER_EXPR_NODE_TYPE_NULL && tb == PARSER_EXPR_NODE_TYPE_NULL) return exprbatch_null_kernel;
+            if(EXPRBATCH_IS_LOGICAL(ta) && EXPRBATCH_IS_LOGICAL(tb)) return exprbatch_and_or;
+            return NULL;
+
+        default:
+            return NULL;
+    }
+}
+
+
+// take program vector, constant can not reuse released temporary vector because temporaries are overwritten on evaluation
+// return 0 on success, non-0 if there are no free vectors
+sint8 exprbatch_alloc_vector(exprbatch_program *p, uint16 *vec, uint8 constant)
+{
+    uint16 v;
+
+    for(v = 0; v < EXPRBATCH_MAX_VECTORS; v++)
+    {
+        if(p->vector_state[v] == EXPRBATCH_VECTOR_FREE || (!constant && p->vector_state[v] == EXPRBATCH_VECTOR_RELEASED))
+        {
+            p->vector_state[v] = EXPRBATCH_VECTOR_TAKEN;
+            *vec = v;
+            return 0;
+        }
+    }
+
+    error_set(ERROR_EXPRESSION_TOO_COMPLEX);
+    return -1;
+}
+
+
+// release temporary vector, constants and columns are kept
+void exprbatch_free_vector(exprbatch_program *p, uint16 operand, uint8 temp)
+{
+    if(temp && !(operand & EXPRBATCH_COLUMN)) p->vector_state[operand] = EXPRBATCH_VECTOR_RELEASED;
+}
+
+
+// append step a <op> b evaluated over selection of current level
+// return new step or NULL if program is too long
+exprbatch_step *exprbatch_append_step(exprbatch_program *p, uint8 op, uint16 a, uint16 b)
+{
+    exprbatch_step *step;
+
+    if(p->step_num >= EXPRBATCH_MAX_STEPS)
+    {
+        error_set(ERROR_EXPRESSION_TOO_COMPLEX);
+        return NULL;
+    }
+
+    step = p->steps + p->step_num++;
+    step->op = op;
+    step->level = p->level;
+    step->narrowed = 0;
+    step->dst = 0;
+    step->a = a;
+    step->b = b;
+    return step;
+}
+
+
+// append step dst = a <op> b with newly allocated temporary dst
+// return 0 on success, non-0 on error
+sint8 exprbatch_add_step(exprbatch_program *p, uint8 op, uint16 a, uint16 b, uint16 *dst)
+{
+    exprbatch_step *step;
+
+    if(exprbatch_alloc_vector(p, dst, 0) != 0) return -1;
+    if(NULL == (step = exprbatch_append_step(p, op, a, b))) return -1;
+
+    step->dst = *dst;
+    return 0;
+}
+
+
+// broadcast constant expr to all elements of vector v
+void exprbatch_fill_const(exprbatch_vector *v, const parser_ast_expr *expr)
+{
+    uint16 i;
+
+    v->type = expr->node_type;
+    memset(v->nulls, expr->node_type == PARSER_EXPR_NODE_TYPE_NULL ? 0xFF : 0, sizeof(v->nulls));
+
+    for(i = 0; i < EXPRBATCH_SIZE; i++)
+    {
+        switch(expr->node_type)
+        {
+            case PARSER_EXPR_NODE_TYPE_NUM: v->num[i] = expr->num; break;
+            case PARSER_EXPR_NODE_TYPE_INT: v->integer[i] = expr->integer; break;
+            case PARSER_EXPR_NODE_TYPE_FLOAT: v->fp[i] = expr->fp; break;
+            case PARSER_EXPR_NODE_TYPE_STR: v->str[i] = expr->str; break;
+            case PARSER_EXPR_NODE_TYPE_BOOL: v->boolean[i] = expr->boolean; break;
+            default: break;
+        }
+    }
+}
+
+
+// return reference of operation node expr, NULL if node is not counted yet
+exprbatch_node_ref *exprbatch_find_node(exprbatch_program *p, const parser_ast_expr *expr)
+{
+    uint16 i;
+
+    for(i = 0; i < p->node_num; i++)
+    {
+        if(p->nodes[i].node == expr) return p->nodes + i;
+    }
+
+    return NULL;
+}
+
+
+// count references of operation nodes of expression expr, shared node is counted once per parent
+// AND node of BETWEEN bounds is not compiled itself, so only its operands are counted, pattern of LIKE is constant
+// return 0 on success, non-0 if there are too many nodes
+sint8 exprbatch_count_refs(exprbatch_program *p, const parser_ast_expr *expr)
+{
+    exprbatch_node_ref *ref;
+
+    if(expr->node_type != PARSER_EXPR_NODE_TYPE_OP) return 0;
+
+    if(NULL != (ref = exprbatch_find_node(p, expr)))
+    {
+        ref->refs++;
+        return 0;
+    }
+
+    if(p->node_num >= EXPRBATCH_MAX_STEPS)
+    {
+        error_set(ERROR_EXPRESSION_TOO_COMPLEX);
+        return -1;
+    }
+
+    ref = p->nodes + p->node_num++;
+    ref->node = expr;
+    ref->refs = 1;
+    ref->compiled = 0;
+
+    if(exprbatch_count_refs(p, expr->left) != 0) return -1;
+    if(expr->op == PARSER_EXPR_OP_TYPE_NOT || expr->op == PARSER_EXPR_OP_TYPE_LIKE || expr->op == PARSER_EXPR_OP_TYPE_NOT_LIKE) return 0;
+
+    if(expr->op == PARSER_EXPR_OP_TYPE_BETWEEN && expr->right->node_type == PARSER_EXPR_NODE_TYPE_OP)
+    {
+        if(exprbatch_count_refs(p, expr->right->left) != 0) return -1;
+        return exprbatch_count_refs(p, expr->right->right);
+    }
+
+    return exprbatch_count_refs(p, expr->right);
+}
+
+
+sint8 exprbatch_compile_node(exprbatch_program *p, const parser_ast_expr *expr, exprvm_interface *vi, uint16 *operand, uint8 *temp);
+
+
+// compile a AND b, a OR b where b is operation which is not compiled yet, a is already compiled into operand a
+// b is evaluated only for elements where a does not decide the result
+// return 0 on success, non-0 on error
+sint8 exprbatch_compile_narrowed(exprbatch_program *p, const parser_ast_expr *expr, exprvm_interface *vi, uint16 a, uint16 *operand)
+{
+    exprbatch_step *narrow, *combine;
+    uint16 narrow_idx, b;
+    uint8 temp_b;
+
+    if(NULL == exprbatch_append_step(p, EXPRBATCH_OP_NARROW, a, 0)) return -1;
+    narrow_idx = p->step_num - 1;
+
+    p->level++;
+    if(exprbatch_compile_node(p, expr->right, vi, &b, &temp_b) != 0) return -1;
+    p->level--;
+
+    if(exprbatch_add_step(p, expr->op, a, b, operand) != 0) return -1;
+    exprbatch_free_vector(p, b, temp_b);
+
+    combine = p->steps + p->step_num - 1;
+    combine->narrowed = 1;
+
+    narrow = p->steps + narrow_idx;
+    narrow->b = p->step_num - 1;
+    return 0;
+}
+
+
+// compile expression subtree expr, set operand to program vector or column holding its value
+// shared operation node is compiled once, its vector is kept until the last reference is compiled
+// node compiled inside narrowed operand is evaluated only for part of elements, so it is not shared
+// temp is set to 1 if operand is temporary vector which can be reused after it is consumed
+// return 0 on success, non-0 on error
+sint8 exprbatch_compile_node(exprbatch_program *p, const parser_ast_expr *expr, exprvm_interface *vi, uint16 *operand, uint8 *temp)
+{
+    uint16 a, b = 0, lo, hi, ge, le, slot;
+    uint8 temp_a, temp_b = 0, temp_lo, temp_hi, op;
+    column_datatype coltype;
+    exprbatch_node_ref *ref;
+    const parser_ast_expr *null_operand;
+
+    *temp = 0;
+
+    switch(expr->node_type)
+    {
+        case PARSER_EXPR_NODE_TYPE_NAME:
+            if(vi->resolve_name(&expr->name, &slot, &coltype) != 0)
+            {
+                error_set(ERROR_SEMANTIC_ERROR);
+                return -1;
+            }
+            *operand = slot | EXPRBATCH_COLUMN;
+            return 0;
+
+        case PARSER_EXPR_NODE_TYPE_OP:
+            ref = exprbatch_find_node(p, expr);
+            ref->refs--;
+            if(ref->compiled)
+            {
+                *operand = ref->operand;
+                *temp = ref->refs == 0;
+                return 0;
+            }
+
+            if(exprbatch_compile_node(p, expr->left, vi, &a, &temp_a) != 0) return -1;
+
+            if(expr->op == PARSER_EXPR_OP_TYPE_BETWEEN)
+            {
+                // a BETWEEN lo AND hi is a >= lo AND a <= hi, a is kept until both comparisons are done
+                if(expr->right->node_type != PARSER_EXPR_NODE_TYPE_OP || expr->right->op != PARSER_EXPR_OP_TYPE_AND)
+                {
+                    error_set(ERROR_SEMANTIC_ERROR);
+                    return -1;
+                }
+
+                if(exprbatch_compile_node(p, expr->right->left, vi, &lo, &temp_lo) != 0) return -1;
+                if(exprbatch_add_step(p, PARSER_EXPR_OP_TYPE_GE, a, lo, &ge) != 0) return -1;
+                exprbatch_free_vector(p, lo, temp_lo);
+
+                if(exprbatch_compile_node(p, expr->right->right, vi, &hi, &temp_hi) != 0) return -1;
+                if(exprbatch_add_step(p, PARSER_EXPR_OP_TYPE_LE, a, hi, &le) != 0) return -1;
+                exprbatch_free_vector(p, hi, temp_hi);
+                exprbatch_free_vector(p, a, temp_a);
+
+                if(exprbatch_add_step(p, PARSER_EXPR_OP_TYPE_AND, ge, le, operand) != 0) return -1;
+                exprbatch_free_vector(p, ge, 1);
+                exprbatch_free_vector(p, le, 1);
+            }
+            else if(expr->op == PARSER_EXPR_OP_TYPE_LIKE || expr->op == PARSER_EXPR_OP_TYPE_NOT_LIKE)
+            {
+                // null pattern or escape character is compiled as operand b of generic step which gives null
+                if(exprvm_compile_pattern(expr, (uint8 *)p->patterns, EXPRBATCH_PATTERN_POOL_SZ, &p->pattern_used, &b, &null_operand) != 0) return -1;
+                if(NULL != null_operand)
+                {
+                    if(exprbatch_compile_node(p, null_operand, vi, &b, &temp_b) != 0) return -1;
+                    op = expr->op;
+                }
+                else
+                {
+                    op = (expr->op == PARSER_EXPR_OP_TYPE_LIKE) ? EXPRBATCH_OP_LIKE : EXPRBATCH_OP_NOT_LIKE;
+                }
+
+                if(exprbatch_add_step(p, op, a, b, operand) != 0) return -1;
+                exprbatch_free_vector(p, a, temp_a);
+            }
+            else if((expr->op == PARSER_EXPR_OP_TYPE_AND || expr->op == PARSER_EXPR_OP_TYPE_OR) && p->level < EXPRBATCH_MAX_LEVELS &&
+                    expr->right->node_type == PARSER_EXPR_NODE_TYPE_OP && !exprbatch_find_node(p, expr->right)->compiled)
+            {
+                if(exprbatch_compile_narrowed(p, expr, vi, a, operand) != 0) return -1;
+                exprbatch_free_vector(p, a, temp_a);
+            }
+            else
+            {
+                if(expr->op == PARSER_EXPR_OP_TYPE_NOT)
+                {
+                    b = a;
+                }
+                else if(exprbatch_compile_node(p, expr->right, vi, &b, &temp_b) != 0)
+                {
+                    return -1;
+                }
+
+                // result vector must differ from operands, so operands are released after it is taken
+                if(exprbatch_add_step(p, expr->op, a, b, operand) != 0) return -1;
+                exprbatch_free_vector(p, a, temp_a);
+                exprbatch_free_vector(p, b, temp_b);
+            }
+
+            *temp = ref->refs == 0 || p->level > 0;
+            if(p->level == 0)
+            {
+                ref->compiled = 1;
+                ref->operand = *operand;
+            }
+            return 0;
+
+        case PARSER_EXPR_NODE_TYPE_NUM:
+        case PARSER_EXPR_NODE_TYPE_INT:
+        case PARSER_EXPR_NODE_TYPE_FLOAT:
+        case PARSER_EXPR_NODE_TYPE_STR:
+        case PARSER_EXPR_NODE_TYPE_BOOL:
+        case PARSER_EXPR_NODE_TYPE_NULL:
+            // constant is broadcast once and is never overwritten
+            if(exprbatch_alloc_vector(p, operand, 1) != 0) return -1;
+            exprbatch_fill_const(p->vectors + *operand, expr);
+            return 0;
+
+        default:
+            error_set(ERROR_SEMANTIC_ERROR);
+            return -1;
+    }
+}
+
+
+// compile expression expr into program using buffer buf
+handle exprbatch_compile(void *buf, const parser_ast_expr *expr, exprvm_interface vi)
+{
+    exprbatch_program *p = (exprbatch_program *)buf;
+    uint16 v;
+    uint8 temp;
+
+    if(NULL == p) return NULL;
+
+    p->step_num = 0;
+    p->node_num = 0;
+    p->level = 0;
+    p->pattern_used = 0;
+    memset(p->vector_state, EXPRBATCH_VECTOR_FREE, sizeof(p->vector_state));
+    for(v = 0; v < EXPRBATCH_MAX_VECTORS; v++)
+    {
+        p->vectors[v].num = p->data[v].num;
+    }
+    p->skipped.type = PARSER_EXPR_NODE_TYPE_NULL;
+    memset(p->skipped.nulls, 0xFF, sizeof(p->skipped.nulls));
+
+    if(exprbatch_count_refs(p, expr) != 0) return NULL;
+    if(exprbatch_compile_node(p, expr, &vi, &p->result, &temp) != 0) return NULL;
+
+    return (handle)p;
+}
+
+
+// evaluate program for batch of columns
+sint8 exprbatch_eval(handle bh, const exprbatch_vector *columns, const uint16 *sel, uint16 n, const exprbatch_vector **result)
+{
+    exprbatch_program *p = (exprbatch_program *)bh;
+    const exprbatch_step *step, *end = p->steps + p->step_num;
+    const exprbatch_vector *a, *b;
+    const uint16 *level_sel;
+    uint16 level_n, i, k, m;
+    uint8 decide;
+    exprbatch_kernel kernel;
+
+    assert(n <= EXPRBATCH_SIZE);
+
+    for(step = p->steps; step < end; step++)
+    {
+        level_sel = step->level == 0 ? sel : p->sels[step->level - 1];
+        level_n = step->level == 0 ? n : p->sel_n[step->level - 1];
+        a = (step->a & EXPRBATCH_COLUMN) ? columns + (step->a & ~EXPRBATCH_COLUMN) : p->vectors + step->a;
+
+        if(step->op == EXPRBATCH_OP_NARROW)
+        {
+            // branch-free compaction of elements where a is null or differs from the deciding value
+            decide = (p->steps[step->b].op == PARSER_EXPR_OP_TYPE_OR);
+            m = 0;
+            if(a->type == PARSER_EXPR_NODE_TYPE_BOOL)
+            {
+                EXPRBATCH_LOOP(level_sel, level_n,
+                    p->sels[step->level][m] = i;
+                    m += EXPRBATCH_IS_NULL(a, i) | (a->boolean[i] ^ decide);
+                )
+            }
+            else
+            {
+                EXPRBATCH_LOOP(level_sel, level_n, p->sels[step->level][m++] = i;)
+            }
+
+            p->sel_n[step->level] = m;
+            if(m == 0) step = p->steps + step->b - 1;
+            continue;
+        }
+
+        if(step->op == EXPRBATCH_OP_LIKE || step->op == EXPRBATCH_OP_NOT_LIKE)
+        {
+            if(exprbatch_like((handle)((uint8 *)p->patterns + step->b), step->op == EXPRBATCH_OP_NOT_LIKE,
+                              a, p->vectors + step->dst, level_sel, level_n) != 0) return -1;
+            continue;
+        }
+
+        if(step->narrowed && p->sel_n[step->level] == 0)
+        {
+            b = &p->skipped;
+        }
+        else
+        {
+            b = (step->b & EXPRBATCH_COLUMN) ? columns + (step->b & ~EXPRBATCH_COLUMN) : p->vectors + step->b;
+        }
+
+        if((kernel = exprbatch_kernel_lookup(step->op, a->type, b->type)) == NULL)
+        {
+            error_set(ERROR_DATATYPE_MISMATCH);
+            return -1;
+        }
+
+        if(kernel(step->op, a, b, p->vectors + step->dst, level_sel, level_n) != 0) return -1;
+    }
+
+    *result = (p->result & EXPRBATCH_COLUMN) ? columns + (p->result & ~EXPRBATCH_COLUMN) : p->vectors + p->result;
+    return 0;
+}
+
+
+// evaluate boolean program for batch of columns and select elements with true result
+sint8 exprbatch_filter(handle bh, const exprbatch_vector *columns, const uint16 *sel, uint16 n, uint16 *sel_out, uint16 *out_n)
+{
+    const exprbatch_vector *res;
+    uint16 i, k, m = 0;
+
+    if(exprbatch_eval(bh, columns, sel, n, &res) != 0) return -1;
+
+    if(res->type == PARSER_EXPR_NODE_TYPE_BOOL)
+    {
+        // branch-free compaction, m never exceeds k, so sel_out can overwrite sel
+        EXPRBATCH_LOOP(sel, n,
+            sel_out[m] = i;
+            m += res->boolean[i] & (EXPRBATCH_IS_NULL(res, i) ^ 1);
+        )
+    }
+    else if(res->type != PARSER_EXPR_NODE_TYPE_NULL)
+    {
+        error_set(ERROR_DATATYPE_MISMATCH);
+        return -1;
+    }
+
+    *out_n = m;
+    return 0;
+}
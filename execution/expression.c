@@ -2,11 +2,18 @@
 #include "common/decimal.h"
 #include "common/string_literal.h"
 #include "common/stack.h"
+#include "common/strmatch.h"
+#include "common/error.h"
 #include <assert.h>
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
 
+#define EXPRESSION_IS_NUMERIC(e)    ((e)->node_type == PARSER_EXPR_NODE_TYPE_NUM || (e)->node_type == PARSER_EXPR_NODE_TYPE_INT \
+                                        || (e)->node_type == PARSER_EXPR_NODE_TYPE_FLOAT)
+
+
 // resolve node of type name to value
 sint8 expression_resolve_name(const parser_ast_expr *expr, parser_ast_expr *result)
 {
@@ -15,6 +22,272 @@ sint8 expression_resolve_name(const parser_ast_expr *expr, parser_ast_expr *resu
 }
 
 
+// return decimal value of numeric node, integer node is converted into buf
+const decimal *expression_num_value(const parser_ast_expr *expr, decimal *buf)
+{
+    if(expr->node_type == PARSER_EXPR_NODE_TYPE_INT)
+    {
+        decimal_from_int64(expr->integer, buf);
+        return buf;
+    }
+
+    return &expr->num;
+}
+
+
+// return floating point value of numeric node
+float64 expression_float_value(const parser_ast_expr *expr)
+{
+    switch(expr->node_type)
+    {
+        case PARSER_EXPR_NODE_TYPE_INT: return (float64)expr->integer;
+        case PARSER_EXPR_NODE_TYPE_NUM: return decimal_to_float64(&expr->num);
+        default: return expr->fp;
+    }
+}
+
+
+// calculate floating point operation res = v1 <op> v2
+sint8 expression_float_op(parser_expr_op_type op, float64 v1, float64 v2, float64 *res)
+{
+    switch(op)
+    {
+        case PARSER_EXPR_OP_TYPE_MUL: *res = v1 * v2; break;
+        case PARSER_EXPR_OP_TYPE_ADD: *res = v1 + v2; break;
+        case PARSER_EXPR_OP_TYPE_SUB: *res = v1 - v2; break;
+        case PARSER_EXPR_OP_TYPE_DIV:
+            if(v2 == 0.0)
+            {
+                error_set(ERROR_DIVISION_BY_ZERO);
+                return -1;
+            }
+            *res = v1 / v2;
+            break;
+        default:
+            assert(1 == 0);
+            return -1;
+    }
+
+    if(!isfinite(*res))
+    {
+        error_set(ERROR_DECIMAL_OVERFLOW);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+// compare two numeric nodes
+// return positive if left > right, negative if left < right, 0 otherwise
+sint16 expression_num_cmp(const parser_ast_expr *left, const parser_ast_expr *right)
+{
+    decimal d1, d2;
+    float64 f1, f2;
+
+    if(left->node_type == PARSER_EXPR_NODE_TYPE_INT && right->node_type == PARSER_EXPR_NODE_TYPE_INT)
+    {
+        return (left->integer > right->integer) - (left->integer < right->integer);
+    }
+
+    if(left->node_type == PARSER_EXPR_NODE_TYPE_FLOAT || right->node_type == PARSER_EXPR_NODE_TYPE_FLOAT)
+    {
+        f1 = expression_float_value(left);
+        f2 = expression_float_value(right);
+        return (f1 > f2) - (f1 < f2);
+    }
+
+    return decimal_cmp(expression_num_value(left, &d1), expression_num_value(right, &d2));
+}
+
+
+// calculate arithmetic operation op over numeric nodes left and right, put result to expr
+// integers stay integers while result fits in sint64, otherwise decimal is used
+// float operand makes the result float
+// return 0 on success, non-0 on error
+sint8 expression_calc_arithmetic(parser_ast_expr *expr, parser_expr_op_type op, const parser_ast_expr *left, const parser_ast_expr *right)
+{
+    decimal d1, d2;
+    const decimal *pd1, *pd2;
+    sint64 ires;
+    uint8 overflow = 1;
+
+    if(left->node_type == PARSER_EXPR_NODE_TYPE_FLOAT || right->node_type == PARSER_EXPR_NODE_TYPE_FLOAT)
+    {
+        expr->node_type = PARSER_EXPR_NODE_TYPE_FLOAT;
+        return expression_float_op(op, expression_float_value(left), expression_float_value(right), &expr->fp);
+    }
+
+    if(left->node_type == PARSER_EXPR_NODE_TYPE_INT && right->node_type == PARSER_EXPR_NODE_TYPE_INT)
+    {
+        switch(op)
+        {
+            case PARSER_EXPR_OP_TYPE_MUL:
+                overflow = __builtin_mul_overflow(left->integer, right->integer, &ires);
+                break;
+            case PARSER_EXPR_OP_TYPE_ADD:
+                overflow = __builtin_add_overflow(left->integer, right->integer, &ires);
+                break;
+            case PARSER_EXPR_OP_TYPE_SUB:
+                overflow = __builtin_sub_overflow(left->integer, right->integer, &ires);
+                break;
+            default:    // division result is decimal
+                break;
+        }
+
+        if(!overflow)
+        {
+            expr->node_type = PARSER_EXPR_NODE_TYPE_INT;
+            expr->integer = ires;
+            return 0;
+        }
+    }
+
+    pd1 = expression_num_value(left, &d1);
+    pd2 = expression_num_value(right, &d2);
+    expr->node_type = PARSER_EXPR_NODE_TYPE_NUM;
+
+    switch(op)
+    {
+        case PARSER_EXPR_OP_TYPE_MUL:
+            return decimal_mul(pd1, pd2, &expr->num);
+        case PARSER_EXPR_OP_TYPE_DIV:
+            return decimal_div(pd1, pd2, &expr->num);
+        case PARSER_EXPR_OP_TYPE_ADD:
+            return decimal_add(pd1, pd2, &expr->num);
+        case PARSER_EXPR_OP_TYPE_SUB:
+            return decimal_sub(pd1, pd2, &expr->num);
+        default:
+            assert(1 == 0);
+            return -1;
+    }
+}
+
+
+// return 1 if expr is AND/OR whose left operand is constant which decides the result, 0 otherwise
+uint8 expression_is_short_circuit(const parser_ast_expr *expr)
+{
+    return (expr->op == PARSER_EXPR_OP_TYPE_AND || expr->op == PARSER_EXPR_OP_TYPE_OR)
+        && expr->left->node_type == PARSER_EXPR_NODE_TYPE_BOOL
+        && expr->left->boolean == (expr->op == PARSER_EXPR_OP_TYPE_OR);
+}
+
+
+// calculate expr = left AND/OR right following three-valued logic, operands must be boolean or null
+// false AND null is false, true OR null is true, otherwise null operand gives null
+// return 0 on success, non-0 on datatype mismatch
+sint8 expression_calc_logical(parser_ast_expr *expr, parser_expr_op_type op, const parser_ast_expr *left, const parser_ast_expr *right)
+{
+    uint8 decide = (op == PARSER_EXPR_OP_TYPE_OR);
+
+    if((left->node_type != PARSER_EXPR_NODE_TYPE_BOOL && left->node_type != PARSER_EXPR_NODE_TYPE_NULL)
+            || (right->node_type != PARSER_EXPR_NODE_TYPE_BOOL && right->node_type != PARSER_EXPR_NODE_TYPE_NULL))
+    {
+        error_set(ERROR_DATATYPE_MISMATCH);
+        return -1;
+    }
+
+    if((left->node_type == PARSER_EXPR_NODE_TYPE_BOOL && left->boolean == decide)
+            || (right->node_type == PARSER_EXPR_NODE_TYPE_BOOL && right->boolean == decide))
+    {
+        expr->boolean = decide;
+        expr->node_type = PARSER_EXPR_NODE_TYPE_BOOL;
+    }
+    else if(left->node_type == PARSER_EXPR_NODE_TYPE_NULL || right->node_type == PARSER_EXPR_NODE_TYPE_NULL)
+    {
+        expr->node_type = PARSER_EXPR_NODE_TYPE_NULL;
+    }
+    else
+    {
+        expr->boolean = decide ^ 1;
+        expr->node_type = PARSER_EXPR_NODE_TYPE_BOOL;
+    }
+
+    return 0;
+}
+
+
+void expression_like_operands(const parser_ast_expr *expr, parser_ast_expr **pattern, parser_ast_expr **escape)
+{
+    if(expr->right->node_type == PARSER_EXPR_NODE_TYPE_OP && expr->right->op == PARSER_EXPR_OP_TYPE_ESCAPE)
+    {
+        *pattern = expr->right->left;
+        *escape = expr->right->right;
+    }
+    else
+    {
+        *pattern = expr->right;
+        *escape = NULL;
+    }
+}
+
+
+// calculate expr = left [NOT] LIKE pattern [ESCAPE escape], null operand gives null
+// if ignore_name is not 0 and any operand is op/name then the expression is not calculated
+// return 0 on success, non-0 on error
+sint8 expression_calc_like(parser_ast_expr *expr, uint8 ignore_name)
+{
+    parser_ast_expr *args[3];
+    uint8 n = 3, i, matched;
+    uint64 pattern_sz;
+    void *buf;
+    handle mh;
+    sint8 res;
+
+    args[0] = expr->left;
+    expression_like_operands(expr, &args[1], &args[2]);
+    if(NULL == args[2]) n = 2;
+
+    for(i = 0; i < n; i++)
+    {
+        if(args[i]->node_type == PARSER_EXPR_NODE_TYPE_OP || args[i]->node_type == PARSER_EXPR_NODE_TYPE_NAME)
+        {
+            if(ignore_name) return 0;
+
+            assert(args[i]->node_type != PARSER_EXPR_NODE_TYPE_OP);
+            if(expression_resolve_name(args[i], args[i]) != 0) return -1;
+        }
+    }
+
+    for(i = 0; i < n; i++)
+    {
+        if(args[i]->node_type == PARSER_EXPR_NODE_TYPE_NULL)
+        {
+            expr->node_type = PARSER_EXPR_NODE_TYPE_NULL;
+            return 0;
+        }
+    }
+
+    for(i = 0; i < n; i++)
+    {
+        if(args[i]->node_type != PARSER_EXPR_NODE_TYPE_STR)
+        {
+            error_set(ERROR_DATATYPE_MISMATCH);
+            return -1;
+        }
+    }
+
+    if(string_literal_byte_length(args[1]->str, &pattern_sz) != 0) return -1;
+
+    buf = malloc(strmatch_get_alloc_sz(pattern_sz));
+    if(NULL == buf)
+    {
+        error_set(ERROR_OUT_OF_MEMORY);
+        return -1;
+    }
+
+    mh = strmatch_compile_literal(buf, args[1]->str, (3 == n) ? args[2]->str : NULL);
+    res = (NULL == mh || strmatch_match_literal(mh, args[0]->str, &matched) != 0);
+    free(buf);
+    if(res) return -1;
+
+    expr->node_type = PARSER_EXPR_NODE_TYPE_BOOL;
+    expr->boolean = matched ^ (expr->op == PARSER_EXPR_OP_TYPE_NOT_LIKE);
+
+    return 0;
+}
+
+
 sint8 expression_calc_base_expr(parser_ast_expr *expr, uint8 ignore_name)
 {
     parser_ast_expr *left, *right;
@@ -28,15 +301,35 @@ sint8 expression_calc_base_expr(parser_ast_expr *expr, uint8 ignore_name)
 
     assert(expr->node_type == PARSER_EXPR_NODE_TYPE_OP);
 
+    if(op == PARSER_EXPR_OP_TYPE_LIKE || op == PARSER_EXPR_OP_TYPE_NOT_LIKE)
+    {
+        return expression_calc_like(expr, ignore_name);
+    }
+
+    // pattern and escape character are calculated by their LIKE
+    if(op == PARSER_EXPR_OP_TYPE_ESCAPE) return 0;
+
     if(0 == ignore_name)
     {
         assert(left->node_type != PARSER_EXPR_NODE_TYPE_OP);
-        assert(op == PARSER_EXPR_OP_TYPE_NOT || right->node_type != PARSER_EXPR_NODE_TYPE_OP);
 
         if(left->node_type == PARSER_EXPR_NODE_TYPE_NAME)
         {
             if(expression_resolve_name(left, left) != 0) return -1;
         }
+    }
+
+    // right operand is not calculated when left one decides the result
+    if(expression_is_short_circuit(expr))
+    {
+        expr->node_type = PARSER_EXPR_NODE_TYPE_BOOL;
+        expr->boolean = (op == PARSER_EXPR_OP_TYPE_OR);
+        return 0;
+    }
+
+    if(0 == ignore_name)
+    {
+        assert(op == PARSER_EXPR_OP_TYPE_NOT || right->node_type != PARSER_EXPR_NODE_TYPE_OP);
 
         if(op != PARSER_EXPR_OP_TYPE_NOT && right->node_type == PARSER_EXPR_NODE_TYPE_NAME)
         {
@@ -60,61 +353,12 @@ sint8 expression_calc_base_expr(parser_ast_expr *expr, uint8 ignore_name)
     switch(op)
     {
         case PARSER_EXPR_OP_TYPE_MUL:
-            if(left->node_type == PARSER_EXPR_NODE_TYPE_NUM && right->node_type == PARSER_EXPR_NODE_TYPE_NUM)
-            {
-                expr->node_type = PARSER_EXPR_NODE_TYPE_NUM;
-                if(decimal_mul(&left->num, &right->num, &expr->num) != 0) return -1;
-            }
-            else if(arg_null)
-            {
-                expr->node_type = PARSER_EXPR_NODE_TYPE_NULL;
-            }
-            else
-            {
-                error_set(ERROR_DATATYPE_MISMATCH);
-                return -1;
-            }
-            break;
         case PARSER_EXPR_OP_TYPE_DIV:
-            if(left->node_type == PARSER_EXPR_NODE_TYPE_NUM && right->node_type == PARSER_EXPR_NODE_TYPE_NUM)
-            {
-                expr->node_type = PARSER_EXPR_NODE_TYPE_NUM;
-                if(decimal_div(&left->num, &right->num, &expr->num) != 0) return -1;
-            }
-            else if(arg_null)
-            {
-                expr->node_type = PARSER_EXPR_NODE_TYPE_NULL;
-            }
-            else
-            {
-                error_set(ERROR_DATATYPE_MISMATCH);
-                return -1;
-            }
-            break;
         case PARSER_EXPR_OP_TYPE_ADD:
-            if(left->node_type == PARSER_EXPR_NODE_TYPE_NUM && right->node_type == PARSER_EXPR_NODE_TYPE_NUM)
-            {
-                expr->node_type = PARSER_EXPR_NODE_TYPE_NUM;
-                if(decimal_add(&left->num, &right->num, &expr->num) != 0) return -1;
-            }
-            else if(arg_null)
-            {
-                expr->node_type = PARSER_EXPR_NODE_TYPE_NULL;
-            }
-            else
-            {
-                error_set(ERROR_DATATYPE_MISMATCH);
-                return -1;
-            }
-            break;
         case PARSER_EXPR_OP_TYPE_SUB:
-            if(left->node_type == PARSER_EXPR_NODE_TYPE_NUM && right->node_type == PARSER_EXPR_NODE_TYPE_NUM)
+            if(EXPRESSION_IS_NUMERIC(left) && EXPRESSION_IS_NUMERIC(right))
             {
-                expr->node_type = PARSER_EXPR_NODE_TYPE_NUM;
-                if(decimal_sub(&left->num, &right->num, &expr->num) != 0)
-                {
-                    return -1;
-                }
+                if(expression_calc_arithmetic(expr, op, left, right) != 0) return -1;
             }
             else if(arg_null)
             {
@@ -132,10 +376,10 @@ sint8 expression_calc_base_expr(parser_ast_expr *expr, uint8 ignore_name)
         case PARSER_EXPR_OP_TYPE_GE:
         case PARSER_EXPR_OP_TYPE_LT:
         case PARSER_EXPR_OP_TYPE_LE:
-            if(left->node_type == PARSER_EXPR_NODE_TYPE_NUM && right->node_type == PARSER_EXPR_NODE_TYPE_NUM)
+            if(EXPRESSION_IS_NUMERIC(left) && EXPRESSION_IS_NUMERIC(right))
             {
                 expr->node_type = PARSER_EXPR_NODE_TYPE_BOOL;
-                cmp_res = decimal_cmp(&left->num, &right->num);
+                cmp_res = expression_num_cmp(left, right);
                 if((0 == cmp_res && (PARSER_EXPR_OP_TYPE_EQ == op || PARSER_EXPR_OP_TYPE_GE == op || PARSER_EXPR_OP_TYPE_LE == op))
                         || (0 > cmp_res && (PARSER_EXPR_OP_TYPE_NE == op || PARSER_EXPR_OP_TYPE_LT == op || PARSER_EXPR_OP_TYPE_LE == op))
                         || (0 < cmp_res && (PARSER_EXPR_OP_TYPE_NE == op || PARSER_EXPR_OP_TYPE_GT == op || PARSER_EXPR_OP_TYPE_GE == op)))
@@ -168,8 +412,7 @@ sint8 expression_calc_base_expr(parser_ast_expr *expr, uint8 ignore_name)
             }
             else if(arg_null)
             {
-                expr->boolean = 0;
-                expr->node_type = PARSER_EXPR_NODE_TYPE_BOOL;
+                expr->node_type = PARSER_EXPR_NODE_TYPE_NULL;
             }
             else
             {
@@ -180,15 +423,10 @@ sint8 expression_calc_base_expr(parser_ast_expr *expr, uint8 ignore_name)
             break;
         case PARSER_EXPR_OP_TYPE_IS:
         case PARSER_EXPR_OP_TYPE_IS_NOT:
-            if(left->node_type != right->node_type)
-            {
-                expr->boolean = 0;
-                expr->node_type = PARSER_EXPR_NODE_TYPE_BOOL;
-            }
-            else if(left->node_type == PARSER_EXPR_NODE_TYPE_NUM)
+            if(EXPRESSION_IS_NUMERIC(left) && EXPRESSION_IS_NUMERIC(right))
             {
                 expr->node_type = PARSER_EXPR_NODE_TYPE_BOOL;
-                cmp_res = decimal_cmp(&left->num, &right->num);
+                cmp_res = expression_num_cmp(left, right);
                 if(0 == cmp_res)
                 {
                     expr->boolean = 1;
@@ -198,6 +436,11 @@ sint8 expression_calc_base_expr(parser_ast_expr *expr, uint8 ignore_name)
                     expr->boolean = 0;
                 }
             }
+            else if(left->node_type != right->node_type)
+            {
+                expr->boolean = 0;
+                expr->node_type = PARSER_EXPR_NODE_TYPE_BOOL;
+            }
             else if(left->node_type == PARSER_EXPR_NODE_TYPE_STR)
             {
                 expr->node_type = PARSER_EXPR_NODE_TYPE_BOOL;
@@ -246,17 +489,9 @@ sint8 expression_calc_base_expr(parser_ast_expr *expr, uint8 ignore_name)
                 expr->boolean = left->boolean ^ 1;
                 expr->node_type = PARSER_EXPR_NODE_TYPE_BOOL;
             }
-            else
+            else if(left->node_type == PARSER_EXPR_NODE_TYPE_NULL)
             {
-                error_set(ERROR_DATATYPE_MISMATCH);
-                return -1;
-            }
-            break;
-        case PARSER_EXPR_OP_TYPE_AND:
-            if(left->node_type == PARSER_EXPR_NODE_TYPE_BOOL && right->node_type == PARSER_EXPR_NODE_TYPE_BOOL)
-            {
-                expr->boolean = left->boolean & right->boolean;
-                expr->node_type = PARSER_EXPR_NODE_TYPE_BOOL;
+                expr->node_type = PARSER_EXPR_NODE_TYPE_NULL;
             }
             else
             {
@@ -264,17 +499,9 @@ sint8 expression_calc_base_expr(parser_ast_expr *expr, uint8 ignore_name)
                 return -1;
             }
             break;
+        case PARSER_EXPR_OP_TYPE_AND:
         case PARSER_EXPR_OP_TYPE_OR:
-            if(left->node_type == PARSER_EXPR_NODE_TYPE_BOOL && right->node_type == PARSER_EXPR_NODE_TYPE_BOOL)
-            {
-                expr->boolean = left->boolean | right->boolean;
-                expr->node_type = PARSER_EXPR_NODE_TYPE_BOOL;
-            }
-            else
-            {
-                error_set(ERROR_DATATYPE_MISMATCH);
-                return -1;
-            }
+            if(expression_calc_logical(expr, op, left, right) != 0) return -1;
             break;
         default:
             assert(1 == 0);
@@ -302,7 +529,8 @@ sint8 expression_calc_const_expr(parser_ast_expr *expr, handle sh)
             }
             else
             {
-                if(PARSER_EXPR_OP_TYPE_NOT != expr->op && prev != expr->right && PARSER_EXPR_NODE_TYPE_OP == expr->right->node_type)
+                if(PARSER_EXPR_OP_TYPE_NOT != expr->op && prev != expr->right && PARSER_EXPR_NODE_TYPE_OP == expr->right->node_type
+                        && !expression_is_short_circuit(expr))
                 {
                     if(stack_push(sh, &expr) != 0) return -1;
                     expr = expr->right;
@@ -0,0 +1,424 @@
+#include "execution/exproptimize.h"
+#include "execution/expression.h"
+#include "common/htable.h"
+#include "common/strval.h"
+#include "common/string_literal.h"
+#include <string.h>
+
+
+#define EXPROPTIMIZE_HTABLE_SZ      (EXPROPTIMIZE_MAX_NODES * 2)
+#define EXPROPTIMIZE_STR_POOL_SZ    (64 * 1024)     // storage of interned string literals per query block
+#define EXPROPTIMIZE_MAX_KEY_SZ     (sizeof(exproptimize_key_header) + 2 * sizeof(uint16) + 2 * LEXER_MAX_IDENTIFIER_LEN + sizeof(strval) + 1)
+
+#define EXPROPTIMIZE_IS_CONST(e)    ((e)->node_type != PARSER_EXPR_NODE_TYPE_OP && (e)->node_type != PARSER_EXPR_NODE_TYPE_NAME)
+
+// 1 if e is pattern with ESCAPE character of LIKE and both are constants
+#define EXPROPTIMIZE_IS_CONST_ESCAPE(e) ((e)->node_type == PARSER_EXPR_NODE_TYPE_OP && (e)->op == PARSER_EXPR_OP_TYPE_ESCAPE \
+                                            && EXPROPTIMIZE_IS_CONST((e)->left) && EXPROPTIMIZE_IS_CONST((e)->right))
+#define EXPROPTIMIZE_IS_BOOL(e, v)  ((e)->node_type == PARSER_EXPR_NODE_TYPE_BOOL && (e)->boolean == (v))
+
+
+// fixed part of node key, followed by node value
+typedef struct _exproptimize_key_header
+{
+    const parser_ast_expr   *left;
+    const parser_ast_expr   *right;
+    parser_expr_node_type   node_type;
+    parser_expr_op_type     op;
+} exproptimize_key_header;
+
+
+// optimizer state
+typedef struct _exproptimize_state
+{
+    handle      nodes;                                  // node key -> merged node
+    handle      strings;                                // interned string literals, equal literals have equal keys
+    uint32      key_used;
+    uint8       key_pool[EXPROPTIMIZE_KEY_POOL_SZ];
+    uint8       htable_buf[];
+} exproptimize_state;
+
+
+// return size of the buffer for optimizer
+size_t exproptimize_get_alloc_sz()
+{
+    return sizeof(exproptimize_state) + htable_get_alloc_sz(EXPROPTIMIZE_HTABLE_SZ)
+        + strval_dict_get_alloc_sz(EXPROPTIMIZE_MAX_NODES, EXPROPTIMIZE_STR_POOL_SZ);
+}
+
+
+// create optimizer using buffer buf
+handle exproptimize_create(void *buf)
+{
+    exproptimize_state *os = (exproptimize_state *)buf;
+
+    if(NULL == os) return NULL;
+
+    // interning dictionary follows hash table
+    os->strings = strval_dict_create(os->htable_buf + htable_get_alloc_sz(EXPROPTIMIZE_HTABLE_SZ),
+                                     EXPROPTIMIZE_MAX_NODES, EXPROPTIMIZE_STR_POOL_SZ);
+    exproptimize_reset((handle)os);
+
+    return (handle)os;
+}
+
+
+// forget nodes seen so far
+void exproptimize_reset(handle oh)
+{
+    exproptimize_state *os = (exproptimize_state *)oh;
+
+    os->nodes = htable_create(EXPROPTIMIZE_HTABLE_SZ, os->htable_buf, htable_strhash);
+    strval_dict_reset(os->strings);
+    os->key_used = 0;
+}
+
+
+// put key identifying value of node expr to buffer key, children are identified by address as they are already merged
+// return key length
+uint32 exproptimize_node_key(exproptimize_state *os, const parser_ast_expr *expr, uint8 *key)
+{
+    exproptimize_key_header *header = (exproptimize_key_header *)key;
+    uint8 *value = key + sizeof(*header);
+    uint8 str[EXPROPTIMIZE_MAX_STR_SZ];
+    uint64 len;
+    strval sv;
+
+    memset(header, 0, sizeof(*header));
+    header->node_type = expr->node_type;
+
+    switch(expr->node_type)
+    {
+        case PARSER_EXPR_NODE_TYPE_OP:
+            header->op = expr->op;
+            header->left = expr->left;
+            header->right = expr->op == PARSER_EXPR_OP_TYPE_NOT ? NULL : expr->right;
+            break;
+        case PARSER_EXPR_NODE_TYPE_NUM:
+            memcpy(value, &expr->num.sign, sizeof(expr->num.sign));
+            value += sizeof(expr->num.sign);
+            memcpy(value, &expr->num.e, sizeof(expr->num.e));
+            value += sizeof(expr->num.e);
+            memcpy(value, &expr->num.n, sizeof(expr->num.n));
+            value += sizeof(expr->num.n);
+            // n counts digits, limbs holding them are compared
+            len = (uint64)(expr->num.n + DECIMAL_BASE_LOG10 - 1) / DECIMAL_BASE_LOG10;
+            if(len > DECIMAL_PARTS) len = DECIMAL_PARTS;
+            memcpy(value, expr->num.m, len * sizeof(expr->num.m[0]));
+            value += len * sizeof(expr->num.m[0]);
+            break;
+        case PARSER_EXPR_NODE_TYPE_INT:
+            memcpy(value, &expr->integer, sizeof(expr->integer));
+            value += sizeof(expr->integer);
+            break;
+        case PARSER_EXPR_NODE_TYPE_FLOAT:
+            memcpy(value, &expr->fp, sizeof(expr->fp));
+            value += sizeof(expr->fp);
+            break;
+        case PARSER_EXPR_NODE_TYPE_BOOL:
+            *value++ = expr->boolean;
+            break;
+        case PARSER_EXPR_NODE_TYPE_STR:
+            // short string literals are compared by interned value, others by handle
+            len = EXPROPTIMIZE_MAX_STR_SZ;
+            if(string_literal_byte_length(expr->str, &len) == 0 && len <= EXPROPTIMIZE_MAX_STR_SZ
+                && string_literal_read(expr->str, str, &len) == 0
+                && strval_dict_intern(os->strings, str, (uint32)len, &sv) == 0)
+            {
+                *value++ = 1;
+                memcpy(value, &sv, sizeof(sv));
+                value += sizeof(sv);
+            }
+            else
+            {
+                *value++ = 0;
+                memcpy(value, &expr->str, sizeof(expr->str));
+                value += sizeof(expr->str);
+            }
+            break;
+        case PARSER_EXPR_NODE_TYPE_NAME:
+            memcpy(value, &expr->name.first_part_len, sizeof(expr->name.first_part_len));
+            value += sizeof(expr->name.first_part_len);
+            memcpy(value, expr->name.first_part, expr->name.first_part_len);
+            value += expr->name.first_part_len;
+            memcpy(value, &expr->name.second_part_len, sizeof(expr->name.second_part_len));
+            value += sizeof(expr->name.second_part_len);
+            memcpy(value, expr->name.second_part, expr->name.second_part_len);
+            value += expr->name.second_part_len;
+            break;
+        default:
+            break;
+    }
+
+    return (uint32)(value - key);
+}
+
+
+// find node equal to expr among nodes seen so far, remember expr if there is no such node
+// return equal node or expr itself
+parser_ast_expr *exproptimize_merge_node(exproptimize_state *os, parser_ast_expr *expr)
+{
+    uint8 key[EXPROPTIMIZE_MAX_KEY_SZ];
+    const htable_entry *found;
+    htable_entry entry;
+
+    entry.keylen = exproptimize_node_key(os, expr, key);
+
+    found = htable_search(os->nodes, key, entry.keylen);
+    if(NULL != found) return (parser_ast_expr *)found->data;
+
+    // when storage is exhausted the node is just not shared
+    if(os->key_used + entry.keylen > EXPROPTIMIZE_KEY_POOL_SZ) return expr;
+
+    entry.key = os->key_pool + os->key_used;
+    entry.data = expr;
+    entry.datalen = sizeof(*expr);
+    memcpy(entry.key, key, entry.keylen);
+
+    if(htable_add(os->nodes, &entry) != 0) return expr;
+    os->key_used += entry.keylen;
+
+    return expr;
+}
+
+
+// return 1 if expr is known to produce boolean value
+uint8 exproptimize_is_boolean(const parser_ast_expr *expr)
+{
+    return expr->node_type == PARSER_EXPR_NODE_TYPE_BOOL
+        || (expr->node_type == PARSER_EXPR_NODE_TYPE_OP && expr->op >= PARSER_EXPR_OP_TYPE_EQ && expr->op <= PARSER_EXPR_OP_TYPE_OR
+            && expr->op != PARSER_EXPR_OP_TYPE_ESCAPE);
+}
+
+
+// simplify boolean identities of operation node expr with already optimized children
+// return replacement node or expr itself
+parser_ast_expr *exproptimize_simplify(parser_ast_expr *expr)
+{
+    parser_ast_expr *left = expr->left, *right = expr->right;
+
+    switch(expr->op)
+    {
+        case PARSER_EXPR_OP_TYPE_NOT:
+            // NOT NOT x -> x
+            if(left->node_type == PARSER_EXPR_NODE_TYPE_OP && left->op == PARSER_EXPR_OP_TYPE_NOT && exproptimize_is_boolean(left->left))
+            {
+                return left->left;
+            }
+            break;
+
+        case PARSER_EXPR_OP_TYPE_AND:
+        case PARSER_EXPR_OP_TYPE_OR:
+            if(!exproptimize_is_boolean(left) || !exproptimize_is_boolean(right)) break;
+
+            // x AND x -> x, x OR x -> x
+            if(left == right) return left;
+
+            // x AND FALSE -> FALSE, x OR TRUE -> TRUE
+            if(EXPROPTIMIZE_IS_BOOL(left, expr->op == PARSER_EXPR_OP_TYPE_OR)) return left;
+            if(EXPROPTIMIZE_IS_BOOL(right, expr->op == PARSER_EXPR_OP_TYPE_OR)) return right;
+
+            // x AND TRUE -> x, x OR FALSE -> x
+            if(EXPROPTIMIZE_IS_BOOL(left, expr->op == PARSER_EXPR_OP_TYPE_AND)) return right;
+            if(EXPROPTIMIZE_IS_BOOL(right, expr->op == PARSER_EXPR_OP_TYPE_AND)) return left;
+            break;
+
+        default:
+            break;
+    }
+
+    return expr;
+}
+
+
+// optimize subtree *pexpr bottom-up, *pexpr is replaced with merged or simplified node
+// return 0 on success, non-0 on error
+sint8 exproptimize_node(exproptimize_state *os, parser_ast_expr **pexpr)
+{
+    parser_ast_expr *expr = *pexpr, folded;
+
+    if(expr->node_type == PARSER_EXPR_NODE_TYPE_OP)
+    {
+        if(exproptimize_node(os, &expr->left) != 0) return -1;
+        if(expr->op != PARSER_EXPR_OP_TYPE_NOT)
+        {
+            if(exproptimize_node(os, &expr->right) != 0) return -1;
+        }
+
+        // folding is done on a copy, so failed operation (e.g. division by zero) keeps the node for execution;
+        // ESCAPE node is folded together with its LIKE
+        if(expr->op != PARSER_EXPR_OP_TYPE_BETWEEN && expr->op != PARSER_EXPR_OP_TYPE_ESCAPE && EXPROPTIMIZE_IS_CONST(expr->left)
+                && (expr->op == PARSER_EXPR_OP_TYPE_NOT || EXPROPTIMIZE_IS_CONST(expr->right) || EXPROPTIMIZE_IS_CONST_ESCAPE(expr->right)))
+        {
+            folded = *expr;
+            if(expression_calc_base_expr(&folded, 1) == 0) *expr = folded;
+        }
+
+        if(expr->node_type == PARSER_EXPR_NODE_TYPE_OP)
+        {
+            expr = exproptimize_simplify(expr);
+        }
+    }
+
+    *pexpr = exproptimize_merge_node(os, expr);
+
+    return 0;
+}
+
+
+// optimize expression expr in place
+sint8 exproptimize_expr(handle oh, parser_ast_expr *expr)
+{
+    exproptimize_state *os = (exproptimize_state *)oh;
+    parser_ast_expr *root = expr;
+
+    if(exproptimize_node(os, &root) != 0) return -1;
+
+    // root is embedded into statement, so replacement is copied into it
+    if(root != expr) *expr = *root;
+
+    return 0;
+}
+
+
+// optimize expressions of list
+// return 0 on success, non-0 on error
+sint8 exproptimize_expr_list(exproptimize_state *os, parser_ast_expr_list *list)
+{
+    for(; NULL != list; list = list->next)
+    {
+        if(exproptimize_expr((handle)os, list->named ? &list->named_expr.expr : &list->expr) != 0) return -1;
+    }
+
+    return 0;
+}
+
+
+sint8 exproptimize_select(exproptimize_state *os, parser_ast_select *stmt);
+
+
+// optimize expressions of single select, it is a separate name scope
+// return 0 on success, non-0 on error
+sint8 exproptimize_single_select(exproptimize_state *os, parser_ast_single_select *stmt)
+{
+    parser_ast_from *from;
+
+    // subqueries first, so their nodes are not merged with nodes of this select
+    for(from = stmt->from; NULL != from; from = from->next)
+    {
+        if(from->type == PARSER_FROM_TYPE_SUBQUERY && exproptimize_select(os, &from->subquery) != 0) return -1;
+    }
+
+    exproptimize_reset((handle)os);
+
+    for(from = stmt->from; NULL != from; from = from->next)
+    {
+        if(NULL != from->on_expr && exproptimize_expr((handle)os, from->on_expr) != 0) return -1;
+    }
+
+    if(NULL != stmt->where && exproptimize_expr((handle)os, stmt->where) != 0) return -1;
+    if(exproptimize_expr_list(os, stmt->projection) != 0) return -1;
+    if(exproptimize_expr_list(os, stmt->group_by) != 0) return -1;
+    if(exproptimize_expr_list(os, stmt->having) != 0) return -1;
+
+    return 0;
+}
+
+
+// optimize expressions of full select
+// return 0 on success, non-0 on error
+sint8 exproptimize_select(exproptimize_state *os, parser_ast_select *stmt)
+{
+    parser_ast_select *select;
+    parser_ast_order_by *order_by;
+
+    for(select = stmt; NULL != select; select = select->next)
+    {
+        if(exproptimize_single_select(os, &select->select) != 0) return -1;
+
+        // order by refers to the result of the whole select
+        if(NULL != select->order_by)
+        {
+            exproptimize_reset((handle)os);
+            for(order_by = select->order_by; NULL != order_by; order_by = order_by->next)
+            {
+                if(exproptimize_expr((handle)os, &order_by->expr) != 0) return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+
+// optimize check expression of constraint
+// return 0 on success, non-0 on error
+sint8 exproptimize_constr(exproptimize_state *os, parser_ast_constr *constr)
+{
+    if(constr->type != PARSER_CONSTRAINT_TYPE_CHECK) return 0;
+
+    exproptimize_reset((handle)os);
+
+    return exproptimize_expr((handle)os, &constr->expr);
+}
+
+
+// optimize all expressions of statement stmt in place
+sint8 exproptimize_stmt(handle oh, parser_ast_stmt *stmt)
+{
+    exproptimize_state *os = (exproptimize_state *)oh;
+    parser_ast_set_list *set;
+    parser_ast_col_desc_list *col;
+    parser_ast_constr_list *constr;
+
+    exproptimize_reset(oh);
+
+    switch(stmt->type)
+    {
+        case PARSER_STMT_TYPE_SELECT:
+            return exproptimize_select(os, &stmt->select_stmt);
+
+        case PARSER_STMT_TYPE_INSERT:
+            if(stmt->insert_stmt.type == PARSER_STMT_TYPE_INSERT_SELECT) return exproptimize_select(os, &stmt->insert_stmt.select_stmt);
+            return exproptimize_expr_list(os, &stmt->insert_stmt.values);
+
+        case PARSER_STMT_TYPE_UPDATE:
+            for(set = &stmt->update_stmt.set_list; NULL != set; set = set->next)
+            {
+                if(exproptimize_expr(oh, &set->expr) != 0) return -1;
+            }
+            if(NULL != stmt->update_stmt.where) return exproptimize_expr(oh, stmt->update_stmt.where);
+            return 0;
+
+        case PARSER_STMT_TYPE_DELETE:
+            if(NULL != stmt->delete_stmt.where) return exproptimize_expr(oh, stmt->delete_stmt.where);
+            return 0;
+
+        case PARSER_STMT_TYPE_CREATE_TABLE:
+            for(col = &stmt->create_table_stmt.cols; NULL != col; col = col->next)
+            {
+                if(NULL != col->col_desc.default_value && exproptimize_expr(oh, col->col_desc.default_value) != 0) return -1;
+            }
+            for(constr = stmt->create_table_stmt.constr; NULL != constr; constr = constr->next)
+            {
+                if(exproptimize_constr(os, &constr->constr) != 0) return -1;
+            }
+            return 0;
+
+        case PARSER_STMT_TYPE_ALTER_TABLE:
+            switch(stmt->alter_table_stmt.type)
+            {
+                case PARSER_STMT_TYPE_ALTER_TABLE_ADD_COL:
+                case PARSER_STMT_TYPE_ALTER_TABLE_MODIFY_COL:
+                    if(NULL != stmt->alter_table_stmt.column.default_expr) return exproptimize_expr(oh, stmt->alter_table_stmt.column.default_expr);
+                    return 0;
+                case PARSER_STMT_TYPE_ALTER_TABLE_ADD_CONSTR:
+                    return exproptimize_constr(os, &stmt->alter_table_stmt.add_constr);
+                default:
+                    return 0;
+            }
+
+        default:
+            return 0;
+    }
+}
@@ -0,0 +1,1079 @@
+#include "execution/exprvm.h"
+#include "execution/expression.h"
+#include "common/decimal.h"
+#include "common/error.h"
+#include "common/string_literal.h"
+#include "common/strmatch.h"
+#include <assert.h>
+#include <string.h>
+
+
+#define EXPRVM_REG_FREE             (0)     // register was never used
+#define EXPRVM_REG_TAKEN            (1)
+#define EXPRVM_REG_RELEASED         (2)     // temporary register which can be reused by another temporary
+
+#define EXPRVM_TYPE_UNKNOWN         ((parser_expr_node_type)0)
+#define EXPRVM_IS_NUMERIC_TYPE(t)   ((t) == PARSER_EXPR_NODE_TYPE_INT || (t) == PARSER_EXPR_NODE_TYPE_NUM || (t) == PARSER_EXPR_NODE_TYPE_FLOAT)
+#define EXPRVM_IS_NUMERIC(v)        EXPRVM_IS_NUMERIC_TYPE((v)->type)
+#define EXPRVM_IS_LOGICAL(v)        ((v)->type == PARSER_EXPR_NODE_TYPE_BOOL || (v)->type == PARSER_EXPR_NODE_TYPE_NULL)
+#define EXPRVM_OPERAND(regs, row, x) (((x) & EXPRVM_ROW_SLOT) ? (row) + ((x) & ~EXPRVM_ROW_SLOT) : (regs) + (x))
+
+
+// operation node of expression, node can be referenced several times when equal subexpressions are merged
+typedef struct _exprvm_node_ref
+{
+    const parser_ast_expr   *node;
+    uint16                  refs;           // references which are not compiled yet
+    uint16                  operand;        // register holding value of the node once it is compiled
+    parser_expr_node_type   type;
+    uint8                   compiled;
+} exprvm_node_ref;
+
+
+// compiled program
+typedef struct _exprvm_program
+{
+    uint16          instr_num;
+    uint16          node_num;                           // compilation only
+    uint16          branch_depth;                       // compilation only: number of enclosing short-circuit operands
+    uint32          pattern_used;                       // compilation only: bytes taken in patterns
+    uint8           reg_state[EXPRVM_MAX_REGISTERS];    // compilation only: one of EXPRVM_REG_*
+    exprvm_node_ref nodes[EXPRVM_MAX_INSTRUCTIONS];     // compilation only: operation nodes of expression
+    exprvm_instr    code[EXPRVM_MAX_INSTRUCTIONS];
+    exprvm_value    regs[EXPRVM_MAX_REGISTERS];         // constants and temporary results
+    uint64          patterns[EXPRVM_PATTERN_POOL_SZ / sizeof(uint64)];     // compiled LIKE patterns
+} exprvm_program;
+
+
+// return size of the buffer for compiled program
+size_t exprvm_get_alloc_sz()
+{
+    return sizeof(exprvm_program);
+}
+
+
+// return decimal value of numeric value, integer is converted into buf
+const decimal *exprvm_num_value(const exprvm_value *v, decimal *buf)
+{
+    if(v->type == PARSER_EXPR_NODE_TYPE_INT)
+    {
+        decimal_from_int64(v->integer, buf);
+        return buf;
+    }
+
+    return &v->num;
+}
+
+
+// return floating point value of numeric value
+float64 exprvm_float_value(const exprvm_value *v)
+{
+    switch(v->type)
+    {
+        case PARSER_EXPR_NODE_TYPE_INT: return (float64)v->integer;
+        case PARSER_EXPR_NODE_TYPE_NUM: return decimal_to_float64(&v->num);
+        default: return v->fp;
+    }
+}
+
+
+// return 1 if comparison result cmp satisfies comparison operator op, 0 otherwise
+uint8 exprvm_cmp_result(parser_expr_op_type op, sint32 cmp)
+{
+    switch(op)
+    {
+        case PARSER_EXPR_OP_TYPE_EQ: return cmp == 0;
+        case PARSER_EXPR_OP_TYPE_NE: return cmp != 0;
+        case PARSER_EXPR_OP_TYPE_GT: return cmp > 0;
+        case PARSER_EXPR_OP_TYPE_GE: return cmp >= 0;
+        case PARSER_EXPR_OP_TYPE_LT: return cmp < 0;
+        case PARSER_EXPR_OP_TYPE_LE: return cmp <= 0;
+        default:
+            assert(1 == 0);
+            return 0;
+    }
+}
+
+
+// compare two numeric values
+// return positive if a > b, negative if a < b, 0 otherwise
+sint16 exprvm_num_cmp(const exprvm_value *a, const exprvm_value *b)
+{
+    decimal d1, d2;
+    float64 f1, f2;
+
+    if(a->type == PARSER_EXPR_NODE_TYPE_INT && b->type == PARSER_EXPR_NODE_TYPE_INT)
+    {
+        return (a->integer > b->integer) - (a->integer < b->integer);
+    }
+
+    if(a->type == PARSER_EXPR_NODE_TYPE_FLOAT || b->type == PARSER_EXPR_NODE_TYPE_FLOAT)
+    {
+        f1 = exprvm_float_value(a);
+        f2 = exprvm_float_value(b);
+        return (f1 > f2) - (f1 < f2);
+    }
+
+    return decimal_cmp(exprvm_num_value(a, &d1), exprvm_num_value(b, &d2));
+}
+
+
+// calculate arithmetic operation op over numeric values a and b, put result to d
+// integers stay integers while result fits in sint64, otherwise decimal is used
+// float operand makes the result float
+// return 0 on success, non-0 on error
+sint8 exprvm_calc_arithmetic(parser_expr_op_type op, const exprvm_value *a, const exprvm_value *b, exprvm_value *d)
+{
+    decimal d1, d2;
+    const decimal *pd1, *pd2;
+    sint64 ires;
+    uint8 overflow = 1;
+
+    if(a->type == PARSER_EXPR_NODE_TYPE_FLOAT || b->type == PARSER_EXPR_NODE_TYPE_FLOAT)
+    {
+        d->type = PARSER_EXPR_NODE_TYPE_FLOAT;
+        return expression_float_op(op, exprvm_float_value(a), exprvm_float_value(b), &d->fp);
+    }
+
+    if(a->type == PARSER_EXPR_NODE_TYPE_INT && b->type == PARSER_EXPR_NODE_TYPE_INT)
+    {
+        switch(op)
+        {
+            case PARSER_EXPR_OP_TYPE_MUL:
+                overflow = __builtin_mul_overflow(a->integer, b->integer, &ires);
+                break;
+            case PARSER_EXPR_OP_TYPE_ADD:
+                overflow = __builtin_add_overflow(a->integer, b->integer, &ires);
+                break;
+            case PARSER_EXPR_OP_TYPE_SUB:
+                overflow = __builtin_sub_overflow(a->integer, b->integer, &ires);
+                break;
+            default:    // division result is decimal
+                break;
+        }
+
+        if(!overflow)
+        {
+            d->type = PARSER_EXPR_NODE_TYPE_INT;
+            d->integer = ires;
+            return 0;
+        }
+    }
+
+    pd1 = exprvm_num_value(a, &d1);
+    pd2 = exprvm_num_value(b, &d2);
+    d->type = PARSER_EXPR_NODE_TYPE_NUM;
+
+    switch(op)
+    {
+        case PARSER_EXPR_OP_TYPE_MUL:
+            return decimal_mul(pd1, pd2, &d->num);
+        case PARSER_EXPR_OP_TYPE_DIV:
+            return decimal_div(pd1, pd2, &d->num);
+        case PARSER_EXPR_OP_TYPE_ADD:
+            return decimal_add(pd1, pd2, &d->num);
+        case PARSER_EXPR_OP_TYPE_SUB:
+            return decimal_sub(pd1, pd2, &d->num);
+        default:
+            assert(1 == 0);
+            return -1;
+    }
+}
+
+
+// calculate d = a <op> b for any operand types, semantics follow expression_calc_base_expr
+// return 0 on success, non-0 on error
+sint8 exprvm_calc_generic(parser_expr_op_type op, const exprvm_value *a, const exprvm_value *b, exprvm_value *d)
+{
+    sint8 res;
+    uint8 decide = (op == PARSER_EXPR_OP_TYPE_OR);
+    uint8 arg_null = a->type == PARSER_EXPR_NODE_TYPE_NULL || (op != PARSER_EXPR_OP_TYPE_NOT && b->type == PARSER_EXPR_NODE_TYPE_NULL);
+
+    switch(op)
+    {
+        case PARSER_EXPR_OP_TYPE_MUL:
+        case PARSER_EXPR_OP_TYPE_DIV:
+        case PARSER_EXPR_OP_TYPE_ADD:
+        case PARSER_EXPR_OP_TYPE_SUB:
+            if(EXPRVM_IS_NUMERIC(a) && EXPRVM_IS_NUMERIC(b))
+            {
+                return exprvm_calc_arithmetic(op, a, b, d);
+            }
+            else if(arg_null)
+            {
+                d->type = PARSER_EXPR_NODE_TYPE_NULL;
+                return 0;
+            }
+            break;
+        case PARSER_EXPR_OP_TYPE_EQ:
+        case PARSER_EXPR_OP_TYPE_NE:
+        case PARSER_EXPR_OP_TYPE_GT:
+        case PARSER_EXPR_OP_TYPE_GE:
+        case PARSER_EXPR_OP_TYPE_LT:
+        case PARSER_EXPR_OP_TYPE_LE:
+            d->type = PARSER_EXPR_NODE_TYPE_BOOL;
+            if(EXPRVM_IS_NUMERIC(a) && EXPRVM_IS_NUMERIC(b))
+            {
+                d->boolean = exprvm_cmp_result(op, exprvm_num_cmp(a, b));
+                return 0;
+            }
+            else if(a->type == PARSER_EXPR_NODE_TYPE_STR && b->type == PARSER_EXPR_NODE_TYPE_STR)
+            {
+                if(string_literal_byte_compare(a->str, b->str, &res) != 0) return -1;
+                d->boolean = exprvm_cmp_result(op, res);
+                return 0;
+            }
+            else if(arg_null)
+            {
+                d->type = PARSER_EXPR_NODE_TYPE_NULL;
+                return 0;
+            }
+            break;
+        case PARSER_EXPR_OP_TYPE_IS:
+        case PARSER_EXPR_OP_TYPE_IS_NOT:
+            d->type = PARSER_EXPR_NODE_TYPE_BOOL;
+            if(EXPRVM_IS_NUMERIC(a) && EXPRVM_IS_NUMERIC(b))
+            {
+                d->boolean = (0 == exprvm_num_cmp(a, b));
+            }
+            else if(a->type != b->type)
+            {
+                d->boolean = 0;
+            }
+            else if(a->type == PARSER_EXPR_NODE_TYPE_STR)
+            {
+                if(string_literal_byte_compare(a->str, b->str, &res) != 0) return -1;
+                d->boolean = (0 == res);
+            }
+            else if(a->type == PARSER_EXPR_NODE_TYPE_BOOL)
+            {
+                d->boolean = (a->boolean == b->boolean);
+            }
+            else
+            {
+                // both are null
+                d->boolean = 1;
+            }
+
+            if(op == PARSER_EXPR_OP_TYPE_IS_NOT) d->boolean ^= 1;
+            return 0;
+        case PARSER_EXPR_OP_TYPE_NOT:
+            if(a->type == PARSER_EXPR_NODE_TYPE_BOOL)
+            {
+                d->type = PARSER_EXPR_NODE_TYPE_BOOL;
+                d->boolean = a->boolean ^ 1;
+                return 0;
+            }
+            else if(arg_null)
+            {
+                d->type = PARSER_EXPR_NODE_TYPE_NULL;
+                return 0;
+            }
+            break;
+        case PARSER_EXPR_OP_TYPE_LIKE:
+        case PARSER_EXPR_OP_TYPE_NOT_LIKE:
+            // string operand is matched by EXPRVM_OP_LIKE, generic operation is left for null pattern
+            if(arg_null && (EXPRVM_IS_LOGICAL(a) || a->type == PARSER_EXPR_NODE_TYPE_STR))
+            {
+                d->type = PARSER_EXPR_NODE_TYPE_NULL;
+                return 0;
+            }
+            break;
+        case PARSER_EXPR_OP_TYPE_AND:
+        case PARSER_EXPR_OP_TYPE_OR:
+            if(EXPRVM_IS_LOGICAL(a) && EXPRVM_IS_LOGICAL(b))
+            {
+                // false AND null is false, true OR null is true, otherwise null operand gives null
+                if((a->type == PARSER_EXPR_NODE_TYPE_BOOL && a->boolean == decide) || (b->type == PARSER_EXPR_NODE_TYPE_BOOL && b->boolean == decide))
+                {
+                    d->type = PARSER_EXPR_NODE_TYPE_BOOL;
+                    d->boolean = decide;
+                }
+                else if(arg_null)
+                {
+                    d->type = PARSER_EXPR_NODE_TYPE_NULL;
+                }
+                else
+                {
+                    d->type = PARSER_EXPR_NODE_TYPE_BOOL;
+                    d->boolean = decide ^ 1;
+                }
+                return 0;
+            }
+            break;
+        default:
+            break;
+    }
+
+    error_set(ERROR_DATATYPE_MISMATCH);
+    return -1;
+}
+
+
+// take free register, constant can not reuse released temporary register because temporaries are overwritten on evaluation
+// return 0 on success, non-0 if there are no free registers
+sint8 exprvm_alloc_reg(exprvm_program *p, uint16 *reg, uint8 constant)
+{
+    uint16 r;
+
+    for(r = 0; r < EXPRVM_MAX_REGISTERS; r++)
+    {
+        if(p->reg_state[r] == EXPRVM_REG_FREE || (!constant && p->reg_state[r] == EXPRVM_REG_RELEASED))
+        {
+            p->reg_state[r] = EXPRVM_REG_TAKEN;
+            *reg = r;
+            return 0;
+        }
+    }
+
+    error_set(ERROR_EXPRESSION_TOO_COMPLEX);
+    return -1;
+}
+
+
+// release temporary register, constants and row slots are kept
+void exprvm_free_reg(exprvm_program *p, uint16 operand, uint8 temp)
+{
+    if(temp && !(operand & EXPRVM_ROW_SLOT)) p->reg_state[operand] = EXPRVM_REG_RELEASED;
+}
+
+
+// return static type of values of column datatype, EXPRVM_TYPE_UNKNOWN if there is no typed instructions for it
+parser_expr_node_type exprvm_column_type(column_datatype type)
+{
+    switch(type)
+    {
+        case INTEGER:
+        case SMALLINT:
+            return PARSER_EXPR_NODE_TYPE_INT;
+        case FLOAT:
+        case DOUBLE_PRECISION:
+            return PARSER_EXPR_NODE_TYPE_FLOAT;
+        case DECIMAL:
+            return PARSER_EXPR_NODE_TYPE_NUM;
+        case CHARACTER_VARYING:
+            return PARSER_EXPR_NODE_TYPE_STR;
+        default:
+            return EXPRVM_TYPE_UNKNOWN;
+    }
+}
+
+
+// choose instruction code for operation op over operands of static types ta and tb
+exprvm_opcode exprvm_select_opcode(parser_expr_op_type op, parser_expr_node_type ta, parser_expr_node_type tb)
+{
+    if(ta == PARSER_EXPR_NODE_TYPE_INT && tb == PARSER_EXPR_NODE_TYPE_INT)
+    {
+        switch(op)
+        {
+            case PARSER_EXPR_OP_TYPE_MUL: return EXPRVM_OP_MUL_INT;
+            case PARSER_EXPR_OP_TYPE_ADD: return EXPRVM_OP_ADD_INT;
+            case PARSER_EXPR_OP_TYPE_SUB: return EXPRVM_OP_SUB_INT;
+            case PARSER_EXPR_OP_TYPE_EQ: return EXPRVM_OP_EQ_INT;
+            case PARSER_EXPR_OP_TYPE_NE: return EXPRVM_OP_NE_INT;
+            case PARSER_EXPR_OP_TYPE_GT: return EXPRVM_OP_GT_INT;
+            case PARSER_EXPR_OP_TYPE_GE: return EXPRVM_OP_GE_INT;
+            case PARSER_EXPR_OP_TYPE_LT: return EXPRVM_OP_LT_INT;
+            case PARSER_EXPR_OP_TYPE_LE: return EXPRVM_OP_LE_INT;
+            default: break;
+        }
+    }
+    else if(ta == PARSER_EXPR_NODE_TYPE_NUM && tb == PARSER_EXPR_NODE_TYPE_NUM)
+    {
+        switch(op)
+        {
+            case PARSER_EXPR_OP_TYPE_MUL: return EXPRVM_OP_MUL_NUM;
+            case PARSER_EXPR_OP_TYPE_DIV: return EXPRVM_OP_DIV_NUM;
+            case PARSER_EXPR_OP_TYPE_ADD: return EXPRVM_OP_ADD_NUM;
+            case PARSER_EXPR_OP_TYPE_SUB: return EXPRVM_OP_SUB_NUM;
+            case PARSER_EXPR_OP_TYPE_EQ:
+            case PARSER_EXPR_OP_TYPE_NE:
+            case PARSER_EXPR_OP_TYPE_GT:
+            case PARSER_EXPR_OP_TYPE_GE:
+            case PARSER_EXPR_OP_TYPE_LT:
+            case PARSER_EXPR_OP_TYPE_LE:
+                return EXPRVM_OP_CMP_NUM;
+            default: break;
+        }
+    }
+    else if(ta == PARSER_EXPR_NODE_TYPE_FLOAT && tb == PARSER_EXPR_NODE_TYPE_FLOAT)
+    {
+        switch(op)
+        {
+            case PARSER_EXPR_OP_TYPE_MUL: return EXPRVM_OP_MUL_FLT;
+            case PARSER_EXPR_OP_TYPE_DIV: return EXPRVM_OP_DIV_FLT;
+            case PARSER_EXPR_OP_TYPE_ADD: return EXPRVM_OP_ADD_FLT;
+            case PARSER_EXPR_OP_TYPE_SUB: return EXPRVM_OP_SUB_FLT;
+            case PARSER_EXPR_OP_TYPE_EQ:
+            case PARSER_EXPR_OP_TYPE_NE:
+            case PARSER_EXPR_OP_TYPE_GT:
+            case PARSER_EXPR_OP_TYPE_GE:
+            case PARSER_EXPR_OP_TYPE_LT:
+            case PARSER_EXPR_OP_TYPE_LE:
+                return EXPRVM_OP_CMP_FLT;
+            default: break;
+        }
+    }
+
+    return (exprvm_opcode)op;
+}
+
+
+// infer static type of result of operation op over operands of static types ta and tb
+// return 0 on success, non-0 if operand types are incompatible with operation
+sint8 exprvm_result_type(parser_expr_op_type op, parser_expr_node_type ta, parser_expr_node_type tb, parser_expr_node_type *type)
+{
+    uint8 known = (ta != EXPRVM_TYPE_UNKNOWN && tb != EXPRVM_TYPE_UNKNOWN);
+
+    switch(op)
+    {
+        case PARSER_EXPR_OP_TYPE_MUL:
+        case PARSER_EXPR_OP_TYPE_DIV:
+        case PARSER_EXPR_OP_TYPE_ADD:
+        case PARSER_EXPR_OP_TYPE_SUB:
+            if(known && !(EXPRVM_IS_NUMERIC_TYPE(ta) && EXPRVM_IS_NUMERIC_TYPE(tb))) break;
+
+            if(ta == PARSER_EXPR_NODE_TYPE_FLOAT || tb == PARSER_EXPR_NODE_TYPE_FLOAT)
+            {
+                *type = PARSER_EXPR_NODE_TYPE_FLOAT;
+            }
+            else if(!known)
+            {
+                *type = EXPRVM_TYPE_UNKNOWN;
+            }
+            else if(ta == PARSER_EXPR_NODE_TYPE_INT && tb == PARSER_EXPR_NODE_TYPE_INT && op != PARSER_EXPR_OP_TYPE_DIV)
+            {
+                // integer overflow makes decimal, typed instruction checks it at runtime
+                *type = PARSER_EXPR_NODE_TYPE_INT;
+            }
+            else
+            {
+                *type = PARSER_EXPR_NODE_TYPE_NUM;
+            }
+            return 0;
+
+        case PARSER_EXPR_OP_TYPE_EQ:
+        case PARSER_EXPR_OP_TYPE_NE:
+        case PARSER_EXPR_OP_TYPE_GT:
+        case PARSER_EXPR_OP_TYPE_GE:
+        case PARSER_EXPR_OP_TYPE_LT:
+        case PARSER_EXPR_OP_TYPE_LE:
+            if(known && !(EXPRVM_IS_NUMERIC_TYPE(ta) && EXPRVM_IS_NUMERIC_TYPE(tb))
+                    && !(ta == PARSER_EXPR_NODE_TYPE_STR && tb == PARSER_EXPR_NODE_TYPE_STR)) break;
+            *type = PARSER_EXPR_NODE_TYPE_BOOL;
+            return 0;
+
+        case PARSER_EXPR_OP_TYPE_IS:
+        case PARSER_EXPR_OP_TYPE_IS_NOT:
+            *type = PARSER_EXPR_NODE_TYPE_BOOL;
+            return 0;
+
+        case PARSER_EXPR_OP_TYPE_LIKE:
+        case PARSER_EXPR_OP_TYPE_NOT_LIKE:
+            if((ta != EXPRVM_TYPE_UNKNOWN && ta != PARSER_EXPR_NODE_TYPE_STR)
+                    || (tb != EXPRVM_TYPE_UNKNOWN && tb != PARSER_EXPR_NODE_TYPE_STR)) break;
+            *type = PARSER_EXPR_NODE_TYPE_BOOL;
+            return 0;
+
+        case PARSER_EXPR_OP_TYPE_NOT:
+            if(ta != EXPRVM_TYPE_UNKNOWN && ta != PARSER_EXPR_NODE_TYPE_BOOL) break;
+            *type = PARSER_EXPR_NODE_TYPE_BOOL;
+            return 0;
+
+        case PARSER_EXPR_OP_TYPE_AND:
+        case PARSER_EXPR_OP_TYPE_OR:
+            if((ta != EXPRVM_TYPE_UNKNOWN && ta != PARSER_EXPR_NODE_TYPE_BOOL)
+                    || (tb != EXPRVM_TYPE_UNKNOWN && tb != PARSER_EXPR_NODE_TYPE_BOOL)) break;
+            *type = PARSER_EXPR_NODE_TYPE_BOOL;
+            return 0;
+
+        default:
+            break;
+    }
+
+    error_set(ERROR_DATATYPE_MISMATCH);
+    return -1;
+}
+
+
+// infer static type of expression subtree expr
+// return 0 on success, non-0 on error
+sint8 exprvm_infer_node(const parser_ast_expr *expr, exprvm_interface *vi, parser_expr_node_type *type)
+{
+    parser_expr_node_type ta, tb = EXPRVM_TYPE_UNKNOWN;
+    column_datatype coltype;
+    uint16 slot;
+
+    switch(expr->node_type)
+    {
+        case PARSER_EXPR_NODE_TYPE_NAME:
+            if(vi->resolve_name(&expr->name, &slot, &coltype) != 0)
+            {
+                error_set(ERROR_SEMANTIC_ERROR);
+                return -1;
+            }
+            *type = exprvm_column_type(coltype);
+            return 0;
+
+        case PARSER_EXPR_NODE_TYPE_OP:
+            // type of pattern with ESCAPE character is type of the pattern
+            if(expr->op == PARSER_EXPR_OP_TYPE_ESCAPE) return exprvm_infer_node(expr->left, vi, type);
+
+            if(exprvm_infer_node(expr->left, vi, &ta) != 0) return -1;
+
+            // a BETWEEN lo AND hi is a >= lo AND a <= hi
+            if(expr->op == PARSER_EXPR_OP_TYPE_BETWEEN)
+            {
+                if(expr->right->node_type != PARSER_EXPR_NODE_TYPE_OP || expr->right->op != PARSER_EXPR_OP_TYPE_AND)
+                {
+                    error_set(ERROR_SEMANTIC_ERROR);
+                    return -1;
+                }
+                if(exprvm_infer_node(expr->right->left, vi, &tb) != 0) return -1;
+                if(exprvm_result_type(PARSER_EXPR_OP_TYPE_GE, ta, tb, type) != 0) return -1;
+                if(exprvm_infer_node(expr->right->right, vi, &tb) != 0) return -1;
+                return exprvm_result_type(PARSER_EXPR_OP_TYPE_LE, ta, tb, type);
+            }
+
+            if(expr->op != PARSER_EXPR_OP_TYPE_NOT && exprvm_infer_node(expr->right, vi, &tb) != 0) return -1;
+            return exprvm_result_type(expr->op, ta, tb, type);
+
+        case PARSER_EXPR_NODE_TYPE_NULL:
+            *type = EXPRVM_TYPE_UNKNOWN;
+            return 0;
+
+        default:
+            *type = expr->node_type;
+            return 0;
+    }
+}
+
+
+// infer static type of expression expr
+sint8 exprvm_infer_type(const parser_ast_expr *expr, exprvm_interface vi, parser_expr_node_type *type)
+{
+    return exprvm_infer_node(expr, &vi, type);
+}
+
+
+// return reference of operation node expr, NULL if node is not counted yet
+exprvm_node_ref *exprvm_find_node(exprvm_program *p, const parser_ast_expr *expr)
+{
+    uint16 i;
+
+    for(i = 0; i < p->node_num; i++)
+    {
+        if(p->nodes[i].node == expr) return p->nodes + i;
+    }
+
+    return NULL;
+}
+
+
+// count references of operation nodes of expression expr, shared node is counted once per parent
+// return 0 on success, non-0 if there are too many nodes
+sint8 exprvm_count_refs(exprvm_program *p, const parser_ast_expr *expr)
+{
+    exprvm_node_ref *ref;
+
+    if(expr->node_type != PARSER_EXPR_NODE_TYPE_OP) return 0;
+
+    if(NULL != (ref = exprvm_find_node(p, expr)))
+    {
+        ref->refs++;
+        return 0;
+    }
+
+    if(p->node_num >= EXPRVM_MAX_INSTRUCTIONS)
+    {
+        error_set(ERROR_EXPRESSION_TOO_COMPLEX);
+        return -1;
+    }
+
+    ref = p->nodes + p->node_num++;
+    ref->node = expr;
+    ref->refs = 1;
+    ref->compiled = 0;
+
+    // pattern of LIKE is a constant compiled with its node, AND node of BETWEEN bounds is not compiled itself
+    if(exprvm_count_refs(p, expr->left) != 0) return -1;
+    if(expr->op == PARSER_EXPR_OP_TYPE_NOT || expr->op == PARSER_EXPR_OP_TYPE_LIKE || expr->op == PARSER_EXPR_OP_TYPE_NOT_LIKE) return 0;
+
+    if(expr->op == PARSER_EXPR_OP_TYPE_BETWEEN && expr->right->node_type == PARSER_EXPR_NODE_TYPE_OP)
+    {
+        if(exprvm_count_refs(p, expr->right->left) != 0) return -1;
+        return exprvm_count_refs(p, expr->right->right);
+    }
+
+    return exprvm_count_refs(p, expr->right);
+}
+
+
+sint8 exprvm_compile_node(exprvm_program *p, const parser_ast_expr *expr, exprvm_interface *vi,
+                          uint16 *operand, uint8 *temp, parser_expr_node_type *type);
+
+
+// append instruction of operation op over operands a and b of static types ta and tb,
+// result is put to a new temporary register, so operands are released by caller after the call
+// return 0 on success, non-0 on error
+sint8 exprvm_add_instr(exprvm_program *p, parser_expr_op_type op, uint16 a, parser_expr_node_type ta,
+                       uint16 b, parser_expr_node_type tb, uint16 *operand, parser_expr_node_type *type)
+{
+    exprvm_instr *instr;
+
+    if(p->instr_num >= EXPRVM_MAX_INSTRUCTIONS - 1)
+    {
+        error_set(ERROR_EXPRESSION_TOO_COMPLEX);
+        return -1;
+    }
+
+    if(exprvm_alloc_reg(p, operand, 0) != 0) return -1;
+
+    instr = p->code + p->instr_num++;
+    instr->opcode = exprvm_select_opcode(op, ta, tb);
+    instr->op = op;
+    instr->dst = *operand;
+    instr->a = a;
+    instr->b = b;
+
+    return exprvm_result_type(op, ta, tb, type);
+}
+
+
+// compile BETWEEN node expr: a BETWEEN lo AND hi is a >= lo AND a <= hi, a is kept until both comparisons are done
+// return 0 on success, non-0 on error
+sint8 exprvm_compile_between(exprvm_program *p, const parser_ast_expr *expr, exprvm_interface *vi,
+                             uint16 *operand, parser_expr_node_type *type)
+{
+    uint16 a, lo, hi, ge, le;
+    uint8 temp_a, temp_lo, temp_hi;
+    parser_expr_node_type ta, tlo, thi, tge, tle;
+
+    if(expr->right->node_type != PARSER_EXPR_NODE_TYPE_OP || expr->right->op != PARSER_EXPR_OP_TYPE_AND)
+    {
+        error_set(ERROR_SEMANTIC_ERROR);
+        return -1;
+    }
+
+    if(exprvm_compile_node(p, expr->left, vi, &a, &temp_a, &ta) != 0) return -1;
+
+    if(exprvm_compile_node(p, expr->right->left, vi, &lo, &temp_lo, &tlo) != 0) return -1;
+    if(exprvm_add_instr(p, PARSER_EXPR_OP_TYPE_GE, a, ta, lo, tlo, &ge, &tge) != 0) return -1;
+    exprvm_free_reg(p, lo, temp_lo);
+
+    if(exprvm_compile_node(p, expr->right->right, vi, &hi, &temp_hi, &thi) != 0) return -1;
+    if(exprvm_add_instr(p, PARSER_EXPR_OP_TYPE_LE, a, ta, hi, thi, &le, &tle) != 0) return -1;
+    exprvm_free_reg(p, hi, temp_hi);
+    exprvm_free_reg(p, a, temp_a);
+
+    if(exprvm_add_instr(p, PARSER_EXPR_OP_TYPE_AND, ge, tge, le, tle, operand, type) != 0) return -1;
+    exprvm_free_reg(p, ge, 1);
+    exprvm_free_reg(p, le, 1);
+
+    return 0;
+}
+
+
+// compile AND/OR node expr: left operand, jump over right operand if left one decides the result, right operand, operation
+// return 0 on success, non-0 on error
+sint8 exprvm_compile_short_circuit(exprvm_program *p, const parser_ast_expr *expr, exprvm_interface *vi,
+                                   uint16 *operand, parser_expr_node_type *type)
+{
+    uint16 a, b, jump;
+    uint8 temp_a, temp_b;
+    parser_expr_node_type ta, tb;
+    exprvm_instr *instr;
+
+    if(exprvm_compile_node(p, expr->left, vi, &a, &temp_a, &ta) != 0) return -1;
+
+    if(p->instr_num >= EXPRVM_MAX_INSTRUCTIONS - 1)
+    {
+        error_set(ERROR_EXPRESSION_TOO_COMPLEX);
+        return -1;
+    }
+
+    // result register is taken before right operand is compiled, so the jump result is not overwritten
+    if(exprvm_alloc_reg(p, operand, 0) != 0) return -1;
+
+    jump = p->instr_num++;
+    instr = p->code + jump;
+    instr->opcode = expr->op == PARSER_EXPR_OP_TYPE_AND ? EXPRVM_OP_JUMP_FALSE : EXPRVM_OP_JUMP_TRUE;
+    instr->op = expr->op;
+    instr->dst = *operand;
+    instr->a = a;
+
+    p->branch_depth++;
+    if(exprvm_compile_node(p, expr->right, vi, &b, &temp_b, &tb) != 0) return -1;
+    p->branch_depth--;
+
+    if(p->instr_num >= EXPRVM_MAX_INSTRUCTIONS - 1)
+    {
+        error_set(ERROR_EXPRESSION_TOO_COMPLEX);
+        return -1;
+    }
+
+    exprvm_free_reg(p, a, temp_a);
+    exprvm_free_reg(p, b, temp_b);
+
+    instr = p->code + p->instr_num++;
+    instr->opcode = expr->op;
+    instr->op = expr->op;
+    instr->dst = *operand;
+    instr->a = a;
+    instr->b = b;
+
+    p->code[jump].b = p->instr_num;
+
+    return exprvm_result_type(expr->op, ta, tb, type);
+}
+
+
+sint8 exprvm_compile_pattern(const parser_ast_expr *expr, uint8 *pool, uint32 pool_sz, uint32 *used, uint16 *offset,
+                             const parser_ast_expr **null_operand)
+{
+    parser_ast_expr *pattern, *escape;
+    uint64 pattern_sz, sz;
+    uint32 start = (*used + 7) & ~7u;
+
+    expression_like_operands(expr, &pattern, &escape);
+
+    *null_operand = NULL;
+    if(pattern->node_type == PARSER_EXPR_NODE_TYPE_NULL) *null_operand = pattern;
+    if(NULL != escape && escape->node_type == PARSER_EXPR_NODE_TYPE_NULL) *null_operand = escape;
+    if(NULL != *null_operand) return 0;
+
+    if(pattern->node_type != PARSER_EXPR_NODE_TYPE_STR || (NULL != escape && escape->node_type != PARSER_EXPR_NODE_TYPE_STR))
+    {
+        error_set(pattern->node_type == PARSER_EXPR_NODE_TYPE_OP || pattern->node_type == PARSER_EXPR_NODE_TYPE_NAME
+                  || (NULL != escape && (escape->node_type == PARSER_EXPR_NODE_TYPE_OP || escape->node_type == PARSER_EXPR_NODE_TYPE_NAME))
+                  ? ERROR_SEMANTIC_ERROR : ERROR_DATATYPE_MISMATCH);
+        return -1;
+    }
+
+    if(string_literal_byte_length(pattern->str, &pattern_sz) != 0) return -1;
+
+    sz = strmatch_get_alloc_sz(pattern_sz);
+    if(start > pool_sz || sz > pool_sz - start)
+    {
+        error_set(ERROR_EXPRESSION_TOO_COMPLEX);
+        return -1;
+    }
+
+    if(strmatch_compile_literal(pool + start, pattern->str, NULL == escape ? NULL : escape->str) == NULL) return -1;
+
+    *offset = (uint16)start;
+    *used = start + (uint32)sz;
+    return 0;
+}
+
+
+// compile LIKE node expr: string operand, then match against pattern compiled into pattern pool,
+// null pattern or escape character is loaded as operand b of generic operation which gives null
+// return 0 on success, non-0 on error
+sint8 exprvm_compile_like(exprvm_program *p, const parser_ast_expr *expr, exprvm_interface *vi,
+                          uint16 *operand, parser_expr_node_type *type)
+{
+    uint16 a, b = 0;
+    uint8 temp_a, temp_b;
+    parser_expr_node_type ta, tb = PARSER_EXPR_NODE_TYPE_STR;
+    const parser_ast_expr *null_operand;
+    exprvm_instr *instr;
+
+    if(exprvm_compile_node(p, expr->left, vi, &a, &temp_a, &ta) != 0) return -1;
+    if(exprvm_compile_pattern(expr, (uint8 *)p->patterns, EXPRVM_PATTERN_POOL_SZ, &p->pattern_used, &b, &null_operand) != 0) return -1;
+    if(NULL != null_operand && exprvm_compile_node(p, null_operand, vi, &b, &temp_b, &tb) != 0) return -1;
+
+    if(p->instr_num >= EXPRVM_MAX_INSTRUCTIONS - 1)
+    {
+        error_set(ERROR_EXPRESSION_TOO_COMPLEX);
+        return -1;
+    }
+
+    if(exprvm_alloc_reg(p, operand, 0) != 0) return -1;
+    exprvm_free_reg(p, a, temp_a);
+
+    instr = p->code + p->instr_num++;
+    instr->opcode = (NULL == null_operand) ? EXPRVM_OP_LIKE : expr->op;
+    instr->op = expr->op;
+    instr->dst = *operand;
+    instr->a = a;
+    instr->b = b;
+
+    return exprvm_result_type(expr->op, ta, tb, type);
+}
+
+
+// compile expression subtree expr, set operand to register or row slot holding its value
+// shared operation node is compiled once, its register is kept until the last reference is compiled
+// temp is set to 1 if operand is temporary register which can be reused after it is consumed
+// return 0 on success, non-0 on error
+sint8 exprvm_compile_node(exprvm_program *p, const parser_ast_expr *expr, exprvm_interface *vi,
+                          uint16 *operand, uint8 *temp, parser_expr_node_type *type)
+{
+    uint16 a, b = 0, slot;
+    uint8 temp_a, temp_b = 0;
+    parser_expr_node_type ta, tb = EXPRVM_TYPE_UNKNOWN;
+    column_datatype coltype;
+    exprvm_value *v;
+    exprvm_node_ref *ref;
+
+    *temp = 0;
+
+    switch(expr->node_type)
+    {
+        case PARSER_EXPR_NODE_TYPE_NAME:
+            if(vi->resolve_name(&expr->name, &slot, &coltype) != 0)
+            {
+                error_set(ERROR_SEMANTIC_ERROR);
+                return -1;
+            }
+            *operand = slot | EXPRVM_ROW_SLOT;
+            *type = exprvm_column_type(coltype);
+            return 0;
+
+        case PARSER_EXPR_NODE_TYPE_OP:
+            ref = exprvm_find_node(p, expr);
+            ref->refs--;
+            if(ref->compiled)
+            {
+                *operand = ref->operand;
+                *temp = ref->refs == 0;
+                *type = ref->type;
+                return 0;
+            }
+
+            if(expr->op == PARSER_EXPR_OP_TYPE_AND || expr->op == PARSER_EXPR_OP_TYPE_OR)
+            {
+                if(exprvm_compile_short_circuit(p, expr, vi, operand, type) != 0) return -1;
+            }
+            else if(expr->op == PARSER_EXPR_OP_TYPE_LIKE || expr->op == PARSER_EXPR_OP_TYPE_NOT_LIKE)
+            {
+                if(exprvm_compile_like(p, expr, vi, operand, type) != 0) return -1;
+            }
+            else if(expr->op == PARSER_EXPR_OP_TYPE_BETWEEN)
+            {
+                if(exprvm_compile_between(p, expr, vi, operand, type) != 0) return -1;
+            }
+            else
+            {
+                if(exprvm_compile_node(p, expr->left, vi, &a, &temp_a, &ta) != 0) return -1;
+                if(expr->op != PARSER_EXPR_OP_TYPE_NOT)
+                {
+                    if(exprvm_compile_node(p, expr->right, vi, &b, &temp_b, &tb) != 0) return -1;
+                }
+
+                // result register must differ from operands, so operands are released after it is taken
+                if(exprvm_add_instr(p, expr->op, a, ta, b, tb, operand, type) != 0) return -1;
+                exprvm_free_reg(p, a, temp_a);
+                exprvm_free_reg(p, b, temp_b);
+            }
+
+            // value computed under short-circuit operand may be skipped, so it is not reused outside of it
+            *temp = ref->refs == 0 || p->branch_depth > 0;
+            if(p->branch_depth == 0)
+            {
+                ref->compiled = 1;
+                ref->operand = *operand;
+                ref->type = *type;
+            }
+            return 0;
+
+        case PARSER_EXPR_NODE_TYPE_NUM:
+        case PARSER_EXPR_NODE_TYPE_INT:
+        case PARSER_EXPR_NODE_TYPE_FLOAT:
+        case PARSER_EXPR_NODE_TYPE_STR:
+        case PARSER_EXPR_NODE_TYPE_BOOL:
+        case PARSER_EXPR_NODE_TYPE_NULL:
+            // constant is loaded once and is never overwritten
+            if(exprvm_alloc_reg(p, operand, 1) != 0) return -1;
+            v = p->regs + *operand;
+            v->type = expr->node_type;
+            switch(expr->node_type)
+            {
+                case PARSER_EXPR_NODE_TYPE_NUM: v->num = expr->num; break;
+                case PARSER_EXPR_NODE_TYPE_INT: v->integer = expr->integer; break;
+                case PARSER_EXPR_NODE_TYPE_FLOAT: v->fp = expr->fp; break;
+                case PARSER_EXPR_NODE_TYPE_STR: v->str = expr->str; break;
+                case PARSER_EXPR_NODE_TYPE_BOOL: v->boolean = expr->boolean; break;
+                default: break;
+            }
+            *type = expr->node_type == PARSER_EXPR_NODE_TYPE_NULL ? EXPRVM_TYPE_UNKNOWN : expr->node_type;
+            return 0;
+
+        default:
+            error_set(ERROR_SEMANTIC_ERROR);
+            return -1;
+    }
+}
+
+
+// compile expression expr into program using buffer buf
+handle exprvm_compile(void *buf, const parser_ast_expr *expr, exprvm_interface vi)
+{
+    exprvm_program *p = (exprvm_program *)buf;
+    exprvm_instr *instr;
+    parser_expr_node_type type;
+    uint16 operand;
+    uint8 temp;
+
+    if(NULL == p) return NULL;
+
+    p->instr_num = 0;
+    p->node_num = 0;
+    p->branch_depth = 0;
+    p->pattern_used = 0;
+    memset(p->reg_state, EXPRVM_REG_FREE, sizeof(p->reg_state));
+
+    if(exprvm_count_refs(p, expr) != 0) return NULL;
+    if(exprvm_compile_node(p, expr, &vi, &operand, &temp, &type) != 0) return NULL;
+
+    instr = p->code + p->instr_num++;
+    instr->opcode = EXPRVM_OP_RET;
+    instr->a = operand;
+    instr->b = 0;
+
+    return (handle)p;
+}
+
+
+// typed integer arithmetic, falls back to generic operation on NULL or overflow
+#define EXPRVM_INT_ARITH(builtin) \
+    if(a->type == PARSER_EXPR_NODE_TYPE_INT && b->type == PARSER_EXPR_NODE_TYPE_INT \
+            && !builtin(a->integer, b->integer, &d->integer)) \
+    { \
+        d->type = PARSER_EXPR_NODE_TYPE_INT; \
+        break; \
+    } \
+    if(exprvm_calc_generic(ip->op, a, b, d) != 0) return -1; \
+    break;
+
+// typed integer comparison, falls back to generic operation on NULL
+#define EXPRVM_INT_CMP(cmp) \
+    if(a->type == PARSER_EXPR_NODE_TYPE_INT && b->type == PARSER_EXPR_NODE_TYPE_INT) \
+    { \
+        d->type = PARSER_EXPR_NODE_TYPE_BOOL; \
+        d->boolean = (a->integer cmp b->integer); \
+        break; \
+    } \
+    if(exprvm_calc_generic(ip->op, a, b, d) != 0) return -1; \
+    break;
+
+// typed float arithmetic, falls back to generic operation on NULL
+#define EXPRVM_FLT_ARITH \
+    if(a->type == PARSER_EXPR_NODE_TYPE_FLOAT && b->type == PARSER_EXPR_NODE_TYPE_FLOAT) \
+    { \
+        d->type = PARSER_EXPR_NODE_TYPE_FLOAT; \
+        if(expression_float_op(ip->op, a->fp, b->fp, &d->fp) != 0) return -1; \
+        break; \
+    } \
+    if(exprvm_calc_generic(ip->op, a, b, d) != 0) return -1; \
+    break;
+
+// typed decimal arithmetic, falls back to generic operation on NULL
+#define EXPRVM_NUM_ARITH(fun) \
+    if(a->type == PARSER_EXPR_NODE_TYPE_NUM && b->type == PARSER_EXPR_NODE_TYPE_NUM) \
+    { \
+        d->type = PARSER_EXPR_NODE_TYPE_NUM; \
+        if(fun(&a->num, &b->num, &d->num) != 0) return -1; \
+        break; \
+    } \
+    if(exprvm_calc_generic(ip->op, a, b, d) != 0) return -1; \
+    break;
+
+
+// evaluate program for row
+sint8 exprvm_eval(handle vh, const exprvm_value *row, exprvm_value *result)
+{
+    exprvm_program *p = (exprvm_program *)vh;
+    exprvm_value *regs = p->regs;
+    const exprvm_instr *ip;
+    const exprvm_value *a, *b;
+    exprvm_value *d;
+
+    for(ip = p->code; ; ip++)
+    {
+        a = EXPRVM_OPERAND(regs, row, ip->a);
+        b = EXPRVM_OPERAND(regs, row, ip->b);
+        d = regs + ip->dst;
+
+        switch(ip->opcode)
+        {
+            case EXPRVM_OP_RET:
+                *result = *a;
+                return 0;
+            case EXPRVM_OP_LIKE:
+                if(a->type == PARSER_EXPR_NODE_TYPE_STR)
+                {
+                    if(strmatch_match_literal((handle)((uint8 *)p->patterns + ip->b), a->str, &d->boolean) != 0) return -1;
+                    d->type = PARSER_EXPR_NODE_TYPE_BOOL;
+                    d->boolean ^= (ip->op == PARSER_EXPR_OP_TYPE_NOT_LIKE);
+                }
+                else if(a->type == PARSER_EXPR_NODE_TYPE_NULL)
+                {
+                    d->type = PARSER_EXPR_NODE_TYPE_NULL;
+                }
+                else
+                {
+                    error_set(ERROR_DATATYPE_MISMATCH);
+                    return -1;
+                }
+                break;
+            case EXPRVM_OP_JUMP_FALSE:
+            case EXPRVM_OP_JUMP_TRUE:
+                if(a->type == PARSER_EXPR_NODE_TYPE_BOOL && a->boolean == (ip->opcode == EXPRVM_OP_JUMP_TRUE))
+                {
+                    *d = *a;
+                    ip = p->code + ip->b - 1;
+                }
+                break;
+            case EXPRVM_OP_MUL_INT: EXPRVM_INT_ARITH(__builtin_mul_overflow)
+            case EXPRVM_OP_ADD_INT: EXPRVM_INT_ARITH(__builtin_add_overflow)
+            case EXPRVM_OP_SUB_INT: EXPRVM_INT_ARITH(__builtin_sub_overflow)
+            case EXPRVM_OP_EQ_INT: EXPRVM_INT_CMP(==)
+            case EXPRVM_OP_NE_INT: EXPRVM_INT_CMP(!=)
+            case EXPRVM_OP_GT_INT: EXPRVM_INT_CMP(>)
+            case EXPRVM_OP_GE_INT: EXPRVM_INT_CMP(>=)
+            case EXPRVM_OP_LT_INT: EXPRVM_INT_CMP(<)
+            case EXPRVM_OP_LE_INT: EXPRVM_INT_CMP(<=)
+            case EXPRVM_OP_MUL_NUM: EXPRVM_NUM_ARITH(decimal_mul)
+            case EXPRVM_OP_DIV_NUM: EXPRVM_NUM_ARITH(decimal_div)
+            case EXPRVM_OP_ADD_NUM: EXPRVM_NUM_ARITH(decimal_add)
+            case EXPRVM_OP_SUB_NUM: EXPRVM_NUM_ARITH(decimal_sub)
+            case EXPRVM_OP_CMP_NUM:
+                if(a->type == PARSER_EXPR_NODE_TYPE_NUM && b->type == PARSER_EXPR_NODE_TYPE_NUM)
+                {
+                    d->type = PARSER_EXPR_NODE_TYPE_BOOL;
+                    d->boolean = exprvm_cmp_result(ip->op, decimal_cmp(&a->num, &b->num));
+                    break;
+                }
+                if(exprvm_calc_generic(ip->op, a, b, d) != 0) return -1;
+                break;
+            case EXPRVM_OP_MUL_FLT:
+            case EXPRVM_OP_DIV_FLT:
+            case EXPRVM_OP_ADD_FLT:
+            case EXPRVM_OP_SUB_FLT:
+                EXPRVM_FLT_ARITH
+            case EXPRVM_OP_CMP_FLT:
+                if(a->type == PARSER_EXPR_NODE_TYPE_FLOAT && b->type == PARSER_EXPR_NODE_TYPE_FLOAT)
+                {
+                    d->type = PARSER_EXPR_NODE_TYPE_BOOL;
+                    d->boolean = exprvm_cmp_result(ip->op, (a->fp > b->fp) - (a->fp < b->fp));
+                    break;
+                }
+                if(exprvm_calc_generic(ip->op, a, b, d) != 0) return -1;
+                break;
+            default:
+                if(exprvm_calc_generic(ip->op, a, b, d) != 0) return -1;
+                break;
+        }
+    }
+
+    return 0;
+}
+
+
+// return number of instructions in program
+uint16 exprvm_instr_num(handle vh)
+{
+    return ((exprvm_program *)vh)->instr_num;
+}
@@ -20,6 +20,14 @@ uint8 grigorian_extract_month_of_year(uint64 date);
 // extract and return day of month of certain date
 uint8 grigorian_extract_day_of_month(uint64 date);
 
+// extract year, month of year or day of month of n dates to array of n values
+void grigorian_extract_year_batch(const uint64 *date, uint32 n, uint64 *year);
+void grigorian_extract_month_of_year_batch(const uint64 *date, uint32 n, uint8 *month);
+void grigorian_extract_day_of_month_batch(const uint64 *date, uint32 n, uint8 *day);
+
+// extract year, month of year and day of month of n dates at once
+void grigorian_extract_date_batch(const uint64 *date, uint32 n, uint64 *year, uint8 *month, uint8 *day);
+
 // build date from year, month, day, hour, minute, seconds
 // month is in 0..11, year must be > 0
 // return 0 on success, non 0 if parameters are invalid
@@ -0,0 +1,58 @@
+#ifndef _CALENDAR_TZINFO
+#define _CALENDAR_TZINFO
+
+// time zone rules
+//
+// a zone is compiled from TZif file of the system time zone database (RFC 8536) into sorted array of periods
+// of constant offset from UTC, local time of a period starts at start + offset, so both UTC and local time
+// are converted by binary search, batch conversion checks the period of the previous value first;
+// rule of TZif footer (POSIX TZ string) is expanded into periods of 400 years after the last transition,
+// later times are moved back by whole 400-year cycles of Gregorian calendar, which repeat the same rules;
+// offsets are kept in minutes as in TIMESTAMP WITH TIME ZONE, seconds of local mean time are dropped;
+// a compiled zone is read only, so it can be shared by threads
+
+#include "defs/defs.h"
+
+typedef struct _tzinfo_zone
+{
+    uint32 n;               // number of periods
+    sint64 *start;          // UTC second since 0001-01-01 each period starts at, the first one starts at 0
+    sint64 *local_start;    // local second each period starts at
+    sint16 *offset;         // offset of local time from UTC in minutes in each period
+    sint64 cycle_start;     // periods after cycle_start repeat every 400 years, 0 if the last period never ends
+    sint64 cycle_end;
+} tzinfo_zone;
+
+// load zone of name, e.g. Europe/Berlin, from directory of time zone database (tz_dir config option)
+// return zone, NULL on error (error code is set)
+tzinfo_zone *tzinfo_load(const achar *name);
+
+// create zone from TZif data of sz bytes
+// return zone, NULL on error (error code is set)
+tzinfo_zone *tzinfo_create(const uint8 *data, uint64 sz);
+
+// create zone from POSIX TZ string, e.g. CET-1CEST,M3.5.0,M10.5.0/3
+// return zone, NULL on error (error code is set)
+tzinfo_zone *tzinfo_create_posix(const achar *tz);
+
+// free memory of zone
+void tzinfo_destroy(tzinfo_zone *zone);
+
+// return offset from UTC in minutes of zone at UTC timestamp ts
+sint16 tzinfo_offset(const tzinfo_zone *zone, uint64 ts);
+
+// convert UTC timestamp ts to local time of zone, tz is set to offset of local time
+// return local timestamp
+uint64 tzinfo_to_local(const tzinfo_zone *zone, uint64 ts, sint16 *tz);
+
+// convert local timestamp ts of zone to UTC, tz is set to offset of local time;
+// local time skipped by zone (clocks set forward) is moved forward by the skipped interval,
+// local time repeated by zone (clocks set back) takes the earlier of the two instants
+// return UTC timestamp
+uint64 tzinfo_to_utc(const tzinfo_zone *zone, uint64 ts, sint16 *tz);
+
+// convert n timestamps at once, fastest when timestamps are sorted
+void tzinfo_to_local_batch(const tzinfo_zone *zone, const uint64 *ts, uint32 n, uint64 *local, sint16 *tz);
+void tzinfo_to_utc_batch(const tzinfo_zone *zone, const uint64 *ts, uint32 n, uint64 *utc, sint16 *tz);
+
+#endif
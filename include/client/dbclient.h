@@ -21,6 +21,7 @@
 // dbclient_connect                |   | C |   |   |   |   |   |   |
 // dbclient_authenticate           |   |   | A |   |   |   |   |   |
 // dbclient_begin_statement        |   |   |   | S |   |   |   |   |
+// dbclient_begin_script           |   |   |   | S |   |   |   |   |
 // dbclient_statement              |   |   |   |   | S |   |   |   |
 // dbclient_finish_statement       |   |   |   |   | E |   |   |   |
 // dbclient_execution_status       |   |   |   |   |   | E |   |   |
@@ -31,8 +32,13 @@
 // dbclient_fetch_row              |   |   |   |   |   |   | F | F |
 // dbclient_next_col_str           |   |   |   |   |   |   |   | F |
 // dbclient_close_recordset        |   |   |   |   |   |   | A | A |
+// dbclient_script_summary         |   |   |   | A |   |   |   |   |
 // dbclient_close_session          |   | D | D | D | D | D | D | D |
 // -----------------------------------------------------------------
+//
+// dbclient_execution_status moves to A when statement result is received,
+// when executing script it stays in E until end of script is received
+// and dbclient_close_recordset moves back to E
 
 
 #include "defs/defs.h"
@@ -51,7 +57,9 @@ typedef enum
     DBCLIENT_RETURN_IN_PROGRESS = 3,    // statement execution is in progress
     DBCLIENT_RETURN_NO_MORE_ROWS = 4,   // end of recordset reached
     DBCLIENT_RETURN_SUCCESS_MSG = 5,    // success with message
-    DBCLIENT_RETURN_SUCCESS_RS = 6      // success with resulting recordset
+    DBCLIENT_RETURN_SUCCESS_RS = 6,     // success with resulting recordset
+    DBCLIENT_RETURN_STMT_FAILED = 7,    // statement failed on server, error message is available
+    DBCLIENT_RETURN_SCRIPT_END = 8      // all results of the script are received
 } dbclient_return_code;
 
 // cell value
@@ -103,6 +111,11 @@ dbclient_return_code dbclient_authenticate(handle session, const char *user, con
 // return DBCLIENT_RETURN_SUCCESS on successful completion or DBCLIENT_RETURN_ERROR on error
 dbclient_return_code dbclient_begin_statement(handle session);
 
+// begin sql script: statements separated with ';' sent and finished as single statement
+// on_error is one of PPROTO_SCRIPT_ON_ERROR_* values
+// return DBCLIENT_RETURN_SUCCESS on successful completion or DBCLIENT_RETURN_ERROR on error
+dbclient_return_code dbclient_begin_script(handle session, uint8 on_error);
+
 // send part of or whole sql statement to server
 // return DBCLIENT_RETURN_SUCCESS on successful completion or DBCLIENT_RETURN_ERROR on error
 dbclient_return_code dbclient_statement(handle session, const uint8 *buf, uint32 len);
@@ -116,6 +129,8 @@ dbclient_return_code dbclient_finish_statement(handle session);
 // or DBCLIENT_RETURN_IN_PROGRESS if statement is in progress
 // or DBCLIENT_RETURN_SUCCESS_MSG if statement completed successfully and there is text message from server
 // or DBCLIENT_RETURN_SUCCESS_RS if statement completed successfully and there is resulting recordset
+// or DBCLIENT_RETURN_STMT_FAILED if statement failed on server
+// or DBCLIENT_RETURN_SCRIPT_END if the script is finished, no more statement results follow
 dbclient_return_code dbclient_execution_status(handle session);
 
 // stop statement execution (or close recordset if statement is complete)
@@ -152,4 +167,7 @@ dbclient_return_code dbclient_close_session(handle session, uint8 force);
 // return message of last error
 char *dbclient_last_error(handle session);
 
+// get numbers of succeeded and failed statements of the last finished script
+void dbclient_script_summary(handle session, uint32 *succeeded, uint32 *failed);
+
 #endif
@@ -21,6 +21,9 @@ handle pproto_client_create(void *ss_buf, int sock);
 // set socket
 void pproto_client_set_sock(handle ss, int sock);
 
+// free data received while sending script which was not read yet
+void pproto_client_discard_held(handle ss);
+
 // read column descriptor in recordset
 // return 0 on success, non 0 otherwise
 sint8 pproto_client_read_recordset_col_desc(handle ss, pproto_col_desc *col_desc);
@@ -111,6 +114,16 @@ sint8 pproto_client_send_goodbye(handle ss);
 // return 0 on success, 1 on error
 sint8 pproto_client_sql_stmt_begin(handle ss);
 
+// start sending sql script: statements separated with ';', on_error is one of PPROTO_SCRIPT_ON_ERROR_* values
+// statement data is sent and finished in the same way as for single statement
+// results received while script is sent are kept and read before the data arriving later
+// return 0 on success, 1 on error
+sint8 pproto_client_sql_script_begin(handle ss, uint8 on_error);
+
+// read end of script message: numbers of succeeded and failed statements
+// return 0 on success, non 0 otherwise
+sint8 pproto_client_read_script_end(handle ss, uint32 *succeeded, uint32 *failed);
+
 // send sql statement data
 // return 0 on success, 1 on error
 sint8 pproto_client_send_sql_stmt(handle ss, const uint8* data, uint32 sz);
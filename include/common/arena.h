@@ -0,0 +1,46 @@
+#ifndef _ARENA_H
+#define _ARENA_H
+
+
+// memory arena: allocated elements never move and are released all at once
+// when in-memory budget is exhausted further chunks are taken from a temporary memory-mapped file
+
+
+#include "defs/defs.h"
+
+
+#define ARENA_MEM_CHUNK_SZ          (64 * 1024)
+#define ARENA_SPILL_CHUNK_SZ        (1024 * 1024)
+#define ARENA_DEFAULT_SPILL_DIR     ("/tmp")
+
+
+// return size of the buffer for arena initialization
+size_t arena_get_alloc_sz();
+
+// create arena using buffer buf
+// not more than mem_budget bytes are taken from heap, the rest is spilled to a file in spill_dir
+// spill_dir must stay valid during the arena lifetime
+// return NULL on error
+handle arena_create(void *buf, uint64 mem_budget, const achar *spill_dir);
+
+// change in-memory budget and spill directory, takes effect on next allocations
+void arena_set_budget(handle ah, uint64 mem_budget, const achar *spill_dir);
+
+// allocate zero-filled element of size sz
+// return pointer to the element or NULL on error (error code is set)
+void *arena_alloc(handle ah, size_t sz);
+
+// release all elements allocated so far
+void arena_reset(handle ah);
+
+// release all resources, buffer of the arena is not freed
+void arena_destroy(handle ah);
+
+// return total number of bytes allocated in memory
+uint64 arena_mem_sz(handle ah);
+
+// return total number of bytes allocated in the spill file
+uint64 arena_spilled_sz(handle ah);
+
+
+#endif
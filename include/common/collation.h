@@ -0,0 +1,56 @@
+#ifndef _COLLATION_H
+#define _COLLATION_H
+
+// string collations and sort keys
+//
+// collation defines order and equality of strings of server encoding:
+//   - binary: bytes are compared as unsigned, shorter string is less than longer string with the same beginning
+//   - ascii_ci: as binary after latin letters A-Z are folded to lower case, other bytes are compared as they are
+//   - codepoint: characters are compared by code point, strings must be valid in server encoding; in UTF-8 and ASCII
+//     byte order is code point order, so valid strings are compared as bytes
+// sort key of string is a byte string which compares with memcmp as the string compares under collation and is equal
+// for equal strings only, so sort, index build and distinct compute key once per value instead of running collation
+// on every comparison; zero byte is written as 0x00 0xFF and key is terminated with 0x00 0x00, so keys are prefix-free
+// and can be concatenated with other keys (see keyenc.h) into multi-column key;
+// ascii_ci keys are built 8 bytes at a time: words without zero byte are folded by bit operations and copied at once
+
+
+#include "defs/defs.h"
+#include "common/encoding.h"
+
+
+typedef enum _collation
+{
+    COLLATION_BINARY = 0,
+    COLLATION_ASCII_CI = 1,
+    COLLATION_CODEPOINT = 2,
+    COLLATION_NUM = 3
+} collation;
+
+
+// return maximum size of sort key of string of sz bytes
+#define COLLATION_KEY_MAX_SZ(sz)    (2 * (sz) + 2)
+
+
+// set server encoding, ENCODING_UNKNOWN keeps the current one (UTF-8 by default)
+void collation_set_encoding(encoding enc);
+
+// find collation by null-terminated name, names are case-insensitive
+// return 0 on success, non-0 if there is no such collation
+sint8 collation_by_name(const achar *name, collation *coll);
+
+// return null-terminated name of collation
+const achar *collation_name(collation coll);
+
+// compare strings str1 of sz1 bytes and str2 of sz2 bytes under collation coll, res is set to -1, 0, 1 if,
+// respectively, str1 < str2, str1 == str2, str1 > str2
+// return 0 on success, non-0 on error (error code is set)
+sint8 collation_cmp(collation coll, const uint8 *str1, uint64 sz1, const uint8 *str2, uint64 sz2, sint8 *res);
+
+// put sort key of str of sz bytes under collation coll to key of at least COLLATION_KEY_MAX_SZ(sz) bytes,
+// key_sz is set to size of the key
+// return 0 on success, non-0 on error (error code is set)
+sint8 collation_key(collation coll, const uint8 *str, uint64 sz, uint8 *key, uint64 *key_sz);
+
+
+#endif
@@ -24,6 +24,14 @@ extern uint8 (*dateop_extract_month_of_year)(uint64 date);
 // extract and return day of month of certain date
 extern uint8 (*dateop_extract_day_of_month)(uint64 date);
 
+// extract year, month of year or day of month of n dates to array of n values
+extern void (*dateop_extract_year_batch)(const uint64 *date, uint32 n, uint64 *year);
+extern void (*dateop_extract_month_of_year_batch)(const uint64 *date, uint32 n, uint8 *month);
+extern void (*dateop_extract_day_of_month_batch)(const uint64 *date, uint32 n, uint8 *day);
+
+// extract year, month of year and day of month of n dates at once
+extern void (*dateop_extract_date_batch)(const uint64 *date, uint32 n, uint64 *year, uint8 *month, uint8 *day);
+
 // return date truncated to beginning of the year
 extern uint64 (*dateop_trunc_to_year)(uint64 date);
 
@@ -48,6 +56,11 @@ inline uint8 dateop_extract_seconds(uint64 date)
     return (date % 60);
 }
 
+// extract hours, minutes or seconds of n dates to array of n values
+void dateop_extract_hour_batch(const uint64 *date, uint32 n, uint8 *hour);
+void dateop_extract_minutes_batch(const uint64 *date, uint32 n, uint8 *min);
+void dateop_extract_seconds_batch(const uint64 *date, uint32 n, uint8 *sec);
+
 // build date from year, month, day, hour, minute, seconds (GRIGORIAN)
 // month is in 0..11, year must be > 0
 // return 0 on success, non 0 if parameters are invalid
@@ -2,6 +2,20 @@
 #define _DECIMAL_H
 
 // decimal precision arithmetics and decimal data type
+//
+// mantissa is stored in limbs of base 10000, up to DECIMAL_POSITIONS digits,
+// mantissa of up to DECIMAL_INT128_DIGITS digits fits into 128-bit integer, so multiplication of such decimals
+// is done natively on 128-bit integers, and the limbs are used only when the result does not fit;
+// addition, subtraction and comparison of aligned mantissas of up to 18 digits are done on 64-bit integers,
+// longer ones are faster on limbs; comparison decides by sign and position of the most significant digit first
+//
+// sum of many decimals is collected in decimal_accumulator: it has wide mantissa of 64-bit limbs with fixed exponent,
+// value is added to limbs without carry and normalization, carry is done once per DECIMAL_ACC_CARRY_INTERVAL values,
+// exponent is lowered only when value has more digits after decimal point than all the values before it,
+// the accumulator keeps DECIMAL_ACC_WINDOW most significant digits, so the sum is exact unless it is that long
+//
+// division is Knuth's algorithm on pairs of limbs of base DECIMAL_BASE2, quotient is truncated to DECIMAL_POSITIONS digits,
+// divisor can be prepared once in decimal_divisor for repeated division by the same decimal
 
 #include "defs/defs.h"
 
@@ -9,10 +23,16 @@
 #define DECIMAL_BASE_LOG10      (4)
 #define DECIMAL_POSITIONS       (DECIMAL_PARTS * DECIMAL_BASE_LOG10)
 #define DECIMAL_BASE            (10000)
+#define DECIMAL_BASE2           (100000000UL)
 #define DECIMAL_SIGN_POS        (1)
 #define DECIMAL_SIGN_NEG        (-1)
 #define DECIMAL_MIN_EXPONENT    (-128)
 #define DECIMAL_MAX_EXPONENT    (127)
+#define DECIMAL_INT128_DIGITS   (38)
+#define DECIMAL_UINT64_DIGITS   (19)
+#define DECIMAL_ACC_PARTS       (DECIMAL_PARTS * 2 + 2)
+#define DECIMAL_ACC_WINDOW      ((DECIMAL_ACC_PARTS - 2) * DECIMAL_BASE_LOG10)
+#define DECIMAL_ACC_CARRY_INTERVAL  (1 << 20)
 
 // decimal representation for calculations
 typedef struct _decimal
@@ -23,6 +43,27 @@ typedef struct _decimal
     sint16 m[DECIMAL_PARTS];    // mantissa
 } decimal;
 
+// divisor prepared for repeated division, division by single limb divisor is done by multiplication by reciprocal
+typedef struct _decimal_divisor
+{
+    uint64 inv;                         // reciprocal of the most significant limb of v
+    uint32 v[DECIMAL_PARTS / 2];        // normalized limbs of base DECIMAL_BASE2
+    uint32 norm;                        // normalization factor
+    sint16 vn;                          // number of limbs in v
+    sint16 n;                           // index of the most significant limb of divisor of base DECIMAL_BASE
+    sint8  sign;                        // sign of divisor
+    sint8  e;                           // exponent of divisor
+} decimal_divisor;
+
+// accumulator of sum of decimals: sum = m[0] * 10^e + m[1] * DECIMAL_BASE * 10^e + ...
+typedef struct _decimal_accumulator
+{
+    sint64 m[DECIMAL_ACC_PARTS];    // mantissa, limbs are not normalized: they can exceed DECIMAL_BASE and differ in sign
+    uint64 count;                   // number of accumulated values
+    uint32 pending;                 // number of values added since the last carry
+    sint16 e;                       // exponent
+} decimal_accumulator;
+
 // add two decimals: d3 = d1 + d2
 // return 0 on success, not 0 on error
 sint8 decimal_add(const decimal *d1, const decimal *d2, decimal *d3);
@@ -39,9 +80,51 @@ sint8 decimal_mul(const decimal *d1, const decimal *d2, decimal *d3);
 // return 0 on success, not 0 on error
 sint8 decimal_div(const decimal *d1, const decimal *d2, decimal *d3);
 
+// prepare divisor d2 for repeated division by decimal_div_by_divisor
+// return 0 on success, not 0 on error
+sint8 decimal_divisor_prepare(const decimal *d2, decimal_divisor *dv);
+
+// divide d1 by prepared divisor dv: d3 = d1 / dv, result is the same as of decimal_div
+// return 0 on success, not 0 on error
+sint8 decimal_div_by_divisor(const decimal *d1, const decimal_divisor *dv, decimal *d3);
+
 // compare two decimals
 // return positive if d1 > d2, negative if d1 < d2, 0 otherwise
 sint16 decimal_cmp(const decimal *d1, const decimal *d2);
 
+// convert integer v to decimal d
+void decimal_from_int64(sint64 v, decimal *d);
+
+// convert decimal d to the nearest floating point number
+float64 decimal_to_float64(const decimal *d);
+
+// convert mantissa of d with sign to 128-bit integer v, so d = v * 10^d->e
+// return 0 on success, not 0 if mantissa has more than DECIMAL_INT128_DIGITS digits
+sint8 decimal_to_int128(const decimal *d, sint128 *v);
+
+// convert 128-bit integer v with exponent e to decimal d = v * 10^e
+void decimal_from_int128(sint128 v, sint8 e, decimal *d);
+
+// initialize empty accumulator acc
+void decimal_accumulator_init(decimal_accumulator *acc);
+
+// add decimal d to accumulator acc
+void decimal_accumulator_add(decimal_accumulator *acc, const decimal *d);
+
+// add sum and count of accumulator other to accumulator acc
+void decimal_accumulator_merge(decimal_accumulator *acc, const decimal_accumulator *other);
+
+// put sum of accumulated values to d
+// return 0 on success, not 0 on error
+sint8 decimal_accumulator_sum(const decimal_accumulator *acc, decimal *d);
+
+// put average of accumulated values to d, empty accumulator is division by zero
+// return 0 on success, not 0 on error
+sint8 decimal_accumulator_avg(const decimal_accumulator *acc, decimal *d);
+
+// arithmetics on limbs without integer fast path, reference for the fast path
+sint8 decimal_add_sub_limbs(const decimal *d1, const decimal *d2, decimal *d3, sint8 op);
+sint8 decimal_mul_limbs(const decimal *d1, const decimal *d2, decimal *d3);
+
 
 #endif
@@ -3,6 +3,9 @@
 
 
 // work with encoding: character operations, validation, conversion, etc.
+//
+// whole buffers are validated, counted and converted by kernels which use SSE2 or AVX2 on x86-64,
+// chosen at initialization by the instruction set of the processor, and portable code elsewhere
 
 
 #include "defs/defs.h"
@@ -89,4 +92,24 @@ encoding encoding_idbyname(const achar* name);
 sint8 encoding_is_convertable(encoding enc1, encoding enc2);
 
 
+// return length of ASCII prefix of str of sz bytes
+uint64 encoding_ascii_len(const uint8 *str, uint64 sz);
+
+// validate str of sz bytes of encoding enc, valid is set to length of the longest prefix of valid characters;
+// overlong forms, surrogates and code points above U+10FFFF are invalid in UTF-8
+// return CHAR_STATE_COMPLETE if str is valid, CHAR_STATE_INCOMPLETE if str ends with valid beginning of character,
+// CHAR_STATE_INVALID otherwise
+encoding_char_state encoding_validate(encoding enc, const uint8 *str, uint64 sz, uint64 *valid);
+
+// return number of characters of valid str of sz bytes of encoding enc
+uint64 encoding_count(encoding enc, const uint8 *str, uint64 sz);
+
+// convert valid str of sz bytes from encoding from to encoding to, put the result in dst of dst_sz bytes;
+// characters which can't be converted are replaced with the question mark as by encoding_conversion_fun,
+// conversion stops before character which doesn't fit in dst or is not complete in str
+// read is set to number of bytes of str converted
+// return number of bytes written to dst
+uint64 encoding_convert(encoding from, encoding to, const uint8 *str, uint64 sz, uint8 *dst, uint64 dst_sz, uint64 *read);
+
+
 #endif
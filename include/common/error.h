@@ -17,6 +17,11 @@ typedef enum _error_code
     ERROR_DATATYPE_MISMATCH = 7,
     ERROR_OUT_OF_MEMORY = 8,
     ERROR_SEMANTIC_ERROR = 9,
+    ERROR_EXPRESSION_TOO_COMPLEX = 10,
+    ERROR_INVALID_DATETIME_FORMAT = 11,
+    ERROR_INVALID_TIME_ZONE = 12,
+    ERROR_INVALID_CHARACTER = 13,
+    ERROR_INVALID_ESCAPE = 14,
 } error_code;
 
 // return error code of last operation
@@ -0,0 +1,39 @@
+#ifndef _FLTCONV_H
+#define _FLTCONV_H
+
+// text conversion of floating point numbers
+//
+// number is formatted to the shortest decimal which is parsed back to the same number (Ryu algorithm):
+// the interval of decimals rounding to the number is computed from multiplication by 128-bit approximations
+// of powers of 5, and digits are removed while both ends of the interval stay distinct;
+// decimal exponent from -4 to 14 is written as fixed point number, others in scientific notation:
+//   1.5, 100, 0.0001, 1e+15, 1.2345e-05, -0, NaN, Infinity, -Infinity
+//
+// parsing is exact: mantissa of up to 19 digits with small exponent is converted by one floating point
+// multiplication or division of exact values (Clinger's fast path), others by multiplication by 128-bit
+// power of 5 (Eisel-Lemire algorithm), the rare numbers too close to halfway between two floats are rounded by strtod
+
+#include "defs/defs.h"
+
+#define FLTCONV_DOUBLE_MAX_SZ   (25)    // longest formatted double: -2.2250738585072014e-308
+#define FLTCONV_FLOAT_MAX_SZ    (16)    // longest formatted float: -1.17549435e-38
+
+
+// format v to buf of at least FLTCONV_DOUBLE_MAX_SZ bytes
+// return number of bytes written
+uint32 fltconv_format_double(float64 v, uint8 *buf);
+
+// format v to buf of at least FLTCONV_FLOAT_MAX_SZ bytes
+// return number of bytes written
+uint32 fltconv_format_float(float32 v, uint8 *buf);
+
+// parse number from str of sz bytes: [+|-]digits[.digits][(e|E)[+|-]digits], NaN, Infinity, -Infinity
+// return number of bytes read, 0 if str does not start with number
+uint32 fltconv_parse_double(const uint8 *str, uint32 sz, float64 *v);
+uint32 fltconv_parse_float(const uint8 *str, uint32 sz, float32 *v);
+
+// return w * 10^e correctly rounded, negated if neg is 1
+float64 fltconv_to_double(uint64 w, sint32 e, uint8 neg);
+
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef _HMAP_H
+#define _HMAP_H
+
+// growable hash map of byte string keys
+//
+// open addressing in SwissTable layout (M. Kulukundis, "Designing a fast hash table", CppCon 2017): every slot has
+// a control byte which is either empty, deleted or 7 bits of the hash of the key in the slot; lookup loads a group of
+// 16 control bytes at once (one SSE2 compare) and checks only slots whose control byte matches, a group with an empty
+// slot ends the probe; groups are probed quadratically, table is at most 7/8 full;
+// slot keeps the whole 32-bit hash of the key, so keys are compared only when hashes are equal and growing
+// doesn't call the hash function again;
+// deleted slot becomes empty if no probe could have passed it, otherwise it stays as a tombstone until next resize;
+// table grows incrementally: entries are moved from the old table to the new one a few groups per insert or delete,
+// lookup checks the new table and then the old one, so no single insert pays for moving the whole table;
+// the first table is in the buffer passed to hmap_create, grown tables are taken from heap
+
+
+#include "defs/defs.h"
+
+
+// entry description
+typedef struct _hmap_entry
+{
+    uint32    keylen;
+    uint32    datalen;
+    void      *key;
+    void      *data;
+} hmap_entry;
+
+
+// function calculating hash value of val of length len
+// return hash value
+typedef uint32 (* hmap_hfun)(const void *val, uint32 len);
+
+
+// return size of the buffer for map holding up to n entries before it grows
+size_t hmap_get_alloc_sz(uint32 n);
+
+// create map using buffer buf of hmap_get_alloc_sz(n) bytes, keys are hashed by function f
+// return NULL on error
+handle hmap_create(void *buf, uint32 n, hmap_hfun f);
+
+// add entry, entry with the same key is replaced; key and data are referenced, not copied
+// return 0 on success, non-0 on error (error code is set)
+sint8 hmap_insert(handle mh, const hmap_entry *entry);
+
+// search for an entry by a key, returned entry is valid until next insert or delete
+// return NULL if not found
+const hmap_entry *hmap_search(handle mh, const void *key, uint32 keylen);
+
+// delete entry by a key
+// return 0 if entry is deleted, non-0 if there is no such key
+sint8 hmap_delete(handle mh, const void *key, uint32 keylen);
+
+// return number of entries
+uint32 hmap_size(handle mh);
+
+// release grown tables, buffer of the map is not freed
+void hmap_destroy(handle mh);
+
+
+#endif
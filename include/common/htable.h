@@ -2,25 +2,23 @@
 #define _HTABLE_H
 
 
-// hash table
+// hash table of fixed capacity
+//
+// compatibility interface over growable hash map (see hmap.h): table is created in the buffer for n entries and
+// never grows, so it needs no destruction; adding an entry to a table of n entries fails
 
 
 #include "defs/defs.h"
+#include "common/hmap.h"
 
 
 // entry description
-typedef struct _htable_entry
-{
-    uint32    keylen;
-    uint32    datalen;
-    void      *key;
-    void      *data;
-} htable_entry;
+typedef hmap_entry htable_entry;
 
 
 // function calculating hash value of val of length len
 // return hash value
-typedef uint32 (* htable_hfun)(const void *val, uint32 len);
+typedef hmap_hfun htable_hfun;
 
 
 // return allocation size for table of n elements
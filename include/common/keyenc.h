@@ -0,0 +1,69 @@
+#ifndef _KEYENC_H
+#define _KEYENC_H
+
+// order-preserving binary encoding of values for index and sort keys
+//
+// encoded values of the same datatype compare with memcmp as the values compare, equal values have equal encoding,
+// so keys are sorted, searched and hashed as raw bytes:
+//   - integers are big-endian with inverted sign bit
+//   - floats are big-endian with inverted sign bit if positive and all bits inverted if negative,
+//     -0 is encoded as 0, every NaN is encoded as the same value greater than infinity
+//   - date and timestamp are big-endian
+//   - timestamp with time zone is encoded as instant in UTC, decoded value has zero offset
+//   - decimal is class byte (negative, zero, positive), adjusted exponent of 2 bytes and pairs of digits
+//     of normalized mantissa, byte per pair, terminated by byte less than any pair,
+//     bytes of negative decimal are inverted
+
+
+#include "defs/defs.h"
+#include "common/decimal.h"
+
+
+#define KEYENC_SMALLINT_SZ      (2)
+#define KEYENC_INTEGER_SZ       (4)
+#define KEYENC_FLOAT_SZ         (4)
+#define KEYENC_DOUBLE_SZ        (8)
+#define KEYENC_DATE_SZ          (8)
+#define KEYENC_TIMESTAMP_SZ     (8)
+#define KEYENC_TIMESTAMP_TZ_SZ  (8)
+#define KEYENC_DECIMAL_MAX_SZ   (1 + 2 + DECIMAL_POSITIONS / 2 + 1)
+
+
+// encode value v to buf
+// return number of bytes written
+uint32 keyenc_encode_smallint(sint16 v, uint8 *buf);
+uint32 keyenc_encode_integer(sint32 v, uint8 *buf);
+uint32 keyenc_encode_float(float32 v, uint8 *buf);
+uint32 keyenc_encode_double(float64 v, uint8 *buf);
+uint32 keyenc_encode_date(uint64 v, uint8 *buf);
+uint32 keyenc_encode_timestamp(uint64 v, uint8 *buf);
+
+// encode timestamp ts of local time with offset tz in minutes from UTC to buf
+// return number of bytes written
+uint32 keyenc_encode_timestamp_with_tz(uint64 ts, sint16 tz, uint8 *buf);
+
+// encode decimal d to buf of at least KEYENC_DECIMAL_MAX_SZ bytes
+// return number of bytes written
+uint32 keyenc_encode_decimal(const decimal *d, uint8 *buf);
+
+
+// decode value from buf to v
+// return number of bytes read
+uint32 keyenc_decode_smallint(const uint8 *buf, sint16 *v);
+uint32 keyenc_decode_integer(const uint8 *buf, sint32 *v);
+uint32 keyenc_decode_float(const uint8 *buf, float32 *v);
+uint32 keyenc_decode_double(const uint8 *buf, float64 *v);
+uint32 keyenc_decode_date(const uint8 *buf, uint64 *v);
+uint32 keyenc_decode_timestamp(const uint8 *buf, uint64 *v);
+
+// decode timestamp with time zone from buf, ts is set to UTC time and tz to 0
+// return number of bytes read
+uint32 keyenc_decode_timestamp_with_tz(const uint8 *buf, uint64 *ts, sint16 *tz);
+
+// decode decimal from buf of sz bytes to d, mantissa of d is normalized: it has no trailing zeroes,
+// unless they are needed to keep exponent in range
+// return number of bytes read, 0 if buf does not start with encoded decimal (error code is set)
+uint32 keyenc_decode_decimal(const uint8 *buf, uint32 sz, decimal *d);
+
+
+#endif
@@ -39,13 +39,20 @@
 #define PPROTO_AUTH_REQUEST_MESSAGE_MAGIC 0x11u
 #define PPROTO_AUTH_RESPONCE_MESSAGE_MAGIC 0x33u
 #define PPROTO_PROGRESS_MESSAGE_MAGIC 0x44u
+#define PPROTO_SCRIPT_END_MESSAGE_MAGIC 0x5Eu
 
 // client message magics
 #define PPROTO_CLIENT_HELLO_MAGIC 0x1406u
 #define PPROTO_AUTH_MESSAGE_MAGIC 0x22u
 #define PPROTO_SQL_REQUEST_MESSAGE_MAGIC 0x55u
+#define PPROTO_SQL_SCRIPT_MESSAGE_MAGIC 0x56u
 #define PPROTO_CANCEL_MESSAGE_MAGIC 0x57u
 
+// script stop-on-error policies
+#define PPROTO_SCRIPT_ON_ERROR_DEFAULT 0x00u
+#define PPROTO_SCRIPT_ON_ERROR_STOP 0x01u
+#define PPROTO_SCRIPT_ON_ERROR_CONTINUE 0x02u
+
 // column description flags
 #define PPROTO_COL_FLAG_NULLABLE 0x01
 
@@ -65,7 +72,9 @@ typedef enum _pproto_msg_type
     PPROTO_AUTH_MSG = 10,
     PPROTO_SQL_REQUEST_MSG = 11,
     PPROTO_CANCEL_MSG = 12,
-    PPROTO_GOODBYE_MSG = 13
+    PPROTO_GOODBYE_MSG = 13,
+    PPROTO_SQL_SCRIPT_MSG = 14,
+    PPROTO_SCRIPT_END_MSG = 15
 } pproto_msg_type;
 
 
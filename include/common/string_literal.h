@@ -3,12 +3,25 @@
 
 
 // string representation and functions
+//
+// string literal is a rope: the first bytes are kept in the literal itself, the following ones in a list
+// of heap chunks, so appending never copies what is already written and moving to another literal
+// takes constant time; bytes above the in-memory limit are written to a temporary file through a chunk-sized buffer;
+// chunks and file are released by truncation
 
 
 #include "defs/defs.h"
 #include "common/encoding.h"
 
 
+#define STRING_LITERAL_DEFAULT_MEM_SZ       (1024 * 1024)
+#define STRING_LITERAL_DEFAULT_SPILL_DIR    ("/tmp")
+
+
+// set number of bytes of each string literal kept in memory, the rest is spilled to a temporary file in spill_dir
+// spill_dir must stay valid while string literals are used, NULL means default directory
+void string_literal_set_spill(uint64 mem_sz, const achar *spill_dir);
+
 // size for string_literal
 size_t string_literal_alloc_sz();
 
@@ -16,15 +29,18 @@ size_t string_literal_alloc_sz();
 // return NULL on error
 handle string_literal_create(void *buf);
 
-// truncate
+// truncate, memory and spill file are released
 // return 0 on success, non-0 on error
 sint8 string_literal_truncate(handle sh);
 
+// release all resources, buffer of the string literal is not freed
+void string_literal_destroy(handle sh);
+
 // append buffer to string literal
 // return 0 on success, 1 on error
 sint8 string_literal_append_char(handle sh, const uint8 *buf, uint32 sz);
 
-// move ownership from one string literal to another
+// move ownership from one string literal to another without copying the data
 // from is trucated
 // return 0 on success, non-0 on error
 sint8 string_literal_move(handle from, handle to);
@@ -34,6 +50,11 @@ sint8 string_literal_move(handle from, handle to);
 // return 0 on success, non-0 on error
 sint8 string_literal_read(handle sh, uint8 *buf, uint64 *sz);
 
+// read data of size sz starting from byte offset of string literal to buf, reading in order takes linear time
+// upon completion sz is set to the number of bytes read
+// return 0 on success, non-0 on error
+sint8 string_literal_read_at(handle sh, uint64 offset, uint8 *buf, uint64 *sz);
+
 // binary compare of two string literals
 // ret is 0 if equal, 1 if sh1 greater then sh2, -1 if sh2 greater than sh1
 // return 0 on success, non-0 on error
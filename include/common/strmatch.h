@@ -0,0 +1,61 @@
+#ifndef _STRMATCH_H
+#define _STRMATCH_H
+
+// LIKE pattern matching
+//
+// pattern is compiled once and matched against many strings: % matches any sequence of characters, _ matches one
+// character, escape character makes the next %, _ or escape itself literal; strings and patterns are compared as bytes,
+// _ takes one UTF-8 character (a byte of any other encoding with high bit clear);
+// compiler picks a kernel by shape of the pattern:
+//   - exact (no wildcards), prefix (abc%), suffix (%abc): single memcmp at fixed position
+//   - contains (%abc%): candidates are positions where both the first and the last byte of the literal are found,
+//     16 (SSE2) or 32 (AVX2) positions are filtered by two compares, survivors are checked with memcmp
+//     (W. Mula, "SIMD-friendly algorithms for substring searching"); portable code uses memchr
+//   - any (%): matches every string
+//   - segments (abc%def, %abc%def%): literals separated by %, the first and the last ones are compared at fixed
+//     positions unless pattern starts or ends with %, inner ones are found at the leftmost position one after another
+//   - general (with _): bit-parallel NFA (Shift-And) with a state bit per pattern byte, % is a self-loop of the preceding
+//     state, _ state loops on UTF-8 continuation bytes; one 64-bit word holds states of patterns of up to 64 bytes
+
+
+#include "defs/defs.h"
+
+
+typedef enum _strmatch_kind
+{
+    STRMATCH_KIND_EXACT = 0,
+    STRMATCH_KIND_PREFIX = 1,
+    STRMATCH_KIND_SUFFIX = 2,
+    STRMATCH_KIND_CONTAINS = 3,
+    STRMATCH_KIND_ANY = 4,
+    STRMATCH_KIND_GENERAL = 5,
+    STRMATCH_KIND_SEGMENTS = 6
+} strmatch_kind;
+
+
+// return size of buffer for compiled pattern of pattern_sz bytes
+uint64 strmatch_get_alloc_sz(uint64 pattern_sz);
+
+// compile pattern of pattern_sz bytes to buf of strmatch_get_alloc_sz(pattern_sz) bytes, escape of escape_sz bytes
+// is a single character or empty if there is no escape character
+// return handle of compiled pattern, NULL on invalid escape character or sequence (error code is set)
+handle strmatch_compile(void *buf, const uint8 *pattern, uint64 pattern_sz, const uint8 *escape, uint64 escape_sz);
+
+// compile pattern and escape held by string literals, escape is NULL if there is no escape character,
+// buf must be of strmatch_get_alloc_sz(length of pattern) bytes
+// return handle of compiled pattern, NULL on error (error code is set)
+handle strmatch_compile_literal(void *buf, handle pattern, handle escape);
+
+// return kernel chosen for compiled pattern
+strmatch_kind strmatch_get_kind(handle mh);
+
+// return 1 if str of sz bytes matches compiled pattern, 0 otherwise
+uint8 strmatch_match(handle mh, const uint8 *str, uint64 sz);
+
+// match string literal sl against compiled pattern, res is set to 1 if it matches, 0 otherwise;
+// long strings are read by windows
+// return 0 on success, non-0 on error
+sint8 strmatch_match_literal(handle mh, handle sl, uint8 *res);
+
+
+#endif
@@ -2,6 +2,13 @@
 #define _STROP_H
 
 // text string operations
+//
+// numbers are formatted with digits in current encoding, digits are single bytes in every supported encoding,
+// so integers are formatted two digits at a time from table of digit pairs, decimals a limb (4 digits) at a time,
+// decimal format can be compiled once into strop_decimal_fmt for repeated formatting of a column,
+// date and timestamp format into strop_dttm_fmt of literal and field ops, which batch formatting applies to a column;
+// dates and timestamps are parsed by the same compiled ops, formats of ISO-8601 shape (yyyy-mm-dd hh:mi:ss.ffffff)
+// are recognized at compile time and read by a parser of fixed positions instead of interpreting the ops
 
 #include "defs/defs.h"
 #include "common/encoding.h"
@@ -10,8 +17,8 @@
 // set current encoding
 void strop_set_encoding(encoding enc);
 
-// length of the string in characters excluding terminating character
-uint64 strop_len(const void *str);
+// return length in characters of valid string str of sz bytes of current encoding
+uint64 strop_len(const uint8 *str, uint64 sz);
 
 // compare two strings
 // return an -1, 0, 1 if, respectively, str1 < str2, str1 == str2, str1 > str2
@@ -27,6 +34,23 @@ sint8 strop_fmt_uint64(uint8* buf, uint32 *ptr, uint32 sz, uint64 number);
 sint8 strop_fmt_uint64_padded(uint8* buf, uint32 *ptr, uint32 sz, uint64 number, uint32 pad);
 
 
+// decimal format compiled from format string or from precision, scale and exponent flag
+typedef struct _strop_decimal_fmt
+{
+    uint8 precision;        // number of digits
+    uint8 scale;            // number of digits after decimal separator
+    uint8 exp;              // 1 - print exponent, 0 - don't print
+} strop_decimal_fmt;
+
+// compile decimal format fmt (see strop_fmt_decimal) to df
+// return 0 on success, non-0 on error
+sint8 strop_decimal_fmt_compile(const achar* fmt, strop_decimal_fmt *df);
+
+// format decimal value according to compiled format df and put result to buf + start
+// return 0 on success, non-0 on error
+// start value will be updated to point after formatted number
+sint8 strop_fmt_decimal_compiled(uint8 *buf, uint32 *start, uint32 sz, const strop_decimal_fmt *df, const decimal *d);
+
 // format decimal value according to fmt and put result to buf + start
 // return 0 on success, non-0 on error
 // start value will be updated to point after formatted number
@@ -41,6 +65,98 @@ sint8 strop_fmt_decimal(uint8 *buf, uint32 *start, uint32 sz, const achar* fmt,
 // start value will be updated to point after formatted number
 sint8 strop_fmt_decimal_pse(uint8 *buf, uint32 *start, uint32 sz, uint8 p, uint8 s, uint8 e, decimal *d);
 
+// date and timestamp format compiled from format string: literal text converted to current encoding and fields
+#define STROP_DTTM_FMT_OPS          (32)
+#define STROP_DTTM_FMT_LITERAL_SZ   (128)
+
+typedef enum _strop_dttm_code
+{
+    STROP_DTTM_LITERAL = 0,
+    STROP_DTTM_YEAR,
+    STROP_DTTM_MONTH,
+    STROP_DTTM_DAY,
+    STROP_DTTM_HOUR,
+    STROP_DTTM_MINUTES,
+    STROP_DTTM_SECONDS,
+    STROP_DTTM_FRACTION,
+    STROP_DTTM_TZ
+} strop_dttm_code;
+
+typedef struct _strop_dttm_fmt_op
+{
+    uint8  code;            // strop_dttm_code
+    uint8  len;             // number of bytes of literal or number of digits of fraction
+    uint16 offset;          // offset of literal in literals
+} strop_dttm_fmt_op;
+
+// parts of ISO-8601 value, a format of ISO-8601 shape is the set of its parts
+#define STROP_ISO_DATE              (0x01)      // yyyy-mm-dd
+#define STROP_ISO_TIME              (0x02)      // (T| )hh:mi
+#define STROP_ISO_SECONDS           (0x04)      // :ss
+#define STROP_ISO_TZ                (0x08)      // (+|-)hh:mi
+#define STROP_ISO_TZ_OTHER          (0x10)      // Z, (+|-)hh, (+|-)hhmi, never in a format
+
+typedef struct _strop_dttm_fmt
+{
+    uint32 n;                                   // number of ops
+    uint32 literal_sz;                          // bytes taken in literals
+    uint8  calendar;                            // 1 if year, month or day is formatted
+    uint8  iso_shape;                           // STROP_ISO_* parts if format is ISO-8601, 0 otherwise
+    uint8  iso_sep;                             // separator of date and time: T or space
+    uint8  iso_frac;                            // digits of fraction of second
+    strop_dttm_fmt_op ops[STROP_DTTM_FMT_OPS];
+    uint8  literals[STROP_DTTM_FMT_LITERAL_SZ];
+} strop_dttm_fmt;
+
+// calendar fields of a day, cached while formatting values of the same day
+typedef struct _strop_dttm_fields
+{
+    uint64 days;            // day number the fields belong to
+    uint64 year;
+    uint8  month;
+    uint8  day;
+} strop_dttm_fields;
+
+// compile date and timestamp format fmt (see strop_fmt_timestamp_with_tz) to df
+// return 0 on success, non-0 on error (format is too long)
+sint8 strop_dttm_fmt_compile(const achar *fmt, strop_dttm_fmt *df);
+
+// format date, timestamp or timestamp with time zone according to compiled format df and put result to buf + start
+// return 0 on success, non-0 on buffer overflow
+// start value updated to point after formatted value
+sint8 strop_fmt_date_compiled(uint8 *buf, uint32 *start, uint32 sz, const strop_dttm_fmt *df, uint64 date);
+sint8 strop_fmt_timestamp_compiled(uint8 *buf, uint32 *start, uint32 sz, const strop_dttm_fmt *df, uint64 ts);
+sint8 strop_fmt_timestamp_with_tz_compiled(uint8 *buf, uint32 *start, uint32 sz, const strop_dttm_fmt *df, uint64 ts, sint16 tz);
+
+// format n values one after another according to compiled format df and put result to buf + start,
+// end[i] is set to offset in buf after value i, calendar fields are computed once for values of the same day
+// return number of values formatted, less than n if buf is full
+// start value updated to point after the last formatted value
+uint32 strop_fmt_date_batch(uint8 *buf, uint32 *start, uint32 sz, const strop_dttm_fmt *df, const uint64 *date, uint32 n, uint32 *end);
+uint32 strop_fmt_timestamp_batch(uint8 *buf, uint32 *start, uint32 sz, const strop_dttm_fmt *df, const uint64 *ts, uint32 n, uint32 *end);
+uint32 strop_fmt_timestamp_with_tz_batch(uint8 *buf, uint32 *start, uint32 sz, const strop_dttm_fmt *df, const uint64 *ts, const sint16 *tz, uint32 n, uint32 *end);
+
+// parse date, timestamp or timestamp with time zone from str of sz bytes according to compiled format df,
+// year takes 4 digits, month, day, hour, minutes and seconds 2 digits, fraction as many digits as in format,
+// time zone (+|-)hh:mi; fields missing in format are taken from 0001-01-01 00:00:00.000000+00:00
+// return number of bytes read, 0 if str does not match format or value is invalid (error code is set)
+uint32 strop_parse_date_compiled(const uint8 *str, uint32 sz, const strop_dttm_fmt *df, uint64 *date);
+uint32 strop_parse_timestamp_compiled(const uint8 *str, uint32 sz, const strop_dttm_fmt *df, uint64 *ts);
+uint32 strop_parse_timestamp_with_tz_compiled(const uint8 *str, uint32 sz, const strop_dttm_fmt *df, uint64 *ts, sint16 *tz);
+
+// parse n values laid out one after another in buf according to compiled format df, value i takes bytes
+// from end[i - 1] (0 for the first one) to end[i] and must be read completely (see strop_fmt_date_batch),
+// calendar part is computed once for values of the same day
+// return number of values parsed, less than n if value at the returned index is invalid (error code is set)
+uint32 strop_parse_date_batch(const uint8 *buf, const uint32 *end, uint32 n, const strop_dttm_fmt *df, uint64 *date);
+uint32 strop_parse_timestamp_batch(const uint8 *buf, const uint32 *end, uint32 n, const strop_dttm_fmt *df, uint64 *ts);
+uint32 strop_parse_timestamp_with_tz_batch(const uint8 *buf, const uint32 *end, uint32 n, const strop_dttm_fmt *df, uint64 *ts, sint16 *tz);
+
+// parse ISO-8601 timestamp from str of sz bytes: yyyy-mm-dd[(T| )hh:mi[:ss[.fraction]]][Z|(+|-)hh[[:]mi]],
+// fraction of up to 9 digits is truncated to microseconds, time zone is 0 if missing
+// return number of bytes read, 0 if str does not start with ISO-8601 timestamp or value is invalid (error code is set)
+uint32 strop_parse_timestamp_iso(const uint8 *str, uint32 sz, uint64 *ts, sint16 *tz);
+
 // format date value according to fmt and put result to buf + start
 // return 0 on success, non-0 on error
 // start value updated to point after formatted date
@@ -63,7 +179,7 @@ sint8 strop_fmt_date(uint8 *buf, uint32 *start, uint32 sz, const achar* fmt, uin
 //   hh:    hour from 0 to 23
 //   mi:    minutes from 0 to 59
 //   ss:    seconds from 0 to 59
-//   x:     fraction of second (xx - two positions, xxx - three, etc up to xxxxxx)
+//   f:     fraction of second (ff - two positions, fff - three, etc up to ffffff)
 sint8 strop_fmt_timestamp(uint8 *buf, uint32 *start, uint32 sz, const achar* fmt, uint64 ts);
 
 // format timestamp value with timezone according to fmt and put result to buf + start
@@ -76,7 +192,7 @@ sint8 strop_fmt_timestamp(uint8 *buf, uint32 *start, uint32 sz, const achar* fmt
 //   hh:    hour from 0 to 23
 //   mi:    minutes from 0 to 59
 //   ss:    seconds from 0 to 59
-//   x:     fraction of second (xx - two positions, xxx - three, etc up to xxxxxx)
+//   f:     fraction of second (ff - two positions, fff - three, etc up to ffffff)
 //   tz:    timezone (for timestamp with timezone)
 sint8 strop_fmt_timestamp_with_tz(uint8 *buf, uint32 *start, uint32 sz, const achar* fmt, uint64 ts, sint16 tz);
 
@@ -0,0 +1,89 @@
+#ifndef _STRVAL_H
+#define _STRVAL_H
+
+// compact string value
+//
+// value takes 32 bytes: length, cached hash and either the string itself, zero-padded, if it is not longer than
+// STRVAL_INLINE_SZ bytes, or the first 8 bytes of the string and a pointer to it; so equality is decided
+// by length and hash for most unequal values and by three words for short ones, and ordering mostly by the first
+// 8 bytes, which are at the same place in both forms;
+// long string is owned by reference-counted heap buffer or by other storage (arena, interning dictionary),
+// reference counts are not atomic, values are used by one thread;
+// interning dictionary keeps one copy of each distinct string in fixed buffer, so equal long values interned
+// by the same dictionary share the pointer and compare equal without reading the string
+
+
+#include "defs/defs.h"
+
+
+#define STRVAL_INLINE_SZ        (24)
+#define STRVAL_PREFIX_SZ        (8)
+
+
+typedef struct _strval
+{
+    uint32 len;                             // length in bytes
+    uint32 hash;
+    union
+    {
+        uint8 data[STRVAL_INLINE_SZ];       // short string, zero-padded
+        struct
+        {
+            uint8 prefix[STRVAL_PREFIX_SZ]; // first bytes of long string
+            const uint8 *ptr;               // long string
+            void *buf;                      // reference-counted buffer of ptr, NULL if ptr is owned by other storage
+        };
+    };
+} strval;
+
+
+// return hash of str of len bytes, the same as cached in value
+uint32 strval_hash_buf(const uint8 *str, uint32 len);
+
+// make value v of copy of str of len bytes, long string is copied to new reference-counted buffer
+// return 0 on success, non-0 on error (error code is set)
+sint8 strval_from_buf(strval *v, const uint8 *str, uint32 len);
+
+// make value v of str of len bytes, long string is not copied and must outlive the value
+void strval_from_ref(strval *v, const uint8 *str, uint32 len);
+
+// make value v of contents of string literal sl
+// return 0 on success, non-0 on error (error code is set)
+sint8 strval_from_literal(strval *v, handle sl);
+
+// make dst another reference to value src
+void strval_copy(strval *dst, const strval *src);
+
+// release reference of value v, buffer of long string is freed with the last reference
+void strval_release(strval *v);
+
+// return pointer to bytes of value v
+const uint8 *strval_data(const strval *v);
+
+// return 1 if values are equal, 0 otherwise
+uint8 strval_eq(const strval *a, const strval *b);
+
+// binary compare of two values
+// return -1, 0, 1 if, respectively, a < b, a == b, a > b
+sint8 strval_cmp(const strval *a, const strval *b);
+
+
+// return size of the buffer for dictionary of up to n strings of up to storage_sz bytes together
+size_t strval_dict_get_alloc_sz(uint32 n, uint32 storage_sz);
+
+// create interning dictionary of up to n strings of up to storage_sz bytes together using buffer buf
+// return NULL on error
+handle strval_dict_create(void *buf, uint32 n, uint32 storage_sz);
+
+// make v value of str of len bytes kept in dictionary, string is added if it is not there
+// return 0 on success, non-0 if dictionary is full (v is not changed)
+sint8 strval_dict_intern(handle dh, const uint8 *str, uint32 len, strval *v);
+
+// return number of distinct strings in dictionary
+uint32 strval_dict_size(handle dh);
+
+// remove all strings, values made by dictionary become invalid
+void strval_dict_reset(handle dh);
+
+
+#endif
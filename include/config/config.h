@@ -25,7 +25,11 @@ typedef enum _config_option
     CONFIG_LOGGING_MODE = 0,
     CONFIG_LOG_DIR = 1,
     CONFIG_LOG_FILE_SIZE_THRESHOLD = 2,
-    CONFIG_LISTENER_TCP_PORT = 3
+    CONFIG_LISTENER_TCP_PORT = 3,
+    CONFIG_PARSER_MEMORY_BUDGET = 4,
+    CONFIG_TEMP_DIR = 5,
+    CONFIG_SCRIPT_ON_ERROR = 6,
+    CONFIG_TZ_DIR = 7
 } config_option;
 
 // searches for configuration file and loads config
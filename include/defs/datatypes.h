@@ -18,6 +18,9 @@ typedef unsigned short uint16;
 typedef unsigned int   uint32;
 typedef unsigned long  uint64;
 
+typedef __int128          sint128;
+typedef unsigned __int128 uint128;
+
 // floats
 typedef float  float32;
 typedef double float64;
@@ -7,7 +7,15 @@
 
 #include "defs/defs.h"
 
-// execute statement
-sint8 execution_exec_statement();
+// set stop-on-error policy used for scripts which do not specify it, one of PPROTO_SCRIPT_ON_ERROR_* values
+void execution_set_script_on_error(uint8 on_error);
+
+// execute single statement sent by client
+// return 0 on success or if statement failed and error is reported to client, non-0 on fatal error
+sint8 execution_exec_statement(handle lexer);
+
+// execute script of statements separated with ';' sent by client
+// return 0 on success or if statements failed and errors are reported to client, non-0 on fatal error
+sint8 execution_exec_script(handle lexer);
 
 #endif
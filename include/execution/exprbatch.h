@@ -0,0 +1,97 @@
+#ifndef _EXPRBATCH_H
+#define _EXPRBATCH_H
+
+
+// vectorized expression evaluation over column batches
+//
+// expression tree is lowered once into a list of steps, every step applies a kernel to whole vectors
+// of up to EXPRBATCH_SIZE values:
+//   - kernel is chosen per batch by the pair of operand vector types, so loops inside kernels are branch-free
+//   - null values are tracked in bitmaps, value of a null element is undefined
+//   - only elements listed in selection vector are evaluated, elements out of selection are undefined
+//   - comparison with NULL operand gives NULL (unknown), as in expression tree and exprvm; only exprbatch_filter
+//     treats unknown result as not selected
+//   - NOT, AND, OR follow SQL three-valued logic: NULL operand gives NULL (unknown), except false AND x is false
+//     and true OR x is true, AND/OR combine true and false bitmaps 64 elements at a time
+//   - right operand of AND/OR is evaluated only over elements where left operand does not decide the result,
+//     up to EXPRBATCH_MAX_LEVELS nested operands are narrowed this way
+//   - x BETWEEN lo AND hi is expected as BETWEEN node with x on the left and AND node of lo, hi on the right
+//   - LIKE pattern and escape character must be constants, pattern is compiled once (see strmatch.h)
+//     and the step runs its kernel for every evaluated string
+
+
+#include "defs/defs.h"
+#include "execution/exprvm.h"
+
+
+#define EXPRBATCH_SIZE              (1024)
+#define EXPRBATCH_NULL_WORDS        (EXPRBATCH_SIZE / 64)
+#define EXPRBATCH_MAX_STEPS         (64)
+#define EXPRBATCH_MAX_VECTORS       (32)        // constants and temporary results
+#define EXPRBATCH_COLUMN            (0x8000u)   // step operand refers to column vector, not program vector
+#define EXPRBATCH_MAX_LEVELS        (8)         // nested AND/OR operands evaluated over narrowed selection
+#define EXPRBATCH_PATTERN_POOL_SZ   (16384)     // bytes for compiled LIKE patterns of program
+
+#define EXPRBATCH_IS_NULL(v, i)     (((v)->nulls[(i) >> 6] >> ((i) & 63)) & 1)
+#define EXPRBATCH_SET_NULL(v, i)    ((v)->nulls[(i) >> 6] |= (uint64)1 << ((i) & 63))
+
+
+// vector of values of the same type
+typedef struct _exprbatch_vector
+{
+    parser_expr_node_type   type;                           // PARSER_EXPR_NODE_TYPE_INT, NUM, FLOAT, STR, BOOL, or NULL if all values are null
+    uint64                  nulls[EXPRBATCH_NULL_WORDS];    // bit i is set if element i is null
+    union
+    {
+        sint64              *integer;
+        float64             *fp;
+        decimal             *num;
+        void                **str;                          // string literal handles
+        uint8               *boolean;                       // 0 or 1
+    };
+} exprbatch_vector;
+
+
+// boolean vector as bitmaps, element which is neither true nor false is null
+typedef struct _exprbatch_bool_bitmap
+{
+    uint64                  true_bits[EXPRBATCH_NULL_WORDS];
+    uint64                  false_bits[EXPRBATCH_NULL_WORDS];
+} exprbatch_bool_bitmap;
+
+
+// convert boolean or all-null vector v into bitmaps bm, only first words of bitmaps are converted
+void exprbatch_bool_to_bitmap(const exprbatch_vector *v, uint16 words, exprbatch_bool_bitmap *bm);
+
+// convert first words of bitmaps bm into boolean vector v
+void exprbatch_bitmap_to_bool(const exprbatch_bool_bitmap *bm, exprbatch_vector *v, uint16 words);
+
+// a = a AND b over first words of bitmaps, three-valued
+void exprbatch_bitmap_and(exprbatch_bool_bitmap *a, const exprbatch_bool_bitmap *b, uint16 words);
+
+// a = a OR b over first words of bitmaps, three-valued
+void exprbatch_bitmap_or(exprbatch_bool_bitmap *a, const exprbatch_bool_bitmap *b, uint16 words);
+
+
+// return size of the buffer for compiled program
+size_t exprbatch_get_alloc_sz();
+
+// compile expression expr into program using buffer buf
+// column names are resolved to indexes in array of column vectors passed on evaluation
+// return program handle or NULL on error (error code is set)
+handle exprbatch_compile(void *buf, const parser_ast_expr *expr, exprvm_interface vi);
+
+// evaluate program for batch of columns
+// if sel is NULL elements 0..n-1 are evaluated, otherwise n elements listed in ascending sel
+// result points to vector which stays valid until next evaluation
+// return 0 on success, non-0 on error (error code is set)
+sint8 exprbatch_eval(handle bh, const exprbatch_vector *columns, const uint16 *sel, uint16 n, const exprbatch_vector **result);
+
+// evaluate boolean program for batch of columns and select elements with true result
+// sel and n are the same as for exprbatch_eval, selected element indexes are put to sel_out, their number to out_n
+// sel_out can be the same array as sel
+// return 0 on success, non-0 on error (error code is set)
+sint8 exprbatch_filter(handle bh, const exprbatch_vector *columns, const uint16 *sel, uint16 n, uint16 *sel_out, uint16 *out_n);
+
+
+#endif
@@ -9,12 +9,25 @@
 #include "parser/parser.h"
 
 
-// calculate expresion expr of kind: type = op, left = leaf argument (str, num, name or NULL), right = leaf argument
+// calculate expresion expr of kind: type = op, left = leaf argument (str, num, int, name or NULL), right = leaf argument
 // if ignore_name is not 0 then nodes of type PARSER_EXPR_NODE_TYPE_NAME are resolved to values
 // if ignore_name is not 0 and left or right = op/name then the expression is not calculated
+// AND, OR and NOT follow three-valued logic, right operand of AND/OR is skipped if left one decides the result
+// comparison with null operand is null (unknown), the caller filtering rows treats unknown as not selected
+// right operand of LIKE can be ESCAPE node of leaf pattern and escape character, LIKE of null operand is null
 // return 0 on success, non-0 on error
 sint8 expression_calc_base_expr(parser_ast_expr *expr, uint8 ignore_name);
 
+// set pattern and escape character operands of LIKE expr, escape is NULL if there is no ESCAPE clause
+void expression_like_operands(const parser_ast_expr *expr, parser_ast_expr **pattern, parser_ast_expr **escape);
+
+// return 1 if expr is AND/OR whose left operand is constant which decides the result, so right operand is not needed
+uint8 expression_is_short_circuit(const parser_ast_expr *expr);
+
+// calculate floating point operation res = v1 <op> v2, op is one of arithmetic operations
+// return 0 on success, non-0 on division by zero or overflow (error code is set)
+sint8 expression_float_op(parser_expr_op_type op, float64 v1, float64 v2, float64 *res);
+
 // calculate constant parts of expresion expr, put result to expr
 // stack of tree depth size is required for keeping pointers on parser_ast_expr *
 // return 0 on success, non-0 on error
@@ -0,0 +1,45 @@
+#ifndef _EXPROPTIMIZE_H
+#define _EXPROPTIMIZE_H
+
+
+// optimization of statement expressions, performed once before execution
+//
+// every expression of the statement (projection, WHERE, ON, GROUP BY, HAVING, ORDER BY, VALUES, SET,
+// CHECK and DEFAULT) is transformed in place:
+//   - constant subexpressions are folded bottom-up, folding errors (e.g. division by zero) are left for execution
+//   - boolean identities are simplified: x AND FALSE, x OR TRUE, x AND TRUE, x OR FALSE, x AND x, x OR x, NOT NOT x,
+//     x must be a comparison, logical operation or boolean constant, so datatype errors are not hidden
+//   - equal subexpressions of the same query block are merged into single node (hash-consing),
+//     so after optimization expression is a DAG and compilers evaluate shared node once per row,
+//     string literals up to EXPROPTIMIZE_MAX_STR_SZ bytes are interned, so equal literals are merged too
+
+
+#include "defs/defs.h"
+#include "parser/parser.h"
+
+
+#define EXPROPTIMIZE_MAX_NODES      (1024)          // distinct nodes merged per query block, the rest is kept as is
+#define EXPROPTIMIZE_KEY_POOL_SZ    (64 * 1024)     // storage of node keys per query block
+#define EXPROPTIMIZE_MAX_STR_SZ     (256)           // longest string literal merged by value
+
+
+// return size of the buffer for optimizer
+size_t exproptimize_get_alloc_sz();
+
+// create optimizer using buffer buf
+// return optimizer handle or NULL on error
+handle exproptimize_create(void *buf);
+
+// optimize expression expr in place, equal subexpressions are merged with nodes seen since previous reset
+// return 0 on success, non-0 on error
+sint8 exproptimize_expr(handle oh, parser_ast_expr *expr);
+
+// forget nodes seen so far, must be called when name scope changes
+void exproptimize_reset(handle oh);
+
+// optimize all expressions of statement stmt in place
+// return 0 on success, non-0 on error
+sint8 exproptimize_stmt(handle oh, parser_ast_stmt *stmt);
+
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef _EXPRVM_H
+#define _EXPRVM_H
+
+
+// expression bytecode compiler and register-based interpreter
+//
+// expression tree is lowered once into a flat program of three-address instructions,
+// then the program is evaluated for every row without walking the tree:
+//   - constants are preloaded into registers at compile time
+//   - column names are resolved to row slots at compile time, instructions read row slots directly
+//   - result types are inferred from column datatypes and literals, incompatible operands are rejected at compile time
+//   - operations with statically known operand types use typed instructions with native integer and float math,
+//     which fall back to the generic implementation when runtime types differ (e.g. NULL or overflow)
+//   - integer overflow promotes the result to decimal, any float operand makes the result float
+//   - comparison with NULL operand gives NULL (unknown), the caller filtering rows treats it as not selected
+//   - AND/OR follow three-valued logic, right operand is not evaluated when left one decides the result
+//   - x BETWEEN lo AND hi is expected as BETWEEN node with x on the left and AND node of lo, hi on the right,
+//     it is compiled as x >= lo AND x <= hi with x evaluated once
+//   - LIKE pattern and escape character must be constants, pattern is compiled once into pattern pool of the program
+//     and its kernel (see strmatch.h) is run for every row
+
+
+#include "defs/defs.h"
+#include "parser/parser.h"
+#include "table/table.h"
+
+
+#define EXPRVM_MAX_INSTRUCTIONS     (256)
+#define EXPRVM_MAX_REGISTERS        (256)
+#define EXPRVM_ROW_SLOT             (0x8000u)       // instruction operand refers to row slot, not register
+#define EXPRVM_PATTERN_POOL_SZ      (16384)         // bytes for compiled LIKE patterns of program
+
+
+// value of a register or a row slot
+typedef struct _exprvm_value
+{
+    parser_expr_node_type   type;       // one of PARSER_EXPR_NODE_TYPE_INT, NUM, FLOAT, STR, BOOL, NULL
+    union
+    {
+        uint8               boolean;
+        sint64              integer;
+        float64             fp;
+        decimal             num;
+        void                *str;       // string literal handle
+    };
+} exprvm_value;
+
+
+// ENUM: instruction codes, generic operations match parser_expr_op_type
+typedef enum _exprvm_opcode
+{
+    EXPRVM_OP_RET = 0,          // return value of operand a
+
+    EXPRVM_OP_MUL = PARSER_EXPR_OP_TYPE_MUL,
+    EXPRVM_OP_DIV = PARSER_EXPR_OP_TYPE_DIV,
+    EXPRVM_OP_ADD = PARSER_EXPR_OP_TYPE_ADD,
+    EXPRVM_OP_SUB = PARSER_EXPR_OP_TYPE_SUB,
+    EXPRVM_OP_EQ = PARSER_EXPR_OP_TYPE_EQ,
+    EXPRVM_OP_NE = PARSER_EXPR_OP_TYPE_NE,
+    EXPRVM_OP_GT = PARSER_EXPR_OP_TYPE_GT,
+    EXPRVM_OP_GE = PARSER_EXPR_OP_TYPE_GE,
+    EXPRVM_OP_LT = PARSER_EXPR_OP_TYPE_LT,
+    EXPRVM_OP_LE = PARSER_EXPR_OP_TYPE_LE,
+    EXPRVM_OP_IS = PARSER_EXPR_OP_TYPE_IS,
+    EXPRVM_OP_IS_NOT = PARSER_EXPR_OP_TYPE_IS_NOT,
+    EXPRVM_OP_NOT = PARSER_EXPR_OP_TYPE_NOT,
+    EXPRVM_OP_AND = PARSER_EXPR_OP_TYPE_AND,
+    EXPRVM_OP_OR = PARSER_EXPR_OP_TYPE_OR,
+
+    // short-circuit of AND/OR: if operand a is false/true then dst = a and execution continues with instruction b
+    EXPRVM_OP_JUMP_FALSE = 24,
+    EXPRVM_OP_JUMP_TRUE,
+
+    // operand a [NOT] LIKE compiled pattern at offset b of pattern pool, generic op is kept in instruction
+    EXPRVM_OP_LIKE = 28,
+
+    // both operands are expected to be integers
+    EXPRVM_OP_MUL_INT = 32,
+    EXPRVM_OP_ADD_INT,
+    EXPRVM_OP_SUB_INT,
+    EXPRVM_OP_EQ_INT,
+    EXPRVM_OP_NE_INT,
+    EXPRVM_OP_GT_INT,
+    EXPRVM_OP_GE_INT,
+    EXPRVM_OP_LT_INT,
+    EXPRVM_OP_LE_INT,
+
+    // both operands are expected to be decimals
+    EXPRVM_OP_MUL_NUM = 64,
+    EXPRVM_OP_DIV_NUM,
+    EXPRVM_OP_ADD_NUM,
+    EXPRVM_OP_SUB_NUM,
+    EXPRVM_OP_CMP_NUM,          // comparison, generic op is kept in instruction
+
+    // both operands are expected to be floats
+    EXPRVM_OP_MUL_FLT = 96,
+    EXPRVM_OP_DIV_FLT,
+    EXPRVM_OP_ADD_FLT,
+    EXPRVM_OP_SUB_FLT,
+    EXPRVM_OP_CMP_FLT           // comparison, generic op is kept in instruction
+} exprvm_opcode;
+
+
+// instruction: dst = a <op> b
+typedef struct _exprvm_instr
+{
+    uint8       opcode;
+    uint8       op;             // parser_expr_op_type for instructions which need it
+    uint16      dst;            // register
+    uint16      a;              // register or row slot if EXPRVM_ROW_SLOT is set
+    uint16      b;              // register or row slot if EXPRVM_ROW_SLOT is set, instruction index for jumps
+} exprvm_instr;
+
+
+typedef struct _exprvm_interface
+{
+    // resolve column name to the slot of evaluated row and its datatype
+    // return 0 on success, non-0 if column is unknown
+    sint8           (*resolve_name)(const parser_ast_name *name, uint16 *slot, column_datatype *type);
+} exprvm_interface;
+
+
+// return size of the buffer for compiled program
+size_t exprvm_get_alloc_sz();
+
+// compile expression expr into program using buffer buf
+// return program handle or NULL on error (error code is set)
+handle exprvm_compile(void *buf, const parser_ast_expr *expr, exprvm_interface vi);
+
+// evaluate program for row, row[slot] is a value of column resolved to slot
+// return 0 on success, non-0 on error (error code is set)
+sint8 exprvm_eval(handle vh, const exprvm_value *row, exprvm_value *result);
+
+// infer static type of expression expr, type is set to 0 if it is known only at runtime (e.g. NULL operand)
+// return 0 on success, non-0 if operand types are incompatible or column is unknown (error code is set)
+sint8 exprvm_infer_type(const parser_ast_expr *expr, exprvm_interface vi, parser_expr_node_type *type);
+
+// return number of instructions in program
+uint16 exprvm_instr_num(handle vh);
+
+// compile pattern and escape character of LIKE expr into pool of pool_sz bytes from *used on, offset is set
+// to the compiled pattern and used is advanced past it; if pattern or escape character is NULL nothing is compiled
+// and null_operand is set to it, otherwise null_operand is set to NULL
+// return 0 on success, non-0 if pattern is not a constant string, is invalid or doesn't fit (error code is set)
+sint8 exprvm_compile_pattern(const parser_ast_expr *expr, uint8 *pool, uint32 pool_sz, uint32 *used, uint16 *offset,
+                             const parser_ast_expr **null_operand);
+
+
+#endif
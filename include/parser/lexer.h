@@ -26,7 +26,7 @@ typedef enum _lexer_lexem_type
 } lexer_lexem_type;
 
 
-#define LEXER_RESERVED_WORD_NUM     (75)
+#define LEXER_RESERVED_WORD_NUM     (77)
 
 // the list must be sorted by ASCII code number (alphabetically)
 typedef enum _lexer_reserved_word
@@ -55,6 +55,7 @@ typedef enum _lexer_reserved_word
     LEXER_RESERVED_WORD_DISTINCT,
     LEXER_RESERVED_WORD_DOUBLE,
     LEXER_RESERVED_WORD_DROP,
+    LEXER_RESERVED_WORD_ESCAPE,
     LEXER_RESERVED_WORD_EXCEPT,
     LEXER_RESERVED_WORD_FIRST,
     LEXER_RESERVED_WORD_FLOAT,
@@ -73,6 +74,7 @@ typedef enum _lexer_reserved_word
     LEXER_RESERVED_WORD_KEY,
     LEXER_RESERVED_WORD_LAST,
     LEXER_RESERVED_WORD_LEFT,
+    LEXER_RESERVED_WORD_LIKE,
     LEXER_RESERVED_WORD_MODIFY,
     LEXER_RESERVED_WORD_NO,
     LEXER_RESERVED_WORD_NOT,
@@ -151,8 +153,9 @@ typedef struct _lexer_lexem
     lexer_reserved_word reserved_word;
     lexer_token         token;
     uint8               identifier[LEXER_MAX_IDENTIFIER_LEN];
-    decimal             num_literal;
-    sint64              integer;
+    decimal             num_literal;    // number, filled if integer_literal is 0
+    sint64              integer;        // number, filled if integer_literal is 1
+    uint8               integer_literal; // 1 if number is integer which fits in sint64
     handle              str_literal;
     uint16              identifier_len; // length of identifier
     uint64              line;           // lexem line
@@ -195,8 +198,20 @@ sint8 lexer_next(handle lexer, lexer_lexem *lexem);
 sint8 lexer_current(handle lexer, lexer_lexem *lexem);
 
 
+// make the next lexer_next return the last read token again, one token can be put back
+void lexer_unread(handle lexer);
+
+
 // if set = 1 make lexer parse only integers, otherwise full decimal is parsed (default)
 void lexer_num_mode_integer(handle lexer, uint8 set);
 
 
+// if set = 1 make lexer parse integers as decimals too, otherwise integer is taken as integer (default)
+void lexer_num_mode_decimal(handle lexer, uint8 set);
+
+
+// if set = 0 lexical errors are not reported through lexer interface until reset (default is 1)
+void lexer_report_errors(handle lexer, uint8 set);
+
+
 #endif
@@ -16,6 +16,7 @@
 #define PARSER_DEFAULT_DECIMAL_PRECISION    (DECIMAL_POSITIONS)
 #define PARSER_DEFAULT_DECIMAL_SCALE        (DECIMAL_POSITIONS / 2)
 #define PARSER_DEFAULT_TS_PRECISION         (6)
+#define PARSER_DEFAULT_MEMORY_BUDGET        (16 * 1024 * 1024)
 
 
 // ENUM: statement type
@@ -97,15 +98,18 @@ typedef enum _parser_expr_op_type
     PARSER_EXPR_OP_TYPE_IS = 11,
     PARSER_EXPR_OP_TYPE_IS_NOT = 12,
     PARSER_EXPR_OP_TYPE_BETWEEN = 13,
+    PARSER_EXPR_OP_TYPE_LIKE = 14,
+    PARSER_EXPR_OP_TYPE_NOT_LIKE = 15,
+    PARSER_EXPR_OP_TYPE_ESCAPE = 16,        // right operand of LIKE: pattern ESCAPE character
 
     // group 5
-    PARSER_EXPR_OP_TYPE_NOT = 14,
+    PARSER_EXPR_OP_TYPE_NOT = 17,
 
     // group 6
-    PARSER_EXPR_OP_TYPE_AND = 15,
+    PARSER_EXPR_OP_TYPE_AND = 18,
 
     // group 7 (lowest priority)
-    PARSER_EXPR_OP_TYPE_OR = 16,
+    PARSER_EXPR_OP_TYPE_OR = 19,
 
 } parser_expr_op_type;
 
@@ -149,6 +153,8 @@ typedef enum _parser_expr_node_type
     PARSER_EXPR_NODE_TYPE_OP = 4,
     PARSER_EXPR_NODE_TYPE_NULL = 5,
     PARSER_EXPR_NODE_TYPE_BOOL = 6,
+    PARSER_EXPR_NODE_TYPE_INT = 7,      // integer number, converted to decimal on demand
+    PARSER_EXPR_NODE_TYPE_FLOAT = 8,    // floating point number, value of FLOAT and DOUBLE PRECISION columns
 } parser_expr_node_type;
 
 
@@ -213,6 +219,8 @@ typedef struct _parser_ast_expr
         parser_expr_op_type op;
         void                *str;
         decimal             num;
+        sint64              integer;
+        float64             fp;
         parser_ast_name     name;
     };
     parser_expr_node_type   node_type;
@@ -632,8 +640,24 @@ typedef struct _parser_interface
 sint8 parser_parse(parser_ast_stmt **stmt, handle lexer, parser_interface pi);
 
 
+// begin parsing of a script: statements separated with ';'
+// return 0 on success, non-0 on error
+sint8 parser_script_begin(handle lexer, parser_interface pi);
+
+
+// parse next statement of the script into AST, stmt is set to NULL if there are no more statements
+// on syntax error the rest of the failed statement is skipped, so parsing can continue with the next one
+// return 0 on success, -1 on error, 1 on syntax error
+sint8 parser_script_next(parser_ast_stmt **stmt);
+
+
 // deallocate statement
 void parser_deallocate_stmt(parser_ast_stmt *stmt);
 
 
+// set maximum in-memory size of AST, the rest of the statement is spilled to a temporary file in spill_dir
+// spill_dir must stay valid while parser is used, NULL means default directory
+void parser_set_memory_budget(uint64 mem_budget, const achar *spill_dir);
+
+
 #endif
@@ -50,6 +50,14 @@ sint8 pproto_server_send_auth_responce(uint8 auth_status);
 // return 0 on success, non 0 otherwise
 sint8 pproto_server_send_goodbye();
 
+// sends success message without text to client
+// return 0 on success, non 0 otherwise
+sint8 pproto_server_send_success();
+
+// sends end of script message with numbers of succeeded and failed statements
+// return 0 on success, non 0 otherwise
+sint8 pproto_server_send_script_end(uint32 succeeded, uint32 failed);
+
 
 
 ////////////////// text string processing
@@ -77,6 +85,10 @@ sint8 pproto_server_read_char(char_info *ch, sint8 *eos);
 // return 0 on success, non 0 otherwise
 sint8 pproto_server_read_str_end();
 
+// skip the rest of the string sent by client without notifying client
+// return 0 on success, non 0 otherwise
+sint8 pproto_server_skip_str();
+
 // begin sending text string to client
 // return 0 on success, non 0 otherwise
 sint8 pproto_server_send_str_begin();
@@ -100,6 +112,10 @@ sint8 pproto_server_send_str_end();
 // return next message type or -1 on error
 pproto_msg_type pproto_server_read_msg_type();
 
+// read stop-on-error policy of the script request, one of PPROTO_SCRIPT_ON_ERROR_* values
+// return 0 on success, non 0 otherwise
+sint8 pproto_server_read_script_on_error(uint8 *on_error);
+
 // sends error defined by errcode and additional message to client
 // msg is optional, can be NULL, expected encoding is UTF-8 (source code enc)
 // return 0 on success, non 0 otherwise
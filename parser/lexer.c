@@ -38,13 +38,13 @@ typedef struct _lexer_char
 int g_lexer_reserved_word_diap[27] =
 {
 //  A   B   C   D   E   F   G   H   I   J   K   L   M   N   O   P   Q   R   S   T   U   V   W   X   Y   Z   <top>
-    1,  8,  9, 16, 25, 26, 31, 32, 33, 39, 40, 41, 43, 44, 49, 53,  0, 55, 59, 62, 66, 69, 72,  0,  0,  74, 75
+    1,  8,  9, 16, 25, 27, 32, 33, 34, 40, 41, 42, 45, 46, 51, 55,  0, 57, 61, 64, 68, 71, 74,  0,  0,  76, 77
 };
 
 
 // the order must correspnd to the oreder of enum lexer_reserved_word
 // and sorted by ASCII code number (alphabetically)
-const achar *g_lexer_reserved_words[75] =
+const achar *g_lexer_reserved_words[77] =
 {
     NULL,
     _ach("ACTION"),
@@ -71,6 +71,7 @@ const achar *g_lexer_reserved_words[75] =
     _ach("DISTINCT"),
     _ach("DOUBLE"),
     _ach("DROP"),
+    _ach("ESCAPE"),
     _ach("EXCEPT"),
     _ach("FIRST"),
     _ach("FLOAT"),
@@ -89,6 +90,7 @@ const achar *g_lexer_reserved_words[75] =
     _ach("KEY"),
     _ach("LAST"),
     _ach("LEFT"),
+    _ach("LIKE"),
     _ach("MODIFY"),
     _ach("NO"),
     _ach("NOT"),
@@ -400,9 +402,16 @@ typedef struct _lexer_state
     // last read lexem
     lexer_lexem lexem;
 
-    // if num_mode = 1 parse only integers, otherwise decimal
+    // if num_mode = 1 parse only integers, if num_mode = 2 parse all numbers as decimals,
+    // otherwise decimal, integer without fraction and exponent is taken as integer
     uint8 num_mode;
 
+    // if report_errors = 0 lexical errors are not sent to li.report_error
+    uint8 report_errors;
+
+    // if unread = 1 the last read lexem is returned again by lexer_next
+    uint8 unread;
+
     // last read char
     lexer_char ch;
 
@@ -432,7 +441,7 @@ sint8 lexer_report_error(lexer_state *ls, const achar *msg, ...)
 
     va_end(args);
 
-    if(ls->li.report_error(ERROR_SYNTAX_ERROR, ls->errmes) != 0) return -1;
+    if(ls->report_errors && ls->li.report_error(ERROR_SYNTAX_ERROR, ls->errmes) != 0) return -1;
 
     return 0;
 }
@@ -496,6 +505,8 @@ handle lexer_create(void *buf, encoding enc, handle str_literal, lexer_interface
     ls->enc_conv = encoding_get_conversion_fun(enc, ENCODING_ASCII);
     ls->lexem.str_literal = str_literal;
     ls->li = li;
+    ls->report_errors = 1;
+    ls->unread = 0;
 
     assert(NULL != ls->enc_conv);
 
@@ -515,6 +526,8 @@ sint8 lexer_reset(handle lexer)
     ls->line = 1u;
     ls->col = 0u;
     ls->num_mode = 0;
+    ls->report_errors = 1;
+    ls->unread = 0;
 
     return lexer_next_ch(ls);
 }
@@ -605,6 +618,17 @@ sint8 lexer_next_identifier(lexer_state *ls)
 }
 
 
+// put n decimal digits of integer v to m, the most significant digit first
+void lexer_int_digits(sint64 v, sint8 *m, sint32 n)
+{
+    while(n > 0)
+    {
+        m[--n] = (sint8)(v % 10);
+        v /= 10;
+    }
+}
+
+
 sint8 lexer_next_num_literal(lexer_state *ls)
 {
     sint8  m[DECIMAL_POSITIONS];
@@ -613,10 +637,10 @@ sint8 lexer_next_num_literal(lexer_state *ls)
     sint32 e = 0;
     sint32 exp_sign = 0;
     sint32 i;
+    uint8  int_fits = 1;
 
     ls->lexem.integer = 0L;
-    memset(&ls->lexem.num_literal, 0, sizeof(ls->lexem.num_literal));
-    ls->lexem.num_literal.sign = DECIMAL_SIGN_POS;
+    ls->lexem.integer_literal = 0;
 
     while(LEXER_CHAR_TYPE_DIGIT == ls->ch.type && (48 == ls->ch.ach.chr[0]))
     {
@@ -627,17 +651,29 @@ sint8 lexer_next_num_literal(lexer_state *ls)
     {
         d = ls->ch.ach.chr[0] - 48;
 
+        if(int_fits)
+        {
+            if(ls->lexem.integer > (0x7FFFFFFFFFFFFFFFL - d) / 10L)
+            {
+                // digits are kept from now on, the ones before are taken from the integer
+                int_fits = 0;
+                lexer_int_digits(ls->lexem.integer, m, n);
+            }
+            else
+            {
+                ls->lexem.integer *= 10;
+                ls->lexem.integer += d;
+            }
+        }
+
         if(ls->num_mode == 1)
         {
-            if(ls->lexem.integer > (0x7FFFFFFFFFFFFFFFL - 10L) / 10L)
+            if(!int_fits)
             {
                 // overflow
                 if(lexer_report_error(ls, _ach("integer is too big at line %d, column %d"), ls->lexem.line, ls->lexem.col) != 0) return -1;
                 return 1;
             }
-
-            ls->lexem.integer *= 10;
-            ls->lexem.integer += d;
         }
         else
         {
@@ -648,7 +684,8 @@ sint8 lexer_next_num_literal(lexer_state *ls)
                 return 1;
             }
 
-            m[n++] =  d;
+            if(!int_fits) m[n] = d;
+            n++;
         }
 
         if(lexer_next_ch(ls) != 0) return -1;
@@ -656,9 +693,25 @@ sint8 lexer_next_num_literal(lexer_state *ls)
 
     if(ls->num_mode == 1)
     {
+        ls->lexem.integer_literal = 1;
+        return 0;
+    }
+
+    // fast path: integer without fraction and exponent, decimal is not built
+    if(int_fits && ls->num_mode == 0
+        && !(ls->ch.type == LEXER_CHAR_TYPE_SPECIAL && ls->ch.ach.chr[0] == _ach('.'))
+        && !(ls->ch.type == LEXER_CHAR_TYPE_LCASE_LETTER && ls->ch.ach.chr[0] == _ach('e'))
+        && !(ls->ch.type == LEXER_CHAR_TYPE_UCASE_LETTER && ls->ch.ach.chr[0] == _ach('E')))
+    {
+        ls->lexem.integer_literal = 1;
         return 0;
     }
 
+    if(int_fits) lexer_int_digits(ls->lexem.integer, m, n);
+
+    memset(&ls->lexem.num_literal, 0, sizeof(ls->lexem.num_literal));
+    ls->lexem.num_literal.sign = DECIMAL_SIGN_POS;
+
     if(ls->ch.type == LEXER_CHAR_TYPE_SPECIAL && ls->ch.ach.chr[0] == _ach('.'))
     {
         if(lexer_next_ch(ls) != 0) return -1;
@@ -783,6 +836,13 @@ sint8 lexer_next(handle lexer, lexer_lexem *lexem)
     uint8 ch;
     sint8 res;
 
+    if(ls->unread)
+    {
+        ls->unread = 0;
+        memcpy(lexem, &ls->lexem, sizeof(*lexem));
+        return 0;
+    }
+
     ls->lexem.type = 0;
     ls->lexem.identifier_len = 0;
     ls->lexem.col = 0u;
@@ -874,6 +934,14 @@ sint8 lexer_current(handle lexer, lexer_lexem *lexem)
 }
 
 
+// make the next lexer_next return the last read token again
+void lexer_unread(handle lexer)
+{
+    lexer_state *ls = (lexer_state *)lexer;
+    ls->unread = 1;
+}
+
+
 // if set = 1 make lexer parse only integers, otherwise full decimal is parsed (default)
 void lexer_num_mode_integer(handle lexer, uint8 set)
 {
@@ -881,3 +949,19 @@ void lexer_num_mode_integer(handle lexer, uint8 set)
     ls->num_mode = set;
 }
 
+
+// if set = 1 make lexer parse integers as decimals too, otherwise integer is taken as integer (default)
+void lexer_num_mode_decimal(handle lexer, uint8 set)
+{
+    lexer_state *ls = (lexer_state *)lexer;
+    ls->num_mode = set ? 2 : 0;
+}
+
+
+// if set = 0 lexical errors are not reported through lexer interface (default is 1)
+void lexer_report_errors(handle lexer, uint8 set)
+{
+    lexer_state *ls = (lexer_state *)lexer;
+    ls->report_errors = set;
+}
+
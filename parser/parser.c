@@ -2,6 +2,7 @@
 #include "common/decimal.h"
 #include "common/error.h"
 #include "common/string_literal.h"
+#include "common/arena.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -11,19 +12,32 @@
 #define PARSER_ERRMES_BUF_SZ    (1024)
 
 
+// string literal of AST, its chunks and spill file are released with the statement
+typedef struct _parser_str_literal parser_str_literal;
+typedef struct _parser_str_literal
+{
+    parser_str_literal  *next;
+    handle              str;
+} parser_str_literal;
+
 struct _parser_state
 {
     handle              lexer;                              // lexer instance
     lexer_lexem         lexem;                              // currently read lexem
-    uint8               expr_op_level[17];                  // "operator -> precedence" correspondence
-    parser_ast_stmt     *stmt_base;                         // statement base address
-    uint64              total_sz;                           // total allocated size
+    uint8               expr_op_level[20];                  // "operator -> precedence" correspondence
+    handle              ast_arena;                          // AST elements storage, elements never move
+    uint64              mem_budget;                         // in-memory size of AST, the rest is spilled to disk
+    const achar         *spill_dir;                         // directory for spill file
+    parser_str_literal  *str_literals;                      // string literals of AST
     achar               errmes[PARSER_ERRMES_BUF_SZ];       // buffer for formatted error message
     sint8               (*report_error)(error_code error, const achar *msg);
     parser_expr_op_type saved_op;                           // first operator with priority lower than prio of "NOT" (NOT is special case)
 } g_parser_state =
 {
-    .stmt_base = NULL,
+    .ast_arena = NULL,
+    .mem_budget = PARSER_DEFAULT_MEMORY_BUDGET,
+    .spill_dir = NULL,
+    .str_literals = NULL,
     .lexem =
     {
         .type = 0,
@@ -31,10 +45,9 @@ struct _parser_state
         .col = 0,
         .str_literal = NULL
     },
-    .total_sz = 0,
     .report_error = NULL,
     .lexer = NULL,
-    .expr_op_level = {0, 1,1, 2,2, 3,3,3,3,3,3, 4,4,4, 5, 6, 7},
+    .expr_op_level = {0, 1,1, 2,2, 3,3,3,3,3,3, 4,4,4,4,4,4, 5, 6, 7},
     .saved_op = PARSER_EXPR_OP_TYPE_NONE
 };
 
@@ -68,25 +81,37 @@ sint8 parser_report_error(const achar *msg, ...)
 // free up space
 void parser_deallocate_stmt(parser_ast_stmt *stmt)
 {
-    free(stmt);
+    (void)stmt;
+
+    for(; NULL != g_parser_state.str_literals; g_parser_state.str_literals = g_parser_state.str_literals->next)
+    {
+        string_literal_destroy(g_parser_state.str_literals->str);
+    }
+
+    if(NULL != g_parser_state.ast_arena) arena_reset(g_parser_state.ast_arena);
 }
 
 
 sint8 parser_allocate_ast_el(void **ptr, size_t sz)
 {
-    // TODO: spill to disk if statement is too big to reside in memory
-    void *new_base = realloc(g_parser_state.stmt_base, g_parser_state.total_sz + sz);
-    if(NULL == new_base)
+    if(NULL == g_parser_state.ast_arena)
+    {
+        void *buf = malloc(arena_get_alloc_sz());
+        g_parser_state.ast_arena = arena_create(buf, g_parser_state.mem_budget, g_parser_state.spill_dir);
+        if(NULL == g_parser_state.ast_arena)
+        {
+            free(buf);
+            if(g_parser_state.report_error(ERROR_OUT_OF_MEMORY, NULL) != 0) return -1;
+            return 1;
+        }
+    }
+
+    if((*ptr = arena_alloc(g_parser_state.ast_arena, sz)) == NULL)
     {
         if(g_parser_state.report_error(ERROR_OUT_OF_MEMORY, NULL) != 0) return -1;
         return 1;
     }
 
-    *ptr = new_base + g_parser_state.total_sz;
-    g_parser_state.stmt_base = new_base;
-    g_parser_state.total_sz += sz;
-    memset(*ptr, 0, sz);
-
     return 0;
 }
 
@@ -200,19 +225,32 @@ sint8 parser_parse_expr_arg(parser_ast_expr *stmt)
     {
         stmt->node_type = PARSER_EXPR_NODE_TYPE_STR;
         void *strlit_buf;
+        parser_str_literal *strlit;
         if((res = parser_allocate_ast_el((void **)&strlit_buf, string_literal_alloc_sz())) != 0) return res;
+        if((res = parser_allocate_ast_el((void **)&strlit, sizeof(parser_str_literal))) != 0) return res;
         if((stmt->str = string_literal_create(strlit_buf)) == NULL ||
             string_literal_move(g_parser_state.lexem.str_literal, stmt->str) != 0)
         {
             if(0 != parser_report_error(_ach("internal server error at line %d, column %d"), g_parser_state.lexem.line, g_parser_state.lexem.col)) return -1;
             return -1;
         }
+        strlit->str = stmt->str;
+        strlit->next = g_parser_state.str_literals;
+        g_parser_state.str_literals = strlit;
         if((res = lexer_next(g_parser_state.lexer, &g_parser_state.lexem)) != 0) return res;
     }
-    else if(g_parser_state.lexem.type == LEXEM_TYPE_NUM_LITERAL)   // decimal
+    else if(g_parser_state.lexem.type == LEXEM_TYPE_NUM_LITERAL)   // number
     {
-        stmt->node_type = PARSER_EXPR_NODE_TYPE_NUM;
-        memcpy(&stmt->num, &g_parser_state.lexem.num_literal, sizeof(stmt->num));
+        if(g_parser_state.lexem.integer_literal)
+        {
+            stmt->node_type = PARSER_EXPR_NODE_TYPE_INT;
+            stmt->integer = g_parser_state.lexem.integer;
+        }
+        else
+        {
+            stmt->node_type = PARSER_EXPR_NODE_TYPE_NUM;
+            memcpy(&stmt->num, &g_parser_state.lexem.num_literal, sizeof(stmt->num));
+        }
         if((res = lexer_next(g_parser_state.lexer, &g_parser_state.lexem)) != 0) return res;
     }
     else if(g_parser_state.lexem.type == LEXEM_TYPE_IDENTIFIER)   // identifier or name
@@ -317,6 +355,28 @@ sint8 parser_parse_expr_op(parser_expr_op_type *operator)
                 if((res = lexer_next(g_parser_state.lexer, &g_parser_state.lexem)) != 0) return res;
             }
         }
+        else if(g_parser_state.lexem.reserved_word == LEXER_RESERVED_WORD_LIKE)
+        {
+            op = PARSER_EXPR_OP_TYPE_LIKE;
+            if((res = lexer_next(g_parser_state.lexer, &g_parser_state.lexem)) != 0) return res;
+        }
+        else if(g_parser_state.lexem.reserved_word == LEXER_RESERVED_WORD_NOT)
+        {
+            // NOT LIKE, otherwise NOT is left for the caller (e.g. NOT NULL of column definition)
+            lexer_lexem not_lexem = g_parser_state.lexem;
+
+            if((res = lexer_next(g_parser_state.lexer, &g_parser_state.lexem)) != 0) return res;
+            if(g_parser_state.lexem.type == LEXEM_TYPE_RESERVED_WORD && g_parser_state.lexem.reserved_word == LEXER_RESERVED_WORD_LIKE)
+            {
+                op = PARSER_EXPR_OP_TYPE_NOT_LIKE;
+                if((res = lexer_next(g_parser_state.lexer, &g_parser_state.lexem)) != 0) return res;
+            }
+            else
+            {
+                lexer_unread(g_parser_state.lexer);
+                g_parser_state.lexem = not_lexem;
+            }
+        }
         else if(g_parser_state.lexem.reserved_word == LEXER_RESERVED_WORD_AND)
         {
             op = PARSER_EXPR_OP_TYPE_AND;
@@ -335,6 +395,34 @@ sint8 parser_parse_expr_op(parser_expr_op_type *operator)
 }
 
 
+// second argument of binary operator stmt, pattern of LIKE can be followed by ESCAPE <term>,
+// then right operand is ESCAPE node with pattern on the left and escape character on the right
+sint8 parser_parse_expr_second_arg(parser_ast_expr *stmt)
+{
+    sint8 res;
+    parser_ast_expr *pattern;
+
+    if((res = parser_allocate_ast_el((void **)&stmt->right, sizeof(*stmt->right))) != 0) return res;
+    if((res = parser_parse_expr_arg(stmt->right)) != 0) return res;
+
+    if((stmt->op == PARSER_EXPR_OP_TYPE_LIKE || stmt->op == PARSER_EXPR_OP_TYPE_NOT_LIKE)
+            && g_parser_state.lexem.type == LEXEM_TYPE_RESERVED_WORD && g_parser_state.lexem.reserved_word == LEXER_RESERVED_WORD_ESCAPE)
+    {
+        if((res = parser_allocate_ast_el((void **)&pattern, sizeof(*pattern))) != 0) return res;
+        *pattern = *stmt->right;
+        stmt->right->node_type = PARSER_EXPR_NODE_TYPE_OP;
+        stmt->right->op = PARSER_EXPR_OP_TYPE_ESCAPE;
+        stmt->right->left = pattern;
+
+        if((res = lexer_next(g_parser_state.lexer, &g_parser_state.lexem)) != 0) return res;
+        if((res = parser_allocate_ast_el((void **)&stmt->right->right, sizeof(*stmt->right->right))) != 0) return res;
+        if((res = parser_parse_expr_arg(stmt->right->right)) != 0) return res;
+    }
+
+    return 0;
+}
+
+
 // Build expression tree.
 // Parsing stops if next operator has priority lower than specified ( > highest_lvl);
 //   the parsed operator then is saved as g_parser_state.saved_op.
@@ -358,9 +446,8 @@ sint8 parser_parse_expr_with_op_prio(parser_ast_expr *stmt, uint8 highest_lvl)
             stmt->op = PARSER_EXPR_OP_TYPE_SUB;
 
             if((res = parser_allocate_ast_el((void **)&stmt->left, sizeof(*stmt->left))) != 0) return res;
-            stmt->left->node_type = PARSER_EXPR_NODE_TYPE_NUM;
-            memset(&stmt->left->num, 0, sizeof(stmt->left->num));
-            stmt->left->num.sign = DECIMAL_SIGN_POS;
+            stmt->left->node_type = PARSER_EXPR_NODE_TYPE_INT;
+            stmt->left->integer = 0;
 
             if((res = lexer_next(g_parser_state.lexer, &g_parser_state.lexem)) != 0) return res;
 
@@ -409,8 +496,7 @@ sint8 parser_parse_expr_with_op_prio(parser_ast_expr *stmt, uint8 highest_lvl)
             node_for_level[g_parser_state.expr_op_level[op]] = stmt;
 
             // second argument
-            if((res = parser_allocate_ast_el((void **)&stmt->right, sizeof(*stmt->right))) != 0) return res;
-            if((res = parser_parse_expr_arg(stmt->right)) != 0) return res;
+            if((res = parser_parse_expr_second_arg(stmt)) != 0) return res;
         }
         else
         {
@@ -468,8 +554,7 @@ sint8 parser_parse_expr_with_op_prio(parser_ast_expr *stmt, uint8 highest_lvl)
             node_for_level[new_level] = stmt;
 
             // second argument
-            if((res = parser_allocate_ast_el((void **)&stmt->right, sizeof(*stmt->right))) != 0) return res;
-            if((res = parser_parse_expr_arg(stmt->right)) != 0) return res;
+            if((res = parser_parse_expr_second_arg(stmt)) != 0) return res;
         }
         else
         {
@@ -1272,7 +1357,7 @@ sint8 parser_process_integer(sint64 *val, sint64 min, sint64 max)
 {
     sint8 res;
 
-    if(g_parser_state.lexem.type != LEXEM_TYPE_NUM_LITERAL)
+    if(g_parser_state.lexem.type != LEXEM_TYPE_NUM_LITERAL || !g_parser_state.lexem.integer_literal)
     {
         if(0 != parser_report_error(_ach("integer value is expected at line %d, column %d"), g_parser_state.lexem.line, g_parser_state.lexem.col)) return -1;
         return 1;
@@ -2103,27 +2188,28 @@ sint8 parser_parse_alter_table(parser_ast_alter_table *stmt)
 
 
 
-// parse statement
-sint8 parser_parse(parser_ast_stmt **pstmt, handle lexer, parser_interface pi)
+// set in-memory size limit of AST and directory for spilling the rest
+void parser_set_memory_budget(uint64 mem_budget, const achar *spill_dir)
 {
-    sint8 res;
-    parser_ast_stmt *stmt = NULL;
+    g_parser_state.mem_budget = mem_budget;
+    g_parser_state.spill_dir = spill_dir;
+    if(NULL != g_parser_state.ast_arena) arena_set_budget(g_parser_state.ast_arena, mem_budget, spill_dir);
+}
 
-    g_parser_state.lexer = lexer;
-    g_parser_state.report_error = pi.report_error;
 
-    if(lexer_reset(lexer) != 0) return -1;
+// parse statement starting with current lexem, stop at the first lexem which is not part of the statement
+// return 0 on success, -1 on error, 1 on syntax error
+sint8 parser_parse_stmt(parser_ast_stmt **pstmt)
+{
+    sint8 res;
+    parser_ast_stmt *stmt = NULL;
 
-    g_parser_state.stmt_base = stmt;
-    g_parser_state.total_sz = 0;
     g_parser_state.saved_op = PARSER_EXPR_OP_TYPE_NONE;
 
     if((res = parser_allocate_ast_el((void **)&stmt, sizeof(*stmt))) != 0) return res;
     *pstmt = stmt;
     lexer_num_mode_integer(g_parser_state.lexer, 0);
 
-    if((res = lexer_next(g_parser_state.lexer, &g_parser_state.lexem)) != 0) return res;
-
     if(g_parser_state.lexem.type == LEXEM_TYPE_RESERVED_WORD)
     {
         if(g_parser_state.lexem.reserved_word == LEXER_RESERVED_WORD_SELECT)
@@ -2305,6 +2391,24 @@ sint8 parser_parse(parser_ast_stmt **pstmt, handle lexer, parser_interface pi)
         return 1;
     }
 
+    return 0;
+}
+
+
+// parse statement
+sint8 parser_parse(parser_ast_stmt **pstmt, handle lexer, parser_interface pi)
+{
+    sint8 res;
+
+    g_parser_state.lexer = lexer;
+    g_parser_state.report_error = pi.report_error;
+
+    if(lexer_reset(lexer) != 0) return -1;
+
+    if((res = lexer_next(g_parser_state.lexer, &g_parser_state.lexem)) != 0) return res;
+
+    if((res = parser_parse_stmt(pstmt)) != 0) return res;
+
     // statement end is expected
     if(g_parser_state.lexem.type != LEXEM_TYPE_EOS)
     {
@@ -2315,3 +2419,95 @@ sint8 parser_parse(parser_ast_stmt **pstmt, handle lexer, parser_interface pi)
     return 0;
 }
 
+
+// return 1 if current lexem is statement delimiter in script
+uint8 parser_is_script_delimiter()
+{
+    return g_parser_state.lexem.type == LEXEM_TYPE_TOKEN && g_parser_state.lexem.token == LEXER_TOKEN_SEMICOLON;
+}
+
+
+// skip the rest of failed statement up to the delimiter or end of script without reporting lexical errors
+// return 0 on success, -1 on error
+sint8 parser_skip_script_stmt()
+{
+    sint8 res = 0;
+
+    lexer_report_errors(g_parser_state.lexer, 0);
+
+    while(!parser_is_script_delimiter() && g_parser_state.lexem.type != LEXEM_TYPE_EOS)
+    {
+        if((res = lexer_next(g_parser_state.lexer, &g_parser_state.lexem)) == -1) break;
+
+        // lexem is not updated on lexical error
+        if(1 == res) g_parser_state.lexem.type = 0;
+    }
+
+    lexer_report_errors(g_parser_state.lexer, 1);
+
+    return res == -1 ? -1 : 0;
+}
+
+
+// begin parsing of a script
+sint8 parser_script_begin(handle lexer, parser_interface pi)
+{
+    g_parser_state.lexer = lexer;
+    g_parser_state.report_error = pi.report_error;
+
+    if(lexer_reset(lexer) != 0) return -1;
+
+    // no statement is parsed yet, first call to parser_script_next starts reading
+    g_parser_state.lexem.type = LEXEM_TYPE_TOKEN;
+    g_parser_state.lexem.token = LEXER_TOKEN_SEMICOLON;
+
+    return 0;
+}
+
+
+// parse next statement of the script
+sint8 parser_script_next(parser_ast_stmt **pstmt)
+{
+    sint8 res;
+
+    *pstmt = NULL;
+
+    if(g_parser_state.lexem.type == LEXEM_TYPE_EOS) return 0;
+
+    // skip delimiter of the previous statement and empty statements
+    do
+    {
+        if((res = lexer_next(g_parser_state.lexer, &g_parser_state.lexem)) != 0)
+        {
+            if(1 == res)
+            {
+                g_parser_state.lexem.type = 0;
+                if(parser_skip_script_stmt() != 0) return -1;
+            }
+            return res;
+        }
+    }
+    while(parser_is_script_delimiter());
+
+    if(g_parser_state.lexem.type == LEXEM_TYPE_EOS) return 0;
+
+    if((res = parser_parse_stmt(pstmt)) == 0)
+    {
+        // statement delimiter or end of script is expected
+        if(!parser_is_script_delimiter() && g_parser_state.lexem.type != LEXEM_TYPE_EOS)
+        {
+            if(0 != parser_report_error(_ach("Unexpected continuation at line %d, column %d"), g_parser_state.lexem.line, g_parser_state.lexem.col)) return -1;
+            res = 1;
+        }
+    }
+
+    if(1 == res)
+    {
+        if(NULL != *pstmt) parser_deallocate_stmt(*pstmt);
+        *pstmt = NULL;
+        if(parser_skip_script_stmt() != 0) return -1;
+    }
+
+    return res;
+}
+
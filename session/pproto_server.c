@@ -37,13 +37,10 @@ struct {
     encoding server_encoding;
 
     encoding_conversion_fun enc_client_to_srv_conversion;
-    encoding_conversion_fun enc_srv_to_client_conversion;
-    encoding_conversion_fun enc_utf8_to_client_conversion;
     encoding_build_char_fun enc_client_build_char;
-    encoding_char_len_fun   enc_srv_char_len;
 
     uint8   chunk_len_left;
-} g_pproto_server_state = {-1, PPROTO_SERVER_RECV_BUF_SIZE, PPROTO_SERVER_SEND_BUF_SIZE, 0u, 0u, 0u, 0u, 0u, ENCODING_UNKNOWN, ENCODING_UNKNOWN, NULL, NULL, NULL, NULL, NULL, 0u};
+} g_pproto_server_state = {-1, PPROTO_SERVER_RECV_BUF_SIZE, PPROTO_SERVER_SEND_BUF_SIZE, 0u, 0u, 0u, 0u, 0u, ENCODING_UNKNOWN, ENCODING_UNKNOWN, NULL, NULL, 0u};
 
 
 /////////////// functions
@@ -183,10 +180,7 @@ void pproto_server_set_client_encoding(encoding enc)
     g_pproto_server_state.client_encoding = enc;
 
     g_pproto_server_state.enc_client_to_srv_conversion = encoding_get_conversion_fun(g_pproto_server_state.client_encoding, g_pproto_server_state.server_encoding);
-    g_pproto_server_state.enc_srv_to_client_conversion = encoding_get_conversion_fun(g_pproto_server_state.server_encoding, g_pproto_server_state.client_encoding);
-    g_pproto_server_state.enc_utf8_to_client_conversion = encoding_get_conversion_fun(ENCODING_UTF8, g_pproto_server_state.client_encoding);
     g_pproto_server_state.enc_client_build_char = encoding_get_build_char_fun(g_pproto_server_state.client_encoding);
-    g_pproto_server_state.enc_srv_char_len = encoding_get_char_len_fun(g_pproto_server_state.server_encoding);
 }
 
 
@@ -249,9 +243,6 @@ sint8 pproto_server_send_str_begin()
 {
     assert(g_pproto_server_state.client_encoding != ENCODING_UNKNOWN);
     assert(g_pproto_server_state.server_encoding != ENCODING_UNKNOWN);
-    assert(g_pproto_server_state.enc_srv_to_client_conversion != NULL);
-    assert(g_pproto_server_state.enc_utf8_to_client_conversion != NULL);
-    assert(g_pproto_server_state.enc_srv_char_len != NULL);
     assert(g_pproto_server_state.send_buf_size > 512);
 
     if(0 != pproto_server_send_uint8(PPROTO_UTEXT_STRING_MAGIC)) return 1;
@@ -276,18 +267,10 @@ sint8 pproto_server_send_str_begin()
 
 sint8 pproto_server_send_str(const uint8 *str_buf, sint32 sz, uint8 srv_enc)
 {
-    assert(str_buf != NULL);
-
-    const_char_info server_chr;
-    char_info client_chr;
-    encoding_conversion_fun conv_fun = (srv_enc != 0) ? g_pproto_server_state.enc_srv_to_client_conversion : g_pproto_server_state.enc_utf8_to_client_conversion;
-
-    client_chr.chr = g_pproto_server_send_buf + g_pproto_server_state.send_buf_ptr;  // will write directly to send buffer
+    uint64 rd, wr, space;
+    encoding enc = (srv_enc != 0) ? g_pproto_server_state.server_encoding : ENCODING_UTF8;
 
-    server_chr.chr = str_buf;     // will read directly from the source buffer
-    server_chr.ptr = 0u;
-    server_chr.state = CHAR_STATE_COMPLETE;
-    server_chr.length = 0u;
+    assert(str_buf != NULL);
 
     if(g_pproto_server_state.send_buf_ptr >= g_pproto_server_state.send_buf_size - 256 - ENCODING_MAXCHAR_LEN)
     {
@@ -298,17 +281,20 @@ sint8 pproto_server_send_str(const uint8 *str_buf, sint32 sz, uint8 srv_enc)
 
     while(sz > 0)
     {
-        g_pproto_server_state.enc_srv_char_len(&server_chr);
-        if(server_chr.length == 0)
+        // convert directly to send buffer what fits in the current chunk, the last character may overflow it
+        space = 255 - g_pproto_server_state.chunk_len;
+        if(space < ENCODING_MAXCHAR_LEN) space = ENCODING_MAXCHAR_LEN;
+
+        wr = encoding_convert(enc, g_pproto_server_state.client_encoding, str_buf, (uint64)sz,
+                g_pproto_server_send_buf + g_pproto_server_state.send_buf_ptr, space, &rd);
+        if(rd == 0)
         {
-            logger_error(_ach("pproto_server, invalid character with length 0"));
+            logger_error(_ach("pproto_server, incomplete character at the end of text string"));
             return 1;
         }
 
-        conv_fun(&server_chr, &client_chr);
-        client_chr.chr += client_chr.length;
-        g_pproto_server_state.send_buf_ptr += client_chr.length;
-        g_pproto_server_state.chunk_len += client_chr.length;
+        g_pproto_server_state.send_buf_ptr += wr;
+        g_pproto_server_state.chunk_len += wr;
 
         if(g_pproto_server_state.chunk_len >= 255)
         {
@@ -320,13 +306,12 @@ sint8 pproto_server_send_str(const uint8 *str_buf, sint32 sz, uint8 srv_enc)
             if(g_pproto_server_state.chunk_len > 0)
             {
                 // shift overflow part to reserve space for the new chunk's length
-                memcpy(g_pproto_server_send_buf + g_pproto_server_state.last_chunk_len_ptr + 1,
+                memmove(g_pproto_server_send_buf + g_pproto_server_state.last_chunk_len_ptr + 1,
                         g_pproto_server_send_buf + g_pproto_server_state.last_chunk_len_ptr,
                         g_pproto_server_state.chunk_len);
             }
 
             g_pproto_server_state.send_buf_ptr++;
-            client_chr.chr++;
 
             // make sure next chunk fits
             if(g_pproto_server_state.send_buf_ptr >= g_pproto_server_state.send_buf_size - 256 - ENCODING_MAXCHAR_LEN)
@@ -339,13 +324,12 @@ sint8 pproto_server_send_str(const uint8 *str_buf, sint32 sz, uint8 srv_enc)
 
                 g_pproto_server_state.send_buf_ptr = g_pproto_server_state.chunk_len + 1;  // newely started chunk + it's length
                 memcpy(g_pproto_server_send_buf, g_pproto_server_send_buf + g_pproto_server_state.last_chunk_len_ptr, g_pproto_server_state.send_buf_ptr);
-                client_chr.chr = g_pproto_server_send_buf + g_pproto_server_state.send_buf_ptr;
                 g_pproto_server_state.last_chunk_len_ptr = 0;
             }
         }
 
-        server_chr.chr += server_chr.length;
-        sz -= server_chr.length;
+        str_buf += rd;
+        sz -= rd;
     }
 
     return 0;
@@ -394,11 +378,12 @@ sint8 pproto_server_read_str_begin(uint64 *len)
 
 sint8 pproto_server_read_str(uint8 *str_buf, uint64 *sz, uint64 *charlen)
 {
-    uint64      wr = 0u, chrcnt = 0u;
+    uint64      wr = 0u, chrcnt = 0u, avail, valid, rd;
     uint8       completed = 0u;
     char_info   server_chr;
     char_info   client_chr;
     uint8       client_chr_buf[ENCODING_MAXCHAR_LEN];
+    const uint8 *client_str;
 
     assert(*sz >= ENCODING_MAXCHAR_LEN);
     assert(g_pproto_server_state.client_encoding != ENCODING_UNKNOWN);
@@ -409,7 +394,6 @@ sint8 pproto_server_read_str(uint8 *str_buf, uint64 *sz, uint64 *charlen)
     client_chr.chr = client_chr_buf;
     client_chr.ptr = 0u;
     client_chr.state = CHAR_STATE_INCOMPLETE;
-    server_chr.chr = str_buf;     // will write directly in the destination buffer
 
     if(g_pproto_server_state.chunk_len_left == 0)
     {
@@ -423,36 +407,70 @@ sint8 pproto_server_read_str(uint8 *str_buf, uint64 *sz, uint64 *charlen)
             if(pproto_server_read_portion() != 0) return 1;
         }
 
-        g_pproto_server_state.enc_client_build_char(&client_chr, g_pproto_server_recv_buf[g_pproto_server_state.recv_buf_ptr]);
-        switch(client_chr.state)
+        avail = g_pproto_server_state.recv_buf_upper_bound - g_pproto_server_state.recv_buf_ptr;
+        if(avail > g_pproto_server_state.chunk_len_left) avail = g_pproto_server_state.chunk_len_left;
+        client_str = g_pproto_server_recv_buf + g_pproto_server_state.recv_buf_ptr;
+        rd = 0;
+
+        if(client_chr.ptr == 0u)
         {
-            case CHAR_STATE_INVALID:
-                // invalid character
+            // validate and convert whole characters received in the current chunk
+            if(CHAR_STATE_INVALID == encoding_validate(g_pproto_server_state.client_encoding, client_str, avail, &valid))
+            {
                 logger_error(_ach("pproto_server, reading text string: invalid character received from client"));
                 return 1;
+            }
+
+            // room for the next char is kept as by reading byte by byte
+            if(valid > 0)
+            {
+                wr += encoding_convert(g_pproto_server_state.client_encoding, g_pproto_server_state.server_encoding,
+                        client_str, valid, str_buf + wr, *sz - wr - (ENCODING_MAXCHAR_LEN - 1), &rd);
+                chrcnt += encoding_count(g_pproto_server_state.client_encoding, client_str, rd);
 
-            case CHAR_STATE_COMPLETE:
-                // completed character
-                g_pproto_server_state.enc_client_to_srv_conversion((const_char_info*)&client_chr, &server_chr);
-                wr += server_chr.length;
                 if(*(sz) - wr < ENCODING_MAXCHAR_LEN)   // next char may not fit
                 {
                     completed = 1u;
                 }
+            }
+        }
 
-                chrcnt++;
-                client_chr.ptr = 0u;
-                client_chr.state = CHAR_STATE_INCOMPLETE;
-                server_chr.chr += server_chr.length;
-                break;
+        if(rd == 0)
+        {
+            // character split between chunks or portions is built byte by byte
+            g_pproto_server_state.enc_client_build_char(&client_chr, *client_str);
+            rd = 1;
 
-            case CHAR_STATE_INCOMPLETE:
-            default:
-                break;
+            switch(client_chr.state)
+            {
+                case CHAR_STATE_INVALID:
+                    // invalid character
+                    logger_error(_ach("pproto_server, reading text string: invalid character received from client"));
+                    return 1;
+
+                case CHAR_STATE_COMPLETE:
+                    // completed character
+                    server_chr.chr = str_buf + wr;
+                    g_pproto_server_state.enc_client_to_srv_conversion((const_char_info*)&client_chr, &server_chr);
+                    wr += server_chr.length;
+                    if(*(sz) - wr < ENCODING_MAXCHAR_LEN)   // next char may not fit
+                    {
+                        completed = 1u;
+                    }
+
+                    chrcnt++;
+                    client_chr.ptr = 0u;
+                    client_chr.state = CHAR_STATE_INCOMPLETE;
+                    break;
+
+                case CHAR_STATE_INCOMPLETE:
+                default:
+                    break;
+            }
         }
 
-        g_pproto_server_state.recv_buf_ptr++;
-        g_pproto_server_state.chunk_len_left--;
+        g_pproto_server_state.recv_buf_ptr += rd;
+        g_pproto_server_state.chunk_len_left -= rd;
 
         if(g_pproto_server_state.chunk_len_left == 0)
         {
@@ -575,6 +593,20 @@ sint8 pproto_server_read_str_end()
 }
 
 
+sint8 pproto_server_skip_str()
+{
+    uint8 strbuf[255];
+
+    while(g_pproto_server_state.chunk_len_left != 0)
+    {
+        if(0 != pproto_server_get(strbuf, g_pproto_server_state.chunk_len_left)) return 1;
+        if(0 != pproto_server_get_uint8(&g_pproto_server_state.chunk_len_left)) return 1;
+    }
+
+    return 0;
+}
+
+
 sint8 pproto_server_read_auth(auth_credentials *cred)
 {
     uint8 user_name[AUTH_USER_NAME_SZ + ENCODING_MAXCHAR_LEN];
@@ -611,7 +643,8 @@ sint8 pproto_server_read_auth(auth_credentials *cred)
 sint8 pproto_server_send_error(error_code errcode, const achar* msg)
 {
     error_set(errcode);
-    if(pproto_server_send_str_begin() != 0
+    if(pproto_server_send_uint8(PPROTO_ERROR_MSG_MAGIC) != 0
+            || pproto_server_send_str_begin() != 0
             || pproto_server_send_str((uint8 *)error_msg(), strlen(error_msg()), 0) != 0)
     {
         return 1;
@@ -677,6 +710,32 @@ sint8 pproto_server_send_auth_responce(uint8 auth_status)
 }
 
 
+sint8 pproto_server_send_success()
+{
+    if(pproto_server_send_uint8(PPROTO_SUCCESS_MESSAGE_WITHOUT_TEXT_MAGIC) != 0
+            || pproto_server_flush_send() != 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+
+sint8 pproto_server_send_script_end(uint32 succeeded, uint32 failed)
+{
+    if(pproto_server_send_uint8(PPROTO_SCRIPT_END_MESSAGE_MAGIC) != 0
+            || pproto_server_send_uint32(succeeded) != 0
+            || pproto_server_send_uint32(failed) != 0
+            || pproto_server_flush_send() != 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+
 sint8 pproto_server_send_goodbye()
 {
     if(pproto_server_send_uint8(PPROTO_GOODBYE_MESSAGE) != 0
@@ -714,6 +773,8 @@ pproto_msg_type pproto_server_read_msg_type()
     {
         case PPROTO_SQL_REQUEST_MESSAGE_MAGIC:
             return PPROTO_SQL_REQUEST_MSG;
+        case PPROTO_SQL_SCRIPT_MESSAGE_MAGIC:
+            return PPROTO_SQL_SCRIPT_MSG;
         case PPROTO_CANCEL_MESSAGE_MAGIC:
             return PPROTO_CANCEL_MSG;
         case PPROTO_GOODBYE_MESSAGE:
@@ -742,6 +803,22 @@ pproto_msg_type pproto_server_read_msg_type()
 }
 
 
+sint8 pproto_server_read_script_on_error(uint8 *on_error)
+{
+    if(pproto_server_get_uint8(on_error) != 0) return 1;
+
+    if(*on_error != PPROTO_SCRIPT_ON_ERROR_DEFAULT
+            && *on_error != PPROTO_SCRIPT_ON_ERROR_STOP
+            && *on_error != PPROTO_SCRIPT_ON_ERROR_CONTINUE)
+    {
+        logger_error(_ach("pproto_server, unknown script stop-on-error policy received from client: %d"), (int)*on_error);
+        return 1;
+    }
+
+    return 0;
+}
+
+
 sint8 pproto_server_send_server_hello()
 {
     if(pproto_server_send_uint16(PPROTO_SERVER_HELLO_MAGIC) != 0
@@ -6,6 +6,8 @@
 #include "execution/execution.h"
 #include "parser/lexer.h"
 #include "common/string_literal.h"
+#include "common/collation.h"
+#include "config/config.h"
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
@@ -35,7 +37,7 @@
 //  a - hello_message from client
 //  b - auth_message from client, wrong credentials
 //  c - auth_message from client, correct credentials
-//  d - sql_request_message from client
+//  d - sql_request_message or sql_script_message from client
 //  e - cancel_message
 //  f - goodbye_message
 //  g - incorrect message
@@ -46,7 +48,8 @@ struct {
     encoding    server_encoding;
     uint32      user_id;
     handle      lexer;
-} g_session_state = {-1, ENCODING_UNKNOWN, ENCODING_UNKNOWN, 0, NULL};
+    uint8       eos_pending;        // last char of sql text is passed to lexer, end of string is next
+} g_session_state = {-1, ENCODING_UNKNOWN, ENCODING_UNKNOWN, 0, NULL, 0};
 
 encoding session_encoding()
 {
@@ -155,11 +158,19 @@ sint8 session_enter_repl()
         switch(msg_type)
         {
             case PPROTO_SQL_REQUEST_MSG:
+                g_session_state.eos_pending = 0;
                 if(execution_exec_statement(g_session_state.lexer))
                 {
                     return 1;
                 }
                 break;
+            case PPROTO_SQL_SCRIPT_MSG:
+                g_session_state.eos_pending = 0;
+                if(execution_exec_script(g_session_state.lexer))
+                {
+                    return 1;
+                }
+                break;
             case PPROTO_GOODBYE_MSG:
                 pproto_server_send_goodbye();
                 return 0;
@@ -173,6 +184,29 @@ sint8 session_enter_repl()
     return 0;
 }
 
+// read next char of sql text for lexer
+// pproto_server reports end of string together with the last char, lexer expects it after the last char
+sint8 session_read_char(char_info *ch, sint8 *eos)
+{
+    if(g_session_state.eos_pending)
+    {
+        g_session_state.eos_pending = 0;
+        *eos = 1;
+        return 0;
+    }
+
+    ch->state = CHAR_STATE_INCOMPLETE;
+    if(pproto_server_read_char(ch, eos) != 0) return 1;
+
+    if(*eos && ch->state != CHAR_STATE_INCOMPLETE)
+    {
+        g_session_state.eos_pending = 1;
+        *eos = 0;
+    }
+
+    return 0;
+}
+
 sint8 session_create_lexer()
 {
     handle str_literal = string_literal_create(malloc(string_literal_alloc_sz()));
@@ -183,7 +217,7 @@ sint8 session_create_lexer()
     }
 
     lexer_interface li;
-    li.next_char = pproto_server_read_char;
+    li.next_char = session_read_char;
     li.report_error = pproto_server_send_error;
 
     g_session_state.lexer = lexer_create(malloc(lexer_get_allocation_size()), g_session_state.server_encoding, str_literal, li);
@@ -205,9 +239,18 @@ sint8 session_create(int client_sock)
 
     // TODO: connect to tipi and determine server encoding
     pproto_server_set_encoding(g_session_state.server_encoding);
+    collation_set_encoding(g_session_state.server_encoding);
 
     if(session_create_lexer() != 0) return 1;
 
+    sint64 mem_budget;
+    if(config_get_int(CONFIG_PARSER_MEMORY_BUDGET, &mem_budget) != 0) return 1;
+    parser_set_memory_budget((uint64)mem_budget, config_get_str(CONFIG_TEMP_DIR));
+    string_literal_set_spill(STRING_LITERAL_DEFAULT_MEM_SZ, config_get_str(CONFIG_TEMP_DIR));
+
+    const achar *on_error = config_get_str(CONFIG_SCRIPT_ON_ERROR);
+    execution_set_script_on_error(0 == strcmp(on_error, _ach("continue")) ? PPROTO_SCRIPT_ON_ERROR_CONTINUE : PPROTO_SCRIPT_ON_ERROR_STOP);
+
     switch(session_auth_client())
     {
         case 1:     // error
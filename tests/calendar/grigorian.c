@@ -1,11 +1,15 @@
 #include "tests.h"
 #include "calendar/grigorian.h"
 #include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
 
 #define SECONDS_IN_DAY (86400)
 #define DAYS_IN_4_PERIOD    (1461UL)     // 4*365 + 1
 #define DAYS_IN_100_PERIOD  (36524UL)    // 25 * DAYS_IN_4_PERIOD - 1
 #define DAYS_IN_400_PERIOD  (146097UL)   // 4 * DAYS_IN_100_PERIOD + 1
+#define TEST_GRIGORIAN_BATCH    (1000)
+#define BENCH_GRIGORIAN_DATES   (10000000)
 
 int test_grigorian_calendar()
 {
@@ -131,6 +135,129 @@ int test_grigorian_calendar()
     res = grigorian_make_date_with_time(&date, 1, 1, 1, 23, 59, 59);
     if(0 != res || date != SECONDS_IN_DAY-1) return __LINE__;
 
+
+    puts("Testing batch extraction");
+    uint64 dates[TEST_GRIGORIAN_BATCH], years[TEST_GRIGORIAN_BATCH], y;
+    uint8 months[TEST_GRIGORIAN_BATCH], days[TEST_GRIGORIAN_BATCH], m[TEST_GRIGORIAN_BATCH], d[TEST_GRIGORIAN_BATCH];
+    uint32 i;
+
+    // every day of several 400-year periods, around leap days and period ends
+    for(y = 1; y < 2500; y += TEST_GRIGORIAN_BATCH / 366)
+    {
+        for(i = 0; i < TEST_GRIGORIAN_BATCH; i++)
+        {
+            dates[i] = grigorian_trunc_to_year((y - 1) * 365 * SECONDS_IN_DAY + (y - 1) / 4 * SECONDS_IN_DAY) + (uint64)i * SECONDS_IN_DAY + i % SECONDS_IN_DAY;
+        }
+
+        grigorian_extract_date_batch(dates, TEST_GRIGORIAN_BATCH, years, months, days);
+        for(i = 0; i < TEST_GRIGORIAN_BATCH; i++)
+        {
+            if(0 != grigorian_make_date(&date, years[i], months[i], days[i])) return __LINE__;
+            if(date != dates[i] - dates[i] % SECONDS_IN_DAY) return __LINE__;
+            if(years[i] != grigorian_extract_year(dates[i])) return __LINE__;
+        }
+
+        grigorian_extract_month_of_year_batch(dates, TEST_GRIGORIAN_BATCH, m);
+        grigorian_extract_day_of_month_batch(dates, TEST_GRIGORIAN_BATCH, d);
+        if(memcmp(m, months, TEST_GRIGORIAN_BATCH) != 0) return __LINE__;
+        if(memcmp(d, days, TEST_GRIGORIAN_BATCH) != 0) return __LINE__;
+        grigorian_extract_year_batch(dates, TEST_GRIGORIAN_BATCH, years + 1);
+        if(years[1] != years[0]) return __LINE__;
+    }
+
+    dates[0] = (uint64)(DAYS_IN_400_PERIOD * 5 - 1) * SECONDS_IN_DAY;
+    grigorian_extract_date_batch(dates, 1, years, months, days);
+    if(years[0] != 2000 || months[0] != 12 || days[0] != 31) return __LINE__;
+    grigorian_extract_date_batch(dates, 0, years, months, days);
+
     return 0;
 }
 
+
+// year, month and day of date by 400, 100 and 4-year periods and walk over month lengths, as done before batch functions
+void bench_grigorian_reference(uint64 date, uint64 *year, uint8 *month, uint8 *day)
+{
+    static const uint8 month_days[2][12] = {{31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31}, {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31}};
+    uint64 days = date / SECONDS_IN_DAY;
+    uint64 r400 = days % DAYS_IN_400_PERIOD;
+    uint64 c100 = r400 == DAYS_IN_400_PERIOD - 1 ? 3 : r400 / DAYS_IN_100_PERIOD;
+    uint64 r100 = r400 - c100 * DAYS_IN_100_PERIOD;
+    uint64 r4 = r100 % DAYS_IN_4_PERIOD;
+    uint64 c1 = r4 == DAYS_IN_4_PERIOD - 1 ? 3 : r4 / 365;
+    sint32 year_day = (sint32)(r4 - c1 * 365), m = 0;
+    uint8 leap = c1 == 3 && (r100 / DAYS_IN_4_PERIOD != 24 || c100 == 3);
+
+    while(year_day >= month_days[leap][m]) year_day -= month_days[leap][m++];
+
+    *year = days / DAYS_IN_400_PERIOD * 400 + c100 * 100 + r100 / DAYS_IN_4_PERIOD * 4 + c1 + 1;
+    *month = (uint8)(m + 1);
+    *day = (uint8)(year_day + 1);
+}
+
+
+int bench_grigorian_functions()
+{
+    puts("Starting benchmark bench_grigorian_functions");
+
+    uint64 *dates = (uint64 *)malloc(BENCH_GRIGORIAN_DATES * sizeof(uint64));
+    uint64 *years = (uint64 *)malloc(BENCH_GRIGORIAN_DATES * sizeof(uint64));
+    uint8 *months = (uint8 *)malloc(BENCH_GRIGORIAN_DATES);
+    uint8 *days = (uint8 *)malloc(BENCH_GRIGORIAN_DATES);
+    uint64 y, sum = 0;
+    uint8 m, d;
+    struct timeval t1;
+    uint32 i;
+    long ms;
+
+    if(NULL == dates || NULL == years || NULL == months || NULL == days) return __LINE__;
+
+    // timestamps of 1900-2100
+    srand(1);
+    for(i = 0; i < BENCH_GRIGORIAN_DATES; i++)
+    {
+        dates[i] = (uint64)DAYS_IN_400_PERIOD * 4 * SECONDS_IN_DAY + ((uint64)rand() << 31 | (uint64)rand()) % ((uint64)DAYS_IN_100_PERIOD * 2 * SECONDS_IN_DAY);
+    }
+
+    // output pages are touched before timing
+    memset(years, 0, BENCH_GRIGORIAN_DATES * sizeof(uint64));
+    memset(months, 0, BENCH_GRIGORIAN_DATES);
+    memset(days, 0, BENCH_GRIGORIAN_DATES);
+
+    gettimeofday(&t1, NULL);
+    for(i = 0; i < BENCH_GRIGORIAN_DATES; i++)
+    {
+        bench_grigorian_reference(dates[i], &y, &m, &d);
+        sum += y + m + d;
+    }
+    ms = bench_elapsed_ms(&t1);
+    printf("Benchmarking year, month and day of 10M dates: division chain %ld ms", ms);
+
+    gettimeofday(&t1, NULL);
+    for(i = 0; i < BENCH_GRIGORIAN_DATES; i++)
+    {
+        sum -= grigorian_extract_year(dates[i]) + grigorian_extract_month_of_year(dates[i]) + grigorian_extract_day_of_month(dates[i]);
+    }
+    printf(", row at a time %ld ms", bench_elapsed_ms(&t1));
+
+    gettimeofday(&t1, NULL);
+    grigorian_extract_date_batch(dates, BENCH_GRIGORIAN_DATES, years, months, days);
+    printf(", batch %ld ms.\n", bench_elapsed_ms(&t1));
+
+    gettimeofday(&t1, NULL);
+    grigorian_extract_month_of_year_batch(dates, BENCH_GRIGORIAN_DATES, months);
+    printf("Benchmarking month of 10M dates: batch %ld ms.\n", bench_elapsed_ms(&t1));
+
+    if(sum != 0) return __LINE__;
+    for(i = 0; i < BENCH_GRIGORIAN_DATES; i++)
+    {
+        bench_grigorian_reference(dates[i], &y, &m, &d);
+        if(y != years[i] || m != months[i] || d != days[i]) return __LINE__;
+    }
+
+    free(dates);
+    free(years);
+    free(months);
+    free(days);
+
+    return 0;
+}
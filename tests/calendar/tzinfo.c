@@ -0,0 +1,298 @@
+#include "tests.h"
+#include "calendar/tzinfo.h"
+#include "common/error.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define USEC_IN_SEC             (1000000UL)
+#define UNIX_EPOCH              (62135596800UL)     // 1970-01-01 in seconds since 0001-01-01
+#define TEST_TZINFO_VALUES      (1000)
+#define BENCH_TZINFO_VALUES     (10000000)
+
+// Europe/Berlin transitions of 2024 and 2100 in seconds since 0001-01-01
+#define CEST_2024   (63847443600UL)
+#define CET_2024    (63865587600UL)
+#define CEST_2100   (66245475600UL)
+#define CET_2100    (66264224400UL)
+#define CEST_9999   (315513795600UL)
+#define CET_9999    (315532544400UL)
+
+// put v to buf in big-endian order
+static uint32 tzif_put(uint8 *buf, uint64 v, uint32 sz)
+{
+    for(uint32 i = sz; i > 0; i--, v >>= 8) buf[i - 1] = (uint8)v;
+    return sz;
+}
+
+// put TZif header and data of CET and CEST transitions of 2024 with times of tsz bytes
+static uint32 tzif_put_block(uint8 *buf, uint8 version, uint32 tsz)
+{
+    uint32 p = 0;
+    uint64 times[3] = {(uint64)-576460752303423488L, CEST_2024 - UNIX_EPOCH, CET_2024 - UNIX_EPOCH};
+    uint32 timecnt = tsz == 8 ? 3 : 2;
+
+    memcpy(buf, "TZif", 4);
+    buf[4] = version;
+    memset(buf + 5, 0, 15);
+    p = 20;
+    p += tzif_put(buf + p, 0, 4);           // isutcnt
+    p += tzif_put(buf + p, 0, 4);           // isstdcnt
+    p += tzif_put(buf + p, 0, 4);           // leapcnt
+    p += tzif_put(buf + p, timecnt, 4);
+    p += tzif_put(buf + p, 3, 4);           // typecnt
+    p += tzif_put(buf + p, 9, 4);           // charcnt
+
+    for(uint32 i = 3 - timecnt; i < 3; i++) p += tzif_put(buf + p, times[i], tsz);
+    if(tsz == 8) buf[p++] = 1;
+    buf[p++] = 2;
+    buf[p++] = 1;
+
+    // LMT +00:53:28, CET, CEST
+    p += tzif_put(buf + p, 3208, 4); buf[p++] = 0; buf[p++] = 0;
+    p += tzif_put(buf + p, 3600, 4); buf[p++] = 0; buf[p++] = 4;
+    p += tzif_put(buf + p, 7200, 4); buf[p++] = 1; buf[p++] = 4;
+    memcpy(buf + p, "LMT\0CET\0\0", 9);
+    p += 9;
+
+    return p;
+}
+
+int test_tzinfo_functions()
+{
+    tzinfo_zone *zone, *zone2;
+    uint8 tzif[512];
+    uint64 ts[TEST_TZINFO_VALUES], local[TEST_TZINFO_VALUES], utc[TEST_TZINFO_VALUES];
+    sint16 tz[TEST_TZINFO_VALUES], tz2;
+    uint32 sz, i;
+
+    puts("Starting test test_tzinfo_functions");
+
+    puts("Testing tzinfo_create_posix");
+
+    zone = tzinfo_create_posix(_ach("CET-1CEST,M3.5.0,M10.5.0/3"));
+    if(zone == NULL) return __LINE__;
+    if(tzinfo_offset(zone, 0) != 60) return __LINE__;
+    if(tzinfo_offset(zone, CEST_2024 * USEC_IN_SEC - 1) != 60) return __LINE__;
+    if(tzinfo_offset(zone, CEST_2024 * USEC_IN_SEC) != 120) return __LINE__;
+    if(tzinfo_offset(zone, CET_2024 * USEC_IN_SEC - 1) != 120) return __LINE__;
+    if(tzinfo_offset(zone, CET_2024 * USEC_IN_SEC) != 60) return __LINE__;
+    if(tzinfo_offset(zone, CEST_2100 * USEC_IN_SEC - 1) != 60) return __LINE__;
+    if(tzinfo_offset(zone, CEST_2100 * USEC_IN_SEC) != 120) return __LINE__;
+    if(tzinfo_offset(zone, CET_2100 * USEC_IN_SEC) != 60) return __LINE__;
+    if(tzinfo_offset(zone, CEST_9999 * USEC_IN_SEC - 1) != 60) return __LINE__;
+    if(tzinfo_offset(zone, CEST_9999 * USEC_IN_SEC) != 120) return __LINE__;
+    if(tzinfo_offset(zone, CET_9999 * USEC_IN_SEC - 1) != 120) return __LINE__;
+    if(tzinfo_offset(zone, CET_9999 * USEC_IN_SEC) != 60) return __LINE__;
+
+    // UTC to local time
+    if(tzinfo_to_local(zone, CEST_2024 * USEC_IN_SEC + 5, &tz2) != (CEST_2024 + 7200) * USEC_IN_SEC + 5 || tz2 != 120) return __LINE__;
+    if(tzinfo_to_local(zone, CET_2024 * USEC_IN_SEC, &tz2) != (CET_2024 + 3600) * USEC_IN_SEC || tz2 != 60) return __LINE__;
+
+    // local time to UTC: 02:30 of spring is skipped and means 03:30, 02:30 of autumn is taken in summer time
+    if(tzinfo_to_utc(zone, (CEST_2024 + 3600 + 1800) * USEC_IN_SEC, &tz2) != (CEST_2024 + 1800) * USEC_IN_SEC || tz2 != 60) return __LINE__;
+    if(tzinfo_to_utc(zone, (CEST_2024 + 7200 + 1800) * USEC_IN_SEC, &tz2) != (CEST_2024 + 1800) * USEC_IN_SEC || tz2 != 120) return __LINE__;
+    if(tzinfo_to_utc(zone, (CET_2024 + 1800) * USEC_IN_SEC, &tz2) != (CET_2024 - 5400) * USEC_IN_SEC || tz2 != 120) return __LINE__;
+    if(tzinfo_to_utc(zone, (CET_2024 + 7200) * USEC_IN_SEC, &tz2) != (CET_2024 + 3600) * USEC_IN_SEC || tz2 != 60) return __LINE__;
+    if(tzinfo_to_utc(zone, (CET_9999 + 7200) * USEC_IN_SEC, &tz2) != (CET_9999 + 3600) * USEC_IN_SEC || tz2 != 60) return __LINE__;
+    if(tzinfo_to_utc(zone, (CET_9999 + 3600) * USEC_IN_SEC, &tz2) != (CET_9999 - 3600) * USEC_IN_SEC || tz2 != 120) return __LINE__;
+    if(tzinfo_to_utc(zone, 0, &tz2) != 0 || tz2 != 60) return __LINE__;
+
+    // batch is the same as conversion of single values, local time converts back to the same UTC
+    srand(1);
+    for(i = 0; i < TEST_TZINFO_VALUES; i++)
+    {
+        ts[i] = ((uint64)rand() << 31 | (uint64)rand()) % (CET_9999 * USEC_IN_SEC);
+        if(i > TEST_TZINFO_VALUES / 2) ts[i] = ts[i - 1] + (uint64)rand() % 4000 * USEC_IN_SEC;
+    }
+    tzinfo_to_local_batch(zone, ts, TEST_TZINFO_VALUES, local, tz);
+    tzinfo_to_utc_batch(zone, local, TEST_TZINFO_VALUES, utc, tz);
+    for(i = 0; i < TEST_TZINFO_VALUES; i++)
+    {
+        if(local[i] != tzinfo_to_local(zone, ts[i], &tz2) || tz[i] != tz2) return __LINE__;
+        // the hour repeated in autumn converts to summer time
+        if(utc[i] != ts[i] && (tz[i] != 120 || utc[i] + 3600 * USEC_IN_SEC != ts[i])) return __LINE__;
+        if(utc[i] != tzinfo_to_utc(zone, local[i], &tz2) || tz[i] != tz2) return __LINE__;
+    }
+    tzinfo_destroy(zone);
+
+    // southern hemisphere: summer time from the first Sunday of October to the first Sunday of April
+    zone = tzinfo_create_posix(_ach("AEST-10AEDT,M10.1.0,M4.1.0/3"));
+    if(zone == NULL) return __LINE__;
+    if(tzinfo_offset(zone, 63848016000UL * USEC_IN_SEC - 1) != 660) return __LINE__;
+    if(tzinfo_offset(zone, 63848016000UL * USEC_IN_SEC) != 600) return __LINE__;
+    if(tzinfo_offset(zone, 63863740800UL * USEC_IN_SEC - 1) != 600) return __LINE__;
+    if(tzinfo_offset(zone, 63863740800UL * USEC_IN_SEC) != 660) return __LINE__;
+    tzinfo_destroy(zone);
+
+    // fixed offsets, names in angle brackets, minutes
+    zone = tzinfo_create_posix(_ach("<+0530>-5:30"));
+    if(zone == NULL) return __LINE__;
+    if(tzinfo_offset(zone, CEST_2024 * USEC_IN_SEC) != 330 || tzinfo_offset(zone, 0) != 330) return __LINE__;
+    if(tzinfo_to_utc(zone, 0, &tz2) != 0) return __LINE__;
+    tzinfo_destroy(zone);
+    zone = tzinfo_create_posix(_ach("EST5EDT"));
+    if(zone == NULL) return __LINE__;
+    if(tzinfo_offset(zone, CEST_2024 * USEC_IN_SEC) != -240) return __LINE__;
+    tzinfo_destroy(zone);
+
+    const achar *bad_tz[] = {_ach(""), _ach("CET"), _ach("-1"), _ach("CET-1CEST,M3.5.0"), _ach("CET-1CEST,M13.5.0,M10.5.0"),
+                             _ach("CET-1CEST,M3.5.0,M10.5.0/"), _ach("CET-1CEST,M3.5.0,M10.5.0x"), _ach("<CET-1")};
+    for(i = 0; i < sizeof(bad_tz) / sizeof(bad_tz[0]); i++)
+    {
+        error_set(ERROR_NO_ERROR);
+        if(tzinfo_create_posix(bad_tz[i]) != NULL) return __LINE__;
+        if(error_get() != ERROR_INVALID_TIME_ZONE) return __LINE__;
+    }
+
+
+    puts("Testing tzinfo_create");
+
+    // version 1: transitions of 2024 only
+    sz = tzif_put_block(tzif, 0, 4);
+    zone = tzinfo_create(tzif, sz);
+    if(zone == NULL) return __LINE__;
+    if(tzinfo_offset(zone, 0) != 53) return __LINE__;
+    if(tzinfo_offset(zone, CEST_2024 * USEC_IN_SEC - 1) != 53) return __LINE__;
+    if(tzinfo_offset(zone, CEST_2024 * USEC_IN_SEC) != 120) return __LINE__;
+    if(tzinfo_offset(zone, CET_2024 * USEC_IN_SEC) != 60) return __LINE__;
+    if(tzinfo_offset(zone, CEST_2100 * USEC_IN_SEC) != 60) return __LINE__;
+    tzinfo_destroy(zone);
+
+    // version 2: footer gives rules after the last transition, transition before year 1 sets the first period
+    sz = tzif_put_block(tzif, '2', 4);
+    sz += tzif_put_block(tzif + sz, '2', 8);
+    memcpy(tzif + sz, "\nCET-1CEST,M3.5.0,M10.5.0/3\n", 28);
+    sz += 28;
+    zone = tzinfo_create(tzif, sz);
+    if(zone == NULL) return __LINE__;
+    if(tzinfo_offset(zone, 0) != 60) return __LINE__;
+    if(tzinfo_offset(zone, CEST_2024 * USEC_IN_SEC) != 120) return __LINE__;
+    if(tzinfo_offset(zone, CET_2024 * USEC_IN_SEC) != 60) return __LINE__;
+    if(tzinfo_offset(zone, CEST_2100 * USEC_IN_SEC - 1) != 60) return __LINE__;
+    if(tzinfo_offset(zone, CEST_2100 * USEC_IN_SEC) != 120) return __LINE__;
+    if(tzinfo_offset(zone, CET_9999 * USEC_IN_SEC) != 60) return __LINE__;
+
+    // the same as the rule alone
+    zone2 = tzinfo_create_posix(_ach("CET-1CEST,M3.5.0,M10.5.0/3"));
+    if(zone2 == NULL) return __LINE__;
+    tzinfo_to_local_batch(zone, ts, TEST_TZINFO_VALUES, local, tz);
+    for(i = 0; i < TEST_TZINFO_VALUES; i++)
+    {
+        if(ts[i] >= CEST_2024 * USEC_IN_SEC && (local[i] != tzinfo_to_local(zone2, ts[i], &tz2) || tz[i] != tz2)) return __LINE__;
+    }
+    tzinfo_destroy(zone2);
+    tzinfo_destroy(zone);
+
+    // truncated data, bad magic, type out of range
+    error_set(ERROR_NO_ERROR);
+    if(tzinfo_create(tzif, sz - 40) != NULL) return __LINE__;
+    if(error_get() != ERROR_INVALID_TIME_ZONE) return __LINE__;
+    if(tzinfo_create(tzif, 43) != NULL) return __LINE__;
+    tzif[0] = 'X';
+    if(tzinfo_create(tzif, sz) != NULL) return __LINE__;
+    sz = tzif_put_block(tzif, 0, 4);
+    tzif[44 + 2 * 4] = 3;
+    if(tzinfo_create(tzif, sz) != NULL) return __LINE__;
+
+
+    puts("Testing tzinfo_load");
+
+    error_set(ERROR_NO_ERROR);
+    if(tzinfo_load(_ach("../../etc/passwd")) != NULL) return __LINE__;
+    if(error_get() != ERROR_INVALID_TIME_ZONE) return __LINE__;
+    if(tzinfo_load(_ach("/etc/passwd")) != NULL) return __LINE__;
+    if(tzinfo_load(_ach("No/Such_Zone")) != NULL) return __LINE__;
+
+    // zone of the system database, if present, is the same as the rule
+    zone = tzinfo_load(_ach("Europe/Berlin"));
+    if(zone != NULL)
+    {
+        if(tzinfo_offset(zone, CEST_2100 * USEC_IN_SEC) != 120 || tzinfo_offset(zone, CET_9999 * USEC_IN_SEC) != 60) return __LINE__;
+        tzinfo_destroy(zone);
+    }
+
+    return 0;
+}
+
+
+// return local timestamp of UTC timestamp ts in zone of TZ environment variable by localtime_r
+static uint64 bench_tzinfo_localtime(uint64 ts)
+{
+    time_t t = (time_t)(ts / USEC_IN_SEC - UNIX_EPOCH);
+    struct tm tm;
+
+    localtime_r(&t, &tm);
+    return ts + (sint64)tm.tm_gmtoff * USEC_IN_SEC;
+}
+
+int bench_tzinfo_functions()
+{
+    puts("Starting benchmark bench_tzinfo_functions");
+
+    tzinfo_zone *zone = tzinfo_load(_ach("America/New_York"));
+    uint64 *ts, *local, *local2;
+    sint16 *tz;
+    struct timeval t1;
+    uint32 i;
+
+    if(zone == NULL)
+    {
+        puts("Time zone database is not found, benchmark is skipped");
+        return 0;
+    }
+
+    ts = (uint64 *)malloc(BENCH_TZINFO_VALUES * sizeof(uint64));
+    local = (uint64 *)malloc(BENCH_TZINFO_VALUES * sizeof(uint64));
+    local2 = (uint64 *)malloc(BENCH_TZINFO_VALUES * sizeof(uint64));
+    tz = (sint16 *)malloc(BENCH_TZINFO_VALUES * sizeof(sint16));
+    if(NULL == ts || NULL == local || NULL == local2 || NULL == tz) return __LINE__;
+
+    setenv("TZ", "America/New_York", 1);
+    tzset();
+
+    // sorted event timestamps of about a year from 2024
+    for(i = 0; i < BENCH_TZINFO_VALUES; i++)
+    {
+        ts[i] = (63842371200UL + i * 3) * USEC_IN_SEC + (uint64)rand() % USEC_IN_SEC;
+    }
+    memset(local, 0, BENCH_TZINFO_VALUES * sizeof(uint64));
+    memset(local2, 0, BENCH_TZINFO_VALUES * sizeof(uint64));
+    memset(tz, 0, BENCH_TZINFO_VALUES * sizeof(sint16));
+
+    gettimeofday(&t1, NULL);
+    for(i = 0; i < BENCH_TZINFO_VALUES; i++)
+    {
+        local2[i] = bench_tzinfo_localtime(ts[i]);
+    }
+    printf("Benchmarking UTC to local time: localtime_r %ld ms", bench_elapsed_ms(&t1));
+
+    gettimeofday(&t1, NULL);
+    for(i = 0; i < BENCH_TZINFO_VALUES; i++)
+    {
+        local[i] = tzinfo_to_local(zone, ts[i], tz + i);
+    }
+    printf(", tzinfo_to_local %ld ms", bench_elapsed_ms(&t1));
+    if(memcmp(local, local2, BENCH_TZINFO_VALUES * sizeof(uint64))) return __LINE__;
+
+    gettimeofday(&t1, NULL);
+    tzinfo_to_local_batch(zone, ts, BENCH_TZINFO_VALUES, local, tz);
+    printf(", tzinfo_to_local_batch %ld ms.\n", bench_elapsed_ms(&t1));
+    if(memcmp(local, local2, BENCH_TZINFO_VALUES * sizeof(uint64))) return __LINE__;
+
+    // every second of 1900 - 2100
+    for(i = 0; i < BENCH_TZINFO_VALUES; i++)
+    {
+        ts[i] = (59926608000UL + ((uint64)rand() << 31 | (uint64)rand()) % (200UL * 365 * 86400)) * USEC_IN_SEC;
+        if(tzinfo_to_local(zone, ts[i], tz) != bench_tzinfo_localtime(ts[i])) return __LINE__;
+    }
+
+    tzinfo_destroy(zone);
+    free(ts);
+    free(local);
+    free(local2);
+    free(tz);
+
+    return 0;
+}
@@ -7,6 +7,7 @@
 #include <string.h>
 #include <assert.h>
 #include <stdlib.h>
+#include <sys/wait.h>
 
 
 int prepare_col_desc(uint8 *buf, uint8 dt_magic, uint64 len, uint8 p, uint8 s, const char *alias, uint8 nullable)
@@ -71,6 +72,68 @@ int check_col_desc(pproto_col_desc *cd, uint8 dt, uint64 len, uint8 p, uint8 s,
     return 0;
 }
 
+#define TEST_PPROTO_CLIENT_SCRIPT_RESULTS (1024u*1024u)
+#define TEST_PPROTO_CLIENT_SCRIPT_LEN (1024u*1024u)
+
+
+// read exactly sz bytes from socket
+// return 0 on success, non 0 otherwise
+int test_pproto_client_recv_fully(int sock, uint8 *buf, uint32 sz)
+{
+    ssize_t readsz;
+
+    while(sz > 0)
+    {
+        readsz = recv(sock, buf, sz, 0);
+        if(readsz <= 0) return 1;
+        buf += readsz;
+        sz -= (uint32)readsz;
+    }
+
+    return 0;
+}
+
+
+// server side of script test: sends all results first, then reads the script, like server streaming results
+// of statements which are executed before the rest of the script is received
+// return 0 on success, line number otherwise
+int test_pproto_client_script_server(int sock)
+{
+    uint8 buf[256];
+    uint32 i, total = 0;
+    ssize_t written;
+
+    memset(buf, PPROTO_SUCCESS_MESSAGE_WITHOUT_TEXT_MAGIC, sizeof(buf));
+    for(i = 0; i < TEST_PPROTO_CLIENT_SCRIPT_RESULTS; i += written)
+    {
+        written = send(sock, buf, sizeof(buf), 0);
+        if(written != sizeof(buf)) return __LINE__;
+    }
+
+    if(0 != test_pproto_client_recv_fully(sock, buf, 3)) return __LINE__;
+    if(buf[0] != PPROTO_SQL_SCRIPT_MESSAGE_MAGIC ||
+       buf[1] != PPROTO_SCRIPT_ON_ERROR_CONTINUE ||
+       buf[2] != PPROTO_UTEXT_STRING_MAGIC) return __LINE__;
+
+    // chunks of statement text until zero length terminator
+    while(1)
+    {
+        if(0 != test_pproto_client_recv_fully(sock, buf, 1)) return __LINE__;
+        if(buf[0] == 0) break;
+        i = buf[0];
+        total += i;
+        if(0 != test_pproto_client_recv_fully(sock, buf, i)) return __LINE__;
+        while(i > 0) if(buf[--i] != 's') return __LINE__;
+    }
+    if(total != TEST_PPROTO_CLIENT_SCRIPT_LEN) return __LINE__;
+
+    buf[0] = PPROTO_SCRIPT_END_MESSAGE_MAGIC;
+    if(1 != send(sock, buf, 1, 0)) return __LINE__;
+
+    return 0;
+}
+
+
 int test_pproto_client_functions()
 {
     uint8 buf[1024], auth_status;
@@ -464,6 +527,50 @@ int test_pproto_client_functions()
     if(-1 != pproto_client_recordset_start_row(ss, nulls, 2)) return __LINE__;
 
 
+    puts("Tesing client protocol sending script while server sends results");
+
+
+    int sp[2];
+    if(0 != socketpair(AF_UNIX, SOCK_STREAM, 0, sp)) return __LINE__;
+    if(0 != setsockopt(sp[1], SOL_SOCKET, SO_RCVTIMEO, (const char*)&tv, sizeof(tv))) return __LINE__;
+    if(0 != setsockopt(sp[1], SOL_SOCKET, SO_SNDTIMEO, (const char*)&tv, sizeof(tv))) return __LINE__;
+
+    pid_t pid = fork();
+    if(pid < 0) return __LINE__;
+    if(pid == 0)
+    {
+        close(sp[0]);
+        _exit(test_pproto_client_script_server(sp[1]) == 0 ? 0 : 1);
+    }
+    if(0 != close(sp[1])) return __LINE__;
+
+    void *sss_buf = malloc(ss_buf_sz);
+    if(NULL == sss_buf) return __LINE__;
+    handle sss = pproto_client_create(sss_buf, sp[0]);
+    if(NULL == sss) return __LINE__;
+
+    // results are sent before the script is read, so client must drain them while sending
+    uint8 *script = (uint8 *)malloc(TEST_PPROTO_CLIENT_SCRIPT_LEN);
+    if(NULL == script) return __LINE__;
+    memset(script, 's', TEST_PPROTO_CLIENT_SCRIPT_LEN);
+    if(0 != pproto_client_sql_script_begin(sss, PPROTO_SCRIPT_ON_ERROR_CONTINUE)) return __LINE__;
+    if(0 != pproto_client_send_sql_stmt(sss, script, TEST_PPROTO_CLIENT_SCRIPT_LEN)) return __LINE__;
+    if(0 != pproto_client_sql_stmt_finish(sss)) return __LINE__;
+    free(script);
+
+    if(1 != pproto_client_poll(sss)) return __LINE__;
+    for(i = 0; i < (int)TEST_PPROTO_CLIENT_SCRIPT_RESULTS; i++)
+    {
+        if(PPROTO_SUCCESS_WITHOUT_TEXT_MSG != pproto_client_read_msg_type(sss)) return __LINE__;
+    }
+    if(PPROTO_SCRIPT_END_MSG != pproto_client_read_msg_type(sss)) return __LINE__;
+
+    if(pid != waitpid(pid, &ret, 0)) return __LINE__;
+    if(!WIFEXITED(ret) || WEXITSTATUS(ret) != 0) return __LINE__;
+    if(0 != close(sp[0])) return __LINE__;
+    free(sss_buf);
+
+
     puts("Tesing client protocol other functions");
 
 
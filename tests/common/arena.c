@@ -0,0 +1,94 @@
+#include "tests.h"
+#include "common/arena.h"
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+int test_arena_functions()
+{
+    puts("Starting test test_arena_functions");
+
+    uint64 *ptrs[100];
+    uint8 *ptr;
+    sint32 i;
+
+
+    puts("Testing in-memory allocation");
+
+    handle ah = arena_create(malloc(arena_get_alloc_sz()), 1024 * 1024, NULL);
+    if(NULL == ah) return __LINE__;
+
+    for(i = 0; i < 100; i++)
+    {
+        if((ptrs[i] = (uint64 *)arena_alloc(ah, sizeof(uint64) * 100)) == NULL) return __LINE__;
+        if(ptrs[i][0] != 0 || ptrs[i][99] != 0) return __LINE__;
+        if(((uint64)ptrs[i] & 15) != 0) return __LINE__;
+        ptrs[i][0] = i;
+        ptrs[i][99] = i;
+    }
+    if(arena_mem_sz(ah) == 0) return __LINE__;
+    if(arena_spilled_sz(ah) != 0) return __LINE__;
+
+    // elements don't move
+    for(i = 0; i < 100; i++)
+    {
+        if(ptrs[i][0] != (uint64)i || ptrs[i][99] != (uint64)i) return __LINE__;
+    }
+
+    // reuse after reset
+    arena_reset(ah);
+    if((ptr = (uint8 *)arena_alloc(ah, 10)) == NULL) return __LINE__;
+    if(ptr[0] != 0 || ptr[9] != 0) return __LINE__;
+
+
+    puts("Testing spilling to disk");
+
+    arena_set_budget(ah, ARENA_MEM_CHUNK_SZ, ARENA_DEFAULT_SPILL_DIR);
+    arena_reset(ah);
+
+    for(i = 0; i < 100; i++)
+    {
+        if((ptrs[i] = (uint64 *)arena_alloc(ah, 50000)) == NULL) return __LINE__;
+        if(ptrs[i][0] != 0) return __LINE__;
+        ptrs[i][0] = i;
+        ptrs[i][50000 / sizeof(uint64) - 1] = i;
+    }
+    if(arena_mem_sz(ah) > ARENA_MEM_CHUNK_SZ) return __LINE__;
+    if(arena_spilled_sz(ah) < 99 * 50000) return __LINE__;
+
+    // element larger than a spill chunk
+    if((ptr = (uint8 *)arena_alloc(ah, ARENA_SPILL_CHUNK_SZ * 2)) == NULL) return __LINE__;
+    memset(ptr, 0xff, ARENA_SPILL_CHUNK_SZ * 2);
+
+    for(i = 0; i < 100; i++)
+    {
+        if(ptrs[i][0] != (uint64)i || ptrs[i][50000 / sizeof(uint64) - 1] != (uint64)i) return __LINE__;
+    }
+
+    // spill file is reused after reset and new elements are zero-filled
+    arena_reset(ah);
+    if(arena_spilled_sz(ah) != 0) return __LINE__;
+    arena_set_budget(ah, 0, NULL);
+    arena_reset(ah);
+    if(arena_mem_sz(ah) != 0) return __LINE__;
+    if((ptr = (uint8 *)arena_alloc(ah, 100)) == NULL) return __LINE__;
+    if(ptr[0] != 0 || ptr[99] != 0) return __LINE__;
+    if(arena_spilled_sz(ah) == 0) return __LINE__;
+
+
+    puts("Testing wrong spill directory");
+
+    arena_reset(ah);
+    arena_destroy(ah);
+    free(ah);
+
+    ah = arena_create(malloc(arena_get_alloc_sz()), 0, _ach("/nonexistent_dir_for_arena_test"));
+    if(NULL == ah) return __LINE__;
+    if(arena_alloc(ah, 100) != NULL) return __LINE__;
+
+    arena_destroy(ah);
+    free(ah);
+
+    return 0;
+}
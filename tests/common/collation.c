@@ -0,0 +1,232 @@
+#include "tests.h"
+#include "common/collation.h"
+#include "common/error.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+
+#define BENCH_COLLATION_ROWS    (1000000)
+#define BENCH_COLLATION_MAX_SZ  (24)
+
+
+// return sign of memcmp of two sort keys, shorter key is less than longer key with the same beginning
+sint8 test_collation_key_cmp(const uint8 *k1, uint64 sz1, const uint8 *k2, uint64 sz2)
+{
+    int r = memcmp(k1, k2, (sz1 < sz2) ? sz1 : sz2);
+    if(0 == r) return (sz1 < sz2) ? -1 : ((sz1 > sz2) ? 1 : 0);
+    return (r < 0) ? -1 : 1;
+}
+
+
+// check that sort keys of str1 and str2 compare as strings do under collation coll
+// return 0 on success
+int test_collation_check(collation coll, const uint8 *str1, uint64 sz1, const uint8 *str2, uint64 sz2, sint8 expected)
+{
+    uint8 k1[COLLATION_KEY_MAX_SZ(64)], k2[COLLATION_KEY_MAX_SZ(64)];
+    uint64 ksz1, ksz2;
+    sint8 res;
+
+    if(collation_cmp(coll, str1, sz1, str2, sz2, &res) != 0 || res != expected) return __LINE__;
+    if(collation_cmp(coll, str2, sz2, str1, sz1, &res) != 0 || res != -expected) return __LINE__;
+    if(collation_key(coll, str1, sz1, k1, &ksz1) != 0) return __LINE__;
+    if(collation_key(coll, str2, sz2, k2, &ksz2) != 0) return __LINE__;
+    if(test_collation_key_cmp(k1, ksz1, k2, ksz2) != expected) return __LINE__;
+
+    return 0;
+}
+
+
+// strings of bench and of random test
+void test_collation_random_str(uint8 *str, uint64 sz)
+{
+    static const uint8 chars[] = {'a', 'b', 'A', 'B', 'z', 'Z', '@', '[', '`', '{', 0, 0x7F, 0xC3, 0xA9};
+
+    for(uint64 i = 0; i < sz; i++) str[i] = chars[rand() % sizeof(chars)];
+}
+
+
+int test_collation_functions()
+{
+    collation coll;
+    uint8 str1[64], str2[64], key[COLLATION_KEY_MAX_SZ(64)];
+    uint64 sz1, sz2, key_sz;
+    sint8 res;
+    int line;
+
+    puts("Starting test test_collation_functions");
+
+    encoding_init();
+    collation_set_encoding(ENCODING_UTF8);
+
+    puts("Testing collation names");
+
+    if(collation_by_name(_ach("binary"), &coll) != 0 || coll != COLLATION_BINARY) return __LINE__;
+    if(collation_by_name(_ach("ASCII_CI"), &coll) != 0 || coll != COLLATION_ASCII_CI) return __LINE__;
+    if(collation_by_name(_ach("codepoint"), &coll) != 0 || coll != COLLATION_CODEPOINT) return __LINE__;
+    if(collation_by_name(_ach("unicode_ci"), &coll) == 0) return __LINE__;
+    if(strcmp(collation_name(COLLATION_ASCII_CI), _ach("ascii_ci")) != 0) return __LINE__;
+
+
+    puts("Testing binary collation");
+
+    if((line = test_collation_check(COLLATION_BINARY, (const uint8 *)"abc", 3, (const uint8 *)"abc", 3, 0)) != 0) return line;
+    if((line = test_collation_check(COLLATION_BINARY, (const uint8 *)"ab", 2, (const uint8 *)"abc", 3, -1)) != 0) return line;
+    if((line = test_collation_check(COLLATION_BINARY, (const uint8 *)"B", 1, (const uint8 *)"a", 1, -1)) != 0) return line;
+    if((line = test_collation_check(COLLATION_BINARY, (const uint8 *)"", 0, (const uint8 *)"a", 1, -1)) != 0) return line;
+    if((line = test_collation_check(COLLATION_BINARY, (const uint8 *)"\xFF", 1, (const uint8 *)"a", 1, 1)) != 0) return line;
+
+    // zero bytes
+    if((line = test_collation_check(COLLATION_BINARY, (const uint8 *)"a", 1, (const uint8 *)"a\0", 2, -1)) != 0) return line;
+    if((line = test_collation_check(COLLATION_BINARY, (const uint8 *)"a\0", 2, (const uint8 *)"a\1", 2, -1)) != 0) return line;
+    if((line = test_collation_check(COLLATION_BINARY, (const uint8 *)"a\0\0", 3, (const uint8 *)"a\0", 2, 1)) != 0) return line;
+    if((line = test_collation_check(COLLATION_BINARY, (const uint8 *)"a\0b", 3, (const uint8 *)"a\0\xFF", 3, -1)) != 0) return line;
+
+    if(collation_key(COLLATION_BINARY, (const uint8 *)"a\0b", 3, key, &key_sz) != 0) return __LINE__;
+    if(key_sz != 6 || memcmp(key, "a\0\xFF" "b\0\0", 6) != 0) return __LINE__;
+
+
+    puts("Testing case-insensitive collation");
+
+    if((line = test_collation_check(COLLATION_ASCII_CI, (const uint8 *)"Hello World", 11, (const uint8 *)"hELLO wORLD", 11, 0)) != 0) return line;
+    if((line = test_collation_check(COLLATION_ASCII_CI, (const uint8 *)"B", 1, (const uint8 *)"a", 1, 1)) != 0) return line;
+    if((line = test_collation_check(COLLATION_ASCII_CI, (const uint8 *)"Z", 1, (const uint8 *)"_", 1, 1)) != 0) return line;
+    if((line = test_collation_check(COLLATION_ASCII_CI, (const uint8 *)"@[", 2, (const uint8 *)"`{", 2, -1)) != 0) return line;
+    if((line = test_collation_check(COLLATION_ASCII_CI, (const uint8 *)"\xC3\x89", 2, (const uint8 *)"\xC3\xA9", 2, -1)) != 0) return line;
+
+    // words are folded at once
+    if(collation_key(COLLATION_ASCII_CI, (const uint8 *)"ABCDEFGHIJKLMNOPQRSTUVWXYZ@[`{\x80\xC1\xDA", 33, key, &key_sz) != 0) return __LINE__;
+    if(key_sz != 35 || memcmp(key, "abcdefghijklmnopqrstuvwxyz@[`{\x80\xC1\xDA\0\0", 35) != 0) return __LINE__;
+
+
+    puts("Testing code point collation");
+
+    if((line = test_collation_check(COLLATION_CODEPOINT, (const uint8 *)"\xC3\xA9", 2, (const uint8 *)"\xE2\x82\xAC", 3, -1)) != 0) return line;
+    if((line = test_collation_check(COLLATION_CODEPOINT, (const uint8 *)"\xF0\x9F\x98\x80", 4, (const uint8 *)"\xEF\xBF\xBD", 3, 1)) != 0) return line;
+    if((line = test_collation_check(COLLATION_CODEPOINT, (const uint8 *)"z", 1, (const uint8 *)"\xC2\x80", 2, -1)) != 0) return line;
+
+    // invalid characters
+    if(collation_cmp(COLLATION_CODEPOINT, (const uint8 *)"\xC3", 1, (const uint8 *)"a", 1, &res) == 0) return __LINE__;
+    if(error_get() != ERROR_INVALID_CHARACTER) return __LINE__;
+    if(collation_key(COLLATION_CODEPOINT, (const uint8 *)"a\xFF", 2, key, &key_sz) == 0) return __LINE__;
+
+    collation_set_encoding(ENCODING_ASCII);
+    if(collation_key(COLLATION_CODEPOINT, (const uint8 *)"\xC3\xA9", 2, key, &key_sz) == 0) return __LINE__;
+    collation_set_encoding(ENCODING_UNKNOWN);
+    if(collation_key(COLLATION_CODEPOINT, (const uint8 *)"abc", 3, key, &key_sz) != 0 || key_sz != 5) return __LINE__;
+    collation_set_encoding(ENCODING_UTF8);
+
+
+    puts("Testing sort keys of random strings");
+
+    srand(1);
+    for(uint32 i = 0; i < 100000; i++)
+    {
+        sz1 = rand() % 20;
+        sz2 = rand() % 20;
+        test_collation_random_str(str1, sz1);
+        if(rand() % 2) memcpy(str2, str1, sz2 < sz1 ? sz2 : sz1);
+        test_collation_random_str(str2 + (sz2 < sz1 ? sz2 : sz1), sz2 - (sz2 < sz1 ? sz2 : sz1));
+        if(rand() % 4 == 0)
+        {
+            // the same letters in other case
+            sz2 = sz1;
+            for(uint64 j = 0; j < sz1; j++) str2[j] = ((str1[j] | 0x20) >= 'a' && (str1[j] | 0x20) <= 'z') ? str1[j] ^ 0x20 : str1[j];
+        }
+
+        for(coll = COLLATION_BINARY; coll <= COLLATION_ASCII_CI; coll++)
+        {
+            if(collation_cmp(coll, str1, sz1, str2, sz2, &res) != 0) return __LINE__;
+            if((line = test_collation_check(coll, str1, sz1, str2, sz2, res)) != 0) return line;
+        }
+    }
+
+    return 0;
+}
+
+
+// row of bench: string and its sort key
+typedef struct _bench_collation_row
+{
+    uint8 str[BENCH_COLLATION_MAX_SZ];
+    uint8 sz;
+    uint8 key_sz;
+    uint8 key[COLLATION_KEY_MAX_SZ(BENCH_COLLATION_MAX_SZ)];
+} bench_collation_row;
+
+collation g_bench_collation = COLLATION_BINARY;
+
+
+int bench_collation_str_cmp(const void *a, const void *b)
+{
+    const bench_collation_row *r1 = *(const bench_collation_row **)a, *r2 = *(const bench_collation_row **)b;
+    sint8 res;
+
+    collation_cmp(g_bench_collation, r1->str, r1->sz, r2->str, r2->sz, &res);
+    return res;
+}
+
+
+int bench_collation_key_cmp(const void *a, const void *b)
+{
+    const bench_collation_row *r1 = *(const bench_collation_row **)a, *r2 = *(const bench_collation_row **)b;
+    return test_collation_key_cmp(r1->key, r1->key_sz, r2->key, r2->key_sz);
+}
+
+
+int bench_collation_functions()
+{
+    puts("Starting benchmark bench_collation_functions");
+
+    static const char *words[] = {"Customer", "ORDER", "order", "Invoice", "invoice", "Paid", "PENDING", "shipped",
+                                  "Berlin", "BERLIN", "berlin", "Paris", "London", "Zurich"};
+    bench_collation_row *rows = (bench_collation_row *)malloc(BENCH_COLLATION_ROWS * sizeof(bench_collation_row));
+    bench_collation_row **sorted = (bench_collation_row **)malloc(BENCH_COLLATION_ROWS * sizeof(bench_collation_row *));
+    bench_collation_row **sorted_keys = (bench_collation_row **)malloc(BENCH_COLLATION_ROWS * sizeof(bench_collation_row *));
+    uint64 key_sz, i;
+    struct timeval t1;
+
+    if(NULL == rows || NULL == sorted || NULL == sorted_keys) return __LINE__;
+
+    // two words and a number, many strings share long prefix
+    srand(1);
+    for(i = 0; i < BENCH_COLLATION_ROWS; i++)
+    {
+        rows[i].sz = (uint8)snprintf((char *)rows[i].str, BENCH_COLLATION_MAX_SZ, "%s %s %d",
+                                     words[rand() % 14], words[rand() % 14], rand() % 1000);
+    }
+
+    for(g_bench_collation = COLLATION_BINARY; g_bench_collation < COLLATION_NUM; g_bench_collation++)
+    {
+        for(i = 0; i < BENCH_COLLATION_ROWS; i++) sorted[i] = sorted_keys[i] = rows + i;
+
+        gettimeofday(&t1, NULL);
+        qsort(sorted, BENCH_COLLATION_ROWS, sizeof(sorted[0]), bench_collation_str_cmp);
+        printf("Benchmarking sort of %d strings, collation %s: compare strings %ld ms",
+               BENCH_COLLATION_ROWS, collation_name(g_bench_collation), bench_elapsed_ms(&t1));
+
+        gettimeofday(&t1, NULL);
+        for(i = 0; i < BENCH_COLLATION_ROWS; i++)
+        {
+            if(collation_key(g_bench_collation, rows[i].str, rows[i].sz, rows[i].key, &key_sz) != 0) return __LINE__;
+            rows[i].key_sz = (uint8)key_sz;
+        }
+        printf(", build keys %ld ms", bench_elapsed_ms(&t1));
+
+        gettimeofday(&t1, NULL);
+        qsort(sorted_keys, BENCH_COLLATION_ROWS, sizeof(sorted_keys[0]), bench_collation_key_cmp);
+        printf(", compare keys %ld ms.\n", bench_elapsed_ms(&t1));
+
+        // both orders are the same up to equal strings
+        for(i = 0; i < BENCH_COLLATION_ROWS; i++)
+        {
+            if(bench_collation_key_cmp(sorted + i, sorted_keys + i) != 0) return __LINE__;
+        }
+    }
+
+    free(rows);
+    free(sorted);
+    free(sorted_keys);
+
+    return 0;
+}
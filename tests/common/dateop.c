@@ -2,6 +2,7 @@
 #include "common/dateop.h"
 #include "calendar/grigorian.h"
 #include <stdio.h>
+#include <string.h>
 
 int test_dateop_functions()
 {
@@ -12,6 +13,10 @@ int test_dateop_functions()
     if(dateop_extract_year != grigorian_extract_year) return __LINE__;
     if(dateop_extract_month_of_year != grigorian_extract_month_of_year) return __LINE__;
     if(dateop_extract_day_of_month != grigorian_extract_day_of_month) return __LINE__;
+    if(dateop_extract_year_batch != grigorian_extract_year_batch) return __LINE__;
+    if(dateop_extract_month_of_year_batch != grigorian_extract_month_of_year_batch) return __LINE__;
+    if(dateop_extract_day_of_month_batch != grigorian_extract_day_of_month_batch) return __LINE__;
+    if(dateop_extract_date_batch != grigorian_extract_date_batch) return __LINE__;
     if(dateop_trunc_to_year != grigorian_trunc_to_year) return __LINE__;
     if(dateop_is_leap_year != grigorian_is_leap_year) return __LINE__;
     if(dateop_make_date_with_time != grigorian_make_date_with_time) return __LINE__;
@@ -35,5 +40,18 @@ int test_dateop_functions()
     if(dateop_extract_seconds(59) != 59) return __LINE__;
     if(dateop_extract_seconds(60) != 0) return __LINE__;
 
+    const uint64 dates[] = {0, 59, 60, 3599, 3600, 86399, 86400, 90061};
+    const uint8 hours[] = {0, 0, 0, 0, 1, 23, 0, 1};
+    const uint8 minutes[] = {0, 0, 1, 59, 0, 59, 0, 1};
+    const uint8 seconds[] = {0, 59, 0, 59, 0, 59, 0, 1};
+    uint8 res[sizeof(dates) / sizeof(dates[0])];
+
+    dateop_extract_hour_batch(dates, sizeof(res), res);
+    if(memcmp(res, hours, sizeof(res)) != 0) return __LINE__;
+    dateop_extract_minutes_batch(dates, sizeof(res), res);
+    if(memcmp(res, minutes, sizeof(res)) != 0) return __LINE__;
+    dateop_extract_seconds_batch(dates, sizeof(res), res);
+    if(memcmp(res, seconds, sizeof(res)) != 0) return __LINE__;
+
     return 0;
 }
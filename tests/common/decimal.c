@@ -9,6 +9,35 @@
 #include <fcntl.h>
 #include <sys/time.h>
 #include <unistd.h>
+#include <stdlib.h>
+
+
+// fill d with random mantissa of n digits, exponent e and random sign
+void test_decimal_random(decimal *d, sint16 n, sint8 e)
+{
+    sint16 i, t = 1;
+
+    memset(d, 0, sizeof(*d));
+    for(i = 0; i < n; i++)
+    {
+        d->m[i / DECIMAL_BASE_LOG10] += (sint16)((i == n - 1 ? rand() % 9 + 1 : rand() % 10) * t);
+        t = (t == DECIMAL_BASE / 10) ? 1 : t * 10;
+    }
+    d->n = n;
+    d->e = n > 0 ? e : 0;
+    d->sign = (n > 0 && rand() % 2) ? DECIMAL_SIGN_NEG : DECIMAL_SIGN_POS;
+}
+
+
+sint16 g_test_decimal_pow10[DECIMAL_BASE_LOG10] = {1, 10, 100, 1000};
+
+
+// return digit j of mantissa of d counting from the least significant one
+sint16 test_decimal_digit(const decimal *d, sint16 j)
+{
+    return d->m[j / DECIMAL_BASE_LOG10] / g_test_decimal_pow10[j % DECIMAL_BASE_LOG10] % 10;
+}
+
 
 int test_decimal_functions()
 {
@@ -775,7 +804,67 @@ int test_decimal_functions()
 //    printf("d3.m = %c %4d %4d %4d %4d %4d %4d %4d %4d %4d %4d e=%d, n=%d\n", (d3.sign == DECIMAL_SIGN_NEG ? '-' : '+'), d3.m[9], d3.m[8], d3.m[7], d3.m[6], d3.m[5], d3.m[4], d3.m[3], d3.m[2], d3.m[1], d3.m[0], d3.e, d3.n);
     if(decimal_cmp(&d3, &ref) != 0) return __LINE__;
 
+    // all limbs of quotient are filled: 7907957 / 89199372060596057129890
+    memset(&d1, 0, sizeof(d1)); d1.sign = DECIMAL_SIGN_POS; d1.m[1] = 790; d1.m[0] = 7957; d1.n = 7; d1.e = -9;
+    memset(&d2, 0, sizeof(d2)); d2.sign = DECIMAL_SIGN_NEG; d2.n = 23; d2.e = -5;
+    d2.m[5] = 891; d2.m[4] = 9937; d2.m[3] = 2060; d2.m[2] = 5960; d2.m[1] = 5712; d2.m[0] = 9890;
+    memset(&ref, 0, sizeof(ref)); ref.sign = DECIMAL_SIGN_NEG; ref.n = 40; ref.e = -60;
+    ref.m[9] = 8865; ref.m[8] = 4850; ref.m[7] = 5591; ref.m[6] = 2574; ref.m[5] = 8224;
+    ref.m[4] = 7448; ref.m[3] = 5303; ref.m[2] = 8661; ref.m[1] = 1762; ref.m[0] = 88;
+    memset(d3.m, 123, sizeof(d3.m)); d3.sign = DECIMAL_SIGN_NEG; d3.e = 123; d3.n = 123;
+    if(decimal_div(&d1, &d2, &d3) != 0) return __LINE__;
+    if(memcmp(&d3, &ref, sizeof(ref)) != 0) return __LINE__;
+
+    // prepared divisor gives the same quotients
+    decimal_divisor dv;
+    if(decimal_divisor_prepare(&d2, &dv) != 0) return __LINE__;
+    memset(d3.m, 123, sizeof(d3.m)); d3.sign = DECIMAL_SIGN_NEG; d3.e = 123; d3.n = 123;
+    if(decimal_div_by_divisor(&d1, &dv, &d3) != 0) return __LINE__;
+    if(memcmp(&d3, &ref, sizeof(ref)) != 0) return __LINE__;
+
+    decimal_from_int64(7, &d2);
+    if(decimal_divisor_prepare(&d2, &dv) != 0) return __LINE__;
+    for(int i = -994; i < 1000; i += 7)
+    {
+        decimal_from_int64(i * 12345L, &d1);
+        if(decimal_div(&d1, &d2, &ref) != 0) return __LINE__;
+        if(decimal_div_by_divisor(&d1, &dv, &d3) != 0) return __LINE__;
+        if(memcmp(&d3, &ref, sizeof(ref)) != 0) return __LINE__;
+        // i * 12345 / 7 is exact
+        decimal_from_int64(i * 12345L / 7, &d1);
+        if(i != 0 && decimal_cmp(&d3, &d1) != 0) return __LINE__;
+    }
+
+    // random divisors of every limb count and sign, both single limb path with reciprocal and long division,
+    // with dividends of any length, including quotients overflowing exponent
+    srand(3);
+    for(int i = 0; i < 4000; i++)
+    {
+        test_decimal_random(&d2, (sint16)(i % DECIMAL_POSITIONS + 1), (sint8)(rand() % 81 - 40));
+        // zero lowest limb, nines in the highest limb
+        if(i % 5 == 0 && d2.n > DECIMAL_BASE_LOG10) d2.m[0] = 0;
+        if(i % 7 == 0) d2.m[(d2.n - 1) / DECIMAL_BASE_LOG10] = (sint16)(d2.n % DECIMAL_BASE_LOG10 ? g_test_decimal_pow10[d2.n % DECIMAL_BASE_LOG10] - 1 : DECIMAL_BASE - 1);
+        if(decimal_divisor_prepare(&d2, &dv) != 0) return __LINE__;
+
+        for(int j = 0; j < 50; j++)
+        {
+            test_decimal_random(&d1, (sint16)(rand() % (DECIMAL_POSITIONS + 1)), (sint8)(rand() % 81 - 40));
+            if(j % 10 == 0 && d1.n > 0) d1.e = (sint8)(j % 20 ? DECIMAL_MAX_EXPONENT : DECIMAL_MIN_EXPONENT);
+
+            memset(&d3, 0, sizeof(d3)); memset(&ref, 0, sizeof(ref));
+            sint8 res = decimal_div(&d1, &d2, &ref);
+            if(decimal_div_by_divisor(&d1, &dv, &d3) != res) return __LINE__;
+            if(res == 0 && memcmp(&d3, &ref, sizeof(ref)) != 0) return __LINE__;
+        }
+    }
+
+    decimal_from_int64(0, &d2);
+    if(decimal_divisor_prepare(&d2, &dv) == 0) return __LINE__;
+    if(error_get() != ERROR_DIVISION_BY_ZERO) return __LINE__;
+
     // overflow
+    memset(&d1, 0, sizeof(d1)); d1.sign = DECIMAL_SIGN_NEG; d1.m[2] = 4999; d1.m[1] = 9997; d1.n = 12;
+    memset(&d2, 0, sizeof(d2)); d2.sign = DECIMAL_SIGN_NEG; d2.m[1] = 5003; d2.m[0] = 9999; d2.n = 8;
     d2.e = -35;
     d1.e = DECIMAL_MIN_EXPONENT;
     memset(d3.m, 123, sizeof(d3.m)); d3.sign = DECIMAL_SIGN_NEG; d3.e = -111; d3.n = 123;
@@ -788,6 +877,258 @@ int test_decimal_functions()
     if(decimal_div(&d1, &d2, &d3) == 0) return __LINE__;
     if(error_get() != ERROR_DECIMAL_OVERFLOW) return __LINE__;
 
+
+    puts("Testing decimal conversion from integer");
+
+    decimal_from_int64(0, &d3);
+    memset(&ref, 0, sizeof(ref)); ref.sign = DECIMAL_SIGN_POS;
+    if(memcmp(&d3, &ref, sizeof(ref)) != 0) return __LINE__;
+
+    decimal_from_int64(-1234567, &d3);
+    memset(&ref, 0, sizeof(ref)); ref.sign = DECIMAL_SIGN_NEG; ref.n = 7; ref.m[0] = 4567; ref.m[1] = 123;
+    if(memcmp(&d3, &ref, sizeof(ref)) != 0) return __LINE__;
+
+    decimal_from_int64(-0x7FFFFFFFFFFFFFFFL - 1, &d3);
+    memset(&ref, 0, sizeof(ref)); ref.sign = DECIMAL_SIGN_NEG; ref.n = 19;
+    ref.m[0] = 5808; ref.m[1] = 5477; ref.m[2] = 368; ref.m[3] = 3372; ref.m[4] = 922;
+    if(memcmp(&d3, &ref, sizeof(ref)) != 0) return __LINE__;
+
+    puts("Testing decimal conversion to float");
+
+    // -1234567 * 10^-3 = -1234.567
+    decimal_from_int64(-1234567, &d3);
+    d3.e = -3;
+    if(decimal_to_float64(&d3) != -1234.567) return __LINE__;
+    d3.e = 2;
+    if(decimal_to_float64(&d3) != -123456700.0) return __LINE__;
+    decimal_from_int64(0, &d3);
+    if(decimal_to_float64(&d3) != 0.0) return __LINE__;
+    // 0.25 with full mantissa
+    memset(&d3, 0, sizeof(d3)); d3.sign = DECIMAL_SIGN_POS; d3.m[9] = 2500; d3.n = 40; d3.e = -40;
+    if(decimal_to_float64(&d3) != 0.25) return __LINE__;
+
+    puts("Testing decimal subtraction of greater number");
+
+    // 3 - 10 = -7, 3 - (-10) = 13
+    decimal_from_int64(3, &d1);
+    decimal_from_int64(10, &d2);
+    decimal_from_int64(-7, &ref);
+    if(decimal_sub(&d1, &d2, &d3) != 0) return __LINE__;
+    if(decimal_cmp(&d3, &ref) != 0) return __LINE__;
+    d2.sign = DECIMAL_SIGN_NEG;
+    decimal_from_int64(13, &ref);
+    if(decimal_sub(&d1, &d2, &d3) != 0) return __LINE__;
+    if(decimal_cmp(&d3, &ref) != 0) return __LINE__;
+
+    // 1e-40 - 8e16 = -8e16, -1e-40 + 8e16 = 8e16: too small term is dropped, sign follows op
+    memset(&d1, 0, sizeof(d1)); d1.sign = DECIMAL_SIGN_POS; d1.m[0] = 1; d1.n = 1; d1.e = -40;
+    memset(&d2, 0, sizeof(d2)); d2.sign = DECIMAL_SIGN_POS; d2.m[0] = 8; d2.n = 1; d2.e = 16;
+    memcpy(&ref, &d2, sizeof(ref));
+    ref.sign = DECIMAL_SIGN_NEG;
+    if(decimal_sub(&d1, &d2, &d3) != 0) return __LINE__;
+    if(memcmp(&d3, &ref, sizeof(ref)) != 0) return __LINE__;
+    d1.sign = DECIMAL_SIGN_NEG;
+    ref.sign = DECIMAL_SIGN_POS;
+    if(decimal_add(&d1, &d2, &d3) != 0) return __LINE__;
+    if(memcmp(&d3, &ref, sizeof(ref)) != 0) return __LINE__;
+    // -1e-40 - (-8e16) = 8e16, 8e16 - 1e-40 = 8e16
+    d2.sign = DECIMAL_SIGN_NEG;
+    if(decimal_sub(&d1, &d2, &d3) != 0) return __LINE__;
+    if(memcmp(&d3, &ref, sizeof(ref)) != 0) return __LINE__;
+    d2.sign = DECIMAL_SIGN_POS;
+    d1.sign = DECIMAL_SIGN_POS;
+    if(decimal_sub(&d2, &d1, &d3) != 0) return __LINE__;
+    if(memcmp(&d3, &ref, sizeof(ref)) != 0) return __LINE__;
+
+    // a - b = -(b - a) and a + b = b + a for terms far apart
+    srand(3);
+    for(int i = 0; i < 100000; i++)
+    {
+        test_decimal_random(&d1, rand() % DECIMAL_POSITIONS + 1, (sint8)(rand() % 121 - 60));
+        test_decimal_random(&d2, rand() % DECIMAL_POSITIONS + 1, (sint8)(rand() % 121 - 60));
+
+        if(decimal_sub(&d1, &d2, &d3) != 0 || decimal_sub(&d2, &d1, &ref) != 0) return __LINE__;
+        if(ref.n > 0) ref.sign = -ref.sign;
+        if(memcmp(&d3, &ref, sizeof(ref)) != 0) return __LINE__;
+        if(decimal_add(&d1, &d2, &d3) != 0 || decimal_add(&d2, &d1, &ref) != 0) return __LINE__;
+        if(memcmp(&d3, &ref, sizeof(ref)) != 0) return __LINE__;
+    }
+
+    puts("Testing decimal comparison of mantissas of different length");
+
+    // 1.5 > 1
+    memset(&d1, 0, sizeof(d1)); d1.sign = DECIMAL_SIGN_POS; d1.m[0] = 15; d1.n = 2; d1.e = -1;
+    memset(&d2, 0, sizeof(d2)); d2.sign = DECIMAL_SIGN_POS; d2.m[0] = 1; d2.n = 1; d2.e = 0;
+    if(decimal_cmp(&d1, &d2) <= 0) return __LINE__;
+    if(decimal_cmp(&d2, &d1) >= 0) return __LINE__;
+
+    // 0.25 = 0.2500000000000000000000000000000000000000
+    memset(&d1, 0, sizeof(d1)); d1.sign = DECIMAL_SIGN_POS; d1.m[0] = 25; d1.n = 2; d1.e = -2;
+    memset(&d2, 0, sizeof(d2)); d2.sign = DECIMAL_SIGN_POS; d2.m[9] = 2500; d2.n = 40; d2.e = -40;
+    if(decimal_cmp(&d1, &d2) != 0) return __LINE__;
+    d2.m[0] = 1;
+    if(decimal_cmp(&d1, &d2) >= 0) return __LINE__;
+
+    // same leading position: comparison agrees with sign of exact difference, including trailing digits
+    sint16 cmp;
+    srand(5);
+    for(int i = 0; i < 100000; i++)
+    {
+        test_decimal_random(&d1, rand() % DECIMAL_POSITIONS + 1, 0);
+        test_decimal_random(&d2, rand() % DECIMAL_POSITIONS + 1, 0);
+        d2.sign = d1.sign;
+        d2.e = (sint8)(d1.n - d2.n);
+        if(i % 2 && d2.n > d1.n)
+        {
+            // equal prefix, so only the tail of the longer mantissa decides
+            for(sint16 j = 0, k = d2.n - d1.n; j < d1.n; j++)
+            {
+                d2.m[(j + k) / DECIMAL_BASE_LOG10] += (sint16)((test_decimal_digit(&d1, j) - test_decimal_digit(&d2, j + k)) * g_test_decimal_pow10[(j + k) % DECIMAL_BASE_LOG10]);
+            }
+        }
+        if(decimal_sub(&d1, &d2, &d3) != 0) return __LINE__;
+        cmp = decimal_cmp(&d1, &d2);
+        if((cmp > 0) - (cmp < 0) != (d3.n == 0 ? 0 : d3.sign)) return __LINE__;
+        cmp = decimal_cmp(&d2, &d1);
+        if((cmp > 0) - (cmp < 0) != (d3.n == 0 ? 0 : -d3.sign)) return __LINE__;
+    }
+
+    puts("Testing decimal conversion to 128-bit integer");
+
+    sint128 v;
+
+    decimal_from_int64(-1234567, &d1);
+    if(decimal_to_int128(&d1, &v) != 0 || v != -1234567) return __LINE__;
+    decimal_from_int128(v, -3, &d3);
+    d1.e = -3;
+    if(memcmp(&d1, &d3, sizeof(d3)) != 0) return __LINE__;
+
+    // 10^38 - 1 fits, 10^38 does not
+    memset(&d1, 0, sizeof(d1)); d1.sign = DECIMAL_SIGN_POS; d1.n = 38;
+    for(int i = 0; i < 9; i++) d1.m[i] = 9999;
+    d1.m[9] = 99;
+    if(decimal_to_int128(&d1, &v) != 0) return __LINE__;
+    decimal_from_int128(v, 0, &d3);
+    if(memcmp(&d1, &d3, sizeof(d3)) != 0) return __LINE__;
+    decimal_from_int128(v + 1, 0, &d3);
+    if(d3.n != 39 || d3.m[9] != 100 || d3.m[8] != 0) return __LINE__;
+    if(decimal_to_int128(&d3, &v) == 0) return __LINE__;
+
+    decimal_from_int128(0, 5, &d3);
+    memset(&ref, 0, sizeof(ref)); ref.sign = DECIMAL_SIGN_POS;
+    if(memcmp(&d3, &ref, sizeof(ref)) != 0) return __LINE__;
+
+    puts("Testing decimal 128-bit fast path against limbs");
+
+    srand(1);
+    for(int i = 0; i < 200000; i++)
+    {
+        test_decimal_random(&d1, rand() % (DECIMAL_POSITIONS + 1), (sint8)(rand() % 41 - 20));
+        test_decimal_random(&d2, rand() % (DECIMAL_POSITIONS + 1), (sint8)(rand() % 41 - 20));
+
+        memset(&d3, 0, sizeof(d3)); memset(&ref, 0, sizeof(ref));
+        if(decimal_add(&d1, &d2, &d3) != decimal_add_sub_limbs(&d1, &d2, &ref, 1)) return __LINE__;
+        if(memcmp(&d3, &ref, sizeof(ref)) != 0) return __LINE__;
+
+        memset(&d3, 0, sizeof(d3)); memset(&ref, 0, sizeof(ref));
+        if(decimal_sub(&d1, &d2, &d3) != decimal_add_sub_limbs(&d1, &d2, &ref, -1)) return __LINE__;
+        if(memcmp(&d3, &ref, sizeof(ref)) != 0) return __LINE__;
+
+        memset(&d3, 0, sizeof(d3)); memset(&ref, 0, sizeof(ref));
+        if(decimal_mul(&d1, &d2, &d3) != decimal_mul_limbs(&d1, &d2, &ref)) return __LINE__;
+        if(memcmp(&d3, &ref, sizeof(ref)) != 0) return __LINE__;
+
+        // equal leading positions exercise comparison of aligned mantissas
+        if(i % 2 && d1.n > 0 && d2.n > 0 && (sint32)d1.e + d1.n - d2.n >= DECIMAL_MIN_EXPONENT && (sint32)d1.e + d1.n - d2.n <= DECIMAL_MAX_EXPONENT)
+        {
+            d2.e = (sint8)(d1.e + d1.n - d2.n);
+            d2.sign = d1.sign;
+        }
+        if(decimal_sub(&d1, &d2, &d3) != 0) return __LINE__;
+        if((decimal_cmp(&d1, &d2) > 0) != (d3.n > 0 && d3.sign == DECIMAL_SIGN_POS)) return __LINE__;
+        if((decimal_cmp(&d1, &d2) < 0) != (d3.n > 0 && d3.sign == DECIMAL_SIGN_NEG)) return __LINE__;
+    }
+
+    puts("Testing decimal accumulator");
+
+    decimal_accumulator acc, part[4];
+    sint8 e;
+
+    // sum is exact, so it is equal to sequential addition
+    srand(2);
+    decimal_accumulator_init(&acc);
+    for(int i = 0; i < 4; i++) decimal_accumulator_init(part + i);
+    memset(&d3, 0, sizeof(d3)); d3.sign = DECIMAL_SIGN_POS;
+    for(int i = 0; i < 20000; i++)
+    {
+        e = (sint8)(i < 10000 ? -2 : -(rand() % 7));
+        test_decimal_random(&d1, rand() % 13, e);
+        decimal_accumulator_add(&acc, &d1);
+        decimal_accumulator_add(part + i % 4, &d1);
+        if(decimal_add(&d3, &d1, &d2) != 0) return __LINE__;
+        d3 = d2;
+    }
+    if(decimal_accumulator_sum(&acc, &d1) != 0) return __LINE__;
+    if(decimal_cmp(&d1, &d3) != 0 || d1.e != -6) return __LINE__;
+    if(acc.count != 20000) return __LINE__;
+
+    // partial sums of workers give the same sum
+    decimal_accumulator_merge(part + 1, part + 3);
+    decimal_accumulator_merge(part + 2, part);
+    decimal_accumulator_merge(part + 2, part + 1);
+    if(decimal_accumulator_sum(part + 2, &d2) != 0) return __LINE__;
+    if(memcmp(&d1, &d2, sizeof(d2)) != 0 || part[2].count != 20000) return __LINE__;
+
+    // limbs are carried periodically
+    decimal_accumulator_init(&acc);
+    decimal_from_int64(-99999999, &d1); d1.e = -4;
+    for(int i = 0; i < DECIMAL_ACC_CARRY_INTERVAL * 2 + 5; i++)
+    {
+        decimal_accumulator_add(&acc, &d1);
+    }
+    decimal_from_int64(-99999999L * (DECIMAL_ACC_CARRY_INTERVAL * 2 + 5), &ref); ref.e = -4;
+    if(decimal_accumulator_sum(&acc, &d3) != 0) return __LINE__;
+    if(memcmp(&d3, &ref, sizeof(ref)) != 0) return __LINE__;
+
+    // 10^100 + 1 does not fit into the window
+    decimal_accumulator_init(&acc);
+    decimal_from_int64(1, &d1);
+    decimal_accumulator_add(&acc, &d1);
+    d1.e = 100;
+    decimal_accumulator_add(&acc, &d1);
+    if(decimal_accumulator_sum(&acc, &d3) != 0) return __LINE__;
+    if(decimal_cmp(&d3, &d1) != 0) return __LINE__;
+
+    // sum to zero, 1 is truncated already
+    d1.sign = DECIMAL_SIGN_NEG;
+    decimal_accumulator_add(&acc, &d1);
+    if(decimal_accumulator_sum(&acc, &d3) != 0) return __LINE__;
+    if(d3.n != 0 || d3.e != 0 || d3.sign != DECIMAL_SIGN_POS) return __LINE__;
+
+    // 41 digits with maximum exponent
+    decimal_accumulator_init(&acc);
+    memset(&d1, 0, sizeof(d1)); d1.sign = DECIMAL_SIGN_POS; d1.n = 40; d1.e = DECIMAL_MAX_EXPONENT;
+    for(int i = 0; i < DECIMAL_PARTS; i++) d1.m[i] = 9999;
+    decimal_accumulator_add(&acc, &d1);
+    if(decimal_accumulator_sum(&acc, &d3) != 0) return __LINE__;
+    if(memcmp(&d3, &d1, sizeof(d1)) != 0) return __LINE__;
+    decimal_accumulator_add(&acc, &d1);
+    if(decimal_accumulator_sum(&acc, &d3) == 0) return __LINE__;
+    if(error_get() != ERROR_DECIMAL_OVERFLOW) return __LINE__;
+
+    // avg(1, 2, 3, 4) = 2.5
+    decimal_accumulator_init(&acc);
+    if(decimal_accumulator_avg(&acc, &d3) == 0) return __LINE__;
+    if(error_get() != ERROR_DIVISION_BY_ZERO) return __LINE__;
+    for(int i = 1; i <= 4; i++)
+    {
+        decimal_from_int64(i, &d1);
+        decimal_accumulator_add(&acc, &d1);
+    }
+    if(decimal_accumulator_avg(&acc, &d3) != 0) return __LINE__;
+    decimal_from_int64(25, &ref); ref.e = -1;
+    if(decimal_cmp(&d3, &ref) != 0) return __LINE__;
+
 /*
     puts("Testing decimal left shift");
 
@@ -850,3 +1191,132 @@ int test_decimal_functions()
 */
     return 0;
 }
+
+
+#define BENCH_DECIMAL_VALUES    (1024)
+#define BENCH_DECIMAL_REPEATS   (2000)
+
+
+int bench_decimal_functions()
+{
+    puts("Starting benchmark bench_decimal_functions");
+
+    const sint16 precisions[] = {4, 18, 38, 40};
+    const char *names[] = {"add", "sub", "mul", "div"};
+    decimal *a = (decimal *)malloc(sizeof(decimal) * BENCH_DECIMAL_VALUES);
+    decimal *b = (decimal *)malloc(sizeof(decimal) * BENCH_DECIMAL_VALUES);
+    decimal d3, sum;
+    decimal_accumulator acc;
+    decimal_divisor dv;
+    struct timeval t1;
+    sint64 check = 0;
+    long fast_ms, limbs_ms;
+    uint32 p, op, r, i;
+
+    if(NULL == a || NULL == b) return __LINE__;
+
+    srand(1);
+    for(p = 0; p < sizeof(precisions) / sizeof(precisions[0]); p++)
+    {
+        for(i = 0; i < BENCH_DECIMAL_VALUES; i++)
+        {
+            // half of precision after decimal point, scale of b is often greater, so terms of add are aligned
+            test_decimal_random(a + i, precisions[p], (sint8)(-precisions[p] / 2));
+            test_decimal_random(b + i, precisions[p] - rand() % 2, (sint8)(-precisions[p] / 2 - rand() % 2));
+        }
+
+        for(op = 0; op < sizeof(names) / sizeof(names[0]); op++)
+        {
+            gettimeofday(&t1, NULL);
+            for(r = 0; r < BENCH_DECIMAL_REPEATS; r++)
+            {
+                for(i = 0; i < BENCH_DECIMAL_VALUES; i++)
+                {
+                    switch(op)
+                    {
+                        case 0: decimal_add(a + i, b + i, &d3); check += d3.n; break;
+                        case 1: decimal_sub(a + i, b + i, &d3); check += d3.n; break;
+                        case 2: decimal_mul(a + i, b + i, &d3); check += d3.n; break;
+                        default: decimal_div(a + i, b + i, &d3); check += d3.n; break;
+                    }
+                }
+            }
+            fast_ms = bench_elapsed_ms(&t1);
+
+            gettimeofday(&t1, NULL);
+            for(r = 0; r < BENCH_DECIMAL_REPEATS; r++)
+            {
+                for(i = 0; i < BENCH_DECIMAL_VALUES; i++)
+                {
+                    switch(op)
+                    {
+                        case 0: decimal_add_sub_limbs(a + i, b + i, &d3, 1); check -= d3.n; break;
+                        case 1: decimal_add_sub_limbs(a + i, b + i, &d3, -1); check -= d3.n; break;
+                        case 2: decimal_mul_limbs(a + i, b + i, &d3); check -= d3.n; break;
+                        default: decimal_div(a + i, b + i, &d3); check -= d3.n; break;
+                    }
+                }
+            }
+            limbs_ms = bench_elapsed_ms(&t1);
+
+            printf("Benchmarking decimal %s of %d digits: %ld ms, on limbs %ld ms.\n", names[op], precisions[p], fast_ms, limbs_ms);
+        }
+
+        memset(&sum, 0, sizeof(sum)); sum.sign = DECIMAL_SIGN_POS;
+        gettimeofday(&t1, NULL);
+        for(r = 0; r < BENCH_DECIMAL_REPEATS; r++)
+        {
+            for(i = 0; i < BENCH_DECIMAL_VALUES; i++)
+            {
+                if(decimal_add(&sum, b + i, &d3) != 0) return __LINE__;
+                sum = d3;
+            }
+        }
+        fast_ms = bench_elapsed_ms(&t1);
+
+        decimal_accumulator_init(&acc);
+        gettimeofday(&t1, NULL);
+        for(r = 0; r < BENCH_DECIMAL_REPEATS; r++)
+        {
+            for(i = 0; i < BENCH_DECIMAL_VALUES; i++)
+            {
+                decimal_accumulator_add(&acc, b + i);
+            }
+        }
+        if(decimal_accumulator_sum(&acc, &d3) != 0) return __LINE__;
+        limbs_ms = bench_elapsed_ms(&t1);
+
+        printf("Benchmarking decimal sum of %d digits: %ld ms, with accumulator %ld ms.\n", precisions[p], fast_ms, limbs_ms);
+
+        // repeated division by the same decimal, as in currency conversion
+        gettimeofday(&t1, NULL);
+        for(r = 0; r < BENCH_DECIMAL_REPEATS; r++)
+        {
+            for(i = 0; i < BENCH_DECIMAL_VALUES; i++)
+            {
+                decimal_div(a + i, b, &d3);
+                check += d3.n;
+            }
+        }
+        fast_ms = bench_elapsed_ms(&t1);
+
+        if(decimal_divisor_prepare(b, &dv) != 0) return __LINE__;
+        gettimeofday(&t1, NULL);
+        for(r = 0; r < BENCH_DECIMAL_REPEATS; r++)
+        {
+            for(i = 0; i < BENCH_DECIMAL_VALUES; i++)
+            {
+                decimal_div_by_divisor(a + i, &dv, &d3);
+                check -= d3.n;
+            }
+        }
+        limbs_ms = bench_elapsed_ms(&t1);
+
+        printf("Benchmarking decimal div by constant of %d digits: %ld ms, with prepared divisor %ld ms.\n", precisions[p], fast_ms, limbs_ms);
+    }
+
+    free(a);
+    free(b);
+
+    return check != 0 ? __LINE__ : 0;
+}
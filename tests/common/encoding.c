@@ -2,6 +2,31 @@
 #include "common/encoding.h"
 #include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
+
+// reference validation by building characters byte by byte
+// return length of the longest valid prefix
+uint64 test_encoding_valid_len(const uint8 *str, uint64 sz)
+{
+    encoding_build_char_fun build = encoding_get_build_char_fun(ENCODING_UTF8);
+    uint8 chr_buf[ENCODING_MAXCHAR_LEN];
+    char_info chr = {.chr = chr_buf, .ptr = 0, .state = CHAR_STATE_INCOMPLETE};
+    uint64 valid = 0;
+
+    for(uint64 i = 0; i < sz; i++)
+    {
+        build(&chr, str[i]);
+        if(chr.state == CHAR_STATE_INVALID) break;
+        if(chr.state == CHAR_STATE_COMPLETE)
+        {
+            valid = i + 1;
+            chr.ptr = 0;
+            chr.state = CHAR_STATE_INCOMPLETE;
+        }
+    }
+
+    return valid;
+}
 
 int test_encoding_functions()
 {
@@ -281,6 +306,200 @@ int test_encoding_functions()
     if(chr.length != 4) return __LINE__;
     if(chr.state != CHAR_STATE_COMPLETE) return __LINE__;
 
+    memset(chr_buf, 0, ENCODING_MAXCHAR_LEN);
+    chr.ptr = 0;
+    chr.state = CHAR_STATE_INCOMPLETE;
+    utf8_build(&chr, 0xEDu);    // surrogate U+D800
+    utf8_build(&chr, 0xA0u);
+    utf8_build(&chr, 0x80u);
+    if(chr.state != CHAR_STATE_INVALID) return __LINE__;
+
+
+    puts("Testing buffer functions");
+
+    static const struct
+    {
+        const char *str;
+        uint64 valid;
+        encoding_char_state state;
+    } utf8_cases[] = {
+        {"", 0, CHAR_STATE_COMPLETE},
+        {"abc", 3, CHAR_STATE_COMPLETE},
+        {"a\xC2\xA2\xE0\xA4\xB9\xF0\x90\x8D\x88z", 11, CHAR_STATE_COMPLETE},
+        {"\xF4\x8F\xBF\xBF", 4, CHAR_STATE_COMPLETE},        // U+10FFFF
+        {"ab\xC0\xAF", 2, CHAR_STATE_INVALID},                 // overlong '/'
+        {"\xE0\x9F\xBF", 0, CHAR_STATE_INVALID},              // overlong
+        {"\xF0\x8F\xBF\xBF", 0, CHAR_STATE_INVALID},          // overlong
+        {"x\xED\xA0\x80", 1, CHAR_STATE_INVALID},             // surrogate
+        {"\xF4\x90\x80\x80", 0, CHAR_STATE_INVALID},          // above U+10FFFF
+        {"\xF5\x80\x80\x80", 0, CHAR_STATE_INVALID},
+        {"a\x80", 1, CHAR_STATE_INVALID},                       // stray continuation byte
+        {"\xC2" "a", 0, CHAR_STATE_INVALID},
+        {"ab\xF0\x90\x8D", 2, CHAR_STATE_INCOMPLETE},
+        {"ab\xE0\x80", 2, CHAR_STATE_INVALID},
+    };
+    uint8 text[256], out[256], conv[256];
+    uint64 valid, rd, wr, sz, len, chars_built;
+    encoding_char_state state;
+    uint32 k;
+
+    for(k = 0; k < sizeof(utf8_cases) / sizeof(utf8_cases[0]); k++)
+    {
+        // at the start, in the middle and across the end of a 32 bytes block
+        for(uint32 pad = 0; pad < 70; pad += 23)
+        {
+            sz = strlen(utf8_cases[k].str);
+            memset(text, 'p', pad);
+            memcpy(text + pad, utf8_cases[k].str, sz);
+
+            if(encoding_validate(ENCODING_UTF8, text, pad + sz, &valid) != utf8_cases[k].state) return __LINE__*1000 + k;
+            if(valid != pad + utf8_cases[k].valid) return __LINE__*1000 + k;
+        }
+    }
+
+    if(encoding_validate(ENCODING_ASCII, (const uint8 *)"abc", 3, &valid) != CHAR_STATE_COMPLETE || valid != 3) return __LINE__;
+    if(encoding_validate(ENCODING_ASCII, (const uint8 *)"ab\xC2\xA2", 4, &valid) != CHAR_STATE_INVALID || valid != 2) return __LINE__;
+    if(encoding_ascii_len((const uint8 *)"0123456789abcdefghijklmnopqrstuvwxyz\x80", 37) != 36) return __LINE__;
+
+    // random text with corrupted bytes against building and converting characters one by one
+    static const char *chars[] = {"a", "Z", "\xD0\xA4", "\xE0\xA4\xB9", "\xF0\x90\x8D\x88", "\xEF\xBF\xBD", "\xF4\x8F\xBF\xBF"};
+    srand(1);
+    for(k = 0; k < 20000; k++)
+    {
+        for(sz = 0; sz < 200; )
+        {
+            const char *c = chars[(rand() % 4 == 0) ? rand() % 7 : rand() % 2];
+            memcpy(text + sz, c, strlen(c));
+            sz += strlen(c);
+        }
+        if(k % 2) text[rand() % sz] = (uint8)rand();
+        len = sz - rand() % 4;
+
+        state = encoding_validate(ENCODING_UTF8, text, len, &valid);
+        if(valid != test_encoding_valid_len(text, len)) return __LINE__*1000 + k;
+        if(state == CHAR_STATE_COMPLETE && valid != len) return __LINE__*1000 + k;
+        if(state != CHAR_STATE_COMPLETE && valid == len) return __LINE__*1000 + k;
+
+        // count against number of characters built, conversion against converting them one by one
+        chr.ptr = 0;
+        chr.state = CHAR_STATE_INCOMPLETE;
+        chars_built = 0;
+        wr = 0;
+        for(uint64 i = 0; i < valid; i++)
+        {
+            utf8_build(&chr, text[i]);
+            if(chr.state == CHAR_STATE_COMPLETE)
+            {
+                chr2.chr = out + wr;
+                utf8_to_ascii((const_char_info *)&chr, &chr2);
+                wr += chr2.length;
+                chars_built++;
+                chr.ptr = 0;
+                chr.state = CHAR_STATE_INCOMPLETE;
+            }
+        }
+        chr2.chr = chr2_buf;
+
+        if(encoding_count(ENCODING_UTF8, text, valid) != chars_built) return __LINE__*1000 + k;
+        if(encoding_convert(ENCODING_UTF8, ENCODING_ASCII, text, valid, conv, sizeof(conv), &rd) != wr) return __LINE__*1000 + k;
+        if(rd != valid || memcmp(conv, out, wr) != 0) return __LINE__*1000 + k;
+    }
+
+    // conversion stops before character which doesn't fit or is not complete
+    const uint8 *str = (const uint8 *)"a\xD0\xA4" "b\xE0\xA4\xB9";
+    wr = encoding_convert(ENCODING_UTF8, ENCODING_UTF8, str, 7, out, 2, &rd);
+    if(wr != 1 || rd != 1) return __LINE__;
+    wr = encoding_convert(ENCODING_UTF8, ENCODING_UTF8, str, 6, out, 256, &rd);
+    if(wr != 4 || rd != 4 || memcmp(out, str, 4) != 0) return __LINE__;
+    wr = encoding_convert(ENCODING_UTF8, ENCODING_ASCII, str, 7, out, 3, &rd);
+    if(wr != 3 || rd != 4 || memcmp(out, "a?b", 3) != 0) return __LINE__;
+    wr = encoding_convert(ENCODING_UTF8, ENCODING_ASCII, str, 6, out, 256, &rd);
+    if(wr != 3 || rd != 4) return __LINE__;
+
+    for(k = 0; k < 100; k++) text[k] = (k % 7) ? (uint8)('a' + k % 26) : (uint8)(0x80 + k);
+    wr = encoding_convert(ENCODING_ASCII, ENCODING_UTF8, text, 100, out, 256, &rd);
+    if(wr != 100 || rd != 100) return __LINE__;
+    for(k = 0; k < 100; k++)
+    {
+        if(out[k] != ((k % 7) ? text[k] : '?')) return __LINE__*1000 + k;
+    }
+
     return 0;
 }
 
+
+#define BENCH_ENCODING_SIZE     (64 * 1024 * 1024)
+
+int bench_encoding_functions()
+{
+    puts("Starting benchmark bench_encoding_functions");
+
+    uint8 *text = (uint8 *)malloc(BENCH_ENCODING_SIZE);
+    uint8 *out = (uint8 *)malloc(BENCH_ENCODING_SIZE);
+    encoding_build_char_fun build;
+    encoding_conversion_fun conv;
+    struct timeval t1;
+    uint64 sz, i, valid, rd, n, wr;
+    uint8 chr_buf[ENCODING_MAXCHAR_LEN];
+    char_info chr = {.chr = chr_buf, .ptr = 0, .state = CHAR_STATE_INCOMPLETE}, dst;
+    static const char *words[] = {"select ", "from ", "where ", "\xD0\xA4\xD1\x8B\xD0\xB2 ", "value ", "\xE2\x82\xAC", "\xF0\x9F\x98\x80"};
+
+    if(NULL == text || NULL == out) return __LINE__;
+
+    encoding_init();
+    build = encoding_get_build_char_fun(ENCODING_UTF8);
+    conv = encoding_get_conversion_fun(ENCODING_UTF8, ENCODING_ASCII);
+
+    // mostly ASCII text with cyrillic words and, rarely, characters of 3 and 4 bytes
+    srand(1);
+    for(sz = 0; sz + 16 < BENCH_ENCODING_SIZE; )
+    {
+        const char *w = words[(rand() % 16 == 0) ? 5 + rand() % 2 : rand() % 5];
+        memcpy(text + sz, w, strlen(w));
+        sz += strlen(w);
+    }
+
+    for(uint32 pass = 0; pass < 2; pass++)
+    {
+        gettimeofday(&t1, NULL);
+        for(i = 0, n = 0, wr = 0; i < sz; i++)
+        {
+            build(&chr, text[i]);
+            if(chr.state == CHAR_STATE_INVALID) return __LINE__;
+            if(chr.state == CHAR_STATE_COMPLETE)
+            {
+                dst.chr = out + wr;
+                conv((const_char_info *)&chr, &dst);
+                wr += dst.length;
+                n++;
+                chr.ptr = 0;
+                chr.state = CHAR_STATE_INCOMPLETE;
+            }
+        }
+        printf("Benchmarking %s text: per character validation, count and conversion %ld ms",
+                pass ? "cyrillic" : "mixed", bench_elapsed_ms(&t1));
+
+        gettimeofday(&t1, NULL);
+        if(encoding_validate(ENCODING_UTF8, text, sz, &valid) != CHAR_STATE_COMPLETE || valid != sz) return __LINE__;
+        printf(", validate %ld ms", bench_elapsed_ms(&t1));
+
+        gettimeofday(&t1, NULL);
+        if(encoding_count(ENCODING_UTF8, text, sz) != n) return __LINE__;
+        printf(", count %ld ms", bench_elapsed_ms(&t1));
+
+        gettimeofday(&t1, NULL);
+        if(encoding_convert(ENCODING_UTF8, ENCODING_ASCII, text, sz, out, BENCH_ENCODING_SIZE, &rd) != wr || rd != sz) return __LINE__;
+        printf(", convert %ld ms.\n", bench_elapsed_ms(&t1));
+
+        // text of 2 byte characters only
+        for(sz = 0; sz + 2 <= BENCH_ENCODING_SIZE; sz += 2)
+        {
+            text[sz] = 0xD0u;
+            text[sz + 1] = 0x90u + sz % 32;
+        }
+    }
+
+    free(text);
+    free(out);
+    return 0;
+}
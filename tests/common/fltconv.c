@@ -0,0 +1,273 @@
+#include "tests.h"
+#include "common/fltconv.h"
+#include "common/decimal.h"
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+
+#define TEST_FLTCONV_VALUES     (200000)
+#define BENCH_FLTCONV_VALUES    (1000000)
+
+
+// return random 64 bits
+uint64 test_fltconv_rand64()
+{
+    return (uint64)rand() << 62 ^ (uint64)rand() << 31 ^ (uint64)rand();
+}
+
+// return number of significant digits of formatted number str
+uint32 test_fltconv_sig_digits(const char *str)
+{
+    uint32 n = 0, zeroes = 0;
+    uint8 sig = 0;
+
+    for(; *str != '\0' && *str != 'e'; str++)
+    {
+        if(*str < '0' || *str > '9') continue;
+        sig |= *str != '0';
+        if(!sig) continue;
+        n++;
+        zeroes = *str == '0' ? zeroes + 1 : 0;
+    }
+
+    // trailing zeroes of integer are not significant
+    return n - zeroes;
+}
+
+// return minimal number of significant digits of %e format of v which is parsed back to v
+uint32 test_fltconv_shortest_double(float64 v)
+{
+    char str[64];
+    uint32 p;
+
+    for(p = 1; p < 17; p++)
+    {
+        snprintf(str, sizeof(str), "%.*e", p - 1, v);
+        if(strtod(str, NULL) == v) break;
+    }
+
+    return p;
+}
+
+uint32 test_fltconv_shortest_float(float32 v)
+{
+    char str[64];
+    uint32 p;
+
+    for(p = 1; p < 9; p++)
+    {
+        snprintf(str, sizeof(str), "%.*e", p - 1, v);
+        if(strtof(str, NULL) == v) break;
+    }
+
+    return p;
+}
+
+
+int test_fltconv_functions()
+{
+    puts("Starting test test_fltconv_functions");
+
+    uint8 buf[FLTCONV_DOUBLE_MAX_SZ + 1];
+    char str[1200];
+    uint32 sz, i, n;
+    uint64 u;
+    float64 fx, fy;
+    float32 gx, gy;
+    decimal d;
+
+    puts("Testing formatting");
+    const float64 dv[] = {0.0, -0.0, 1.0, -1.5, 100.0, 0.1, 0.3, 1e-4, 1e-5, 123456789012345.0, 1e15, 1.2345e-5,
+        5e-324, 1.7976931348623157e308, 2.2250738585072014e-308, 9007199254740993.0, 1e23, -2.5e-10};
+    const char *ds[] = {"0", "-0", "1", "-1.5", "100", "0.1", "0.3", "0.0001", "1e-05", "123456789012345", "1e+15", "1.2345e-05",
+        "5e-324", "1.7976931348623157e+308", "2.2250738585072014e-308", "9.007199254740992e+15", "1e+23", "-2.5e-10"};
+    for(i = 0; i < sizeof(dv) / sizeof(dv[0]); i++)
+    {
+        sz = fltconv_format_double(dv[i], buf);
+        if(sz != strlen(ds[i]) || memcmp(buf, ds[i], sz) != 0) return __LINE__;
+    }
+
+    sz = fltconv_format_double(NAN, buf);
+    if(sz != 3 || memcmp(buf, "NaN", 3) != 0) return __LINE__;
+    sz = fltconv_format_double(-INFINITY, buf);
+    if(sz != 9 || memcmp(buf, "-Infinity", 9) != 0) return __LINE__;
+    sz = fltconv_format_float(INFINITY, buf);
+    if(sz != 8 || memcmp(buf, "Infinity", 8) != 0) return __LINE__;
+
+    const float32 fv[] = {0.1f, 1.17549435e-38f, -3.4028235e38f, 16777216.0f, 1e-45f, 0.3f};
+    const char *fs[] = {"0.1", "1.1754944e-38", "-3.4028235e+38", "16777216", "1e-45", "0.3"};
+    for(i = 0; i < sizeof(fv) / sizeof(fv[0]); i++)
+    {
+        sz = fltconv_format_float(fv[i], buf);
+        if(sz != strlen(fs[i]) || memcmp(buf, fs[i], sz) != 0) return __LINE__;
+    }
+
+    puts("Testing shortest round trip");
+    srand(1);
+    for(i = 0; i < TEST_FLTCONV_VALUES; i++)
+    {
+        u = test_fltconv_rand64();
+        if(i % 4 == 0) u >>= rand() % 64;
+        memcpy(&fx, &u, sizeof(fx));
+        if(i % 4 == 1) fx = (float64)(rand() % 2000000 - 1000000) / 1000.0;
+        if(isnan(fx)) continue;
+
+        sz = fltconv_format_double(fx, buf);
+        if(sz > FLTCONV_DOUBLE_MAX_SZ) return __LINE__;
+        buf[sz] = '\0';
+        fy = strtod((const char *)buf, NULL);
+        if(memcmp(&fx, &fy, sizeof(fx)) != 0) return __LINE__;
+        if(fx != 0.0 && !isinf(fx) && test_fltconv_sig_digits((const char *)buf) > test_fltconv_shortest_double(fx)) return __LINE__;
+        if(fltconv_parse_double(buf, sz, &fy) != sz || memcmp(&fx, &fy, sizeof(fx)) != 0) return __LINE__;
+
+        memcpy(&gx, &u, sizeof(gx));
+        if(isnan(gx)) continue;
+
+        sz = fltconv_format_float(gx, buf);
+        if(sz > FLTCONV_FLOAT_MAX_SZ) return __LINE__;
+        buf[sz] = '\0';
+        gy = strtof((const char *)buf, NULL);
+        if(memcmp(&gx, &gy, sizeof(gx)) != 0) return __LINE__;
+        if(gx != 0.0f && !isinf(gx) && test_fltconv_sig_digits((const char *)buf) > test_fltconv_shortest_float(gx)) return __LINE__;
+        if(fltconv_parse_float(buf, sz, &gy) != sz || memcmp(&gx, &gy, sizeof(gx)) != 0) return __LINE__;
+    }
+
+    puts("Testing parsing");
+    const char *ps[] = {"12abc", "-0.5e", "+.25", "1e+2x", "1.e3", "-inf", "nan"};
+    const uint32 pn[] = {2, 4, 4, 4, 4, 0, 3};
+    for(i = 0; i < sizeof(ps) / sizeof(ps[0]); i++)
+    {
+        if(fltconv_parse_double((const uint8 *)ps[i], strlen(ps[i]), &fx) != pn[i]) return __LINE__;
+    }
+    if(fltconv_parse_double((const uint8 *)"", 0, &fx) != 0) return __LINE__;
+    if(fltconv_parse_double((const uint8 *)".", 1, &fx) != 0) return __LINE__;
+    if(fltconv_parse_double((const uint8 *)"-", 1, &fx) != 0) return __LINE__;
+    if(fltconv_parse_double((const uint8 *)"-Infinity", 9, &fx) != 9 || fx != -INFINITY) return __LINE__;
+    if(fltconv_parse_double((const uint8 *)"1e400", 5, &fx) != 5 || fx != INFINITY) return __LINE__;
+    if(fltconv_parse_double((const uint8 *)"-1e-400", 7, &fx) != 7 || fx != 0.0 || !signbit(fx)) return __LINE__;
+
+    // random digits, long mantissas go through the slow path
+    for(i = 0; i < TEST_FLTCONV_VALUES / 20; i++)
+    {
+        n = 0;
+        if(rand() % 2) str[n++] = '-';
+        sz = rand() % 2 ? rand() % 30 : rand() % 1000;
+        while(sz-- > 0) str[n++] = (char)('0' + rand() % 10);
+        str[n++] = '.';
+        sz = rand() % 20 + 1;
+        while(sz-- > 0) str[n++] = (char)('0' + rand() % 10);
+        n += snprintf(str + n, sizeof(str) - n, "e%d", rand() % 700 - 350);
+
+        fx = strtod(str, NULL);
+        if(fltconv_parse_double((const uint8 *)str, n, &fy) != n || memcmp(&fx, &fy, sizeof(fx)) != 0) return __LINE__;
+        gx = strtof(str, NULL);
+        if(fltconv_parse_float((const uint8 *)str, n, &gy) != n || memcmp(&gx, &gy, sizeof(gx)) != 0) return __LINE__;
+    }
+
+    // halfway between two doubles decided by the last of many digits
+    strcpy(str, "9007199254740993.");
+    memset(str + 17, '0', 1000);
+    strcpy(str + 1017, "1");
+    if(fltconv_parse_double((const uint8 *)str, 1018, &fx) != 1018 || fx != 9007199254740994.0) return __LINE__;
+    if(fltconv_parse_double((const uint8 *)str, 1017, &fx) != 1017 || fx != 9007199254740992.0) return __LINE__;
+
+    puts("Testing conversion of decimal");
+    for(i = 0; i < TEST_FLTCONV_VALUES / 20; i++)
+    {
+        decimal_from_int64((sint64)(test_fltconv_rand64() >> (rand() % 64)) * (rand() % 2 ? 1 : -1), &d);
+        d.e = (sint8)(rand() % 256 - 128);
+        if(d.n > 0 && rand() % 2)
+        {
+            // more than 19 digits
+            memmove(d.m + 5, d.m, sizeof(d.m[0]) * 5);
+            for(n = 0; n < 5; n++) d.m[n] = (sint16)(rand() % DECIMAL_BASE);
+            d.n += 5 * DECIMAL_BASE_LOG10;
+        }
+
+        sz = 0;
+        if(d.sign == DECIMAL_SIGN_NEG) str[sz++] = '-';
+        str[sz++] = '0';
+        for(n = DECIMAL_PARTS; n-- > 0; ) sz += snprintf(str + sz, sizeof(str) - sz, "%04d", d.m[n]);
+        snprintf(str + sz, sizeof(str) - sz, "e%d", d.e);
+
+        fx = strtod(str, NULL);
+        fy = decimal_to_float64(&d);
+        if(memcmp(&fx, &fy, sizeof(fx)) != 0 && !(fx == 0.0 && fy == 0.0)) return __LINE__;
+    }
+
+    if(fltconv_to_double(1, -1, 0) != 0.1) return __LINE__;
+    if(fltconv_to_double(123456789012345678UL, 290, 1) != -1.23456789012345678e307) return __LINE__;
+
+    return 0;
+}
+
+
+int bench_fltconv_functions()
+{
+    puts("Starting benchmark bench_fltconv_functions");
+
+    uint8 *out = (uint8 *)malloc(BENCH_FLTCONV_VALUES * 32);
+    float64 *num = (float64 *)malloc(BENCH_FLTCONV_VALUES * sizeof(float64));
+    uint32 *len = (uint32 *)malloc(BENCH_FLTCONV_VALUES * sizeof(uint32));
+    struct timeval t1;
+    float64 v;
+    uint32 i;
+    uint64 u;
+    long ms;
+
+    if(NULL == out || NULL == num || NULL == len) return __LINE__;
+
+    srand(1);
+    for(i = 0; i < BENCH_FLTCONV_VALUES; i++)
+    {
+        // half are random bits, half are short decimals like table data
+        do
+        {
+            u = test_fltconv_rand64();
+            memcpy(num + i, &u, sizeof(u));
+        }
+        while(!isfinite(num[i]));
+        if(i % 2) num[i] = (float64)(rand() % 10000000) / 100.0;
+    }
+
+    gettimeofday(&t1, NULL);
+    for(i = 0; i < BENCH_FLTCONV_VALUES; i++)
+    {
+        len[i] = (uint32)snprintf((char *)out + i * 32, 32, "%.17g", num[i]);
+    }
+    ms = bench_elapsed_ms(&t1);
+    printf("Benchmarking double formatting: snprintf %ld ms", ms);
+
+    gettimeofday(&t1, NULL);
+    for(i = 0; i < BENCH_FLTCONV_VALUES; i++)
+    {
+        len[i] = fltconv_format_double(num[i], out + i * 32);
+    }
+    printf(", fltconv_format_double %ld ms.\n", bench_elapsed_ms(&t1));
+
+    // parse back the shortest texts
+    for(i = 0; i < BENCH_FLTCONV_VALUES; i++) out[i * 32 + len[i]] = '\0';
+
+    gettimeofday(&t1, NULL);
+    for(i = 0; i < BENCH_FLTCONV_VALUES; i++)
+    {
+        if(strtod((const char *)out + i * 32, NULL) != num[i]) return __LINE__;
+    }
+    ms = bench_elapsed_ms(&t1);
+    printf("Benchmarking double parsing: strtod %ld ms", ms);
+
+    gettimeofday(&t1, NULL);
+    for(i = 0; i < BENCH_FLTCONV_VALUES; i++)
+    {
+        if(fltconv_parse_double(out + i * 32, len[i], &v) != len[i] || v != num[i]) return __LINE__;
+    }
+    printf(", fltconv_parse_double %ld ms.\n", bench_elapsed_ms(&t1));
+
+    free(out);
+    free(num);
+    free(len);
+
+    return 0;
+}
@@ -0,0 +1,313 @@
+#include "tests.h"
+#include "common/hmap.h"
+#include "common/htable.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define TEST_HMAP_KEYS          (4096)
+#define BENCH_HMAP_KEYS         (1000000)
+#define BENCH_HMAP_KEY_SZ       (24)
+
+
+// every key gets the same hash, so all entries share one probe sequence
+uint32 test_hmap_same_hash(const void *val, uint32 len)
+{
+    (void)val; (void)len;
+    return 42;
+}
+
+
+// check that key i is in map mh with data i if present[i] is set and is absent otherwise
+// return 0 on success
+int test_hmap_check(handle mh, const uint32 *keys, const uint8 *present, uint32 n)
+{
+    const hmap_entry *e;
+    uint32 size = 0;
+
+    for(uint32 i = 0; i < n; i++)
+    {
+        e = hmap_search(mh, keys + i, sizeof(uint32));
+        if(present[i])
+        {
+            if(NULL == e || e->data != (void *)(keys + i)) return __LINE__;
+            size++;
+        }
+        else if(NULL != e)
+        {
+            return __LINE__;
+        }
+    }
+
+    if(hmap_size(mh) != size) return __LINE__;
+
+    return 0;
+}
+
+
+int test_hmap_functions()
+{
+    puts("Starting test test_hmap_functions");
+
+    uint32 *keys = (uint32 *)malloc(TEST_HMAP_KEYS * sizeof(uint32));
+    uint8 present[TEST_HMAP_KEYS];
+    void *buf = malloc(hmap_get_alloc_sz(TEST_HMAP_KEYS));
+    hmap_entry e;
+    handle mh;
+    uint32 i, k;
+    int line;
+
+    if(NULL == keys || NULL == buf) return __LINE__;
+    for(i = 0; i < TEST_HMAP_KEYS; i++) keys[i] = i * 2654435761u;
+
+
+    puts("Testing insert with growth");
+
+    // map starts from a single group and grows incrementally many times
+    if((mh = hmap_create(buf, 0, htable_strhash)) == NULL) return __LINE__;
+    memset(present, 0, sizeof(present));
+    e.keylen = sizeof(uint32);
+    e.datalen = 0;
+    for(i = 0; i < TEST_HMAP_KEYS; i++)
+    {
+        e.key = keys + i;
+        e.data = keys + i;
+        if(hmap_insert(mh, &e) != 0) return __LINE__;
+        present[i] = 1;
+
+        // keys of the table being moved and of the new one are both found
+        if(i % 97 == 0 && (line = test_hmap_check(mh, keys, present, TEST_HMAP_KEYS)) != 0) return line;
+    }
+    if((line = test_hmap_check(mh, keys, present, TEST_HMAP_KEYS)) != 0) return line;
+
+
+    puts("Testing replace and delete");
+
+    e.key = keys + 5;
+    e.data = keys + 6;
+    if(hmap_insert(mh, &e) != 0) return __LINE__;
+    if(hmap_size(mh) != TEST_HMAP_KEYS) return __LINE__;
+    if(hmap_search(mh, keys + 5, sizeof(uint32))->data != keys + 6) return __LINE__;
+    e.data = keys + 5;
+    if(hmap_insert(mh, &e) != 0) return __LINE__;
+
+    for(i = 0; i < TEST_HMAP_KEYS; i += 2)
+    {
+        if(hmap_delete(mh, keys + i, sizeof(uint32)) != 0) return __LINE__;
+        present[i] = 0;
+    }
+    if(hmap_delete(mh, keys, sizeof(uint32)) == 0) return __LINE__;
+    if((line = test_hmap_check(mh, keys, present, TEST_HMAP_KEYS)) != 0) return line;
+
+
+    puts("Testing random operations");
+
+    // inserts and deletes of a small set of keys, then of all keys, against presence flags
+    srand(1);
+    for(i = 0; i < 300000; i++)
+    {
+        k = rand() % ((i < 150000) ? 300 : TEST_HMAP_KEYS);
+        e.key = keys + k;
+        e.data = keys + k;
+        switch(rand() % 3)
+        {
+            case 0:
+                if(hmap_delete(mh, keys + k, sizeof(uint32)) != !present[k]) return __LINE__;
+                present[k] = 0;
+                break;
+            default:
+                if(hmap_insert(mh, &e) != 0) return __LINE__;
+                present[k] = 1;
+                break;
+        }
+
+        if(i % 10007 == 0 && (line = test_hmap_check(mh, keys, present, TEST_HMAP_KEYS)) != 0) return line;
+    }
+    if((line = test_hmap_check(mh, keys, present, TEST_HMAP_KEYS)) != 0) return line;
+    hmap_destroy(mh);
+
+
+    puts("Testing tombstone cleanup");
+
+    // window of 10 live keys slides over all keys, map is rehashed in place instead of growing
+    if((mh = hmap_create(buf, 0, htable_strhash)) == NULL) return __LINE__;
+    memset(present, 0, sizeof(present));
+    for(i = 0; i < 20 * TEST_HMAP_KEYS; i++)
+    {
+        k = i % TEST_HMAP_KEYS;
+        e.key = keys + k;
+        e.keylen = sizeof(uint32);
+        e.data = keys + k;
+        if(hmap_insert(mh, &e) != 0) return __LINE__;
+        present[k] = 1;
+        if(i >= 10)
+        {
+            k = (i - 10) % TEST_HMAP_KEYS;
+            if(hmap_delete(mh, keys + k, sizeof(uint32)) != 0) return __LINE__;
+            present[k] = 0;
+        }
+        if(hmap_size(mh) != ((i < 10) ? i + 1 : 10)) return __LINE__;
+    }
+    if((line = test_hmap_check(mh, keys, present, TEST_HMAP_KEYS)) != 0) return line;
+    hmap_destroy(mh);
+
+
+    puts("Testing colliding hashes and key lengths");
+
+    // keys of equal hash are told apart by contents, keys may be empty or have zero bytes
+    static const char *strs[] = {"", "a", "aa", "ab", "a\0b", "a\0c", "xxx xxx\0 123", "abc"};
+    static const uint32 lens[] = {0, 1, 2, 2, 3, 3, 12, 3};
+
+    if((mh = hmap_create(buf, 2, test_hmap_same_hash)) == NULL) return __LINE__;
+    for(k = 0; k < 3; k++)
+    {
+        for(i = 0; i < 8; i++)
+        {
+            e.key = (void *)strs[i];
+            e.keylen = lens[i];
+            e.data = (void *)(strs + i);
+            if(hmap_insert(mh, &e) != 0) return __LINE__;
+        }
+        if(hmap_size(mh) != 8) return __LINE__;
+        for(i = 0; i < 8; i++)
+        {
+            const hmap_entry *found = hmap_search(mh, strs[i], lens[i]);
+            if(NULL == found || found->data != strs + i || found->keylen != lens[i]) return __LINE__;
+        }
+        if(hmap_search(mh, "a\0d", 3) != NULL) return __LINE__;
+        for(i = k; i < 8; i += 2)
+        {
+            if(hmap_delete(mh, strs[i], lens[i]) != 0) return __LINE__;
+            if(hmap_search(mh, strs[i], lens[i]) != NULL) return __LINE__;
+        }
+    }
+    hmap_destroy(mh);
+
+    free(keys);
+    free(buf);
+
+    return 0;
+}
+
+
+// linear probing table with full key compare on every slot, as hash tables were before hmap
+typedef struct _bench_hmap_linear
+{
+    uint32          n;
+    hmap_entry      *tbl;
+} bench_hmap_linear;
+
+
+void bench_hmap_linear_add(bench_hmap_linear *t, const hmap_entry *entry)
+{
+    uint32 i = htable_strhash(entry->key, entry->keylen) % t->n;
+
+    while(NULL != t->tbl[i].key && (t->tbl[i].keylen != entry->keylen || 0 != memcmp(t->tbl[i].key, entry->key, entry->keylen)))
+    {
+        if(++i == t->n) i = 0;
+    }
+    t->tbl[i] = *entry;
+}
+
+
+const hmap_entry *bench_hmap_linear_search(const bench_hmap_linear *t, const void *key, uint32 keylen)
+{
+    uint32 i = htable_strhash(key, keylen) % t->n;
+
+    while(NULL != t->tbl[i].key)
+    {
+        if(t->tbl[i].keylen == keylen && 0 == memcmp(t->tbl[i].key, key, keylen)) return t->tbl + i;
+        if(++i == t->n) i = 0;
+    }
+
+    return NULL;
+}
+
+
+int bench_hmap_functions()
+{
+    puts("Starting benchmark bench_hmap_functions");
+
+    char *keys = (char *)malloc((uint64)BENCH_HMAP_KEYS * BENCH_HMAP_KEY_SZ);
+    uint32 *lens = (uint32 *)malloc(BENCH_HMAP_KEYS * sizeof(uint32));
+    void *buf = malloc(hmap_get_alloc_sz(BENCH_HMAP_KEYS));
+    bench_hmap_linear linear;
+    hmap_entry e;
+    handle mh;
+    uint64 found;
+    uint32 i;
+    struct timeval t1;
+
+    if(NULL == keys || NULL == lens || NULL == buf) return __LINE__;
+
+    // keys are unique, the second half of them is never inserted and is looked up as misses
+    for(i = 0; i < BENCH_HMAP_KEYS; i++)
+    {
+        lens[i] = (uint32)snprintf(keys + (uint64)i * BENCH_HMAP_KEY_SZ, BENCH_HMAP_KEY_SZ, "customer:%08x", i * 2654435761u);
+    }
+    e.datalen = 0;
+
+    // linear probing table of fixed size 2n, half full
+    linear.n = BENCH_HMAP_KEYS + 1;
+    if((linear.tbl = (hmap_entry *)calloc(linear.n, sizeof(hmap_entry))) == NULL) return __LINE__;
+
+    gettimeofday(&t1, NULL);
+    for(i = 0; i < BENCH_HMAP_KEYS / 2; i++)
+    {
+        e.key = keys + (uint64)i * BENCH_HMAP_KEY_SZ;
+        e.keylen = lens[i];
+        e.data = e.key;
+        bench_hmap_linear_add(&linear, &e);
+    }
+    printf("Benchmarking %d keys, linear probing: insert %ld ms", BENCH_HMAP_KEYS / 2, bench_elapsed_ms(&t1));
+
+    gettimeofday(&t1, NULL);
+    for(i = 0, found = 0; i < BENCH_HMAP_KEYS; i++)
+    {
+        found += (NULL != bench_hmap_linear_search(&linear, keys + (uint64)i * BENCH_HMAP_KEY_SZ, lens[i]));
+    }
+    printf(", lookup of hits and misses %ld ms.\n", bench_elapsed_ms(&t1));
+    if(found != BENCH_HMAP_KEYS / 2) return __LINE__;
+    free(linear.tbl);
+
+    for(int presized = 0; presized < 2; presized++)
+    {
+        if((mh = hmap_create(buf, presized ? BENCH_HMAP_KEYS / 2 : 0, htable_strhash)) == NULL) return __LINE__;
+
+        gettimeofday(&t1, NULL);
+        for(i = 0; i < BENCH_HMAP_KEYS / 2; i++)
+        {
+            e.key = keys + (uint64)i * BENCH_HMAP_KEY_SZ;
+            e.keylen = lens[i];
+            e.data = e.key;
+            if(hmap_insert(mh, &e) != 0) return __LINE__;
+        }
+        printf("Benchmarking %d keys, hmap %s: insert %ld ms", BENCH_HMAP_KEYS / 2, presized ? "presized" : "growing",
+               bench_elapsed_ms(&t1));
+
+        gettimeofday(&t1, NULL);
+        for(i = 0, found = 0; i < BENCH_HMAP_KEYS; i++)
+        {
+            found += (NULL != hmap_search(mh, keys + (uint64)i * BENCH_HMAP_KEY_SZ, lens[i]));
+        }
+        printf(", lookup of hits and misses %ld ms", bench_elapsed_ms(&t1));
+        if(found != BENCH_HMAP_KEYS / 2) return __LINE__;
+
+        gettimeofday(&t1, NULL);
+        for(i = 0; i < BENCH_HMAP_KEYS / 2; i++)
+        {
+            if(hmap_delete(mh, keys + (uint64)i * BENCH_HMAP_KEY_SZ, lens[i]) != 0) return __LINE__;
+        }
+        printf(", delete %ld ms.\n", bench_elapsed_ms(&t1));
+        if(hmap_size(mh) != 0) return __LINE__;
+
+        hmap_destroy(mh);
+    }
+
+    free(keys);
+    free(lens);
+    free(buf);
+
+    return 0;
+}
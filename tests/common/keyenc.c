@@ -0,0 +1,295 @@
+#include "tests.h"
+#include "common/keyenc.h"
+#include "common/error.h"
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+
+#define TEST_KEYENC_VALUES      (20000)
+
+
+// return sign of memcmp of keys a and b of sizes sa and sb, prefix is less than longer key
+sint8 test_keyenc_cmp(const uint8 *a, uint32 sa, const uint8 *b, uint32 sb)
+{
+    int cmp = memcmp(a, b, sa < sb ? sa : sb);
+
+    if(cmp != 0) return (cmp > 0) - (cmp < 0);
+    return (sa > sb) - (sa < sb);
+}
+
+
+// random decimal of up to DECIMAL_POSITIONS digits with exponent close to 0, so equal values of different scale occur
+void test_keyenc_random_decimal(decimal *d)
+{
+    sint128 v = 0;
+    sint32 i, digits = rand() % (DECIMAL_INT128_DIGITS + 1);
+
+    for(i = 0; i < digits; i++) v = v * 10 + rand() % 10;
+    if(rand() % 4 == 0) v = v - v % 100;
+    if(rand() % 2) v = -v;
+
+    decimal_from_int128(v, (sint8)(rand() % 9 - 4), d);
+
+    // extend mantissa up to DECIMAL_POSITIONS digits with trailing zeroes
+    if(d->n > 0 && d->n <= DECIMAL_POSITIONS - DECIMAL_BASE_LOG10 && rand() % 4 == 0 && d->e > DECIMAL_MIN_EXPONENT + DECIMAL_BASE_LOG10)
+    {
+        memmove(d->m + 1, d->m, sizeof(d->m) - sizeof(d->m[0]));
+        d->m[0] = 0;
+        d->n += DECIMAL_BASE_LOG10;
+        d->e -= DECIMAL_BASE_LOG10;
+    }
+}
+
+
+int test_keyenc_functions()
+{
+    puts("Starting test test_keyenc_functions");
+
+    uint8 ka[KEYENC_DECIMAL_MAX_SZ], kb[KEYENC_DECIMAL_MAX_SZ];
+    uint32 sa, sb, i;
+    sint64 x, y;
+    float64 fx, fy;
+    float32 gx, gy;
+    sint32 ix, iy;
+    sint16 hx, hy, tz;
+    uint64 ux, uy;
+    decimal da, db, dc;
+    sint16 cmp;
+    sint8 res;
+    sint128 v;
+
+
+    puts("Testing integer encoding");
+
+    srand(1);
+    for(i = 0; i < TEST_KEYENC_VALUES; i++)
+    {
+        ix = (sint32)((uint32)rand() << 1) ^ rand();
+        iy = (i % 8 == 0) ? ix : (sint32)rand() - RAND_MAX / 2;
+        hx = (sint16)ix;
+        hy = (sint16)iy;
+
+        if(keyenc_encode_integer(ix, ka) != KEYENC_INTEGER_SZ) return __LINE__;
+        if(keyenc_encode_integer(iy, kb) != KEYENC_INTEGER_SZ) return __LINE__;
+        if(test_keyenc_cmp(ka, KEYENC_INTEGER_SZ, kb, KEYENC_INTEGER_SZ) != (ix > iy) - (ix < iy)) return __LINE__;
+        if(keyenc_decode_integer(ka, &iy) != KEYENC_INTEGER_SZ || iy != ix) return __LINE__;
+
+        if(keyenc_encode_smallint(hx, ka) != KEYENC_SMALLINT_SZ) return __LINE__;
+        if(keyenc_encode_smallint(hy, kb) != KEYENC_SMALLINT_SZ) return __LINE__;
+        if(test_keyenc_cmp(ka, KEYENC_SMALLINT_SZ, kb, KEYENC_SMALLINT_SZ) != (hx > hy) - (hx < hy)) return __LINE__;
+        if(keyenc_decode_smallint(ka, &hy) != KEYENC_SMALLINT_SZ || hy != hx) return __LINE__;
+    }
+
+    keyenc_encode_integer(-2147483647 - 1, ka);
+    keyenc_encode_integer(2147483647, kb);
+    if(ka[0] != 0 || kb[0] != 0xFF || test_keyenc_cmp(ka, 4, kb, 4) >= 0) return __LINE__;
+
+
+    puts("Testing floating point encoding");
+
+    for(i = 0; i < TEST_KEYENC_VALUES; i++)
+    {
+        fx = ldexp((float64)rand() / RAND_MAX - 0.5, rand() % 200 - 100);
+        fy = (i % 8 == 0) ? fx : ldexp((float64)rand() / RAND_MAX - 0.5, rand() % 200 - 100);
+        gx = (float32)fx;
+        gy = (float32)fy;
+
+        keyenc_encode_double(fx, ka);
+        keyenc_encode_double(fy, kb);
+        if(test_keyenc_cmp(ka, KEYENC_DOUBLE_SZ, kb, KEYENC_DOUBLE_SZ) != (fx > fy) - (fx < fy)) return __LINE__;
+        if(keyenc_decode_double(ka, &fy) != KEYENC_DOUBLE_SZ || fy != fx) return __LINE__;
+
+        keyenc_encode_float(gx, ka);
+        keyenc_encode_float(gy, kb);
+        if(test_keyenc_cmp(ka, KEYENC_FLOAT_SZ, kb, KEYENC_FLOAT_SZ) != (gx > gy) - (gx < gy)) return __LINE__;
+        if(keyenc_decode_float(ka, &gy) != KEYENC_FLOAT_SZ || gy != gx) return __LINE__;
+    }
+
+    // -0 is 0
+    keyenc_encode_double(-0.0, ka);
+    keyenc_encode_double(0.0, kb);
+    if(memcmp(ka, kb, KEYENC_DOUBLE_SZ) != 0) return __LINE__;
+    keyenc_encode_float(-0.0f, ka);
+    keyenc_encode_float(0.0f, kb);
+    if(memcmp(ka, kb, KEYENC_FLOAT_SZ) != 0) return __LINE__;
+
+    // -inf < -1 < 1 < inf < NaN, every NaN is the same
+    keyenc_encode_double(-INFINITY, ka);
+    keyenc_encode_double(-1.0, kb);
+    if(memcmp(ka, kb, KEYENC_DOUBLE_SZ) >= 0) return __LINE__;
+    keyenc_encode_double(1.0, ka);
+    keyenc_encode_double(INFINITY, kb);
+    if(memcmp(ka, kb, KEYENC_DOUBLE_SZ) >= 0) return __LINE__;
+    keyenc_encode_double(NAN, ka);
+    if(memcmp(ka, kb, KEYENC_DOUBLE_SZ) <= 0) return __LINE__;
+    keyenc_encode_double(-NAN, kb);
+    if(memcmp(ka, kb, KEYENC_DOUBLE_SZ) != 0) return __LINE__;
+    keyenc_decode_double(ka, &fx);
+    if(fx == fx) return __LINE__;
+    keyenc_encode_float(NAN, ka);
+    keyenc_encode_float(INFINITY, kb);
+    if(memcmp(ka, kb, KEYENC_FLOAT_SZ) <= 0) return __LINE__;
+
+
+    puts("Testing date and time encoding");
+
+    for(i = 0; i < TEST_KEYENC_VALUES; i++)
+    {
+        ux = ((uint64)rand() << 31 | rand()) % (10000ULL * 366 * 86400 * 1000000);
+        uy = (i % 8 == 0) ? ux : ((uint64)rand() << 31 | rand()) % (10000ULL * 366 * 86400 * 1000000);
+
+        keyenc_encode_timestamp(ux, ka);
+        keyenc_encode_timestamp(uy, kb);
+        if(test_keyenc_cmp(ka, KEYENC_TIMESTAMP_SZ, kb, KEYENC_TIMESTAMP_SZ) != (ux > uy) - (ux < uy)) return __LINE__;
+        if(keyenc_decode_timestamp(ka, &uy) != KEYENC_TIMESTAMP_SZ || uy != ux) return __LINE__;
+
+        keyenc_encode_date(ux / 1000000, ka);
+        if(keyenc_decode_date(ka, &uy) != KEYENC_DATE_SZ || uy != ux / 1000000) return __LINE__;
+
+        // the same instant in different time zones has the same key
+        tz = (sint16)(rand() % 1681 - 840);
+        keyenc_encode_timestamp_with_tz(ux, 0, ka);
+        keyenc_encode_timestamp_with_tz(ux + (sint64)tz * 60 * 1000000, tz, kb);
+        if(memcmp(ka, kb, KEYENC_TIMESTAMP_TZ_SZ) != 0) return __LINE__;
+        if(keyenc_decode_timestamp_with_tz(kb, &uy, &tz) != KEYENC_TIMESTAMP_TZ_SZ || uy != ux || tz != 0) return __LINE__;
+        keyenc_encode_timestamp_with_tz(ux, 60, kb);
+        if(memcmp(ka, kb, KEYENC_TIMESTAMP_TZ_SZ) <= 0 && ux >= 3600000000ULL) return __LINE__;
+    }
+
+    // 12:00 +02:00 is before 11:30 +01:00
+    keyenc_encode_timestamp_with_tz(12ULL * 3600 * 1000000, 120, ka);
+    keyenc_encode_timestamp_with_tz(11ULL * 3600 * 1000000 + 1800000000ULL, 60, kb);
+    if(memcmp(ka, kb, KEYENC_TIMESTAMP_TZ_SZ) >= 0) return __LINE__;
+
+
+    puts("Testing decimal encoding");
+
+    for(i = 0; i < TEST_KEYENC_VALUES * 5; i++)
+    {
+        test_keyenc_random_decimal(&da);
+        test_keyenc_random_decimal(&db);
+        if(i % 8 == 0)
+        {
+            // the same value with other scale
+            db = da;
+            if(da.n < DECIMAL_INT128_DIGITS && da.e > DECIMAL_MIN_EXPONENT && decimal_to_int128(&da, &v) == 0)
+            {
+                decimal_from_int128(v * 10, (sint8)(da.e - 1), &db);
+            }
+        }
+
+        sa = keyenc_encode_decimal(&da, ka);
+        sb = keyenc_encode_decimal(&db, kb);
+        if(sa > KEYENC_DECIMAL_MAX_SZ || sb > KEYENC_DECIMAL_MAX_SZ) return __LINE__;
+
+        cmp = decimal_cmp(&da, &db);
+        if(test_keyenc_cmp(ka, sa, kb, sb) != (cmp > 0) - (cmp < 0)) return __LINE__;
+
+        if(keyenc_decode_decimal(ka, sa, &db) != sa) return __LINE__;
+        if(decimal_cmp(&da, &db) != 0) return __LINE__;
+        if(db.n > 0 && db.m[0] % 10 == 0) return __LINE__;
+    }
+
+    // mantissa length counting leading zeroes doesn't change the key
+    decimal_from_int64(-5, &da); da.e = -1;
+    db = da; db.n = 2;
+    sa = keyenc_encode_decimal(&da, ka);
+    sb = keyenc_encode_decimal(&db, kb);
+    if(sa != sb || memcmp(ka, kb, sa) != 0) return __LINE__;
+    if(keyenc_decode_decimal(kb, sb, &db) != sb || decimal_cmp(&da, &db) != 0) return __LINE__;
+    db.n = 3; db.m[0] = 0;
+    decimal_from_int64(0, &dc);
+    if(keyenc_encode_decimal(&db, kb) != 1 || keyenc_encode_decimal(&dc, ka) != 1 || ka[0] != kb[0]) return __LINE__;
+
+    // results of arithmetic
+    for(i = 0; i < TEST_KEYENC_VALUES * 5; i++)
+    {
+        test_keyenc_random_decimal(&da);
+        test_keyenc_random_decimal(&db);
+        switch(i % 4)
+        {
+            case 0: res = decimal_add(&da, &db, &dc); break;
+            case 1: res = decimal_sub(&da, &db, &dc); break;
+            case 2: res = decimal_mul(&da, &db, &dc); break;
+            default: res = decimal_div(&da, &db, &dc); break;
+        }
+        if(res != 0) continue;
+
+        sa = keyenc_encode_decimal(&dc, ka);
+        if(sa > KEYENC_DECIMAL_MAX_SZ) return __LINE__;
+        if(keyenc_decode_decimal(ka, sa, &db) != sa) return __LINE__;
+        if(decimal_cmp(&dc, &db) != 0) return __LINE__;
+
+        // decoded value is normalized and must have the same key
+        sb = keyenc_encode_decimal(&db, kb);
+        if(sa != sb || memcmp(ka, kb, sa) != 0) return __LINE__;
+
+        sb = keyenc_encode_decimal(&da, kb);
+        cmp = decimal_cmp(&dc, &da);
+        if(test_keyenc_cmp(ka, sa, kb, sb) != (cmp > 0) - (cmp < 0)) return __LINE__;
+    }
+
+    // trailing zeroes at the exponent limits: 10e127 can't be normalized to 1e128, 10e-128 is 1e-127
+    for(i = 0; i < 8; i++)
+    {
+        decimal_from_int64((i & 1) ? -10 : 10, &da);
+        if(i & 2) decimal_from_int64((i & 1) ? -1230000 : 1230000, &da);
+        da.e = (i & 4) ? DECIMAL_MIN_EXPONENT : DECIMAL_MAX_EXPONENT;
+        sa = keyenc_encode_decimal(&da, ka);
+        if(keyenc_decode_decimal(ka, sa, &db) != sa) return __LINE__;
+        if(decimal_cmp(&da, &db) != 0 || db.sign != da.sign) return __LINE__;
+        if(db.e < DECIMAL_MIN_EXPONENT || db.e > DECIMAL_MAX_EXPONENT) return __LINE__;
+        if((i & 4) && db.m[0] % 10 == 0) return __LINE__;
+        sb = keyenc_encode_decimal(&db, kb);
+        if(sa != sb || memcmp(ka, kb, sa) != 0) return __LINE__;
+    }
+
+    // 1.50 = 1.5 < 1.51 < 15, -0.5 < -0.05 < 0
+    decimal_from_int64(150, &da); da.e = -2;
+    decimal_from_int64(15, &db); db.e = -1;
+    sa = keyenc_encode_decimal(&da, ka);
+    sb = keyenc_encode_decimal(&db, kb);
+    if(sa != 5 || sa != sb || memcmp(ka, kb, sa) != 0) return __LINE__;
+    decimal_from_int64(151, &db); db.e = -2;
+    sb = keyenc_encode_decimal(&db, kb);
+    if(test_keyenc_cmp(ka, sa, kb, sb) >= 0) return __LINE__;
+    decimal_from_int64(15, &da);
+    sa = keyenc_encode_decimal(&da, ka);
+    if(test_keyenc_cmp(kb, sb, ka, sa) >= 0) return __LINE__;
+
+    decimal_from_int64(-5, &da); da.e = -1;
+    decimal_from_int64(-5, &db); db.e = -2;
+    sa = keyenc_encode_decimal(&da, ka);
+    sb = keyenc_encode_decimal(&db, kb);
+    if(test_keyenc_cmp(ka, sa, kb, sb) >= 0) return __LINE__;
+    decimal_from_int64(0, &da);
+    sa = keyenc_encode_decimal(&da, ka);
+    if(sa != 1 || test_keyenc_cmp(kb, sb, ka, sa) >= 0) return __LINE__;
+    if(keyenc_decode_decimal(ka, sa, &db) != 1 || db.n != 0) return __LINE__;
+
+    // extreme exponents
+    x = 1;
+    for(y = -1; y <= 1; y += 2)
+    {
+        decimal_from_int64(x * y, &da); da.e = DECIMAL_MIN_EXPONENT;
+        sa = keyenc_encode_decimal(&da, ka);
+        if(keyenc_decode_decimal(ka, sa, &db) != sa || decimal_cmp(&da, &db) != 0) return __LINE__;
+        decimal_from_int64(x * y, &da); da.e = DECIMAL_MAX_EXPONENT;
+        sa = keyenc_encode_decimal(&da, ka);
+        if(keyenc_decode_decimal(ka, sa, &db) != sa || decimal_cmp(&da, &db) != 0) return __LINE__;
+    }
+
+    // malformed keys
+    decimal_from_int64(-12345, &da);
+    sa = keyenc_encode_decimal(&da, ka);
+    error_set(ERROR_NO_ERROR);
+    if(keyenc_decode_decimal(ka, sa - 1, &db) != 0) return __LINE__;
+    if(error_get() != ERROR_INVALID_DECIMAL_FORMAT) return __LINE__;
+    ka[0] = 0x7F;
+    if(keyenc_decode_decimal(ka, sa, &db) != 0) return __LINE__;
+    if(keyenc_decode_decimal(ka, 0, &db) != 0) return __LINE__;
+
+    return 0;
+}
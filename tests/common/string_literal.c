@@ -127,5 +127,71 @@ int test_string_literal_functions()
     if(0 != string_literal_byte_compare(strlit2, strlit, &ret)) return __LINE__;
     if(ret != 1) return __LINE__;
 
+
+    // long literals in memory and spilled to file
+    uint64 long_len = 300000, i, pos;
+    uint8 *long_buf = (uint8 *)malloc(long_len);
+    if(NULL == long_buf) return __LINE__;
+    for(i = 0; i < long_len; i++) long_buf[i] = (uint8)(i * 7 + i / 5000);
+
+    for(uint64 mem_sz = 0; mem_sz <= STRING_LITERAL_DEFAULT_MEM_SZ; mem_sz += STRING_LITERAL_DEFAULT_MEM_SZ / 8)
+    {
+        string_literal_set_spill(mem_sz % STRING_LITERAL_DEFAULT_MEM_SZ, NULL);
+
+        // appended in small pieces, as by lexer
+        if(0 != string_literal_truncate(strlit)) return __LINE__;
+        for(i = 0; i < long_len; i += 3)
+        {
+            if(0 != string_literal_append_char(strlit, long_buf + i, (long_len - i < 3) ? long_len - i : 3)) return __LINE__;
+        }
+        if(0 != string_literal_byte_length(strlit, &sz)) return __LINE__;
+        if(sz != long_len) return __LINE__;
+
+        // streaming read
+        for(pos = 0; pos < long_len; pos += sz)
+        {
+            sz = 1000;
+            if(0 != string_literal_read_at(strlit, pos, buf, &sz)) return __LINE__;
+            if(sz != ((long_len - pos < 1000) ? long_len - pos : 1000)) return __LINE__;
+            if(memcmp(buf, long_buf + pos, sz)) return __LINE__;
+        }
+        sz = 10;
+        if(0 != string_literal_read_at(strlit, long_len, buf, &sz)) return __LINE__;
+        if(sz != 0) return __LINE__;
+        sz = 100;
+        if(0 != string_literal_read_at(strlit, 5000, buf, &sz)) return __LINE__;
+        if(sz != 100 || memcmp(buf, long_buf + 5000, sz)) return __LINE__;
+
+        // move keeps data, source is empty
+        if(0 != string_literal_move(strlit, strlit2)) return __LINE__;
+        if(0 != string_literal_byte_length(strlit, &sz)) return __LINE__;
+        if(sz != 0) return __LINE__;
+        sz = 1000;
+        if(0 != string_literal_read_at(strlit2, long_len - 1000, buf, &sz)) return __LINE__;
+        if(sz != 1000 || memcmp(buf, long_buf + long_len - 1000, sz)) return __LINE__;
+
+        // compare with copy appended at once, prefix and changed last byte
+        if(0 != string_literal_append_char(strlit, long_buf, long_len)) return __LINE__;
+        if(0 != string_literal_byte_compare(strlit, strlit2, &ret)) return __LINE__;
+        if(ret != 0) return __LINE__;
+
+        if(0 != string_literal_truncate(strlit)) return __LINE__;
+        if(0 != string_literal_append_char(strlit, long_buf, long_len - 1)) return __LINE__;
+        if(0 != string_literal_byte_compare(strlit, strlit2, &ret)) return __LINE__;
+        if(ret != -1) return __LINE__;
+
+        buf[0] = long_buf[long_len - 1] + 1;
+        if(0 != string_literal_append_char(strlit, buf, 1)) return __LINE__;
+        if(0 != string_literal_byte_compare(strlit, strlit2, &ret)) return __LINE__;
+        if(ret != 1) return __LINE__;
+        if(0 != string_literal_byte_compare(strlit2, strlit, &ret)) return __LINE__;
+        if(ret != -1) return __LINE__;
+    }
+
+    string_literal_set_spill(STRING_LITERAL_DEFAULT_MEM_SZ, NULL);
+    string_literal_destroy(strlit);
+    string_literal_destroy(strlit2);
+    free(long_buf);
+
     return 0;
 }
@@ -0,0 +1,333 @@
+#include "tests.h"
+#include "common/strmatch.h"
+#include "common/string_literal.h"
+#include "common/error.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+
+#define BENCH_STRMATCH_ROWS     (1000000)
+#define BENCH_STRMATCH_MAX_SZ   (96)
+
+
+// reference LIKE matcher: backtracking over pattern of psz bytes and str of sz bytes, escape is a single byte or 0,
+// _ takes one UTF-8 character
+uint8 test_strmatch_naive(const uint8 *pattern, uint64 psz, const uint8 *str, uint64 sz, uint8 escape)
+{
+    uint64 i;
+
+    while(psz > 0)
+    {
+        if(escape != 0 && pattern[0] == escape && psz > 1)
+        {
+            if(0 == sz || str[0] != pattern[1]) return 0;
+            pattern += 2; psz -= 2;
+            str++; sz--;
+        }
+        else if(pattern[0] == '%')
+        {
+            for(i = 0; i <= sz; i++)
+            {
+                if(test_strmatch_naive(pattern + 1, psz - 1, str + i, sz - i, escape)) return 1;
+            }
+            return 0;
+        }
+        else if(pattern[0] == '_')
+        {
+            if(0 == sz) return 0;
+            for(i = 1; i < sz && (str[i] & 0xC0) == 0x80; i++);
+            pattern++; psz--;
+            str += i; sz -= i;
+        }
+        else
+        {
+            if(0 == sz || str[0] != pattern[0]) return 0;
+            pattern++; psz--;
+            str++; sz--;
+        }
+    }
+
+    return 0 == sz;
+}
+
+
+// compile null-terminated pattern with escape, check its kind and match of null-terminated str
+// return 0 on success
+int test_strmatch_check(const char *pattern, const char *escape, strmatch_kind kind, const char *str, uint8 expected)
+{
+    static uint8 buf[65536];
+    handle mh;
+
+    if(strmatch_get_alloc_sz(strlen(pattern)) > sizeof(buf)) return __LINE__;
+    mh = strmatch_compile(buf, (const uint8 *)pattern, strlen(pattern), (const uint8 *)escape, NULL == escape ? 0 : strlen(escape));
+    if(NULL == mh) return __LINE__;
+    if(strmatch_get_kind(mh) != kind) return __LINE__;
+    if(strmatch_match(mh, (const uint8 *)str, strlen(str)) != expected) return __LINE__;
+
+    return 0;
+}
+
+
+// random bytes of alphabet chars
+void test_strmatch_random(uint8 *str, uint64 sz, const char *chars)
+{
+    uint64 n = strlen(chars);
+
+    for(uint64 i = 0; i < sz; i++) str[i] = (uint8)chars[rand() % n];
+}
+
+
+int test_strmatch_functions()
+{
+    uint8 *buf = (uint8 *)malloc(strmatch_get_alloc_sz(16384));
+    uint8 pattern[256], str[512], res;
+    uint64 psz, sz, i, j, k;
+    handle mh, sl, pl;
+    int line;
+
+    puts("Starting test test_strmatch_functions");
+
+    if(NULL == buf) return __LINE__;
+
+
+    puts("Testing kernel choice");
+
+    static const struct
+    {
+        const char      *pattern;
+        const char      *escape;
+        strmatch_kind   kind;
+        const char      *str;
+        uint8           expected;
+    } cases[] = {
+        {"abc", NULL, STRMATCH_KIND_EXACT, "abc", 1},
+        {"abc", NULL, STRMATCH_KIND_EXACT, "abcd", 0},
+        {"", NULL, STRMATCH_KIND_EXACT, "", 1},
+        {"", NULL, STRMATCH_KIND_EXACT, "a", 0},
+        {"abc%", NULL, STRMATCH_KIND_PREFIX, "abcdef", 1},
+        {"abc%%", NULL, STRMATCH_KIND_PREFIX, "ab", 0},
+        {"%def", NULL, STRMATCH_KIND_SUFFIX, "abcdef", 1},
+        {"%def", NULL, STRMATCH_KIND_SUFFIX, "defa", 0},
+        {"%cd%", NULL, STRMATCH_KIND_CONTAINS, "abcdef", 1},
+        {"%%cd%", NULL, STRMATCH_KIND_CONTAINS, "abdcef", 0},
+        {"%", NULL, STRMATCH_KIND_ANY, "", 1},
+        {"%%", NULL, STRMATCH_KIND_ANY, "abc", 1},
+        {"a_c", NULL, STRMATCH_KIND_GENERAL, "abc", 1},
+        {"a_c", NULL, STRMATCH_KIND_GENERAL, "ac", 0},
+        {"a_c", NULL, STRMATCH_KIND_GENERAL, "a\xC3\xA9" "c", 1},
+        {"a_c", NULL, STRMATCH_KIND_GENERAL, "a\xE2\x82\xAC" "c", 1},
+        {"a__c", NULL, STRMATCH_KIND_GENERAL, "a\xE2\x82\xAC" "c", 0},
+        {"a%b%c", NULL, STRMATCH_KIND_SEGMENTS, "axxbyyc", 1},
+        {"a%b%c", NULL, STRMATCH_KIND_SEGMENTS, "axxcyyb", 0},
+        {"%a%b%", NULL, STRMATCH_KIND_SEGMENTS, "xxaxxbxx", 1},
+        {"%a%b%", NULL, STRMATCH_KIND_SEGMENTS, "xxbxxaxx", 0},
+        {"ab%bc", NULL, STRMATCH_KIND_SEGMENTS, "abc", 0},
+        {"ab%%bc", NULL, STRMATCH_KIND_SEGMENTS, "abbc", 1},
+        {"a%a", NULL, STRMATCH_KIND_SEGMENTS, "a", 0},
+        {"%ab%ab%", NULL, STRMATCH_KIND_SEGMENTS, "xabx", 0},
+        {"%ab%ab", NULL, STRMATCH_KIND_SEGMENTS, "abab", 1},
+        {"a!%%!%b", "!", STRMATCH_KIND_SEGMENTS, "a%x%b", 1},
+        {"a!%%!%b", "!", STRMATCH_KIND_SEGMENTS, "ax%b", 0},
+        {"%ab_", NULL, STRMATCH_KIND_GENERAL, "aab" "\xC3\xA9", 1},
+        {"_%", NULL, STRMATCH_KIND_GENERAL, "", 0},
+        {"100!%", "!", STRMATCH_KIND_EXACT, "100%", 1},
+        {"100!%", "!", STRMATCH_KIND_EXACT, "1000", 0},
+        {"%!_x%", "!", STRMATCH_KIND_CONTAINS, "a_xb", 1},
+        {"%!_x%", "!", STRMATCH_KIND_CONTAINS, "abxb", 0},
+        {"a!!%", "!", STRMATCH_KIND_PREFIX, "a!b", 1},
+        {"a%%", "%", STRMATCH_KIND_EXACT, "a%", 1},
+        {"\xC2\xA7_%", "\xC2\xA7", STRMATCH_KIND_PREFIX, "_abc", 1},
+    };
+
+    for(i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        if((line = test_strmatch_check(cases[i].pattern, cases[i].escape, cases[i].kind, cases[i].str, cases[i].expected)) != 0) return line;
+    }
+
+
+    puts("Testing invalid escape");
+
+    if(strmatch_compile(buf, (const uint8 *)"ab!c", 4, (const uint8 *)"!", 1) != NULL) return __LINE__;
+    if(error_get() != ERROR_INVALID_ESCAPE) return __LINE__;
+    if(strmatch_compile(buf, (const uint8 *)"ab!", 3, (const uint8 *)"!", 1) != NULL) return __LINE__;
+    if(error_get() != ERROR_INVALID_ESCAPE) return __LINE__;
+    if(strmatch_compile(buf, (const uint8 *)"ab", 2, (const uint8 *)"!!", 2) != NULL) return __LINE__;
+    if(error_get() != ERROR_INVALID_ESCAPE) return __LINE__;
+
+
+    puts("Testing random patterns against reference matcher");
+
+    srand(1);
+    for(i = 0; i < 200000; i++)
+    {
+        if(i % 10 == 0)
+        {
+            // patterns up to 150 bytes take several words of NFA state, string is the pattern with % and _ replaced
+            // by random characters and one byte changed in half of the cases; two % keep reference matcher fast,
+            // patterns without _ are matched by segments
+            psz = 64 + rand() % 87;
+            test_strmatch_random(pattern, psz, i % 20 ? "aab_" : "aab");
+            pattern[rand() % psz] = '%';
+            pattern[rand() % psz] = '%';
+            for(j = 0, sz = 0; j < psz; j++)
+            {
+                switch(pattern[j])
+                {
+                    case '%':
+                        k = rand() % 4;
+                        test_strmatch_random(str + sz, k, "ab");
+                        sz += k;
+                        break;
+                    case '_':
+                        if(rand() % 2)
+                        {
+                            str[sz++] = 0xC3;
+                            str[sz++] = 0xA9;
+                        }
+                        else
+                        {
+                            str[sz++] = 'b';
+                        }
+                        break;
+                    default:
+                        str[sz++] = pattern[j];
+                        break;
+                }
+            }
+            if(rand() % 2) str[rand() % sz] ^= 1;
+        }
+        else
+        {
+            psz = rand() % 9;
+            sz = rand() % 12;
+            test_strmatch_random(pattern, psz, (i % 3 == 0) ? "ab%_" : "ab%_!");
+            test_strmatch_random(str, sz, "ab!_%");
+
+            // escape is followed by one of !, _ or % in valid patterns
+            for(j = 0; j < psz; j++)
+            {
+                if(pattern[j] != '!') continue;
+                if(j + 1 < psz) pattern[++j] = "!_%"[rand() % 3];
+                else pattern[j] = 'a';
+            }
+        }
+
+        mh = strmatch_compile(buf, pattern, psz, (const uint8 *)"!", 1);
+        if(NULL == mh) return __LINE__;
+        if(strmatch_match(mh, str, sz) != test_strmatch_naive(pattern, psz, str, sz, '!')) return __LINE__;
+    }
+
+
+    puts("Testing long string literals");
+
+    sl = string_literal_create(malloc(string_literal_alloc_sz()));
+    pl = string_literal_create(malloc(string_literal_alloc_sz()));
+    if(NULL == sl || NULL == pl) return __LINE__;
+
+    // 20000 bytes of "0123456789" with "needle" in the middle
+    for(i = 0; i < 1000; i++)
+    {
+        if(string_literal_append_char(sl, (const uint8 *)(i == 500 ? "needle" : "0123456789"), i == 500 ? 6 : 10) != 0) return __LINE__;
+        if(string_literal_append_char(sl, (const uint8 *)"9876543210", 10) != 0) return __LINE__;
+    }
+
+    static const struct
+    {
+        const char  *pattern;
+        uint8       expected;
+    } long_cases[] = {
+        {"0123%", 1}, {"1%", 0}, {"%3210", 1}, {"%3211", 0}, {"%needle%", 1}, {"%neetle%", 0},
+        {"%ne_dle%", 1}, {"0%need%3210", 1}, {"0%need%3211", 0}, {"%", 1}, {"0123456789", 0}
+    };
+
+    for(i = 0; i < sizeof(long_cases) / sizeof(long_cases[0]); i++)
+    {
+        if(string_literal_truncate(pl) != 0) return __LINE__;
+        if(string_literal_append_char(pl, (const uint8 *)long_cases[i].pattern, (uint32)strlen(long_cases[i].pattern)) != 0) return __LINE__;
+        if((mh = strmatch_compile_literal(buf, pl, NULL)) == NULL) return __LINE__;
+        if(strmatch_match_literal(mh, sl, &res) != 0 || res != long_cases[i].expected) return __LINE__;
+    }
+
+    // literal of 3000 bytes doesn't fit sliding window, pattern with _ takes 47 words of NFA state
+    for(j = 0; j < 4; j++)
+    {
+        if(string_literal_truncate(pl) != 0) return __LINE__;
+        if(string_literal_append_char(pl, (const uint8 *)"%", 1) != 0) return __LINE__;
+        for(i = 0; i < 150; i++)
+        {
+            if(string_literal_append_char(pl, (const uint8 *)(j < 2 ? "0123456789" : "0123456780"), 10) != 0) return __LINE__;
+            if(string_literal_append_char(pl, (const uint8 *)(j % 2 ? "__________" : "9876543210"), 10) != 0) return __LINE__;
+        }
+        if(string_literal_append_char(pl, (const uint8 *)"%", 1) != 0) return __LINE__;
+        if((mh = strmatch_compile_literal(buf, pl, NULL)) == NULL) return __LINE__;
+        if(strmatch_get_kind(mh) != (j % 2 ? STRMATCH_KIND_GENERAL : STRMATCH_KIND_CONTAINS)) return __LINE__;
+        if(strmatch_match_literal(mh, sl, &res) != 0 || res != (j < 2)) return __LINE__;
+    }
+
+    string_literal_destroy(sl);
+    string_literal_destroy(pl);
+    free(sl);
+    free(pl);
+    free(buf);
+
+    return 0;
+}
+
+
+int bench_strmatch_functions()
+{
+    puts("Starting benchmark bench_strmatch_functions");
+
+    static const char *words[] = {"Customer", "ORDER", "order", "Invoice", "invoice", "Paid", "PENDING", "shipped",
+                                  "Berlin", "Paris", "London", "Zurich", "delivered", "returned", "Oslo", "Rome"};
+    static const char *patterns[] = {"Customer%", "%shipped", "%Zurich%", "%Paid%Oslo%", "%or_er%", "Invoice 1%n"};
+    static const char *kinds[] = {"exact", "prefix", "suffix", "contains", "any", "general", "segments"};
+    uint8 *strs = (uint8 *)malloc((uint64)BENCH_STRMATCH_ROWS * BENCH_STRMATCH_MAX_SZ);
+    uint8 *sizes = (uint8 *)malloc(BENCH_STRMATCH_ROWS);
+    uint8 buf[4096];
+    uint64 i, naive_num, num;
+    handle mh;
+    struct timeval t1;
+    int pos;
+
+    if(NULL == strs || NULL == sizes) return __LINE__;
+
+    // several words and a number
+    srand(1);
+    for(i = 0; i < BENCH_STRMATCH_ROWS; i++)
+    {
+        pos = snprintf((char *)strs + i * BENCH_STRMATCH_MAX_SZ, BENCH_STRMATCH_MAX_SZ, "%s %d %s %s %s %s %s",
+                       words[rand() % 16], rand() % 1000, words[rand() % 16], words[rand() % 16], words[rand() % 16],
+                       words[rand() % 16], words[rand() % 16]);
+        sizes[i] = (uint8)(pos < BENCH_STRMATCH_MAX_SZ ? pos : BENCH_STRMATCH_MAX_SZ - 1);
+    }
+
+    for(uint32 p = 0; p < sizeof(patterns) / sizeof(patterns[0]); p++)
+    {
+        uint64 psz = strlen(patterns[p]);
+
+        gettimeofday(&t1, NULL);
+        for(i = 0, naive_num = 0; i < BENCH_STRMATCH_ROWS; i++)
+        {
+            naive_num += test_strmatch_naive((const uint8 *)patterns[p], psz, strs + i * BENCH_STRMATCH_MAX_SZ, sizes[i], 0);
+        }
+        printf("Benchmarking LIKE '%s' over %d strings: naive %ld ms", patterns[p], BENCH_STRMATCH_ROWS, bench_elapsed_ms(&t1));
+
+        if((mh = strmatch_compile(buf, (const uint8 *)patterns[p], psz, NULL, 0)) == NULL) return __LINE__;
+
+        gettimeofday(&t1, NULL);
+        for(i = 0, num = 0; i < BENCH_STRMATCH_ROWS; i++)
+        {
+            num += strmatch_match(mh, strs + i * BENCH_STRMATCH_MAX_SZ, sizes[i]);
+        }
+        printf(", %s kernel %ld ms, %lu matches.\n", kinds[strmatch_get_kind(mh)], bench_elapsed_ms(&t1), (unsigned long)num);
+
+        if(num != naive_num) return __LINE__;
+    }
+
+    free(strs);
+    free(sizes);
+
+    return 0;
+}
@@ -5,6 +5,7 @@
 #include "common/error.h"
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 int test_strop_functions()
 {
@@ -18,6 +19,13 @@ int test_strop_functions()
     uint64 num;
 
 
+    puts("Testing strop_len");
+
+    if(strop_len((const uint8 *)"", 0) != 0) return __LINE__;
+    if(strop_len((const uint8 *)"abc", 3) != 3) return __LINE__;
+    if(strop_len((const uint8 *)"\xD0\xA4\xD1\x8B\xD0\xB2 \xE2\x82\xAC", 10) != 5) return __LINE__;
+
+
     puts("Testing strop_fmt_uint64");
 
     if(strop_fmt_uint64(buf, &ptr, 16, 1234567890123456UL) != 0) return __LINE__;
@@ -427,5 +435,362 @@ int test_strop_functions()
     if(strop_fmt_decimal(buf, &ptr, 99, fmt, &q) == 0) return __LINE__;
     if(error_get() != ERROR_INVALID_DECIMAL_FORMAT) return __LINE__;
 
+
+    puts("Testing strop_fmt_decimal_compiled");
+
+    strop_decimal_fmt df;
+
+    if(strop_decimal_fmt_compile(_ach("dddsdde"), &df) != 0) return __LINE__;
+    if(df.precision != 5 || df.scale != 2 || df.exp != 1) return __LINE__;
+    if(strop_decimal_fmt_compile(_ach("dds."), &df) == 0) return __LINE__;
+    if(error_get() != ERROR_INVALID_DECIMAL_FORMAT) return __LINE__;
+
+    // the same descriptor for every value, digits of limbs with inner zeroes
+    if(strop_decimal_fmt_compile(_ach("ddddddddddsdddd"), &df) != 0) return __LINE__;
+    decimal_from_int64(-1000200030004L, &q);
+    q.e = -4;
+    ptr = 0;
+    if(strop_fmt_decimal_compiled(buf, &ptr, 99, &df, &q) != 0) return __LINE__;
+    if(ptr != 15 || memcmp(buf, "-100020003.0004", 15)) return __LINE__;
+
+    decimal_from_int64(7, &q);
+    q.e = -6;
+    ptr = 0;
+    if(strop_fmt_decimal_compiled(buf, &ptr, 99, &df, &q) != 0) return __LINE__;
+    if(ptr != 7 || memcmp(buf, " 0.0000", 7)) return __LINE__;
+
+    decimal_from_int64(123456789012L, &q);
+    q.e = 0;
+    ptr = 0;
+    if(strop_fmt_decimal_compiled(buf, &ptr, 99, &df, &q) != 0) return __LINE__;
+    if(ptr != 1 || buf[0] != '?') return __LINE__;
+
+    // buffer overflow
+    decimal_from_int64(99990000, &q);
+    q.e = -4;
+    ptr = 0;
+    if(strop_fmt_decimal_compiled(buf, &ptr, 9, &df, &q) == 0) return __LINE__;
+    ptr = 0;
+    if(strop_fmt_decimal_compiled(buf, &ptr, 10, &df, &q) != 0) return __LINE__;
+    if(ptr != 10 || memcmp(buf, " 9999.0000", 10)) return __LINE__;
+
+
+    puts("Testing strop_dttm_fmt_compile");
+
+    strop_dttm_fmt tf;
+    uint64 ts[4];
+    sint16 tz[4];
+    uint32 end[4], i;
+
+    // compiled formats give the same text as format strings
+    const achar *dttm_fmts[] = {_ach("yyyy-mm-dd hh:mi:ss.ffffff"), _ach("yyyx.mx.dx hx/mx/sx"), _ach("yyyyyyyymmmmdddd hhhh:mimi:ssss"),
+                                _ach("ymd hhhmiisss"), _ach("YYYY MM DD HH MI SS"), _ach("dd.mm.yyyy fff tz t"), _ach("")};
+    for(i = 0; i < sizeof(dttm_fmts) / sizeof(dttm_fmts[0]); i++)
+    {
+        uint8 buf2[100];
+        uint32 ptr2 = 0;
+
+        if(strop_dttm_fmt_compile(dttm_fmts[i], &tf) != 0) return __LINE__;
+        ptr = 0;
+        if(strop_fmt_timestamp_with_tz_compiled(buf, &ptr, 99, &tf, (63718704000UL + 86399) * 1000000 + 123456, -691) != 0) return __LINE__;
+        if(strop_fmt_timestamp_with_tz(buf2, &ptr2, 99, dttm_fmts[i], (63718704000UL + 86399) * 1000000 + 123456, -691) != 0) return __LINE__;
+        if(ptr != ptr2 || memcmp(buf, buf2, ptr)) return __LINE__;
+    }
+
+    if(strop_dttm_fmt_compile(_ach("dd.mm.yyyy fff tz t"), &tf) != 0) return __LINE__;
+    if(tf.n != 10 || !tf.calendar) return __LINE__;
+    ptr = 0;
+    if(strop_fmt_date_compiled(buf, &ptr, 99, &tf, 63718704000UL) != 0) return __LINE__;
+    if(ptr != 23 || memcmp(buf, "02.03.2020 000 +00:00 t", 23)) return __LINE__;
+
+    if(strop_dttm_fmt_compile(_ach("hh:mi"), &tf) != 0) return __LINE__;
+    if(tf.n != 3 || tf.calendar) return __LINE__;
+
+    // format longer than compiled format can hold
+    char long_fmt[STROP_DTTM_FMT_LITERAL_SZ + 2];
+    memset(long_fmt, '-', sizeof(long_fmt) - 1);
+    long_fmt[sizeof(long_fmt) - 1] = '\0';
+    error_set(ERROR_NO_ERROR);
+    if(strop_dttm_fmt_compile(_ach(long_fmt), &tf) == 0) return __LINE__;
+    if(error_get() != ERROR_INVALID_DATETIME_FORMAT) return __LINE__;
+
+
+    puts("Testing strop_fmt_timestamp_batch");
+
+    if(strop_dttm_fmt_compile(_ach("yyyy-mm-dd hh:mi:ss.fff"), &tf) != 0) return __LINE__;
+    ts[0] = 63718704000UL * 1000000;
+    ts[1] = (63718704000UL + 86399) * 1000000 + 999999;
+    ts[2] = (63718704000UL + 86400) * 1000000 + 1000;
+    ts[3] = 0;
+    ptr = 0;
+    if(strop_fmt_timestamp_batch(buf, &ptr, 99, &tf, ts, 4, end) != 4) return __LINE__;
+    if(ptr != 92 || end[0] != 23 || end[1] != 46 || end[2] != 69 || end[3] != 92) return __LINE__;
+    if(memcmp(buf, "2020-03-02 00:00:00.0002020-03-02 23:59:59.9992020-03-03 00:00:00.0010001-01-01 00:00:00.000", 92)) return __LINE__;
+
+    // stops at the value which does not fit
+    ptr = 0;
+    if(strop_fmt_timestamp_batch(buf, &ptr, 50, &tf, ts, 4, end) != 2) return __LINE__;
+    if(ptr != 46) return __LINE__;
+
+    if(strop_dttm_fmt_compile(_ach("dd/mm/yyyy hh tz"), &tf) != 0) return __LINE__;
+    tz[0] = 60;
+    tz[1] = -30;
+    ptr = 0;
+    if(strop_fmt_timestamp_with_tz_batch(buf, &ptr, 99, &tf, ts + 1, tz, 2, end) != 2) return __LINE__;
+    if(ptr != 40 || memcmp(buf, "02/03/2020 23 +01:0003/03/2020 00 -00:30", 40)) return __LINE__;
+
+    ts[0] = 63718704000UL;
+    ts[1] = 63718704000UL + 86400 * 29;
+    ptr = 0;
+    if(strop_fmt_date_batch(buf, &ptr, 99, &tf, ts, 2, end) != 2) return __LINE__;
+    if(ptr != 40 || end[0] != 20 || memcmp(buf, "02/03/2020 00 +00:0031/03/2020 00 +00:00", 40)) return __LINE__;
+
+
+    puts("Testing strop_parse_timestamp_compiled");
+
+    // formats of ISO-8601 shape are recognized
+    if(strop_dttm_fmt_compile(_ach("yyyy-mm-dd hh:mi:ss.ffffff"), &tf) != 0) return __LINE__;
+    if(tf.iso_shape != (STROP_ISO_DATE | STROP_ISO_TIME | STROP_ISO_SECONDS) || tf.iso_sep != ' ' || tf.iso_frac != 6) return __LINE__;
+    if(strop_dttm_fmt_compile(_ach("yyyy-mm-ddThh:mitz"), &tf) != 0) return __LINE__;
+    if(tf.iso_shape != (STROP_ISO_DATE | STROP_ISO_TIME | STROP_ISO_TZ) || tf.iso_sep != 'T' || tf.iso_frac != 0) return __LINE__;
+    if(strop_dttm_fmt_compile(_ach("yyyy-mm-dd"), &tf) != 0) return __LINE__;
+    if(tf.iso_shape != STROP_ISO_DATE) return __LINE__;
+    if(strop_dttm_fmt_compile(_ach("yyyy-mm-dd hh"), &tf) != 0) return __LINE__;
+    if(tf.iso_shape != 0) return __LINE__;
+    if(strop_dttm_fmt_compile(_ach("dd.mm.yyyy"), &tf) != 0) return __LINE__;
+    if(tf.iso_shape != 0) return __LINE__;
+
+    // values read back equal formatted ones with ISO-8601 and other formats
+    const achar *parse_fmts[] = {_ach("yyyy-mm-dd hh:mi:ss.ffffff"), _ach("yyyy-mm-ddThh:mi:ss.ffffff"), _ach("dd.mm.yyyy hh:mi:ss.ffffff"),
+                                 _ach("yyyymmddhhmissffffff"), _ach("ss mi hh dd mm yyyy ffffff")};
+    ts[0] = 0;
+    ts[1] = (63718704000UL + 86399) * 1000000 + 123456;
+    ts[2] = (63718704000UL + 86400) * 1000000 + 1;
+    ts[3] = 315537897599UL * 1000000 + 999999;    // 9999-12-31 23:59:59.999999
+    for(i = 0; i < sizeof(parse_fmts) / sizeof(parse_fmts[0]); i++)
+    {
+        uint8 text[4 * 32];
+        uint64 parsed[4];
+        uint32 j;
+
+        if(strop_dttm_fmt_compile(parse_fmts[i], &tf) != 0) return __LINE__;
+        for(j = 0; j < 4; j++)
+        {
+            ptr = 0;
+            if(strop_fmt_timestamp_compiled(buf, &ptr, 99, &tf, ts[j]) != 0) return __LINE__;
+            if(strop_parse_timestamp_compiled(buf, ptr, &tf, parsed + j) != ptr) return __LINE__;
+            if(parsed[j] != ts[j]) return __LINE__;
+        }
+
+        ptr = 0;
+        if(strop_fmt_timestamp_batch(text, &ptr, sizeof(text), &tf, ts, 4, end) != 4) return __LINE__;
+        memset(parsed, 0, sizeof(parsed));
+        if(strop_parse_timestamp_batch(text, end, 4, &tf, parsed) != 4) return __LINE__;
+        if(memcmp(parsed, ts, sizeof(parsed))) return __LINE__;
+    }
+
+    // fields missing in format take the lowest value, fraction is scaled
+    if(strop_dttm_fmt_compile(_ach("hh:mi:ss.ff"), &tf) != 0) return __LINE__;
+    if(strop_parse_timestamp_compiled((const uint8 *)"01:02:03.45", 11, &tf, ts) != 11) return __LINE__;
+    if(ts[0] != 3723UL * 1000000 + 450000) return __LINE__;
+    if(strop_dttm_fmt_compile(_ach("yyyy-mm-dd"), &tf) != 0) return __LINE__;
+    if(strop_parse_date_compiled((const uint8 *)"2020-03-02", 10, &tf, ts) != 10 || ts[0] != 63718704000UL) return __LINE__;
+
+    // ISO-8601 value with parts not in format is read by format
+    if(strop_parse_date_compiled((const uint8 *)"2020-03-02T10:00", 16, &tf, ts) != 10 || ts[0] != 63718704000UL) return __LINE__;
+    if(strop_dttm_fmt_compile(_ach("yyyy-mm-dd hh:mi:ss.ff"), &tf) != 0) return __LINE__;
+    if(strop_parse_timestamp_compiled((const uint8 *)"2020-03-02 00:00:01.12345Z", 26, &tf, ts) != 22) return __LINE__;
+    if(ts[0] != (63718704000UL + 1) * 1000000 + 120000) return __LINE__;
+
+    // time zone
+    if(strop_dttm_fmt_compile(_ach("yyyy-mm-dd hh:mitz"), &tf) != 0) return __LINE__;
+    if(strop_parse_timestamp_with_tz_compiled((const uint8 *)"2020-03-02 11:31-11:31", 22, &tf, ts, tz) != 22) return __LINE__;
+    if(ts[0] != (63718704000UL + 41460) * 1000000 || tz[0] != -691) return __LINE__;
+    if(strop_parse_timestamp_with_tz_compiled((const uint8 *)"2020-03-02 11:31+05:00", 22, &tf, ts, tz) != 22 || tz[0] != 300) return __LINE__;
+
+    // invalid values
+    const char *bad_values[] = {"2020-03-02 11:31+05", "2020-13-02 11:31+05:00", "2020-02-30 11:31+05:00", "2020-03-02 24:00+05:00",
+                                "2020-03-02 11:60+05:00", "2020-03-02 11:31+05:60", "2020-03-02 11:31+19:00", "2020-3-02 11:31+05:00",
+                                "2020/03/02 11:31+05:00", "2020-03-02T11:31+05:00", "2020-03-02 1a:31+05:00", ""};
+    for(i = 0; i < sizeof(bad_values) / sizeof(bad_values[0]); i++)
+    {
+        error_set(ERROR_NO_ERROR);
+        if(strop_parse_timestamp_with_tz_compiled((const uint8 *)bad_values[i], strlen(bad_values[i]), &tf, ts, tz) != 0) return __LINE__;
+        if(error_get() != ERROR_INVALID_DATETIME_FORMAT) return __LINE__;
+    }
+
+    // batch stops at value which is invalid or not read completely
+    if(strop_dttm_fmt_compile(_ach("dd.mm.yyyy"), &tf) != 0) return __LINE__;
+    memcpy(buf, "02.03.202003.03.202031.02.202001.01.2020", 40);
+    end[0] = 10;
+    end[1] = 20;
+    end[2] = 30;
+    end[3] = 40;
+    if(strop_parse_date_batch(buf, end, 4, &tf, ts) != 2) return __LINE__;
+    if(ts[0] != 63718704000UL || ts[1] != 63718704000UL + 86400) return __LINE__;
+    end[1] = 21;
+    if(strop_parse_date_batch(buf, end, 2, &tf, ts) != 1) return __LINE__;
+
+    if(strop_dttm_fmt_compile(_ach("yyyy-mm-dd hh:mi:sstz"), &tf) != 0) return __LINE__;
+    memcpy(buf, "2020-03-02 00:00:00+01:002020-03-02 00:00:00-00:30", 50);
+    end[0] = 25;
+    end[1] = 50;
+    if(strop_parse_timestamp_with_tz_batch(buf, end, 2, &tf, ts, tz) != 2) return __LINE__;
+    if(ts[0] != 63718704000UL * 1000000 || ts[1] != ts[0] || tz[0] != 60 || tz[1] != -30) return __LINE__;
+
+
+    puts("Testing strop_parse_timestamp_iso");
+
+    const char *iso_values[] = {"2020-03-02", "2020-03-02T23:59", "2020-03-02 23:59:59", "2020-03-02T23:59:59.5", "2020-03-02T23:59:59.123456789Z",
+                                "2020-03-02T23:59:59,5", "2020-03-02T23:59:59.000001+05", "2020-03-02T23:59-0530", "2020-03-02T23:59-05:30x"};
+    const uint32 iso_len[] = {10, 16, 19, 21, 30, 19, 29, 21, 22};
+    const uint64 iso_ts[] = {63718704000UL * 1000000, (63718704000UL + 86340) * 1000000, (63718704000UL + 86399) * 1000000,
+                             (63718704000UL + 86399) * 1000000 + 500000, (63718704000UL + 86399) * 1000000 + 123456,
+                             (63718704000UL + 86399) * 1000000, (63718704000UL + 86399) * 1000000 + 1,
+                             (63718704000UL + 86340) * 1000000, (63718704000UL + 86340) * 1000000};
+    const sint16 iso_tz[] = {0, 0, 0, 0, 0, 0, 300, -330, -330};
+    for(i = 0; i < sizeof(iso_values) / sizeof(iso_values[0]); i++)
+    {
+        tz[0] = 1;
+        if(strop_parse_timestamp_iso((const uint8 *)iso_values[i], strlen(iso_values[i]), ts, tz) != iso_len[i]) return __LINE__;
+        if(ts[0] != iso_ts[i] || tz[0] != iso_tz[i]) return __LINE__;
+    }
+
+    error_set(ERROR_NO_ERROR);
+    if(strop_parse_timestamp_iso((const uint8 *)"2020-03-0", 9, ts, tz) != 0) return __LINE__;
+    if(strop_parse_timestamp_iso((const uint8 *)"2020-02-30", 10, ts, tz) != 0) return __LINE__;
+    if(error_get() != ERROR_INVALID_DATETIME_FORMAT) return __LINE__;
+
+    return 0;
+}
+
+
+#define BENCH_STROP_VALUES      (1000000)
+
+
+int bench_strop_functions()
+{
+    puts("Starting benchmark bench_strop_functions");
+
+    uint8 *out = (uint8 *)malloc(BENCH_STROP_VALUES * 48);
+    uint64 *num = (uint64 *)malloc(BENCH_STROP_VALUES * sizeof(uint64));
+    decimal *dec = (decimal *)malloc(BENCH_STROP_VALUES * sizeof(decimal));
+    uint32 *end = (uint32 *)malloc(BENCH_STROP_VALUES * sizeof(uint32));
+    strop_decimal_fmt df;
+    strop_dttm_fmt tf;
+    struct timeval t1;
+    uint32 ptr, i;
+    long ms;
+
+    if(NULL == out || NULL == num || NULL == dec || NULL == end) return __LINE__;
+
+    encoding_init();
+    strop_set_encoding(ENCODING_UTF8);
+
+    srand(1);
+    for(i = 0; i < BENCH_STROP_VALUES; i++)
+    {
+        num[i] = ((uint64)rand() << 31 | (uint64)rand()) >> (rand() % 62);
+        decimal_from_int64((sint64)(num[i] % 100000000000000L) * (rand() % 2 ? 1 : -1), dec + i);
+        dec[i].e = -4;
+    }
+
+    gettimeofday(&t1, NULL);
+    for(i = 0, ptr = 0; i < BENCH_STROP_VALUES; i++)
+    {
+        ptr += snprintf((char *)out + ptr, 48, "%lu", num[i]);
+    }
+    ms = bench_elapsed_ms(&t1);
+    printf("Benchmarking uint64: snprintf %ld ms", ms);
+
+    gettimeofday(&t1, NULL);
+    for(i = 0, ptr = 0; i < BENCH_STROP_VALUES; i++)
+    {
+        if(strop_fmt_uint64(out, &ptr, BENCH_STROP_VALUES * 48, num[i]) != 0) return __LINE__;
+    }
+    printf(", strop_fmt_uint64 %ld ms.\n", bench_elapsed_ms(&t1));
+
+    gettimeofday(&t1, NULL);
+    for(i = 0, ptr = 0; i < BENCH_STROP_VALUES; i++)
+    {
+        if(strop_fmt_decimal(out, &ptr, BENCH_STROP_VALUES * 48, _ach("ddddddddddddsdddd"), dec + i) != 0) return __LINE__;
+    }
+    printf("Benchmarking decimal(17,4): strop_fmt_decimal %ld ms", bench_elapsed_ms(&t1));
+
+    if(strop_decimal_fmt_compile(_ach("ddddddddddddsdddd"), &df) != 0) return __LINE__;
+    gettimeofday(&t1, NULL);
+    for(i = 0, ptr = 0; i < BENCH_STROP_VALUES; i++)
+    {
+        if(strop_fmt_decimal_compiled(out, &ptr, BENCH_STROP_VALUES * 48, &df, dec + i) != 0) return __LINE__;
+    }
+    printf(", strop_fmt_decimal_compiled %ld ms.\n", bench_elapsed_ms(&t1));
+
+    // sorted timestamps of about a month, several thousands per day
+    dateop_set_calendar(DATEOP_CALENDAR_GRIGORIAN);
+    for(i = 0; i < BENCH_STROP_VALUES; i++)
+    {
+        num[i] = (63718704000UL + i * 3) * 1000000 + (uint64)rand() % 1000000;
+    }
+
+    gettimeofday(&t1, NULL);
+    for(i = 0, ptr = 0; i < BENCH_STROP_VALUES; i++)
+    {
+        if(strop_fmt_timestamp(out, &ptr, BENCH_STROP_VALUES * 48, _ach("yyyy-mm-dd hh:mi:ss.ffffff"), num[i]) != 0) return __LINE__;
+    }
+    printf("Benchmarking timestamp: strop_fmt_timestamp %ld ms", bench_elapsed_ms(&t1));
+
+    if(strop_dttm_fmt_compile(_ach("yyyy-mm-dd hh:mi:ss.ffffff"), &tf) != 0) return __LINE__;
+    gettimeofday(&t1, NULL);
+    for(i = 0, ptr = 0; i < BENCH_STROP_VALUES; i++)
+    {
+        if(strop_fmt_timestamp_compiled(out, &ptr, BENCH_STROP_VALUES * 48, &tf, num[i]) != 0) return __LINE__;
+    }
+    printf(", strop_fmt_timestamp_compiled %ld ms", bench_elapsed_ms(&t1));
+
+    gettimeofday(&t1, NULL);
+    ptr = 0;
+    if(strop_fmt_timestamp_batch(out, &ptr, BENCH_STROP_VALUES * 48, &tf, num, BENCH_STROP_VALUES, end) != BENCH_STROP_VALUES) return __LINE__;
+    printf(", strop_fmt_timestamp_batch %ld ms.\n", bench_elapsed_ms(&t1));
+
+    // read back the formatted timestamps
+    uint32 year, month, day, hour, min, sec, us, start;
+    uint64 date;
+    char text[48];
+
+    gettimeofday(&t1, NULL);
+    for(i = 0, start = 0; i < BENCH_STROP_VALUES; start = end[i++])
+    {
+        memcpy(text, out + start, end[i] - start);
+        text[end[i] - start] = '\0';
+        if(7 != sscanf(text, "%4u-%2u-%2u %2u:%2u:%2u.%6u", &year, &month, &day, &hour, &min, &sec, &us)) return __LINE__;
+        if(0 != dateop_make_date_with_time(&date, year, (uint8)month, (uint8)day, (uint8)hour, (uint8)min, (uint8)sec)) return __LINE__;
+        num[i] = date * 1000000 + us;
+    }
+    printf("Benchmarking timestamp parsing: sscanf %ld ms", bench_elapsed_ms(&t1));
+
+    gettimeofday(&t1, NULL);
+    for(i = 0, start = 0; i < BENCH_STROP_VALUES; start = end[i++])
+    {
+        if(strop_parse_timestamp_compiled(out + start, end[i] - start, &tf, num + i) != end[i] - start) return __LINE__;
+    }
+    printf(", strop_parse_timestamp_compiled %ld ms", bench_elapsed_ms(&t1));
+
+    gettimeofday(&t1, NULL);
+    if(strop_parse_timestamp_batch(out, end, BENCH_STROP_VALUES, &tf, num) != BENCH_STROP_VALUES) return __LINE__;
+    printf(", strop_parse_timestamp_batch %ld ms", bench_elapsed_ms(&t1));
+
+    // format which is not ISO-8601 is read by ops
+    if(strop_dttm_fmt_compile(_ach("dd.mm.yyyy hh:mi:ss.ffffff"), &tf) != 0) return __LINE__;
+    ptr = 0;
+    if(strop_fmt_timestamp_batch(out, &ptr, BENCH_STROP_VALUES * 48, &tf, num, BENCH_STROP_VALUES, end) != BENCH_STROP_VALUES) return __LINE__;
+    gettimeofday(&t1, NULL);
+    if(strop_parse_timestamp_batch(out, end, BENCH_STROP_VALUES, &tf, num) != BENCH_STROP_VALUES) return __LINE__;
+    printf(", not ISO-8601 strop_parse_timestamp_batch %ld ms.\n", bench_elapsed_ms(&t1));
+
+    free(out);
+    free(num);
+    free(dec);
+    free(end);
+
     return 0;
 }
@@ -0,0 +1,250 @@
+#include "tests.h"
+#include "common/strval.h"
+#include "common/string_literal.h"
+#include "common/htable.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+
+#define BENCH_STRVAL_ROWS   (1000000)
+
+
+// return 1 if value v holds len bytes of str
+uint8 test_strval_holds(const strval *v, const char *str)
+{
+    uint32 len = (uint32)strlen(str);
+    return v->len == len && v->hash == strval_hash_buf((const uint8 *)str, len) && 0 == memcmp(strval_data(v), str, len);
+}
+
+
+int test_strval_functions()
+{
+    strval a, b, c, d;
+    const char *long1 = "Democratic Republic of the Congo";
+    const char *long2 = "Democratic Republic of the Congo, north";
+    uint8 buf[64];
+
+    puts("Starting test test_strval_functions");
+
+    if(sizeof(strval) != 32) return __LINE__;
+
+    puts("Testing inline values");
+
+    if(strval_from_buf(&a, (const uint8 *)"active", 6) != 0) return __LINE__;
+    strval_from_ref(&b, (const uint8 *)"active", 6);
+    if(!test_strval_holds(&a, "active") || !test_strval_holds(&b, "active")) return __LINE__;
+    if(strval_data(&a) != a.data) return __LINE__;
+    if(!strval_eq(&a, &b) || strval_cmp(&a, &b) != 0) return __LINE__;
+
+    strval_from_ref(&c, (const uint8 *)"activ", 5);
+    if(strval_eq(&a, &c) || strval_cmp(&c, &a) != -1 || strval_cmp(&a, &c) != 1) return __LINE__;
+
+    strval_from_ref(&c, (const uint8 *)"blocked", 7);
+    if(strval_eq(&a, &c) || strval_cmp(&a, &c) != -1) return __LINE__;
+
+    // zero byte inside of the string
+    strval_from_ref(&c, (const uint8 *)"act\0ve", 6);
+    strval_from_ref(&d, (const uint8 *)"act", 3);
+    if(strval_eq(&c, &d) || strval_cmp(&d, &c) != -1 || strval_cmp(&c, &a) != -1) return __LINE__;
+
+    // empty string
+    strval_from_ref(&c, NULL, 0);
+    if(c.len != 0 || strval_cmp(&c, &d) != -1 || strval_cmp(&d, &c) != 1) return __LINE__;
+    strval_release(&c);
+
+    // the longest inline string
+    memset(buf, 'z', sizeof(buf));
+    strval_from_ref(&c, buf, STRVAL_INLINE_SZ);
+    if(strval_data(&c) != c.data) return __LINE__;
+    strval_from_ref(&d, buf, STRVAL_INLINE_SZ + 1);
+    if(strval_data(&d) != buf) return __LINE__;
+    if(strval_eq(&c, &d) || strval_cmp(&c, &d) != -1) return __LINE__;
+
+
+    puts("Testing long values");
+
+    if(strval_from_buf(&a, (const uint8 *)long1, (uint32)strlen(long1)) != 0) return __LINE__;
+    strval_from_ref(&b, (const uint8 *)long1, (uint32)strlen(long1));
+    if(!test_strval_holds(&a, long1) || !test_strval_holds(&b, long1)) return __LINE__;
+    if(strval_data(&a) == (const uint8 *)long1 || strval_data(&b) != (const uint8 *)long1) return __LINE__;
+    if(!strval_eq(&a, &b) || strval_cmp(&a, &b) != 0) return __LINE__;
+
+    strval_from_ref(&c, (const uint8 *)long2, (uint32)strlen(long2));
+    if(strval_eq(&a, &c) || strval_cmp(&a, &c) != -1 || strval_cmp(&c, &b) != 1) return __LINE__;
+
+    // long and short strings with the same prefix
+    strval_from_ref(&d, (const uint8 *)"Democratic", 10);
+    if(strval_cmp(&d, &a) != -1 || strval_cmp(&a, &d) != 1) return __LINE__;
+    strval_from_ref(&d, (const uint8 *)"Democratic Republic of the Congo!", 33);
+    if(strval_cmp(&d, &a) != 1) return __LINE__;
+    strval_from_ref(&d, (const uint8 *)"Democratic Republic of Korea", 28);
+    if(strval_cmp(&d, &a) != -1) return __LINE__;
+
+    // buffer is freed with the last reference
+    strval_copy(&c, &a);
+    if(strval_data(&c) != strval_data(&a) || !strval_eq(&c, &a)) return __LINE__;
+    strval_release(&a);
+    if(a.len != 0 || !test_strval_holds(&c, long1)) return __LINE__;
+    strval_release(&c);
+
+
+    puts("Testing values of string literals");
+
+    handle sh = string_literal_create(malloc(string_literal_alloc_sz()));
+    if(NULL == sh) return __LINE__;
+
+    if(string_literal_append_char(sh, (const uint8 *)"Chile", 5) != 0) return __LINE__;
+    if(strval_from_literal(&a, sh) != 0 || !test_strval_holds(&a, "Chile")) return __LINE__;
+
+    for(uint32 i = 0; i < 1000; i++)
+    {
+        if(string_literal_append_char(sh, (const uint8 *)"0123456789", 10) != 0) return __LINE__;
+    }
+    if(strval_from_literal(&b, sh) != 0 || b.len != 10005) return __LINE__;
+    if(0 != memcmp(strval_data(&b), "Chile0123456789", 15) || 0 != memcmp(strval_data(&b) + 9995, "0123456789", 10)) return __LINE__;
+    if(b.hash != strval_hash_buf(strval_data(&b), b.len)) return __LINE__;
+    if(strval_cmp(&a, &b) != -1) return __LINE__;
+    strval_release(&b);
+
+    string_literal_destroy(sh);
+    free(sh);
+
+
+    puts("Testing interning dictionary");
+
+    handle dh = strval_dict_create(malloc(strval_dict_get_alloc_sz(4, 64)), 4, 64);
+    if(NULL == dh) return __LINE__;
+
+    if(strval_dict_intern(dh, (const uint8 *)"shipped", 7, &a) != 0) return __LINE__;
+    if(strval_dict_intern(dh, (const uint8 *)long1, (uint32)strlen(long1), &b) != 0) return __LINE__;
+    if(strval_dict_intern(dh, (const uint8 *)"shipped", 7, &c) != 0) return __LINE__;
+    if(strval_dict_intern(dh, (const uint8 *)long1, (uint32)strlen(long1), &d) != 0) return __LINE__;
+    if(strval_dict_size(dh) != 2) return __LINE__;
+    if(!test_strval_holds(&a, "shipped") || !strval_eq(&a, &c)) return __LINE__;
+
+    // equal long strings share the copy kept in dictionary
+    if(!test_strval_holds(&b, long1) || strval_data(&b) == (const uint8 *)long1) return __LINE__;
+    if(strval_data(&b) != strval_data(&d)) return __LINE__;
+
+    // storage of long strings is full
+    if(strval_dict_intern(dh, (const uint8 *)long2, (uint32)strlen(long2), &c) == 0) return __LINE__;
+    if(strval_dict_size(dh) != 2) return __LINE__;
+
+    // number of strings is limited
+    if(strval_dict_intern(dh, (const uint8 *)"new", 3, &c) != 0) return __LINE__;
+    if(strval_dict_intern(dh, (const uint8 *)"cancelled", 9, &c) != 0) return __LINE__;
+    if(strval_dict_intern(dh, (const uint8 *)"returned", 8, &c) == 0) return __LINE__;
+    if(strval_dict_intern(dh, (const uint8 *)"new", 3, &c) != 0 || !test_strval_holds(&c, "new")) return __LINE__;
+    if(strval_dict_size(dh) != 4) return __LINE__;
+
+    strval_dict_reset(dh);
+    if(strval_dict_size(dh) != 0) return __LINE__;
+    if(strval_dict_intern(dh, (const uint8 *)long2, (uint32)strlen(long2), &c) != 0) return __LINE__;
+    if(!test_strval_holds(&c, long2)) return __LINE__;
+
+    free(dh);
+
+    return 0;
+}
+
+
+int bench_strval_functions()
+{
+    puts("Starting benchmark bench_strval_functions");
+
+    static const char *words[] = {"new", "paid", "shipped", "delivered", "cancelled", "returned",
+                                  "Chile", "France", "Germany", "United Kingdom", "United States of America",
+                                  "Democratic Republic of the Congo", "Saint Vincent and the Grenadines",
+                                  "Bosnia and Herzegovina"};
+    const uint32 words_num = sizeof(words) / sizeof(words[0]);
+    handle *literals = (handle *)malloc(words_num * sizeof(handle));
+    uint8 *row_idx = (uint8 *)malloc(BENCH_STRVAL_ROWS);
+    strval *values = (strval *)malloc(BENCH_STRVAL_ROWS * sizeof(strval));
+    handle dh = strval_dict_create(malloc(strval_dict_get_alloc_sz(words_num, 1024)), words_num, 1024);
+    uint8 buf[64];
+    uint64 len, i, eq, lt;
+    uint32 hash;
+    sint8 res;
+    struct timeval t1;
+
+    if(NULL == literals || NULL == row_idx || NULL == values || NULL == dh) return __LINE__;
+
+    for(i = 0; i < words_num; i++)
+    {
+        literals[i] = string_literal_create(malloc(string_literal_alloc_sz()));
+        if(NULL == literals[i]) return __LINE__;
+        if(string_literal_append_char(literals[i], (const uint8 *)words[i], (uint32)strlen(words[i])) != 0) return __LINE__;
+    }
+
+    srand(1);
+    for(i = 0; i < BENCH_STRVAL_ROWS; i++) row_idx[i] = (uint8)(rand() % words_num);
+
+    printf("Benchmarking footprint: string literal %lu bytes, value %lu bytes, dictionary of %u strings %lu bytes\n",
+           (unsigned long)string_literal_alloc_sz(), (unsigned long)sizeof(strval), words_num,
+           (unsigned long)strval_dict_get_alloc_sz(words_num, 1024));
+
+    // hashing and comparison of each row with its neighbour, as grouping and sorting of column do
+    gettimeofday(&t1, NULL);
+    for(i = 1, eq = 0, lt = 0, hash = 0; i < BENCH_STRVAL_ROWS; i++)
+    {
+        handle s1 = literals[row_idx[i - 1]], s2 = literals[row_idx[i]];
+        len = sizeof(buf);
+        if(string_literal_read(s2, buf, &len) != 0) return __LINE__;
+        hash += htable_strhash(buf, (uint32)len);
+        if(string_literal_byte_compare(s1, s2, &res) != 0) return __LINE__;
+        eq += (0 == res);
+        lt += (res < 0);
+    }
+    printf("Benchmarking %d rows: string literals hash and compare %ld ms", BENCH_STRVAL_ROWS, bench_elapsed_ms(&t1));
+
+    gettimeofday(&t1, NULL);
+    for(i = 0; i < BENCH_STRVAL_ROWS; i++)
+    {
+        const char *w = words[row_idx[i]];
+        if(strval_from_buf(values + i, (const uint8 *)w, (uint32)strlen(w)) != 0) return __LINE__;
+    }
+    printf(", values: build %ld ms", bench_elapsed_ms(&t1));
+
+    gettimeofday(&t1, NULL);
+    for(i = 1; i < BENCH_STRVAL_ROWS; i++)
+    {
+        hash -= values[i].hash;
+        eq -= strval_eq(values + i - 1, values + i);
+        lt -= (strval_cmp(values + i - 1, values + i) < 0);
+    }
+    printf(", hash and compare %ld ms", bench_elapsed_ms(&t1));
+    if(0 != eq || 0 != lt) return __LINE__;
+
+    for(i = 0; i < BENCH_STRVAL_ROWS; i++) strval_release(values + i);
+
+    gettimeofday(&t1, NULL);
+    for(i = 0; i < BENCH_STRVAL_ROWS; i++)
+    {
+        const char *w = words[row_idx[i]];
+        if(strval_dict_intern(dh, (const uint8 *)w, (uint32)strlen(w), values + i) != 0) return __LINE__;
+    }
+    printf(", interned: build %ld ms", bench_elapsed_ms(&t1));
+
+    gettimeofday(&t1, NULL);
+    for(i = 1, eq = 0, lt = 0; i < BENCH_STRVAL_ROWS; i++)
+    {
+        hash += values[i].hash;
+        eq += strval_eq(values + i - 1, values + i);
+        lt += (strval_cmp(values + i - 1, values + i) < 0);
+    }
+    printf(", hash and compare %ld ms.\n", bench_elapsed_ms(&t1));
+    if(hash == 0 && eq == 0 && lt == 0) return __LINE__;
+
+    for(i = 0; i < words_num; i++)
+    {
+        string_literal_destroy(literals[i]);
+        free(literals[i]);
+    }
+    free(literals);
+    free(row_idx);
+    free(values);
+    free(dh);
+
+    return 0;
+}
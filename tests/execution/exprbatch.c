@@ -0,0 +1,763 @@
+#include "tests.h"
+#include "execution/exprbatch.h"
+#include "execution/exprvm.h"
+#include "execution/expression.h"
+#include "common/error.h"
+#include "common/stack.h"
+#include "common/string_literal.h"
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+// resolve single-letter column names "a".."g" to slots 0..6
+sint8 test_exprbatch_resolve_name(const parser_ast_name *name, uint16 *slot, column_datatype *type)
+{
+    if(name->first_part_len != 1 || name->second_part_len != 0) return 1;
+    if(name->first_part[0] < 'a' || name->first_part[0] > 'h') return 1;
+
+    *slot = name->first_part[0] - 'a';
+    *type = *slot == 2 ? DECIMAL : (*slot == 6 ? DOUBLE_PRECISION : (*slot == 7 ? CHARACTER_VARYING : INTEGER));
+    return 0;
+}
+
+
+void test_exprbatch_name(parser_ast_expr *e, char c)
+{
+    memset(e, 0, sizeof(*e));
+    e->node_type = PARSER_EXPR_NODE_TYPE_NAME;
+    e->name.first_part[0] = c;
+    e->name.first_part_len = 1;
+}
+
+
+void test_exprbatch_op(parser_ast_expr *e, parser_expr_op_type op, parser_ast_expr *left, parser_ast_expr *right)
+{
+    e->node_type = PARSER_EXPR_NODE_TYPE_OP;
+    e->op = op;
+    e->left = left;
+    e->right = right;
+}
+
+
+void test_exprbatch_int(parser_ast_expr *e, sint64 val)
+{
+    e->node_type = PARSER_EXPR_NODE_TYPE_INT;
+    e->integer = val;
+}
+
+
+// copy element i of vector v to row value
+void test_exprbatch_get(const exprbatch_vector *v, uint16 i, exprvm_value *val)
+{
+    val->type = EXPRBATCH_IS_NULL(v, i) ? PARSER_EXPR_NODE_TYPE_NULL : v->type;
+    switch(val->type)
+    {
+        case PARSER_EXPR_NODE_TYPE_INT: val->integer = v->integer[i]; break;
+        case PARSER_EXPR_NODE_TYPE_FLOAT: val->fp = v->fp[i]; break;
+        case PARSER_EXPR_NODE_TYPE_NUM: val->num = v->num[i]; break;
+        case PARSER_EXPR_NODE_TYPE_BOOL: val->boolean = v->boolean[i]; break;
+        case PARSER_EXPR_NODE_TYPE_STR: val->str = v->str[i]; break;
+        default: break;
+    }
+}
+
+
+// compare batch evaluation of e with row-at-a-time evaluation
+// return 0 if results match, non-0 otherwise
+int test_exprbatch_match(parser_ast_expr *e, const exprbatch_vector *cols, const uint16 *sel, uint16 n, void *bbuf, void *vbuf)
+{
+    exprvm_interface vi = {test_exprbatch_resolve_name};
+    const exprbatch_vector *res;
+    exprvm_value row[8], expected, actual;
+    handle bh, vh;
+    uint16 i, k;
+
+    if((bh = exprbatch_compile(bbuf, e, vi)) == NULL) return __LINE__;
+    if((vh = exprvm_compile(vbuf, e, vi)) == NULL) return __LINE__;
+    if(exprbatch_eval(bh, cols, sel, n, &res) != 0) return __LINE__;
+
+    for(k = 0; k < n; k++)
+    {
+        i = (NULL == sel) ? k : sel[k];
+        for(int c = 0; c < 8; c++) test_exprbatch_get(cols + c, i, row + c);
+        if(exprvm_eval(vh, row, &expected) != 0) return __LINE__;
+
+        test_exprbatch_get(res, i, &actual);
+        if(actual.type != expected.type)
+        {
+            // integer overflow in any row makes the whole batch decimal
+            if(actual.type != PARSER_EXPR_NODE_TYPE_NUM || expected.type != PARSER_EXPR_NODE_TYPE_INT) return __LINE__;
+            decimal_from_int64(expected.integer, &expected.num);
+            expected.type = PARSER_EXPR_NODE_TYPE_NUM;
+        }
+        if(actual.type == PARSER_EXPR_NODE_TYPE_INT && actual.integer != expected.integer) return __LINE__;
+        if(actual.type == PARSER_EXPR_NODE_TYPE_FLOAT && actual.fp != expected.fp) return __LINE__;
+        if(actual.type == PARSER_EXPR_NODE_TYPE_NUM && decimal_cmp(&actual.num, &expected.num) != 0) return __LINE__;
+        if(actual.type == PARSER_EXPR_NODE_TYPE_BOOL && actual.boolean != expected.boolean) return __LINE__;
+    }
+
+    return 0;
+}
+
+
+// compare batch evaluation of nodes e[0..num-1] rooted at e[0] with expression tree evaluation of every row,
+// column names are replaced by row values in a copy of the tree
+// return 0 if results match, non-0 otherwise
+int test_exprbatch_match_tree(const parser_ast_expr *e, int num, const exprbatch_vector *cols, uint16 n, void *bbuf, handle sh)
+{
+    exprvm_interface vi = {test_exprbatch_resolve_name};
+    const exprbatch_vector *res;
+    parser_ast_expr t[16];
+    exprvm_value val;
+    handle bh;
+    uint16 i;
+
+    if((bh = exprbatch_compile(bbuf, e, vi)) == NULL) return __LINE__;
+    if(exprbatch_eval(bh, cols, NULL, n, &res) != 0) return __LINE__;
+
+    for(i = 0; i < n; i++)
+    {
+        memcpy(t, e, sizeof(t[0]) * num);
+        for(int j = 0; j < num; j++)
+        {
+            if(t[j].node_type == PARSER_EXPR_NODE_TYPE_OP)
+            {
+                t[j].left = t + (e[j].left - e);
+                if(NULL != e[j].right) t[j].right = t + (e[j].right - e);
+            }
+            else if(t[j].node_type == PARSER_EXPR_NODE_TYPE_NAME)
+            {
+                test_exprbatch_get(cols + (e[j].name.first_part[0] - 'a'), i, &val);
+                t[j].node_type = val.type;
+                if(val.type == PARSER_EXPR_NODE_TYPE_INT) t[j].integer = val.integer;
+                if(val.type == PARSER_EXPR_NODE_TYPE_NUM) t[j].num = val.num;
+                if(val.type == PARSER_EXPR_NODE_TYPE_FLOAT) t[j].fp = val.fp;
+                if(val.type == PARSER_EXPR_NODE_TYPE_BOOL) t[j].boolean = val.boolean;
+            }
+        }
+        if(expression_calc_const_expr(t, sh) != 0) return __LINE__;
+
+        test_exprbatch_get(res, i, &val);
+        if(val.type != t[0].node_type) return __LINE__;
+        if(val.type == PARSER_EXPR_NODE_TYPE_BOOL && val.boolean != t[0].boolean) return __LINE__;
+    }
+
+    return 0;
+}
+
+
+int test_exprbatch_functions()
+{
+    puts("Starting test test_exprbatch_functions");
+
+    parser_ast_expr e[10];
+    exprbatch_vector cols[8];
+    const exprbatch_vector *res;
+    exprvm_interface vi = {test_exprbatch_resolve_name};
+    sint64 *ints_a = (sint64 *)malloc(sizeof(sint64) * EXPRBATCH_SIZE);
+    sint64 *ints_b = (sint64 *)malloc(sizeof(sint64) * EXPRBATCH_SIZE);
+    decimal *nums = (decimal *)malloc(sizeof(decimal) * EXPRBATCH_SIZE);
+    float64 *floats = (float64 *)malloc(sizeof(float64) * EXPRBATCH_SIZE);
+    uint8 bools_d[EXPRBATCH_SIZE] = {0, 0, 0, 1, 1, 1, 0, 0, 0}, bools_e[EXPRBATCH_SIZE] = {0, 1, 0, 0, 1, 0, 0, 1, 0};
+    uint16 sel[EXPRBATCH_SIZE], n, i;
+    void *bbuf = malloc(exprbatch_get_alloc_sz()), *vbuf = malloc(exprvm_get_alloc_sz());
+    handle bh;
+    int res_line;
+    uint32 stack_sz = 16;
+    handle sh = stack_create(stack_sz, sizeof(parser_ast_expr *), malloc(stack_get_alloc_sz(stack_sz, sizeof(parser_ast_expr *))));
+
+    if(NULL == sh) return __LINE__;
+    if(NULL == ints_a || NULL == ints_b || NULL == nums || NULL == floats || NULL == bbuf || NULL == vbuf) return __LINE__;
+
+    // a, b are integers, c is decimal, g is float, every 7th a, every 11th c and every 13th g are null
+    memset(cols, 0, sizeof(cols));
+    cols[0].type = PARSER_EXPR_NODE_TYPE_INT;
+    cols[0].integer = ints_a;
+    cols[1].type = PARSER_EXPR_NODE_TYPE_INT;
+    cols[1].integer = ints_b;
+    cols[2].type = PARSER_EXPR_NODE_TYPE_NUM;
+    cols[2].num = nums;
+    cols[6].type = PARSER_EXPR_NODE_TYPE_FLOAT;
+    cols[6].fp = floats;
+    srand(1);
+    for(i = 0; i < EXPRBATCH_SIZE; i++)
+    {
+        ints_a[i] = rand() % 2001 - 1000;
+        ints_b[i] = rand() % 100 + 1;
+        decimal_from_int64(rand() % 20001 - 10000, nums + i);
+        nums[i].e = -2;
+        floats[i] = (rand() % 20001 - 10000) / 8.0;
+        if(i % 13 == 0) EXPRBATCH_SET_NULL(&cols[6], i);
+        if(i % 7 == 0) EXPRBATCH_SET_NULL(&cols[0], i);
+        if(i % 11 == 0) EXPRBATCH_SET_NULL(&cols[2], i);
+    }
+    // ascending selection of every third element
+    for(i = 0, n = 0; i < EXPRBATCH_SIZE; i += 3) sel[n++] = i;
+
+    // d, e are booleans covering all pairs of true, false and null, f is all-null
+    cols[3].type = PARSER_EXPR_NODE_TYPE_BOOL;
+    cols[3].boolean = bools_d;
+    cols[4].type = PARSER_EXPR_NODE_TYPE_BOOL;
+    cols[4].boolean = bools_e;
+    for(i = 6; i < 9; i++) EXPRBATCH_SET_NULL(&cols[3], i);
+    for(i = 2; i < 9; i += 3) EXPRBATCH_SET_NULL(&cols[4], i);
+    cols[5].type = PARSER_EXPR_NODE_TYPE_NULL;
+    memset(cols[5].nulls, 0xFF, sizeof(cols[5].nulls));
+
+
+    puts("Testing arithmetic against exprvm");
+
+    // a * b + 3
+    test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_ADD, &e[1], &e[4]);
+    test_exprbatch_op(&e[1], PARSER_EXPR_OP_TYPE_MUL, &e[2], &e[3]);
+    test_exprbatch_name(&e[2], 'a');
+    test_exprbatch_name(&e[3], 'b');
+    test_exprbatch_int(&e[4], 3);
+    if((res_line = test_exprbatch_match(e, cols, NULL, EXPRBATCH_SIZE, bbuf, vbuf)) != 0) return res_line;
+    if((res_line = test_exprbatch_match(e, cols, sel, n, bbuf, vbuf)) != 0) return res_line;
+
+    // a - c, a / b, c * b
+    test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_SUB, &e[2], &e[5]);
+    test_exprbatch_name(&e[5], 'c');
+    if((res_line = test_exprbatch_match(e, cols, NULL, EXPRBATCH_SIZE, bbuf, vbuf)) != 0) return res_line;
+    test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_DIV, &e[2], &e[3]);
+    if((res_line = test_exprbatch_match(e, cols, sel, n, bbuf, vbuf)) != 0) return res_line;
+    test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_MUL, &e[5], &e[3]);
+    if((res_line = test_exprbatch_match(e, cols, NULL, EXPRBATCH_SIZE, bbuf, vbuf)) != 0) return res_line;
+
+    // g * a, g + g, g / b, c - g
+    test_exprbatch_name(&e[5], 'g');
+    test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_MUL, &e[5], &e[2]);
+    if((res_line = test_exprbatch_match(e, cols, NULL, EXPRBATCH_SIZE, bbuf, vbuf)) != 0) return res_line;
+    test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_ADD, &e[5], &e[5]);
+    if((res_line = test_exprbatch_match(e, cols, sel, n, bbuf, vbuf)) != 0) return res_line;
+    test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_DIV, &e[5], &e[3]);
+    if((res_line = test_exprbatch_match(e, cols, NULL, EXPRBATCH_SIZE, bbuf, vbuf)) != 0) return res_line;
+    test_exprbatch_name(&e[6], 'c');
+    test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_SUB, &e[6], &e[5]);
+    if((res_line = test_exprbatch_match(e, cols, NULL, EXPRBATCH_SIZE, bbuf, vbuf)) != 0) return res_line;
+
+    // float division by zero in null element is not an error
+    floats[0] = 0.0;
+    test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_DIV, &e[5], &e[5]);
+    if((bh = exprbatch_compile(bbuf, e, vi)) == NULL) return __LINE__;
+    if(exprbatch_eval(bh, cols, NULL, EXPRBATCH_SIZE, &res) != 0) return __LINE__;
+    floats[1] = 0.0;
+    if(exprbatch_eval(bh, cols, NULL, EXPRBATCH_SIZE, &res) == 0) return __LINE__;
+    if(error_get() != ERROR_DIVISION_BY_ZERO) return __LINE__;
+    floats[1] = 1.0;
+    test_exprbatch_name(&e[5], 'c');
+
+    // overflow of a single element makes whole batch decimal
+    ints_a[5] = 2;
+    ints_b[5] = 0x7FFFFFFFFFFFFFFF;
+    test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_MUL, &e[2], &e[3]);
+    if((bh = exprbatch_compile(bbuf, e, vi)) == NULL) return __LINE__;
+    if(exprbatch_eval(bh, cols, NULL, EXPRBATCH_SIZE, &res) != 0) return __LINE__;
+    if(res->type != PARSER_EXPR_NODE_TYPE_NUM) return __LINE__;
+    if((res_line = test_exprbatch_match(e, cols, NULL, EXPRBATCH_SIZE, bbuf, vbuf)) != 0) return res_line;
+    ints_b[5] = 1;
+
+    // division by zero
+    ints_b[10] = 0;
+    test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_DIV, &e[2], &e[3]);
+    if((bh = exprbatch_compile(bbuf, e, vi)) == NULL) return __LINE__;
+    if(exprbatch_eval(bh, cols, NULL, EXPRBATCH_SIZE, &res) == 0) return __LINE__;
+    if(error_get() != ERROR_DIVISION_BY_ZERO) return __LINE__;
+    // element out of selection is not evaluated
+    if(exprbatch_eval(bh, cols, sel, n, &res) != 0) return __LINE__;
+    ints_b[10] = 1;
+
+
+    puts("Testing comparison against exprvm");
+
+    for(parser_expr_op_type op = PARSER_EXPR_OP_TYPE_EQ; op <= PARSER_EXPR_OP_TYPE_LE; op++)
+    {
+        // a <op> c, c <op> c, a * b <op> 3, g <op> g, g <op> a
+        test_exprbatch_name(&e[6], 'g');
+        test_exprbatch_op(&e[0], op, &e[6], &e[6]);
+        if((res_line = test_exprbatch_match(e, cols, NULL, EXPRBATCH_SIZE, bbuf, vbuf)) != 0) return res_line;
+        test_exprbatch_op(&e[0], op, &e[6], &e[2]);
+        if((res_line = test_exprbatch_match(e, cols, sel, n, bbuf, vbuf)) != 0) return res_line;
+        test_exprbatch_op(&e[0], op, &e[2], &e[5]);
+        if((res_line = test_exprbatch_match(e, cols, NULL, EXPRBATCH_SIZE, bbuf, vbuf)) != 0) return res_line;
+        test_exprbatch_op(&e[0], op, &e[5], &e[5]);
+        if((res_line = test_exprbatch_match(e, cols, sel, n, bbuf, vbuf)) != 0) return res_line;
+        test_exprbatch_op(&e[0], op, &e[1], &e[4]);
+        if((res_line = test_exprbatch_match(e, cols, NULL, EXPRBATCH_SIZE, bbuf, vbuf)) != 0) return res_line;
+    }
+
+    // comparison with null element gives null
+    test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_LT, &e[2], &e[3]);
+    if((bh = exprbatch_compile(bbuf, e, vi)) == NULL) return __LINE__;
+    if(exprbatch_eval(bh, cols, NULL, EXPRBATCH_SIZE, &res) != 0) return __LINE__;
+    if(res->type != PARSER_EXPR_NODE_TYPE_BOOL) return __LINE__;
+    if(!EXPRBATCH_IS_NULL(res, 14) || EXPRBATCH_IS_NULL(res, 15)) return __LINE__;
+
+    // comparison with all-null operand gives all-null result
+    test_exprbatch_name(&e[3], 'f');
+    if((bh = exprbatch_compile(bbuf, e, vi)) == NULL) return __LINE__;
+    if(exprbatch_eval(bh, cols, NULL, EXPRBATCH_SIZE, &res) != 0) return __LINE__;
+    if(res->type != PARSER_EXPR_NODE_TYPE_NULL) return __LINE__;
+    test_exprbatch_name(&e[3], 'b');
+
+
+    puts("Testing IS NULL and BETWEEN");
+
+    // a IS NULL, a IS NOT NULL
+    e[6].node_type = PARSER_EXPR_NODE_TYPE_NULL;
+    for(parser_expr_op_type op = PARSER_EXPR_OP_TYPE_IS; op <= PARSER_EXPR_OP_TYPE_IS_NOT; op++)
+    {
+        test_exprbatch_op(&e[0], op, &e[2], &e[6]);
+        if((bh = exprbatch_compile(bbuf, e, vi)) == NULL) return __LINE__;
+        if(exprbatch_eval(bh, cols, NULL, EXPRBATCH_SIZE, &res) != 0) return __LINE__;
+        if(res->type != PARSER_EXPR_NODE_TYPE_BOOL) return __LINE__;
+        for(i = 0; i < EXPRBATCH_SIZE; i++)
+        {
+            if(EXPRBATCH_IS_NULL(res, i)) return __LINE__;
+            if(res->boolean[i] != ((i % 7 == 0) ^ (op == PARSER_EXPR_OP_TYPE_IS_NOT))) return __LINE__;
+        }
+        if((res_line = test_exprbatch_match(e, cols, sel, n, bbuf, vbuf)) != 0) return res_line;
+    }
+
+    // a IS c
+    test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_IS, &e[2], &e[5]);
+    if((res_line = test_exprbatch_match(e, cols, NULL, EXPRBATCH_SIZE, bbuf, vbuf)) != 0) return res_line;
+
+    // a BETWEEN -100 AND 100
+    test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_BETWEEN, &e[2], &e[7]);
+    test_exprbatch_op(&e[7], PARSER_EXPR_OP_TYPE_AND, &e[8], &e[9]);
+    test_exprbatch_int(&e[8], -100);
+    test_exprbatch_int(&e[9], 100);
+    if((bh = exprbatch_compile(bbuf, e, vi)) == NULL) return __LINE__;
+    if(exprbatch_eval(bh, cols, NULL, EXPRBATCH_SIZE, &res) != 0) return __LINE__;
+    if(res->type != PARSER_EXPR_NODE_TYPE_BOOL) return __LINE__;
+    for(i = 0; i < EXPRBATCH_SIZE; i++)
+    {
+        // null a gives null from both comparisons
+        if(EXPRBATCH_IS_NULL(res, i) != (i % 7 == 0)) return __LINE__;
+        if(i % 7 != 0 && res->boolean[i] != (ints_a[i] >= -100 && ints_a[i] <= 100)) return __LINE__;
+    }
+    if((res_line = test_exprbatch_match(e, cols, sel, n, bbuf, vbuf)) != 0) return res_line;
+
+    // between bounds must be AND node
+    test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_BETWEEN, &e[2], &e[8]);
+    if(exprbatch_compile(bbuf, e, vi) != NULL) return __LINE__;
+    if(error_get() != ERROR_SEMANTIC_ERROR) return __LINE__;
+
+
+    puts("Testing logical operations");
+
+    // d AND e, d OR e over all pairs of true, false, null
+    {
+        const uint8 and_res[9] = {0, 0, 0, 0, 1, 2, 0, 2, 2}, or_res[9] = {0, 1, 2, 1, 1, 1, 2, 1, 2};     // 2 is null
+
+        test_exprbatch_name(&e[1], 'd');
+        test_exprbatch_name(&e[2], 'e');
+        for(parser_expr_op_type op = PARSER_EXPR_OP_TYPE_AND; op <= PARSER_EXPR_OP_TYPE_OR; op++)
+        {
+            const uint8 *expected = op == PARSER_EXPR_OP_TYPE_AND ? and_res : or_res;
+
+            test_exprbatch_op(&e[0], op, &e[1], &e[2]);
+            if((bh = exprbatch_compile(bbuf, e, vi)) == NULL) return __LINE__;
+            if(exprbatch_eval(bh, cols, NULL, 9, &res) != 0) return __LINE__;
+            if(res->type != PARSER_EXPR_NODE_TYPE_BOOL) return __LINE__;
+            for(i = 0; i < 9; i++)
+            {
+                if(EXPRBATCH_IS_NULL(res, i) != (expected[i] == 2)) return __LINE__;
+                if(expected[i] != 2 && res->boolean[i] != expected[i]) return __LINE__;
+            }
+
+            // d <op> f: f is all-null
+            test_exprbatch_name(&e[2], 'f');
+            if((bh = exprbatch_compile(bbuf, e, vi)) == NULL) return __LINE__;
+            if(exprbatch_eval(bh, cols, NULL, 9, &res) != 0) return __LINE__;
+            for(i = 0; i < 9; i++)
+            {
+                if(EXPRBATCH_IS_NULL(res, i) != (expected[i / 3 * 3 + 2] == 2)) return __LINE__;
+                if(expected[i / 3 * 3 + 2] != 2 && res->boolean[i] != expected[i / 3 * 3 + 2]) return __LINE__;
+            }
+            test_exprbatch_name(&e[2], 'e');
+        }
+
+        // NOT d
+        test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_NOT, &e[1], NULL);
+        if((bh = exprbatch_compile(bbuf, e, vi)) == NULL) return __LINE__;
+        if(exprbatch_eval(bh, cols, NULL, 9, &res) != 0) return __LINE__;
+        for(i = 0; i < 9; i++)
+        {
+            if(EXPRBATCH_IS_NULL(res, i) != (i >= 6)) return __LINE__;
+            if(i < 6 && res->boolean[i] != (bools_d[i] ^ 1)) return __LINE__;
+        }
+
+        // a AND d
+        test_exprbatch_name(&e[2], 'a');
+        test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_AND, &e[2], &e[1]);
+        if((bh = exprbatch_compile(bbuf, e, vi)) == NULL) return __LINE__;
+        if(exprbatch_eval(bh, cols, NULL, 9, &res) == 0) return __LINE__;
+        if(error_get() != ERROR_DATATYPE_MISMATCH) return __LINE__;
+    }
+
+
+    puts("Testing NOT, AND, OR over null comparisons against expression tree and exprvm");
+
+    // comparison with null gives null, so NOT of it is null too and only AND/OR with deciding operand is known
+    {
+        parser_ast_expr s[12];
+
+        // a > 5, c < 0
+        test_exprbatch_op(&s[1], PARSER_EXPR_OP_TYPE_GT, &s[2], &s[3]);
+        test_exprbatch_name(&s[2], 'a');
+        test_exprbatch_int(&s[3], 5);
+        test_exprbatch_op(&s[4], PARSER_EXPR_OP_TYPE_LT, &s[5], &s[6]);
+        test_exprbatch_name(&s[5], 'c');
+        test_exprbatch_int(&s[6], 0);
+
+        // NOT (a > 5)
+        test_exprbatch_op(&s[0], PARSER_EXPR_OP_TYPE_NOT, &s[1], NULL);
+        if((bh = exprbatch_compile(bbuf, s, vi)) == NULL) return __LINE__;
+        if(exprbatch_eval(bh, cols, NULL, EXPRBATCH_SIZE, &res) != 0) return __LINE__;
+        if(!EXPRBATCH_IS_NULL(res, 0) || !EXPRBATCH_IS_NULL(res, 7)) return __LINE__;
+        if((res_line = test_exprbatch_match_tree(s, 7, cols, EXPRBATCH_SIZE, bbuf, sh)) != 0) return res_line;
+        if((res_line = test_exprbatch_match(s, cols, sel, n, bbuf, vbuf)) != 0) return res_line;
+
+        // (a > 5) AND (c < 0), (a > 5) OR (c < 0)
+        for(parser_expr_op_type op = PARSER_EXPR_OP_TYPE_AND; op <= PARSER_EXPR_OP_TYPE_OR; op++)
+        {
+            test_exprbatch_op(&s[0], op, &s[1], &s[4]);
+            if((res_line = test_exprbatch_match_tree(s, 7, cols, EXPRBATCH_SIZE, bbuf, sh)) != 0) return res_line;
+            if((res_line = test_exprbatch_match(s, cols, NULL, EXPRBATCH_SIZE, bbuf, vbuf)) != 0) return res_line;
+        }
+
+        // NOT ((a > 5) OR NOT (c < 0))
+        test_exprbatch_op(&s[0], PARSER_EXPR_OP_TYPE_NOT, &s[7], NULL);
+        test_exprbatch_op(&s[7], PARSER_EXPR_OP_TYPE_OR, &s[1], &s[8]);
+        test_exprbatch_op(&s[8], PARSER_EXPR_OP_TYPE_NOT, &s[4], NULL);
+        if((res_line = test_exprbatch_match_tree(s, 9, cols, EXPRBATCH_SIZE, bbuf, sh)) != 0) return res_line;
+        if((res_line = test_exprbatch_match(s, cols, sel, n, bbuf, vbuf)) != 0) return res_line;
+
+        // (a > 5) AND NOT (c < 0 OR g > 5)
+        test_exprbatch_op(&s[0], PARSER_EXPR_OP_TYPE_AND, &s[1], &s[7]);
+        test_exprbatch_op(&s[7], PARSER_EXPR_OP_TYPE_NOT, &s[8], NULL);
+        test_exprbatch_op(&s[8], PARSER_EXPR_OP_TYPE_OR, &s[4], &s[9]);
+        test_exprbatch_op(&s[9], PARSER_EXPR_OP_TYPE_GT, &s[10], &s[3]);
+        test_exprbatch_name(&s[10], 'g');
+        if((res_line = test_exprbatch_match_tree(s, 11, cols, EXPRBATCH_SIZE, bbuf, sh)) != 0) return res_line;
+        if((res_line = test_exprbatch_match(s, cols, NULL, EXPRBATCH_SIZE, bbuf, vbuf)) != 0) return res_line;
+
+        // NOT (g = f) OR b > 10: f is all-null
+        test_exprbatch_op(&s[0], PARSER_EXPR_OP_TYPE_OR, &s[7], &s[1]);
+        test_exprbatch_op(&s[7], PARSER_EXPR_OP_TYPE_NOT, &s[8], NULL);
+        test_exprbatch_op(&s[8], PARSER_EXPR_OP_TYPE_EQ, &s[9], &s[10]);
+        test_exprbatch_name(&s[9], 'g');
+        test_exprbatch_name(&s[10], 'f');
+        test_exprbatch_name(&s[2], 'b');
+        test_exprbatch_int(&s[3], 10);
+        if((res_line = test_exprbatch_match_tree(s, 11, cols, EXPRBATCH_SIZE, bbuf, sh)) != 0) return res_line;
+        if((res_line = test_exprbatch_match(s, cols, sel, n, bbuf, vbuf)) != 0) return res_line;
+
+        // filter selects only true elements, null result of NOT (a > 5) is not selected
+        test_exprbatch_op(&s[0], PARSER_EXPR_OP_TYPE_NOT, &s[1], NULL);
+        test_exprbatch_name(&s[2], 'a');
+        test_exprbatch_int(&s[3], 5);
+        {
+            uint16 out[EXPRBATCH_SIZE], out_n, expected_n = 0;
+
+            if((bh = exprbatch_compile(bbuf, s, vi)) == NULL) return __LINE__;
+            if(exprbatch_filter(bh, cols, NULL, EXPRBATCH_SIZE, out, &out_n) != 0) return __LINE__;
+            for(i = 0; i < EXPRBATCH_SIZE; i++)
+            {
+                if(i % 7 == 0 || ints_a[i] > 5) continue;
+                if(expected_n >= out_n || out[expected_n] != i) return __LINE__;
+                expected_n++;
+            }
+            if(expected_n != out_n) return __LINE__;
+        }
+    }
+
+
+    puts("Testing short-circuit");
+
+    // bitmaps of d: elements 0-2 are false, 3-5 are true, 6-8 are null
+    {
+        exprbatch_bool_bitmap bm;
+        exprbatch_vector v;
+        uint8 bools[EXPRBATCH_SIZE];
+
+        exprbatch_bool_to_bitmap(&cols[3], 1, &bm);
+        if((bm.true_bits[0] & 0x1FF) != 0x038 || (bm.false_bits[0] & 0x1FF) != 0x007) return __LINE__;
+
+        v.boolean = bools;
+        exprbatch_bitmap_to_bool(&bm, &v, 1);
+        if(v.type != PARSER_EXPR_NODE_TYPE_BOOL) return __LINE__;
+        for(i = 0; i < 9; i++)
+        {
+            if(EXPRBATCH_IS_NULL(&v, i) != (i >= 6)) return __LINE__;
+            if(i < 6 && v.boolean[i] != bools_d[i]) return __LINE__;
+        }
+
+        exprbatch_bool_to_bitmap(&cols[5], 1, &bm);
+        if(bm.true_bits[0] != 0 || bm.false_bits[0] != 0) return __LINE__;
+    }
+
+    // b > 50 and (b = 95 or 1000 / (b - 95) > 0): division by zero is never evaluated
+    {
+        parser_ast_expr s[12];
+
+        test_exprbatch_op(&s[0], PARSER_EXPR_OP_TYPE_AND, &s[1], &s[4]);
+        test_exprbatch_op(&s[1], PARSER_EXPR_OP_TYPE_GT, &s[2], &s[3]);
+        test_exprbatch_name(&s[2], 'b');
+        test_exprbatch_int(&s[3], 50);
+        test_exprbatch_op(&s[4], PARSER_EXPR_OP_TYPE_OR, &s[5], &s[7]);
+        test_exprbatch_op(&s[5], PARSER_EXPR_OP_TYPE_EQ, &s[2], &s[6]);
+        test_exprbatch_int(&s[6], 95);
+        test_exprbatch_op(&s[7], PARSER_EXPR_OP_TYPE_GT, &s[8], &s[11]);
+        test_exprbatch_op(&s[8], PARSER_EXPR_OP_TYPE_DIV, &s[9], &s[10]);
+        test_exprbatch_int(&s[9], 1000);
+        test_exprbatch_op(&s[10], PARSER_EXPR_OP_TYPE_SUB, &s[2], &s[6]);
+        test_exprbatch_int(&s[11], 0);
+
+        if((bh = exprbatch_compile(bbuf, s, vi)) == NULL) return __LINE__;
+        if(exprbatch_eval(bh, cols, NULL, EXPRBATCH_SIZE, &res) != 0) return __LINE__;
+        if(res->type != PARSER_EXPR_NODE_TYPE_BOOL) return __LINE__;
+        for(i = 0; i < EXPRBATCH_SIZE; i++)
+        {
+            if(EXPRBATCH_IS_NULL(res, i) || res->boolean[i] != (ints_b[i] >= 95)) return __LINE__;
+        }
+        if((res_line = test_exprbatch_match(s, cols, sel, n, bbuf, vbuf)) != 0) return res_line;
+
+        // b > 1000 and ...: right operand is skipped for the whole batch
+        test_exprbatch_int(&s[3], 1000);
+        if((bh = exprbatch_compile(bbuf, s, vi)) == NULL) return __LINE__;
+        if(exprbatch_eval(bh, cols, sel, n, &res) != 0) return __LINE__;
+        if(res->type != PARSER_EXPR_NODE_TYPE_BOOL) return __LINE__;
+        for(i = 0; i < n; i++)
+        {
+            if(EXPRBATCH_IS_NULL(res, sel[i]) || res->boolean[sel[i]] != 0) return __LINE__;
+        }
+
+        // without short-circuit division by zero fails the batch
+        test_exprbatch_op(&s[4], PARSER_EXPR_OP_TYPE_AND, &s[5], &s[7]);
+        test_exprbatch_int(&s[3], 0);
+        if((bh = exprbatch_compile(bbuf, s, vi)) == NULL) return __LINE__;
+        if(exprbatch_eval(bh, cols, NULL, EXPRBATCH_SIZE, &res) == 0) return __LINE__;
+        if(error_get() != ERROR_DIVISION_BY_ZERO) return __LINE__;
+    }
+
+
+    puts("Testing LIKE against exprvm");
+
+    {
+        static const char *words[] = {"Berlin", "berlin", "Bern", "Paris", "Parma", "Oslo", "Zurich", "Bergen"};
+        static const char *patterns[] = {"Ber%", "%is", "%er%", "B_r%n", "%", "Bern"};
+        void *strs[EXPRBATCH_SIZE];
+        handle words_sl[8], pattern_sl, escape_sl;
+
+        // h is string, every 5th h is null
+        cols[7].type = PARSER_EXPR_NODE_TYPE_STR;
+        cols[7].str = strs;
+        for(i = 0; i < 8; i++)
+        {
+            if((words_sl[i] = string_literal_create(malloc(string_literal_alloc_sz()))) == NULL) return __LINE__;
+            if(string_literal_append_char(words_sl[i], (const uint8 *)words[i], (uint32)strlen(words[i])) != 0) return __LINE__;
+        }
+        for(i = 0; i < EXPRBATCH_SIZE; i++)
+        {
+            strs[i] = words_sl[rand() % 8];
+            if(i % 5 == 0) EXPRBATCH_SET_NULL(&cols[7], i);
+        }
+        if((pattern_sl = string_literal_create(malloc(string_literal_alloc_sz()))) == NULL) return __LINE__;
+        if((escape_sl = string_literal_create(malloc(string_literal_alloc_sz()))) == NULL) return __LINE__;
+        if(string_literal_append_char(escape_sl, (const uint8 *)"!", 1) != 0) return __LINE__;
+
+        // h [NOT] LIKE pattern [ESCAPE '!']
+        test_exprbatch_name(&e[1], 'h');
+        e[2].node_type = PARSER_EXPR_NODE_TYPE_STR;
+        e[2].str = pattern_sl;
+        e[4].node_type = PARSER_EXPR_NODE_TYPE_STR;
+        e[4].str = escape_sl;
+        for(uint32 p = 0; p < 6 * 4; p++)
+        {
+            if(string_literal_truncate(pattern_sl) != 0) return __LINE__;
+            if(string_literal_append_char(pattern_sl, (const uint8 *)patterns[p % 6], (uint32)strlen(patterns[p % 6])) != 0) return __LINE__;
+            test_exprbatch_op(&e[3], PARSER_EXPR_OP_TYPE_ESCAPE, &e[2], &e[4]);
+            test_exprbatch_op(&e[0], p / 6 % 2 ? PARSER_EXPR_OP_TYPE_NOT_LIKE : PARSER_EXPR_OP_TYPE_LIKE, &e[1], p / 12 ? &e[3] : &e[2]);
+            if((res_line = test_exprbatch_match(e, cols, NULL, EXPRBATCH_SIZE, bbuf, vbuf)) != 0) return res_line;
+            if((res_line = test_exprbatch_match(e, cols, sel, n, bbuf, vbuf)) != 0) return res_line;
+        }
+
+        // 'Bern' LIKE h is not supported, null pattern gives null
+        test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_LIKE, &e[2], &e[1]);
+        if(exprbatch_compile(bbuf, e, vi) != NULL) return __LINE__;
+        if(error_get() != ERROR_SEMANTIC_ERROR) return __LINE__;
+        e[2].node_type = PARSER_EXPR_NODE_TYPE_NULL;
+        test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_LIKE, &e[1], &e[2]);
+        if((bh = exprbatch_compile(bbuf, e, vi)) == NULL) return __LINE__;
+        if(exprbatch_eval(bh, cols, NULL, EXPRBATCH_SIZE, &res) != 0) return __LINE__;
+        if(res->type != PARSER_EXPR_NODE_TYPE_NULL) return __LINE__;
+
+        // invalid escape sequence
+        e[2].node_type = PARSER_EXPR_NODE_TYPE_STR;
+        if(string_literal_append_char(pattern_sl, (const uint8 *)"!a", 2) != 0) return __LINE__;
+        test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_LIKE, &e[1], &e[3]);
+        if(exprbatch_compile(bbuf, e, vi) != NULL) return __LINE__;
+        if(error_get() != ERROR_INVALID_ESCAPE) return __LINE__;
+
+        for(i = 0; i < 8; i++)
+        {
+            string_literal_destroy(words_sl[i]);
+            free(words_sl[i]);
+        }
+        string_literal_destroy(pattern_sl);
+        free(pattern_sl);
+        string_literal_destroy(escape_sl);
+        free(escape_sl);
+        cols[7].type = PARSER_EXPR_NODE_TYPE_NULL;
+        memset(cols[7].nulls, 0xFF, sizeof(cols[7].nulls));
+    }
+
+
+    puts("Testing filter");
+
+    // a > 0 AND b < 50 over selection, result overwrites selection
+    test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_AND, &e[1], &e[4]);
+    test_exprbatch_op(&e[1], PARSER_EXPR_OP_TYPE_GT, &e[2], &e[3]);
+    test_exprbatch_name(&e[2], 'a');
+    test_exprbatch_int(&e[3], 0);
+    test_exprbatch_op(&e[4], PARSER_EXPR_OP_TYPE_LT, &e[5], &e[6]);
+    test_exprbatch_name(&e[5], 'b');
+    test_exprbatch_int(&e[6], 50);
+    if((bh = exprbatch_compile(bbuf, e, vi)) == NULL) return __LINE__;
+
+    {
+        uint16 out[EXPRBATCH_SIZE], out_n, expected_n = 0;
+
+        if(exprbatch_filter(bh, cols, NULL, EXPRBATCH_SIZE, out, &out_n) != 0) return __LINE__;
+        for(i = 0; i < EXPRBATCH_SIZE; i++)
+        {
+            if(i % 7 == 0 || ints_a[i] <= 0 || ints_b[i] >= 50) continue;
+            if(expected_n >= out_n || out[expected_n++] != i) return __LINE__;
+        }
+        if(expected_n != out_n) return __LINE__;
+
+        expected_n = 0;
+        for(i = 0; i < n; i++)
+        {
+            if(sel[i] % 7 == 0 || ints_a[sel[i]] <= 0 || ints_b[sel[i]] >= 50) continue;
+            out[expected_n++] = sel[i];
+        }
+        if(exprbatch_filter(bh, cols, sel, n, sel, &n) != 0) return __LINE__;
+        if(n != expected_n || memcmp(out, sel, n * sizeof(uint16)) != 0) return __LINE__;
+    }
+
+    // a + b is not boolean
+    test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_ADD, &e[2], &e[5]);
+    if((bh = exprbatch_compile(bbuf, e, vi)) == NULL) return __LINE__;
+    if(exprbatch_filter(bh, cols, NULL, EXPRBATCH_SIZE, sel, &n) == 0) return __LINE__;
+    if(error_get() != ERROR_DATATYPE_MISMATCH) return __LINE__;
+
+    free(ints_a);
+    free(ints_b);
+    free(nums);
+    free(floats);
+    free(bbuf);
+    free(vbuf);
+    free(sh);
+
+    return 0;
+}
+
+
+#define BENCH_EXPRBATCH_ROWS    (1024 * 1024)
+
+
+int bench_exprbatch_functions()
+{
+    puts("Starting benchmark bench_exprbatch_functions");
+
+    parser_ast_expr e[9];
+    exprbatch_vector cols[3];
+    exprvm_value row[3], res;
+    exprvm_interface vi = {test_exprbatch_resolve_name};
+    struct timeval t1;
+    uint64 vm_selected, batch_selected;
+    uint16 sel[EXPRBATCH_SIZE], n;
+    handle bh, vh;
+    void *bbuf = malloc(exprbatch_get_alloc_sz()), *vbuf = malloc(exprvm_get_alloc_sz());
+    sint64 *ints = (sint64 *)malloc(sizeof(sint64) * EXPRBATCH_SIZE * 3);
+    decimal *nums = (decimal *)malloc(sizeof(decimal) * EXPRBATCH_SIZE * 3);
+    if(NULL == bbuf || NULL == vbuf || NULL == ints || NULL == nums) return __LINE__;
+
+    // a * b + 9 - c >= 42
+    test_exprbatch_op(&e[0], PARSER_EXPR_OP_TYPE_GE, &e[1], &e[8]);
+    test_exprbatch_op(&e[1], PARSER_EXPR_OP_TYPE_SUB, &e[2], &e[7]);
+    test_exprbatch_op(&e[2], PARSER_EXPR_OP_TYPE_ADD, &e[3], &e[6]);
+    test_exprbatch_op(&e[3], PARSER_EXPR_OP_TYPE_MUL, &e[4], &e[5]);
+    test_exprbatch_name(&e[4], 'a');
+    test_exprbatch_name(&e[5], 'b');
+    test_exprbatch_int(&e[6], 9);
+    test_exprbatch_name(&e[7], 'c');
+    test_exprbatch_int(&e[8], 42);
+    if((bh = exprbatch_compile(bbuf, e, vi)) == NULL) return __LINE__;
+    if((vh = exprvm_compile(vbuf, e, vi)) == NULL) return __LINE__;
+
+    memset(cols, 0, sizeof(cols));
+
+    for(uint8 integers = 1; integers <= 1; integers--)
+    {
+        // column values are the same in every batch
+        for(int c = 0; c < 3; c++)
+        {
+            cols[c].type = integers ? PARSER_EXPR_NODE_TYPE_INT : PARSER_EXPR_NODE_TYPE_NUM;
+            cols[c].integer = ints + c * EXPRBATCH_SIZE;
+            if(!integers) cols[c].num = nums + c * EXPRBATCH_SIZE;
+        }
+        for(sint64 i = 0; i < EXPRBATCH_SIZE; i++)
+        {
+            sint64 vals[3] = {i & 0xF, i >> 4, i};
+            for(int c = 0; c < 3; c++)
+            {
+                ints[c * EXPRBATCH_SIZE + i] = vals[c];
+                decimal_from_int64(vals[c], nums + c * EXPRBATCH_SIZE + i);
+            }
+        }
+
+        puts(integers ? "Benchmarking row-at-a-time bytecode on integer rows" : "Benchmarking row-at-a-time bytecode on decimal rows");
+
+        vm_selected = 0;
+        gettimeofday(&t1, NULL);
+        for(uint32 i = 0; i < BENCH_EXPRBATCH_ROWS; i++)
+        {
+            for(int c = 0; c < 3; c++)
+            {
+                row[c].type = cols[c].type;
+                if(integers) row[c].integer = cols[c].integer[i % EXPRBATCH_SIZE];
+                else row[c].num = cols[c].num[i % EXPRBATCH_SIZE];
+            }
+            if(0 != exprvm_eval(vh, row, &res)) return __LINE__;
+            vm_selected += res.boolean;
+        }
+        printf("Elapsed: %ld ms.\n", bench_elapsed_ms(&t1));
+
+        puts(integers ? "Benchmarking batch filter on integer rows" : "Benchmarking batch filter on decimal rows");
+
+        batch_selected = 0;
+        gettimeofday(&t1, NULL);
+        for(uint32 i = 0; i < BENCH_EXPRBATCH_ROWS; i += EXPRBATCH_SIZE)
+        {
+            if(0 != exprbatch_filter(bh, cols, NULL, EXPRBATCH_SIZE, sel, &n)) return __LINE__;
+            batch_selected += n;
+        }
+        printf("Elapsed: %ld ms.\n", bench_elapsed_ms(&t1));
+
+        if(vm_selected != batch_selected) return __LINE__;
+    }
+
+    free(bbuf);
+    free(vbuf);
+    free(ints);
+    free(nums);
+
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include "tests.h"
 #include "execution/expression.h"
+#include "parser/lexer.h"
 #include "common/error.h"
 #include "common/stack.h"
 #include "common/string_literal.h"
@@ -297,6 +298,89 @@ int test_expression_functions()
     if(e[0].node_type != PARSER_EXPR_NODE_TYPE_BOOL) return __LINE__;
     if(e[0].boolean != 1) return __LINE__;
 
+    // null and false, null and true, null or true, null or false: known operand decides the result
+    {
+        struct
+        {
+            parser_expr_op_type op;
+            uint8               other;
+            uint8               expected_res;   // 2 is null
+        } null_res[4] =
+        {
+            {PARSER_EXPR_OP_TYPE_AND, 0, 0},
+            {PARSER_EXPR_OP_TYPE_AND, 1, 2},
+            {PARSER_EXPR_OP_TYPE_OR,  1, 1},
+            {PARSER_EXPR_OP_TYPE_OR,  0, 2}
+        };
+
+        for(int i = 0; i < 4; i++)
+        {
+            for(int null_left = 0; null_left < 2; null_left++)
+            {
+                e[0].node_type = PARSER_EXPR_NODE_TYPE_OP;
+                e[0].op = null_res[i].op;
+                e[0].left = null_left ? &e[2] : &e[1];
+                e[0].right = null_left ? &e[1] : &e[2];
+
+                e[1].node_type = PARSER_EXPR_NODE_TYPE_BOOL;
+                e[1].boolean = null_res[i].other;
+
+                e[2].node_type = PARSER_EXPR_NODE_TYPE_NULL;
+
+                if(0 != expression_calc_base_expr(e, 0)) return __LINE__;
+                if(null_res[i].expected_res == 2)
+                {
+                    if(e[0].node_type != PARSER_EXPR_NODE_TYPE_NULL) return __LINE__;
+                }
+                else
+                {
+                    if(e[0].node_type != PARSER_EXPR_NODE_TYPE_BOOL) return __LINE__;
+                    if(e[0].boolean != null_res[i].expected_res) return __LINE__;
+                }
+            }
+        }
+    }
+
+    // not null
+    e[0].node_type = PARSER_EXPR_NODE_TYPE_OP;
+    e[0].op = PARSER_EXPR_OP_TYPE_NOT;
+    e[0].left = &e[1];
+    e[0].right = NULL;
+
+    e[1].node_type = PARSER_EXPR_NODE_TYPE_NULL;
+
+    if(0 != expression_calc_base_expr(e, 0)) return __LINE__;
+    if(e[0].node_type != PARSER_EXPR_NODE_TYPE_NULL) return __LINE__;
+
+    // false and <name>: right operand is not needed
+    e[0].node_type = PARSER_EXPR_NODE_TYPE_OP;
+    e[0].op = PARSER_EXPR_OP_TYPE_AND;
+    e[0].left = &e[1];
+    e[0].right = &e[2];
+
+    e[1].node_type = PARSER_EXPR_NODE_TYPE_BOOL;
+    e[1].boolean = 0;
+
+    e[2].node_type = PARSER_EXPR_NODE_TYPE_NAME;
+    e[2].name.first_part_len = 1;
+    e[2].name.second_part_len = 0;
+
+    if(0 != expression_calc_base_expr(e, 1)) return __LINE__;
+    if(e[0].node_type != PARSER_EXPR_NODE_TYPE_BOOL) return __LINE__;
+    if(e[0].boolean != 0) return __LINE__;
+
+    // true and <name> is kept
+    e[0].node_type = PARSER_EXPR_NODE_TYPE_OP;
+    e[0].op = PARSER_EXPR_OP_TYPE_AND;
+    e[0].left = &e[1];
+    e[0].right = &e[2];
+
+    e[1].boolean = 1;
+
+    if(0 != expression_calc_base_expr(e, 1)) return __LINE__;
+    if(e[0].node_type != PARSER_EXPR_NODE_TYPE_OP) return __LINE__;
+    if(e[0].op != PARSER_EXPR_OP_TYPE_AND) return __LINE__;
+
     // 1 <op> 2 / 2 <op> 1 / 2 <op> 2
     struct
     {
@@ -459,6 +543,125 @@ int test_expression_functions()
     }
 
 
+    puts("Testing expression_calc_base_expr with integers");
+
+    // 7 * -6
+    e[0].node_type = PARSER_EXPR_NODE_TYPE_OP;
+    e[0].op = PARSER_EXPR_OP_TYPE_MUL;
+    e[0].left = &e[1];
+    e[0].right = &e[2];
+    e[1].node_type = PARSER_EXPR_NODE_TYPE_INT;
+    e[1].integer = 7;
+    e[2].node_type = PARSER_EXPR_NODE_TYPE_INT;
+    e[2].integer = -6;
+
+    if(0 != expression_calc_base_expr(e, 0)) return __LINE__;
+    if(e[0].node_type != PARSER_EXPR_NODE_TYPE_INT) return __LINE__;
+    if(e[0].integer != -42) return __LINE__;
+
+    // overflow turns into decimal: 9223372036854775807 + 1
+    e[0].node_type = PARSER_EXPR_NODE_TYPE_OP;
+    e[0].op = PARSER_EXPR_OP_TYPE_ADD;
+    e[1].integer = 0x7FFFFFFFFFFFFFFFL;
+    e[2].integer = 1;
+
+    if(0 != expression_calc_base_expr(e, 0)) return __LINE__;
+    if(e[0].node_type != PARSER_EXPR_NODE_TYPE_NUM) return __LINE__;
+    if(e[0].num.sign != DECIMAL_SIGN_POS || e[0].num.n != 19 || e[0].num.e != 0) return __LINE__;
+    if(e[0].num.m[4] != 922 || e[0].num.m[0] != 5808) return __LINE__;
+
+    // division gives decimal: 1 / 4
+    e[0].node_type = PARSER_EXPR_NODE_TYPE_OP;
+    e[0].op = PARSER_EXPR_OP_TYPE_DIV;
+    e[1].integer = 1;
+    e[2].integer = 4;
+
+    if(0 != expression_calc_base_expr(e, 0)) return __LINE__;
+    if(e[0].node_type != PARSER_EXPR_NODE_TYPE_NUM) return __LINE__;
+    memset(&e[3].num, 0, sizeof(e[3].num));
+    e[3].num.sign = DECIMAL_SIGN_POS;
+    e[3].num.m[0] = 25;
+    e[3].num.n = 2;
+    e[3].num.e = -2;
+    if(decimal_cmp(&e[0].num, &e[3].num) != 0) return __LINE__;
+
+    // mixed: 3 - 0.5, 2 >= 2.0, 2 is 2.0
+    e[0].node_type = PARSER_EXPR_NODE_TYPE_OP;
+    e[0].op = PARSER_EXPR_OP_TYPE_SUB;
+    e[1].integer = 3;
+    e[2].node_type = PARSER_EXPR_NODE_TYPE_NUM;
+    memset(&e[2].num, 0, sizeof(e[2].num));
+    e[2].num.sign = DECIMAL_SIGN_POS;
+    e[2].num.m[0] = 5;
+    e[2].num.n = 1;
+    e[2].num.e = -1;
+
+    if(0 != expression_calc_base_expr(e, 0)) return __LINE__;
+    if(e[0].node_type != PARSER_EXPR_NODE_TYPE_NUM) return __LINE__;
+    e[3].num.e = -1;
+    if(decimal_cmp(&e[0].num, &e[3].num) != 0) return __LINE__;
+
+    e[0].node_type = PARSER_EXPR_NODE_TYPE_OP;
+    e[0].op = PARSER_EXPR_OP_TYPE_GE;
+    e[1].integer = 2;
+    e[2].num.m[0] = 20;
+    e[2].num.n = 2;
+
+    if(0 != expression_calc_base_expr(e, 0)) return __LINE__;
+    if(e[0].node_type != PARSER_EXPR_NODE_TYPE_BOOL) return __LINE__;
+    if(e[0].boolean != 1) return __LINE__;
+
+    e[0].node_type = PARSER_EXPR_NODE_TYPE_OP;
+    e[0].op = PARSER_EXPR_OP_TYPE_IS;
+
+    if(0 != expression_calc_base_expr(e, 0)) return __LINE__;
+    if(e[0].node_type != PARSER_EXPR_NODE_TYPE_BOOL) return __LINE__;
+    if(e[0].boolean != 1) return __LINE__;
+
+
+    puts("Testing expression_calc_base_expr with floats");
+
+    // 2.0 is 2.5 - 0.5: float operand makes the result float
+    e[0].node_type = PARSER_EXPR_NODE_TYPE_OP;
+    e[0].op = PARSER_EXPR_OP_TYPE_SUB;
+    e[1].node_type = PARSER_EXPR_NODE_TYPE_FLOAT;
+    e[1].fp = 2.5;
+    e[2].num.m[0] = 5;
+    e[2].num.n = 1;
+
+    if(0 != expression_calc_base_expr(e, 0)) return __LINE__;
+    if(e[0].node_type != PARSER_EXPR_NODE_TYPE_FLOAT) return __LINE__;
+    if(e[0].fp != 2.0) return __LINE__;
+
+    // 2.5 > 3
+    e[0].node_type = PARSER_EXPR_NODE_TYPE_OP;
+    e[0].op = PARSER_EXPR_OP_TYPE_GT;
+    e[2].node_type = PARSER_EXPR_NODE_TYPE_INT;
+    e[2].integer = 3;
+
+    if(0 != expression_calc_base_expr(e, 0)) return __LINE__;
+    if(e[0].node_type != PARSER_EXPR_NODE_TYPE_BOOL) return __LINE__;
+    if(e[0].boolean != 0) return __LINE__;
+
+    // 2.5 / 0
+    e[0].node_type = PARSER_EXPR_NODE_TYPE_OP;
+    e[0].op = PARSER_EXPR_OP_TYPE_DIV;
+    e[2].integer = 0;
+
+    if(0 == expression_calc_base_expr(e, 0)) return __LINE__;
+    if(error_get() != ERROR_DIVISION_BY_ZERO) return __LINE__;
+
+    // 1e300 * 1e300
+    e[0].node_type = PARSER_EXPR_NODE_TYPE_OP;
+    e[0].op = PARSER_EXPR_OP_TYPE_MUL;
+    e[1].fp = 1e300;
+    e[2].node_type = PARSER_EXPR_NODE_TYPE_FLOAT;
+    e[2].fp = 1e300;
+
+    if(0 == expression_calc_base_expr(e, 0)) return __LINE__;
+    if(error_get() != ERROR_DECIMAL_OVERFLOW) return __LINE__;
+
+
     puts("Testing expression_calc_expr with constants only");
 
     // 4/2 + 5*3 > 0 and 1=1
@@ -555,6 +758,40 @@ int test_expression_functions()
     if(ee->node_type != PARSER_EXPR_NODE_TYPE_BOOL) return __LINE__;
     if(ee->boolean != 1) return __LINE__;
 
+    // true or 1 / 0 = 1: division by zero is never evaluated
+    // e[12] = 1, e[13] = 0
+    e[12].node_type = PARSER_EXPR_NODE_TYPE_INT;
+    e[12].integer = 1;
+    e[13].node_type = PARSER_EXPR_NODE_TYPE_INT;
+    e[13].integer = 0;
+
+    // e[14] = e[12] / e[13]
+    ee = e + 14;
+    ee->node_type = PARSER_EXPR_NODE_TYPE_OP;
+    ee->op = PARSER_EXPR_OP_TYPE_DIV;
+    ee->left = &e[12];
+    ee->right = &e[13];
+
+    // e[15] = e[14] = e[12]
+    ee = e + 15;
+    ee->node_type = PARSER_EXPR_NODE_TYPE_OP;
+    ee->op = PARSER_EXPR_OP_TYPE_EQ;
+    ee->left = &e[14];
+    ee->right = &e[12];
+
+    // e[16] = true, e[17] = e[16] OR e[15]
+    e[16].node_type = PARSER_EXPR_NODE_TYPE_BOOL;
+    e[16].boolean = 1;
+    ee = e + 17;
+    ee->node_type = PARSER_EXPR_NODE_TYPE_OP;
+    ee->op = PARSER_EXPR_OP_TYPE_OR;
+    ee->left = &e[16];
+    ee->right = &e[15];
+
+    if(0 != expression_calc_const_expr(ee, sh)) return __LINE__;
+    if(ee->node_type != PARSER_EXPR_NODE_TYPE_BOOL) return __LINE__;
+    if(ee->boolean != 1) return __LINE__;
+
 
 /*
     puts("Testing expression_calc_expr with names");
@@ -846,3 +1083,195 @@ int test_expression_functions()
 */
     return 0;
 }
+
+
+#define BENCH_EXPRESSION_REPEATS        (1000000)
+#define BENCH_EXPRESSION_ROWS           (20000)
+#define BENCH_EXPRESSION_LEX_REPEATS    (20)
+
+
+// build tree for (12345 * 678 + 9 - 1011121314) >= 42 in e[0..8], e[0] is root
+void bench_expression_build(parser_ast_expr *e, uint8 integers)
+{
+    static const sint64 vals[5] = {12345, 678, 9, 1011121314, 42};
+    static const uint8 leaf[5] = {4, 5, 6, 7, 8};
+
+    e[0].node_type = PARSER_EXPR_NODE_TYPE_OP; e[0].op = PARSER_EXPR_OP_TYPE_GE; e[0].left = &e[1]; e[0].right = &e[8];
+    e[1].node_type = PARSER_EXPR_NODE_TYPE_OP; e[1].op = PARSER_EXPR_OP_TYPE_SUB; e[1].left = &e[2]; e[1].right = &e[7];
+    e[2].node_type = PARSER_EXPR_NODE_TYPE_OP; e[2].op = PARSER_EXPR_OP_TYPE_ADD; e[2].left = &e[3]; e[2].right = &e[6];
+    e[3].node_type = PARSER_EXPR_NODE_TYPE_OP; e[3].op = PARSER_EXPR_OP_TYPE_MUL; e[3].left = &e[4]; e[3].right = &e[5];
+
+    for(int i = 0; i < 5; i++)
+    {
+        if(integers)
+        {
+            e[leaf[i]].node_type = PARSER_EXPR_NODE_TYPE_INT;
+            e[leaf[i]].integer = vals[i];
+        }
+        else
+        {
+            e[leaf[i]].node_type = PARSER_EXPR_NODE_TYPE_NUM;
+            decimal_from_int64(vals[i], &e[leaf[i]].num);
+        }
+    }
+}
+
+
+struct
+{
+    uint64                  cur_char;
+    uint64                  len;
+    const achar             *text;
+    encoding_build_char_fun build_char;
+} g_bench_expression_text = {0, 0, NULL, NULL};
+
+
+// feed characters of g_bench_expression_text to lexer
+sint8 bench_expression_char_feeder(char_info *ch, sint8 *eos)
+{
+    if(g_bench_expression_text.cur_char == g_bench_expression_text.len)
+    {
+        *eos = 1;
+    }
+    else
+    {
+        ch->length = 0u;
+        ch->ptr = 0u;
+        ch->state = CHAR_STATE_INCOMPLETE;
+        *eos = 0;
+        do
+        {
+            g_bench_expression_text.build_char(ch, g_bench_expression_text.text[g_bench_expression_text.cur_char++]);
+        }
+        while(ch->state != CHAR_STATE_COMPLETE);
+    }
+
+    return 0;
+}
+
+
+sint8 bench_expression_error_reporter(error_code error, const achar *msg)
+{
+    (void)error;
+    (void)msg;
+    return -1;
+}
+
+
+// lex every row of g_bench_expression_text and evaluate it as the tree of bench_expression_build,
+// numeric literals become leaves the way parser makes them, so integers stay integers unless decimal_mode is set
+// return number of rows evaluated or -1 on error
+sint64 bench_expression_lex_run(handle lexer, handle sh, uint8 decimal_mode)
+{
+    static const uint8 leaf[5] = {4, 5, 6, 7, 8};
+    parser_ast_expr tmpl[9], e[9];
+    lexer_lexem lexem;
+    sint64 rows = 0;
+    int k = 0;
+
+    bench_expression_build(tmpl, 1);
+    g_bench_expression_text.cur_char = 0;
+    if(0 != lexer_reset(lexer)) return -1;
+    lexer_num_mode_decimal(lexer, decimal_mode);
+    do
+    {
+        if(lexer_next(lexer, &lexem) != 0) return -1;
+        if(lexem.type == LEXEM_TYPE_NUM_LITERAL)
+        {
+            if(k == 0) memcpy(e, tmpl, sizeof(e));
+            if(k == 5) return -1;
+            if(lexem.integer_literal)
+            {
+                e[leaf[k]].node_type = PARSER_EXPR_NODE_TYPE_INT;
+                e[leaf[k]].integer = lexem.integer;
+            }
+            else
+            {
+                e[leaf[k]].node_type = PARSER_EXPR_NODE_TYPE_NUM;
+                memcpy(&e[leaf[k]].num, &lexem.num_literal, sizeof(e[leaf[k]].num));
+            }
+            k++;
+        }
+        else if(lexem.type == LEXEM_TYPE_TOKEN && lexem.token == LEXER_TOKEN_SEMICOLON)
+        {
+            if(k != 5) return -1;
+            if(0 != expression_calc_const_expr(e, sh)) return -1;
+            if(e[0].node_type != PARSER_EXPR_NODE_TYPE_BOOL || e[0].boolean != 0) return -1;
+            k = 0;
+            rows++;
+        }
+    }
+    while(lexem.type != LEXEM_TYPE_EOS);
+
+    return rows;
+}
+
+
+int bench_expression_functions()
+{
+    puts("Starting benchmark bench_expression_functions");
+
+    parser_ast_expr tmpl[9], e[9];
+    struct timeval t1;
+    uint32 stack_sz = 8;
+    handle sh = stack_create(stack_sz, sizeof(parser_ast_expr *), malloc(stack_get_alloc_sz(stack_sz, sizeof(parser_ast_expr *))));
+    if(NULL == sh) return __LINE__;
+
+    for(uint8 integers = 1; integers <= 1; integers--)
+    {
+        puts(integers ? "Benchmarking integer literals" : "Benchmarking decimal literals");
+
+        bench_expression_build(e, integers);
+        memcpy(tmpl, e, sizeof(e));
+
+        gettimeofday(&t1, NULL);
+        for(int i = 0; i < BENCH_EXPRESSION_REPEATS; i++)
+        {
+            memcpy(e, tmpl, sizeof(e));
+            if(0 != expression_calc_const_expr(e, sh)) return __LINE__;
+            if(e[0].node_type != PARSER_EXPR_NODE_TYPE_BOOL || e[0].boolean != 0) return __LINE__;
+        }
+        printf("Elapsed: %ld ms.\n", bench_elapsed_ms(&t1));
+    }
+
+    // the same text is lexed with integer literals and with all literals taken as decimals,
+    // as it was before integer literals, so the difference is what integer literals save end to end
+    {
+        const achar *row = _ach("select 12345 * 678 + 9 - 1011121314 >= 42;\n");
+        lexer_interface li = {bench_expression_char_feeder, bench_expression_error_reporter};
+        handle strlit = string_literal_create(malloc(string_literal_alloc_sz()));
+        handle lexer;
+        achar *text;
+
+        if(NULL == strlit) return __LINE__;
+        if((lexer = lexer_create(malloc(lexer_get_allocation_size()), ENCODING_UTF8, strlit, li)) == NULL) return __LINE__;
+        if((text = (achar *)malloc(strlen(row) * BENCH_EXPRESSION_ROWS + 1)) == NULL) return __LINE__;
+        for(int i = 0; i < BENCH_EXPRESSION_ROWS; i++) memcpy(text + i * strlen(row), row, strlen(row));
+        text[strlen(row) * BENCH_EXPRESSION_ROWS] = _ach('\0');
+
+        encoding_init();
+        g_bench_expression_text.build_char = encoding_get_build_char_fun(ENCODING_UTF8);
+        g_bench_expression_text.text = text;
+        g_bench_expression_text.len = strlen(text);
+
+        for(uint8 decimal_mode = 0; decimal_mode < 2; decimal_mode++)
+        {
+            puts(decimal_mode ? "Benchmarking lexed and evaluated literals parsed as decimals" : "Benchmarking lexed and evaluated integer literals");
+
+            gettimeofday(&t1, NULL);
+            for(int i = 0; i < BENCH_EXPRESSION_LEX_REPEATS; i++)
+            {
+                if(bench_expression_lex_run(lexer, sh, decimal_mode) != BENCH_EXPRESSION_ROWS) return __LINE__;
+            }
+            printf("Elapsed: %ld ms.\n", bench_elapsed_ms(&t1));
+        }
+
+        free(text);
+        free(lexer);
+        free(strlit);
+    }
+
+    free(sh);
+
+    return 0;
+}
@@ -0,0 +1,289 @@
+#include "tests.h"
+#include "execution/exproptimize.h"
+#include "execution/exprvm.h"
+#include "execution/exprbatch.h"
+#include "parser/parser.h"
+#include "common/string_literal.h"
+#include "common/error.h"
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+struct
+{
+    uint64                  cur_char;
+    const achar             *stmt;
+    encoding_build_char_fun build_char;
+} g_test_exproptimize_state = {0, NULL, NULL};
+
+
+sint8 test_exproptimize_char_feeder(char_info *ch, sint8 *eos)
+{
+    if(g_test_exproptimize_state.cur_char == strlen(g_test_exproptimize_state.stmt))
+    {
+        *eos = 1;
+    }
+    else
+    {
+        ch->length = 0u;
+        ch->ptr = 0u;
+        ch->state = CHAR_STATE_INCOMPLETE;
+        *eos = 0;
+        do
+        {
+            g_test_exproptimize_state.build_char(ch, g_test_exproptimize_state.stmt[g_test_exproptimize_state.cur_char++]);
+        }
+        while(ch->state != CHAR_STATE_COMPLETE);
+    }
+
+    return 0;
+}
+
+
+sint8 test_exproptimize_error_reporter(error_code error, const achar *msg)
+{
+    printf("Unexpected parsing error %d: %s\n", error, msg);
+    return -1;
+}
+
+
+sint8 test_exproptimize_resolve_name(const parser_ast_name *name, uint16 *slot, column_datatype *type)
+{
+    if(name->first_part_len != 1 || name->second_part_len != 0 || name->first_part[0] != 'a') return 1;
+
+    *slot = 0;
+    *type = INTEGER;
+    return 0;
+}
+
+
+// parse and optimize statement sql
+// return 0 on success
+sint8 test_exproptimize_parse(handle lexer, handle oh, const achar *sql, parser_ast_stmt **stmt)
+{
+    parser_interface pi;
+    pi.report_error = test_exproptimize_error_reporter;
+
+    g_test_exproptimize_state.cur_char = 0;
+    g_test_exproptimize_state.stmt = sql;
+
+    if(parser_parse(stmt, lexer, pi) != 0) return -1;
+
+    return exproptimize_stmt(oh, *stmt);
+}
+
+
+// put to sql statement comparing column with two equal literals of len bytes
+void test_exproptimize_long_literals(char *sql, uint32 len)
+{
+    uint32 pos = sprintf(sql, "select a from t where a = '");
+    memset(sql + pos, 'x', len);
+    pos += len;
+    pos += sprintf(sql + pos, "' or a > '");
+    memset(sql + pos, 'x', len);
+    pos += len;
+    sprintf(sql + pos, "'");
+}
+
+
+// return expression of list item
+parser_ast_expr *test_exproptimize_item(parser_ast_expr_list *list)
+{
+    return list->named ? &list->named_expr.expr : &list->expr;
+}
+
+
+// return 1 if expr is integer constant equal to v
+uint8 test_exproptimize_is_int(const parser_ast_expr *expr, sint64 v)
+{
+    return expr->node_type == PARSER_EXPR_NODE_TYPE_INT && expr->integer == v;
+}
+
+
+int test_exproptimize_functions()
+{
+    parser_ast_stmt *stmt;
+    parser_ast_expr *where, *expr;
+    lexer_interface li;
+    exprvm_value row, result;
+    exprbatch_vector column;
+    const exprbatch_vector *res;
+    sint64 values[4] = {5, 0, -3, 1};
+    char sql[64 + 2 * (EXPROPTIMIZE_MAX_STR_SZ + 1)];
+    handle vh, bh;
+
+    puts("Starting test test_exproptimize_functions");
+
+    li.next_char = test_exproptimize_char_feeder;
+    li.report_error = test_exproptimize_error_reporter;
+
+    encoding_init();
+    g_test_exproptimize_state.build_char = encoding_get_build_char_fun(ENCODING_UTF8);
+
+    handle strlit = string_literal_create(malloc(string_literal_alloc_sz()));
+    if(NULL == strlit) return __LINE__;
+
+    handle lexer = lexer_create(malloc(lexer_get_allocation_size()), ENCODING_UTF8, strlit, li);
+    if(NULL == lexer) return __LINE__;
+
+    handle oh = exproptimize_create(malloc(exproptimize_get_alloc_sz()));
+    if(NULL == oh) return __LINE__;
+
+
+    puts("Testing constant folding");
+
+    if(test_exproptimize_parse(lexer, oh, _ach("select 1 + 2 * 3, (4 - 2) * (1 + 1) > 3 from t"), &stmt) != 0) return __LINE__;
+    expr = test_exproptimize_item(stmt->select_stmt.select.projection);
+    if(!test_exproptimize_is_int(expr, 7)) return __LINE__;
+    expr = test_exproptimize_item(stmt->select_stmt.select.projection->next);
+    if(expr->node_type != PARSER_EXPR_NODE_TYPE_BOOL || expr->boolean != 1) return __LINE__;
+    parser_deallocate_stmt(stmt);
+
+    // constant part of expression with column is folded too
+    if(test_exproptimize_parse(lexer, oh, _ach("select a from t where a > (2 * 5 - 1)"), &stmt) != 0) return __LINE__;
+    where = stmt->select_stmt.select.where;
+    if(where->node_type != PARSER_EXPR_NODE_TYPE_OP || where->op != PARSER_EXPR_OP_TYPE_GT) return __LINE__;
+    if(!test_exproptimize_is_int(where->right, 9)) return __LINE__;
+    parser_deallocate_stmt(stmt);
+
+    // failed operation is left for execution
+    if(test_exproptimize_parse(lexer, oh, _ach("select 1 / 0"), &stmt) != 0) return __LINE__;
+    expr = test_exproptimize_item(stmt->select_stmt.select.projection);
+    if(expr->node_type != PARSER_EXPR_NODE_TYPE_OP || expr->op != PARSER_EXPR_OP_TYPE_DIV) return __LINE__;
+    parser_deallocate_stmt(stmt);
+
+    // set, where and check expressions
+    if(test_exproptimize_parse(lexer, oh, _ach("update t set a = 2 * 3 where a = 1 + 1"), &stmt) != 0) return __LINE__;
+    if(!test_exproptimize_is_int(&stmt->update_stmt.set_list.expr, 6)) return __LINE__;
+    if(!test_exproptimize_is_int(stmt->update_stmt.where->right, 2)) return __LINE__;
+    parser_deallocate_stmt(stmt);
+
+    if(test_exproptimize_parse(lexer, oh, _ach("create table t (a integer, constraint c1 check (a > 10 * 10))"), &stmt) != 0) return __LINE__;
+    if(NULL == stmt->create_table_stmt.constr) return __LINE__;
+    if(!test_exproptimize_is_int(stmt->create_table_stmt.constr->constr.expr.right, 100)) return __LINE__;
+    parser_deallocate_stmt(stmt);
+
+
+    puts("Testing boolean identities");
+
+    // x AND TRUE -> x
+    if(test_exproptimize_parse(lexer, oh, _ach("select a from t where a > 1 and 1 = 1"), &stmt) != 0) return __LINE__;
+    where = stmt->select_stmt.select.where;
+    if(where->node_type != PARSER_EXPR_NODE_TYPE_OP || where->op != PARSER_EXPR_OP_TYPE_GT) return __LINE__;
+    parser_deallocate_stmt(stmt);
+
+    // x AND FALSE -> FALSE
+    if(test_exproptimize_parse(lexer, oh, _ach("delete from t where a > 1 and 2 < 1"), &stmt) != 0) return __LINE__;
+    where = stmt->delete_stmt.where;
+    if(where->node_type != PARSER_EXPR_NODE_TYPE_BOOL || where->boolean != 0) return __LINE__;
+    parser_deallocate_stmt(stmt);
+
+    // x OR TRUE -> TRUE, x OR FALSE -> x
+    if(test_exproptimize_parse(lexer, oh, _ach("select a from t where (a > 1 or 1 = 1) and (a < 5 or 1 = 2)"), &stmt) != 0) return __LINE__;
+    where = stmt->select_stmt.select.where;
+    if(where->node_type != PARSER_EXPR_NODE_TYPE_OP || where->op != PARSER_EXPR_OP_TYPE_LT) return __LINE__;
+    parser_deallocate_stmt(stmt);
+
+    // NOT NOT x -> x
+    if(test_exproptimize_parse(lexer, oh, _ach("select a from t where not not a > 1"), &stmt) != 0) return __LINE__;
+    where = stmt->select_stmt.select.where;
+    if(where->node_type != PARSER_EXPR_NODE_TYPE_OP || where->op != PARSER_EXPR_OP_TYPE_GT) return __LINE__;
+    parser_deallocate_stmt(stmt);
+
+    // operand of unknown type is kept, so datatype error is reported on execution
+    if(test_exproptimize_parse(lexer, oh, _ach("select a from t where a and 1 = 2"), &stmt) != 0) return __LINE__;
+    where = stmt->select_stmt.select.where;
+    if(where->node_type != PARSER_EXPR_NODE_TYPE_OP || where->op != PARSER_EXPR_OP_TYPE_AND) return __LINE__;
+    parser_deallocate_stmt(stmt);
+
+
+    puts("Testing common subexpressions");
+
+    // x AND x -> x
+    if(test_exproptimize_parse(lexer, oh, _ach("select a from t where a > 1 and a > 1"), &stmt) != 0) return __LINE__;
+    where = stmt->select_stmt.select.where;
+    if(where->node_type != PARSER_EXPR_NODE_TYPE_OP || where->op != PARSER_EXPR_OP_TYPE_GT) return __LINE__;
+    parser_deallocate_stmt(stmt);
+
+    // subexpression is shared inside expression and between where and projection
+    if(test_exproptimize_parse(lexer, oh, _ach("select a + 1 from t where (a + 1 > 2) or (a + 1 < 0)"), &stmt) != 0) return __LINE__;
+    where = stmt->select_stmt.select.where;
+    if(where->left->left != where->right->left) return __LINE__;
+    expr = test_exproptimize_item(stmt->select_stmt.select.projection);
+    if(expr->left != where->left->left->left) return __LINE__;
+
+    // shared node is evaluated once
+    exprvm_interface vi = {test_exproptimize_resolve_name};
+    vh = exprvm_compile(malloc(exprvm_get_alloc_sz()), where, vi);
+    if(NULL == vh) return __LINE__;
+    if(exprvm_instr_num(vh) != 6) return __LINE__;
+
+    bh = exprbatch_compile(malloc(exprbatch_get_alloc_sz()), where, vi);
+    if(NULL == bh) return __LINE__;
+
+    column.type = PARSER_EXPR_NODE_TYPE_INT;
+    memset(column.nulls, 0, sizeof(column.nulls));
+    column.integer = values;
+    if(exprbatch_eval(bh, &column, NULL, 4, &res) != 0) return __LINE__;
+
+    for(uint8 i = 0; i < 4; i++)
+    {
+        row.type = PARSER_EXPR_NODE_TYPE_INT;
+        row.integer = values[i];
+        if(exprvm_eval(vh, &row, &result) != 0) return __LINE__;
+        if(result.type != PARSER_EXPR_NODE_TYPE_BOOL) return __LINE__;
+        if(result.boolean != (values[i] + 1 > 2 || values[i] + 1 < 0)) return __LINE__;
+
+        if(res->type != PARSER_EXPR_NODE_TYPE_BOOL || EXPRBATCH_IS_NULL(res, i)) return __LINE__;
+        if(res->boolean[i] != result.boolean) return __LINE__;
+    }
+
+    free(vh);
+    free(bh);
+    parser_deallocate_stmt(stmt);
+
+    // equal decimal literals are merged by value, all limbs are compared
+    if(test_exproptimize_parse(lexer, oh,
+        _ach("select a from t where a = 1234567890123456789012.5 or a > 1234567890123456789012.5 or a < 2234567890123456789012.5"),
+        &stmt) != 0) return __LINE__;
+    where = stmt->select_stmt.select.where;
+    if(where->left->left->right->node_type != PARSER_EXPR_NODE_TYPE_NUM) return __LINE__;
+    if(where->left->left->right != where->left->right->right) return __LINE__;
+    if(where->left->left->right == where->right->right) return __LINE__;
+    parser_deallocate_stmt(stmt);
+
+    // equal string literals are merged by value
+    if(test_exproptimize_parse(lexer, oh, _ach("select a from t where a = 'abc' or a > 'abc' or a < 'abd'"), &stmt) != 0) return __LINE__;
+    where = stmt->select_stmt.select.where;
+    if(where->left->left->right != where->left->right->right) return __LINE__;
+    if(where->left->left->right == where->right->right) return __LINE__;
+    parser_deallocate_stmt(stmt);
+
+    // the same for long literals, up to the limit
+    test_exproptimize_long_literals(sql, EXPROPTIMIZE_MAX_STR_SZ);
+    if(test_exproptimize_parse(lexer, oh, _ach(sql), &stmt) != 0) return __LINE__;
+    where = stmt->select_stmt.select.where;
+    if(where->left->right != where->right->right) return __LINE__;
+    parser_deallocate_stmt(stmt);
+
+    test_exproptimize_long_literals(sql, EXPROPTIMIZE_MAX_STR_SZ + 1);
+    if(test_exproptimize_parse(lexer, oh, _ach(sql), &stmt) != 0) return __LINE__;
+    where = stmt->select_stmt.select.where;
+    if(where->left->right == where->right->right) return __LINE__;
+    parser_deallocate_stmt(stmt);
+
+    // subquery is a separate name scope
+    if(test_exproptimize_parse(lexer, oh, _ach("select a + 1 from (select a + 1 as a from t) where a + 1 > 0"), &stmt) != 0) return __LINE__;
+    where = stmt->select_stmt.select.where;
+    expr = test_exproptimize_item(stmt->select_stmt.select.from->subquery.select.projection);
+    if(expr->left == where->left->left) return __LINE__;
+    if(test_exproptimize_item(stmt->select_stmt.select.projection)->left != where->left->left) return __LINE__;
+    parser_deallocate_stmt(stmt);
+
+    free(oh);
+    free(lexer);
+    free(strlit);
+
+    return 0;
+}
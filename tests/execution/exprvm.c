@@ -0,0 +1,530 @@
+#include "tests.h"
+#include "execution/exprvm.h"
+#include "execution/expression.h"
+#include "common/error.h"
+#include "common/stack.h"
+#include "common/string_literal.h"
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+// resolve columns "a", "b", "c", "d" to slots 0, 1, 2, 3: a and b are integers, c is decimal, d is double
+sint8 test_exprvm_resolve_name(const parser_ast_name *name, uint16 *slot, column_datatype *type)
+{
+    if(name->first_part_len != 1 || name->second_part_len != 0) return 1;
+    if(name->first_part[0] < 'a' || name->first_part[0] > 'd') return 1;
+
+    *slot = name->first_part[0] - 'a';
+    *type = *slot < 2 ? INTEGER : (*slot == 2 ? DECIMAL : DOUBLE_PRECISION);
+    return 0;
+}
+
+
+void test_exprvm_name(parser_ast_expr *e, char c)
+{
+    memset(e, 0, sizeof(*e));
+    e->node_type = PARSER_EXPR_NODE_TYPE_NAME;
+    e->name.first_part[0] = c;
+    e->name.first_part_len = 1;
+}
+
+
+void test_exprvm_op(parser_ast_expr *e, parser_expr_op_type op, parser_ast_expr *left, parser_ast_expr *right)
+{
+    e->node_type = PARSER_EXPR_NODE_TYPE_OP;
+    e->op = op;
+    e->left = left;
+    e->right = right;
+}
+
+
+void test_exprvm_int(parser_ast_expr *e, sint64 val)
+{
+    e->node_type = PARSER_EXPR_NODE_TYPE_INT;
+    e->integer = val;
+}
+
+
+int test_exprvm_functions()
+{
+    puts("Starting test test_exprvm_functions");
+
+    parser_ast_expr e[10], t[10];
+    exprvm_value row[4], res;
+    parser_expr_node_type type;
+    exprvm_interface vi = {test_exprvm_resolve_name};
+    decimal d;
+    handle vh;
+    void *buf = malloc(exprvm_get_alloc_sz());
+    if(NULL == buf) return __LINE__;
+
+    uint32 stack_sz = 8;
+    handle sh = stack_create(stack_sz, sizeof(parser_ast_expr *), malloc(stack_get_alloc_sz(stack_sz, sizeof(parser_ast_expr *))));
+    if(NULL == sh) return __LINE__;
+
+
+    puts("Testing integer columns");
+
+    // a * b + 3 > 10
+    test_exprvm_op(&e[0], PARSER_EXPR_OP_TYPE_GT, &e[1], &e[6]);
+    test_exprvm_op(&e[1], PARSER_EXPR_OP_TYPE_ADD, &e[2], &e[5]);
+    test_exprvm_op(&e[2], PARSER_EXPR_OP_TYPE_MUL, &e[3], &e[4]);
+    test_exprvm_name(&e[3], 'a');
+    test_exprvm_name(&e[4], 'b');
+    test_exprvm_int(&e[5], 3);
+    test_exprvm_int(&e[6], 10);
+
+    if((vh = exprvm_compile(buf, e, vi)) == NULL) return __LINE__;
+    if(exprvm_instr_num(vh) != 4) return __LINE__;
+
+    row[0].type = PARSER_EXPR_NODE_TYPE_INT;
+    row[0].integer = 2;
+    row[1].type = PARSER_EXPR_NODE_TYPE_INT;
+    row[1].integer = 4;
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_BOOL || res.boolean != 1) return __LINE__;
+
+    row[1].integer = 3;
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_BOOL || res.boolean != 0) return __LINE__;
+
+    // NULL operand makes arithmetic and comparison NULL
+    row[1].type = PARSER_EXPR_NODE_TYPE_NULL;
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_NULL) return __LINE__;
+
+    // a * b
+    if((vh = exprvm_compile(buf, &e[2], vi)) == NULL) return __LINE__;
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_NULL) return __LINE__;
+
+    // overflow makes decimal
+    row[0].integer = 0x7FFFFFFFFFFFFFFF;
+    row[1].type = PARSER_EXPR_NODE_TYPE_INT;
+    row[1].integer = 10;
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_NUM) return __LINE__;
+    if(res.num.sign != DECIMAL_SIGN_POS || res.num.n != 20) return __LINE__;
+    if(res.num.m[0] != 8070) return __LINE__;
+
+    // decimal in integer column falls back to generic instruction
+    row[0].type = PARSER_EXPR_NODE_TYPE_NUM;
+    decimal_from_int64(7, &row[0].num);
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_NUM) return __LINE__;
+    if(res.num.n != 2 || res.num.m[0] != 70) return __LINE__;
+
+
+    puts("Testing decimal columns");
+
+    // c / a
+    test_exprvm_op(&e[0], PARSER_EXPR_OP_TYPE_DIV, &e[1], &e[2]);
+    test_exprvm_name(&e[1], 'c');
+    test_exprvm_name(&e[2], 'a');
+    if((vh = exprvm_compile(buf, e, vi)) == NULL) return __LINE__;
+
+    row[0].type = PARSER_EXPR_NODE_TYPE_INT;
+    row[0].integer = 4;
+    row[2].type = PARSER_EXPR_NODE_TYPE_NUM;
+    decimal_from_int64(10, &row[2].num);
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_NUM) return __LINE__;
+    decimal_from_int64(25, &d);
+    d.e = -1;
+    if(decimal_cmp(&res.num, &d) != 0) return __LINE__;
+
+    row[0].integer = 0;
+    if(exprvm_eval(vh, row, &res) == 0) return __LINE__;
+    if(error_get() != ERROR_DIVISION_BY_ZERO) return __LINE__;
+
+    // c <= c
+    test_exprvm_op(&e[0], PARSER_EXPR_OP_TYPE_LE, &e[1], &e[1]);
+    if((vh = exprvm_compile(buf, e, vi)) == NULL) return __LINE__;
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_BOOL || res.boolean != 1) return __LINE__;
+
+
+    puts("Testing boolean operations");
+
+    // not (a is null) and b = 1
+    test_exprvm_op(&e[0], PARSER_EXPR_OP_TYPE_AND, &e[1], &e[5]);
+    test_exprvm_op(&e[1], PARSER_EXPR_OP_TYPE_NOT, &e[2], NULL);
+    test_exprvm_op(&e[2], PARSER_EXPR_OP_TYPE_IS, &e[3], &e[4]);
+    test_exprvm_name(&e[3], 'a');
+    e[4].node_type = PARSER_EXPR_NODE_TYPE_NULL;
+    test_exprvm_op(&e[5], PARSER_EXPR_OP_TYPE_EQ, &e[6], &e[7]);
+    test_exprvm_name(&e[6], 'b');
+    test_exprvm_int(&e[7], 1);
+    if((vh = exprvm_compile(buf, e, vi)) == NULL) return __LINE__;
+
+    row[0].type = PARSER_EXPR_NODE_TYPE_INT;
+    row[1].type = PARSER_EXPR_NODE_TYPE_INT;
+    row[1].integer = 1;
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_BOOL || res.boolean != 1) return __LINE__;
+
+    row[0].type = PARSER_EXPR_NODE_TYPE_NULL;
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_BOOL || res.boolean != 0) return __LINE__;
+
+    // a and b is rejected at compile time
+    test_exprvm_op(&e[0], PARSER_EXPR_OP_TYPE_AND, &e[3], &e[6]);
+    if(exprvm_compile(buf, e, vi) != NULL) return __LINE__;
+    if(error_get() != ERROR_DATATYPE_MISMATCH) return __LINE__;
+
+    // a = 0 or 10 / a > 1: division is skipped when a = 0
+    test_exprvm_op(&e[0], PARSER_EXPR_OP_TYPE_OR, &e[1], &e[4]);
+    test_exprvm_op(&e[1], PARSER_EXPR_OP_TYPE_EQ, &e[2], &e[3]);
+    test_exprvm_name(&e[2], 'a');
+    test_exprvm_int(&e[3], 0);
+    test_exprvm_op(&e[4], PARSER_EXPR_OP_TYPE_GT, &e[5], &e[7]);
+    test_exprvm_op(&e[5], PARSER_EXPR_OP_TYPE_DIV, &e[6], &e[2]);
+    test_exprvm_int(&e[6], 10);
+    test_exprvm_int(&e[7], 1);
+    if((vh = exprvm_compile(buf, e, vi)) == NULL) return __LINE__;
+
+    row[0].type = PARSER_EXPR_NODE_TYPE_INT;
+    row[0].integer = 0;
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_BOOL || res.boolean != 1) return __LINE__;
+
+    row[0].integer = 5;
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_BOOL || res.boolean != 1) return __LINE__;
+
+    row[0].integer = 20;
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_BOOL || res.boolean != 0) return __LINE__;
+
+    row[0].type = PARSER_EXPR_NODE_TYPE_NULL;
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_NULL) return __LINE__;
+
+    // null and b = 2, null or b = 2: null and false is false, null or true is true, otherwise null
+    e[1].node_type = PARSER_EXPR_NODE_TYPE_NULL;
+    test_exprvm_op(&e[4], PARSER_EXPR_OP_TYPE_EQ, &e[8], &e[9]);
+    test_exprvm_name(&e[8], 'b');
+    test_exprvm_int(&e[9], 2);
+    row[1].type = PARSER_EXPR_NODE_TYPE_INT;
+    for(parser_expr_op_type op = PARSER_EXPR_OP_TYPE_AND; op <= PARSER_EXPR_OP_TYPE_OR; op++)
+    {
+        test_exprvm_op(&e[0], op, &e[1], &e[4]);
+        if((vh = exprvm_compile(buf, e, vi)) == NULL) return __LINE__;
+
+        row[1].integer = op == PARSER_EXPR_OP_TYPE_AND ? 1 : 2;
+        if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+        if(res.type != PARSER_EXPR_NODE_TYPE_BOOL || res.boolean != (op == PARSER_EXPR_OP_TYPE_OR)) return __LINE__;
+
+        row[1].integer = op == PARSER_EXPR_OP_TYPE_AND ? 2 : 1;
+        if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+        if(res.type != PARSER_EXPR_NODE_TYPE_NULL) return __LINE__;
+    }
+    test_exprvm_name(&e[3], 'a');
+
+
+    puts("Testing BETWEEN");
+
+    // a * 2 between b and 10: a * 2 is computed once for both comparisons
+    test_exprvm_op(&e[0], PARSER_EXPR_OP_TYPE_BETWEEN, &e[1], &e[4]);
+    test_exprvm_op(&e[1], PARSER_EXPR_OP_TYPE_MUL, &e[2], &e[3]);
+    test_exprvm_name(&e[2], 'a');
+    test_exprvm_int(&e[3], 2);
+    test_exprvm_op(&e[4], PARSER_EXPR_OP_TYPE_AND, &e[5], &e[6]);
+    test_exprvm_name(&e[5], 'b');
+    test_exprvm_int(&e[6], 10);
+    if(exprvm_infer_type(e, vi, &type) != 0 || type != PARSER_EXPR_NODE_TYPE_BOOL) return __LINE__;
+    if((vh = exprvm_compile(buf, e, vi)) == NULL) return __LINE__;
+    if(exprvm_instr_num(vh) != 5) return __LINE__;
+
+    {
+        const sint64 cases[][3] = {{3, 5, 1}, {5, 5, 1}, {6, 5, 0}, {2, 5, 0}, {2, 4, 1}};
+
+        row[0].type = PARSER_EXPR_NODE_TYPE_INT;
+        row[1].type = PARSER_EXPR_NODE_TYPE_INT;
+        for(uint32 i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+        {
+            row[0].integer = cases[i][0];
+            row[1].integer = cases[i][1];
+            if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+            if(res.type != PARSER_EXPR_NODE_TYPE_BOOL || res.boolean != cases[i][2]) return __LINE__;
+        }
+    }
+
+    // null bound gives null unless the other comparison is false
+    row[1].type = PARSER_EXPR_NODE_TYPE_NULL;
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_NULL) return __LINE__;
+
+    row[0].integer = 6;
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_BOOL || res.boolean != 0) return __LINE__;
+
+    // bounds must be AND node
+    test_exprvm_op(&e[0], PARSER_EXPR_OP_TYPE_BETWEEN, &e[1], &e[6]);
+    if(exprvm_compile(buf, e, vi) != NULL) return __LINE__;
+    if(error_get() != ERROR_SEMANTIC_ERROR) return __LINE__;
+    if(exprvm_infer_type(e, vi, &type) == 0) return __LINE__;
+    test_exprvm_name(&e[3], 'a');
+
+
+    puts("Testing float columns");
+
+    // d * 2, d + d, d / a
+    test_exprvm_op(&e[0], PARSER_EXPR_OP_TYPE_MUL, &e[1], &e[2]);
+    test_exprvm_name(&e[1], 'd');
+    test_exprvm_int(&e[2], 2);
+    if((vh = exprvm_compile(buf, e, vi)) == NULL) return __LINE__;
+    row[3].type = PARSER_EXPR_NODE_TYPE_FLOAT;
+    row[3].fp = 1.25;
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_FLOAT || res.fp != 2.5) return __LINE__;
+
+    test_exprvm_op(&e[0], PARSER_EXPR_OP_TYPE_ADD, &e[1], &e[1]);
+    if((vh = exprvm_compile(buf, e, vi)) == NULL) return __LINE__;
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_FLOAT || res.fp != 2.5) return __LINE__;
+
+    test_exprvm_op(&e[0], PARSER_EXPR_OP_TYPE_DIV, &e[1], &e[3]);
+    if((vh = exprvm_compile(buf, e, vi)) == NULL) return __LINE__;
+    row[0].type = PARSER_EXPR_NODE_TYPE_INT;
+    row[0].integer = 5;
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_FLOAT || res.fp != 0.25) return __LINE__;
+    row[0].integer = 0;
+    if(exprvm_eval(vh, row, &res) == 0) return __LINE__;
+    if(error_get() != ERROR_DIVISION_BY_ZERO) return __LINE__;
+
+    // d * d overflows
+    test_exprvm_op(&e[0], PARSER_EXPR_OP_TYPE_MUL, &e[1], &e[1]);
+    if((vh = exprvm_compile(buf, e, vi)) == NULL) return __LINE__;
+    row[3].fp = 1e300;
+    if(exprvm_eval(vh, row, &res) == 0) return __LINE__;
+    if(error_get() != ERROR_DECIMAL_OVERFLOW) return __LINE__;
+
+    // d < c
+    test_exprvm_op(&e[0], PARSER_EXPR_OP_TYPE_LT, &e[1], &e[4]);
+    test_exprvm_name(&e[4], 'c');
+    if((vh = exprvm_compile(buf, e, vi)) == NULL) return __LINE__;
+    row[2].type = PARSER_EXPR_NODE_TYPE_NUM;
+    decimal_from_int64(126, &row[2].num);
+    row[2].num.e = -2;
+    row[3].fp = 1.25;
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_BOOL || res.boolean != 1) return __LINE__;
+    row[2].num.m[0] = 125;
+    if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+    if(res.type != PARSER_EXPR_NODE_TYPE_BOOL || res.boolean != 0) return __LINE__;
+
+
+    puts("Testing type inference");
+
+    // a + b, a / b, a - c, d * a, a < d, NULL * a, true + a
+    test_exprvm_name(&e[1], 'a');
+    test_exprvm_name(&e[2], 'b');
+    test_exprvm_name(&e[3], 'c');
+    test_exprvm_name(&e[4], 'd');
+    e[5].node_type = PARSER_EXPR_NODE_TYPE_NULL;
+    e[6].node_type = PARSER_EXPR_NODE_TYPE_BOOL;
+    e[6].boolean = 1;
+    {
+        const struct { parser_expr_op_type op; int l, r; parser_expr_node_type type; } cases[] = {
+            {PARSER_EXPR_OP_TYPE_ADD, 1, 2, PARSER_EXPR_NODE_TYPE_INT},
+            {PARSER_EXPR_OP_TYPE_DIV, 1, 2, PARSER_EXPR_NODE_TYPE_NUM},
+            {PARSER_EXPR_OP_TYPE_SUB, 1, 3, PARSER_EXPR_NODE_TYPE_NUM},
+            {PARSER_EXPR_OP_TYPE_MUL, 4, 1, PARSER_EXPR_NODE_TYPE_FLOAT},
+            {PARSER_EXPR_OP_TYPE_LT, 1, 4, PARSER_EXPR_NODE_TYPE_BOOL},
+            {PARSER_EXPR_OP_TYPE_MUL, 5, 1, 0},
+            {PARSER_EXPR_OP_TYPE_ADD, 6, 1, PARSER_EXPR_NODE_TYPE_OP},     // mismatch
+        };
+
+        for(uint32 i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+        {
+            test_exprvm_op(&e[0], cases[i].op, &e[cases[i].l], &e[cases[i].r]);
+            if(cases[i].type == PARSER_EXPR_NODE_TYPE_OP)
+            {
+                if(exprvm_infer_type(e, vi, &type) == 0) return __LINE__;
+                if(error_get() != ERROR_DATATYPE_MISMATCH) return __LINE__;
+                continue;
+            }
+            if(exprvm_infer_type(e, vi, &type) != 0) return __LINE__;
+            if(type != cases[i].type) return __LINE__;
+        }
+    }
+
+
+    puts("Testing compilation errors");
+
+    test_exprvm_op(&e[0], PARSER_EXPR_OP_TYPE_ADD, &e[1], &e[2]);
+    test_exprvm_name(&e[1], 'a');
+    test_exprvm_name(&e[2], 'x');
+    if(exprvm_compile(buf, e, vi) != NULL) return __LINE__;
+    if(error_get() != ERROR_SEMANTIC_ERROR) return __LINE__;
+
+    // a + (a + (a + ...)) does not fit into program
+    parser_ast_expr *deep = (parser_ast_expr *)malloc(sizeof(parser_ast_expr) * (2 * EXPRVM_MAX_INSTRUCTIONS + 1));
+    if(NULL == deep) return __LINE__;
+    for(int i = 0; i < EXPRVM_MAX_INSTRUCTIONS; i++)
+    {
+        test_exprvm_op(&deep[2 * i], PARSER_EXPR_OP_TYPE_ADD, &deep[2 * i + 1], &deep[2 * i + 2]);
+        test_exprvm_name(&deep[2 * i + 1], 'a');
+    }
+    test_exprvm_name(&deep[2 * EXPRVM_MAX_INSTRUCTIONS], 'b');
+    if(exprvm_compile(buf, deep, vi) != NULL) return __LINE__;
+    if(error_get() != ERROR_EXPRESSION_TOO_COMPLEX) return __LINE__;
+    free(deep);
+
+
+    puts("Testing constant expressions against expression_calc_const_expr");
+
+    // (1000000007 * 3 - 5) / 7 <> 2 is not null
+    test_exprvm_op(&e[0], PARSER_EXPR_OP_TYPE_IS_NOT, &e[1], &e[9]);
+    test_exprvm_op(&e[1], PARSER_EXPR_OP_TYPE_NE, &e[2], &e[8]);
+    test_exprvm_op(&e[2], PARSER_EXPR_OP_TYPE_DIV, &e[3], &e[7]);
+    test_exprvm_op(&e[3], PARSER_EXPR_OP_TYPE_SUB, &e[4], &e[6]);
+    test_exprvm_op(&e[4], PARSER_EXPR_OP_TYPE_MUL, &e[5], &e[8]);
+    test_exprvm_int(&e[5], 1000000007);
+    test_exprvm_int(&e[6], 5);
+    test_exprvm_int(&e[7], 7);
+    test_exprvm_int(&e[8], 3);
+    e[9].node_type = PARSER_EXPR_NODE_TYPE_NULL;
+
+    for(int i = 0; i < 5; i++)
+    {
+        // e[i] subtree has no shared nodes except the leaf e[8]
+        memcpy(t, e, sizeof(e));
+        for(int j = 0; j < 10; j++)
+        {
+            if(t[j].node_type != PARSER_EXPR_NODE_TYPE_OP) continue;
+            t[j].left = t + (e[j].left - e);
+            if(NULL != e[j].right) t[j].right = t + (e[j].right - e);
+        }
+
+        if((vh = exprvm_compile(buf, &e[i], vi)) == NULL) return __LINE__;
+        if(exprvm_eval(vh, row, &res) != 0) return __LINE__;
+        if(expression_calc_const_expr(&t[i], sh) != 0) return __LINE__;
+        if(res.type != t[i].node_type) return __LINE__;
+        if(res.type == PARSER_EXPR_NODE_TYPE_BOOL && res.boolean != t[i].boolean) return __LINE__;
+        if(res.type == PARSER_EXPR_NODE_TYPE_INT && res.integer != t[i].integer) return __LINE__;
+        if(res.type == PARSER_EXPR_NODE_TYPE_NUM && decimal_cmp(&res.num, &t[i].num) != 0) return __LINE__;
+    }
+
+    free(sh);
+    free(buf);
+
+    return 0;
+}
+
+
+#define BENCH_EXPRVM_ROWS   (1000000)
+
+
+// build a * b + 9 - c >= 42 for the tree walker, column leaves are e[4], e[5], e[7]
+void bench_exprvm_build(parser_ast_expr *e)
+{
+    test_exprvm_op(&e[0], PARSER_EXPR_OP_TYPE_GE, &e[1], &e[8]);
+    test_exprvm_op(&e[1], PARSER_EXPR_OP_TYPE_SUB, &e[2], &e[7]);
+    test_exprvm_op(&e[2], PARSER_EXPR_OP_TYPE_ADD, &e[3], &e[6]);
+    test_exprvm_op(&e[3], PARSER_EXPR_OP_TYPE_MUL, &e[4], &e[5]);
+    test_exprvm_int(&e[6], 9);
+    test_exprvm_int(&e[8], 42);
+}
+
+
+// fill row values of row number i
+void bench_exprvm_row(exprvm_value *row, sint64 i, uint8 integers)
+{
+    sint64 vals[3] = {i & 0xFFFF, i >> 4, i};
+
+    for(int j = 0; j < 3; j++)
+    {
+        if(integers)
+        {
+            row[j].type = PARSER_EXPR_NODE_TYPE_INT;
+            row[j].integer = vals[j];
+        }
+        else
+        {
+            row[j].type = PARSER_EXPR_NODE_TYPE_NUM;
+            decimal_from_int64(vals[j], &row[j].num);
+        }
+    }
+}
+
+
+// set leaf e to value v
+void bench_exprvm_leaf(parser_ast_expr *e, const exprvm_value *v)
+{
+    e->node_type = v->type;
+    if(v->type == PARSER_EXPR_NODE_TYPE_INT) e->integer = v->integer;
+    else e->num = v->num;
+}
+
+
+int bench_exprvm_functions()
+{
+    puts("Starting benchmark bench_exprvm_functions");
+
+    parser_ast_expr tmpl[9], e[9];
+    exprvm_value row[3], res;
+    exprvm_interface vi = {test_exprvm_resolve_name};
+    struct timeval t1;
+    uint64 walker_true, vm_true;
+    handle vh;
+    void *buf = malloc(exprvm_get_alloc_sz());
+    if(NULL == buf) return __LINE__;
+
+    uint32 stack_sz = 8;
+    handle sh = stack_create(stack_sz, sizeof(parser_ast_expr *), malloc(stack_get_alloc_sz(stack_sz, sizeof(parser_ast_expr *))));
+    if(NULL == sh) return __LINE__;
+
+    bench_exprvm_build(e);
+    memcpy(tmpl, e, sizeof(e));
+
+    for(uint8 integers = 1; integers <= 1; integers--)
+    {
+        puts(integers ? "Benchmarking tree walker on integer rows" : "Benchmarking tree walker on decimal rows");
+
+        walker_true = 0;
+        gettimeofday(&t1, NULL);
+        for(sint64 i = 0; i < BENCH_EXPRVM_ROWS; i++)
+        {
+            bench_exprvm_row(row, i, integers);
+            memcpy(e, tmpl, sizeof(e));
+            bench_exprvm_leaf(&e[4], &row[0]);
+            bench_exprvm_leaf(&e[5], &row[1]);
+            bench_exprvm_leaf(&e[7], &row[2]);
+            if(0 != expression_calc_const_expr(e, sh)) return __LINE__;
+            if(e[0].node_type != PARSER_EXPR_NODE_TYPE_BOOL) return __LINE__;
+            walker_true += e[0].boolean;
+        }
+        printf("Elapsed: %ld ms.\n", bench_elapsed_ms(&t1));
+
+        puts(integers ? "Benchmarking bytecode on integer rows" : "Benchmarking bytecode on decimal rows");
+
+        // same expression with column references: a for e[4], b for e[5], c for e[7]
+        memcpy(e, tmpl, sizeof(e));
+        test_exprvm_name(&e[4], 'a');
+        test_exprvm_name(&e[5], 'b');
+        test_exprvm_name(&e[7], 'c');
+        if((vh = exprvm_compile(buf, e, vi)) == NULL) return __LINE__;
+
+        vm_true = 0;
+        gettimeofday(&t1, NULL);
+        for(sint64 i = 0; i < BENCH_EXPRVM_ROWS; i++)
+        {
+            bench_exprvm_row(row, i, integers);
+            if(0 != exprvm_eval(vh, row, &res)) return __LINE__;
+            if(res.type != PARSER_EXPR_NODE_TYPE_BOOL) return __LINE__;
+            vm_true += res.boolean;
+        }
+        printf("Elapsed: %ld ms.\n", bench_elapsed_ms(&t1));
+
+        if(walker_true != vm_true) return __LINE__;
+    }
+
+    free(sh);
+    free(buf);
+
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "tests.h"
 
@@ -20,10 +21,39 @@ int process_test_fail(int test_result, const char* test)
     return 0;
 }
 
+long bench_elapsed_ms(const struct timeval *t1)
+{
+    struct timeval t2;
+    gettimeofday(&t2, NULL);
+    return (t2.tv_sec - t1->tv_sec) * 1000 + (t2.tv_usec - t1->tv_usec) / 1000;
+}
+
 int main(int argc, char **argv)
 {
+    if(argc > 1 && 0 == strcmp(argv[1], "bench"))
+    {
+        process_test_fail(bench_lexer_functions(), "bench_lexer_functions");
+        process_test_fail(bench_expression_functions(), "bench_expression_functions");
+        process_test_fail(bench_exprvm_functions(), "bench_exprvm_functions");
+        process_test_fail(bench_exprbatch_functions(), "bench_exprbatch_functions");
+        process_test_fail(bench_decimal_functions(), "bench_decimal_functions");
+        process_test_fail(bench_strop_functions(), "bench_strop_functions");
+        process_test_fail(bench_fltconv_functions(), "bench_fltconv_functions");
+        process_test_fail(bench_grigorian_functions(), "bench_grigorian_functions");
+        process_test_fail(bench_tzinfo_functions(), "bench_tzinfo_functions");
+        process_test_fail(bench_encoding_functions(), "bench_encoding_functions");
+        process_test_fail(bench_strval_functions(), "bench_strval_functions");
+        process_test_fail(bench_collation_functions(), "bench_collation_functions");
+        process_test_fail(bench_strmatch_functions(), "bench_strmatch_functions");
+        process_test_fail(bench_hmap_functions(), "bench_hmap_functions");
+
+        printf("Benchmark execution completed.\n");
+        return 0;
+    }
+
     process_test_fail(test_auth_sha3_512(), "test_auth_sha3_512");
     process_test_fail(test_grigorian_calendar(), "test_grigorian_calendar");
+    process_test_fail(test_tzinfo_functions(), "test_tzinfo_functions");
     process_test_fail(test_strop_functions(), "test_strop_functions");
     process_test_fail(test_dateop_functions(), "test_dateop_functions");
     process_test_fail(test_encoding_functions(), "test_encoding_functions");
@@ -36,7 +66,17 @@ int main(int argc, char **argv)
     process_test_fail(test_parser_functions(), "test_parser_functions");
     process_test_fail(test_stack_functions(), "test_stack_functions");
     process_test_fail(test_expression_functions(), "test_expression_functions");
+    process_test_fail(test_exprvm_functions(), "test_exprvm_functions");
+    process_test_fail(test_exprbatch_functions(), "test_exprbatch_functions");
+    process_test_fail(test_exproptimize_functions(), "test_exproptimize_functions");
     process_test_fail(test_htable_functions(), "test_htable_functions");
+    process_test_fail(test_arena_functions(), "test_arena_functions");
+    process_test_fail(test_keyenc_functions(), "test_keyenc_functions");
+    process_test_fail(test_fltconv_functions(), "test_fltconv_functions");
+    process_test_fail(test_strval_functions(), "test_strval_functions");
+    process_test_fail(test_collation_functions(), "test_collation_functions");
+    process_test_fail(test_strmatch_functions(), "test_strmatch_functions");
+    process_test_fail(test_hmap_functions(), "test_hmap_functions");
 
     printf("Test execution completed.\n");
     return 0;
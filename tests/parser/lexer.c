@@ -39,6 +39,33 @@ sint8 test_lexer_char_feeder(char_info *ch, sint8 *eos)
 }
 
 
+uint64 g_bench_lexer_stmt_len = 0;
+
+
+// same as test_lexer_char_feeder, but statement length is known beforehand
+sint8 bench_lexer_char_feeder(char_info *ch, sint8 *eos)
+{
+    if(g_test_lexer_state.cur_char == g_bench_lexer_stmt_len)
+    {
+        *eos = 1;
+    }
+    else
+    {
+        ch->length = 0u;
+        ch->ptr = 0u;
+        ch->state = CHAR_STATE_INCOMPLETE;
+        *eos = 0;
+        do
+        {
+            g_test_lexer_state.build_char(ch, g_test_lexer_state.stmt[g_test_lexer_state.cur_char++]);
+        }
+        while(ch->state != CHAR_STATE_COMPLETE);
+    }
+
+    return 0;
+}
+
+
 sint8 test_lexer_error_reporter(error_code error, const achar *msg)
 {
     if(strcmp(msg, g_test_lexer_state.expected_errmsg)) return -1;
@@ -136,6 +163,30 @@ int test_lexer_functions()
     if(lexem.type != LEXEM_TYPE_EOS) return __LINE__;
 
 
+    puts("Testing lexer_unread");
+
+    g_test_lexer_state.stmt = _ach("Escape like like_ zone");
+    g_test_lexer_state.cur_char = 0;
+    if(0 != lexer_reset(lexer)) return __LINE__;
+
+    if(lexer_next(lexer, &lexem) != 0) return __LINE__;
+    if(lexem.type != LEXEM_TYPE_RESERVED_WORD || lexem.reserved_word != LEXER_RESERVED_WORD_ESCAPE) return __LINE__;
+    if(lexer_next(lexer, &lexem) != 0) return __LINE__;
+    if(lexem.type != LEXEM_TYPE_RESERVED_WORD || lexem.reserved_word != LEXER_RESERVED_WORD_LIKE) return __LINE__;
+
+    // the last token is returned again once
+    if(lexer_next(lexer, &lexem) != 0) return __LINE__;
+    if(lexem.type != LEXEM_TYPE_IDENTIFIER || lexem.identifier_len != 5) return __LINE__;
+    lexer_unread(lexer);
+    memset(&lexem, 0, sizeof(lexem));
+    if(lexer_next(lexer, &lexem) != 0) return __LINE__;
+    if(lexem.type != LEXEM_TYPE_IDENTIFIER || lexem.identifier_len != 5 || lexem.col != 13) return __LINE__;
+    if(lexer_next(lexer, &lexem) != 0) return __LINE__;
+    if(lexem.type != LEXEM_TYPE_RESERVED_WORD || lexem.reserved_word != LEXER_RESERVED_WORD_ZONE) return __LINE__;
+    if(lexer_next(lexer, &lexem) != 0) return __LINE__;
+    if(lexem.type != LEXEM_TYPE_EOS) return __LINE__;
+
+
     puts("Testing lexer_next for tokens");
 
     // all tokens
@@ -227,12 +278,46 @@ int test_lexer_functions()
 
     if(lexer_next(lexer, &lexem) != 0) return __LINE__;
     if(lexem.type != LEXEM_TYPE_NUM_LITERAL) return __LINE__;
-    if(lexem.num_literal.m[1] != 1234 || lexem.num_literal.m[0] != 5678) return __LINE__;
+    if(lexem.integer_literal != 1 || lexem.integer != 12345678) return __LINE__;
+
+    if(lexer_next(lexer, &lexem) != 0) return __LINE__;
+    if(lexem.type != LEXEM_TYPE_EOS) return __LINE__;
+
+    // largest integer
+    g_test_lexer_state.stmt = _ach("9223372036854775807,0009223372036854775808");
+    g_test_lexer_state.cur_char = 0;
+    if(0 != lexer_reset(lexer)) return __LINE__;
+
+    if(lexer_next(lexer, &lexem) != 0) return __LINE__;
+    if(lexem.type != LEXEM_TYPE_NUM_LITERAL) return __LINE__;
+    if(lexem.integer_literal != 1 || lexem.integer != 0x7FFFFFFFFFFFFFFFL) return __LINE__;
+
+    if(lexer_next(lexer, &lexem) != 0) return __LINE__;
+    if(lexem.type != LEXEM_TYPE_TOKEN || lexem.token != LEXER_TOKEN_COMMA) return __LINE__;
+
+    // integer which doesn't fit in 64 bits is decimal
+    if(lexer_next(lexer, &lexem) != 0) return __LINE__;
+    if(lexem.type != LEXEM_TYPE_NUM_LITERAL) return __LINE__;
+    if(lexem.integer_literal != 0) return __LINE__;
+    if(lexem.num_literal.m[4] != 922 || lexem.num_literal.m[0] != 5808 || lexem.num_literal.n != 19) return __LINE__;
     if(lexem.num_literal.sign != DECIMAL_SIGN_POS || lexem.num_literal.e != 0) return __LINE__;
 
     if(lexer_next(lexer, &lexem) != 0) return __LINE__;
     if(lexem.type != LEXEM_TYPE_EOS) return __LINE__;
 
+    // integer with exponent is decimal
+    g_test_lexer_state.stmt = _ach("12e+2");
+    g_test_lexer_state.cur_char = 0;
+    if(0 != lexer_reset(lexer)) return __LINE__;
+
+    if(lexer_next(lexer, &lexem) != 0) return __LINE__;
+    if(lexem.type != LEXEM_TYPE_NUM_LITERAL) return __LINE__;
+    if(lexem.integer_literal != 0) return __LINE__;
+    if(lexem.num_literal.m[0] != 12 || lexem.num_literal.e != 2) return __LINE__;
+
+    if(lexer_next(lexer, &lexem) != 0) return __LINE__;
+    if(lexem.type != LEXEM_TYPE_EOS) return __LINE__;
+
     // floating with no exponent
     g_test_lexer_state.stmt = _ach("1234.5678");
     g_test_lexer_state.cur_char = 0;
@@ -335,6 +420,37 @@ int test_lexer_functions()
     if(lexer_next(lexer, &lexem) != 1) return __LINE__;
 
 
+    // digits taken before and after integer overflow
+    g_test_lexer_state.stmt = _ach("12345678901234567890123.5");
+    g_test_lexer_state.cur_char = 0;
+    if(0 != lexer_reset(lexer)) return __LINE__;
+
+    if(lexer_next(lexer, &lexem) != 0) return __LINE__;
+    if(lexem.type != LEXEM_TYPE_NUM_LITERAL || lexem.integer_literal != 0) return __LINE__;
+    if(lexem.num_literal.n != 24 || lexem.num_literal.e != -1) return __LINE__;
+    if(lexem.num_literal.m[5] != 1234 || lexem.num_literal.m[4] != 5678 || lexem.num_literal.m[3] != 9012) return __LINE__;
+    if(lexem.num_literal.m[2] != 3456 || lexem.num_literal.m[1] != 7890 || lexem.num_literal.m[0] != 1235) return __LINE__;
+
+
+    // decimal mode
+    g_test_lexer_state.stmt = _ach("12345678 0 42.5");
+    g_test_lexer_state.cur_char = 0;
+    if(0 != lexer_reset(lexer)) return __LINE__;
+    lexer_num_mode_decimal(lexer, 1);
+
+    if(lexer_next(lexer, &lexem) != 0) return __LINE__;
+    if(lexem.type != LEXEM_TYPE_NUM_LITERAL || lexem.integer_literal != 0) return __LINE__;
+    if(lexem.num_literal.m[1] != 1234 || lexem.num_literal.m[0] != 5678 || lexem.num_literal.n != 8) return __LINE__;
+    if(lexem.num_literal.sign != DECIMAL_SIGN_POS || lexem.num_literal.e != 0) return __LINE__;
+
+    if(lexer_next(lexer, &lexem) != 0) return __LINE__;
+    if(lexem.type != LEXEM_TYPE_NUM_LITERAL || lexem.integer_literal != 0 || lexem.num_literal.n != 0) return __LINE__;
+
+    if(lexer_next(lexer, &lexem) != 0) return __LINE__;
+    if(lexem.type != LEXEM_TYPE_NUM_LITERAL || lexem.integer_literal != 0) return __LINE__;
+    if(lexem.num_literal.m[0] != 425 || lexem.num_literal.e != -1) return __LINE__;
+
+
     // integer mode
     g_test_lexer_state.stmt = _ach("922337203685477579.123");
     g_test_lexer_state.cur_char = 0;
@@ -372,3 +488,79 @@ int test_lexer_functions()
 
     return 0;
 }
+
+
+#define BENCH_LEXER_ROWS        (2000)
+#define BENCH_LEXER_REPEATS     (50)
+
+
+// lex the whole statement, integers are parsed as decimals if decimal_mode is 1
+// return number of numeric literals or -1 on error
+sint64 bench_lexer_run(handle lexer, uint8 decimal_mode)
+{
+    lexer_lexem lexem;
+    sint64 num_cnt = 0;
+
+    if(0 != lexer_reset(lexer)) return -1;
+    lexer_num_mode_decimal(lexer, decimal_mode);
+    do
+    {
+        if(lexer_next(lexer, &lexem) != 0) return -1;
+        if(lexem.type == LEXEM_TYPE_NUM_LITERAL) num_cnt++;
+    }
+    while(lexem.type != LEXEM_TYPE_EOS);
+
+    return num_cnt;
+}
+
+
+int bench_lexer_functions()
+{
+    puts("Starting benchmark bench_lexer_functions");
+
+    const achar *int_row = _ach("insert into t values (12345, 678, 9, 1011121314, 42, 7);\n");
+    achar *int_stmt;
+    struct timeval t1;
+    handle lexer;
+    lexer_interface li;
+    sint64 num_cnt;
+
+    encoding_init();
+    g_test_lexer_state.build_char = encoding_get_build_char_fun(ENCODING_UTF8);
+    li.next_char = bench_lexer_char_feeder;
+    li.report_error = test_lexer_error_reporter;
+
+    handle strlit = string_literal_create(malloc(string_literal_alloc_sz()));
+    if(NULL == strlit) return __LINE__;
+    if((lexer = lexer_create(malloc(lexer_get_allocation_size()), ENCODING_UTF8, strlit, li)) == NULL) return __LINE__;
+
+    int_stmt = (achar *)malloc(strlen(int_row) * BENCH_LEXER_ROWS + 1);
+    if(NULL == int_stmt) return __LINE__;
+    int_stmt[0] = _ach('\0');
+    for(int i = 0; i < BENCH_LEXER_ROWS; i++)
+    {
+        strcat(int_stmt + i * strlen(int_row), int_row);
+    }
+
+    // the same integer literals are lexed as integers and as decimals, as they were before integer fast path
+    for(int decimal_mode = 0; decimal_mode < 2; decimal_mode++)
+    {
+        puts(decimal_mode ? "Benchmarking integer literals parsed as decimals" : "Benchmarking integer literals");
+
+        g_test_lexer_state.stmt = int_stmt;
+        g_bench_lexer_stmt_len = strlen(int_stmt);
+        gettimeofday(&t1, NULL);
+        for(int i = 0; i < BENCH_LEXER_REPEATS; i++)
+        {
+            g_test_lexer_state.cur_char = 0;
+            if((num_cnt = bench_lexer_run(lexer, (uint8)decimal_mode)) != 6 * BENCH_LEXER_ROWS) return __LINE__;
+        }
+        printf("Elapsed: %ld ms.\n", bench_elapsed_ms(&t1));
+    }
+
+    free(int_stmt);
+    free(lexer);
+    free(strlit);
+
+    return 0;
+}
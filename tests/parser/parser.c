@@ -74,6 +74,9 @@ void test_parser_print_expr_tree(parser_ast_expr *e, int lvl)
             case PARSER_EXPR_OP_TYPE_IS: puts("IS"); break;
             case PARSER_EXPR_OP_TYPE_IS_NOT: puts("IS NOT"); break;
             case PARSER_EXPR_OP_TYPE_BETWEEN: puts("BrETWEEN"); break;
+            case PARSER_EXPR_OP_TYPE_LIKE: puts("LIKE"); break;
+            case PARSER_EXPR_OP_TYPE_NOT_LIKE: puts("NOT LIKE"); break;
+            case PARSER_EXPR_OP_TYPE_ESCAPE: puts("ESCAPE"); break;
             case PARSER_EXPR_OP_TYPE_NOT: puts("NOT"); break;
             case PARSER_EXPR_OP_TYPE_AND: puts("AND"); break;
             case PARSER_EXPR_OP_TYPE_OR: puts("OR"); break;
@@ -85,6 +88,10 @@ void test_parser_print_expr_tree(parser_ast_expr *e, int lvl)
     {
         printf("num: sign=%d, n=%d, e=%d, m0=%d\n", e->num.sign, e->num.n, e->num.e, e->num.m[0]);
     }
+    else if(e->node_type == PARSER_EXPR_NODE_TYPE_INT)
+    {
+        printf("int: %ld\n", e->integer);
+    }
     else if(e->node_type == PARSER_EXPR_NODE_TYPE_STR)
     {
         uint64 len=0;
@@ -134,6 +141,8 @@ sint8 test_parser_compare_mem(uint64 len1, void *ptr1, uint64 len2, void *ptr2)
         puts("Statement compare: buffer contents mismatch");
         return 1;
     }
+
+    return 0;
 }
 
 sint8 test_parser_compare_name(parser_ast_name *stmt1, parser_ast_name *stmt2)
@@ -157,6 +166,19 @@ sint8 test_parser_compare_expr(parser_ast_expr *stmt1, parser_ast_expr *stmt2)
 {
     sint8 ret;
 
+    // integer literals are compared with decimal reference values
+    if(stmt1->node_type == PARSER_EXPR_NODE_TYPE_INT && stmt2->node_type == PARSER_EXPR_NODE_TYPE_NUM)
+    {
+        decimal d;
+        decimal_from_int64(stmt1->integer, &d);
+        if(memcmp(&d, &stmt2->num, sizeof(d)))
+        {
+            puts("Statement compare: expression int mismatch");
+            return 1;
+        }
+        return 0;
+    }
+
     if(stmt1->node_type != stmt2->node_type)
     {
         puts("Statement compare: expression node_type mismatch");
@@ -209,6 +231,13 @@ sint8 test_parser_compare_expr(parser_ast_expr *stmt1, parser_ast_expr *stmt2)
                 return 1;
             }
             break;
+        case PARSER_EXPR_NODE_TYPE_INT:
+            if(stmt1->integer != stmt2->integer)
+            {
+                puts("Statement compare: expression int mismatch");
+                return 1;
+            }
+            break;
         case PARSER_EXPR_NODE_TYPE_STR:
             string_literal_byte_compare(stmt1->str, stmt2->str, &ret);
             if(ret)
@@ -2321,5 +2350,90 @@ int test_parser_functions()
     parser_deallocate_stmt(stmt);
 
 
+    puts("Testing statement parsing with spilling to disk");
+    g_test_parser_state.cur_char = 0;
+    parser_set_memory_budget(0, NULL);
+
+    if(parser_parse(&stmt, lexer, pi) != 0) return __LINE__;
+    if(stmt == NULL) return __LINE__;
+
+    if(test_parser_compare_stmt(stmt, &ref_stmt) != 0) return __LINE__;
+
+    parser_deallocate_stmt(stmt);
+    parser_set_memory_budget(PARSER_DEFAULT_MEMORY_BUDGET, NULL);
+
+
+    puts("Testing LIKE predicate parsing");
+    g_test_parser_state.cur_char = 0;
+    g_test_parser_state.stmt = _ach("select a like 'x%!_' escape '!' and b not like 'y_', not c like d from t");
+
+    if(parser_parse(&stmt, lexer, pi) != 0) return __LINE__;
+    if(stmt == NULL || stmt->type != PARSER_STMT_TYPE_SELECT) return __LINE__;
+
+    parser_ast_expr *le = &stmt->select_stmt.select.projection->expr;
+    if(le->node_type != PARSER_EXPR_NODE_TYPE_OP || le->op != PARSER_EXPR_OP_TYPE_AND) return __LINE__;
+    if(le->left->op != PARSER_EXPR_OP_TYPE_LIKE || le->left->left->node_type != PARSER_EXPR_NODE_TYPE_NAME) return __LINE__;
+    if(le->left->right->node_type != PARSER_EXPR_NODE_TYPE_OP || le->left->right->op != PARSER_EXPR_OP_TYPE_ESCAPE) return __LINE__;
+    if(le->left->right->left->node_type != PARSER_EXPR_NODE_TYPE_STR || le->left->right->right->node_type != PARSER_EXPR_NODE_TYPE_STR) return __LINE__;
+    if(le->right->op != PARSER_EXPR_OP_TYPE_NOT_LIKE || le->right->right->node_type != PARSER_EXPR_NODE_TYPE_STR) return __LINE__;
+
+    // NOT of operand is applied to the whole LIKE
+    le = &stmt->select_stmt.select.projection->next->expr;
+    if(le->node_type != PARSER_EXPR_NODE_TYPE_OP || le->op != PARSER_EXPR_OP_TYPE_NOT) return __LINE__;
+    if(le->left->op != PARSER_EXPR_OP_TYPE_LIKE || le->left->right->node_type != PARSER_EXPR_NODE_TYPE_NAME) return __LINE__;
+
+    parser_deallocate_stmt(stmt);
+
+
+    puts("Testing script parsing");
+    g_test_parser_state.cur_char = 0;
+    g_test_parser_state.stmt = _ach("drop table t1;;drop table t2 t3;drop table 't4;drop table t5;");
+
+    ref_stmt.type = PARSER_STMT_TYPE_DROP_TABLE;
+    ref_stmt.drop_table_stmt.table.second_part_len = 0;
+    ref_stmt.drop_table_stmt.table.first_part_len = 2;
+
+    if(parser_script_begin(lexer, pi) != 0) return __LINE__;
+
+    strcpy((char *)ref_stmt.drop_table_stmt.table.first_part, _ach("t1"));
+    if(parser_script_next(&stmt) != 0) return __LINE__;
+    if(stmt == NULL) return __LINE__;
+    if(test_parser_compare_stmt(stmt, &ref_stmt) != 0) return __LINE__;
+    parser_deallocate_stmt(stmt);
+
+    // failed statement is skipped up to the delimiter
+    g_test_parser_state.expected_errmsg = _ach("Unexpected continuation at line 1, column 30");
+    if(parser_script_next(&stmt) != 1) return __LINE__;
+    if(stmt != NULL) return __LINE__;
+
+    // lexical errors are reported once, delimiters inside of failed statement's string literal are ignored
+    g_test_parser_state.expected_errmsg = _ach("string literal has no closing ' at line 1, column 44");
+    if(parser_script_next(&stmt) != 1) return __LINE__;
+    if(stmt != NULL) return __LINE__;
+    g_test_parser_state.expected_errmsg = NULL;
+
+    if(parser_script_next(&stmt) != 0) return __LINE__;
+    if(stmt != NULL) return __LINE__;
+
+    g_test_parser_state.cur_char = 0;
+    g_test_parser_state.stmt = _ach("drop table t1;drop table t2 t3; drop table t5");
+
+    if(parser_script_begin(lexer, pi) != 0) return __LINE__;
+    if(parser_script_next(&stmt) != 0) return __LINE__;
+    parser_deallocate_stmt(stmt);
+    g_test_parser_state.expected_errmsg = _ach("Unexpected continuation at line 1, column 29");
+    if(parser_script_next(&stmt) != 1) return __LINE__;
+    g_test_parser_state.expected_errmsg = NULL;
+
+    strcpy((char *)ref_stmt.drop_table_stmt.table.first_part, _ach("t5"));
+    if(parser_script_next(&stmt) != 0) return __LINE__;
+    if(stmt == NULL) return __LINE__;
+    if(test_parser_compare_stmt(stmt, &ref_stmt) != 0) return __LINE__;
+    parser_deallocate_stmt(stmt);
+
+    if(parser_script_next(&stmt) != 0) return __LINE__;
+    if(stmt != NULL) return __LINE__;
+
+
     return 0;
 }
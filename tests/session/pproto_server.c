@@ -21,6 +21,7 @@ int test_pproto_server_functions()
     sint8 eos;
     encoding client_enc = ENCODING_UTF8, enc;
     pproto_msg_type msg_type;
+    uint8 on_error;
     auth_credentials cred;
     int optval;
 
@@ -513,11 +514,12 @@ int test_pproto_server_functions()
 
     error_set(ERROR_NO_ERROR);
     if(pproto_server_send_error(ERROR_SYNTAX_ERROR, str)) return __LINE__;
-    if(sz + 3 != recv(sv[1], buf, sz + 3, 0)) return __LINE__;
-    if(buf[0] != PPROTO_UTEXT_STRING_MAGIC) return __LINE__;
-    if(buf[1] != sz) return __LINE__;
-    if(memcmp(buf+2, cmpbuf, sz)) return __LINE__;
-    if(buf[sz + 2] != 0) return __LINE__;
+    if(sz + 4 != recv(sv[1], buf, sz + 4, 0)) return __LINE__;
+    if(buf[0] != PPROTO_ERROR_MSG_MAGIC) return __LINE__;
+    if(buf[1] != PPROTO_UTEXT_STRING_MAGIC) return __LINE__;
+    if(buf[2] != sz) return __LINE__;
+    if(memcmp(buf+3, cmpbuf, sz)) return __LINE__;
+    if(buf[sz + 3] != 0) return __LINE__;
 
 
     // without message
@@ -528,11 +530,32 @@ int test_pproto_server_functions()
 
     error_set(ERROR_NO_ERROR);
     if(pproto_server_send_error(ERROR_SYNTAX_ERROR, NULL)) return __LINE__;
-    if(sz + 3 != recv(sv[1], buf, sz + 3, 0)) return __LINE__;
-    if(buf[0] != PPROTO_UTEXT_STRING_MAGIC) return __LINE__;
-    if(buf[1] != sz) return __LINE__;
-    if(memcmp(buf+2, cmpbuf, sz)) return __LINE__;
-    if(buf[sz + 2] != 0) return __LINE__;
+    if(sz + 4 != recv(sv[1], buf, sz + 4, 0)) return __LINE__;
+    if(buf[0] != PPROTO_ERROR_MSG_MAGIC) return __LINE__;
+    if(buf[1] != PPROTO_UTEXT_STRING_MAGIC) return __LINE__;
+    if(buf[2] != sz) return __LINE__;
+    if(memcmp(buf+3, cmpbuf, sz)) return __LINE__;
+    if(buf[sz + 3] != 0) return __LINE__;
+
+
+    // script messages
+    buf[0] = PPROTO_SQL_SCRIPT_MESSAGE_MAGIC;
+    buf[1] = PPROTO_SCRIPT_ON_ERROR_CONTINUE;
+    buf[2] = 0x7F;
+    if(3 != send(sv[1], buf, 3, 0)) return __LINE__;
+    msg_type = pproto_server_read_msg_type();
+    if(msg_type != PPROTO_SQL_SCRIPT_MSG) return __LINE__;
+    if(pproto_server_read_script_on_error(&on_error) != 0) return __LINE__;
+    if(on_error != PPROTO_SCRIPT_ON_ERROR_CONTINUE) return __LINE__;
+    if(pproto_server_read_script_on_error(&on_error) == 0) return __LINE__;
+
+    if(pproto_server_send_success() != 0) return __LINE__;
+    if(pproto_server_send_script_end(3, 258) != 0) return __LINE__;
+    if(10 != recv(sv[1], buf, 10, 0)) return __LINE__;
+    if(buf[0] != PPROTO_SUCCESS_MESSAGE_WITHOUT_TEXT_MAGIC) return __LINE__;
+    if(buf[1] != PPROTO_SCRIPT_END_MESSAGE_MAGIC) return __LINE__;
+    if(buf[2] != 0 || buf[3] != 0 || buf[4] != 0 || buf[5] != 3) return __LINE__;
+    if(buf[6] != 0 || buf[7] != 0 || buf[8] != 1 || buf[9] != 2) return __LINE__;
 
 
     return 0;
@@ -1,7 +1,9 @@
 #ifndef _PERSISTENCE_TESTS_H
 #define _PERSISTENCE_TESTS_H
 
-// automated tests (invoked by 'make test')
+// automated tests (invoked by 'make test') and benchmarks (invoked by 'make bench')
+
+#include <sys/time.h>
 
 // All test functions below return 0 on success or __LINE__ on error
 
@@ -11,6 +13,9 @@ int test_auth_sha3_512();
 // test grigorian calendar functions
 int test_grigorian_calendar();
 
+// test time zone rules of tzinfo
+int test_tzinfo_functions();
+
 // test strop functions
 int test_strop_functions();
 
@@ -47,7 +52,85 @@ int test_stack_functions();
 // test expression functions
 int test_expression_functions();
 
+// test expression bytecode compiler and interpreter
+int test_exprvm_functions();
+
+// test vectorized expression evaluation
+int test_exprbatch_functions();
+
+// test constant folding and common subexpression elimination
+int test_exproptimize_functions();
+
 // test htable functions
 int test_htable_functions();
 
+// test arena functions
+int test_arena_functions();
+
+// test order-preserving key encoding
+int test_keyenc_functions();
+
+// test shortest float formatting and exact parsing
+int test_fltconv_functions();
+
+// test compact string values and interning dictionary
+int test_strval_functions();
+
+// test collations and their sort keys
+int test_collation_functions();
+
+// test LIKE pattern kernels against a backtracking matcher, escape characters and long string literals
+int test_strmatch_functions();
+
+// test growable hash map: growth, replace, delete, tombstones and colliding hashes
+int test_hmap_functions();
+
+
+// All benchmark functions below print elapsed times and return 0 on success or __LINE__ on error
+
+// return milliseconds elapsed since t1
+long bench_elapsed_ms(const struct timeval *t1);
+
+// benchmark lexer on integer-heavy insert statements
+int bench_lexer_functions();
+
+// benchmark constant expression calculation on integer and decimal literals
+int bench_expression_functions();
+
+// benchmark expression bytecode evaluation against the tree walker on integer and decimal rows
+int bench_exprvm_functions();
+
+// benchmark batch filter against row-at-a-time bytecode evaluation on integer and decimal rows
+int bench_exprbatch_functions();
+
+// benchmark decimal add, sub, mul and div on mantissas of several precisions
+int bench_decimal_functions();
+
+// benchmark formatting of million integers, decimals and timestamps and parsing of the timestamps
+int bench_strop_functions();
+
+// benchmark formatting and parsing of million doubles against snprintf and strtod
+int bench_fltconv_functions();
+
+// benchmark extraction of year, month and day from ten million dates row at a time and in batch
+int bench_grigorian_functions();
+
+// benchmark conversion of ten million timestamps to local time against localtime_r
+int bench_tzinfo_functions();
+
+// benchmark validation, counting and conversion of 64 MB of UTF-8 text against building characters one by one
+int bench_encoding_functions();
+
+// benchmark hashing and comparison of million short and long strings as string literals, values and interned values
+int bench_strval_functions();
+
+// benchmark sort of million strings by every collation comparing strings against comparing precomputed sort keys
+int bench_collation_functions();
+
+// benchmark LIKE over million strings for every kind of pattern against a backtracking matcher
+int bench_strmatch_functions();
+
+// benchmark insert, lookup and delete of million keys in hash map against linear probing with full key compare
+int bench_hmap_functions();
+
 #endif